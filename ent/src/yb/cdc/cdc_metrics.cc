@@ -74,6 +74,18 @@ METRIC_DEFINE_gauge_int64(cdc, async_replication_committed_lag_micros,
                           yb::MetricUnit::kMicroseconds,
                           "Lag between last record applied on consumer and producer.",
                           {0, yb::AggregationFunction::kMax} /* optional_args */);
+METRIC_DEFINE_histogram_with_percentiles(cdc, async_replication_sent_lag,
+    "CDC Physical Time Lag Sent Distribution", yb::MetricUnit::kMicroseconds,
+    "Distribution of the lag between commit time of the last record polled and last record "
+    "applied on producer.", 3600000000LU /* 1 hour */, 2);
+METRIC_DEFINE_histogram_with_percentiles(cdc, async_replication_committed_lag,
+    "CDC Physical Time Lag Committed Distribution", yb::MetricUnit::kMicroseconds,
+    "Distribution of the lag between last record applied on consumer and producer.",
+    3600000000LU /* 1 hour */, 2);
+METRIC_DEFINE_histogram_with_percentiles(cdc, get_changes_read_latency,
+    "CDC GetChanges Read Latency", yb::MetricUnit::kMicroseconds,
+    "Time spent by the producer reading and converting WAL records for a GetChanges request.",
+    60000000LU /* 1 minute */, 2);
 
 METRIC_DEFINE_gauge_int64(cdcsdk,
     cdcsdk_sent_lag_micros, "CDCSDK sent Lag",
@@ -142,6 +154,9 @@ CDCTabletMetrics::CDCTabletMetrics(const scoped_refptr<MetricEntity>& entity)
       GINIT(last_readable_opid_index),
       GINIT(async_replication_sent_lag_micros),
       GINIT(async_replication_committed_lag_micros),
+      MINIT(async_replication_sent_lag),
+      MINIT(async_replication_committed_lag),
+      MINIT(get_changes_read_latency),
       GINIT(is_bootstrap_required),
       GINIT(last_getchanges_time),
       GINIT(time_since_last_getchanges),
@@ -74,6 +74,12 @@ class CDCTabletMetrics {
   // Lag between last record applied on consumer and producer.
   scoped_refptr<AtomicGauge<int64_t> > async_replication_committed_lag_micros;
 
+  // Distributions of the two lags above, recorded on every GetChanges that returns records.
+  scoped_refptr<Histogram> async_replication_sent_lag;
+  scoped_refptr<Histogram> async_replication_committed_lag;
+  // Time spent reading and converting WAL records for a GetChanges request.
+  scoped_refptr<Histogram> get_changes_read_latency;
+
   // Info about if a tablet has fallen too far behind in replication.
   scoped_refptr<AtomicGauge<bool>> is_bootstrap_required;
 
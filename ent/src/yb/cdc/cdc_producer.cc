@@ -330,38 +330,43 @@ Status PopulateWriteRecord(const ReplicateMsgPtr& msg,
     const auto key_size = VERIFY_RESULT(
         docdb::DocKey::EncodedSize(key, docdb::DocKeyPart::kWholeDocKey));
 
-    Slice value_slice = write_pair.value();
-    RETURN_NOT_OK(docdb::ValueControlFields::Decode(&value_slice));
-    auto value_type = docdb::DecodeValueEntryType(value_slice);
-
     // Compare key hash with previously seen key hash to determine whether the write pair
     // is part of the same row or not.
     Slice primary_key(key.data(), key_size);
     if (prev_key != primary_key) {
       // Write pair contains record for different row. Create a new CDCRecord in this case.
       record = resp->add_records();
-      Slice sub_doc_key = key;
-      docdb::SubDocKey decoded_key;
-      RETURN_NOT_OK(decoded_key.DecodeFrom(&sub_doc_key, docdb::HybridTimeRequired::kFalse));
 
       if (metadata.record_format == CDCRecordFormat::WAL) {
         // For 2DC, populate serialized data from WAL, to avoid unnecessary deserializing on
-        // producer and re-serializing on consumer.
+        // producer and re-serializing on consumer. Only the hash code is decoded, the rest of the
+        // key is passed through as is.
         auto kv_pair = record->add_key();
-        if (decoded_key.doc_key().has_hash()) {
-          // TODO: is there another way of getting this? Perhaps using kUpToHashOrFirstRange?
-          kv_pair->set_key(
-              PartitionSchema::EncodeMultiColumnHashValue(decoded_key.doc_key().hash()));
+        docdb::DocKeyDecoder decoder(primary_key);
+        RETURN_NOT_OK(decoder.DecodeCotableId());
+        RETURN_NOT_OK(decoder.DecodeColocationId());
+        uint16_t hash = 0;
+        if (VERIFY_RESULT(decoder.DecodeHashCode(&hash))) {
+          kv_pair->set_key(PartitionSchema::EncodeMultiColumnHashValue(hash));
         } else {
-          kv_pair->set_key(decoded_key.doc_key().Encode().ToStringBuffer());
+          kv_pair->set_key(primary_key.cdata(), primary_key.size());
         }
-        kv_pair->mutable_value()->set_binary_value(write_pair.key().ToBuffer());
+        kv_pair->mutable_value()->set_binary_value(key.cdata(), key.size());
       } else {
+        Slice sub_doc_key = key;
+        docdb::SubDocKey decoded_key;
+        RETURN_NOT_OK(decoded_key.DecodeFrom(&sub_doc_key, docdb::HybridTimeRequired::kFalse));
         AddPrimaryKey(decoded_key, schema, record);
       }
 
-      // Check whether operation is WRITE or DELETE.
-      if (value_type == docdb::ValueEntryType::kTombstone && decoded_key.num_subkeys() == 0) {
+      // Check whether operation is WRITE or DELETE. A row delete is a tombstone on the document
+      // key itself, i.e. a key without subkeys.
+      Slice value_slice = write_pair.value();
+      RETURN_NOT_OK(docdb::ValueControlFields::Decode(&value_slice));
+      auto value_type = docdb::DecodeValueEntryType(value_slice);
+      Slice subkeys = key.WithoutPrefix(key_size);
+      if (value_type == docdb::ValueEntryType::kTombstone &&
+          (subkeys.empty() || subkeys[0] == docdb::KeyEntryTypeAsChar::kHybridTime)) {
         record->set_operation(CDCRecordPB::DELETE);
       } else {
         record->set_operation(CDCRecordPB::WRITE);
@@ -389,8 +394,9 @@ Status PopulateWriteRecord(const ReplicateMsgPtr& msg,
 
     if (metadata.record_format == CDCRecordFormat::WAL) {
       auto kv_pair = record->add_changes();
-      kv_pair->set_key(write_pair.key().ToBuffer());
-      kv_pair->mutable_value()->set_binary_value(write_pair.value().ToBuffer());
+      kv_pair->set_key(key.cdata(), key.size());
+      kv_pair->mutable_value()->set_binary_value(
+          write_pair.value().cdata(), write_pair.value().size());
     } else if (record->operation() == CDCRecordPB_OperationType_WRITE) {
       docdb::KeyEntryValue column_id;
       Slice key_column = write_pair.key().WithoutPrefix(key_size);
@@ -510,14 +516,17 @@ Status GetChangesForXCluster(const std::string& stream_id,
                              consensus::ReplicateMsgsHolder* msgs_holder,
                              GetChangesResponsePB* resp,
                              int64_t* last_readable_opid_index,
-                             const CoarseTimePoint deadline) {
+                             const CoarseTimePoint deadline,
+                             size_t max_batch_size_bytes) {
   auto replicate_intents = ReplicateIntents(GetAtomicFlag(&FLAGS_cdc_enable_replicate_intents));
   // Request scope on transaction participant so that transactions are not removed from participant
   // while RequestScope is active.
   RequestScope request_scope;
 
   auto read_ops = VERIFY_RESULT(tablet_peer->consensus()->
-    ReadReplicatedMessagesForCDC(from_op_id, last_readable_opid_index, deadline));
+    ReadReplicatedMessagesForCDC(
+        from_op_id, last_readable_opid_index, deadline, false /* fetch_single_entry */,
+        max_batch_size_bytes));
   ScopedTrackedConsumption consumption;
   if (read_ops.read_from_disk_size && mem_tracker) {
     consumption = ScopedTrackedConsumption(mem_tracker, read_ops.read_from_disk_size);
@@ -98,6 +98,7 @@ Status GetChangesForXCluster(const std::string& stream_id,
                              consensus::ReplicateMsgsHolder* msgs_holder,
                              GetChangesResponsePB* resp,
                              int64_t* last_readable_opid_index = nullptr,
-                             const CoarseTimePoint deadline = CoarseTimePoint::max());
+                             const CoarseTimePoint deadline = CoarseTimePoint::max(),
+                             size_t max_batch_size_bytes = 0);
 }  // namespace cdc
 }  // namespace yb
@@ -141,6 +141,14 @@ DEFINE_UNKNOWN_bool(parallelize_bootstrap_producer, true,
     "When this is true, use the version of BootstrapProducer with batched and "
     "parallelized rpc calls. This is recommended for large input sizes");
 
+DEFINE_RUNTIME_bool(cdc_state_table_coalesce_checkpoint_updates, false,
+    "When true, checkpoint updates of GetChanges are not written to the cdc_state table one by "
+    "one. They are kept in memory, with only the update with the highest checkpoint of each "
+    "stream and tablet, and written as one batch by the CDC background thread. An update still "
+    "pending when the tserver stops is lost, and the stream resumes from the previous "
+    "checkpoint.");
+TAG_FLAG(cdc_state_table_coalesce_checkpoint_updates, advanced);
+
 DEFINE_test_flag(uint64, cdc_log_init_failure_timeout_seconds, 0,
     "Timeout in seconds for CDCServiceImpl::SetCDCCheckpoint to return log init failure");
 
@@ -159,6 +167,9 @@ DEFINE_test_flag(bool, block_get_changes, false,
 DEFINE_test_flag(bool, cdc_inject_replication_index_update_failure, false,
     "Injects an error after updating a tablet's replication index entry");
 
+DEFINE_test_flag(bool, cdc_pause_coalesced_checkpoint_flush, false,
+    "Keeps the coalesced checkpoint updates in memory instead of writing them to cdc_state.");
+
 DECLARE_bool(enable_log_retention_by_op_idx);
 
 DECLARE_int32(cdc_checkpoint_opid_interval_ms);
@@ -1584,13 +1595,15 @@ void CDCServiceImpl::GetChanges(
   }
 
   bool report_tablet_split = false;
+  const auto read_start = MonoTime::Now();
   // Read the latest changes from the Log.
   if (record.source_type == XCLUSTER) {
     status = GetChangesForXCluster(
         stream_id, req->tablet_id(), op_id, record, tablet_peer, session,
         std::bind(
             &CDCServiceImpl::UpdateChildrenTabletsOnSplitOp, this, producer_tablet, _1, session),
-        mem_tracker, &msgs_holder, resp, &last_readable_index, get_changes_deadline);
+        mem_tracker, &msgs_holder, resp, &last_readable_index, get_changes_deadline,
+        req->max_bytes());
   } else {
     std::string commit_timestamp;
     OpId last_streamed_op_id;
@@ -1723,7 +1736,8 @@ void CDCServiceImpl::GetChanges(
   }
   // Update relevant GetChanges metrics before handing off the Response.
   UpdateCDCTabletMetrics(
-      resp, producer_tablet, tablet_peer, op_id, record.source_type, last_readable_index);
+      resp, producer_tablet, tablet_peer, op_id, record.source_type, last_readable_index,
+      MonoTime::Now() - read_start);
 
   if (report_tablet_split) {
     RPC_STATUS_RETURN_ERROR(
@@ -2535,6 +2549,10 @@ void CDCServiceImpl::UpdatePeersAndMetrics() {
   };
 
   do {
+    // Flushed even when CDC is not enabled, so that updates made before a stream was deleted are
+    // not held back.
+    FlushPendingCheckpointUpdates();
+
     if (!cdc_enabled_.load(std::memory_order_acquire)) {
       // CDC service not enabled, so skip background thread work.
       continue;
@@ -3651,7 +3669,8 @@ void CDCServiceImpl::UpdateCDCTabletMetrics(
     const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
     const OpId& op_id,
     const CDCRequestSource source_type,
-    int64_t last_readable_index) {
+    int64_t last_readable_index,
+    MonoDelta read_latency) {
   auto tablet_metric_row = GetCDCTabletMetrics(producer_tablet, tablet_peer, source_type);
   if (!tablet_metric_row) {
     return;
@@ -3687,6 +3706,7 @@ void CDCServiceImpl::UpdateCDCTabletMetrics(
     tablet_metric->last_readable_opid_index->set_value(last_readable_index);
     tablet_metric->last_checkpoint_opid_index->set_value(op_id.index);
     tablet_metric->last_getchanges_time->set_value(GetCurrentTimeMicros());
+    tablet_metric->get_changes_read_latency->Increment(read_latency.ToMicroseconds());
 
     if (resp->records_size() > 0) {
       uint64 last_record_time = resp->records(resp->records_size() - 1).time();
@@ -3701,6 +3721,8 @@ void CDCServiceImpl::UpdateCDCTabletMetrics(
       auto last_replicated_micros = GetLastReplicatedTime(tablet_peer);
       tablet_metric->async_replication_sent_lag_micros->set_value(
           last_replicated_micros - last_record_micros);
+      tablet_metric->async_replication_sent_lag->Increment(
+          std::max<int64_t>(last_replicated_micros - last_record_micros, 0));
 
       auto first_record_micros = HybridTime(first_record_time).GetPhysicalValueMicros();
       tablet_metric->last_checkpoint_physicaltime->set_value(first_record_micros);
@@ -3710,6 +3732,8 @@ void CDCServiceImpl::UpdateCDCTabletMetrics(
           std::max(tablet_metric->last_caughtup_physicaltime->value(), first_record_micros));
       tablet_metric->async_replication_committed_lag_micros->set_value(
           last_replicated_micros - first_record_micros);
+      tablet_metric->async_replication_committed_lag->Increment(
+          std::max<int64_t>(last_replicated_micros - first_record_micros, 0));
     } else {
       tablet_metric->rpc_heartbeats_responded->Increment();
       // If there are no more entries to be read, that means we're caught up.
@@ -3769,6 +3793,27 @@ Status CDCServiceImpl::UpdateCheckpointAndActiveTime(
     // stream.
     auto* condition = req->mutable_if_expr()->mutable_condition();
     condition->set_op(QL_OP_EXISTS);
+
+    if (!force_update && GetAtomicFlag(&FLAGS_cdc_state_table_coalesce_checkpoint_updates)) {
+      std::lock_guard<decltype(pending_checkpoint_updates_mutex_)> l(
+          pending_checkpoint_updates_mutex_);
+      auto& pending_update = pending_checkpoint_updates_[producer_tablet];
+      // Concurrent GetChanges calls could report checkpoints out of order, keep the highest.
+      if (!pending_update.op || pending_update.commit_op_id <= commit_op_id) {
+        pending_update = PendingCheckpointUpdate {
+          .commit_op_id = commit_op_id,
+          .op = op,
+        };
+      }
+      return Status::OK();
+    }
+
+    {
+      // A synchronous write supersedes any update of the same row still waiting to be flushed.
+      std::lock_guard<decltype(pending_checkpoint_updates_mutex_)> l(
+          pending_checkpoint_updates_mutex_);
+      pending_checkpoint_updates_.erase(producer_tablet);
+    }
     // TODO(async_flush): https://github.com/yugabyte/yugabyte-db/issues/12173
     RETURN_NOT_OK(RefreshCacheOnFail(session->ApplyAndFlushSync(op)));
   }
@@ -3776,6 +3821,34 @@ Status CDCServiceImpl::UpdateCheckpointAndActiveTime(
   return Status::OK();
 }
 
+void CDCServiceImpl::FlushPendingCheckpointUpdates() {
+  if (PREDICT_FALSE(FLAGS_TEST_cdc_pause_coalesced_checkpoint_flush)) {
+    return;
+  }
+  decltype(pending_checkpoint_updates_) pending_updates;
+  {
+    std::lock_guard<decltype(pending_checkpoint_updates_mutex_)> l(
+        pending_checkpoint_updates_mutex_);
+    pending_updates.swap(pending_checkpoint_updates_);
+  }
+  if (pending_updates.empty()) {
+    return;
+  }
+
+  std::vector<client::YBOperationPtr> ops;
+  ops.reserve(pending_updates.size());
+  for (auto& [producer_tablet, pending_update] : pending_updates) {
+    ops.push_back(std::move(pending_update.op));
+  }
+  VLOG(2) << "Flushing " << ops.size() << " coalesced checkpoint updates to cdc_state table";
+
+  auto session = client()->NewSession();
+  session->SetTimeout(MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms));
+  WARN_NOT_OK(
+      RefreshCacheOnFail(session->ApplyAndFlushSync(ops)),
+      "Unable to flush coalesced checkpoint updates to cdc_state table");
+}
+
 const std::string GetCDCMetricsKey(const std::string& stream_id) {
   return "CDCMetrics::" + stream_id;
 }
@@ -13,6 +13,8 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_fwd.h"
 #include "yb/cdc/cdc_error.h"
@@ -186,7 +188,8 @@ class CDCServiceImpl : public CDCServiceIf {
       const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
       const OpId& op_id,
       const CDCRequestSource source_type,
-      int64_t last_readable_index);
+      int64_t last_readable_index,
+      MonoDelta read_latency);
 
   std::shared_ptr<CDCServerMetrics> GetCDCServerMetrics() { return server_metrics_; }
 
@@ -327,6 +330,10 @@ class CDCServiceImpl : public CDCServiceIf {
   // tablet and then update the peers' log objects. Also used to update lag metrics.
   void UpdatePeersAndMetrics();
 
+  // Writes the checkpoint updates coalesced by UpdateCheckpointAndActiveTime to cdc_state, as one
+  // batch. Called by the UpdatePeersAndMetrics thread.
+  void FlushPendingCheckpointUpdates() EXCLUDES(pending_checkpoint_updates_mutex_);
+
   Status GetTabletIdsToPoll(
       const CDCStreamId stream_id,
       const std::set<TabletId>& active_or_hidden_tablets,
@@ -434,6 +441,18 @@ class CDCServiceImpl : public CDCServiceIf {
   // CDC service proxy.
   CDCServiceProxyMap cdc_service_map_ GUARDED_BY(mutex_);
 
+  struct PendingCheckpointUpdate {
+    OpId commit_op_id;
+    client::YBqlWriteOpPtr op;
+  };
+
+  // Checkpoint updates waiting to be written to cdc_state when
+  // cdc_state_table_coalesce_checkpoint_updates is set. Only the update with the highest
+  // checkpoint of each stream and tablet is kept.
+  std::mutex pending_checkpoint_updates_mutex_;
+  std::unordered_map<ProducerTabletInfo, PendingCheckpointUpdate, ProducerTabletInfo::Hash>
+      pending_checkpoint_updates_ GUARDED_BY(pending_checkpoint_updates_mutex_);
+
   // Thread with a few functions:
   //
   // Read the cdc_state table and get the minimum checkpoint for each tablet
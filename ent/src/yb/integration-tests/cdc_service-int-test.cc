@@ -55,8 +55,10 @@
 
 using std::string;
 
+DECLARE_bool(TEST_cdc_pause_coalesced_checkpoint_flush);
 DECLARE_bool(TEST_record_segments_violate_max_time_policy);
 DECLARE_bool(TEST_record_segments_violate_min_space_policy);
+DECLARE_bool(cdc_state_table_coalesce_checkpoint_updates);
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(enable_log_retention_by_op_idx);
 DECLARE_bool(enable_ysql);
@@ -1556,6 +1558,71 @@ TEST_F(CDCServiceTest, TestCheckpointUpdate) {
   VerifyStreamDeletedFromCdcState(client_.get(), stream_id_, tablet_id);
 }
 
+// Coalesced checkpoint updates keep the highest checkpoint of the tablet, even when a lower one
+// is reported later.
+TEST_F(CDCServiceTest, TestCoalescedCheckpointUpdate) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cdc_state_checkpoint_update_interval_ms) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cdc_state_table_coalesce_checkpoint_updates) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_cdc_pause_coalesced_checkpoint_flush) = true;
+
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id_);
+
+  std::string tablet_id = GetTablet();
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+
+  tserver::WriteRequestPB write_req;
+  tserver::WriteResponsePB write_resp;
+  write_req.set_tablet_id(tablet_id);
+  {
+    RpcController rpc;
+    AddTestRowInsert(1, 11, "key1", &write_req);
+    AddTestRowInsert(2, 22, "key2", &write_req);
+
+    SCOPED_TRACE(write_req.DebugString());
+    ASSERT_OK(WriteToProxyWithRetries(proxy, write_req, &write_resp, &rpc));
+    SCOPED_TRACE(write_resp.DebugString());
+    ASSERT_FALSE(write_resp.has_error());
+  }
+
+  GetChangesRequestPB change_req;
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id_);
+
+  CDCCheckpointPB initial_checkpoint;
+  ASSERT_OK(GetChangesInitialSchema(change_req, &initial_checkpoint));
+
+  // Each GetChanges call reports its from_checkpoint as committed.
+  auto get_changes = [this, &change_req](const CDCCheckpointPB& from_checkpoint)
+      -> Result<GetChangesResponsePB> {
+    change_req.mutable_from_checkpoint()->CopyFrom(from_checkpoint);
+    GetChangesResponsePB change_resp;
+    RpcController rpc;
+    RETURN_NOT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    SCHECK(!change_resp.has_error(), IllegalState, change_resp.error().ShortDebugString());
+    return change_resp;
+  };
+
+  auto change_resp = ASSERT_RESULT(get_changes(initial_checkpoint));
+  ASSERT_EQ(change_resp.records_size(), 2);
+  const auto checkpoint = change_resp.checkpoint();
+
+  ASSERT_OK(get_changes(checkpoint));
+  // A lower checkpoint reported after a higher one, for instance by a retried request.
+  ASSERT_OK(get_changes(initial_checkpoint));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_cdc_pause_coalesced_checkpoint_flush) = false;
+  // Give the CDC background thread time to write the coalesced updates.
+  SleepFor(MonoDelta::FromSeconds(2) * kTimeMultiplier);
+  ASSERT_NO_FATALS(VerifyCdcStateMatches(
+      client_.get(), stream_id_, tablet_id, checkpoint.op_id().term(),
+      checkpoint.op_id().index()));
+
+  // Cleanup stream before shutdown.
+  ASSERT_OK(client_->DeleteCDCStream(stream_id_));
+  VerifyStreamDeletedFromCdcState(client_.get(), stream_id_, tablet_id);
+}
+
 namespace {
 void WaitForCDCIndex(const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
                      int64_t expected_index,
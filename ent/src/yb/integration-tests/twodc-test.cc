@@ -86,6 +86,7 @@ DECLARE_int32(cdc_wal_retention_time_secs);
 DECLARE_int32(replication_failure_delay_exponent);
 DECLARE_double(TEST_respond_write_failed_probability);
 DECLARE_int32(cdc_max_apply_batch_num_records);
+DECLARE_int32(cdc_max_concurrent_apply_write_rpcs);
 DECLARE_int32(async_replication_idle_delay_ms);
 DECLARE_int32(async_replication_polling_delay_ms);
 DECLARE_int32(async_replication_max_idle_wait);
@@ -1439,6 +1440,33 @@ TEST_P(TwoDCTest, ApplyOperations) {
   ASSERT_OK(DeleteUniverseReplication());
 }
 
+// Records of a producer tablet are written to several consumer tablets concurrently. Writes to the
+// same consumer tablet must still be applied in order, so the deletes and the second inserts of a
+// key are not applied before its first insert.
+TEST_P(TwoDCTest, ApplyOperationsToManyConsumerTablets) {
+  constexpr int kConsumerTablets = 8;
+  // Less than the number of consumer tablets, so that some tablets wait for their turn.
+  SetAtomicFlag(3, &FLAGS_cdc_max_concurrent_apply_write_rpcs);
+
+  uint32_t replication_factor = NonTsanVsTsan(3, 1);
+  auto tables = ASSERT_RESULT(SetUpWithParams({1}, {kConsumerTablets}, replication_factor));
+
+  std::vector<std::shared_ptr<client::YBTable>> producer_tables;
+  producer_tables.reserve(1);
+  producer_tables.push_back(tables[0]);
+  ASSERT_OK(SetupUniverseReplication(producer_tables));
+  ASSERT_OK(CorrectlyPollingAllTablets(consumer_cluster(), kConsumerTablets));
+
+  WriteWorkload(0, 200, producer_client(), tables[0]->name());
+  DeleteWorkload(0, 100, producer_client(), tables[0]->name());
+  WriteWorkload(0, 50, producer_client(), tables[0]->name());
+
+  ASSERT_OK(VerifyNumRecords(tables[1]->name(), consumer_client(), 150));
+  ASSERT_OK(VerifyWrittenRecords(tables[0]->name(), tables[1]->name()));
+
+  ASSERT_OK(DeleteUniverseReplication());
+}
+
 class TwoDCTestTransactionalOnly : public TwoDCTest {};
 
 INSTANTIATE_TEST_CASE_P(
@@ -43,6 +43,7 @@
 #include "yb/server/secure.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/shared_lock.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
@@ -71,6 +72,19 @@ static bool ValidateXClusterSafeTimeUpdateInterval(const char* flagname, int32 v
 
 DEFINE_validator(xcluster_safe_time_update_interval_secs, &ValidateXClusterSafeTimeUpdateInterval);
 
+METRIC_DEFINE_histogram_with_percentiles(server, xcluster_consumer_poll_rpc_latency,
+    "xCluster Consumer GetChanges Latency", yb::MetricUnit::kMicroseconds,
+    "Time from sending a GetChanges request to the producer until its response is received. "
+    "Includes the network round trip and the read on the producer.", 60000000LU, 2);
+METRIC_DEFINE_histogram_with_percentiles(server, xcluster_consumer_apply_latency,
+    "xCluster Consumer Apply Latency", yb::MetricUnit::kMicroseconds,
+    "Time spent applying the records of one GetChanges response, including retries.",
+    60000000LU, 2);
+METRIC_DEFINE_histogram_with_percentiles(server, xcluster_consumer_end_to_end_lag,
+    "xCluster Consumer End To End Lag", yb::MetricUnit::kMicroseconds,
+    "Time between the commit of the last record of a GetChanges response on the producer and "
+    "the end of its apply on the consumer.", 3600000000LU /* 1 hour */, 2);
+
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 DECLARE_int32(cdc_write_rpc_timeout_ms);
 DECLARE_bool(use_node_to_node_encryption);
@@ -129,7 +143,8 @@ Result<std::unique_ptr<CDCConsumer>> CDCConsumer::Create(
 
   local_client->client->SetLocalTabletServer(tserver->permanent_uuid(), tserver->proxy(), tserver);
   auto cdc_consumer = std::make_unique<CDCConsumer>(std::move(is_leader_for_tablet), proxy_cache,
-      tserver->permanent_uuid(), std::move(local_client), &tserver->TransactionManager());
+      tserver->permanent_uuid(), std::move(local_client), &tserver->TransactionManager(),
+      tserver->metric_entity());
 
   // TODO(NIC): Unify cdc_consumer thread_pool & remote_client_ threadpools
   RETURN_NOT_OK(yb::Thread::Create(
@@ -150,13 +165,17 @@ CDCConsumer::CDCConsumer(
     const string& ts_uuid,
     std::unique_ptr<CDCClient>
         local_client,
-    client::TransactionManager* transaction_manager)
+    client::TransactionManager* transaction_manager,
+    const scoped_refptr<MetricEntity>& metric_entity)
     : is_leader_for_tablet_(std::move(is_leader_for_tablet)),
       rpcs_(new rpc::Rpcs),
       log_prefix_(Format("[TS $0]: ", ts_uuid)),
       local_client_(std::move(local_client)),
       last_safe_time_published_at_(MonoTime::Now()),
-      transaction_manager_(transaction_manager) {}
+      transaction_manager_(transaction_manager),
+      poll_rpc_latency_(METRIC_xcluster_consumer_poll_rpc_latency.Instantiate(metric_entity)),
+      apply_latency_(METRIC_xcluster_consumer_apply_latency.Instantiate(metric_entity)),
+      end_to_end_lag_(METRIC_xcluster_consumer_end_to_end_lag.Instantiate(metric_entity)) {}
 
 CDCConsumer::~CDCConsumer() {
   Shutdown();
@@ -27,11 +27,14 @@
 #include "yb/common/common_types.pb.h"
 #include "yb/tablet/tablet_types.pb.h"
 #include "yb/cdc/cdc_consumer.pb.h"
+#include "yb/gutil/ref_counted.h"
 #include "yb/util/locks.h"
 #include "yb/util/monotime.h"
 
 namespace yb {
 
+class Histogram;
+class MetricEntity;
 class Thread;
 class ThreadPool;
 
@@ -78,7 +81,8 @@ class CDCConsumer {
       rpc::ProxyCache* proxy_cache,
       const std::string& ts_uuid,
       std::unique_ptr<CDCClient> local_client,
-      client::TransactionManager* transaction_manager);
+      client::TransactionManager* transaction_manager,
+      const scoped_refptr<MetricEntity>& metric_entity);
 
   ~CDCConsumer();
   void Shutdown() EXCLUDES(should_run_mutex_);
@@ -121,6 +125,11 @@ class CDCConsumer {
   // Returns the replication error map.
   cdc::TabletReplicationErrorMap GetReplicationErrors() const;
 
+  // Per stage latencies of the pollers, from the consumer side.
+  const scoped_refptr<Histogram>& poll_rpc_latency() const { return poll_rpc_latency_; }
+  const scoped_refptr<Histogram>& apply_latency() const { return apply_latency_; }
+  const scoped_refptr<Histogram>& end_to_end_lag() const { return end_to_end_lag_; }
+
  private:
   // Runs a thread that periodically polls for any new threads.
   void RunThread() EXCLUDES(should_run_mutex_);
@@ -222,6 +231,10 @@ class CDCConsumer {
   mutable simple_spinlock tablet_replication_error_map_lock_;
   cdc::TabletReplicationErrorMap tablet_replication_error_map_
     GUARDED_BY(tablet_replication_error_map_lock_);
+
+  scoped_refptr<Histogram> poll_rpc_latency_;
+  scoped_refptr<Histogram> apply_latency_;
+  scoped_refptr<Histogram> end_to_end_lag_;
 };
 
 } // namespace enterprise
@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/tserver/cdc_poller.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(cdc_read_rpc_timeout_ms);
+DECLARE_uint64(async_replication_max_get_changes_bytes);
+DECLARE_uint64(consensus_max_batch_size_bytes);
+DECLARE_uint64(rpc_max_message_size);
+
+namespace yb {
+namespace tserver {
+namespace enterprise {
+
+class CDCPollerTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_cdc_read_rpc_timeout_ms) = 30000;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_consensus_max_batch_size_bytes) = 4_MB;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_async_replication_max_get_changes_bytes) = 64_MB;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_max_message_size) = 255_MB;
+  }
+
+  // Size requested after a fast poll that filled the window.
+  static uint64_t AfterFullPoll(uint64_t current) {
+    return NextGetChangesMaxBytes(current, false /* failed */, 100ms, current);
+  }
+};
+
+TEST_F(CDCPollerTest, AdaptiveGetChangesSize) {
+  // Grows while responses are full and fast.
+  ASSERT_EQ(AfterFullPoll(4_MB), 8_MB);
+  ASSERT_EQ(AfterFullPoll(32_MB), 64_MB);
+  // Bounded by async_replication_max_get_changes_bytes.
+  ASSERT_EQ(AfterFullPoll(64_MB), 64_MB);
+
+  // Stays when responses don't fill half of the window.
+  ASSERT_EQ(NextGetChangesMaxBytes(8_MB, false, 100ms, 1_MB), 8_MB);
+  // Stays when polls are neither fast nor slow.
+  ASSERT_EQ(NextGetChangesMaxBytes(8_MB, false, 10s, 8_MB), 8_MB);
+
+  // Halves on failures and slow polls, down to consensus_max_batch_size_bytes.
+  ASSERT_EQ(NextGetChangesMaxBytes(16_MB, true /* failed */, 100ms, 0), 8_MB);
+  ASSERT_EQ(NextGetChangesMaxBytes(16_MB, false, 20s, 16_MB), 8_MB);
+  ASSERT_EQ(NextGetChangesMaxBytes(4_MB, true, 100ms, 0), 4_MB);
+}
+
+TEST_F(CDCPollerTest, AdaptiveGetChangesSizeFitsRpc) {
+  // The window never exceeds what the producer reads into one response, half of
+  // rpc_max_message_size, even when async_replication_max_get_changes_bytes is larger.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_async_replication_max_get_changes_bytes) = 1024_MB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_max_message_size) = 32_MB;
+  uint64_t size = FLAGS_consensus_max_batch_size_bytes;
+  for (int i = 0; i != 10; ++i) {
+    size = AfterFullPoll(size);
+  }
+  ASSERT_EQ(size, 16_MB);
+
+  // But never goes below consensus_max_batch_size_bytes.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_max_message_size) = 4_MB;
+  ASSERT_EQ(AfterFullPoll(4_MB), 4_MB);
+}
+
+} // namespace enterprise
+} // namespace tserver
+} // namespace yb
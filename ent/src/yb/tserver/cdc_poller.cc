@@ -27,8 +27,11 @@
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/gutil/dynamic_annotations.h"
+#include "yb/gutil/walltime.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 #include "yb/util/threadpool.h"
 
@@ -50,6 +53,15 @@ DEFINE_RUNTIME_bool(cdc_consumer_use_proxy_forwarding, false,
     "When enabled, read requests from the CDC Consumer that go to the wrong node are "
     "forwarded to the correct node by the Producer.");
 
+DEFINE_RUNTIME_bool(async_replication_adaptive_get_changes_size, false,
+    "When enabled, the poller grows the size of its GetChanges responses while they come back "
+    "full and fast, and shrinks it when they get slow or fail. Otherwise the producer uses "
+    "consensus_max_batch_size_bytes.");
+
+DEFINE_RUNTIME_uint64(async_replication_max_get_changes_bytes, 64_MB,
+    "Upper bound for the GetChanges response size when "
+    "async_replication_adaptive_get_changes_size is enabled.");
+
 DEFINE_test_flag(int32, xcluster_simulated_lag_ms, 0,
     "Simulate lag in xcluster replication. Replication is paused if set to -1.");
 DEFINE_test_flag(string, xcluster_simulated_lag_tablet_filter, "",
@@ -60,6 +72,8 @@ DEFINE_test_flag(bool, cdc_skip_replication_poll, false,
                  "If true, polling will be skipped.");
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
+DECLARE_uint64(consensus_max_batch_size_bytes);
+DECLARE_uint64(rpc_max_message_size);
 
 using namespace std::placeholders;
 
@@ -256,6 +270,14 @@ void CDCPoller::DoPoll() {
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
   req.set_serve_as_proxy(GetAtomicFlag(&FLAGS_cdc_consumer_use_proxy_forwarding));
+  if (GetAtomicFlag(&FLAGS_async_replication_adaptive_get_changes_size)) {
+    if (get_changes_max_bytes_ == 0) {
+      get_changes_max_bytes_ = GetAtomicFlag(&FLAGS_consensus_max_batch_size_bytes);
+    }
+    req.set_max_bytes(get_changes_max_bytes_);
+  } else {
+    get_changes_max_bytes_ = 0;
+  }
 
   cdc::CDCCheckpointPB checkpoint;
   *checkpoint.mutable_op_id() = op_id_;
@@ -281,6 +303,7 @@ void CDCPoller::DoPoll() {
       producer_client_->client.get(),
       &req,
       std::bind(&CDCPoller::HandlePoll, shared_from_this(), _1, _2));
+  poll_start_time_ = MonoTime::Now();
   (**poll_handle_).SendRpc();
 }
 
@@ -303,6 +326,10 @@ void CDCPoller::DoHandlePoll(Status status, std::shared_ptr<cdc::GetChangesRespo
 
   status_ = status;
   resp_ = resp;
+  const auto poll_latency = MonoTime::Now() - poll_start_time_;
+  if (status_.ok()) {
+    cdc_consumer_->poll_rpc_latency()->Increment(poll_latency.ToMicroseconds());
+  }
 
   bool failed = false;
   if (!status_.ok()) {
@@ -325,6 +352,7 @@ void CDCPoller::DoHandlePoll(Status status, std::shared_ptr<cdc::GetChangesRespo
     LOG_WITH_PREFIX_UNLOCKED(ERROR) << "CDCPoller failure: no checkpoint";
     failed = true;
   }
+  AdjustGetChangesSize(failed, poll_latency);
   if (failed) {
     // In case of errors, try polling again with backoff
     poll_failures_ =
@@ -334,10 +362,41 @@ void CDCPoller::DoHandlePoll(Status status, std::shared_ptr<cdc::GetChangesRespo
   poll_failures_ = std::max(poll_failures_ - 2, 0); // otherwise, recover slowly if we're congested
 
   // Success Case: ApplyChanges() from Poll
+  apply_start_time_ = MonoTime::Now();
   output_client_->SetLastCompatibleConsumerSchemaVersion(last_compatible_consumer_schema_version_);
   WARN_NOT_OK(output_client_->ApplyChanges(resp_.get()), "Could not ApplyChanges");
 }
 
+uint64_t NextGetChangesMaxBytes(
+    uint64_t current, bool failed, MonoDelta poll_latency, size_t response_bytes) {
+  // Like TCP congestion control: while responses are limited by the requested size and come back
+  // well within the read deadline, the link and the producer have spare capacity, so double the
+  // size. Back off by half as soon as a poll fails or takes a good part of the deadline.
+  const auto min_bytes = GetAtomicFlag(&FLAGS_consensus_max_batch_size_bytes);
+  // The producer does not read more than half of rpc_max_message_size, so that the response fits
+  // into an RPC. Growing the window past that would only delay backing off.
+  const auto max_bytes = std::max<uint64_t>(
+      std::min<uint64_t>(
+          GetAtomicFlag(&FLAGS_async_replication_max_get_changes_bytes),
+          FLAGS_rpc_max_message_size / 2),
+      min_bytes);
+  const auto read_timeout = MonoDelta::FromMilliseconds(FLAGS_cdc_read_rpc_timeout_ms);
+  if (failed || poll_latency * 2 > read_timeout) {
+    current = std::max<uint64_t>(current / 2, min_bytes);
+  } else if (response_bytes * 2 >= current && poll_latency * 4 < read_timeout) {
+    current *= 2;
+  }
+  return std::min<uint64_t>(current, max_bytes);
+}
+
+void CDCPoller::AdjustGetChangesSize(bool failed, MonoDelta poll_latency) {
+  if (get_changes_max_bytes_ == 0) {
+    return;
+  }
+  get_changes_max_bytes_ = NextGetChangesMaxBytes(
+      get_changes_max_bytes_, failed, poll_latency, resp_->ByteSizeLong());
+}
+
 void CDCPoller::HandleApplyChanges(cdc::OutputClientResponse response) {
   RETURN_WHEN_OFFLINE();
   WARN_NOT_OK(thread_pool_->SubmitFunc(
@@ -362,6 +421,14 @@ void CDCPoller::DoHandleApplyChanges(cdc::OutputClientResponse response) {
   }
   apply_failures_ = std::max(apply_failures_ - 2, 0); // recover slowly if we've gotten congested
 
+  cdc_consumer_->apply_latency()->Increment((MonoTime::Now() - apply_start_time_).ToMicroseconds());
+  if (resp_->records_size() > 0) {
+    const auto last_record_micros =
+        HybridTime(resp_->records(resp_->records_size() - 1).time()).GetPhysicalValueMicros();
+    cdc_consumer_->end_to_end_lag()->Increment(
+        std::max<int64_t>(GetCurrentTimeMicros() - last_record_micros, 0));
+  }
+
   op_id_ = response.last_applied_op_id;
 
   idle_polls_ = (response.processed_record_count == 0) ? idle_polls_ + 1 : 0;
@@ -46,6 +46,12 @@ namespace enterprise {
 
 class CDCConsumer;
 
+// Returns the size to request by the next GetChanges when
+// async_replication_adaptive_get_changes_size is set, from the size requested by the last one and
+// its outcome.
+uint64_t NextGetChangesMaxBytes(
+    uint64_t current, bool failed, MonoDelta poll_latency, size_t response_bytes);
+
 
 class CDCPoller : public std::enable_shared_from_this<CDCPoller> {
  public:
@@ -94,6 +100,8 @@ class CDCPoller : public std::enable_shared_from_this<CDCPoller> {
   // Does the work of polling for new changes.
   void DoHandleApplyChanges(cdc::OutputClientResponse response);
   void UpdateSafeTime(int64 new_time) EXCLUDES(safe_time_lock_);
+  // Updates the size requested by the next GetChanges, from the outcome of the last one.
+  void AdjustGetChangesSize(bool failed, MonoDelta poll_latency);
 
   cdc::ProducerTabletInfo producer_tablet_info_;
   cdc::ConsumerTabletInfo consumer_tablet_info_;
@@ -128,6 +136,13 @@ class CDCPoller : public std::enable_shared_from_this<CDCPoller> {
   int poll_failures_ GUARDED_BY(data_mutex_){0};
   int apply_failures_ GUARDED_BY(data_mutex_){0};
   int idle_polls_ GUARDED_BY(data_mutex_){0};
+
+  // Start of the current GetChanges RPC and of the apply of its response, for the latency metrics.
+  MonoTime poll_start_time_ GUARDED_BY(data_mutex_);
+  MonoTime apply_start_time_ GUARDED_BY(data_mutex_);
+
+  // Size of the WAL entries requested by GetChanges, 0 when the producer default is used.
+  uint64_t get_changes_max_bytes_ GUARDED_BY(data_mutex_) = 0;
 };
 
 } // namespace enterprise
@@ -12,7 +12,10 @@
 
 #include "yb/tserver/twodc_output_client.h"
 
+#include <deque>
+#include <map>
 #include <shared_mutex>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
 #include "yb/cdc/cdc_rpc.h"
@@ -31,6 +34,7 @@
 #include "yb/tserver/cdc_consumer.h"
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/twodc_write_interface.h"
+#include "yb/util/atomic.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/net_util.h"
@@ -45,6 +49,11 @@ DEFINE_RUNTIME_bool(cdc_force_remote_tserver, false,
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
+DEFINE_RUNTIME_int32(cdc_max_concurrent_apply_write_rpcs, 8,
+    "Max number of consumer tablets that one xCluster output client writes to concurrently. "
+    "Writes to the same consumer tablet are always sent one at a time, in order.");
+TAG_FLAG(cdc_max_concurrent_apply_write_rpcs, advanced);
+
 DEFINE_test_flag(bool, xcluster_consumer_fail_after_process_split_op, false,
     "Whether or not to fail after processing a replicated split_op on the consumer.");
 
@@ -73,7 +82,6 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
       local_client_(local_client),
       thread_pool_(thread_pool),
       rpcs_(rpcs),
-      write_handle_(rpcs->InvalidHandle()),
       apply_changes_clbk_(std::move(apply_changes_clbk)),
       use_local_tserver_(use_local_tserver),
       all_tablets_result_(STATUS(Uninitialized, "Result has not been initialized.")),
@@ -94,15 +102,17 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
     DCHECK(!shutdown_);
     shutdown_ = true;
 
-    rpc::RpcCommandPtr rpc_to_abort;
+    std::vector<rpc::RpcCommandPtr> rpcs_to_abort;
     {
       std::lock_guard<decltype(lock_)> l(lock_);
-      if (write_handle_ != rpcs_->InvalidHandle()) {
-        rpc_to_abort = *write_handle_;
+      for (const auto& tablet_and_handle : write_handles_) {
+        if (tablet_and_handle.second != rpcs_->InvalidHandle()) {
+          rpcs_to_abort.push_back(*tablet_and_handle.second);
+        }
       }
     }
-    if (rpc_to_abort) {
-      rpc_to_abort->Abort();
+    for (const auto& rpc : rpcs_to_abort) {
+      rpc->Abort();
     }
   }
 
@@ -161,10 +171,14 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   Status SendUserTableWrites();
 
-  void SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request);
+  // Sends the next pending write of every consumer tablet that has no write in flight, up to
+  // cdc_max_concurrent_apply_write_rpcs tablets at a time.
+  void SendPendingWrites() EXCLUDES(lock_);
 
-  void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
-  void DoWriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
+  void WriteCDCRecordDone(
+      const TabletId& tablet_id, const Status& status, const WriteResponsePB& response);
+  void DoWriteCDCRecordDone(
+      const TabletId& tablet_id, const Status& status, const WriteResponsePB& response);
 
   // Increment processed record count.
   // Returns true if all records are processed, false if there are still some pending records.
@@ -184,7 +198,6 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   std::shared_ptr<CDCClient> local_client_;
   ThreadPool* thread_pool_;  // Use threadpool so that callbacks aren't run on reactor threads.
   rpc::Rpcs* rpcs_;
-  rpc::Rpcs::Handle write_handle_ GUARDED_BY(lock_);
   // Retain COMMIT rpcs in-flight as these need to be cleaned up on shutdown
   std::vector<std::shared_ptr<client::ExternalTransaction>> external_transactions_;
   std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk_;
@@ -193,9 +206,18 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
 
   std::shared_ptr<client::YBTable> table_;
 
-  // Used to protect error_status_, op_id_, done_processing_, write_handle_ and record counts.
+  // Used to protect error_status_, op_id_, done_processing_, pending writes and record counts.
   mutable rw_spinlock lock_;
   Status error_status_ GUARDED_BY(lock_);
+
+  // Writes that are not sent yet, per consumer tablet and in the order they must be applied.
+  std::map<TabletId, std::deque<std::unique_ptr<WriteRequestPB>>> pending_writes_
+      GUARDED_BY(lock_);
+  // Consumer tablets with a write in flight. The handle is invalid once the rpc has finished, but
+  // the tablet stays here until the response is handled, so its next write is not sent earlier.
+  std::unordered_map<TabletId, rpc::Rpcs::Handle> write_handles_ GUARDED_BY(lock_);
+  // First failure among the writes of the current set of pending writes.
+  Status write_status_ GUARDED_BY(lock_);
   OpIdPB op_id_ GUARDED_BY(lock_) = consensus::MinimumOpId();
   bool done_processing_ GUARDED_BY(lock_) = false;
   uint32_t wait_for_version_ GUARDED_BY(lock_) = 0;
@@ -465,16 +487,22 @@ Status TwoDCOutputClient::SendTransactionUpdates() {
 
 Status TwoDCOutputClient::SendUserTableWrites() {
   // Send out the buffered writes.
-  std::unique_ptr<WriteRequestPB> write_request;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->GetNextWriteRequest();
-  }
-  if (!write_request) {
-    LOG(WARNING) << "Expected to find a write_request but were unable to";
-    return STATUS(IllegalState, "Could not find a write request to send");
+    DCHECK(pending_writes_.empty());
+    DCHECK(write_handles_.empty());
+    // The write strategy returns the writes of a tablet in order, before those of the next tablet.
+    while (auto write_request = write_strategy_->GetNextWriteRequest()) {
+      auto& tablet_writes = pending_writes_[write_request->tablet_id()];
+      tablet_writes.push_back(std::move(write_request));
+    }
+    if (pending_writes_.empty()) {
+      LOG(WARNING) << "Expected to find a write_request but were unable to";
+      return STATUS(IllegalState, "Could not find a write request to send");
+    }
+    write_status_ = Status::OK();
   }
-  SendNextCDCWriteToTablet(std::move(write_request));
+  SendPendingWrites();
   return Status::OK();
 }
 
@@ -615,85 +643,128 @@ Result<bool> TwoDCOutputClient::ProcessMetaOp(const cdc::CDCRecordPB& record) {
   return done;
 }
 
-void TwoDCOutputClient::SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request) {
-  // TODO: This should be parallelized for better performance with M:N setups.
+void TwoDCOutputClient::SendPendingWrites() {
   auto deadline =
       CoarseMonoClock::Now() + MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
+  const auto max_concurrent_writes = implicit_cast<size_t>(
+      std::max(GetAtomicFlag(&FLAGS_cdc_max_concurrent_apply_write_rpcs), 1));
 
-  std::lock_guard<decltype(lock_)> l(lock_);
-  write_handle_ = rpcs_->Prepare();
-  if (write_handle_ != rpcs_->InvalidHandle()) {
-    // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write request.
-    *write_handle_ = cdc::CreateCDCWriteRpc(
-        deadline,
-        nullptr /* RemoteTablet */,
-        table_,
-        local_client_->client.get(),
-        write_request.get(),
-        std::bind(&TwoDCOutputClient::WriteCDCRecordDone, SharedFromThis(), _1, _2),
-        UseLocalTserver());
-    (**write_handle_).SendRpc();
-  } else {
-    LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
+  std::vector<rpc::RpcCommandPtr> rpcs_to_send;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    for (auto it = pending_writes_.begin();
+         it != pending_writes_.end() && write_handles_.size() < max_concurrent_writes;) {
+      const auto& tablet_id = it->first;
+      if (write_handles_.count(tablet_id)) {
+        ++it;
+        continue;
+      }
+      auto write_request = std::move(it->second.front());
+      it->second.pop_front();
+      auto handle = rpcs_->Prepare();
+      if (handle != rpcs_->InvalidHandle()) {
+        // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write
+        // request.
+        *handle = cdc::CreateCDCWriteRpc(
+            deadline,
+            nullptr /* RemoteTablet */,
+            table_,
+            local_client_->client.get(),
+            write_request.get(),
+            std::bind(&TwoDCOutputClient::WriteCDCRecordDone, SharedFromThis(), tablet_id, _1, _2),
+            UseLocalTserver());
+        rpcs_to_send.push_back(*handle);
+        write_handles_.emplace(tablet_id, handle);
+      } else {
+        LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << tablet_id;
+      }
+      if (it->second.empty()) {
+        it = pending_writes_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  for (const auto& rpc : rpcs_to_send) {
+    rpc->SendRpc();
   }
 }
 
-void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response) {
+void TwoDCOutputClient::WriteCDCRecordDone(
+    const TabletId& tablet_id, const Status& status, const WriteResponsePB& response) {
   rpc::RpcCommandPtr retained;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    retained = rpcs_->Unregister(&write_handle_);
+    auto it = write_handles_.find(tablet_id);
+    if (it != write_handles_.end()) {
+      retained = rpcs_->Unregister(&it->second);
+    }
   }
   RETURN_WHEN_OFFLINE();
 
   WARN_NOT_OK(
       thread_pool_->SubmitFunc(std::bind(
-          &TwoDCOutputClient::DoWriteCDCRecordDone, SharedFromThis(), status, std::move(response))),
+          &TwoDCOutputClient::DoWriteCDCRecordDone, SharedFromThis(), tablet_id, status,
+          std::move(response))),
       "Could not submit DoWriteCDCRecordDone to thread pool");
 }
 
 void TwoDCOutputClient::DoWriteCDCRecordDone(
-    const Status& status, const WriteResponsePB& response) {
+    const TabletId& tablet_id, const Status& status, const WriteResponsePB& response) {
   RETURN_WHEN_OFFLINE();
 
-  if (!status.ok()) {
-    HandleError(status);
-    return;
-  } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()));
-    return;
+  auto write_status = status;
+  if (write_status.ok() && response.has_error()) {
+    write_status = StatusFromPB(response.error().status());
+  }
+  if (write_status.ok()) {
+    cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
   }
-  cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
 
   // See if we need to handle any more writes.
-  std::unique_ptr<WriteRequestPB> write_request;
+  bool writes_done;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->GetNextWriteRequest();
+    write_handles_.erase(tablet_id);
+    if (!write_status.ok()) {
+      // Do not send anything else, the whole response is applied again after the error.
+      pending_writes_.clear();
+      if (write_status_.ok()) {
+        write_status_ = write_status;
+      }
+    }
+    writes_done = pending_writes_.empty() && write_handles_.empty();
+    write_status = write_status_;
   }
 
-  if (write_request) {
-    SendNextCDCWriteToTablet(std::move(write_request));
-  } else {
-    // We may still have more records to process (in case of ddls/master requests).
-    int next_record = 0;
-    {
-      SharedLock<decltype(lock_)> l(lock_);
-      if (processed_record_count_ < record_count_) {
-        // processed_record_count_ is 1-based, so no need to add 1 to get next record.
-        next_record = processed_record_count_;
-      }
+  if (!writes_done) {
+    SendPendingWrites();
+    return;
+  }
+  if (!write_status.ok()) {
+    HandleError(write_status);
+    return;
+  }
+
+  // We may still have more records to process (in case of ddls/master requests).
+  int next_record = 0;
+  {
+    SharedLock<decltype(lock_)> l(lock_);
+    if (processed_record_count_ < record_count_) {
+      // processed_record_count_ is 1-based, so no need to add 1 to get next record.
+      next_record = processed_record_count_;
     }
-    if (next_record > 0) {
-      // Process rest of the records.
-      Status s = ProcessChangesStartingFromIndex(next_record);
-      if (!s.ok()) {
-        HandleError(s);
-      }
-    } else {
-      // Last record, return response to caller.
-      HandleResponse();
+  }
+  if (next_record > 0) {
+    // Process rest of the records.
+    Status s = ProcessChangesStartingFromIndex(next_record);
+    if (!s.ok()) {
+      HandleError(s);
     }
+  } else {
+    // Last record, return response to caller.
+    HandleResponse();
   }
 }
 
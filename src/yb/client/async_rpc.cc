@@ -706,6 +706,10 @@ void WriteRpc::NotifyBatcher(const Status& status) {
   batcher_->ProcessWriteResponse(*this, status);
 }
 
+HybridTime ReadRpc::RequestedReadTime() const {
+  return req_.has_read_time() ? HybridTime(req_.read_time().read_ht()) : HybridTime::kInvalid;
+}
+
 ReadRpc::ReadRpc(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_level)
     : AsyncRpcBase(data, yb_consistency_level) {
   TRACE_TO(trace_, "ReadRpc initiated");
@@ -187,6 +187,8 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
 
   virtual ~ReadRpc();
 
+  HybridTime RequestedReadTime() const override;
+
  private:
   Status SwapResponses() override;
   void CallRemoteMethod() override;
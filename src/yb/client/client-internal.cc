@@ -105,6 +105,19 @@ DEFINE_test_flag(string, assert_tablet_server_select_is_in_zone, "",
                  "Verify that SelectTServer selected a talet server in the AZ specified by this "
                  "flag.");
 
+DEFINE_RUNTIME_bool(latency_aware_replica_selection, false,
+    "When selecting the closest replica, for example for follower reads, choose a farther replica "
+    "when its recent average response time is lower than the one of the closest replica by "
+    "latency_aware_replica_selection_min_speedup times. Replicas without recent responses are "
+    "never chosen for their response time, and the closest replica is used again once its "
+    "response time is no longer recent, so that it gets measured again.");
+TAG_FLAG(latency_aware_replica_selection, advanced);
+
+DEFINE_RUNTIME_double(latency_aware_replica_selection_min_speedup, 2.0,
+    "How many times lower the average response time of a replica should be than the one of the "
+    "closest replica for latency_aware_replica_selection to choose it.");
+TAG_FLAG(latency_aware_replica_selection_min_speedup, advanced);
+
 DECLARE_int64(reset_master_leader_timeout_ms);
 
 DECLARE_string(flagfile);
@@ -304,6 +317,32 @@ YBClient::Data::~Data() {
   rpcs_.Shutdown();
 }
 
+RemoteTabletServer* YBClient::Data::SelectFasterTServer(
+    RemoteTabletServer* closest, const std::vector<RemoteTabletServer*>& candidates) {
+  // Without a recent response time of the closest replica, use it to measure it again.
+  const auto closest_response_time = closest->RecentAverageResponseTime();
+  if (closest_response_time == MonoDelta::kZero) {
+    return closest;
+  }
+  auto* fastest = closest;
+  auto fastest_response_time = closest_response_time;
+  for (auto* rts : candidates) {
+    const auto response_time = rts->RecentAverageResponseTime();
+    if (response_time != MonoDelta::kZero && response_time < fastest_response_time) {
+      fastest = rts;
+      fastest_response_time = response_time;
+    }
+  }
+  if (fastest_response_time.ToSeconds() * FLAGS_latency_aware_replica_selection_min_speedup <
+          closest_response_time.ToSeconds()) {
+    VLOG(2) << "Selected " << fastest->permanent_uuid() << " responding in "
+            << fastest_response_time << " instead of " << closest->permanent_uuid()
+            << " responding in " << closest_response_time;
+    return fastest;
+  }
+  return closest;
+}
+
 RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
                                                   const ReplicaSelection selection,
                                                   const set<string>& blacklist,
@@ -371,6 +410,10 @@ RemoteTabletServer* YBClient::Data::SelectTServer(RemoteTablet* rt,
         if (ret == nullptr && !filtered.empty()) {
           ret = filtered[rand() % filtered.size()];
         }
+
+        if (ret != nullptr && FLAGS_latency_aware_replica_selection) {
+          ret = SelectFasterTServer(ret, filtered);
+        }
       }
       break;
     }
@@ -337,6 +337,13 @@ class YBClient::Data {
       const std::set<std::string>& blacklist,
       std::vector<internal::RemoteTabletServer*>* candidates);
 
+  // Returns the candidate with the lowest recent average response time when it responds
+  // latency_aware_replica_selection_min_speedup times faster than the closest replica, otherwise
+  // returns the closest replica.
+  internal::RemoteTabletServer* SelectFasterTServer(
+      internal::RemoteTabletServer* closest,
+      const std::vector<internal::RemoteTabletServer*>& candidates);
+
   // Sets 'master_proxy_' from the address specified by
   // 'leader_master_hostport_'.  Called by
   // GetLeaderMasterRpc::Finished() upon successful completion.
@@ -446,6 +453,8 @@ class YBClient::Data {
 
   rpc::Messenger* messenger_ = nullptr;
   std::unique_ptr<rpc::Messenger> messenger_holder_;
+  // Set when messenger_ is shared with other clients, see ybclient_share_messenger.
+  std::shared_ptr<rpc::Messenger> shared_messenger_;
   std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   scoped_refptr<internal::MetaCache> meta_cache_;
   scoped_refptr<MetricEntity> metric_entity_;
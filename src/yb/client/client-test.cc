@@ -63,6 +63,7 @@
 #include "yb/common/schema.h"
 #include "yb/common/wire_protocol.h"
 
+#include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus.proxy.h"
 
 #include "yb/gutil/algorithm.h"
@@ -88,6 +89,7 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
@@ -114,6 +116,8 @@
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_bool(log_inject_latency);
+DECLARE_bool(tserver_send_leader_hint);
+DECLARE_bool(ybclient_share_messenger);
 DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(heartbeat_interval_ms);
 DECLARE_int32(log_inject_latency_ms_mean);
@@ -786,6 +790,23 @@ TEST_F(ClientTest, TestListTabletServers) {
   ASSERT_EQ(expected_ts_hostnames, actual_ts_hostnames);
 }
 
+TEST_F(ClientTest, SharedMessenger) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ybclient_share_messenger) = true;
+  auto build_client = [this] {
+    return YBClientBuilder()
+        .add_master_server_addr(yb::ToString(cluster_->mini_master()->bound_rpc_addr()))
+        .Build();
+  };
+  auto client1 = ASSERT_RESULT(build_client());
+  auto client2 = ASSERT_RESULT(build_client());
+  ASSERT_EQ(client1->messenger(), client2->messenger());
+  ASSERT_NE(client_->messenger(), client1->messenger());
+
+  // Messenger should stay usable by remaining client, after other one is destroyed.
+  client1.reset();
+  ASSERT_EQ(ASSERT_RESULT(client2->ListTabletServers()).size(), 3);
+}
+
 bool TableNotFound(const Status& status) {
   return status.IsNotFound()
          && (master::MasterError(status) == master::MasterErrorPB::OBJECT_NOT_FOUND);
@@ -2363,6 +2384,58 @@ TEST_F(ClientTest, TestReadFromFollower) {
   }
 }
 
+// A follower that rejects a write with NOT_THE_LEADER returns the leader it knows about, and the
+// client should retry on that replica right away instead of guessing among the others.
+TEST_F(ClientTest, NotTheLeaderHint) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tserver_send_leader_hint) = true;
+
+  ASSERT_NO_FATALS(InsertTestRows(client_table2_, 1));
+  auto remote_tablet = ASSERT_RESULT(
+      LookupFirstTabletFuture(client_.get(), client_table2_.table()).get());
+  auto* leader = remote_tablet->LeaderTServer();
+  ASSERT_NOTNULL(leader);
+
+  auto peers = ASSERT_RESULT(ListTabletPeers(cluster_.get(), remote_tablet->tablet_id()));
+  ASSERT_EQ(peers.size(), cluster_->num_tablet_servers());
+  ASSERT_OK(WaitFor([&peers, leader] {
+    for (const auto& peer : peers) {
+      auto consensus = peer->shared_consensus();
+      if (!consensus || consensus->ConsensusState(
+              consensus::CONSENSUS_CONFIG_ACTIVE).leader_uuid() != leader->permanent_uuid()) {
+        return false;
+      }
+    }
+    return true;
+  }, 10s * kTimeMultiplier, "All peers know the leader"));
+
+  internal::RemoteTabletServer* follower = nullptr;
+  for (auto* ts : remote_tablet->GetRemoteTabletServers()) {
+    if (ts != leader) {
+      follower = ts;
+      break;
+    }
+  }
+  ASSERT_NOTNULL(follower);
+  // Make the client believe that the follower is the leader.
+  ASSERT_TRUE(remote_tablet->MarkTServerAsLeader(follower));
+
+  auto not_leader_rejections = [&peers] {
+    int64_t result = 0;
+    for (const auto& peer : peers) {
+      result += peer->shared_tablet()->metrics()->not_leader_rejections->value();
+    }
+    return result;
+  };
+  auto rejections_before = not_leader_rejections();
+
+  ASSERT_NO_FATALS(InsertTestRows(client_table2_, 1, 1));
+
+  // Only the follower the client was pointed at rejected the write, the hint was used to reach
+  // the leader on the next attempt.
+  ASSERT_EQ(not_leader_rejections() - rejections_before, 1);
+  ASSERT_EQ(remote_tablet->LeaderTServer(), leader);
+}
+
 TEST_F(ClientTest, Capability) {
   constexpr CapabilityId kFakeCapability = 0x9c40e9a7;
 
@@ -2640,6 +2713,65 @@ TEST_F(ClientTest, RefreshPartitions) {
   LOG(INFO) << "num_lookups_done: " << num_lookups_done;
 }
 
+// Lookups by key of several clients must return the tablet serving the key while the tables
+// snapshots of their meta caches are being replaced.
+TEST_F(ClientTest, ConcurrentLookupsWithInvalidation) {
+  const auto kLookupTimeout = 10s * kTimeMultiplier;
+  const auto kNumLookupThreads = 4;
+  const auto kTestTime = 10s;
+
+  auto other_client = ASSERT_RESULT(YBClientBuilder()
+      .add_master_server_addr(yb::ToString(cluster_->mini_master()->bound_rpc_addr()))
+      .Build());
+  auto other_table = ASSERT_RESULT(other_client->OpenTable(kTableName));
+  const std::vector<std::pair<YBClient*, YBTablePtr>> clients = {
+    {client_.get(), client_table_.table()},
+    {other_client.get(), other_table},
+  };
+  const std::vector<internal::MetaCache*> meta_caches = {
+    client_->data_->meta_cache_.get(),
+    other_client->data_->meta_cache_.get(),
+  };
+
+  TestThreadHolder thread_holder;
+  std::atomic<size_t> num_lookups{0};
+  for (int i = 0; i != kNumLookupThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [&stop = thread_holder.stop_flag(), &clients, &num_lookups, kLookupTimeout] {
+      while (!stop.load(std::memory_order_acquire)) {
+        for (const auto& [client, table] : clients) {
+          const auto hash_code = RandomUniformInt<uint16_t>(0, PartitionSchema::kMaxPartitionKey);
+          const auto partition_key = PartitionSchema::EncodeMultiColumnHashValue(hash_code);
+          auto tablet = client->LookupTabletByKeyFuture(
+              table, partition_key, CoarseMonoClock::now() + kLookupTimeout).get();
+          if (!tablet.ok()) {
+            // Lookups that raced with the invalidation are retried by the callers.
+            ASSERT_TRUE(tablet.status().IsTryAgain()) << tablet.status();
+            continue;
+          }
+          ASSERT_TRUE((*tablet)->partition().ContainsKey(partition_key))
+              << "Tablet " << (*tablet)->tablet_id() << " does not contain key "
+              << Slice(partition_key).ToDebugHexString();
+          num_lookups.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  thread_holder.AddThreadFunctor([&stop = thread_holder.stop_flag(), &meta_caches, &other_table] {
+    while (!stop.load(std::memory_order_acquire)) {
+      for (auto* meta_cache : meta_caches) {
+        meta_cache->InvalidateTableCache(*other_table);
+      }
+      std::this_thread::sleep_for(10ms);
+    }
+  });
+
+  thread_holder.WaitAndStop(kTestTime);
+  LOG(INFO) << "Lookups done: " << num_lookups.load();
+  ASSERT_GT(num_lookups.load(), 0);
+}
+
 // There should be only one lookup RPC asking for colocated tables tablet locations.
 // When we ask for tablet lookup for other tables colocated with the first one we asked, MetaCache
 // should be able to respond without sending RPCs to master again.
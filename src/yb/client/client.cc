@@ -110,6 +110,7 @@
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/strongly_typed_bool.h"
+#include "yb/util/thread.h"
 
 #include "yb/yql/cql/ql/ptree/pt_option.h"
 
@@ -232,6 +233,13 @@ DEFINE_UNKNOWN_int32(backfill_index_client_rpc_timeout_ms, kDefaultBackfillIndex
              "Timeout for BackfillIndex RPCs from client to master.");
 TAG_FLAG(backfill_index_client_rpc_timeout_ms, advanced);
 
+DEFINE_NON_RUNTIME_bool(ybclient_share_messenger, false,
+    "Whether clients that are built without an explicit messenger use a single messenger shared "
+    "by all such clients of the process, instead of creating their own. Outbound calls of all of "
+    "them to the same server then go through the same num_connections_to_server connections. "
+    "The shared messenger is configured by the first client that creates it.");
+TAG_FLAG(ybclient_share_messenger, advanced);
+
 DEFINE_RUNTIME_int32(ycql_num_tablets, -1,
     "The number of tablets per YCQL table. Default value is -1. "
     "Colocated tables are not affected. "
@@ -453,6 +461,42 @@ YBClientBuilder& YBClientBuilder::AddMasterAddressSource(const MasterAddressSour
   return *this;
 }
 
+namespace {
+
+// Returns messenger shared by clients when ybclient_share_messenger is set, creating it if
+// necessary. The messenger is shut down when the last client that uses it releases it.
+Result<std::shared_ptr<rpc::Messenger>> SharedClientMessenger(
+    int32_t num_reactors, const scoped_refptr<MetricEntity>& metric_entity,
+    const std::shared_ptr<MemTracker>& parent_mem_tracker) {
+  static std::mutex mutex;
+  static std::weak_ptr<rpc::Messenger> shared_messenger;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto result = shared_messenger.lock();
+  if (result) {
+    return result;
+  }
+  auto messenger = VERIFY_RESULT(client::CreateClientMessenger(
+      "shared_ybclient", num_reactors, metric_entity, parent_mem_tracker));
+  result = std::shared_ptr<rpc::Messenger>(messenger.release(), [](rpc::Messenger* messenger) {
+    // The last client could be destroyed by a callback running on a reactor of this messenger,
+    // and a reactor thread cannot wait for the reactors to stop.
+    auto shutdown = [messenger] {
+      messenger->Shutdown();
+      delete messenger;
+    };
+    auto thread = Thread::Make("client", "shared_messenger_shutdown", shutdown);
+    if (!thread.ok()) {
+      LOG(DFATAL) << "Failed to start shared messenger shutdown thread: " << thread.status();
+      shutdown();
+    }
+  });
+  shared_messenger = result;
+  return result;
+}
+
+} // namespace
+
 Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBClient>* client) {
   RETURN_NOT_OK(CheckCPUFlags());
 
@@ -462,6 +506,10 @@ Status YBClientBuilder::DoBuild(rpc::Messenger* messenger, std::unique_ptr<YBCli
   if (messenger) {
     c->data_->messenger_holder_ = nullptr;
     c->data_->messenger_ = messenger;
+  } else if (FLAGS_ybclient_share_messenger) {
+    c->data_->shared_messenger_ = VERIFY_RESULT(SharedClientMessenger(
+        data_->num_reactors_, data_->metric_entity_, data_->parent_mem_tracker_));
+    c->data_->messenger_ = c->data_->shared_messenger_.get();
   } else {
     c->data_->messenger_holder_ = VERIFY_RESULT(client::CreateClientMessenger(
         data_->client_name_, data_->num_reactors_,
@@ -557,6 +605,9 @@ void YBClient::Shutdown() {
   data_->StartShutdown();
   if (data_->messenger_holder_) {
     data_->messenger_holder_->Shutdown();
+  } else if (data_->shared_messenger_) {
+    // Other clients keep using the messenger, so abort the calls and tasks of this client only.
+    data_->rpcs_.Shutdown();
   }
   if (data_->threadpool_) {
     data_->threadpool_->Shutdown();
@@ -1909,6 +1960,10 @@ const CloudInfoPB& YBClient::cloud_info() const {
   return data_->cloud_info_pb_;
 }
 
+void YBClient::PreserveZoneLocalLeadersOnly(std::vector<const TabletId*>* tablet_ids) {
+  data_->meta_cache_->PreserveZoneLocalLeadersOnly(data_->cloud_info_pb_, tablet_ids);
+}
+
 std::pair<RetryableRequestId, RetryableRequestId> YBClient::NextRequestIdAndMinRunningRequestId() {
   std::lock_guard<simple_spinlock> lock(data_->tablet_requests_mutex_);
   auto& requests = data_->requests_;
@@ -794,6 +794,10 @@ class YBClient {
 
   const CloudInfoPB& cloud_info() const;
 
+  // Removes from tablet_ids the tablets whose leader is not known to be in the zone of this
+  // client. Uses cached tablet locations only, so does not send any RPC.
+  void PreserveZoneLocalLeadersOnly(std::vector<const TabletId*>* tablet_ids);
+
   std::pair<RetryableRequestId, RetryableRequestId> NextRequestIdAndMinRunningRequestId();
 
   void RequestsFinished(const std::set<RetryableRequestId>& request_ids);
@@ -824,6 +828,7 @@ class YBClient {
   friend class internal::ClientMasterRpcBase;
   friend class PlacementInfoTest;
 
+  FRIEND_TEST(ClientTest, ConcurrentLookupsWithInvalidation);
   FRIEND_TEST(ClientTest, TestGetTabletServerBlacklist);
   FRIEND_TEST(ClientTest, TestMasterDown);
   FRIEND_TEST(ClientTest, TestMasterLookupPermits);
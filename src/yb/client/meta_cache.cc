@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <list>
 #include <memory>
@@ -58,6 +59,7 @@
 
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/ref_counted.h"
+#include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/master/master_client.proxy.h"
@@ -116,6 +118,34 @@ DEFINE_test_flag(double, simulate_lookup_timeout_probability, 0,
 DEFINE_test_flag(double, simulate_lookup_partition_list_mismatch_probability, 0,
                  "Probability for simulating the partition list mismatch error on tablet lookup.");
 
+DEFINE_RUNTIME_bool(client_adaptive_concurrency_limit, false,
+    "Limit the number of requests in flight from this client to each tablet server with an "
+    "additive increase, multiplicative decrease limit fed by rejections and response times. "
+    "Requests over the limit are held by the client and retried with backoff.");
+TAG_FLAG(client_adaptive_concurrency_limit, advanced);
+
+DEFINE_RUNTIME_int32(client_concurrency_limit_initial, 64,
+    "Initial number of requests in flight to a tablet server when "
+    "client_adaptive_concurrency_limit is set.");
+TAG_FLAG(client_concurrency_limit_initial, advanced);
+
+DEFINE_RUNTIME_int32(client_concurrency_limit_min, 4,
+    "Lower bound of the adaptive concurrency limit to a tablet server.");
+TAG_FLAG(client_concurrency_limit_min, advanced);
+
+DEFINE_RUNTIME_int32(client_concurrency_limit_max, 1024,
+    "Upper bound of the adaptive concurrency limit to a tablet server.");
+TAG_FLAG(client_concurrency_limit_max, advanced);
+
+DEFINE_RUNTIME_double(client_concurrency_limit_backoff_ratio, 0.5,
+    "Factor applied to the adaptive concurrency limit of a tablet server when it is overloaded.");
+TAG_FLAG(client_concurrency_limit_backoff_ratio, advanced);
+
+DEFINE_RUNTIME_double(client_concurrency_limit_latency_factor, 2.0,
+    "A response slower than this many times the average response time of the tablet server is "
+    "treated as a sign of overload by the adaptive concurrency limit. 0 to only use rejections.");
+TAG_FLAG(client_concurrency_limit_latency_factor, advanced);
+
 METRIC_DEFINE_coarse_histogram(
   server, dns_resolve_latency_during_init_proxy,
   "yb.client.MetaCache.InitProxy DNS Resolve",
@@ -156,6 +186,63 @@ const size_t kPartitionGroupSize = 4;
 
 std::atomic<int64_t> lookup_serial_{1};
 
+std::atomic<uint64_t> meta_cache_instance_serial{0};
+
+// Weight of the latest sample in the average response time of a tablet server.
+constexpr double kResponseTimeSmoothingFactor = 0.2;
+
+// Time after which the average response time of a tablet server that got no responses is no longer
+// considered recent.
+const MonoDelta kResponseTimeExpiration = MonoDelta::FromSeconds(10);
+
+// Returns the tablet if it is not stale and its partition contains partition_start_key.
+RemoteTabletPtr UsableTabletForPartitionStart(
+    const RemoteTabletPtr& tablet, const PartitionKey& partition_start_key) {
+  // Stale entries must be re-fetched.
+  if (!tablet || tablet->stale()) {
+    return nullptr;
+  }
+
+  if (tablet->partition().partition_key_end().compare(partition_start_key) > 0 ||
+      tablet->partition().partition_key_end().empty()) {
+    // partition_start_key < partition.end OR tablet does not end.
+    return tablet;
+  }
+
+  return nullptr;
+}
+
+// Returns the cached tablet serving the partition starting at partition_start_key, if it can be
+// used for the partition list version the key was computed with.
+RemoteTabletPtr FindTabletByPartitionStart(
+    PartitionListVersion cached_partition_list_version,
+    const std::map<PartitionKey, RemoteTabletPtr>& tablets_by_partition,
+    const VersionedPartitionStartKey& versioned_partition_start_key) {
+  if (PREDICT_FALSE(
+          cached_partition_list_version != versioned_partition_start_key.partition_list_version)) {
+    // TableData::partition_list version in cache does not match partition_list_version used to
+    // calculate partition_key_start, can't use cache.
+    return nullptr;
+  }
+
+  const auto& partition_start_key = *versioned_partition_start_key.key;
+
+  auto tablet_it = tablets_by_partition.find(partition_start_key);
+  if (PREDICT_FALSE(tablet_it == tablets_by_partition.end())) {
+    // No tablets with a start partition key lower than 'partition_key'.
+    return nullptr;
+  }
+
+  return UsableTabletForPartitionStart(tablet_it->second, partition_start_key);
+}
+
+// Returns the index of partition_start_key in partitions, or partitions.size() if it is not the
+// start of any partition.
+size_t PartitionStartIndex(const TablePartitionList& partitions, const PartitionKey& key) {
+  auto it = std::lower_bound(partitions.begin(), partitions.end(), key);
+  return it != partitions.end() && *it == key ? it - partitions.begin() : partitions.size();
+}
+
 } // namespace
 
 int64_t TEST_GetLookupSerial() {
@@ -302,6 +389,87 @@ std::string RemoteTabletServer::TEST_PlacementZone() const {
   return cloud_info_pb_.placement_zone();
 }
 
+void RemoteTabletServer::RecordResponseTime(MonoDelta response_time) {
+  const auto sample_us = std::max<int64_t>(response_time.ToMicroseconds(), 1);
+  // An average that is no longer recent does not describe the server anymore, start over.
+  const auto average_us = RecentAverageResponseTime().ToMicroseconds();
+  // Concurrent updates could lose a sample, that is fine for an estimate.
+  average_response_time_us_.store(
+      average_us == 0 ? sample_us
+                      : static_cast<int64_t>(
+                            average_us * (1 - kResponseTimeSmoothingFactor) +
+                            sample_us * kResponseTimeSmoothingFactor),
+      std::memory_order_relaxed);
+  last_response_time_update_.store(MonoTime::Now(), std::memory_order_release);
+}
+
+MonoDelta RemoteTabletServer::AverageResponseTime() const {
+  return MonoDelta::FromMicroseconds(average_response_time_us_.load(std::memory_order_relaxed));
+}
+
+MonoDelta RemoteTabletServer::RecentAverageResponseTime() const {
+  const auto last_update = last_response_time_update_.load(std::memory_order_acquire);
+  if (MonoTime::Now() - last_update > kResponseTimeExpiration) {
+    return MonoDelta::kZero;
+  }
+  return AverageResponseTime();
+}
+
+RequestSlot RemoteTabletServer::TryAcquireRequestSlot() {
+  if (!FLAGS_client_adaptive_concurrency_limit) {
+    return RequestSlot::kNotLimited;
+  }
+  auto limit = concurrency_limit_.load(std::memory_order_relaxed);
+  if (limit == 0) {
+    limit = FLAGS_client_concurrency_limit_initial;
+    double expected = 0;
+    if (!concurrency_limit_.compare_exchange_strong(expected, limit)) {
+      limit = expected;
+    }
+  }
+  if (requests_in_flight_.fetch_add(1, std::memory_order_acq_rel) >= limit) {
+    requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+    return RequestSlot::kLimitReached;
+  }
+  return RequestSlot::kAcquired;
+}
+
+void RemoteTabletServer::ReleaseRequestSlot(MonoDelta response_time, bool overloaded) {
+  requests_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+
+  const auto latency_factor = FLAGS_client_concurrency_limit_latency_factor;
+  if (!overloaded && latency_factor > 0) {
+    const auto average = AverageResponseTime();
+    overloaded = average.ToMicroseconds() > 0 &&
+                 response_time.ToSeconds() > average.ToSeconds() * latency_factor;
+  }
+
+  const double min_limit = std::max(FLAGS_client_concurrency_limit_min, 1);
+  const double max_limit = std::max<double>(FLAGS_client_concurrency_limit_max, min_limit);
+  auto limit = concurrency_limit_.load(std::memory_order_relaxed);
+  if (overloaded) {
+    // All requests in flight see the same overload, so only back off once per response time.
+    const auto now = MonoTime::Now();
+    auto last_decrease = last_concurrency_limit_decrease_.load(std::memory_order_acquire);
+    if (now - last_decrease < std::max(response_time, AverageResponseTime()) ||
+        !last_concurrency_limit_decrease_.compare_exchange_strong(last_decrease, now)) {
+      return;
+    }
+    const auto new_limit = std::max(
+        min_limit, limit * FLAGS_client_concurrency_limit_backoff_ratio);
+    VLOG_WITH_FUNC(1) << "Reducing concurrency limit of " << permanent_uuid() << " from " << limit
+                      << " to " << new_limit;
+    concurrency_limit_.store(new_limit, std::memory_order_relaxed);
+    return;
+  }
+  // Concurrent updates could lose an increment, that is fine for an estimate.
+  concurrency_limit_.store(std::min(max_limit, limit + 1 / limit), std::memory_order_relaxed);
+}
+
+double RemoteTabletServer::ConcurrencyLimit() const {
+  return concurrency_limit_.load(std::memory_order_relaxed);
+}
+
 std::string ReplicasCount::ToString() {
   return Format(
       " live replicas $0, read replicas $1, expected live replicas $2, expected read replicas $3",
@@ -671,6 +839,7 @@ void LookupCallbackVisitor::operator()(
 
 MetaCache::MetaCache(YBClient* client)
   : client_(client),
+    instance_id_(meta_cache_instance_serial.fetch_add(1, std::memory_order_relaxed) + 1),
     master_lookup_sem_(FLAGS_max_concurrent_master_lookups),
     log_prefix_(Format("MetaCache($0)(client_id: $1): ", static_cast<void*>(this), client_->id())) {
 }
@@ -948,6 +1117,17 @@ Status MetaCache::ProcessTabletLocations(
   {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
     ProcessedTablesMap processed_tables;
+    auto update_snapshot = ScopeExit(
+        [this, &processed_tables, &locations]() NO_THREAD_SAFETY_ANALYSIS {
+      std::unordered_map<TableId, std::vector<PartitionKey>> changed_partitions;
+      for (const auto& processed_table : processed_tables) {
+        auto& partitions = changed_partitions[processed_table.first];
+        for (const auto& loc : locations) {
+          partitions.push_back(loc.partition().partition_key_start());
+        }
+      }
+      UpdateTablesSnapshotUnlocked(changed_partitions);
+    });
 
     for (const TabletLocationsPB& loc : locations) {
       auto remote = VERIFY_RESULT(ProcessTabletLocation(
@@ -1176,6 +1356,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    UpdateTablesSnapshotUnlocked({{table_id, {}}});
   }
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
@@ -1765,39 +1946,14 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
 
   const auto& table_data = it->second;
 
-  if (PREDICT_FALSE(
-          table_data.partition_list->version !=
-          versioned_partition_start_key.partition_list_version)) {
-    // TableData::partition_list version in cache does not match partition_list_version used to
-    // calculate partition_key_start, can't use cache.
-    return nullptr;
-  }
-
-  const auto& partition_start_key = *versioned_partition_start_key.key;
-
-  DCHECK_EQ(
-      partition_start_key,
-      *client::FindPartitionStart(table_data.partition_list, partition_start_key));
-  auto tablet_it = table_data.tablets_by_partition.find(partition_start_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
-    // No tablets with a start partition key lower than 'partition_key'.
-    return nullptr;
-  }
-
-  const auto& result = tablet_it->second;
-
-  // Stale entries must be re-fetched.
-  if (result->stale()) {
-    return nullptr;
-  }
-
-  if (result->partition().partition_key_end().compare(partition_start_key) > 0 ||
-      result->partition().partition_key_end().empty()) {
-    // partition_start_key < partition.end OR tablet does not end.
-    return result;
-  }
-
-  return nullptr;
+  DCHECK(table_data.partition_list->version !=
+             versioned_partition_start_key.partition_list_version ||
+         *versioned_partition_start_key.key ==
+             *client::FindPartitionStart(
+                 table_data.partition_list, *versioned_partition_start_key.key));
+  return FindTabletByPartitionStart(
+      table_data.partition_list->version, table_data.tablets_by_partition,
+      versioned_partition_start_key);
 }
 
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
@@ -1835,6 +1991,152 @@ RemoteTabletPtr MetaCache::FastLookupTabletByKeyUnlocked(
   return nullptr;
 }
 
+RemoteTabletPtr MetaCache::FastLookupTabletByKeyInSnapshot(
+    const TableId& table_id, const VersionedPartitionStartKey& partition_start) {
+  auto snapshot = GetTablesSnapshot();
+  if (!snapshot) {
+    return nullptr;
+  }
+  const auto* table_snapshot = snapshot->Find(table_id);
+  if (!table_snapshot ||
+      table_snapshot->partition_list->version != partition_start.partition_list_version) {
+    return nullptr;
+  }
+  const auto& partitions = table_snapshot->partition_list->keys;
+  auto idx = PartitionStartIndex(partitions, *partition_start.key);
+  if (idx == partitions.size()) {
+    return nullptr;
+  }
+  auto result = UsableTabletForPartitionStart(table_snapshot->tablet(idx), *partition_start.key);
+  if (result && result->HasLeader()) {
+    VLOG_WITH_PREFIX(5) << "Fast lookup in snapshot: found tablet " << result->tablet_id();
+    return result;
+  }
+
+  return nullptr;
+}
+
+const TablePartitionsSnapshot* TablesSnapshot::Find(const TableId& table_id) const {
+  const auto& shard = shards[ShardIndex(table_id)];
+  if (!shard) {
+    return nullptr;
+  }
+  auto it = shard->find(table_id);
+  return it != shard->end() ? it->second.get() : nullptr;
+}
+
+std::shared_ptr<const TablesSnapshot> MetaCache::GetTablesSnapshot() {
+  struct CachedSnapshot {
+    uint64_t version = 0;
+    std::weak_ptr<const TablesSnapshot> snapshot;
+  };
+  // Keyed by MetaCache::instance_id_. Weak references do not keep the snapshots of destroyed
+  // MetaCache instances alive, their entries are removed when this thread refreshes any snapshot.
+  static thread_local std::unordered_map<uint64_t, CachedSnapshot> cached_snapshots;
+
+  auto version = tables_snapshot_version_.load(std::memory_order_acquire);
+  auto& cached_snapshot = cached_snapshots[instance_id_];
+  if (cached_snapshot.version == version) {
+    auto result = cached_snapshot.snapshot.lock();
+    if (result) {
+      return result;
+    }
+  }
+
+  std::shared_ptr<const TablesSnapshot> result;
+  {
+    SharedLock<decltype(mutex_)> lock(mutex_);
+    cached_snapshot.version = tables_snapshot_version_.load(std::memory_order_acquire);
+    result = tables_snapshot_;
+  }
+  cached_snapshot.snapshot = result;
+  for (auto it = cached_snapshots.begin(); it != cached_snapshots.end();) {
+    if (it->second.snapshot.expired()) {
+      it = cached_snapshots.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return result;
+}
+
+void MetaCache::UpdateTablesSnapshotUnlocked(
+    const std::unordered_map<TableId, std::vector<PartitionKey>>& changed_partitions) {
+  if (changed_partitions.empty()) {
+    return;
+  }
+  auto snapshot = tables_snapshot_ ? std::make_shared<TablesSnapshot>(*tables_snapshot_)
+                                   : std::make_shared<TablesSnapshot>();
+  // Shards copied for the new snapshot, only the shards of the changed tables are copied.
+  std::unordered_map<size_t, std::shared_ptr<TablesSnapshot::Shard>> new_shards;
+  for (const auto& [table_id, partitions] : changed_partitions) {
+    auto shard_idx = TablesSnapshot::ShardIndex(table_id);
+    auto& new_shard = new_shards[shard_idx];
+    if (!new_shard) {
+      const auto& old_shard = snapshot->shards[shard_idx];
+      new_shard = old_shard ? std::make_shared<TablesSnapshot::Shard>(*old_shard)
+                            : std::make_shared<TablesSnapshot::Shard>();
+    }
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      new_shard->erase(table_id);
+      continue;
+    }
+    auto& table_snapshot = (*new_shard)[table_id];
+    table_snapshot = UpdateTableSnapshotUnlocked(it->second, table_snapshot.get(), partitions);
+  }
+  for (auto& [shard_idx, shard] : new_shards) {
+    snapshot->shards[shard_idx] = std::move(shard);
+  }
+  tables_snapshot_ = std::move(snapshot);
+  tables_snapshot_version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+std::shared_ptr<const TablePartitionsSnapshot> MetaCache::UpdateTableSnapshotUnlocked(
+    const TableData& table_data, const TablePartitionsSnapshot* previous,
+    const std::vector<PartitionKey>& changed_partitions) {
+  using Chunk = TablePartitionsSnapshot::Chunk;
+  constexpr auto kChunkSize = TablePartitionsSnapshot::kChunkSize;
+
+  auto result = std::make_shared<TablePartitionsSnapshot>();
+  result->partition_list = table_data.partition_list;
+  const auto& partitions = table_data.partition_list->keys;
+
+  if (previous && previous->partition_list == table_data.partition_list &&
+      !changed_partitions.empty()) {
+    result->chunks = previous->chunks;
+    // Chunks copied for the new snapshot, only the chunks of the changed partitions are copied.
+    std::unordered_map<size_t, std::shared_ptr<Chunk>> new_chunks;
+    for (const auto& partition_start : changed_partitions) {
+      auto idx = PartitionStartIndex(partitions, partition_start);
+      if (idx == partitions.size()) {
+        continue;
+      }
+      auto& chunk = new_chunks[idx / kChunkSize];
+      if (!chunk) {
+        chunk = std::make_shared<Chunk>(*result->chunks[idx / kChunkSize]);
+      }
+      (*chunk)[idx % kChunkSize] = FindPtrOrNull(table_data.tablets_by_partition, partition_start);
+    }
+    for (auto& [chunk_idx, chunk] : new_chunks) {
+      result->chunks[chunk_idx] = std::move(chunk);
+    }
+    return result;
+  }
+
+  result->chunks.reserve((partitions.size() + kChunkSize - 1) / kChunkSize);
+  for (size_t chunk_start = 0; chunk_start < partitions.size(); chunk_start += kChunkSize) {
+    auto chunk = std::make_shared<Chunk>();
+    auto chunk_end = std::min(chunk_start + kChunkSize, partitions.size());
+    chunk->reserve(chunk_end - chunk_start);
+    for (auto idx = chunk_start; idx != chunk_end; ++idx) {
+      chunk->push_back(FindPtrOrNull(table_data.tablets_by_partition, partitions[idx]));
+    }
+    result->chunks.push_back(std::move(chunk));
+  }
+  return result;
+}
+
 template <class Mutex>
 bool IsUniqueLock(const std::lock_guard<Mutex>*) {
   return true;
@@ -2018,6 +2320,13 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  auto tablet = FastLookupTabletByKeyInSnapshot(
+      table->id(), {partition_start, table_partition_list->version});
+  if (tablet) {
+    callback(tablet);
+    return;
+  }
+
   PartitionGroupStartKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<std::shared_timed_mutex>>(
           table, table_partition_list, partition_start, deadline, &callback,
@@ -2072,6 +2381,20 @@ std::optional<RemoteTabletPtr> MetaCache::LookupTabletByIdFastPathUnlocked(
   return std::nullopt;
 }
 
+void MetaCache::PreserveZoneLocalLeadersOnly(
+    const CloudInfoPB& cloud_info, std::vector<const TabletId*>* tablet_ids) {
+  SharedLock<std::shared_timed_mutex> lock(mutex_);
+  auto filter = [this, &cloud_info](const TabletId* id) REQUIRES_SHARED(mutex_) {
+    auto tablet = LookupTabletByIdFastPathUnlocked(*id);
+    if (!tablet || !*tablet) {
+      return true;
+    }
+    auto* leader = (*tablet)->LeaderTServer();
+    return !leader || leader->LocalityLevelWith(cloud_info) != LocalityLevel::kZone;
+  };
+  EraseIf(filter, tablet_ids);
+}
+
 template <class Lock>
 bool MetaCache::DoLookupTabletById(
     const TabletId& tablet_id,
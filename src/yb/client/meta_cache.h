@@ -32,6 +32,7 @@
 // This module is internal to the client and not a public API.
 #pragma once
 
+#include <array>
 #include <shared_mutex>
 #include <map>
 #include <string>
@@ -65,6 +66,7 @@
 #include "yb/tserver/tserver_fwd.h"
 
 #include "yb/util/capabilities.h"
+#include "yb/util/enums.h"
 #include "yb/util/format.h"
 #include "yb/util/locks.h"
 #include "yb/util/lockfree.h"
@@ -95,6 +97,10 @@ class LookupByIdRpc;
 using ProcessedTablesMap =
     std::unordered_map<TableId, std::unordered_map<PartitionKey, RemoteTabletPtr>>;
 
+// Outcome of RemoteTabletServer::TryAcquireRequestSlot. Only kAcquired takes a slot that should
+// be returned with ReleaseRequestSlot.
+YB_DEFINE_ENUM(RequestSlot, (kNotLimited)(kAcquired)(kLimitReached));
+
 // The information cached about a given tablet server in the cluster.
 //
 // A RemoteTabletServer could be the local tablet server.
@@ -146,6 +152,30 @@ class RemoteTabletServer {
 
   std::string TEST_PlacementZone() const;
 
+  // Records the time this server took to respond to a request.
+  void RecordResponseTime(MonoDelta response_time);
+
+  // Exponentially weighted moving average of the response time of this server. Zero if nothing
+  // was recorded yet.
+  MonoDelta AverageResponseTime() const;
+
+  // Same as AverageResponseTime, but zero when no response was recorded recently, since an old
+  // average does not describe the current state of the server.
+  MonoDelta RecentAverageResponseTime() const;
+
+  // Takes a slot for a request to this server. Returns kLimitReached when the adaptive
+  // concurrency limit of this server is reached, in which case the request should be held by the
+  // client and tried later. Returns kNotLimited without taking a slot when the limit is disabled.
+  RequestSlot TryAcquireRequestSlot();
+
+  // Returns a slot acquired by TryAcquireRequestSlot and adjusts the limit: it grows by one per
+  // limit successful responses, and shrinks when the server rejected the request as overloaded or
+  // responded much slower than on average.
+  void ReleaseRequestSlot(MonoDelta response_time, bool overloaded);
+
+  // Current concurrency limit, zero if it was not initialized yet.
+  double ConcurrencyLimit() const;
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
@@ -159,6 +189,14 @@ class RemoteTabletServer {
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_ GUARDED_BY(mutex_);
 
+  // Average response time in microseconds as of last_response_time_update_, without decay.
+  std::atomic<int64_t> average_response_time_us_{0};
+  std::atomic<MonoTime> last_response_time_update_{MonoTime::Min()};
+
+  std::atomic<int64_t> requests_in_flight_{0};
+  std::atomic<double> concurrency_limit_{0};
+  std::atomic<MonoTime> last_concurrency_limit_decrease_{MonoTime::Min()};
+
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
 
@@ -469,6 +507,42 @@ struct TableData {
   // miss the key, because it doesn't exist in 1st post-split tablet.
 };
 
+// Immutable copy of the partition to tablet mapping of a cached table. Used to look up tablets by
+// key without taking MetaCache::mutex_.
+//
+// The tablets of the partitions in partition_list are stored in chunks of consecutive partitions,
+// so a new snapshot that differs in a few tablets shares all other chunks with the previous one.
+struct TablePartitionsSnapshot {
+  static constexpr size_t kChunkSize = 64;
+
+  using Chunk = std::vector<RemoteTabletPtr>;
+
+  VersionedTablePartitionListPtr partition_list;
+  std::vector<std::shared_ptr<const Chunk>> chunks;
+
+  // Returns the tablet cached for the partition with the specified index in partition_list.
+  const RemoteTabletPtr& tablet(size_t partition_idx) const {
+    return (*chunks[partition_idx / kChunkSize])[partition_idx % kChunkSize];
+  }
+};
+
+// Immutable copy of the partition to tablet mappings of all cached tables. Tables are split into
+// shards by table id, so a new snapshot that differs in a few tables shares all other shards with
+// the previous one.
+struct TablesSnapshot {
+  static constexpr size_t kNumShards = 64;
+
+  using Shard = std::unordered_map<TableId, std::shared_ptr<const TablePartitionsSnapshot>>;
+
+  std::array<std::shared_ptr<const Shard>, kNumShards> shards;
+
+  static size_t ShardIndex(const TableId& table_id) {
+    return std::hash<TableId>()(table_id) % kNumShards;
+  }
+
+  const TablePartitionsSnapshot* Find(const TableId& table_id) const;
+};
+
 class LookupCallbackVisitor : public boost::static_visitor<> {
  public:
   explicit LookupCallbackVisitor(const LookupCallbackParam& param) : param_(param) {
@@ -543,6 +617,11 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Removes from tablet_ids the tablets whose leader is not known to be in the same zone as
+  // cloud_info. Only consults local information.
+  void PreserveZoneLocalLeadersOnly(
+      const CloudInfoPB& cloud_info, std::vector<const TabletId*>* tablet_ids);
+
   // Return the local tablet server if available.
   RemoteTabletServer* local_tserver() const {
     return local_tserver_;
@@ -636,6 +715,27 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       const TableId& table_id,
       const VersionedPartitionStartKey& partition_start) REQUIRES_SHARED(mutex_);
 
+  // Same as FastLookupTabletByKeyUnlocked, but uses the tables snapshot instead of taking mutex_.
+  RemoteTabletPtr FastLookupTabletByKeyInSnapshot(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_start)
+      EXCLUDES(mutex_);
+
+  // Returns the current tables snapshot. Only takes mutex_ when a new snapshot was published since
+  // the previous call from this thread.
+  std::shared_ptr<const TablesSnapshot> GetTablesSnapshot() EXCLUDES(mutex_);
+
+  // Publishes a new tables snapshot, with the current state of the specified partitions of the
+  // specified tables. An empty list of partitions means all partitions of the table.
+  void UpdateTablesSnapshotUnlocked(
+      const std::unordered_map<TableId, std::vector<PartitionKey>>& changed_partitions)
+      REQUIRES(mutex_);
+
+  // Returns the snapshot of the table with the current state of the specified partitions, sharing
+  // the chunks of other partitions with the previous snapshot of the table if there is one.
+  std::shared_ptr<const TablePartitionsSnapshot> UpdateTableSnapshotUnlocked(
+      const TableData& table_data, const TablePartitionsSnapshot* previous,
+      const std::vector<PartitionKey>& changed_partitions) REQUIRES(mutex_);
+
   // Lookup from cache the set of tablets corresponding to a tiven table.
   // Returns empty vector if the cache is invalid or a tablet is stale,
   // otherwise returns a list of tablets.
@@ -693,6 +793,18 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   // Cache of tablets, keyed by table ID, then by start partition key.
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Copy of tables_ partition to tablet mappings, replaced when they change. Lookups by key keep a
+  // thread local weak reference to it, so the hot path does not take mutex_.
+  std::shared_ptr<const TablesSnapshot> tables_snapshot_ GUARDED_BY(mutex_);
+
+  // Incremented each time tables_snapshot_ is replaced, lets threads detect that their snapshot
+  // is outdated without taking mutex_.
+  std::atomic<uint64_t> tables_snapshot_version_{1};
+
+  // Identifies this MetaCache in the thread local snapshot references. Unlike the address, it is
+  // not reused by MetaCache instances created later.
+  const uint64_t instance_id_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
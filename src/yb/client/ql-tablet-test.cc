@@ -59,6 +59,7 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_retention_policy.h"
 
@@ -112,6 +113,7 @@ DECLARE_double(leader_failure_max_missed_heartbeat_periods);
 DECLARE_int32(TEST_backfill_sabotage_frequency);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
 DECLARE_string(compression_type);
+DECLARE_bool(tablet_track_cpu_time);
 
 namespace yb {
 namespace client {
@@ -682,6 +684,28 @@ TEST_F(QLTabletTest, GCLogWithRestartWithoutWrites) {
   VerifyLogIndicies(cluster_.get());
 }
 
+TEST_F(QLTabletTest, TrackCpuTime) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_track_cpu_time) = true;
+
+  TableHandle table;
+  CreateTable(kTable1Name, &table);
+
+  // Writes and then reads every key.
+  FillTable(0, kTotalKeys, table);
+
+  int64_t read_cpu_time = 0;
+  int64_t write_apply_cpu_time = 0;
+  for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+    auto* metrics = peer->tablet()->metrics();
+    read_cpu_time += metrics->read_cpu_time->value();
+    write_apply_cpu_time += metrics->write_apply_cpu_time->value();
+  }
+  LOG(INFO) << "Read CPU time: " << read_cpu_time << "us, write apply CPU time: "
+            << write_apply_cpu_time << "us";
+  ASSERT_GT(read_cpu_time, 0);
+  ASSERT_GT(write_apply_cpu_time, 0);
+}
+
 TEST_F(QLTabletTest, LeaderLease) {
   SetAtomicFlag(false, &FLAGS_enable_lease_revocation);
 
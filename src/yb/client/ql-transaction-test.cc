@@ -28,6 +28,8 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/log.h"
 
+#include "yb/gutil/casts.h"
+
 #include "yb/rocksdb/db.h"
 
 #include "yb/rpc/rpc.h"
@@ -44,6 +46,7 @@
 
 #include "yb/util/async_util.h"
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
@@ -62,6 +65,9 @@ DECLARE_bool(TEST_disable_proactive_txn_cleanup_on_abort);
 DECLARE_bool(TEST_fail_in_apply_if_no_metadata);
 DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
+DECLARE_bool(batch_transaction_heartbeats);
+DECLARE_bool(cleanup_aborts_resolve_status_in_batches);
+DECLARE_bool(coordinate_regular_and_intents_db_flush);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
@@ -69,6 +75,8 @@ DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(TEST_delay_init_tablet_peer_ms);
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(max_transactions_in_status_request);
+DECLARE_int32(num_raft_ops_to_force_idle_intents_db_to_flush);
 DECLARE_int32(remote_bootstrap_max_chunk_size);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
@@ -76,6 +84,9 @@ DECLARE_uint64(aborted_intent_cleanup_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_heartbeat_usec);
 
+METRIC_DECLARE_histogram(
+    handler_latency_yb_tserver_TabletServerService_UpdateTransactionHeartbeats);
+
 namespace yb {
 namespace client {
 
@@ -442,6 +453,44 @@ TEST_F(QLTransactionTest, Heartbeat) {
   AssertNoRunningTransactions();
 }
 
+TEST_F(QLTransactionTest, BatchedHeartbeats) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_batch_transaction_heartbeats) = true;
+  constexpr size_t kTransactions = 20;
+
+  auto count_batches = [this] {
+    size_t result = 0;
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      const auto& metrics =
+          cluster_->mini_tablet_server(i)->server()->metric_entity()->UnsafeMetricsMapForTests();
+      auto it = metrics.find(
+          &METRIC_handler_latency_yb_tserver_TabletServerService_UpdateTransactionHeartbeats);
+      if (it != metrics.end()) {
+        result += down_cast<const Histogram&>(*it->second).TotalCount();
+      }
+    }
+    return result;
+  };
+
+  std::vector<YBTransactionPtr> txns;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    ASSERT_OK(WriteRows(CreateSession(txn), i));
+    txns.push_back(std::move(txn));
+  }
+
+  auto batches_before = count_batches();
+  std::this_thread::sleep_for(GetTransactionTimeout() * 2);
+  auto batches = count_batches() - batches_before;
+  LOG(INFO) << "Heartbeat batches: " << batches;
+  ASSERT_GT(batches, 0);
+
+  for (auto& txn : txns) {
+    ASSERT_OK(txn->CommitFuture().get());
+  }
+  VerifyData(kTransactions);
+  AssertNoRunningTransactions();
+}
+
 TEST_F(QLTransactionTest, Expire) {
   SetDisableHeartbeatInTests(true);
   auto txn = CreateTransaction();
@@ -881,6 +930,47 @@ TEST_F(QLTransactionTest, CheckCompactionAbortCleanup) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+// Checks that intents of several aborted transactions are cleaned by compaction, when their
+// statuses are resolved in batches split by max_transactions_in_status_request.
+TEST_F(QLTransactionTest, CheckCompactionAbortCleanupInBatches) {
+  constexpr int kTransactions = 5;
+
+  SetAtomicFlag(0ULL, &FLAGS_max_clock_skew_usec); // To avoid read restart in this test.
+  FLAGS_TEST_disable_proactive_txn_cleanup_on_abort = true;
+  FLAGS_aborted_intent_cleanup_ms = 1000; // 1 sec
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_cleanup_aborts_resolve_status_in_batches) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_max_transactions_in_status_request) = 2;
+
+  {
+    auto session = CreateSession();
+    for (int i = 1; i <= kTransactions; ++i) {
+      ASSERT_OK(WriteRow(session, i, i));
+    }
+  }
+
+  for (int i = 1; i <= kTransactions; ++i) {
+    auto txn = CreateTransaction();
+    auto session = CreateSession(txn);
+    ASSERT_OK(UpdateRow(session, i, i * 10));
+    VERIFY_ROW(session, i, i * 10);
+    txn->Abort();
+  }
+
+  ASSERT_OK(WaitTransactionsCleaned());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(FLAGS_aborted_intent_cleanup_ms));
+  ASSERT_OK(cluster_->CompactTablets());
+
+  {
+    auto session = CreateSession();
+    for (int i = 1; i <= kTransactions; ++i) {
+      VERIFY_ROW(session, i, i);
+    }
+  }
+
+  ASSERT_OK(WaitIntentsCleaned());
+}
+
 class QLTransactionTestWithDisabledCompactions : public QLTransactionTest {
  public:
   void SetUp() override {
@@ -1684,6 +1774,60 @@ TEST_F_EX(QLTransactionTest, DeleteFlushedIntents, QLTransactionTestSingleTablet
   }, 15s, "Intents and files are removed"));
 }
 
+// Checks that each regular db flush is followed by exactly one intents db flush, and does not
+// cause extra regular db flushes.
+TEST_F_EX(QLTransactionTest, FlushIntentsAfterRegularFlush, QLTransactionTestSingleTablet) {
+  constexpr size_t kNumFlushes = 3;
+  constexpr size_t kNumTransactions = 10;
+
+  FLAGS_coordinate_regular_and_intents_db_flush = true;
+  FLAGS_num_raft_ops_to_force_idle_intents_db_to_flush =
+      static_cast<int32_t>(kNumTransactions / 2);
+  FLAGS_rocksdb_disable_compactions = true;
+
+  auto count_files = [](rocksdb::DB* db) {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    db->GetLiveFilesMetaData(&files);
+    return files.size();
+  };
+
+  auto session = CreateSession();
+  for (size_t flush = 1; flush <= kNumFlushes; ++flush) {
+    for (size_t i = 0; i != kNumTransactions; ++i) {
+      auto txn = CreateTransaction();
+      session->SetTransaction(txn);
+      ASSERT_OK(WriteRows(session, (flush - 1) * kNumTransactions + i));
+      ASSERT_OK(txn->CommitFuture().get());
+    }
+    ASSERT_OK(WaitFor([this] {
+      return CountIntents(cluster_.get()) == 0;
+    }, 15s, "Intents applied"));
+
+    ASSERT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync, tablet::FlushFlags::kRegular));
+
+    ASSERT_OK(WaitFor([this, &count_files, flush] {
+      for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+        auto* tablet = peer->tablet();
+        auto* intents_db = tablet ? tablet->TEST_intents_db() : nullptr;
+        if (intents_db && count_files(intents_db) != flush) {
+          return false;
+        }
+      }
+      return true;
+    }, 15s, "Intents flushed"));
+
+    for (const auto& peer : ListTabletPeers(cluster_.get(), ListPeersFilter::kAll)) {
+      auto* tablet = peer->tablet();
+      if (!tablet || !tablet->TEST_intents_db()) {
+        continue;
+      }
+      SCOPED_TRACE(Format("T $0 P $1", peer->tablet_id(), peer->permanent_uuid()));
+      ASSERT_EQ(count_files(tablet->TEST_db()), flush);
+      ASSERT_EQ(count_files(tablet->TEST_intents_db()), flush);
+    }
+  }
+}
+
 // Test performs transactional writes to get flushed intents.
 // Then performs non transactional writes and checks that log size stabilizes, meaning
 // log gc is working.
@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include "yb/client/schema.h"
 #include "yb/client/snapshot_test_util.h"
 #include "yb/client/table.h"
@@ -22,12 +24,17 @@
 #include "yb/master/master_util.h"
 #include "yb/master/mini_master.h"
 
+#include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_bootstrap_if.h"
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_retention_policy.h"
 
 #include "yb/util/backoff_waiter.h"
+#include "yb/util/env.h"
+#include "yb/util/path_util.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/string_util.h"
 
 #include "yb/yql/cql/ql/util/errcodes.h"
@@ -35,6 +42,7 @@
 using namespace std::literals;
 
 DECLARE_bool(enable_history_cutoff_propagation);
+DECLARE_bool(pitr_skip_unchanged_tablets);
 DECLARE_int32(history_cutoff_propagation_interval_ms);
 DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_uint64(snapshot_coordinator_poll_interval_ms);
@@ -137,6 +145,48 @@ TEST_F(SnapshotScheduleTest, Snapshot) {
   }, FLAGS_timestamp_history_retention_interval_sec * 1s + 5s, "History cutoff update"));
 }
 
+TEST_F(SnapshotScheduleTest, IncrementalFiles) {
+  ASSERT_NO_FATALS(WriteData());
+  auto schedule_id = ASSERT_RESULT(
+    snapshot_util_->CreateSchedule(table_, YQLDatabase::YQL_DATABASE_PGSQL, "yugabyte"));
+  ASSERT_OK(snapshot_util_->WaitScheduleSnapshot(schedule_id));
+
+  // Nothing is written between the snapshots, so the second one has no new SST files.
+  ASSERT_OK(WaitFor([this]() -> Result<bool> {
+    auto snapshots = VERIFY_RESULT(snapshot_util_->ListSnapshots());
+    return snapshots.size() == 2;
+  }, kSnapshotInterval * 2, "Second snapshot"));
+  auto snapshots = ASSERT_RESULT(snapshot_util_->ListSnapshots());
+
+  auto peers = ListTabletPeers(cluster_.get(), [table_id = table_->id()](const auto& peer) {
+    return peer->tablet_metadata()->table_id() == table_id;
+  });
+  ASSERT_FALSE(peers.empty());
+  for (const auto& peer : peers) {
+    SCOPED_TRACE(Format("T $0 P $1", peer->tablet_id(), peer->permanent_uuid()));
+    auto top_dir = ASSERT_RESULT(peer->tablet_metadata()->TopSnapshotsDir());
+    int num_incremental = 0;
+    for (const auto& snapshot : snapshots) {
+      auto snapshot_id = TryFullyDecodeTxnSnapshotId(snapshot.id());
+      tablet::SnapshotFilesPB snapshot_files;
+      ASSERT_OK(pb_util::ReadPBContainerFromPath(
+          Env::Default(),
+          JoinPathSegments(top_dir, snapshot_id.ToString(), "snapshot.files"),
+          &snapshot_files));
+      ASSERT_GT(snapshot_files.files_size(), 0);
+      if (!snapshot_files.has_base_snapshot()) {
+        ASSERT_EQ(snapshot_files.new_files_size(), snapshot_files.files_size());
+        continue;
+      }
+      ++num_incremental;
+      for (const auto& file : snapshot_files.new_files()) {
+        ASSERT_FALSE(boost::ends_with(file, ".sst")) << "New file: " << file;
+      }
+    }
+    ASSERT_EQ(num_incremental, 1);
+  }
+}
+
 TEST_F(SnapshotScheduleTest, GC) {
   FLAGS_snapshot_coordinator_cleanup_delay_ms = 100;
   // When retention matches snapshot interval we expect at most 3 snapshots for schedule.
@@ -317,6 +367,36 @@ TEST_F(SnapshotScheduleTest, RestoreSchema) {
   ASSERT_NO_FATALS(VerifyData());
 }
 
+TEST_F(SnapshotScheduleTest, RestoreUnchangedTablets) {
+  FLAGS_pitr_skip_unchanged_tablets = true;
+  ASSERT_NO_FATALS(WriteData());
+  auto schedule_id = ASSERT_RESULT(
+    snapshot_util_->CreateSchedule(table_, YQLDatabase::YQL_DATABASE_PGSQL, "yugabyte"));
+  ASSERT_OK(snapshot_util_->WaitScheduleSnapshot(schedule_id));
+  auto hybrid_time = cluster_->mini_master(0)->master()->clock()->Now();
+  auto snapshot_id = ASSERT_RESULT(snapshot_util_->PickSuitableSnapshot(schedule_id, hybrid_time));
+
+  auto peers = ListTabletPeers(cluster_.get(), [table_id = table_->id()](const auto& peer) {
+    return peer->tablet_metadata()->table_id() == table_id;
+  });
+  std::vector<rocksdb::DB*> dbs;
+  std::vector<OpId> flushed_op_ids;
+  for (const auto& peer : peers) {
+    dbs.push_back(peer->tablet()->TEST_db());
+    flushed_op_ids.push_back(ASSERT_RESULT(peer->tablet()->MaxPersistentOpId()).regular);
+  }
+
+  // Nothing was written after hybrid_time, so the restore does not have to reopen RocksDB.
+  ASSERT_OK(snapshot_util_->RestoreSnapshot(snapshot_id, hybrid_time));
+  for (size_t i = 0; i != peers.size(); ++i) {
+    ASSERT_EQ(dbs[i], peers[i]->tablet()->TEST_db()) << "T " << peers[i]->tablet_id();
+    // The restore operation should be recorded as flushed, so it is not replayed after restart.
+    ASSERT_GT(ASSERT_RESULT(peers[i]->tablet()->MaxPersistentOpId()).regular, flushed_op_ids[i])
+        << "T " << peers[i]->tablet_id();
+  }
+  ASSERT_NO_FATALS(VerifyData());
+}
+
 TEST_F(SnapshotScheduleTest, RemoveNewTablets) {
   const auto kInterval = 5s * kTimeMultiplier;
   const auto kRetention = kInterval * 2;
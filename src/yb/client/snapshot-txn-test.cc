@@ -73,6 +73,7 @@ DECLARE_int32(TEST_inject_status_resolver_delay_ms);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_int32(txn_max_apply_batch_records);
 DECLARE_int64(transaction_rpc_timeout_ms);
+DECLARE_uint32(apply_intents_task_max_batches_per_run);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(max_transactions_in_status_request);
 DECLARE_uint64(clock_skew_force_crash_bound_usec);
@@ -825,6 +826,13 @@ TEST_F(SnapshotTxnTest, MultiWriteWithRestartAndLongApply) {
   TestMultiWriteWithRestart();
 }
 
+TEST_F(SnapshotTxnTest, MultiWriteWithRestartAndYieldingLongApply) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_txn_max_apply_batch_records) = 3;
+  // Every apply batch is performed by a separate run of the apply task.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_apply_intents_task_max_batches_per_run) = 1;
+  TestMultiWriteWithRestart();
+}
+
 using RemoteBootstrapOnStartBase = TransactionCustomLogSegmentSizeTest<128, SnapshotTxnTest>;
 
 void SnapshotTxnTest::TestRemoteBootstrap() {
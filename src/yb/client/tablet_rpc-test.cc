@@ -18,9 +18,15 @@
 
 #include "yb/master/master_client.pb.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/test_util.h"
 #include "yb/util/trace.h"
 
+DECLARE_bool(client_adaptive_concurrency_limit);
+DECLARE_int32(client_concurrency_limit_initial);
+DECLARE_int32(client_concurrency_limit_min);
+DECLARE_double(client_concurrency_limit_latency_factor);
+
 namespace yb {
 namespace client {
 namespace internal {
@@ -112,6 +118,76 @@ TEST_F(TabletRpcTest, TabletInvokerSelectTabletServerRace) {
   replicas_refresher.join();
 }
 
+TEST_F(TabletRpcTest, RemoteTabletServerAverageResponseTime) {
+  RemoteTabletServer ts("n1-uuid", nullptr, nullptr);
+  ASSERT_EQ(MonoDelta::kZero, ts.AverageResponseTime());
+
+  ts.RecordResponseTime(MonoDelta::FromMilliseconds(10));
+  ASSERT_NEAR(10000, ts.AverageResponseTime().ToMicroseconds(), 100);
+
+  // The average moves towards new samples, but is not replaced by them.
+  ts.RecordResponseTime(MonoDelta::FromMilliseconds(60));
+  ASSERT_NEAR(20000, ts.AverageResponseTime().ToMicroseconds(), 200);
+}
+
+TEST_F(TabletRpcTest, RemoteTabletServerConcurrencyLimit) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_adaptive_concurrency_limit) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_initial) = 2;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_min) = 1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_latency_factor) = 0;
+
+  RemoteTabletServer ts("n1-uuid", nullptr, nullptr);
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kLimitReached, ts.TryAcquireRequestSlot());
+
+  // A successful response grows the limit by 1 / limit.
+  ts.ReleaseRequestSlot(MonoDelta::FromMilliseconds(1), /* overloaded= */ false);
+  ASSERT_DOUBLE_EQ(2.5, ts.ConcurrencyLimit());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kLimitReached, ts.TryAcquireRequestSlot());
+
+  // Overload halves the limit, but only once per response time.
+  ts.ReleaseRequestSlot(MonoDelta::FromSeconds(10), /* overloaded= */ true);
+  ASSERT_DOUBLE_EQ(1.25, ts.ConcurrencyLimit());
+  ts.ReleaseRequestSlot(MonoDelta::FromSeconds(10), /* overloaded= */ true);
+  ASSERT_DOUBLE_EQ(1.25, ts.ConcurrencyLimit());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kLimitReached, ts.TryAcquireRequestSlot());
+
+  // Nothing is limited while the flag is off.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_adaptive_concurrency_limit) = false;
+  ASSERT_EQ(RequestSlot::kNotLimited, ts.TryAcquireRequestSlot());
+}
+
+// Requests sent while the limit is disabled do not take slots, so they must not return any when
+// they complete after the limit was enabled again.
+TEST_F(TabletRpcTest, RemoteTabletServerConcurrencyLimitToggle) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_adaptive_concurrency_limit) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_initial) = 1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_min) = 1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_concurrency_limit_latency_factor) = 0;
+
+  RemoteTabletServer ts("n1-uuid", nullptr, nullptr);
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_adaptive_concurrency_limit) = false;
+  ASSERT_EQ(RequestSlot::kNotLimited, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kNotLimited, ts.TryAcquireRequestSlot());
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_client_adaptive_concurrency_limit) = true;
+  // The slot taken before the flag was turned off is still held.
+  ASSERT_EQ(RequestSlot::kLimitReached, ts.TryAcquireRequestSlot());
+
+  // Only the acquired slot is released, the limit grows to 2.
+  ts.ReleaseRequestSlot(MonoDelta::FromMilliseconds(1), /* overloaded= */ false);
+  ASSERT_DOUBLE_EQ(2, ts.ConcurrencyLimit());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kAcquired, ts.TryAcquireRequestSlot());
+  ASSERT_EQ(RequestSlot::kLimitReached, ts.TryAcquireRequestSlot());
+}
+
 } // namespace internal
 } // namespace client
 } // namespace yb
@@ -26,6 +26,7 @@
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_header.pb.h"
 
+#include "yb/tserver/local_tablet_server.h"
 #include "yb/tserver/tserver_error.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
@@ -51,10 +52,18 @@ DEFINE_UNKNOWN_int32(lookup_cache_refresh_secs, 60, "When non-zero, specifies ho
              "This request is only sent if we are processing a ConsistentPrefix read and the RPC "
              "layer has determined that its view of the replicas is inconsistent with what the "
              "master has reported");
+DEFINE_RUNTIME_bool(consistent_prefix_read_skip_lagging_local_replica, false,
+    "When a consistent prefix read with a specified read time would be sent to the local "
+    "tserver, check the safe time of the local replica first. If the replica cannot serve the "
+    "read time yet, send the read to the leader instead of taking a round trip to the replica "
+    "that would reject it or wait for its safe time.");
+TAG_FLAG(consistent_prefix_read_skip_lagging_local_replica, advanced);
 DEFINE_test_flag(int32, assert_failed_replicas_less_than, 0,
                  "If greater than 0, this process will crash if the number of failed replicas for "
                  "a RemoteTabletServer is greater than the specified number.");
 
+DECLARE_bool(latency_aware_replica_selection);
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -85,7 +94,11 @@ TabletInvoker::TabletInvoker(const bool local_tserver_only,
         local_tserver_only_(local_tserver_only),
         consistent_prefix_(consistent_prefix) {}
 
-TabletInvoker::~TabletInvoker() {}
+TabletInvoker::~TabletInvoker() {
+  if (request_slot_ts_) {
+    request_slot_ts_->ReleaseRequestSlot(MonoDelta::kZero, /* overloaded= */ false);
+  }
+}
 
 void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   TRACE_TO(trace_, "SelectTabletServerWithConsistentPrefix()");
@@ -99,6 +112,21 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
                                               YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
                                               &candidates);
+  if (current_ts_ && current_ts_->IsLocal() &&
+      FLAGS_consistent_prefix_read_skip_lagging_local_replica) {
+    auto read_time = rpc_->RequestedReadTime();
+    if (read_time.is_valid()) {
+      auto safe_time = current_ts_->local_tserver()->SafeTimeForFollowerRead(tablet_id_);
+      if (safe_time.is_valid() && safe_time < read_time) {
+        auto* leader = tablet_->LeaderTServer();
+        if (leader && leader != current_ts_) {
+          VLOG(1) << "Local replica of " << tablet_id_ << " has safe time " << safe_time
+                  << " before read time " << read_time << ", using leader";
+          current_ts_ = leader;
+        }
+      }
+    }
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -143,13 +171,26 @@ void TabletInvoker::SelectTabletServer()  {
     current_ts_ = nullptr;
   }
   if (!current_ts_) {
-    // Try to "guess" the next leader.
     vector<RemoteTabletServer*> replicas;
     tablet_->GetRemoteTabletServers(&replicas);
-    for (RemoteTabletServer* ts : replicas) {
-      if (!followers_.count(ts)) {
-        current_ts_ = ts;
-        break;
+    // Prefer the leader reported by the replica that rejected the previous attempt.
+    if (!leader_hint_uuid_.empty()) {
+      for (RemoteTabletServer* ts : replicas) {
+        if (ts->permanent_uuid() == leader_hint_uuid_ && !followers_.count(ts)) {
+          VLOG(2) << "Tablet " << tablet_id_ << ": Using leader hint " << ts->ToString();
+          current_ts_ = ts;
+          break;
+        }
+      }
+      leader_hint_uuid_.clear();
+    }
+    // Try to "guess" the next leader.
+    if (!current_ts_) {
+      for (RemoteTabletServer* ts : replicas) {
+        if (!followers_.count(ts)) {
+          current_ts_ = ts;
+          break;
+        }
       }
     }
     if (current_ts_) {
@@ -261,9 +302,31 @@ void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
     return;
   }
 
+  const auto request_slot = current_ts_->TryAcquireRequestSlot();
+  if (request_slot == RequestSlot::kLimitReached) {
+    // The server has as many of our requests in flight as it can take. Hold the request here
+    // instead of adding to its load, it is sent again after the retry delay.
+    VLOG(3) << "Tablet " << tablet_id_ << ": Concurrency limit reached for replica "
+            << current_ts_->ToString();
+    status = retrier_->DelayedRetry(
+        command_,
+        STATUS_FORMAT(ServiceUnavailable, "Concurrency limit of $0 reached", *current_ts_),
+        rpc::BackoffStrategy::kExponential);
+    if (!status.ok()) {
+      command_->Finished(status);
+    }
+    return;
+  }
+  if (request_slot == RequestSlot::kAcquired) {
+    request_slot_ts_ = current_ts_;
+  }
+
   VLOG(2) << "Tablet " << tablet_id_ << ": Sending " << command_->ToString() << " to replica "
           << current_ts_->ToString();
 
+  if (request_slot_ts_ || FLAGS_latency_aware_replica_selection) {
+    send_time_ = MonoTime::Now();
+  }
   rpc_->SendRpcToTserver(retrier_->attempt_num());
 }
 
@@ -288,6 +351,10 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
       .status = STATUS(IllegalState, "Not the leader"),
       .time = CoarseMonoClock::now()
     });
+    auto leader_hint = tserver::TabletServerLeaderHint::ValueFromStatus(reason);
+    if (leader_hint) {
+      leader_hint_uuid_ = std::move(*leader_hint);
+    }
   } else {
     VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason
             << ", old replica: " << yb::ToString(current_ts_);
@@ -316,6 +383,18 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   return status;
 }
 
+bool TabletInvoker::IsServerOverloaded(const Status& status) const {
+  if (status.IsTimedOut()) {
+    return true;
+  }
+  if (status.IsRemoteError()) {
+    const auto* error = retrier_->controller().error_response();
+    return error && error->code() == rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY;
+  }
+  // Write throttling rejects requests with ServiceUnavailable in the response.
+  return status.ok() && ErrorStatus(rpc_->response_error()).IsServiceUnavailable();
+}
+
 bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
@@ -323,6 +402,18 @@ bool TabletInvoker::Done(Status* status) {
   bool assign_new_leader = assign_new_leader_;
   assign_new_leader_ = false;
 
+  // A timed out request still tells that the server is at least that slow.
+  const auto response_time = send_time_ ? MonoTime::Now() - send_time_ : MonoDelta();
+  if (current_ts_ && response_time && (status->ok() || status->IsTimedOut())) {
+    current_ts_->RecordResponseTime(response_time);
+  }
+  if (request_slot_ts_) {
+    request_slot_ts_->ReleaseRequestSlot(
+        response_time ? response_time : MonoDelta::kZero, IsServerOverloaded(*status));
+    request_slot_ts_ = nullptr;
+  }
+  send_time_ = MonoTime();
+
   if (status->IsAborted() || retrier_->finished()) {
     if (status->ok()) {
       *status = retrier_->controller().status();
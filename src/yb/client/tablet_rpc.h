@@ -54,6 +54,11 @@ class TabletRpc {
   // attempt_num starts with 1.
   virtual void SendRpcToTserver(int attempt_num) = 0;
 
+  // Read time specified by the request, or invalid hybrid time if the server should pick it.
+  virtual HybridTime RequestedReadTime() const {
+    return HybridTime::kInvalid;
+  }
+
  protected:
   ~TabletRpc() {}
 };
@@ -100,6 +105,9 @@ class TabletInvoker {
 
   void SelectTabletServer();
 
+  // Whether the response with the given status tells that current_ts_ is overloaded.
+  bool IsServerOverloaded(const Status& status) const;
+
   // This is an implementation of ReadRpc with consistency level as CONSISTENT_PREFIX. As a result,
   // there is no requirement that the read needs to hit the leader.
   void SelectTabletServerWithConsistentPrefix();
@@ -176,8 +184,19 @@ class TabletInvoker {
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
   RemoteTabletServer* current_ts_ = nullptr;
 
+  // When the request was last sent to current_ts_, used to measure its response time.
+  MonoTime send_time_;
+
+  // The server whose request slot is held by the request in flight, see
+  // RemoteTabletServer::TryAcquireRequestSlot.
+  RemoteTabletServer* request_slot_ts_ = nullptr;
+
   // Should we assign new leader in meta cache when successful response is received.
   bool assign_new_leader_ = false;
+
+  // UUID of the leader reported by the last replica that rejected the request with
+  // NOT_THE_LEADER. Used once by the next SelectTabletServer.
+  std::string leader_hint_uuid_;
 };
 
 Status ErrorStatus(const tserver::TabletServerErrorPB* error);
@@ -74,6 +74,9 @@ DEFINE_UNKNOWN_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
               "Interval of transaction heartbeat in usec.");
 DEFINE_UNKNOWN_bool(transaction_disable_heartbeat_in_tests, false,
     "Disable heartbeat during test.");
+DEFINE_RUNTIME_AUTO_bool(batch_transaction_heartbeats, kLocalVolatile, false, true,
+    "Send PENDING transaction heartbeats to the same status tablet together, in a single "
+    "UpdateTransactionHeartbeats RPC.");
 DECLARE_uint64(max_clock_skew_usec);
 
 DEFINE_UNKNOWN_bool(auto_promote_nonlocal_transactions_to_global, true,
@@ -1581,20 +1584,36 @@ class YBTransaction::Impl final : public internal::TxnBatcherIf {
       timeout = TransactionRpcTimeout();
     }
 
+    internal::RemoteTabletPtr status_tablet;
     rpc::RpcCommandPtr rpc;
     {
       SharedLock<std::shared_mutex> lock(mutex_);
-      internal::RemoteTabletPtr status_tablet;
 
       if (!send_to_new_tablet && old_status_tablet_) {
         status_tablet = old_status_tablet_;
       } else {
         status_tablet = status_tablet_;
       }
-      rpc = PrepareHeartbeatRPC(
-          CoarseMonoClock::now() + timeout, status_tablet, status,
-          std::bind(
-              &Impl::HeartbeatDone, this, _1, _2, _3, status, transaction, send_to_new_tablet));
+      if (status != TransactionStatus::PENDING ||
+          !GetAtomicFlag(&FLAGS_batch_transaction_heartbeats)) {
+        rpc = PrepareHeartbeatRPC(
+            CoarseMonoClock::now() + timeout, status_tablet, status,
+            std::bind(
+                &Impl::HeartbeatDone, this, _1, _2, _3, status, transaction, send_to_new_tablet));
+      }
+    }
+
+    if (!rpc) {
+      // Plain PENDING heartbeats carry nothing but the transaction id, so the transaction manager
+      // sends them together with the heartbeats of other transactions to the same status tablet.
+      manager_->SendHeartbeat(
+          CoarseMonoClock::now() + timeout, status_tablet, id,
+          [this, transaction, send_to_new_tablet](const Status& status) {
+            HeartbeatDone(
+                status, /* request= */ {}, /* response= */ {}, TransactionStatus::PENDING,
+                transaction, send_to_new_tablet);
+          });
+      return;
     }
 
     auto& handle = send_to_new_tablet ? new_heartbeat_handle_ : heartbeat_handle_;
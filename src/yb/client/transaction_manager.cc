@@ -15,17 +15,26 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <deque>
+#include <unordered_map>
+
 #include "yb/client/client.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
+#include "yb/client/transaction_rpc.h"
 #include "yb/client/yb_table_name.h"
 
 #include "yb/master/catalog_manager.h"
 
+#include "yb/common/wire_protocol.h"
+
+#include "yb/rpc/rpc.h"
 #include "yb/rpc/tasks_pool.h"
 
 #include "yb/server/server_base_options.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
 #include "yb/util/flags.h"
 #include "yb/util/format.h"
 #include "yb/util/status_format.h"
@@ -39,6 +48,17 @@ DEFINE_UNKNOWN_uint64(transaction_manager_workers_limit, 50,
 DEFINE_UNKNOWN_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_RUNTIME_uint32(transaction_heartbeat_batch_max_size, 128,
+    "Max number of transactions whose heartbeats are sent to a status tablet in a single "
+    "UpdateTransactionHeartbeats RPC.");
+TAG_FLAG(transaction_heartbeat_batch_max_size, advanced);
+
+DEFINE_RUNTIME_bool(transaction_manager_prefer_zone_local_status_tablets, false,
+    "When no status tablet has its leader on the local tablet server, prefer the status tablets "
+    "whose leader is in the same zone, according to the tablet locations cached by the client, "
+    "before picking a random one.");
+TAG_FLAG(transaction_manager_prefer_zone_local_status_tablets, advanced);
+
 DEFINE_test_flag(string, transaction_manager_preferred_tablet, "",
                  "For testing only. If non-empty, transaction manager will try to use the status "
                  "tablet with id matching this flag, if present in the list of status tablets.");
@@ -52,8 +72,8 @@ namespace {
 // the same placement.
 class TransactionTableState {
  public:
-  explicit TransactionTableState(LocalTabletFilter local_tablet_filter)
-      : local_tablet_filter_(local_tablet_filter) {
+  TransactionTableState(YBClient* client, LocalTabletFilter local_tablet_filter)
+      : client_(client), local_tablet_filter_(local_tablet_filter) {
   }
 
   void InvokeCallback(const PickStatusTabletCallback& callback,
@@ -121,6 +141,16 @@ class TransactionTableState {
         callback(*RandomElement(ids));
         return true;
       }
+      if (FLAGS_transaction_manager_prefer_zone_local_status_tablets) {
+        for (const auto& id : tablets) {
+          ids.push_back(&id);
+        }
+        client_->PreserveZoneLocalLeadersOnly(&ids);
+        if (!ids.empty()) {
+          callback(*RandomElement(ids));
+          return true;
+        }
+      }
       return false;
     }
     callback(RandomElement(tablets));
@@ -141,6 +171,7 @@ class TransactionTableState {
     FATAL_INVALID_ENUM_VALUE(TransactionLocality, locality);
   }
 
+  YBClient* const client_;
   LocalTabletFilter local_tablet_filter_;
 
   // Set to true once transaction tablets have been loaded at least once. global_tablets
@@ -243,7 +274,7 @@ class TransactionManager::Impl {
                 LocalTabletFilter local_tablet_filter)
       : client_(client),
         clock_(clock),
-        table_state_{std::move(local_tablet_filter)},
+        table_state_{client, std::move(local_tablet_filter)},
         thread_pool_(rpc::ThreadPoolOptions {
           .name = "TransactionManager",
           .max_workers = FLAGS_transaction_manager_workers_limit,
@@ -301,6 +332,33 @@ class TransactionManager::Impl {
     }
   }
 
+  void SendHeartbeat(
+      CoarseTimePoint deadline, const internal::RemoteTabletPtr& status_tablet,
+      const TransactionId& transaction_id, TransactionHeartbeatCallback callback) {
+    HeartbeatBatch batch;
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      if (!heartbeats_closed_) {
+        auto& queue = heartbeat_queues_[status_tablet->tablet_id()];
+        queue.heartbeats.push_back(QueuedHeartbeat {
+          .transaction_id = transaction_id,
+          .deadline = deadline,
+          .callback = std::move(callback),
+        });
+        if (queue.in_flight) {
+          return;
+        }
+        queue.in_flight = true;
+        batch = TakeHeartbeatBatch(&queue);
+      }
+    }
+    if (batch.empty()) {
+      callback(STATUS(Aborted, "Transaction manager is shutting down"));
+      return;
+    }
+    SendHeartbeatBatch(status_tablet, std::move(batch));
+  }
+
   const scoped_refptr<ClockBase>& clock() const {
     return clock_;
   }
@@ -326,6 +384,20 @@ class TransactionManager::Impl {
   }
 
   void Shutdown() {
+    HeartbeatBatch pending_heartbeats;
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      heartbeats_closed_ = true;
+      for (auto& [tablet_id, queue] : heartbeat_queues_) {
+        std::move(
+            queue.heartbeats.begin(), queue.heartbeats.end(),
+            std::back_inserter(pending_heartbeats));
+        queue.heartbeats.clear();
+      }
+    }
+    for (auto& heartbeat : pending_heartbeats) {
+      heartbeat.callback(STATUS(Aborted, "Transaction manager is shutting down"));
+    }
     rpcs_.Shutdown();
     thread_pool_.Shutdown();
   }
@@ -339,11 +411,116 @@ class TransactionManager::Impl {
   }
 
  private:
+  struct QueuedHeartbeat {
+    TransactionId transaction_id;
+    CoarseTimePoint deadline;
+    TransactionHeartbeatCallback callback;
+  };
+
+  using HeartbeatBatch = std::vector<QueuedHeartbeat>;
+
+  struct HeartbeatQueue {
+    std::deque<QueuedHeartbeat> heartbeats;
+    bool in_flight = false;
+  };
+
+  static HeartbeatBatch TakeHeartbeatBatch(HeartbeatQueue* queue) {
+    auto size = std::min<size_t>(
+        queue->heartbeats.size(),
+        std::max<uint32_t>(FLAGS_transaction_heartbeat_batch_max_size, 1));
+    HeartbeatBatch result;
+    result.reserve(size);
+    std::move(
+        queue->heartbeats.begin(), queue->heartbeats.begin() + size, std::back_inserter(result));
+    queue->heartbeats.erase(queue->heartbeats.begin(), queue->heartbeats.begin() + size);
+    return result;
+  }
+
+  void SendHeartbeatBatch(const internal::RemoteTabletPtr& status_tablet, HeartbeatBatch batch) {
+    tserver::UpdateTransactionHeartbeatsRequestPB req;
+    req.set_tablet_id(status_tablet->tablet_id());
+    req.set_propagated_hybrid_time(Now().ToUint64());
+    auto deadline = CoarseTimePoint::min();
+    for (const auto& heartbeat : batch) {
+      req.add_transaction_id(heartbeat.transaction_id.data(), heartbeat.transaction_id.size());
+      deadline = std::max(deadline, heartbeat.deadline);
+    }
+
+    auto handle = rpcs_.Prepare();
+    if (handle == rpcs_.InvalidHandle()) {
+      HeartbeatBatchDone(
+          status_tablet, STATUS(Aborted, "Transaction manager is shutting down"), {}, &batch);
+      return;
+    }
+    *handle = UpdateTransactionHeartbeats(
+        deadline, status_tablet.get(), client_, &req,
+        [this, handle, status_tablet, batch = std::move(batch)](
+            const Status& status,
+            const tserver::UpdateTransactionHeartbeatsRequestPB& req,
+            const tserver::UpdateTransactionHeartbeatsResponsePB& resp) mutable {
+          client::UpdateClock(resp, this);
+          auto retained_self = rpcs_.Unregister(handle);
+          HeartbeatBatchDone(status_tablet, status, resp, &batch);
+        });
+    (**handle).SendRpc();
+  }
+
+  void HeartbeatBatchDone(
+      const internal::RemoteTabletPtr& status_tablet, Status status,
+      const tserver::UpdateTransactionHeartbeatsResponsePB& resp, HeartbeatBatch* batch) {
+    if (status.ok() && static_cast<size_t>(resp.status().size()) != batch->size()) {
+      status = STATUS_FORMAT(
+          IllegalState, "Wrong number of heartbeat statuses: $0, expected: $1",
+          resp.status().size(), batch->size());
+    }
+    for (size_t i = 0; i != batch->size(); ++i) {
+      (*batch)[i].callback(status.ok() ? StatusFromPB(resp.status(static_cast<int>(i))) : status);
+    }
+
+    // Callbacks could queue new heartbeats, e.g. when retrying, so we check the queue after them.
+    HeartbeatBatch next_batch;
+    Status next_status;
+    {
+      std::lock_guard lock(heartbeats_mutex_);
+      auto it = heartbeat_queues_.find(status_tablet->tablet_id());
+      if (it == heartbeat_queues_.end()) {
+        LOG(DFATAL) << "Heartbeat queue missing for " << status_tablet->tablet_id();
+        return;
+      }
+      auto& queue = it->second;
+      if (heartbeats_closed_) {
+        std::move(
+            queue.heartbeats.begin(), queue.heartbeats.end(), std::back_inserter(next_batch));
+        queue.heartbeats.clear();
+        next_status = STATUS(Aborted, "Transaction manager is shutting down");
+      } else {
+        next_batch = TakeHeartbeatBatch(&queue);
+      }
+      if (next_batch.empty() || !next_status.ok()) {
+        queue.in_flight = false;
+      }
+      if (queue.heartbeats.empty() && !queue.in_flight) {
+        heartbeat_queues_.erase(it);
+      }
+    }
+    if (!next_status.ok()) {
+      for (auto& heartbeat : next_batch) {
+        heartbeat.callback(next_status);
+      }
+    } else if (!next_batch.empty()) {
+      SendHeartbeatBatch(status_tablet, std::move(next_batch));
+    }
+  }
+
   YBClient* const client_;
   scoped_refptr<ClockBase> clock_;
   TransactionTableState table_state_;
   std::atomic<bool> closed_{false};
 
+  std::mutex heartbeats_mutex_;
+  bool heartbeats_closed_ GUARDED_BY(heartbeats_mutex_) = false;
+  std::unordered_map<TabletId, HeartbeatQueue> heartbeat_queues_ GUARDED_BY(heartbeats_mutex_);
+
   yb::rpc::ThreadPool thread_pool_; // TODO async operations instead of pool
   yb::rpc::TasksPool<LoadStatusTabletsTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
@@ -367,6 +544,12 @@ void TransactionManager::PickStatusTablet(
   impl_->PickStatusTablet(std::move(callback), locality);
 }
 
+void TransactionManager::SendHeartbeat(
+    CoarseTimePoint deadline, const internal::RemoteTabletPtr& status_tablet,
+    const TransactionId& transaction_id, TransactionHeartbeatCallback callback) {
+  impl_->SendHeartbeat(deadline, status_tablet, transaction_id, std::move(callback));
+}
+
 YBClient* TransactionManager::client() const {
   return impl_->client();
 }
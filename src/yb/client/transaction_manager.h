@@ -22,15 +22,19 @@
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 #include "yb/common/transaction.pb.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
+#include "yb/util/monotime.h"
+
 namespace yb {
 namespace client {
 
 using PickStatusTabletCallback = std::function<void(const Result<std::string>&)>;
 using UpdateTransactionTablesVersionCallback = std::function<void(const Status&)>;
+using TransactionHeartbeatCallback = std::function<void(const Status&)>;
 
 // TransactionManager manages multiple transactions. It lives at the YQL engine layer.
 class TransactionManager {
@@ -50,6 +54,13 @@ class TransactionManager {
 
   void PickStatusTablet(PickStatusTabletCallback callback, TransactionLocality locality);
 
+  // Sends a PENDING heartbeat for the transaction to its status tablet. Heartbeats to the same
+  // status tablet are batched: while a batch is in flight, new heartbeats are queued and sent
+  // together when it completes. The callback receives the result for this transaction only.
+  void SendHeartbeat(
+      CoarseTimePoint deadline, const internal::RemoteTabletPtr& status_tablet,
+      const TransactionId& transaction_id, TransactionHeartbeatCallback callback);
+
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
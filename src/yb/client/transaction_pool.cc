@@ -41,6 +41,11 @@ DEFINE_UNKNOWN_double(transaction_pool_reserve_factor, 2,
               "During cleanup we will preserve number of transactions in pool that equals to"
                   " average number or take requests during prepration multiplied by this factor");
 
+DEFINE_RUNTIME_uint32(transaction_pool_extra_preparations_on_miss, 0,
+    "Number of additional transactions that are prepared when a take request finds the pool "
+    "empty, so the pool catches up with a burst of requests faster");
+TAG_FLAG(transaction_pool_extra_preparations_on_miss, advanced);
+
 DEFINE_UNKNOWN_bool(force_global_transactions, false,
             "Force all transactions to be global transactions");
 
@@ -101,8 +106,9 @@ class SingleLocalityPool {
   }
 
   YBTransactionPtr Take(CoarseTimePoint deadline) {
-    YBTransactionPtr result, new_txn;
+    YBTransactionPtr result;
     uint64_t old_taken;
+    size_t num_new_txns = 1;
     IncrementCounter(cache_queries_);
     {
       std::lock_guard<std::mutex> lock(mutex_);
@@ -116,6 +122,9 @@ class SingleLocalityPool {
         // prepare newly created transaction, since it is anyway too late.
         result = std::make_shared<YBTransaction>(&manager_, locality_);
         IncrementHistogram(cache_histogram_, 0);
+        // The pool is behind the take rate, so prepare extra transactions. Cleanup shrinks the
+        // pool back when they are not used.
+        num_new_txns += FLAGS_transaction_pool_extra_preparations_on_miss;
       } else {
         result = Pop();
         // Cache histogram should show number of cache hits in percents, so we put 100 in case of
@@ -123,15 +132,17 @@ class SingleLocalityPool {
         IncrementHistogram(cache_histogram_, 100);
         IncrementCounter(cache_hits_);
       }
-      new_txn = std::make_shared<YBTransaction>(&manager_, locality_);
-      ++preparing_transactions_;
+      preparing_transactions_ += num_new_txns;
     }
-    IncrementGauge(gauge_preparing_);
-    internal::InFlightOpsGroupsWithMetadata ops_info;
-    if (new_txn->batcher_if().Prepare(
-        &ops_info, ForceConsistentRead::kFalse, deadline, Initial::kFalse,
-        std::bind(&SingleLocalityPool::TransactionReady, this, _1, new_txn, old_taken))) {
-      TransactionReady(Status::OK(), new_txn, old_taken);
+    for (size_t i = 0; i != num_new_txns; ++i) {
+      auto new_txn = std::make_shared<YBTransaction>(&manager_, locality_);
+      IncrementGauge(gauge_preparing_);
+      internal::InFlightOpsGroupsWithMetadata ops_info;
+      if (new_txn->batcher_if().Prepare(
+          &ops_info, ForceConsistentRead::kFalse, deadline, Initial::kFalse,
+          std::bind(&SingleLocalityPool::TransactionReady, this, _1, new_txn, old_taken))) {
+        TransactionReady(Status::OK(), new_txn, old_taken);
+      }
     }
     return result;
   }
@@ -48,6 +48,7 @@ typedef std::shared_ptr<Schema> SchemaPtr;
 typedef std::string PartitionKey;
 typedef std::shared_ptr<const PartitionKey> PartitionKeyPtr;
 
+class QLCompiledCondition;
 class QLExprExecutor;
 typedef std::shared_ptr<QLExprExecutor> QLExprExecutorPtr;
 
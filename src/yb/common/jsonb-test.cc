@@ -13,17 +13,22 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <rapidjson/prettywriter.h>
 
+#include "yb/common/common.pb.h"
 #include "yb/common/jsonb.h"
+#include "yb/common/ql_value.h"
 
 #include "yb/gutil/dynamic_annotations.h"
 
 #include "yb/util/status.h"
+#include "yb/util/status_format.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/tostring.h"
+#include "yb/util/varint.h"
 
 using std::to_string;
 using std::numeric_limits;
@@ -158,5 +163,79 @@ TEST(JsonbTest, TestArrays) {
   VerifyArray(document);
 }
 
+void AddKeyOperation(const std::string& key, JsonOperatorPB op, QLJsonColumnOperationsPB* ops) {
+  auto* json_op = ops->add_json_operations();
+  json_op->set_json_operator(op);
+  json_op->mutable_operand()->mutable_value()->set_string_value(key);
+}
+
+void AddIndexOperation(int64_t index, JsonOperatorPB op, QLJsonColumnOperationsPB* ops) {
+  auto* json_op = ops->add_json_operations();
+  json_op->set_json_operator(op);
+  json_op->mutable_operand()->mutable_value()->set_varint_value(
+      util::VarInt(index).EncodeToComparable());
+}
+
+TEST(JsonbTest, TestPathLookupInLargeObject) {
+  constexpr int kNumKeys = 1000;
+  std::string json = "{";
+  for (int i = 0; i < kNumKeys; ++i) {
+    if (i) {
+      json += ", ";
+    }
+    json += Format(R"#("k$0" : { "v" : $0, "s" : "value $0", "a" : [$0, "x"] })#", i);
+  }
+  json += "}";
+
+  Jsonb jsonb;
+  ASSERT_OK(jsonb.FromString(json));
+
+  for (int i = 0; i < kNumKeys; i += 37) {
+    const auto key = Format("k$0", i);
+
+    QLJsonColumnOperationsPB text_ops;
+    AddKeyOperation(key, JsonOperatorPB::JSON_OBJECT, &text_ops);
+    AddKeyOperation("s", JsonOperatorPB::JSON_TEXT, &text_ops);
+    QLValuePB result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), text_ops, &result));
+    ASSERT_EQ(Format("value $0", i), result.string_value());
+
+    QLJsonColumnOperationsPB array_ops;
+    AddKeyOperation(key, JsonOperatorPB::JSON_OBJECT, &array_ops);
+    AddKeyOperation("a", JsonOperatorPB::JSON_OBJECT, &array_ops);
+    AddIndexOperation(0, JsonOperatorPB::JSON_OBJECT, &array_ops);
+    result.Clear();
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), array_ops, &result));
+    ASSERT_TRUE(result.has_jsonb_value());
+    Jsonb scalar(result.jsonb_value());
+    rapidjson::Document document;
+    ASSERT_OK(scalar.ToRapidJson(&document));
+    ASSERT_TRUE(document.IsInt());
+    ASSERT_EQ(i, document.GetInt());
+
+    QLJsonColumnOperationsPB object_ops;
+    AddKeyOperation(key, JsonOperatorPB::JSON_OBJECT, &object_ops);
+    Slice value;
+    JEntry metadata;
+    ASSERT_OK(Jsonb::FindPath(jsonb.SerializedJsonb(), object_ops, &value, &metadata));
+    rapidjson::Document object;
+    ASSERT_OK(Jsonb(value.ToBuffer()).ToRapidJson(&object));
+    ASSERT_TRUE(object.IsObject());
+    ASSERT_EQ(i, object["v"].GetInt());
+  }
+
+  // Missing keys, and paths through scalars, read as null.
+  const std::vector<std::vector<std::string>> missing_paths = {{"k"}, {"k1000"}, {"k1", "v", "x"}};
+  for (const auto& path : missing_paths) {
+    QLJsonColumnOperationsPB ops;
+    for (const auto& key : path) {
+      AddKeyOperation(key, JsonOperatorPB::JSON_OBJECT, &ops);
+    }
+    QLValuePB result;
+    ASSERT_OK(Jsonb::ApplyJsonbOperators(jsonb.SerializedJsonb(), ops, &result));
+    ASSERT_TRUE(IsNull(result));
+  }
+}
+
 }  // namespace common
 }  // namespace yb
@@ -706,24 +706,27 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
 
   size_t num_kv_pairs = GetCount(jsonb_header);
   const string& search_key = json_op.operand().value().string_value();
+  // Keys are serialized in std::string order, which is the order of Slice::compare, so the
+  // search runs over the serialized keys without copying them.
+  const Slice search_key_slice(search_key);
 
   size_t metadata_begin_offset = sizeof(jsonb_header);
   size_t data_begin_offset = ComputeDataOffset(num_kv_pairs, kJBObject);
 
   // Binary search to find the key.
   int64_t low = 0, high = num_kv_pairs - 1;
-  auto search_key_slice = Slice(search_key);
   while (low <= high) {
     size_t mid = low + (high - low)/2;
     Slice mid_key;
     RETURN_NOT_OK(GetObjectKey(mid, jsonb, metadata_begin_offset, data_begin_offset, &mid_key));
 
-    if (mid_key == search_key_slice) {
+    const int cmp = mid_key.compare(search_key_slice);
+    if (cmp == 0) {
       RETURN_NOT_OK(GetObjectValue(mid, jsonb, sizeof(jsonb_header),
                                    ComputeDataOffset(num_kv_pairs, kJBObject), num_kv_pairs,
                                    result, element_metadata));
       return Status::OK();
-    } else if (mid_key.ToBuffer() > search_key) {
+    } else if (cmp > 0) {
       high = mid - 1;
     } else {
       low = mid + 1;
@@ -732,33 +735,39 @@ Status Jsonb::ApplyJsonbOperatorToObject(const Slice& jsonb, const QLJsonOperati
   return STATUS_SUBSTITUTE(NotFound, "Couldn't find key $0 in json document", search_key);
 }
 
-Status Jsonb::ApplyJsonbOperators(const std::string &serialized_json,
-                                  const QLJsonColumnOperationsPB& json_ops,
-                                  QLValuePB* result) {
+Status Jsonb::FindPath(const Slice& jsonb, const QLJsonColumnOperationsPB& json_ops,
+                       Slice* result, JEntry* element_metadata) {
   const int num_ops = json_ops.json_operations().size();
 
-  Slice jsonop_result;
-  Slice operand(serialized_json);
-  JEntry element_metadata;
+  Slice operand = jsonb;
   for (int i = 0; i < num_ops; i++) {
     const QLJsonOperationPB &op = json_ops.json_operations().Get(i);
-    const Status s = ApplyJsonbOperator(operand, op, &jsonop_result,
-                                        &element_metadata);
-    if (s.IsNotFound()) {
-      // We couldn't apply the operator to the operand and hence return null as the result.
-      SetNull(result);
-      return Status::OK();
-    }
-    RETURN_NOT_OK(s);
+    RETURN_NOT_OK(ApplyJsonbOperator(operand, op, result, element_metadata));
 
-    if (IsScalar(element_metadata) && i != num_ops - 1) {
+    if (IsScalar(*element_metadata) && i != num_ops - 1) {
       // We have to apply another operation after this, but we received a scalar intermediate
       // result.
-      SetNull(result);
-      return Status::OK();
+      return STATUS(NotFound, "Cannot apply operators to scalar values");
     }
-    operand = jsonop_result;
+    operand = *result;
   }
+  return Status::OK();
+}
+
+Status Jsonb::ApplyJsonbOperators(const Slice& serialized_json,
+                                  const QLJsonColumnOperationsPB& json_ops,
+                                  QLValuePB* result) {
+  const int num_ops = json_ops.json_operations().size();
+
+  Slice jsonop_result;
+  JEntry element_metadata;
+  const Status s = FindPath(serialized_json, json_ops, &jsonop_result, &element_metadata);
+  if (s.IsNotFound()) {
+    // We couldn't apply the operators to the operand and hence return null as the result.
+    SetNull(result);
+    return Status::OK();
+  }
+  RETURN_NOT_OK(s);
 
   // In case of '->>', we need to return a string result.
   if (num_ops > 0 &&
@@ -774,12 +783,14 @@ Status Jsonb::ApplyJsonbOperators(const std::string &serialized_json,
     return Status::OK();
   }
 
-  string jsonb_result = jsonop_result.ToBuffer();
+  string jsonb_result;
   if (IsScalar(element_metadata)) {
     // In case of a scalar that is received from an operation, convert it to a jsonb scalar.
     RETURN_NOT_OK(CreateScalar(jsonop_result,
                                element_metadata,
                                &jsonb_result));
+  } else {
+    jsonb_result.assign(jsonop_result.cdata(), jsonop_result.size());
   }
   result->set_jsonb_value(std::move(jsonb_result));
   return Status::OK();
@@ -85,9 +85,19 @@ class Jsonb {
   // Returns a json string for serialized jsonb
   Status ToJsonString(std::string* json) const;
 
-  static Status ApplyJsonbOperators(const std::string &serialized_json,
-                                            const QLJsonColumnOperationsPB& json_ops,
-                                            QLValuePB* result);
+  // Applies the '->' and '->>' operators in json_ops to serialized jsonb. Returns null in result
+  // when the path does not exist.
+  static Status ApplyJsonbOperators(const Slice& serialized_json,
+                                    const QLJsonColumnOperationsPB& json_ops,
+                                    QLValuePB* result);
+
+  // Follows the path given by json_ops directly over serialized jsonb, without decoding it. Object
+  // keys are found by binary search over the sorted keys, and the JEntry offsets locate values and
+  // array elements, so only the headers on the path are read. result points into jsonb, and
+  // element_metadata is the JEntry of the element found. Returns NotFound when the path does not
+  // exist or goes through a scalar.
+  static Status FindPath(const Slice& jsonb, const QLJsonColumnOperationsPB& json_ops,
+                         Slice* result, JEntry* element_metadata);
 
   const std::string& SerializedJsonb() const;
 
@@ -430,6 +430,118 @@ Status QLExprExecutor::EvalCondition(const QLConditionPB& condition,
 
 //--------------------------------------------------------------------------------------------------
 
+std::unique_ptr<QLCompiledCondition> QLCompiledCondition::Compile(
+    const QLConditionPB& condition) {
+  auto result = std::make_unique<QLCompiledCondition>();
+  if (!result->AddTerms(condition)) {
+    return nullptr;
+  }
+  return result;
+}
+
+bool QLCompiledCondition::AddTerms(const QLConditionPB& condition) {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_AND:
+      if (operands.empty()) {
+        return false;
+      }
+      for (const auto& operand : operands) {
+        if (!operand.has_condition() || !AddTerms(operand.condition())) {
+          return false;
+        }
+      }
+      return true;
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL:
+      if (operands.size() != 1 || !operands.Get(0).has_column_id()) {
+        return false;
+      }
+      terms_.push_back(Term {
+        .column_id = operands.Get(0).column_id(),
+        .op = condition.op(),
+        .value = nullptr,
+      });
+      return true;
+
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL:
+      if (operands.size() != 2 || !operands.Get(0).has_column_id() ||
+          !operands.Get(1).has_value()) {
+        return false;
+      }
+      terms_.push_back(Term {
+        .column_id = operands.Get(0).column_id(),
+        .op = condition.op(),
+        .value = &operands.Get(1).value(),
+      });
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+Result<bool> QLCompiledCondition::Evaluate(const QLTableRow& table_row) const {
+  static const QLValuePB kNullValue;
+
+  for (const auto& term : terms_) {
+    // A missing column reads as null, as in QLTableRow::ReadColumn.
+    const auto* column_value = table_row.GetColumn(term.column_id);
+    const auto& lhs = column_value ? *column_value : kNullValue;
+    bool matched;
+    switch (term.op) {
+      case QL_OP_IS_NULL:
+        matched = IsNull(lhs);
+        break;
+      case QL_OP_IS_NOT_NULL:
+        matched = !IsNull(lhs);
+        break;
+      default: {
+        const auto& rhs = *term.value;
+        if (!Comparable(lhs, rhs)) {
+          return STATUS(RuntimeError, "values not comparable");
+        }
+        switch (term.op) {
+          case QL_OP_EQUAL:
+            matched = lhs == rhs;
+            break;
+          case QL_OP_LESS_THAN:
+            matched = lhs < rhs;
+            break;
+          case QL_OP_LESS_THAN_EQUAL:
+            matched = lhs <= rhs;
+            break;
+          case QL_OP_GREATER_THAN:
+            matched = lhs > rhs;
+            break;
+          case QL_OP_GREATER_THAN_EQUAL:
+            matched = lhs >= rhs;
+            break;
+          case QL_OP_NOT_EQUAL:
+            matched = lhs != rhs;
+            break;
+          default:
+            return STATUS_FORMAT(IllegalState, "Unexpected operator in compiled condition: $0",
+                                 QLOperator_Name(term.op));
+        }
+        break;
+      }
+    }
+    if (!matched) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 bfpg::TSOpcode GetTSWriteInstruction(const PgsqlExpressionPB& ql_expr) {
   // "kSubDocInsert" instructs the tablet server to insert a new value or replace an existing value.
   if (ql_expr.has_tscall()) {
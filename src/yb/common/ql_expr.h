@@ -357,6 +357,30 @@ class QLExprExecutor {
   Result<QLValuePB> EvalBFCall(const Expr& bfcall, const QLTableRow& table_row);
 };
 
+// A QL condition flattened once per request, to be evaluated against many rows without walking
+// the protobuf expression tree. Only conjunctions of comparisons between a column and a constant,
+// and null checks of a column, are compiled. These are the usual shape of a WHERE clause that the
+// scan spec cannot turn into key bounds. The result is the same as QLExprExecutor::EvalCondition.
+class QLCompiledCondition {
+ public:
+  // Returns nullptr when the condition has a shape that is not supported.
+  static std::unique_ptr<QLCompiledCondition> Compile(const QLConditionPB& condition);
+
+  Result<bool> Evaluate(const QLTableRow& table_row) const;
+
+ private:
+  struct Term {
+    ColumnIdRep column_id;
+    QLOperator op;
+    // Constant operand, nullptr for null checks.
+    const QLValuePB* value;
+  };
+
+  bool AddTerms(const QLConditionPB& condition);
+
+  boost::container::small_vector<Term, 4> terms_;
+};
+
 template <class It>
 Status EvalOperandsHelper(
     QLExprExecutor* executor, It it, const QLTableRow& table_row) {
@@ -20,10 +20,29 @@
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
 
+#include "yb/util/flags.h"
+#include "yb/util/result.h"
+
+DEFINE_RUNTIME_bool(ycql_compile_scan_conditions, true,
+    "Whether YCQL WHERE and IF conditions of simple shape are compiled once per scan, instead of "
+    "being interpreted from the expression tree for every row.");
+TAG_FLAG(ycql_compile_scan_conditions, advanced);
+
 namespace yb {
 
 using std::vector;
 
+namespace {
+
+std::unique_ptr<QLCompiledCondition> CompileCondition(const QLConditionPB* condition) {
+  if (condition == nullptr) {
+    return nullptr;
+  }
+  return QLCompiledCondition::Compile(*condition);
+}
+
+} // namespace
+
 //-------------------------------------- QL scan range --------------------------------------
 QLScanRange::QLScanRange(const Schema& schema, const QLConditionPB& condition)
     : schema_(schema) {
@@ -539,16 +558,26 @@ QLScanSpec::QLScanSpec(const QLConditionPB* condition,
   if (executor_ == nullptr) {
     executor_ = std::make_shared<QLExprExecutor>();
   }
+  if (FLAGS_ycql_compile_scan_conditions) {
+    compiled_condition_ = CompileCondition(condition_);
+    compiled_if_condition_ = CompileCondition(if_condition_);
+  }
 }
 
+QLScanSpec::~QLScanSpec() = default;
+
 // Evaluate the WHERE condition for the given row.
 Status QLScanSpec::Match(const QLTableRow& table_row, bool* match) const {
   bool cond = true;
   bool if_cond = true;
-  if (condition_ != nullptr) {
+  if (compiled_condition_) {
+    cond = VERIFY_RESULT(compiled_condition_->Evaluate(table_row));
+  } else if (condition_ != nullptr) {
     RETURN_NOT_OK(executor_->EvalCondition(*condition_, table_row, &cond));
   }
-  if (if_condition_ != nullptr) {
+  if (compiled_if_condition_) {
+    if_cond = VERIFY_RESULT(compiled_if_condition_->Evaluate(table_row));
+  } else if (if_condition_ != nullptr) {
     RETURN_NOT_OK(executor_->EvalCondition(*if_condition_, table_row, &if_cond));
   }
   *match = cond && if_cond;
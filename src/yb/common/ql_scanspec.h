@@ -158,7 +158,7 @@ class QLScanSpec : public YQLScanSpec {
              const bool is_forward_scan,
              QLExprExecutorPtr executor = nullptr);
 
-  virtual ~QLScanSpec() {}
+  virtual ~QLScanSpec();
 
   // Evaluate the WHERE condition for the given row to decide if it is selected or not.
   // virtual to make the class polymorphic.
@@ -176,6 +176,10 @@ class QLScanSpec : public YQLScanSpec {
   const QLConditionPB* if_condition_;
   const bool is_forward_scan_;
   QLExprExecutorPtr executor_;
+
+  // Compiled forms of condition_ and if_condition_, when they have a supported shape.
+  std::unique_ptr<QLCompiledCondition> compiled_condition_;
+  std::unique_ptr<QLCompiledCondition> compiled_if_condition_;
 };
 
 //--------------------------------------------------------------------------------------------------
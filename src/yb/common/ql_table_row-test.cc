@@ -14,9 +14,12 @@
 #include <boost/functional/hash.hpp>
 #include <gtest/gtest.h>
 
+#include "yb/common/common.pb.h"
 #include "yb/common/ql_expr.h"
 
 #include "yb/util/random_util.h"
+#include "yb/util/result.h"
+#include "yb/util/test_macros.h"
 
 namespace yb {
 
@@ -75,4 +78,62 @@ TEST(QLTableRowTest, Random) {
   }
 }
 
+namespace {
+
+void AddColumnCondition(
+    QLConditionPB* condition, QLOperator op, ColumnIdRep column_id, const QLValuePB* value) {
+  auto* term = condition->add_operands()->mutable_condition();
+  term->set_op(op);
+  term->add_operands()->set_column_id(column_id);
+  if (value) {
+    *term->add_operands()->mutable_value() = *value;
+  }
+}
+
+} // namespace
+
+TEST(QLTableRowTest, CompiledCondition) {
+  constexpr int kRows = 1000;
+  const ColumnIdRep column1 = kFirstColumnIdRep;
+  const ColumnIdRep column2 = kFirstColumnIdRep + 1;
+
+  QLValuePB upper;
+  upper.set_int32_value(70);
+  QLValuePB excluded;
+  excluded.set_int32_value(30);
+
+  // column1 < 70 AND column1 != 30 AND column2 IS NOT NULL.
+  QLConditionPB condition;
+  condition.set_op(QL_OP_AND);
+  AddColumnCondition(&condition, QL_OP_LESS_THAN, column1, &upper);
+  AddColumnCondition(&condition, QL_OP_NOT_EQUAL, column1, &excluded);
+  AddColumnCondition(&condition, QL_OP_IS_NOT_NULL, column2, nullptr);
+
+  auto compiled = QLCompiledCondition::Compile(condition);
+  ASSERT_NE(compiled, nullptr);
+
+  QLExprExecutor executor;
+  QLTableRow row;
+  for (int i = kRows; i-- > 0;) {
+    row.Clear();
+    QLValuePB value;
+    value.set_int32_value(RandomUniformInt(0, 100));
+    row.AllocColumn(column1, value);
+    if (RandomUniformBool()) {
+      row.AllocColumn(column2, value);
+    }
+
+    bool expected = false;
+    ASSERT_OK(executor.EvalCondition(condition, row, &expected));
+    ASSERT_EQ(ASSERT_RESULT(compiled->Evaluate(row)), expected) << row.ToString();
+  }
+
+  // Conditions on expressions other than plain columns are left to the interpreter.
+  QLConditionPB unsupported;
+  unsupported.set_op(QL_OP_OR);
+  AddColumnCondition(&unsupported, QL_OP_IS_NULL, column1, nullptr);
+  AddColumnCondition(&unsupported, QL_OP_IS_NULL, column2, nullptr);
+  ASSERT_EQ(QLCompiledCondition::Compile(unsupported), nullptr);
+}
+
 } // namespace yb
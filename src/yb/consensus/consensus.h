@@ -329,9 +329,10 @@ class Consensus {
       MicrosTime min_allowed, CoarseTimePoint deadline) const = 0;
 
   // Read majority replicated messages for CDC producer.
+  // max_batch_size_bytes == 0 means consensus_max_batch_size_bytes.
   virtual Result<ReadOpsResult> ReadReplicatedMessagesForCDC(
       const yb::OpId& from, int64_t* repl_index, const CoarseTimePoint deadline,
-      const bool fetch_single_entry = false) = 0;
+      const bool fetch_single_entry = false, size_t max_batch_size_bytes = 0) = 0;
 
   virtual void UpdateCDCConsumerOpId(const yb::OpId& op_id) = 0;
 
@@ -751,7 +751,7 @@ Result<ReadOpsResult> PeerMessageQueue::ReadFromLogCache(
 // CDC producer will use this to get the messages to send in response to cdc::GetChanges RPC.
 Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(
     const yb::OpId& last_op_id, int64_t* repl_index, const CoarseTimePoint deadline,
-    const bool fetch_single_entry) {
+    const bool fetch_single_entry, size_t max_batch_size_bytes) {
   // The batch of messages read from cache.
 
   int64_t to_index;
@@ -777,9 +777,11 @@ Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(
                              max(log_cache_.earliest_op_index(), last_op_id.index) :
                              last_op_id.index;
 
+  const size_t max_size = max_batch_size_bytes
+      ? std::min<size_t>(max_batch_size_bytes, FLAGS_rpc_max_message_size / 2)
+      : FLAGS_consensus_max_batch_size_bytes;
   auto result = ReadFromLogCache(
-      after_op_index, to_index, FLAGS_consensus_max_batch_size_bytes, local_peer_uuid_, deadline,
-      fetch_single_entry);
+      after_op_index, to_index, max_size, local_peer_uuid_, deadline, fetch_single_entry);
   if (PREDICT_FALSE(!result.ok()) && PREDICT_TRUE(result.status().IsNotFound())) {
     const std::string premature_gc_warning =
       Format("The logs from index $0 have been garbage collected and cannot be read ($1)",
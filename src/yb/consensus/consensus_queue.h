@@ -385,10 +385,13 @@ class PeerMessageQueue {
   }
 
   // Read replicated log records starting from the OpId immediately after last_op_id.
+  // Reads at most max_batch_size_bytes, or consensus_max_batch_size_bytes when it is 0. The limit
+  // is capped at half of rpc_max_message_size, so that the CDC response still fits in one RPC.
   Result<ReadOpsResult> ReadReplicatedMessagesForCDC(
       const yb::OpId& last_op_id, int64_t* last_replicated_opid_index = nullptr,
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
-      const bool fetch_single_entry = false);
+      const bool fetch_single_entry = false,
+      size_t max_batch_size_bytes = 0);
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id);
 
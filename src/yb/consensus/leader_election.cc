@@ -32,6 +32,7 @@
 
 #include "yb/consensus/leader_election.h"
 
+#include <atomic>
 #include <functional>
 #include <mutex>
 
@@ -143,6 +144,16 @@ bool VoteCounter::AreAllVotesIn() const {
 // LeaderElection
 ///////////////////////////////////////////////////
 
+namespace {
+
+std::atomic<int64_t> num_running_elections{0};
+
+} // namespace
+
+int64_t LeaderElection::NumRunning() {
+  return num_running_elections.load(std::memory_order_acquire);
+}
+
 LeaderElection::LeaderElection(const RaftConfigPB& config,
                                PeerProxyFactory* proxy_factory,
                                const VoteRequestPB& request,
@@ -182,14 +193,25 @@ LeaderElection::LeaderElection(const RaftConfigPB& config,
       << "Expected different number of followers. Follower UUIDs: ["
       << yb::ToString(voting_follower_uuids_)
       << "]; RaftConfig: {" << config.ShortDebugString() << "}";
+
+  num_running_elections.fetch_add(1, std::memory_order_acq_rel);
+  counted_as_running_.store(true, std::memory_order_release);
 }
 
 LeaderElection::~LeaderElection() {
+  // Election could be destroyed without decision, for instance during shutdown.
+  StopCountingAsRunning();
   std::lock_guard<Lock> guard(lock_);
   DCHECK(has_responded_); // We must always call the callback exactly once.
   voter_state_.clear();
 }
 
+void LeaderElection::StopCountingAsRunning() {
+  if (counted_as_running_.exchange(false, std::memory_order_acq_rel)) {
+    num_running_elections.fetch_sub(1, std::memory_order_acq_rel);
+  }
+}
+
 void LeaderElection::Run() {
   VLOG_WITH_PREFIX(1) << "Running leader election.";
 
@@ -254,6 +276,7 @@ void LeaderElection::CheckForDecision() {
 
   // Respond outside of the lock.
   if (to_respond) {
+    StopCountingAsRunning();
     // This is thread-safe since result_ is write-once.
     decision_callback_(result_);
   }
@@ -32,6 +32,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <map>
 #include <string>
@@ -184,6 +185,9 @@ class LeaderElection : public RefCountedThreadSafe<LeaderElection> {
   // Run the election: send the vote request to followers.
   void Run();
 
+  // Number of elections in this process that were created but not decided yet.
+  static int64_t NumRunning();
+
  private:
   friend class RefCountedThreadSafe<LeaderElection>;
 
@@ -201,6 +205,9 @@ class LeaderElection : public RefCountedThreadSafe<LeaderElection> {
   // This class is refcounted.
   ~LeaderElection();
 
+  // Removes this election from the number of running elections, if it was not removed yet.
+  void StopCountingAsRunning();
+
   // Check to see if a decision has been made. If so, invoke decision callback.
   // Calls the callback outside of holding a lock.
   void CheckForDecision();
@@ -241,6 +248,9 @@ class LeaderElection : public RefCountedThreadSafe<LeaderElection> {
   // Whether we have responded via the callback yet.
   bool has_responded_ = false;
 
+  // Whether this election is included in the number of running elections.
+  std::atomic<bool> counted_as_running_{false};
+
   // Election request to send to voters.
   const VoteRequestPB request_;
 
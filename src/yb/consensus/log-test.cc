@@ -63,6 +63,8 @@ DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
+DECLARE_bool(log_zero_preallocated_segments);
+DECLARE_bool(log_lz4_compression);
 
 namespace yb {
 namespace log {
@@ -573,6 +575,76 @@ TEST_F(LogTest, TestSegmentRollover) {
   ASSERT_EQ(num_entries, total_read);
 }
 
+// Zero filled segments should be readable the same way as the regular preallocated segments.
+TEST_F(LogTest, TestSegmentRolloverWithZeroFill) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_zero_preallocated_segments) = true;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+  const int kNumEntriesPerBatch = 100;
+
+  OpIdPB op_id = MakeOpId(1, 1);
+  size_t num_entries = 0;
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  while (segments.size() < 3) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+  ASSERT_OK(log_->Close());
+
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(
+      fs_manager_->env(), nullptr, "Log reader: ", tablet_wal_path_, nullptr, nullptr, &reader));
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+
+  size_t total_read = 0;
+  for (const scoped_refptr<ReadableLogSegment>& entry : segments) {
+    auto read_entries = entry->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    total_read += read_entries.entries.size();
+  }
+  ASSERT_EQ(num_entries, total_read);
+}
+
+TEST_F(LogTest, TestLz4Compression) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_lz4_compression) = true;
+  BuildLog();
+  log_->SetMaxSegmentSizeForTests(990);
+  const int kNumEntriesPerBatch = 100;
+
+  OpIdPB op_id = MakeOpId(1, 1);
+  size_t num_entries = 0;
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  while (segments.size() < 3) {
+    ASSERT_OK(AppendNoOps(&op_id, kNumEntriesPerBatch));
+    num_entries += kNumEntriesPerBatch;
+    ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  }
+  ASSERT_OK(log_->Close());
+
+  // Segments written with compression could be read after the flag is turned off.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_log_lz4_compression) = false;
+  std::unique_ptr<LogReader> reader;
+  ASSERT_OK(LogReader::Open(
+      fs_manager_->env(), nullptr, "Log reader: ", tablet_wal_path_, nullptr, nullptr, &reader));
+  ASSERT_OK(reader->GetSegmentsSnapshot(&segments));
+
+  size_t total_read = 0;
+  for (const scoped_refptr<ReadableLogSegment>& entry : segments) {
+    ASSERT_EQ(LOG_COMPRESSION_LZ4, entry->header().compression());
+    auto read_entries = entry->ReadEntries();
+    ASSERT_OK(read_entries.status);
+    total_read += read_entries.entries.size();
+  }
+  ASSERT_EQ(num_entries, total_read);
+}
+
 TEST_F(LogTest, TestWriteAndReadToAndFromInProgressSegment) {
   const int kNumEntries = 4;
   BuildLog();
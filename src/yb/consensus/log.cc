@@ -139,6 +139,18 @@ DEFINE_UNKNOWN_double(log_background_sync_interval_fraction, 0.6,
              "entry exceeds interval_durable_wal_write_ms*log_background_sync_interval_fraction "
              "the fsync task is pushed to the log-sync queue.");
 
+DEFINE_RUNTIME_bool(log_zero_preallocated_segments, false,
+    "Whether to write zeros over the preallocated part of a new WAL segment and sync them before "
+    "the segment becomes active. fallocate() leaves unwritten extents, so the first write to each "
+    "block of the segment also has to update file system metadata during fsync. Zeroing is done "
+    "by the allocation thread, off the append path, at the cost of writing every segment twice.");
+TAG_FLAG(log_zero_preallocated_segments, advanced);
+
+DEFINE_RUNTIME_bool(log_lz4_compression, false,
+    "Whether to compress WAL entry batches with LZ4. The setting is recorded in the header of "
+    "every segment and takes effect starting from the next allocated segment. Segments written "
+    "with compression cannot be read by versions that do not support it.");
+TAG_FLAG(log_lz4_compression, advanced);
 
 // Flags for controlling kernel watchdog limits.
 DEFINE_RUNTIME_int32(consensus_log_scoped_watch_delay_callback_threshold_ms, 1000,
@@ -1691,15 +1703,40 @@ Status Log::PreAllocateNewSegment() {
   if (options_.preallocate_segments) {
     uint64_t next_segment_size = NextSegmentDesiredSize();
     TRACE("Preallocating $0 byte segment in $1", next_segment_size, next_segment_path_);
-    // TODO (perf) zero the new segments -- this could result in additional performance
-    // improvements.
     RETURN_NOT_OK(next_segment_file_->PreAllocate(next_segment_size));
+    if (FLAGS_log_zero_preallocated_segments) {
+      RETURN_NOT_OK(ZeroFillSegment(next_segment_path_, next_segment_size));
+    }
   }
 
   allocation_state_.store(SegmentAllocationState::kAllocationFinished, std::memory_order_release);
   return Status::OK();
 }
 
+Status Log::ZeroFillSegment(const std::string& path, uint64_t size) {
+  TRACE_EVENT1("log", "ZeroFillSegment", "file", path);
+  constexpr size_t kZeroBlockSize = 1_MB;
+  static const std::string kZeros(kZeroBlockSize, '\0');
+
+  // When the file system does not support fallocate(), nothing was preallocated, and writing zeros
+  // would grow the placeholder segment to its full size.
+  size = std::min(size, VERIFY_RESULT(get_env()->GetFileSize(path)));
+  if (size == 0) {
+    return Status::OK();
+  }
+
+  RWFileOptions opts;
+  opts.mode = Env::OPEN_EXISTING;
+  std::unique_ptr<RWFile> file;
+  RETURN_NOT_OK(get_env()->NewRWFile(opts, path, &file));
+  for (uint64_t offset = 0; offset < size; offset += kZeroBlockSize) {
+    auto len = std::min<uint64_t>(kZeroBlockSize, size - offset);
+    RETURN_NOT_OK(file->Write(offset, Slice(kZeros.data(), len)));
+  }
+  RETURN_NOT_OK(file->Sync());
+  return file->Close();
+}
+
 Status Log::SwitchToAllocatedSegment() {
   CHECK_EQ(allocation_state(), SegmentAllocationState::kAllocationFinished);
   // Increment "next" log segment seqno.
@@ -1728,6 +1765,9 @@ Status Log::SwitchToAllocatedSegment() {
   header.set_minor_version(kLogMinorVersion);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_unused_tablet_id(tablet_id_);
+  if (FLAGS_log_lz4_compression) {
+    header.set_compression(LOG_COMPRESSION_LZ4);
+  }
 
   // Set up the new footer. This will be maintained as the segment is written.
   footer_builder_.Clear();
@@ -378,6 +378,11 @@ class Log : public RefCountedThreadSafe<Log> {
   // Preallocates the space for a new segment.
   Status PreAllocateNewSegment();
 
+  // Overwrites the first 'size' bytes of the placeholder segment at 'path' with zeros and syncs
+  // them, so that appends to the segment do not have to convert unwritten extents. Only the part
+  // that was actually preallocated is overwritten.
+  Status ZeroFillSegment(const std::string& path, uint64_t size);
+
   // Returns the desired size for the next log segment to be created.
   uint64_t NextSegmentDesiredSize();
 
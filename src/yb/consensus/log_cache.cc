@@ -104,6 +104,15 @@ namespace {
 
 const std::string kParentMemTrackerId = "log_cache"s;
 
+// Calculate the total byte size that will be used on the wire to replicate this message as part of
+// a consensus update request. This accounts for the length delimiting and tagging of the message.
+int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
+  auto msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
+      msg.SerializedSize());
+  msg_size += 1; // for the type tag
+  return msg_size;
+}
+
 }
 
 typedef vector<const ReplicateMsg*>::const_iterator MsgIter;
@@ -137,7 +146,8 @@ LogCache::LogCache(const scoped_refptr<MetricEntity>& metric_entity,
   // Put a fake message at index 0, since this simplifies a lot of our code paths elsewhere.
   auto zero_op = rpc::MakeSharedMessage<LWReplicateMsg>();
   *zero_op->mutable_id() = MinimumOpId();
-  InsertOrDie(&cache_, 0, { zero_op, zero_op->SpaceUsedLong() });
+  InsertOrDie(&cache_, 0, {
+      zero_op, zero_op->SpaceUsedLong(), TotalByteSizeForMessage(*zero_op) });
 }
 
 MemTrackerPtr LogCache::GetServerMemTracker(const MemTrackerPtr& server_tracker) {
@@ -179,7 +189,7 @@ LogCache::PrepareAppendResult LogCache::PrepareAppendOperations(const ReplicateM
   std::vector<CacheEntry> entries_to_insert;
   entries_to_insert.reserve(msgs.size());
   for (const auto& msg : msgs) {
-    CacheEntry e = { msg, msg->SpaceUsedLong() };
+    CacheEntry e = { msg, msg->SpaceUsedLong(), TotalByteSizeForMessage(*msg) };
     result.mem_required += e.mem_usage;
     entries_to_insert.emplace_back(std::move(e));
   }
@@ -319,15 +329,6 @@ Result<yb::OpId> LogCache::LookupOpId(int64_t op_index) const {
 
 namespace {
 
-// Calculate the total byte size that will be used on the wire to replicate this message as part of
-// a consensus update request. This accounts for the length delimiting and tagging of the message.
-int64_t TotalByteSizeForMessage(const LWReplicateMsg& msg) {
-  auto msg_size = google::protobuf::internal::WireFormatLite::LengthDelimitedSize(
-      msg.SerializedSize());
-  msg_size += 1; // for the type tag
-  return msg_size;
-}
-
 Status UpdateResultHeaderSchemaFromSegment(
     log::LogReader* log_reader, const int64_t segment_seq_num, ReadOpsResult* result) {
   const auto segment_result = log_reader->GetSegmentBySequenceNumber(segment_seq_num);
@@ -471,7 +472,7 @@ Result<ReadOpsResult> LogCache::ReadOps(
           continue;
         }
 
-        auto current_message_size = TotalByteSizeForMessage(*msg);
+        auto current_message_size = iter->second.wire_size;
         remaining_space -= current_message_size;
         if (remaining_space < 0 && !result.messages.empty()) {
           break;
@@ -199,6 +199,11 @@ class LogCache {
     // to compute, so we compute it only once upon insertion.
     size_t mem_usage = 0;
 
+    // The cached value of TotalByteSizeForMessage(*msg), i.e. the size of msg in an update request.
+    // It is used by ReadOps, so that reading cached operations for followers does not recompute
+    // the serialized size of every message under the cache lock.
+    int64_t wire_size = 0;
+
     // Did we start memory tracking for this entry.
     bool tracked = false;
   };
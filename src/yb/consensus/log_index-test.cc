@@ -30,6 +30,10 @@
 // under the License.
 //
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "yb/consensus/log_index.h"
 #include "yb/consensus/opid_util.h"
 
@@ -149,5 +153,35 @@ TEST_F(LogIndexTest, TestMultiSegmentWithGC) {
   VerifyNotFound(entries_per_chunk * 2.5);
 }
 
+TEST_F(LogIndexTest, ConcurrentReadAndOverwrite) {
+  constexpr int64_t kOpIndex = 10;
+  constexpr int64_t kOffsetMultiplier = 1000;
+  constexpr int kNumReaders = 4;
+  ASSERT_OK(AddEntry(MakeOpId(1, kOpIndex), 1, kOffsetMultiplier));
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> readers;
+  for (int i = 0; i != kNumReaders; ++i) {
+    readers.emplace_back([this, &stop] {
+      while (!stop.load(std::memory_order_acquire)) {
+        LogIndexEntry entry;
+        CHECK_OK(index_->GetEntry(kOpIndex, &entry));
+        // Every written entry has the same term and segment number, so a torn read would be
+        // detected here.
+        CHECK_EQ(entry.op_id.term, entry.segment_sequence_number);
+        CHECK_EQ(entry.op_id.term * kOffsetMultiplier, entry.offset_in_segment);
+      }
+    });
+  }
+
+  for (int64_t term = 2; term != 100000; ++term) {
+    ASSERT_OK(AddEntry(MakeOpId(term, kOpIndex), term, term * kOffsetMultiplier));
+  }
+  stop.store(true, std::memory_order_release);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
 } // namespace log
 } // namespace yb
@@ -40,6 +40,11 @@
 //
 // When the log is GCed, we remove any index chunks which are no longer needed, and
 // unmap them.
+//
+// Updates of entries within a chunk are serialized by the chunk write lock. Readers do not take
+// any lock while copying an entry out of the mapped memory: every chunk carries a version counter
+// that is odd while an update is in progress, and a reader retries if the counter changed during
+// the copy.
 
 #include "yb/consensus/log_index.h"
 
@@ -47,8 +52,10 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 
+#include <atomic>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -57,6 +64,7 @@
 #include "yb/consensus/log.messages.h"
 
 #include "yb/gutil/casts.h"
+#include "yb/gutil/dynamic_annotations.h"
 #include "yb/gutil/map-util.h"
 
 #include "yb/util/atomic.h"
@@ -66,11 +74,19 @@
 #include "yb/util/flags.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
+#include "yb/util/shared_lock.h"
+#include "yb/util/size_literals.h"
 
 DEFINE_UNKNOWN_int32(
     entries_per_index_block, 10000, "Number of entries per index block stored in WAL segment file");
 TAG_FLAG(entries_per_index_block, advanced);
 
+DEFINE_NON_RUNTIME_bool(log_index_huge_page_chunks, false,
+    "Use log index chunks whose size is a multiple of 2MB and advise the kernel to back their "
+    "mappings with transparent huge pages. Reduces TLB misses when old operations are read "
+    "through the log index, e.g. by remote bootstrap and CDC.");
+TAG_FLAG(log_index_huge_page_chunks, advanced);
+
 DEFINE_test_flag(
     int32, entries_per_log_index_chuck, 0,
     "DO NOT CHANGE IN PRODUCTION. If set to value greater than 0 - overrides "
@@ -101,6 +117,11 @@ struct PhysicalEntry {
   }
 } PACKED;
 
+// 24 * 2^20 bytes, i.e. 12 huge pages of 2MB.
+constexpr int32_t kEntriesPerHugePageIndexChunk = 1 << 20;
+static_assert(kEntriesPerHugePageIndexChunk * sizeof(PhysicalEntry) % (2_MB) == 0,
+              "Huge page index chunk should consist of whole 2MB pages");
+
 int32_t GetEntriesPerIndexChunk() {
   // The number of index entries per index chunk.
   //
@@ -110,7 +131,8 @@ int32_t GetEntriesPerIndexChunk() {
   // of the entry within the file is determined via simple "/" and "%" calculations respectively
   // on this value. [Technically, if we did decide to change this number, we would have to
   // implement some logic to compute the number of entries in each file from its size. But
-  // currently, that's not implemented.]
+  // currently, that's not implemented.] It is safe to switch between the chunk sizes below on
+  // restart, since index chunk files are not durable and are removed in LogIndex::Init.
   //
   // On MacOS, ftruncate()'ing a file to its desired size before doing the mmap, immediately uses up
   // actual disk space, whereas on Linux, it appears to be lazy. Since MacOS is unlikely to be
@@ -122,7 +144,8 @@ int32_t GetEntriesPerIndexChunk() {
 #if defined(__APPLE__)
   static int32_t num_entries_per_index_chunk = 16 * 1024;
 #else
-  static int32_t num_entries_per_index_chunk = 1000000;
+  static int32_t num_entries_per_index_chunk =
+      FLAGS_log_index_huge_page_chunks ? kEntriesPerHugePageIndexChunk : 1000000;
 #endif
 
   static class ChunkSizeInitializer {
@@ -160,8 +183,12 @@ class LogIndex::IndexChunk : public RefCountedThreadSafe<LogIndex::IndexChunk> {
   // Open and map the memory.
   Status Open();
   uint8_t* GetPhysicalEntryPtr(int entry_index);
+
+  // Lock free read of the entry, could be invoked concurrently with SetEntry.
   void GetEntry(int entry_index, PhysicalEntry* ret);
-  void SetEntry(int entry_index, const PhysicalEntry& entry);
+
+  // Writes the entry. When overwrite is false, and entry already contains data, leaves it as is.
+  void SetEntry(int entry_index, const PhysicalEntry& entry, Overwrite overwrite);
 
   // Flush memory-mapped chunk to file.
   Status Flush();
@@ -172,6 +199,13 @@ class LogIndex::IndexChunk : public RefCountedThreadSafe<LogIndex::IndexChunk> {
   const string path_;
   int fd_;
   uint8_t* mapping_;
+
+  // Serializes writers. The appender and lazy loading of index blocks could update the same chunk
+  // concurrently.
+  simple_spinlock write_lock_;
+
+  // Incremented before and after each entry update, so it is odd while update is in progress.
+  std::atomic<uint64_t> version_{0};
 };
 
 namespace  {
@@ -212,6 +246,15 @@ Status LogIndex::IndexChunk::Open() {
     return STATUS(IOError, "Unable to mmap()", Errno(err));
   }
 
+#ifdef MADV_HUGEPAGE
+  if (FLAGS_log_index_huge_page_chunks) {
+    // Huge pages are just a hint, so ignore the failure, e.g. when THP is disabled.
+    if (madvise(mapping_, GetChunkFileSize(), MADV_HUGEPAGE) != 0) {
+      VLOG(1) << "madvise(MADV_HUGEPAGE) failed for " << path_ << ": " << Errno(errno);
+    }
+  }
+#endif
+
   return Status::OK();
 }
 
@@ -223,13 +266,47 @@ uint8_t* LogIndex::IndexChunk::GetPhysicalEntryPtr(int entry_index) {
 }
 
 void LogIndex::IndexChunk::GetEntry(int entry_index, PhysicalEntry* ret) {
-  memcpy(ret, GetPhysicalEntryPtr(entry_index), sizeof(PhysicalEntry));
+  const auto* ptr = GetPhysicalEntryPtr(entry_index);
+  for (;;) {
+    auto version = version_.load(std::memory_order_acquire);
+    if (version & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+    // Torn reads are detected by the version check below.
+    ANNOTATE_IGNORE_READS_BEGIN();
+    memcpy(ret, ptr, sizeof(PhysicalEntry));
+    ANNOTATE_IGNORE_READS_END();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (version_.load(std::memory_order_relaxed) == version) {
+      return;
+    }
+  }
 }
 
-void LogIndex::IndexChunk::SetEntry(int entry_index, const PhysicalEntry& phys) {
+void LogIndex::IndexChunk::SetEntry(
+    int entry_index, const PhysicalEntry& phys, Overwrite overwrite) {
   DVLOG_WITH_FUNC(4) << "path: " << path_ << " index_in_chunk: " << entry_index
                     << " entry: " << phys.ToString();
-  memcpy(GetPhysicalEntryPtr(entry_index), &phys, sizeof(PhysicalEntry));
+  auto* ptr = GetPhysicalEntryPtr(entry_index);
+  std::lock_guard<simple_spinlock> l(write_lock_);
+  if (PREDICT_FALSE(!overwrite)) {
+    // Check if destination entry at operation index inside chunk is empty (memory mapped file
+    // content is zero-initialized), so we can load into it and won't overwrite existing index
+    // entry.
+    PhysicalEntry existing;
+    memcpy(&existing, ptr, sizeof(PhysicalEntry));
+    if (existing.offset_in_segment != 0) {
+      // Destination entry for the op_index already exists - don't overwrite.
+      return;
+    }
+  }
+  version_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  ANNOTATE_IGNORE_WRITES_BEGIN();
+  memcpy(ptr, &phys, sizeof(PhysicalEntry));
+  ANNOTATE_IGNORE_WRITES_END();
+  version_.fetch_add(1, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////
@@ -317,7 +394,7 @@ Status LogIndex::GetChunkForIndex(int64_t log_index, bool create,
   DVLOG_WITH_FUNC(4) << "op_index: " << log_index << " chunk_idx: " << chunk_idx;
 
   {
-    std::lock_guard<simple_spinlock> l(open_chunks_lock_);
+    SharedLock<rw_spinlock> l(open_chunks_lock_);
     if (FindCopy(open_chunks_, chunk_idx, chunk)) {
       DVLOG_WITH_FUNC(4) << "chunk_idx: " << chunk_idx << " path: " << (*chunk)->path();
       return Status::OK();
@@ -332,7 +409,7 @@ Status LogIndex::GetChunkForIndex(int64_t log_index, bool create,
                         "Couldn't open index chunk");
   DVLOG_WITH_FUNC(4) << "chunk_idx: " << chunk_idx << " path: " << (*chunk)->path();
   {
-    std::lock_guard<simple_spinlock> l(open_chunks_lock_);
+    std::lock_guard<rw_spinlock> l(open_chunks_lock_);
     if (PREDICT_FALSE(ContainsKey(open_chunks_, chunk_idx))) {
       // Someone else opened the chunk in the meantime.
       // We'll just return that one.
@@ -359,19 +436,7 @@ Status LogIndex::AddEntry(const LogIndexEntry& entry, const Overwrite overwrite)
   phys.term = entry.op_id.term;
   phys.segment_sequence_number = entry.segment_sequence_number;
   phys.offset_in_segment = entry.offset_in_segment;
-  std::lock_guard<simple_spinlock> l(open_chunks_lock_);
-  if (PREDICT_FALSE(!overwrite)) {
-    // Check if destination entry at operation index inside chunk is empty (memory mapped file
-    // content is zero-initialized), so we can load into it and won't overwrite existing index
-    // entry.
-    PhysicalEntry existing;
-    chunk->GetEntry(index_in_chunk, &existing);
-    if (existing.offset_in_segment != 0) {
-      // Destination entry for the op_idex already exists - don't overwrite.
-      return Status::OK();
-    }
-  }
-  chunk->SetEntry(index_in_chunk, phys);
+  chunk->SetEntry(index_in_chunk, phys, overwrite);
 
   DVLOG(3) << "Added log index entry " << entry.ToString();
 
@@ -396,7 +461,6 @@ Status LogIndex::GetEntry(int64_t index, LogIndexEntry* entry) {
   RETURN_NOT_OK(s);
   int index_in_chunk = index % GetEntriesPerIndexChunk();
   PhysicalEntry phys;
-  std::lock_guard<simple_spinlock> l(open_chunks_lock_);
   chunk->GetEntry(index_in_chunk, &phys);
 
   // We never write any real entries to offset 0, because there's a header
@@ -421,7 +485,7 @@ void LogIndex::GC(int64_t min_index_to_retain) {
   // Enumerate which chunks to delete.
   vector<int64_t> chunks_to_delete;
   {
-    std::lock_guard<simple_spinlock> l(open_chunks_lock_);
+    std::lock_guard<rw_spinlock> l(open_chunks_lock_);
     for (auto it = open_chunks_.begin();
          it != open_chunks_.lower_bound(min_chunk_to_retain); ++it) {
       chunks_to_delete.push_back(it->first);
@@ -438,7 +502,7 @@ void LogIndex::GC(int64_t min_index_to_retain) {
     }
     LOG(INFO) << "Deleted log index segment " << path;
     {
-      std::lock_guard<simple_spinlock> l(open_chunks_lock_);
+      std::lock_guard<rw_spinlock> l(open_chunks_lock_);
       open_chunks_.erase(chunk_idx);
     }
   }
@@ -88,6 +88,7 @@ class ReadableLogSegment;
 // This class is thread-safe, but doesn't provide a memory barrier between writers and
 // readers. In other words, if a reader is expected to see an index entry written by a
 // writer, there should be some other synchronization between them to ensure visibility.
+// Reading an entry does not block on concurrent appends to the same chunk.
 //
 // See .cc file for implementation notes.
 class LogIndex : public RefCountedThreadSafe<LogIndex> {
@@ -168,7 +169,8 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
   // The base directory where index files are located.
   const std::string base_dir_;
 
-  simple_spinlock open_chunks_lock_;
+  // Readers take it in shared mode, only opening and GC of chunks take it exclusively.
+  rw_spinlock open_chunks_lock_;
 
   // Map from chunk index to IndexChunk. The chunk index is the log index modulo
   // the number of entries per chunk (see docs in log_index.cc).
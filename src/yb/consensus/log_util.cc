@@ -38,6 +38,7 @@
 #include <utility>
 
 #include <glog/logging.h>
+#include <lz4.h>
 
 #include "yb/common/hybrid_time.h"
 
@@ -921,6 +922,12 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
                                          header.msg_crc, read_crc));
   }
 
+  Slice batch_data = entry_batch_slice.Prefix(header.msg_length);
+  if (header_.compression() == LOG_COMPRESSION_LZ4) {
+    buffer = VERIFY_RESULT(DecompressEntryBatch(batch_data, *offset));
+    batch_data = buffer.AsSlice();
+  }
+
   // TODO(lw_uc) embed buffer and first arena block into holder itself.
   struct DataHolder {
     RefCntBuffer buffer;
@@ -931,7 +938,7 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
 
   auto holder = std::make_shared<DataHolder>(buffer);
   auto batch = holder->arena.NewArenaObject<LWLogEntryBatchPB>();
-  s = batch->ParseFromSlice(entry_batch_slice.Prefix(header.msg_length));
+  s = batch->ParseFromSlice(batch_data);
 
   if (!s.ok()) {
     return STATUS_FORMAT(
@@ -943,6 +950,28 @@ Result<std::shared_ptr<LWLogEntryBatchPB>> ReadableLogSegment::ReadEntryBatch(
   return rpc::SharedField(holder, batch);
 }
 
+Result<RefCntBuffer> ReadableLogSegment::DecompressEntryBatch(
+    const Slice& compressed, int64_t offset) {
+  if (compressed.size() < sizeof(uint32_t)) {
+    return STATUS_FORMAT(
+        Corruption, "Compressed entry batch at offset $0 in $1 is too short: $2",
+        offset, path_, compressed.size());
+  }
+  const auto uncompressed_size = DecodeFixed32(compressed.data());
+  Slice input = compressed.WithoutPrefix(sizeof(uint32_t));
+  RefCntBuffer result(uncompressed_size);
+  const int decompressed_size = LZ4_decompress_safe(
+      input.cdata(), result.data(), narrow_cast<int>(input.size()),
+      narrow_cast<int>(uncompressed_size));
+  if (decompressed_size < 0 || static_cast<uint32_t>(decompressed_size) != uncompressed_size) {
+    return STATUS_FORMAT(
+        Corruption,
+        "Failed to decompress entry batch at offset $0 in $1: expected $2 bytes, got $3",
+        offset, path_, uncompressed_size, decompressed_size);
+  }
+  return result;
+}
+
 const LogSegmentHeaderPB& ReadableLogSegment::header() const {
   DCHECK(header_.IsInitialized());
   return header_;
@@ -1070,9 +1099,24 @@ Status WritableLogSegment::WriteIndexWithFooterAndClose(
   return Status::OK();
 }
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
+  Slice data = entry_batch_data;
+  if (header_.compression() == LOG_COMPRESSION_LZ4) {
+    const int input_size = narrow_cast<int>(entry_batch_data.size());
+    const int max_size = LZ4_compressBound(input_size);
+    compression_buffer_.resize(sizeof(uint32_t) + max_size);
+    InlineEncodeFixed32(compression_buffer_.data(), narrow_cast<uint32_t>(input_size));
+    const int compressed_size = LZ4_compress_default(
+        entry_batch_data.cdata(),
+        pointer_cast<char*>(compression_buffer_.data()) + sizeof(uint32_t), input_size, max_size);
+    if (compressed_size <= 0) {
+      return STATUS_FORMAT(
+          RuntimeError, "Failed to compress $0 bytes entry batch for $1", input_size, path_);
+    }
+    data = Slice(compression_buffer_.data(), sizeof(uint32_t) + compressed_size);
+  }
   uint8_t header_buf[kEntryHeaderSize];
 
   // First encode the length of the message.
@@ -1131,9 +1175,14 @@ Status WritableLogSegment::WriteIndexBlock(const LogIndexBlock& index_block) {
   uint8_t size_buf[sizeof(int64_t)];
   InlineEncodeFixed64(size_buf, index_block_header_buffer_.size());
 
-  RETURN_NOT_OK(writable_file_->Append(Slice(size_buf, sizeof(int64_t))));
-  RETURN_NOT_OK(writable_file_->Append(Slice(index_block_header_buffer_)));
-  return writable_file_->Append(index_block.data);
+  std::array<Slice, 3> slices = {
+      Slice(size_buf, sizeof(int64_t)),
+      Slice(index_block_header_buffer_),
+      Slice(index_block.data),
+  };
+
+  // Write the size, the header and the index block itself with a single writev.
+  return writable_file_->AppendSlices(slices.data(), slices.size());
 }
 
 Status WritableLogSegment::Sync() {
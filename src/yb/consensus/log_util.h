@@ -53,6 +53,7 @@
 #include "yb/util/env.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/restart_safe_clock.h"
 #include "yb/util/status.h"
 #include "yb/util/tostring.h"
@@ -346,6 +347,9 @@ class ReadableLogSegment : public RefCountedThreadSafe<ReadableLogSegment> {
   Result<std::shared_ptr<LWLogEntryBatchPB>> ReadEntryBatch(
       int64_t *offset, const EntryHeader& header);
 
+  // Decompresses LZ4 compressed entry batch read at 'offset'.
+  Result<RefCntBuffer> DecompressEntryBatch(const Slice& compressed, int64_t offset);
+
   void UpdateReadableToOffset(int64_t readable_to_offset);
 
   int64_t ReadEntriesUpTo();
@@ -475,6 +479,9 @@ class WritableLogSegment {
 
   LogSegmentFooterPB footer_;
 
+  // Buffer for compressed entry batches, reused between WriteEntryBatch calls.
+  faststring compression_buffer_;
+
   // the offset of the first entry in the log
   int64_t first_entry_offset_;
 
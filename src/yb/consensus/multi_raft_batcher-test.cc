@@ -0,0 +1,70 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace consensus {
+
+class MultiRaftBatcherTest : public YBTest {
+ protected:
+  // Returns the time from the first request of a batch until the timer tick that sends it, when
+  // the first request was added offset after a tick.
+  CoarseDuration FlushDelay(CoarseDuration offset, CoarseDuration avg_rtt) {
+    const auto first_request_time = start_ + offset;
+    auto tick = start_ + kInterval;
+    while (ShouldPostponeBatchFlush(tick, first_request_time, kInterval, avg_rtt)) {
+      tick += kInterval;
+    }
+    return tick - first_request_time;
+  }
+
+  static constexpr CoarseDuration kInterval = 50ms;
+  const CoarseTimePoint start_ = CoarseMonoClock::Now();
+};
+
+TEST_F(MultiRaftBatcherTest, AdaptiveFlushDelay) {
+  for (auto offset : {0ms, 1ms, 10ms, 25ms, 49ms}) {
+    SCOPED_TRACE(Format("Offset: $0ms", offset.count()));
+
+    // Without a measured round trip time the batch is sent on the first tick.
+    ASSERT_EQ(FlushDelay(offset, 0ms), kInterval - offset);
+
+    for (auto avg_rtt : {5ms, 20ms, 40ms, 50ms, 200ms}) {
+      SCOPED_TRACE(Format("RTT: $0ms", avg_rtt.count()));
+      auto delay = FlushDelay(offset, avg_rtt);
+      ASSERT_GE(delay, kInterval - offset);
+      // The extra delay does not exceed the round trip time, nor one interval.
+      ASSERT_LE(delay, kInterval + std::min<CoarseDuration>(avg_rtt, kInterval));
+      ASSERT_LE(delay, 2 * kInterval);
+    }
+  }
+
+  // A batch started right after a tick waits for one more tick when the round trip time is at
+  // least one interval.
+  ASSERT_EQ(FlushDelay(0ms, 50ms), 2 * kInterval);
+  ASSERT_EQ(FlushDelay(0ms, 40ms), kInterval);
+  // A batch started late in the period waits for one more tick when that is within the round trip
+  // time.
+  ASSERT_EQ(FlushDelay(40ms, 40ms), 2 * kInterval - 40ms);
+  ASSERT_EQ(FlushDelay(40ms, 5ms), kInterval - 40ms);
+}
+
+} // namespace consensus
+} // namespace yb
@@ -37,6 +37,18 @@ DEFINE_UNKNOWN_uint64(multi_raft_batch_size, 0,
               "Maximum batch size for a multi-Raft consensus payload. Ignored if set to zero.");
 TAG_FLAG(multi_raft_batch_size, advanced);
 
+DEFINE_RUNTIME_bool(multi_raft_adaptive_batching, false,
+    "If true, a multi-Raft batcher that still has a batch in flight to its remote peer lets the "
+    "current batch grow: the size limit is scaled by the number of batches in flight and the "
+    "periodic flush is postponed by up to the observed batch round trip time, so that a request "
+    "waits at most twice multi_raft_heartbeat_interval_ms before it is sent.");
+TAG_FLAG(multi_raft_adaptive_batching, advanced);
+
+DEFINE_RUNTIME_uint64(multi_raft_adaptive_batch_size_max_multiplier, 8,
+    "Upper bound on the factor by which multi_raft_adaptive_batching may scale "
+    "multi_raft_batch_size.");
+TAG_FLAG(multi_raft_adaptive_batch_size_max_multiplier, advanced);
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
 namespace yb {
@@ -55,6 +67,10 @@ struct ResponseCallbackData {
 }
 
 struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
+  // Time when the first request was added to this batch.
+  CoarseTimePoint first_request_time;
+  // Time when the batch was sent.
+  CoarseTimePoint send_time;
   MultiRaftConsensusRequestPB batch_req;
   MultiRaftConsensusResponsePB batch_res;
   rpc::RpcController controller;
@@ -96,14 +112,18 @@ void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
   std::shared_ptr<MultiRaftConsensusData> data = nullptr;
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (current_batch_->response_callback_data.empty()) {
+      current_batch_->first_request_time = CoarseMonoClock::Now();
+    }
     current_batch_->response_callback_data.push_back({
       .resp = response,
       .callback = std::move(callback)
     });
     // Add a ConsensusRequestPB to the batch
     current_batch_->batch_req.add_consensus_request()->Swap(request);
-    if (FLAGS_multi_raft_batch_size > 0
-        && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    auto batch_size_limit = BatchSizeLimit();
+    if (batch_size_limit > 0
+        && current_batch_->response_callback_data.size() >= batch_size_limit) {
       data = PrepareNextBatchRequest();
     }
   }
@@ -114,11 +134,57 @@ void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   std::shared_ptr<MultiRaftConsensusData> data;
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    if (ShouldPostponeFlush()) {
+      return;
+    }
     data = PrepareNextBatchRequest();
   }
   SendBatchRequest(data);
 }
 
+uint64_t MultiRaftHeartbeatBatcher::BatchSizeLimit() const {
+  uint64_t batch_size = FLAGS_multi_raft_batch_size;
+  if (batch_size == 0 || !FLAGS_multi_raft_adaptive_batching) {
+    return batch_size;
+  }
+  uint64_t multiplier = std::min<uint64_t>(
+      1 + in_flight_batches_.load(std::memory_order_acquire),
+      std::max<uint64_t>(FLAGS_multi_raft_adaptive_batch_size_max_multiplier, 1));
+  return batch_size * multiplier;
+}
+
+bool MultiRaftHeartbeatBatcher::ShouldPostponeFlush() {
+  if (!FLAGS_multi_raft_adaptive_batching ||
+      in_flight_batches_.load(std::memory_order_acquire) == 0 ||
+      !current_batch_ || current_batch_->response_callback_data.empty()) {
+    return false;
+  }
+  return ShouldPostponeBatchFlush(
+      CoarseMonoClock::Now(), current_batch_->first_request_time,
+      std::chrono::milliseconds(FLAGS_multi_raft_heartbeat_interval_ms),
+      std::chrono::microseconds(avg_rtt_us_.load(std::memory_order_acquire)));
+}
+
+bool ShouldPostponeBatchFlush(
+    CoarseTimePoint now, CoarseTimePoint first_request_time, CoarseDuration interval,
+    CoarseDuration avg_rtt) {
+  // The batch should be sent by interval + min(rtt, interval) after its first request. The flush
+  // is only postponed when the next timer tick still happens by then, so a heartbeat is never
+  // delayed by more than twice the regular flush interval.
+  auto deadline = first_request_time + interval + std::min(avg_rtt, interval);
+  return now + interval <= deadline;
+}
+
+void MultiRaftHeartbeatBatcher::UpdateRtt(CoarseMonoClock::Duration rtt) {
+  // Exponential moving average with the weight 1/8 for the new sample, as in TCP SRTT.
+  int64_t sample = ToMicroseconds(rtt);
+  int64_t old_value = avg_rtt_us_.load(std::memory_order_acquire);
+  int64_t new_value;
+  do {
+    new_value = old_value == 0 ? sample : old_value + (sample - old_value) / 8;
+  } while (!avg_rtt_us_.compare_exchange_weak(old_value, new_value, std::memory_order_acq_rel));
+}
+
 std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
     MultiRaftHeartbeatBatcher::PrepareNextBatchRequest() {
   if (!current_batch_ || current_batch_->batch_req.consensus_request_size() == 0) {
@@ -140,7 +206,16 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
   data->controller.Reset();
   data->controller.set_timeout(MonoDelta::FromMilliseconds(
       FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
-  auto callback = [data, running_calls = running_calls_]() {
+  data->send_time = CoarseMonoClock::Now();
+  in_flight_batches_.fetch_add(1, std::memory_order_acq_rel);
+  std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+  auto callback = [data, running_calls = running_calls_, weak_self]() {
+    if (auto self = weak_self.lock()) {
+      self->in_flight_batches_.fetch_sub(1, std::memory_order_acq_rel);
+      if (data->controller.status().ok()) {
+        self->UpdateRtt(CoarseMonoClock::Now() - data->send_time);
+      }
+    }
     --*running_calls;
     auto status = data->controller.status();
     for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
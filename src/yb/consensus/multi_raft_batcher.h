@@ -20,6 +20,7 @@
 
 #include "yb/rpc/rpc_controller.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/net/net_util.h"
 
 namespace yb {
@@ -79,6 +80,16 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void MultiRaftUpdateHeartbeatResponseCallback(std::shared_ptr<MultiRaftConsensusData> data);
 
+  // Returns the number of requests after which the current batch is sent without waiting for the
+  // timer, or 0 if there is no such limit.
+  uint64_t BatchSizeLimit() const;
+
+  // Returns true if the periodic timer should not send the current batch yet, because a previous
+  // batch to the same peer is still in flight (see FLAGS_multi_raft_adaptive_batching).
+  bool ShouldPostponeFlush() REQUIRES(mutex_);
+
+  void UpdateRtt(CoarseMonoClock::Duration rtt);
+
   rpc::Messenger* messenger_;
 
   ConsensusServiceProxyPtr consensus_proxy_;
@@ -90,8 +101,21 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   std::shared_ptr<MultiRaftConsensusData> current_batch_ GUARDED_BY(mutex_);
 
   std::atomic<int>* running_calls_;
+
+  // Number of batch requests sent by this batcher that did not complete yet.
+  std::atomic<int> in_flight_batches_{0};
+
+  // Moving average of the batch request round trip time.
+  std::atomic<int64_t> avg_rtt_us_{0};
 };
 
+// Returns true if the periodic flush at time now should leave the current batch, whose first request
+// was added at first_request_time, to the next timer tick. Used by multi_raft_adaptive_batching
+// while a previous batch to the same peer is in flight.
+bool ShouldPostponeBatchFlush(
+    CoarseTimePoint now, CoarseTimePoint first_request_time, CoarseDuration interval,
+    CoarseDuration avg_rtt);
+
 // MultiRaftManager is responsible for managing all MultiRaftHeartbeatBatchers
 // for a given tserver (utilizes a mapping between a hostport and the corresponding batcher).
 // MultiRaftManager allows multiple peers to share the same batcher
@@ -241,6 +241,13 @@ DEFINE_UNKNOWN_int64(protege_synchronization_timeout_ms, 1000,
 DEFINE_test_flag(bool, skip_election_when_fail_detected, false,
                  "Inside RaftConsensus::ReportFailureDetectedTask, skip normal election.");
 
+DEFINE_RUNTIME_int32(leader_election_stagger_threshold, 0,
+    "When the number of leader elections running in this process reaches this value, a replica "
+    "that detected leader failure postpones its own election by a random fraction of the minimum "
+    "election timeout. Helps to spread elections after a node hosting many leaders fails. "
+    "0 to disable.");
+TAG_FLAG(leader_election_stagger_threshold, advanced);
+
 namespace yb {
 namespace consensus {
 
@@ -1024,6 +1031,19 @@ void RaftConsensus::ReportFailureDetectedTask() {
     return;
   }
 
+  const auto stagger_threshold = FLAGS_leader_election_stagger_threshold;
+  if (stagger_threshold > 0) {
+    const auto running_elections = LeaderElection::NumRunning();
+    if (running_elections >= stagger_threshold) {
+      auto delay = MonoDelta::FromMilliseconds(
+          MinimumElectionTimeout().ToMilliseconds() * RandomUniformReal<double>(0.1, 1.0));
+      VLOG_WITH_PREFIX(1) << "Postponing election for " << delay << ", running elections: "
+                          << running_elections;
+      SnoozeFailureDetector(DO_NOT_LOG, delay);
+      return;
+    }
+  }
+
   // Start an election.
   LOG_WITH_PREFIX(INFO) << "ReportFailDetected: Starting NORMAL_ELECTION...";
   Status s = StartElection(LeaderElectionData{
@@ -3467,9 +3487,9 @@ Status RaftConsensus::HandleTermAdvanceUnlocked(ConsensusTerm new_term) {
 
 Result<ReadOpsResult> RaftConsensus::ReadReplicatedMessagesForCDC(
     const yb::OpId& from, int64_t* last_replicated_opid_index, const CoarseTimePoint deadline,
-    const bool fetch_single_entry) {
+    const bool fetch_single_entry, size_t max_batch_size_bytes) {
   return queue_->ReadReplicatedMessagesForCDC(
-      from, last_replicated_opid_index, deadline, fetch_single_entry);
+      from, last_replicated_opid_index, deadline, fetch_single_entry, max_batch_size_bytes);
 }
 
 void RaftConsensus::UpdateCDCConsumerOpId(const yb::OpId& op_id) {
@@ -266,7 +266,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
       const yb::OpId& from,
       int64_t* last_replicated_opid_index,
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
-      const bool fetch_single_entry = false) override;
+      const bool fetch_single_entry = false,
+      size_t max_batch_size_bytes = 0) override;
 
   void UpdateCDCConsumerOpId(const yb::OpId& op_id) override;
 
@@ -0,0 +1,175 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/consensus/consensus.messages.h"
+#include "yb/consensus/retryable_requests.h"
+
+#include "yb/rpc/lightweight_message.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/opid.h"
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+DECLARE_int32(retryable_request_timeout_secs);
+
+METRIC_DECLARE_entity(tablet);
+METRIC_DECLARE_gauge_int64(replicated_retryable_request_ranges);
+METRIC_DECLARE_gauge_int64(retryable_requests_memory_usage);
+
+namespace yb {
+namespace consensus {
+
+class RetryableRequestsTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    metric_entity_ = METRIC_ENTITY_tablet.Instantiate(&metric_registry_, "retryable-test");
+    requests_.SetMetricEntity(metric_entity_);
+  }
+
+  // Adds a replicated request, the way it is loaded during tablet bootstrap.
+  void AddReplicated(
+      const ClientId& client_id, RetryableRequestId request_id,
+      RetryableRequestId min_running_request_id = 0,
+      RestartSafeCoarseTimePoint time = RestartSafeCoarseTimePoint()) {
+    auto msg = rpc::MakeSharedMessage<LWReplicateMsg>();
+    ++last_op_id_.index;
+    last_op_id_.ToPB(msg->mutable_id());
+    auto* write = msg->mutable_write();
+    auto client_id_pair = client_id.ToUInt64Pair();
+    write->set_client_id1(client_id_pair.first);
+    write->set_client_id2(client_id_pair.second);
+    write->set_request_id(request_id);
+    write->set_min_running_request_id(min_running_request_id);
+    if (time == RestartSafeCoarseTimePoint()) {
+      time = requests_.Clock().Now();
+    }
+    requests_.Bootstrap(*msg, time);
+  }
+
+  RestartSafeCoarseTimePoint ExpiredTime() {
+    return requests_.Clock().Now() - (FLAGS_retryable_request_timeout_secs + 10) * 1s;
+  }
+
+  size_t NumReplicatedRanges() {
+    return requests_.TEST_Counts().replicated;
+  }
+
+  int64_t ReplicatedRangesGauge() {
+    return METRIC_replicated_retryable_request_ranges.Instantiate(metric_entity_, 0)->value();
+  }
+
+  int64_t MemoryUsageGauge() {
+    return METRIC_retryable_requests_memory_usage.Instantiate(metric_entity_, 0)->value();
+  }
+
+  MetricRegistry metric_registry_;
+  scoped_refptr<MetricEntity> metric_entity_;
+  RetryableRequests requests_;
+  OpId last_op_id_{1, 0};
+};
+
+TEST_F(RetryableRequestsTest, JoinRanges) {
+  const auto client_id = ClientId::GenerateRandom();
+
+  // Consecutive ids extend the same range.
+  for (RetryableRequestId id = 1; id <= 3; ++id) {
+    AddReplicated(client_id, id);
+  }
+  ASSERT_EQ(1, NumReplicatedRanges());
+
+  AddReplicated(client_id, 5);
+  ASSERT_EQ(2, NumReplicatedRanges());
+  ASSERT_EQ(2, ReplicatedRangesGauge());
+
+  // Request that fills the gap joins both ranges.
+  AddReplicated(client_id, 4);
+  ASSERT_EQ(1, NumReplicatedRanges());
+  ASSERT_EQ(1, ReplicatedRangesGauge());
+
+  // Request right before a range extends it.
+  AddReplicated(client_id, 8);
+  AddReplicated(client_id, 7);
+  ASSERT_EQ(2, NumReplicatedRanges());
+  ASSERT_EQ(2, ReplicatedRangesGauge());
+}
+
+TEST_F(RetryableRequestsTest, TrimBelowMinRunning) {
+  const auto client_id = ClientId::GenerateRandom();
+
+  for (RetryableRequestId id = 1; id <= 5; ++id) {
+    AddReplicated(client_id, id);
+  }
+  AddReplicated(client_id, 7);
+  ASSERT_EQ(2, NumReplicatedRanges());
+
+  // Range [1, 5] is trimmed to [4, 5].
+  AddReplicated(client_id, 10, 4 /* min_running_request_id */);
+  ASSERT_EQ(4, ASSERT_RESULT(requests_.MinRunningRequestId(client_id)));
+  ASSERT_EQ(3, NumReplicatedRanges());
+  ASSERT_EQ(3, ReplicatedRangesGauge());
+
+  // Ranges [4, 5] and [7, 7] are dropped.
+  AddReplicated(client_id, 11, 8 /* min_running_request_id */);
+  ASSERT_EQ(8, ASSERT_RESULT(requests_.MinRunningRequestId(client_id)));
+  ASSERT_EQ(1, NumReplicatedRanges());
+  ASSERT_EQ(1, ReplicatedRangesGauge());
+}
+
+TEST_F(RetryableRequestsTest, Expiry) {
+  const auto client_id = ClientId::GenerateRandom();
+
+  // Fresh range is before the expired ones in request id order, expired ranges are dropped anyway.
+  AddReplicated(client_id, 1);
+  const auto fresh_op_id = last_op_id_;
+  AddReplicated(client_id, 3, 0, ExpiredTime());
+  AddReplicated(client_id, 5, 0, ExpiredTime());
+  ASSERT_EQ(3, NumReplicatedRanges());
+
+  ASSERT_EQ(fresh_op_id, requests_.CleanExpiredReplicatedAndGetMinOpId());
+  ASSERT_EQ(1, NumReplicatedRanges());
+  ASSERT_EQ(1, ReplicatedRangesGauge());
+}
+
+TEST_F(RetryableRequestsTest, MemoryUsageGauge) {
+  ASSERT_EQ(0, MemoryUsageGauge());
+
+  const auto client_id = ClientId::GenerateRandom();
+  AddReplicated(client_id, 1);
+  requests_.CleanExpiredReplicatedAndGetMinOpId();
+  const auto base_usage = MemoryUsageGauge();
+  ASSERT_GT(base_usage, 0);
+
+  // Every other id, so each request has its own range.
+  constexpr RetryableRequestId kNumRanges = 100;
+  for (RetryableRequestId i = 1; i <= kNumRanges; ++i) {
+    AddReplicated(client_id, 1 + 2 * i);
+  }
+  ASSERT_EQ(kNumRanges + 1, NumReplicatedRanges());
+  requests_.CleanExpiredReplicatedAndGetMinOpId();
+  const auto grown_usage = MemoryUsageGauge();
+  ASSERT_GT(grown_usage, base_usage);
+
+  // Drops all previous ranges. The memory is released by the next cleanup.
+  AddReplicated(client_id, 1000, 1000 /* min_running_request_id */);
+  ASSERT_EQ(1, NumReplicatedRanges());
+  requests_.CleanExpiredReplicatedAndGetMinOpId();
+  ASSERT_LT(MemoryUsageGauge(), grown_usage);
+}
+
+} // namespace consensus
+} // namespace yb
@@ -15,7 +15,6 @@
 
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
 #include "yb/consensus/consensus.messages.h"
@@ -53,6 +52,12 @@ METRIC_DEFINE_gauge_int64(tablet, replicated_retryable_request_ranges,
                           yb::MetricUnit::kRequests,
                           "Number of replicated retryable request ranges.");
 
+METRIC_DEFINE_gauge_int64(tablet, retryable_requests_memory_usage,
+                          "Memory used by retryable requests.",
+                          yb::MetricUnit::kBytes,
+                          "Estimated memory used to track running and replicated retryable "
+                          "requests, updated when expired requests are cleaned.");
+
 namespace yb {
 namespace consensus {
 
@@ -73,23 +78,23 @@ struct RunningRetryableRequest {
 };
 
 struct ReplicatedRetryableRequestRange {
-  mutable RetryableRequestId first_id;
+  RetryableRequestId first_id;
   RetryableRequestId last_id;
   yb::OpId min_op_id;
-  mutable RestartSafeCoarseTimePoint min_time;
-  mutable RestartSafeCoarseTimePoint max_time;
+  RestartSafeCoarseTimePoint min_time;
+  RestartSafeCoarseTimePoint max_time;
 
   ReplicatedRetryableRequestRange(RetryableRequestId id, const yb::OpId& op_id,
                               RestartSafeCoarseTimePoint time)
       : first_id(id), last_id(id), min_op_id(op_id), min_time(time),
         max_time(time) {}
 
-  void InsertTime(const RestartSafeCoarseTimePoint& time) const {
+  void InsertTime(const RestartSafeCoarseTimePoint& time) {
     min_time = std::min(min_time, time);
     max_time = std::max(max_time, time);
   }
 
-  void PrepareJoinWithPrev(const ReplicatedRetryableRequestRange& prev) const {
+  void PrepareJoinWithPrev(const ReplicatedRetryableRequestRange& prev) {
     min_time = std::min(min_time, prev.min_time);
     max_time = std::max(max_time, prev.max_time);
     first_id = prev.first_id;
@@ -101,8 +106,6 @@ struct ReplicatedRetryableRequestRange {
   }
 };
 
-struct LastIdIndex;
-struct OpIdIndex;
 struct RequestIdIndex;
 
 typedef boost::multi_index_container <
@@ -117,28 +120,20 @@ typedef boost::multi_index_container <
     >
 > RunningRetryableRequests;
 
-typedef boost::multi_index_container <
-    ReplicatedRetryableRequestRange,
-    boost::multi_index::indexed_by <
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<LastIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, RetryableRequestId,
-                &ReplicatedRetryableRequestRange::last_id
-            >
-        >,
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<OpIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, yb::OpId,
-                &ReplicatedRetryableRequestRange::min_op_id
-            >
-        >
-    >
-> ReplicatedRetryableRequestRanges;
-
-typedef ReplicatedRetryableRequestRanges::index<LastIdIndex>::type
-    ReplicatedRetryableRequestRangesByLastId;
+// Ranges do not overlap and are sorted by last_id, so they are also sorted by first_id.
+// A flat vector takes a fraction of the memory of a node based container, and a client usually
+// has a few ranges, since ranges below its min running request id are dropped.
+typedef std::vector<ReplicatedRetryableRequestRange> ReplicatedRetryableRequestRanges;
+
+// Returns the first range with last_id >= id.
+ReplicatedRetryableRequestRanges::iterator LowerBoundByLastId(
+    ReplicatedRetryableRequestRanges* ranges, RetryableRequestId id) {
+  return std::lower_bound(
+      ranges->begin(), ranges->end(), id,
+      [](const ReplicatedRetryableRequestRange& range, RetryableRequestId id) {
+        return range.last_id < id;
+      });
+}
 
 struct ClientRetryableRequests {
   RunningRetryableRequests running;
@@ -237,9 +232,9 @@ class RetryableRequests::Impl {
           data.client_id(), client_retryable_requests.min_running_request_id);
     }
 
-    auto& replicated_indexed_by_last_id = client_retryable_requests.replicated.get<LastIdIndex>();
-    auto it = replicated_indexed_by_last_id.lower_bound(data.request_id());
-    if (it != replicated_indexed_by_last_id.end() && it->first_id <= data.request_id()) {
+    auto& replicated = client_retryable_requests.replicated;
+    auto it = LowerBoundByLastId(&replicated, data.request_id());
+    if (it != replicated.end() && it->first_id <= data.request_id()) {
       return STATUS_FORMAT(
               AlreadyPresent, "Duplicate request $0 from client $1 (min running $2)",
               data.request_id(), data.client_id(),
@@ -267,23 +262,22 @@ class RetryableRequests::Impl {
     auto clean_start = now - GetAtomicFlag(&FLAGS_retryable_request_timeout_secs) * 1s;
     for (auto ci = clients_.begin(); ci != clients_.end();) {
       ClientRetryableRequests& client_retryable_requests = ci->second;
-      auto& op_id_index = client_retryable_requests.replicated.get<OpIdIndex>();
-      auto it = op_id_index.begin();
-      int64_t count = 0;
-      while (it != op_id_index.end() && it->max_time < clean_start) {
-        ++it;
-        ++count;
-      }
+      auto& replicated = client_retryable_requests.replicated;
+      auto new_end = std::remove_if(
+          replicated.begin(), replicated.end(), [clean_start](const auto& range) {
+            return range.max_time < clean_start;
+          });
       if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(count);
+        replicated_request_ranges_gauge_->DecrementBy(replicated.end() - new_end);
       }
-      if (it != op_id_index.end()) {
-        result = std::min(result, it->min_op_id);
-        op_id_index.erase(op_id_index.begin(), it);
-      } else {
-        op_id_index.clear();
+      replicated.erase(new_end, replicated.end());
+      if (replicated.capacity() > 2 * replicated.size() + kMinReplicatedRangesCapacity) {
+        replicated.shrink_to_fit();
       }
-      if (op_id_index.empty() && client_retryable_requests.running.empty()) {
+      for (const auto& range : replicated) {
+        result = std::min(result, range.min_op_id);
+      }
+      if (replicated.empty() && client_retryable_requests.running.empty()) {
         // We delay deleting client with empty requests, to be able to filter requests with too
         // small request id.
         if (client_retryable_requests.empty_since == RestartSafeCoarseTimePoint()) {
@@ -296,6 +290,10 @@ class RetryableRequests::Impl {
       ++ci;
     }
 
+    if (memory_usage_gauge_) {
+      memory_usage_gauge_->set(MemoryUsage());
+    }
+
     return result;
   }
 
@@ -372,6 +370,7 @@ class RetryableRequests::Impl {
     running_requests_gauge_ = METRIC_running_retryable_requests.Instantiate(metric_entity, 0);
     replicated_request_ranges_gauge_ = METRIC_replicated_retryable_request_ranges.Instantiate(
         metric_entity, 0);
+    memory_usage_gauge_ = METRIC_retryable_requests_memory_usage.Instantiate(metric_entity, 0);
   }
 
   RetryableRequestsCounts TEST_Counts() {
@@ -393,27 +392,40 @@ class RetryableRequests::Impl {
   }
 
  private:
+  static constexpr size_t kMinReplicatedRangesCapacity = 8;
+
+  // Approximate, it does not include the duplicate rounds of running requests.
+  size_t MemoryUsage() const {
+    constexpr size_t kNodeOverhead = 2 * sizeof(void*);
+    size_t result = clients_.bucket_count() * sizeof(void*);
+    for (const auto& [client_id, client] : clients_) {
+      result += sizeof(client_id) + sizeof(client) + kNodeOverhead;
+      result += client.replicated.capacity() * sizeof(ReplicatedRetryableRequestRange);
+      result += client.running.bucket_count() * sizeof(void*);
+      result += client.running.size() * (sizeof(RunningRetryableRequest) + kNodeOverhead);
+    }
+    return result;
+  }
+
   void CleanupReplicatedRequests(
       RetryableRequestId new_min_running_request_id,
       ClientRetryableRequests* client_retryable_requests) {
-    auto& replicated_indexed_by_last_id = client_retryable_requests->replicated.get<LastIdIndex>();
+    auto& replicated = client_retryable_requests->replicated;
     if (new_min_running_request_id > client_retryable_requests->min_running_request_id) {
       // We are not interested in ids below write_request.min_running_request_id() anymore.
       //
       // Request id intervals are ordered by last id of interval, and does not overlap.
       // So we are trying to find interval with last_id >= min_running_request_id
       // and trim it if necessary.
-      auto it = replicated_indexed_by_last_id.lower_bound(new_min_running_request_id);
-      if (it != replicated_indexed_by_last_id.end() &&
-          it->first_id < new_min_running_request_id) {
+      auto it = LowerBoundByLastId(&replicated, new_min_running_request_id);
+      if (it != replicated.end() && it->first_id < new_min_running_request_id) {
         it->first_id = new_min_running_request_id;
       }
       if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(
-            std::distance(replicated_indexed_by_last_id.begin(), it));
+        replicated_request_ranges_gauge_->DecrementBy(it - replicated.begin());
       }
       // Remove all intervals that has ids below write_request.min_running_request_id().
-      replicated_indexed_by_last_id.erase(replicated_indexed_by_last_id.begin(), it);
+      replicated.erase(replicated.begin(), it);
       client_retryable_requests->min_running_request_id = new_min_running_request_id;
     }
   }
@@ -421,9 +433,9 @@ class RetryableRequests::Impl {
   void AddReplicated(yb::OpId op_id, const ReplicateData& data, RestartSafeCoarseTimePoint time,
                      ClientRetryableRequests* client) {
     auto request_id = data.request_id();
-    auto& replicated_indexed_by_last_id = client->replicated.get<LastIdIndex>();
-    auto request_it = replicated_indexed_by_last_id.lower_bound(request_id);
-    if (request_it != replicated_indexed_by_last_id.end() && request_it->first_id <= request_id) {
+    auto& replicated = client->replicated;
+    auto request_it = LowerBoundByLastId(&replicated, request_id);
+    if (request_it != replicated.end() && request_it->first_id <= request_id) {
 #ifndef NDEBUG
       LOG_WITH_PREFIX(ERROR)
           << "Replicated requests: " << yb::ToString(client->replicated);
@@ -436,44 +448,32 @@ class RetryableRequests::Impl {
     // Check that we have range right after this id, and we could extend it.
     // Requests rarely attaches to begin of interval, so we could don't check for
     // RangeTimeLimit() here.
-    if (request_it != replicated_indexed_by_last_id.end() &&
-        request_it->first_id == request_id + 1) {
+    if (request_it != replicated.end() && request_it->first_id == request_id + 1) {
       op_id = std::min(request_it->min_op_id, op_id);
       request_it->InsertTime(time);
       // If previous range is right before this id, then we could just join those ranges.
-      if (!TryJoinRanges(request_it, op_id, &replicated_indexed_by_last_id)) {
+      if (!TryJoinRanges(request_it, op_id, &replicated)) {
         --(request_it->first_id);
-        UpdateMinOpId(request_it, op_id, &replicated_indexed_by_last_id);
+        request_it->min_op_id = op_id;
       }
       return;
     }
 
-    if (TryJoinToEndOfRange(request_it, op_id, request_id, time, &replicated_indexed_by_last_id)) {
+    if (TryJoinToEndOfRange(request_it, op_id, request_id, time, &replicated)) {
       return;
     }
 
-    client->replicated.emplace(request_id, op_id, time);
+    replicated.emplace(request_it, request_id, op_id, time);
     if (replicated_request_ranges_gauge_) {
       replicated_request_ranges_gauge_->Increment();
     }
   }
 
-  void UpdateMinOpId(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (min_op_id < request_it->min_op_id) {
-      replicated_indexed_by_last_id->modify(request_it, [min_op_id](auto& entry) { // NOLINT
-        entry.min_op_id = min_op_id;
-      });
-    }
-  }
-
   bool TryJoinRanges(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
+      ReplicatedRetryableRequestRanges::iterator request_it,
       yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
+      ReplicatedRetryableRequestRanges* replicated) {
+    if (request_it == replicated->begin()) {
       return false;
     }
 
@@ -491,22 +491,21 @@ class RetryableRequests::Impl {
       return false;
     }
 
-    min_op_id = std::min(min_op_id, request_prev_it->min_op_id);
+    request_it->min_op_id = std::min(min_op_id, request_prev_it->min_op_id);
     request_it->PrepareJoinWithPrev(*request_prev_it);
-    replicated_indexed_by_last_id->erase(request_prev_it);
+    replicated->erase(request_prev_it);
     if (replicated_request_ranges_gauge_) {
       replicated_request_ranges_gauge_->Decrement();
     }
-    UpdateMinOpId(request_it, min_op_id, replicated_indexed_by_last_id);
 
     return true;
   }
 
   bool TryJoinToEndOfRange(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
+      ReplicatedRetryableRequestRanges::iterator request_it,
       yb::OpId op_id, RetryableRequestId request_id, RestartSafeCoarseTimePoint time,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
+      ReplicatedRetryableRequestRanges* replicated) {
+    if (request_it == replicated->begin()) {
       return false;
     }
 
@@ -523,13 +522,9 @@ class RetryableRequests::Impl {
       return false;
     }
 
-    op_id = std::min(request_it->min_op_id, op_id);
+    request_it->min_op_id = std::min(request_it->min_op_id, op_id);
     request_it->InsertTime(time);
-    // Actually we should use the modify function on client.replicated, but since the order of
-    // ranges should not be changed, we could update last_id directly.
-    ++const_cast<ReplicatedRetryableRequestRange&>(*request_it).last_id;
-
-    UpdateMinOpId(request_it, op_id, replicated_indexed_by_last_id);
+    ++request_it->last_id;
 
     return true;
   }
@@ -543,6 +538,7 @@ class RetryableRequests::Impl {
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
+  scoped_refptr<AtomicGauge<int64_t>> memory_usage_gauge_;
 };
 
 RetryableRequests::RetryableRequests(std::string log_prefix)
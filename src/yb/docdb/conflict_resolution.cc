@@ -29,6 +29,7 @@
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/gutil/stl_util.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metrics.h"
@@ -36,6 +37,12 @@
 #include "yb/util/status_format.h"
 #include "yb/util/trace.h"
 
+DEFINE_RUNTIME_bool(skip_intents_conflict_check_without_running_transactions, false,
+    "Skip looking up conflicting intents in the intents DB when the local transaction "
+    "participant has no running transactions, since they could not have written any intent "
+    "that conflicts.");
+TAG_FLAG(skip_intents_conflict_check_without_running_transactions, advanced);
+
 using namespace std::literals;
 using namespace std::placeholders;
 
@@ -183,6 +190,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   }
 
   void Resolve() {
+    // Intents are written by transactions registered in the participant, and a transaction stays
+    // registered until its intents are applied or it is aborted. Conflicting writes are
+    // serialized by the in-memory locks held while resolving, so when nothing is running there is
+    // no intent to conflict with.
+    skip_intents_ = FLAGS_skip_intents_conflict_check_without_running_transactions &&
+                    status_manager_.MinRunningHybridTime() == HybridTime::kMax;
     auto status = context_->ReadConflicts(this);
     if (!status.ok()) {
       InvokeCallback(status);
@@ -204,6 +217,9 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
 
   // Reads conflicts for specified intent from DB.
   Status ReadIntentConflicts(IntentTypeSet type, KeyBytes* intent_key_prefix) {
+    if (skip_intents_) {
+      return Status::OK();
+    }
     EnsureIntentIteratorCreated();
 
     const auto conflicting_intent_types = kIntentTypeSetConflicts[type.ToUIntPtr()];
@@ -271,7 +287,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   }
 
   void EnsureIntentIteratorCreated() {
-    if (!intent_iter_.Initialized()) {
+    if (!skip_intents_ && !intent_iter_.Initialized()) {
       intent_iter_ = CreateRocksDBIterator(
           doc_db_.intents,
           doc_db_.key_bounds,
@@ -502,6 +518,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   ResolutionCallback callback_;
 
   BoundedRocksDbIterator intent_iter_;
+  bool skip_intents_ = false;
   Slice intent_key_upperbound_;
   TransactionConflictInfoMap conflicts_;
 
@@ -487,6 +487,7 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
               << "start time: " << wait_start_time;
         }
         waiters_to_probe.push_back(*waiter_it);
+        new_waiters_.push_back(waiter_txn_id);
       }
       return Status::OK();
     }(req);
@@ -502,6 +503,28 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
     }
   }
 
+  void TriggerProbesForNewWaiters() EXCLUDES(mutex_) {
+    std::vector<std::pair<const TransactionId, std::shared_ptr<const WaiterData>>> waiters_to_probe;
+    {
+      UniqueLock<decltype(mutex_)> l(mutex_);
+      for (const auto& waiter_txn_id : waiters_to_reprobe_) {
+        auto it = waiters_.find(waiter_txn_id);
+        if (it != waiters_.end()) {
+          waiters_to_probe.push_back(*it);
+        }
+      }
+      waiters_to_reprobe_.clear();
+      waiters_to_reprobe_.swap(new_waiters_);
+    }
+    if (waiters_to_probe.empty()) {
+      return;
+    }
+    VLOG_WITH_PREFIX(4) << "Re-probing " << waiters_to_probe.size() << " new waiters";
+    for (const auto& probe : GetProbesToSend(waiters_to_probe)) {
+      probe->Send();
+    }
+  }
+
   void TriggerProbes() EXCLUDES(mutex_) {
     // We should be able to trigger probes only once per unique waiting transaction, but we still
     // trigger all active probes on a fixed interval for safetey/simplicity.
@@ -729,6 +752,14 @@ class DeadlockDetector::Impl : public std::enable_shared_from_this<DeadlockDetec
 
   Waiters waiters_ GUARDED_BY(mutex_);
 
+  // Waiters are probed as soon as their wait-for edges are received. A cycle that is closed by
+  // edges which reach different coordinators at about the same time could be missed by these
+  // probes, so waiters are probed once more by the second TriggerProbesForNewWaiters call after
+  // they were received. new_waiters_ holds waiters received since the last call, and
+  // waiters_to_reprobe_ those that will be probed by the next call.
+  std::vector<TransactionId> new_waiters_ GUARDED_BY(mutex_);
+  std::vector<TransactionId> waiters_to_reprobe_ GUARDED_BY(mutex_);
+
   std::atomic<uint32_t> seq_no_ = 0;
 };
 
@@ -759,6 +790,10 @@ void DeadlockDetector::TriggerProbes() {
   return impl_->TriggerProbes();
 }
 
+void DeadlockDetector::TriggerProbesForNewWaiters() {
+  return impl_->TriggerProbesForNewWaiters();
+}
+
 void DeadlockDetector::Shutdown() {
   return impl_->Shutdown();
 }
@@ -99,6 +99,11 @@ class DeadlockDetector {
 
   void TriggerProbes();
 
+  // Probes again the waiters received before the previous call of this method. Should be called
+  // much more often than TriggerProbes, to find cycles whose edges were received concurrently by
+  // different detectors without waiting for the next full scan.
+  void TriggerProbesForNewWaiters();
+
   void Shutdown();
 
  private:
@@ -13,26 +13,74 @@
 //
 //
 
+#include <optional>
+
 #include "yb/rocksdb/db/dbformat.h"
 
+#include "yb/common/doc_hybrid_time.h"
+
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/gutil/casts.h"
+#include "yb/util/flags.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 
+DEFINE_RUNTIME_bool(docdb_record_file_column_bounds, false,
+    "Record the smallest and largest values of the int, bigint and timestamp columns written to "
+    "every new SST file, so that scans with conditions on those columns could skip files.");
+TAG_FLAG(docdb_record_file_column_bounds, advanced);
+
 namespace yb {
 namespace docdb {
 
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index);
+rocksdb::UserBoundaryTag TagForHybridTime();
+rocksdb::UserBoundaryTag TagForColumnValues();
+rocksdb::UserBoundaryTag TagForColumnValue(ColumnId column_id);
+bool IsColumnValuesTag(rocksdb::UserBoundaryTag tag);
 
 namespace {
 
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
+constexpr rocksdb::UserBoundaryTag kHybridTimeTag = 1;
+// Present in files with column bounds. Its largest value is kColumnValuesIncomplete when the file
+// has column values that are not reflected in the bounds.
+constexpr rocksdb::UserBoundaryTag kColumnValuesTag = 2;
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
+constexpr rocksdb::UserBoundaryTag kColumnValuesStart = 1U << 30;
+
+const char kColumnValuesComplete[] = "\x00";
+const char kColumnValuesIncomplete[] = "\x01";
+
+// Returns the value of a column in the key encoding, when its type is supported by column bounds.
+Result<std::optional<KeyEntryValue>> ColumnValueForBounds(Slice value) {
+  switch (DecodeValueEntryType(value)) {
+    case ValueEntryType::kInt32: FALLTHROUGH_INTENDED;
+    case ValueEntryType::kInt64: FALLTHROUGH_INTENDED;
+    case ValueEntryType::kTimestamp:
+      break;
+    default:
+      return std::nullopt;
+  }
+  PrimitiveValue primitive_value;
+  RETURN_NOT_OK(primitive_value.DecodeFromValue(value));
+  switch (primitive_value.value_type()) {
+    case ValueEntryType::kInt32:
+      return KeyEntryValue::Int32(primitive_value.GetInt32());
+    case ValueEntryType::kInt64:
+      return KeyEntryValue::Int64(primitive_value.GetInt64());
+    case ValueEntryType::kTimestamp:
+      return KeyEntryValue::MakeTimestamp(primitive_value.GetTimestamp());
+    default:
+      return std::nullopt;
+  }
+}
 
 class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
  public:
@@ -62,6 +110,61 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
       });
     }
 
+    // Doc hybrid time is encoded in the reverse order, so the smallest value of this tag is the
+    // largest hybrid time of the file, and the largest value is its smallest hybrid time.
+    values->push_back(rocksdb::UserBoundaryValueRef {
+      .tag = kHybridTimeTag,
+      .value = slices[size],
+    });
+
+    return Status::OK();
+  }
+
+  bool ExtractsFromValues() override {
+    return FLAGS_docdb_record_file_column_bounds;
+  }
+
+  // Records the values of columns that are written as separate records, i.e. the key is the doc key
+  // followed by the column id. Values of packed rows and values with a user timestamp, which could
+  // win over a version with a later hybrid time, mark the file as incomplete.
+  Status ExtractFromValue(
+      Slice user_key, Slice value, std::string* buffer,
+      rocksdb::UserBoundaryValueRefs* values) override {
+    if (docdb::IsInternalRecordKeyType(docdb::DecodeKeyEntryType(user_key))) {
+      return Status::OK();
+    }
+
+    auto control_fields = VERIFY_RESULT(ValueControlFields::Decode(&value));
+    auto subkeys = user_key;
+    subkeys.remove_prefix(VERIFY_RESULT(DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey)));
+    const bool complete = !control_fields.has_timestamp() &&
+                          DecodeValueEntryType(value) != ValueEntryType::kPackedRow;
+    values->push_back(rocksdb::UserBoundaryValueRef {
+      .tag = kColumnValuesTag,
+      .value = Slice(complete ? kColumnValuesComplete : kColumnValuesIncomplete, 1),
+    });
+
+    if (!complete || subkeys.empty() || subkeys[0] != KeyEntryTypeAsChar::kColumnId) {
+      return Status::OK();
+    }
+    KeyEntryValue column_id;
+    RETURN_NOT_OK(KeyEntryValue::DecodeKey(&subkeys, &column_id));
+    // Elements of collections have more subkeys after the column id.
+    if (subkeys.empty() || subkeys[0] != KeyEntryTypeAsChar::kHybridTime) {
+      return Status::OK();
+    }
+    auto column_value = VERIFY_RESULT(ColumnValueForBounds(value));
+    if (!column_value ||
+        static_cast<uint32_t>(column_id.GetColumnId().rep()) >= kColumnValuesStart) {
+      return Status::OK();
+    }
+    KeyBytes encoded_value;
+    column_value->AppendToKey(&encoded_value);
+    buffer->assign(encoded_value.AsSlice().cdata(), encoded_value.size());
+    values->push_back(rocksdb::UserBoundaryValueRef {
+      .tag = TagForColumnValue(column_id.GetColumnId()),
+      .value = *buffer,
+    });
     return Status::OK();
   }
 
@@ -88,9 +191,39 @@ Result<KeyEntryValue> TEST_GetKeyEntryValue(
   return KeyEntryValue::FullyDecodeFromKey(value->AsSlice());
 }
 
+// Used in tests
+Result<DocHybridTime> TEST_GetHybridTime(const rocksdb::UserBoundaryValues& values) {
+  auto value = rocksdb::TEST_UserValueWithTag(values, kHybridTimeTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found hybrid time value");
+  }
+  return DocHybridTime::FullyDecodeFrom(value->AsSlice());
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return static_cast<rocksdb::UserBoundaryTag>(kRangeComponentsStart + index);
 }
 
+rocksdb::UserBoundaryTag TagForHybridTime() {
+  return kHybridTimeTag;
+}
+
+rocksdb::UserBoundaryTag TagForColumnValues() {
+  return kColumnValuesTag;
+}
+
+rocksdb::UserBoundaryTag TagForColumnValue(ColumnId column_id) {
+  return static_cast<rocksdb::UserBoundaryTag>(kColumnValuesStart + column_id.rep());
+}
+
+bool IsColumnValuesTag(rocksdb::UserBoundaryTag tag) {
+  return tag == kColumnValuesTag || tag >= kColumnValuesStart;
+}
+
+bool IsFileColumnValuesComplete(const Slice* largest_column_values) {
+  return largest_column_values &&
+         *largest_column_values == Slice(kColumnValuesComplete, 1);
+}
+
 } // namespace docdb
 } // namespace yb
@@ -118,6 +118,44 @@ TEST(DocKVUtilTest, ZeroEncodingAndDecoding) {
   }
 }
 
+TEST(DocKVUtilTest, DecodeStringsWithManyZeros) {
+  // Bytes that are special for either encoding, so both escape sequences and runs between them
+  // are exercised.
+  const char kAlphabet[] = {'\0', '\x01', 'a', '\xfe', '\xff'};
+  rocksdb::Random rng(12345);
+  for (int i = 0; i < 1000; ++i) {
+    int len = rng.Next() % 200;
+    string s;
+    for (int j = 0; j < len; ++j) {
+      s.push_back(rng.OneIn(4) ? kAlphabet[rng.Uniform(static_cast<int>(sizeof(kAlphabet)))]
+                               : static_cast<char>(rng.Next()));
+    }
+    for (bool complement : {false, true}) {
+      KeyBuffer encoded;
+      if (complement) {
+        ComplementZeroEncodeAndAppendStrToKey(s, &encoded);
+      } else {
+        ZeroEncodeAndAppendStrToKey(s, &encoded);
+      }
+      const auto encoded_size = encoded.size();
+      encoded.Append(Slice("tail"));
+
+      string decoded;
+      Slice slice = encoded.AsSlice();
+      ASSERT_OK(complement ? DecodeComplementZeroEncodedStr(&slice, &decoded)
+                           : DecodeZeroEncodedStr(&slice, &decoded));
+      ASSERT_EQ(s, decoded);
+      ASSERT_EQ("tail", slice.ToBuffer());
+
+      // Skipping the string consumes the same bytes.
+      slice = encoded.AsSlice();
+      ASSERT_OK(complement ? DecodeComplementZeroEncodedStr(&slice, nullptr)
+                           : DecodeZeroEncodedStr(&slice, nullptr));
+      ASSERT_EQ(encoded.size() - encoded_size, slice.size());
+    }
+  }
+}
+
 TEST(DocKVUtilTest, TableTTL) {
   Schema schema;
   EXPECT_TRUE(TableTTL(schema).Equals(ValueControlFields::kMaxTtl));
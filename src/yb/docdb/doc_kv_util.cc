@@ -13,6 +13,8 @@
 
 #include "yb/docdb/doc_kv_util.h"
 
+#include <cstring>
+
 #include "yb/docdb/docdb_encoding_fwd.h"
 #include "yb/docdb/value_type.h"
 
@@ -101,6 +103,19 @@ void TerminateComplementZeroEncodedKeyStr(KeyBuffer *dest) {
   TerminateEncodedKeyStr<'\xff'>(dest);
 }
 
+template<char END_OF_STRING>
+void AppendDecodedRun(const char* begin, const char* end, string* result) {
+  const auto old_size = result->size();
+  result->append(begin, end);
+  if (END_OF_STRING != '\0') {
+    // Plain loop over the appended bytes, so it is vectorized by the compiler.
+    auto* data = result->data();
+    for (auto i = old_size, size = result->size(); i != size; ++i) {
+      data[i] ^= END_OF_STRING;
+    }
+  }
+}
+
 template<char END_OF_STRING>
 Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
@@ -110,34 +125,40 @@ Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   const char* end = p + slice->size();
 
   while (p != end) {
+    // Regular characters are copied in runs up to the next END_OF_STRING character, which is found
+    // with memchr. It is vectorized, so long strings are not walked byte by byte.
+    const char* marker = static_cast<const char*>(memchr(p, END_OF_STRING, end - p));
+    if (marker == nullptr) {
+      marker = end;
+    }
+    if (result != nullptr) {
+      AppendDecodedRun<END_OF_STRING>(p, marker, result);
+    }
+    p = marker;
+    if (p == end) {
+      break;
+    }
+    ++p;
+    if (p == end) {
+      return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
+                                             END_OF_STRING));
+    }
     if (*p == END_OF_STRING) {
+      // Found two END_OF_STRING characters, this is the end of the encoded string.
       ++p;
-      if (p == end) {
-        return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
-                                               END_OF_STRING));
-      }
-      if (*p == END_OF_STRING) {
-        // Found two END_OF_STRING characters, this is the end of the encoded string.
-        ++p;
-        break;
-      }
-      if (*p == END_OF_STRING_ESCAPE) {
-        // 0 is encoded as 00 01 in ascending encoding and FF FE in descending encoding.
-        if (result != nullptr) {
-          result->push_back(0);
-        }
-        ++p;
-      } else {
-        return STATUS(Corruption, StringPrintf(
-            "Invalid sequence in encoded string: "
-            R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
-            END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
-      }
-    } else {
+      break;
+    }
+    if (*p == END_OF_STRING_ESCAPE) {
+      // 0 is encoded as 00 01 in ascending encoding and FF FE in descending encoding.
       if (result != nullptr) {
-        result->push_back((*p) ^ END_OF_STRING);
+        result->push_back(0);
       }
       ++p;
+    } else {
+      return STATUS(Corruption, StringPrintf(
+          "Invalid sequence in encoded string: "
+          R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
+          END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
     }
   }
   if (result != nullptr) {
@@ -1297,5 +1297,29 @@ TEST_F(DocOperationTest, EarlyFilesFilteredBeforeBigFile) {
   ASSERT_EQ(kNumFilesToExpire, stats->getTickerCount(rocksdb::COMPACTION_FILES_FILTERED));
 }
 
+TEST_F(DocOperationTest, ExpiredFilesDeletedBelowCompactionTrigger) {
+  ASSERT_OK(DisableCompactions());
+  const int kNumFilesToWrite = 3;
+  ASSERT_LT(kNumFilesToWrite, FLAGS_rocksdb_level0_file_num_compaction_trigger);
+  GenerateFiles(kNumFilesToWrite, this);
+
+  auto files = rocksdb()->GetLiveFilesMetaData();
+  ASSERT_EQ(kNumFilesToWrite, files.size());
+
+  // Use a filter factory that will expire every file.
+  compaction_file_filter_factory_ =
+      std::make_shared<DiscardUntilFileFilterFactory>(kAlwaysDiscard);
+
+  ASSERT_OK(ReinitDBOptions());
+
+  WaitCompactionsDone(rocksdb());
+
+  // There are fewer files than the compaction trigger, but expired files are still deleted.
+  files = rocksdb()->GetLiveFilesMetaData();
+  ASSERT_EQ(0, files.size());
+  auto stats = rocksdb()->GetOptions().statistics;
+  ASSERT_EQ(kNumFilesToWrite, stats->getTickerCount(rocksdb::COMPACTION_FILES_FILTERED));
+}
+
 }  // namespace docdb
 }  // namespace yb
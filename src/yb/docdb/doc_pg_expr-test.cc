@@ -0,0 +1,67 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_expr.h"
+#include "yb/common/schema.h"
+
+#include "yb/docdb/doc_pg_expr.h"
+#include "yb/docdb/docdb_pgapi.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr int32_t kInt4Oid = 23;
+
+} // namespace
+
+class DocPgExprTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    ASSERT_OK(DocPgInit());
+  }
+};
+
+// Scans without pushed down expressions still register their column references, since they are
+// used for the projection. Such rows are not converted to Postgres format, so a row missing the
+// referenced column matches.
+TEST_F(DocPgExprTest, ColumnRefsWithoutExpressions) {
+  Schema schema(
+      {ColumnSchema("k", DataType::INT32, false /* is_nullable */, true /* is_hash_key */,
+                    false /* is_static */, false /* is_counter */, 1 /* order */),
+       ColumnSchema("v", DataType::INT32, true /* is_nullable */, false /* is_hash_key */,
+                    false /* is_static */, false /* is_counter */, 2 /* order */)},
+      {ColumnId(10), ColumnId(11)}, 1 /* key_columns */);
+
+  DocPgExprExecutor executor(&schema);
+  PgsqlColRefPB column_ref;
+  column_ref.set_column_id(11);
+  column_ref.set_attno(2);
+  column_ref.set_typid(kInt4Oid);
+  ASSERT_OK(executor.AddColumnRef(column_ref));
+
+  QLTableRow row;
+  bool match = false;
+  ASSERT_OK(executor.Exec(row, nullptr /* results */, &match));
+  ASSERT_TRUE(match);
+}
+
+} // namespace docdb
+} // namespace yb
@@ -204,8 +204,11 @@ class DocPgExprExecutor::Private {
               bool* match) {
     *match = true;
 
-    // early exit if there are no operations to process
-    if(var_map_.empty() && where_clause_.empty() && targets_.empty()) {
+    // early exit if there are no operations to process.
+    // Column references alone are not evaluated, so there is no need to convert row values to
+    // Postgres format if there are no expressions. This is typical for scans without pushed down
+    // conditions, where column references are only used to build the projection.
+    if (where_clause_.empty() && targets_.empty()) {
       return Status::OK();
     }
 
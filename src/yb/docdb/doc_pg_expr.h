@@ -74,7 +74,7 @@ class DocPgExprExecutor {
   // Method extracts values from the row according to the column references added to the executor.
   // Extracted values are converted to Postgres format (datum and is_null pairs). The case if no
   // columns are referenced is possible, but not very practical, it means that all expressions are
-  // constants.
+  // constants. If there are no where clause or target expressions, the row is not converted at all.
   // Then where clause expressions are evaluated, if any, in the order they are added. If a where
   // clause expression is evaluated to false, execution stops and match is returned as false.
   // Then target expressions are evaluated in the order they are added. Execution results are
@@ -22,6 +22,10 @@
 namespace yb {
 namespace docdb {
 extern rocksdb::UserBoundaryTag TagForRangeComponent(size_t index);
+extern rocksdb::UserBoundaryTag TagForHybridTime();
+extern rocksdb::UserBoundaryTag TagForColumnValues();
+extern rocksdb::UserBoundaryTag TagForColumnValue(ColumnId column_id);
+extern bool IsFileColumnValuesComplete(const Slice* largest_column_values);
 
 std::vector<KeyBytes> EncodePrimitiveValues(const std::vector<KeyEntryValue>& source,
                                             size_t min_size) {
@@ -89,5 +93,134 @@ bool QLRangeBasedFileFilter::Filter(const rocksdb::FdWithBoundaries& file) const
   return true;
 }
 
+KeyBoundsFileFilter::KeyBoundsFileFilter(
+    KeyBytes lower_bound, KeyBytes upper_bound,
+    std::shared_ptr<rocksdb::ReadFileFilter> next_filter)
+    : lower_bound_(std::move(lower_bound)), upper_bound_(std::move(upper_bound)),
+      next_filter_(std::move(next_filter)) {
+}
+
+bool KeyBoundsFileFilter::Filter(const rocksdb::FdWithBoundaries& file) const {
+  if (!lower_bound_.empty() && file.largest.user_key().compare(lower_bound_.AsSlice()) < 0) {
+    return false;
+  }
+  // Keys that start with the upper bound are within the scan, e.g. subkeys of the last row.
+  if (!upper_bound_.empty()) {
+    auto smallest = file.smallest.user_key();
+    if (smallest.compare(upper_bound_.AsSlice()) > 0 &&
+        !smallest.starts_with(upper_bound_.AsSlice())) {
+      return false;
+    }
+  }
+  return !next_filter_ || next_filter_->Filter(file);
+}
+
+HybridTimeFileFilter::HybridTimeFileFilter(
+    HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> next_filter)
+    : encoded_max_hybrid_time_(max_hybrid_time, kMaxWriteId),
+      next_filter_(std::move(next_filter)) {
+}
+
+bool HybridTimeFileFilter::Filter(const rocksdb::FdWithBoundaries& file) const {
+  // Doc hybrid time is encoded in the reverse order, so the largest value holds the smallest
+  // hybrid time of the file.
+  const Slice* min_hybrid_time = file.largest.user_value_with_tag(TagForHybridTime());
+  if (min_hybrid_time && min_hybrid_time->compare(encoded_max_hybrid_time_.AsSlice()) < 0) {
+    return false;
+  }
+  return !next_filter_ || next_filter_->Filter(file);
+}
+
+ColumnBoundsFileFilter::ColumnBoundsFileFilter(
+    std::vector<ColumnValueBounds> bounds, std::shared_ptr<rocksdb::ReadFileFilter> next_filter)
+    : bounds_(std::move(bounds)), next_filter_(std::move(next_filter)) {
+}
+
+bool ColumnBoundsFileFilter::Filter(const rocksdb::FdWithBoundaries& file) const {
+  return !next_filter_ || next_filter_->Filter(file);
+}
+
+bool ColumnBoundsFileFilter::MayMatch(const rocksdb::FdWithBoundaries& file) const {
+  if (!IsFileColumnValuesComplete(file.largest.user_value_with_tag(TagForColumnValues()))) {
+    return true;
+  }
+  for (const auto& bounds : bounds_) {
+    auto tag = TagForColumnValue(bounds.column_id);
+    const Slice* smallest = file.smallest.user_value_with_tag(tag);
+    const Slice* largest = file.largest.user_value_with_tag(tag);
+    // The column has no values in the file.
+    if (!smallest || !largest) {
+      return false;
+    }
+    if (!bounds.upper.empty() && smallest->compare(bounds.upper.AsSlice()) > 0) {
+      return false;
+    }
+    if (!bounds.lower.empty() && largest->compare(bounds.lower.AsSlice()) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ColumnBoundsFileFilter::FilterFiles(
+    const rocksdb::FdWithBoundaries* files, size_t num_files, std::vector<bool>* read) const {
+  rocksdb::ReadFileFilter::FilterFiles(files, num_files, read);
+
+  const auto hybrid_time_tag = TagForHybridTime();
+  std::vector<bool> skip(num_files);
+  bool has_files_to_skip = false;
+  for (size_t i = 0; i != num_files; ++i) {
+    if ((*read)[i] && files[i].smallest.user_value_with_tag(hybrid_time_tag) &&
+        !MayMatch(files[i])) {
+      skip[i] = true;
+      has_files_to_skip = true;
+    }
+  }
+  if (!has_files_to_skip) {
+    return;
+  }
+
+  // Doc hybrid time is encoded in the reverse order, so the smallest value of the tag is the
+  // largest hybrid time of a file, and the largest value is its smallest hybrid time.
+  // Files that turn out not to be older than all files to read are read as well, which could make
+  // other files not older than all files to read, so repeat until nothing changes.
+  for (;;) {
+    const Slice* min_read_hybrid_time = nullptr;
+    for (size_t i = 0; i != num_files; ++i) {
+      if (!(*read)[i] || skip[i]) {
+        continue;
+      }
+      const Slice* min_hybrid_time = files[i].largest.user_value_with_tag(hybrid_time_tag);
+      if (!min_hybrid_time) {
+        // Records of this file could be older than records of any other file.
+        return;
+      }
+      if (!min_read_hybrid_time || min_hybrid_time->compare(*min_read_hybrid_time) > 0) {
+        min_read_hybrid_time = min_hybrid_time;
+      }
+    }
+    if (!min_read_hybrid_time) {
+      break;
+    }
+    bool changed = false;
+    for (size_t i = 0; i != num_files; ++i) {
+      if (skip[i] && files[i].smallest.user_value_with_tag(hybrid_time_tag)->compare(
+              *min_read_hybrid_time) <= 0) {
+        skip[i] = false;
+        changed = true;
+      }
+    }
+    if (!changed) {
+      break;
+    }
+  }
+
+  for (size_t i = 0; i != num_files; ++i) {
+    if (skip[i]) {
+      (*read)[i] = false;
+    }
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
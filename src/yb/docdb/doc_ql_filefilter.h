@@ -15,7 +15,11 @@
 
 #pragma once
 
+#include "yb/common/column_id.h"
+#include "yb/common/doc_hybrid_time.h"
+
 #include "yb/docdb/docdb_fwd.h"
+#include "yb/docdb/key_bytes.h"
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/util/status_fwd.h"
 
@@ -38,5 +42,79 @@ class QLRangeBasedFileFilter : public rocksdb::ReadFileFilter {
   std::vector<bool> upper_bounds_inclusive_;
 };
 
+// Skips files whose key range does not overlap with the scan bounds. Keys of colocated tables
+// start with the colocation or cotable id, so files that contain only other tables of the tablet
+// are skipped without reading their index or filter blocks.
+// An empty bound means that the scan is not bounded on that side.
+class KeyBoundsFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  KeyBoundsFileFilter(
+      KeyBytes lower_bound, KeyBytes upper_bound,
+      std::shared_ptr<rocksdb::ReadFileFilter> next_filter);
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override;
+
+ private:
+  KeyBytes lower_bound_;
+  KeyBytes upper_bound_;
+  // Filter that is applied to files within the bounds, could be null.
+  std::shared_ptr<rocksdb::ReadFileFilter> next_filter_;
+};
+
+// Skips files whose records all have hybrid time above the given limit, so a read at an old
+// read time, e.g. a time-travel read, does not open files that were written after it.
+// Files without hybrid time boundaries are never skipped.
+class HybridTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  HybridTimeFileFilter(HybridTime max_hybrid_time,
+                       std::shared_ptr<rocksdb::ReadFileFilter> next_filter);
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override;
+
+ private:
+  EncodedDocHybridTime encoded_max_hybrid_time_;
+  // Filter that is applied to files that are not skipped, could be null.
+  std::shared_ptr<rocksdb::ReadFileFilter> next_filter_;
+};
+
+// Bounds of the values of a non-key column that a scan could return.
+// An empty bound means that the scan is not bounded on that side.
+struct ColumnValueBounds {
+  ColumnId column_id;
+  KeyBytes lower;
+  KeyBytes upper;
+};
+
+// Skips files that have no values of a column within the bounds of the scan, using the smallest and
+// largest column values recorded with docdb_record_file_column_bounds.
+//
+// A skipped file could hold versions of rows whose newer versions are in other files. To keep those
+// rows correct, a file is only skipped when all its records are older than the records of every
+// file that is read. Rows of skipped files then could only be missing columns, whose values do not
+// match the scan conditions anyway. This is only true when the filtered columns are not updated
+// after the row is inserted, e.g. the creation time of a time series row, so the filter should
+// only be used for such tables.
+//
+// The decision depends on the other files, so it is only made in FilterFiles.
+class ColumnBoundsFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  ColumnBoundsFileFilter(std::vector<ColumnValueBounds> bounds,
+                         std::shared_ptr<rocksdb::ReadFileFilter> next_filter);
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override;
+
+  void FilterFiles(
+      const rocksdb::FdWithBoundaries* files, size_t num_files,
+      std::vector<bool>* read) const override;
+
+ private:
+  // Whether the file could have a column value within the bounds.
+  bool MayMatch(const rocksdb::FdWithBoundaries& file) const;
+
+  std::vector<ColumnValueBounds> bounds_;
+  // Filter that is applied to every file first, could be null.
+  std::shared_ptr<rocksdb::ReadFileFilter> next_filter_;
+};
+
 }  // namespace docdb
 }  // namespace yb
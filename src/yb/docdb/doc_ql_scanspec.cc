@@ -13,6 +13,9 @@
 
 #include "yb/docdb/doc_ql_scanspec.h"
 
+#include <map>
+#include <optional>
+
 #include "yb/common/common.pb.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/schema.h"
@@ -21,10 +24,12 @@
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_ql_filefilter.h"
 #include "yb/docdb/doc_scanspec_util.h"
+#include "yb/docdb/key_entry_value.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
+#include "yb/util/timestamp.h"
 
 using std::vector;
 
@@ -43,6 +48,117 @@ bool AreColumnsContinous(std::vector<int> col_idxs) {
   return true;
 }
 
+// Returns the value in the key encoding, when the column has a type supported by column bounds and
+// the value has the type of the column.
+std::optional<KeyEntryValue> ColumnBoundValue(const ColumnSchema& column, const QLValuePB& value) {
+  switch (column.type()->main()) {
+    case DataType::INT32:
+      if (value.value_case() == QLValuePB::kInt32Value) {
+        return KeyEntryValue::Int32(value.int32_value());
+      }
+      break;
+    case DataType::INT64:
+      if (value.value_case() == QLValuePB::kInt64Value) {
+        return KeyEntryValue::Int64(value.int64_value());
+      }
+      break;
+    case DataType::TIMESTAMP:
+      if (value.value_case() == QLValuePB::kTimestampValue) {
+        return KeyEntryValue::MakeTimestamp(Timestamp(value.timestamp_value()));
+      }
+      break;
+    default:
+      break;
+  }
+  return std::nullopt;
+}
+
+using ColumnBoundsMap = std::map<ColumnId, ColumnValueBounds>;
+
+// Narrows the lower or upper bound of the column. Strict inequalities are treated as inclusive,
+// the bounds are only used to skip files.
+void NarrowColumnBound(
+    const Schema& schema, ColumnId column_id, const QLValuePB& value, bool lower,
+    ColumnBoundsMap* bounds) {
+  auto column = schema.column_by_id(column_id);
+  if (!column.ok() || schema.is_key_column(column_id)) {
+    return;
+  }
+  auto bound_value = ColumnBoundValue(*column, value);
+  if (!bound_value) {
+    return;
+  }
+  KeyBytes encoded_value;
+  bound_value->AppendToKey(&encoded_value);
+  auto& column_bounds = (*bounds)[column_id];
+  column_bounds.column_id = column_id;
+  auto& bound = lower ? column_bounds.lower : column_bounds.upper;
+  if (bound.empty() ||
+      encoded_value.AsSlice().compare(bound.AsSlice()) * (lower ? 1 : -1) > 0) {
+    bound = std::move(encoded_value);
+  }
+}
+
+void AddColumnBounds(
+    const Schema& schema, const QLConditionPB& condition, ColumnBoundsMap* bounds) {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_AND:
+      for (const auto& operand : operands) {
+        if (operand.has_condition()) {
+          AddColumnBounds(schema, operand.condition(), bounds);
+        }
+      }
+      return;
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: {
+      if (operands.size() != 2) {
+        return;
+      }
+      const auto& lhs = operands.Get(0);
+      const auto& rhs = operands.Get(1);
+      bool lhs_is_column;
+      if (lhs.has_column_id() && rhs.has_value()) {
+        lhs_is_column = true;
+      } else if (lhs.has_value() && rhs.has_column_id()) {
+        lhs_is_column = false;
+      } else {
+        return;
+      }
+      ColumnId column_id(lhs_is_column ? lhs.column_id() : rhs.column_id());
+      const auto& value = lhs_is_column ? rhs.value() : lhs.value();
+      const bool less = condition.op() == QL_OP_LESS_THAN ||
+                        condition.op() == QL_OP_LESS_THAN_EQUAL;
+      if (condition.op() == QL_OP_EQUAL || less != lhs_is_column) {
+        // <column> = <value>, <column> >= <value> or <value> <= <column>.
+        NarrowColumnBound(schema, column_id, value, /* lower= */ true, bounds);
+      }
+      if (condition.op() == QL_OP_EQUAL || less == lhs_is_column) {
+        // <column> = <value>, <column> <= <value> or <value> >= <column>.
+        NarrowColumnBound(schema, column_id, value, /* lower= */ false, bounds);
+      }
+      return;
+    }
+    case QL_OP_BETWEEN: {
+      // <column> BETWEEN <value_1> AND <value_2>, optionally followed by the inclusiveness of the
+      // bounds.
+      if (operands.size() < 3 || !operands.Get(0).has_column_id() ||
+          !operands.Get(1).has_value() || !operands.Get(2).has_value()) {
+        return;
+      }
+      ColumnId column_id(operands.Get(0).column_id());
+      NarrowColumnBound(schema, column_id, operands.Get(1).value(), /* lower= */ true, bounds);
+      NarrowColumnBound(schema, column_id, operands.Get(2).value(), /* lower= */ false, bounds);
+      return;
+    }
+    default:
+      return;
+  }
+}
+
 }  // namespace
 
 DocQLScanSpec::DocQLScanSpec(const Schema& schema,
@@ -366,6 +482,20 @@ std::shared_ptr<rocksdb::ReadFileFilter> DocQLScanSpec::CreateFileFilter() const
   }
 }
 
+std::vector<ColumnValueBounds> DocQLScanSpec::ColumnBounds() const {
+  std::vector<ColumnValueBounds> result;
+  if (!condition_) {
+    return result;
+  }
+  ColumnBoundsMap bounds;
+  AddColumnBounds(schema_, *condition_, &bounds);
+  result.reserve(bounds.size());
+  for (auto& [column_id, column_bounds] : bounds) {
+    result.push_back(std::move(column_bounds));
+  }
+  return result;
+}
+
 Result<KeyBytes> DocQLScanSpec::LowerBound() const {
   return Bound(true /* lower_bound */);
 }
@@ -65,6 +65,9 @@ class DocQLScanSpec : public QLScanSpec {
   // Create file filter based on range components.
   std::shared_ptr<rocksdb::ReadFileFilter> CreateFileFilter() const;
 
+  // Bounds of the values of non-key int, bigint and timestamp columns implied by the condition.
+  std::vector<ColumnValueBounds> ColumnBounds() const;
+
   // Gets the query id.
   const rocksdb::QueryId QueryId() const {
     return query_id_;
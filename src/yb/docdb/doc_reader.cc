@@ -200,6 +200,24 @@ Status DocDBTableReader::UpdateTableTombstoneTime(const Slice& root_doc_key) {
   return Status::OK();
 }
 
+const std::vector<int64_t>& DocDBTableReader::PackedProjectionIndexes(
+    const SchemaPacking& packing) {
+  if (packed_projection_packing_ == &packing) {
+    return packed_projection_indexes_;
+  }
+  packed_projection_packing_ = &packing;
+  packed_projection_indexes_.clear();
+  if (projection_) {
+    packed_projection_indexes_.reserve(projection_->size());
+    for (const auto& column : *projection_) {
+      packed_projection_indexes_.push_back(
+          column.IsColumnId() ? packing.GetIndex(column.GetColumnId())
+                              : SchemaPacking::kNotPackedColumnIdx);
+    }
+  }
+  return packed_projection_indexes_;
+}
+
 // Scan state entry. See state_ description below for details.
 struct StateEntry {
   KeyBytes key_entry; // Represents the part of the key that is related to this state entry.
@@ -477,13 +495,27 @@ class DocDBTableReader::GetHelper {
   // Before calling, all fields should have correct values, especially column_index_ that points
   // to the current column in projection.
   void UpdatePackedColumnData() {
-    auto& column = (*reader_.projection_)[column_index_];
-    if (column.IsColumnId()) {
-      packed_column_data_ = GetPackedColumn(column.GetColumnId());
-    } else {
-      // Used in tests only.
+    if (!packed_projection_indexes_) {
+      // Actual for tests only.
       packed_column_data_.row = nullptr;
+      return;
+    }
+    auto packed_index = (*packed_projection_indexes_)[column_index_];
+    if (packed_index == SchemaPacking::kNotPackedColumnIdx) {
+      // Liveness column and columns missing from the packing.
+      auto& column = (*reader_.projection_)[column_index_];
+      packed_column_data_ =
+          column.IsColumnId() ? GetPackedColumn(column.GetColumnId()) : PackedColumnData();
+      return;
     }
+    auto slice = schema_packing_->GetValue(packed_index, reader_.packed_row_.AsSlice());
+    VLOG_WITH_PREFIX_AND_FUNC(4)
+        << "Packed row " << (*reader_.projection_)[column_index_] << ": "
+        << slice.ToDebugHexString();
+    packed_column_data_ = PackedColumnData {
+      .row = &packed_row_data_,
+      .encoded_value = slice.empty() ? NullSlice() : slice,
+    };
   }
 
   Status Prepare() {
@@ -507,7 +539,10 @@ class DocDBTableReader::GetHelper {
     if (value_type == ValueEntryType::kPackedRow) {
       value.consume_byte();
       schema_packing_ = &VERIFY_RESULT(reader_.schema_packing_storage_.GetPacking(&value)).get();
-      packed_row_.Assign(value);
+      reader_.packed_row_.Assign(value);
+      if (reader_.projection_) {
+        packed_projection_indexes_ = &reader_.PackedProjectionIndexes(*schema_packing_);
+      }
       packed_row_data_.doc_ht = doc_ht;
       packed_row_data_.control_fields = control_fields;
       auto& expiration = root.expiration;
@@ -542,7 +577,7 @@ class DocDBTableReader::GetHelper {
       };
     }
 
-    auto slice = schema_packing_->GetValue(column_id, packed_row_.AsSlice());
+    auto slice = schema_packing_->GetValue(column_id, reader_.packed_row_.AsSlice());
     if (!slice) {
       VLOG_WITH_PREFIX_AND_FUNC(4) << "No packed row data for " << column_id;
       return PackedColumnData();
@@ -589,9 +624,11 @@ class DocDBTableReader::GetHelper {
   SubDocument& result_;
 
   // Packed row related fields. Not changed after initialization.
-  ValueBuffer packed_row_;
+  // Packed row itself is stored in reader_.packed_row_.
   PackedRowData packed_row_data_;
   const SchemaPacking* schema_packing_ = nullptr;
+  // Packed column indexes for projection columns, nullptr when row is not packed.
+  const std::vector<int64_t>* packed_projection_indexes_ = nullptr;
 
   // Scanning stack.
   // I.e. the first entry is related to whole document (i.e. row).
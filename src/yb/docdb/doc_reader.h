@@ -30,6 +30,8 @@
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
 
+#include "yb/util/byte_buffer.h"
+#include "yb/util/kv_util.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/strongly_typed_bool.h"
@@ -97,6 +99,10 @@ class DocDBTableReader {
   // at that row.
   Status InitForKey(const Slice& sub_doc_key);
 
+  // Returns packed column indexes for projection columns in the specified packing.
+  // Result is cached, so subsequent rows with the same schema version don't resolve column ids.
+  const std::vector<int64_t>& PackedProjectionIndexes(const SchemaPacking& packing);
+
   class GetHelper;
 
   // Owned by caller.
@@ -107,6 +113,16 @@ class DocDBTableReader {
   const SchemaPackingStorage& schema_packing_storage_;
 
   std::vector<KeyBytes> encoded_projection_;
+
+  // Schema packing that packed_projection_indexes_ was built for.
+  const SchemaPacking* packed_projection_packing_ = nullptr;
+  // For i-th column in projection contains its index in packed_projection_packing_, or
+  // SchemaPacking::kNotPackedColumnIdx when column is not packed.
+  std::vector<int64_t> packed_projection_indexes_;
+
+  // Buffer for the packed row of the currently read document. Reused between rows to avoid
+  // allocation per row.
+  ValueBuffer packed_row_;
   DocHybridTime table_tombstone_time_ = DocHybridTime::kMin;
   Expiration table_expiration_;
 };
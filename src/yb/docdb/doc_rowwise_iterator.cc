@@ -31,6 +31,7 @@
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_path.h"
+#include "yb/docdb/doc_ql_filefilter.h"
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/doc_read_context.h"
 #include "yb/docdb/doc_reader.h"
@@ -61,6 +62,21 @@
 
 using std::string;
 
+DEFINE_RUNTIME_bool(docdb_scan_skip_files_out_of_bounds, false,
+    "Skip SST files whose key range does not overlap with the bounds of a scan. Useful for "
+    "colocated tables, where files could contain only keys of other tables of the tablet.");
+TAG_FLAG(docdb_scan_skip_files_out_of_bounds, advanced);
+
+DEFINE_RUNTIME_bool(docdb_scan_skip_files_newer_than_read_time, true,
+    "Skip SST files whose records were all written after the global limit of the read time. "
+    "Useful for reads at an old read time, such as time-travel reads.");
+
+DEFINE_RUNTIME_bool(docdb_scan_skip_files_by_column_bounds, false,
+    "Skip SST files whose recorded int, bigint or timestamp column values do not match the "
+    "conditions of a YCQL scan on those columns. Only correct for tables whose filtered columns "
+    "are not updated after a row is inserted. See docdb_record_file_column_bounds.");
+TAG_FLAG(docdb_scan_skip_files_by_column_bounds, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -92,12 +108,13 @@ DocRowwiseIterator::DocRowwiseIterator(
 DocRowwiseIterator::~DocRowwiseIterator() {
 }
 
-Status DocRowwiseIterator::Init(TableType table_type, const Slice& sub_doc_key) {
+Status DocRowwiseIterator::Init(
+    TableType table_type, const Slice& sub_doc_key, rocksdb::QueryId query_id) {
   db_iter_ = CreateIntentAwareIterator(
       doc_db_,
       BloomFilterMode::DONT_USE_BLOOM_FILTER,
       boost::none /* user_key_for_filter */,
-      rocksdb::kDefaultQueryId,
+      query_id,
       txn_op_context_,
       deadline_,
       read_time_);
@@ -149,6 +166,32 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
   return false;
 }
 
+namespace {
+
+// The table tombstone of a colocated table is stored at the table prefix, before the scan lower
+// bound, and is read through the scan iterator. So files are filtered by the table prefix.
+Result<KeyBytes> FileFilterLowerBound(const KeyBytes& lower_doc_key) {
+  auto key = lower_doc_key.AsSlice();
+  if (key.empty() ||
+      (key[0] != KeyEntryTypeAsChar::kColocationId && key[0] != KeyEntryTypeAsChar::kTableId)) {
+    return lower_doc_key;
+  }
+  DocKey table_id;
+  RETURN_NOT_OK(table_id.DecodeFrom(key, DocKeyPart::kUpToId));
+  return table_id.Encode();
+}
+
+std::vector<ColumnValueBounds> ColumnBounds(const DocQLScanSpec& doc_spec) {
+  return doc_spec.ColumnBounds();
+}
+
+// Conditions of YSQL scans on non-key columns are not converted to column bounds.
+std::vector<ColumnValueBounds> ColumnBounds(const DocPgsqlScanSpec& doc_spec) {
+  return {};
+}
+
+} // namespace
+
 template <class T>
 Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   is_forward_scan_ = doc_spec.is_forward_scan();
@@ -167,9 +210,31 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  auto file_filter = doc_spec.CreateFileFilter();
+  if (FLAGS_docdb_scan_skip_files_out_of_bounds &&
+      (!lower_doc_key.empty() || !upper_doc_key.empty())) {
+    file_filter = std::make_shared<KeyBoundsFileFilter>(
+        VERIFY_RESULT(FileFilterLowerBound(lower_doc_key)), upper_doc_key,
+        std::move(file_filter));
+  }
+  if (FLAGS_docdb_scan_skip_files_newer_than_read_time &&
+      read_time_.global_limit.is_valid() && read_time_.global_limit != HybridTime::kMax) {
+    file_filter = std::make_shared<HybridTimeFileFilter>(
+        read_time_.global_limit, std::move(file_filter));
+  }
+  // Files are only skipped depending on the other files that are read, so this filter should see
+  // the decisions of all other filters.
+  if (FLAGS_docdb_scan_skip_files_by_column_bounds) {
+    auto column_bounds = ColumnBounds(doc_spec);
+    if (!column_bounds.empty()) {
+      file_filter = std::make_shared<ColumnBoundsFileFilter>(
+          std::move(column_bounds), std::move(file_filter));
+    }
+  }
+
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, std::move(file_filter));
 
   row_ready_ = false;
 
@@ -446,10 +511,11 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
     const auto& column_id = projection.column_id(i);
     const auto ql_type = projection.column(i).type();
-    const SubDocument* column_value = row_.GetChild(KeyEntryValue::MakeColumnId(column_id));
+    // row_ is refilled for every row, so the column payloads are moved out instead of copied.
+    SubDocument* column_value = row_.GetChild(KeyEntryValue::MakeColumnId(column_id));
     if (column_value != nullptr) {
       QLTableColumn& column = table_row->AllocColumn(column_id);
-      column_value->ToQLValuePB(ql_type, &column.value);
+      column_value->MoveToQLValuePB(ql_type, &column.value);
       column.ttl_seconds = column_value->GetTtl();
       if (column_value->IsWriteTimeSet()) {
         column.write_time = column_value->GetWriteTime();
@@ -67,7 +67,8 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   virtual ~DocRowwiseIterator();
 
   // Init scan iterator.
-  Status Init(TableType table_type, const Slice& sub_doc_key = Slice());
+  Status Init(TableType table_type, const Slice& sub_doc_key = Slice(),
+              rocksdb::QueryId query_id = rocksdb::kDefaultQueryId);
   // Init QL read scan.
   Status Init(const QLScanSpec& spec);
   Status Init(const PgsqlScanSpec& spec);
@@ -464,6 +464,24 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   return DoSetPrimitive(doc_path, control_fields, value, &iter, write_id);
 }
 
+Status DocWriteBatch::SetPackedRow(
+    Slice encoded_doc_key, Slice packed_row, IntraTxnWriteId write_id) {
+  DOCDB_DEBUG_LOG("Called with encoded_doc_key=$0, packed_row=$1",
+                  encoded_doc_key.ToDebugHexString(), packed_row.ToDebugHexString());
+  SCHECK_LT(write_id, put_batch_.size(), InvalidArgument, "Write id was not reserved");
+  SCHECK(!packed_row.empty(), InvalidArgument, "Empty packed row");
+
+  auto& entry = put_batch_[write_id];
+  entry.key.assign(encoded_doc_key.cdata(), encoded_doc_key.size());
+  entry.value.assign(packed_row.cdata(), packed_row.size());
+
+  current_entry_.doc_hybrid_time = DocHybridTime::kMin;
+  key_prefix_.Reset(encoded_doc_key);
+  cache_.Put(key_prefix_, DocHybridTime(HybridTime::kMax, write_id),
+             static_cast<ValueEntryType>(packed_row[0]));
+  return Status::OK();
+}
+
 Status DocWriteBatch::ExtendSubDocument(
     const DocPath& doc_path,
     const ValueRef& value,
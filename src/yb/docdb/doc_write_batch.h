@@ -188,6 +188,12 @@ class DocWriteBatch {
         deadline, query_id);
   }
 
+  // Writes the packed row of the document with the given encoded key and default control fields
+  // into the slot reserved by ReserveWriteId. Same as SetPrimitive with a DocPath that has no
+  // subkeys, which never reads the existing document, but without building the DocPath and the
+  // intermediate copies of the key and value.
+  Status SetPackedRow(Slice encoded_doc_key, Slice packed_row, IntraTxnWriteId write_id);
+
   // Extend the SubDocument in the given key. We'll support List with Append and Prepend mode later.
   // TODO(akashnil): 03/20/17 ENG-1107
   // In each SetPrimitive call, some common work is repeated. It may be made more
@@ -0,0 +1,394 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// In-process benchmark of the DocDB read and write kernels: DocWriteBatch, RowPacker,
+// IntentAwareIterator and DocRowwiseIterator. For every combination of the configured number of
+// columns, row format and intent ratio it loads a fresh DocDB and reports ops/s, CPU per op and
+// allocations per op for each phase.
+//
+// Example:
+//   docdb-bench --docdb_bench_rows=200000 --docdb_bench_num_columns=4,64 \
+//       --docdb_bench_key_distribution=uniform --docdb_bench_intent_ratios=0,0.1
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifdef YB_TCMALLOC_ENABLED
+#if defined(YB_GOOGLE_TCMALLOC)
+#include <tcmalloc/malloc_extension.h>
+#else
+#include <gperftools/malloc_hook.h>
+#endif
+#endif
+
+#include "yb/common/ql_value.h"
+#include "yb/common/read_hybrid_time.h"
+#include "yb/common/schema.h"
+#include "yb/common/transaction-test-util.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_read_context.h"
+#include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_write_batch.h"
+#include "yb/docdb/docdb_test_base.h"
+#include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/schema_packing.h"
+
+#include "yb/gutil/strings/split.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/random_util.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DEFINE_NON_RUNTIME_int32(docdb_bench_rows, 20000,
+    "Number of rows loaded into DocDB for each benchmark configuration.");
+DEFINE_NON_RUNTIME_int32(docdb_bench_rows_per_batch, 100,
+    "Number of rows written by a single DocWriteBatch.");
+DEFINE_NON_RUNTIME_int32(docdb_bench_point_reads, 20000,
+    "Number of IntentAwareIterator point reads for each benchmark configuration.");
+DEFINE_NON_RUNTIME_string(docdb_bench_num_columns, "4,64",
+    "Comma separated list of non-key column counts, i.e. narrow and wide schemas.");
+DEFINE_NON_RUNTIME_string(docdb_bench_row_formats, "packed,unpacked",
+    "Comma separated list of row formats: packed (one RowPacker value per row) or unpacked "
+    "(one value per column).");
+DEFINE_NON_RUNTIME_int32(docdb_bench_string_value_size, 16,
+    "Size of the values of the string columns. Every other non-key column is a string column.");
+DEFINE_NON_RUNTIME_string(docdb_bench_key_distribution, "sequential",
+    "Order of the keys used by writes and point reads: sequential or uniform.");
+DEFINE_NON_RUNTIME_string(docdb_bench_intent_ratios, "0,0.1",
+    "Comma separated list of the fractions of rows that are also overwritten by committed, but "
+    "not yet applied, transactions, so that readers have to resolve their intents.");
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr SchemaVersion kSchemaVersion = 1;
+const auto kWriteTime = HybridTime::FromMicros(1000);
+const auto kIntentWriteTime = HybridTime::FromMicros(1500);
+const auto kCommitTime = HybridTime::FromMicros(1600);
+const auto kReadTime = ReadHybridTime::FromMicros(2000);
+
+std::vector<std::string> SplitList(const std::string& input) {
+  return strings::Split(input, ",", strings::SkipEmpty());
+}
+
+// Counts allocations of the whole process while alive. With gperftools every allocation is seen
+// through a malloc hook, with Google tcmalloc the numbers are estimated from an allocation
+// profile. Without tcmalloc nothing is counted.
+class AllocationCounter {
+ public:
+  AllocationCounter() {
+#ifdef YB_TCMALLOC_ENABLED
+#if defined(YB_GOOGLE_TCMALLOC)
+    token_.emplace(tcmalloc::MallocExtension::StartAllocationProfiling());
+#else
+    allocations_.store(0, std::memory_order_relaxed);
+    allocated_bytes_.store(0, std::memory_order_relaxed);
+    CHECK(MallocHook::AddNewHook(&CountAllocation));
+#endif
+#endif
+  }
+
+  // Stops counting and fills in the number of allocations and allocated bytes.
+  void Stop(uint64_t* allocations, uint64_t* allocated_bytes) {
+    *allocations = 0;
+    *allocated_bytes = 0;
+#ifdef YB_TCMALLOC_ENABLED
+#if defined(YB_GOOGLE_TCMALLOC)
+    auto profile = std::move(*token_).Stop();
+    token_.reset();
+    profile.Iterate([allocations, allocated_bytes](const tcmalloc::Profile::Sample& sample) {
+      *allocations += sample.count;
+      *allocated_bytes += sample.sum;
+    });
+#else
+    CHECK(MallocHook::RemoveNewHook(&CountAllocation));
+    *allocations = allocations_.load(std::memory_order_relaxed);
+    *allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+#endif
+#endif
+  }
+
+ private:
+#ifdef YB_TCMALLOC_ENABLED
+#if defined(YB_GOOGLE_TCMALLOC)
+  std::optional<tcmalloc::MallocExtension::AllocationProfilingToken> token_;
+#else
+  static void CountAllocation(const void* ptr, size_t size) {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  static std::atomic<uint64_t> allocations_;
+  static std::atomic<uint64_t> allocated_bytes_;
+#endif
+#endif
+};
+
+#if defined(YB_TCMALLOC_ENABLED) && !defined(YB_GOOGLE_TCMALLOC)
+std::atomic<uint64_t> AllocationCounter::allocations_{0};
+std::atomic<uint64_t> AllocationCounter::allocated_bytes_{0};
+#endif
+
+// Measures one phase of the benchmark: wall time, CPU time of the calling thread and
+// allocations.
+class PhaseMeter {
+ public:
+  explicit PhaseMeter(std::string description) : description_(std::move(description)) {
+    stopwatch_.start();
+  }
+
+  void Finish(size_t ops) {
+    stopwatch_.stop();
+    uint64_t allocations, allocated_bytes;
+    allocation_counter_.Stop(&allocations, &allocated_bytes);
+
+    auto elapsed = stopwatch_.elapsed();
+    ops = std::max<size_t>(ops, 1);
+    LOG(INFO) << Format(
+        "$0: $1 ops, $2 ops/s, $3 us CPU/op ($4 us user, $5 us sys), $6 allocs/op, $7 bytes/op",
+        description_, ops, static_cast<int64_t>(ops / elapsed.wall_seconds()),
+        (elapsed.user + elapsed.system) / 1000.0 / ops, elapsed.user / 1000.0 / ops,
+        elapsed.system / 1000.0 / ops, static_cast<double>(allocations) / ops,
+        static_cast<double>(allocated_bytes) / ops);
+  }
+
+ private:
+  std::string description_;
+  Stopwatch stopwatch_{Stopwatch::THIS_THREAD};
+  AllocationCounter allocation_counter_;
+};
+
+struct BenchConfig {
+  size_t num_columns;
+  bool packed;
+  double intent_ratio;
+
+  std::string ToString() const {
+    return Format(
+        "{ columns: $0 format: $1 intent_ratio: $2 }", num_columns,
+        packed ? "packed" : "unpacked", intent_ratio);
+  }
+};
+
+} // namespace
+
+class DocDBBench : public DocDBTestBase {
+ protected:
+  void SetUp() override {
+    DocDBTestBase::SetUp();
+    SeedRandom();
+  }
+
+  void RunConfig(const BenchConfig& config);
+
+  Status Load(const BenchConfig& config);
+  Status WriteRows(
+      const BenchConfig& config, const std::vector<int64_t>& keys, bool transactional,
+      HybridTime write_time, const std::string& description);
+  Status AddRow(const BenchConfig& config, int64_t key, DocWriteBatch* dwb);
+  Status ScanRows(const BenchConfig& config);
+  Status PointReads(const BenchConfig& config);
+
+  std::vector<int64_t> MakeKeys(size_t count, size_t key_space) const;
+
+  Schema schema_;
+  std::unique_ptr<SchemaPacking> schema_packing_;
+  std::unique_ptr<DocReadContext> doc_read_context_;
+  TransactionStatusManagerMock txn_status_manager_;
+  std::string string_value_;
+};
+
+std::vector<int64_t> DocDBBench::MakeKeys(size_t count, size_t key_space) const {
+  std::vector<int64_t> result(count);
+  if (FLAGS_docdb_bench_key_distribution == "uniform") {
+    for (auto& key : result) {
+      key = RandomUniformInt<int64_t>(0, key_space - 1);
+    }
+  } else {
+    CHECK_EQ(FLAGS_docdb_bench_key_distribution, "sequential");
+    for (size_t i = 0; i != count; ++i) {
+      result[i] = i % key_space;
+    }
+  }
+  return result;
+}
+
+Status DocDBBench::AddRow(const BenchConfig& config, int64_t key, DocWriteBatch* dwb) {
+  auto encoded_doc_key = DocKey(KeyEntryValues(key)).Encode();
+  if (config.packed) {
+    RowPacker packer(
+        kSchemaVersion, *schema_packing_,
+        /* packed_size_limit= */ std::numeric_limits<size_t>::max(),
+        /* control_fields= */ Slice());
+    for (size_t i = 0; i != config.num_columns; ++i) {
+      auto column_id = schema_.column_id(schema_.num_key_columns() + i);
+      RETURN_NOT_OK(packer.AddValue(
+          column_id, i % 2 ? QLValue::Primitive(string_value_) : QLValue::PrimitiveInt64(key)));
+    }
+    return dwb->SetPrimitive(
+        DocPath(encoded_doc_key), ValueControlFields(), ValueRef(VERIFY_RESULT(packer.Complete())));
+  }
+
+  for (size_t i = 0; i != config.num_columns; ++i) {
+    auto column_id = schema_.column_id(schema_.num_key_columns() + i);
+    RETURN_NOT_OK(dwb->SetPrimitive(
+        DocPath(encoded_doc_key, KeyEntryValue::MakeColumnId(column_id)),
+        ValueRef(i % 2 ? QLValue::Primitive(string_value_) : QLValue::PrimitiveInt64(key))));
+  }
+  return Status::OK();
+}
+
+Status DocDBBench::WriteRows(
+    const BenchConfig& config, const std::vector<int64_t>& keys, bool transactional,
+    HybridTime write_time, const std::string& description) {
+  const size_t rows_per_batch = std::max(FLAGS_docdb_bench_rows_per_batch, 1);
+  auto dwb = MakeDocWriteBatch();
+  PhaseMeter meter(Format("$0 $1", description, config));
+  for (size_t begin = 0; begin < keys.size(); begin += rows_per_batch) {
+    if (transactional) {
+      // One transaction per batch, like distributed transactions writing to a tablet.
+      auto txn_id = TransactionId::GenerateRandom();
+      SetCurrentTransactionId(txn_id);
+      txn_status_manager_.Commit(txn_id, kCommitTime);
+    }
+    auto end = std::min(begin + rows_per_batch, keys.size());
+    for (auto i = begin; i != end; ++i) {
+      RETURN_NOT_OK(AddRow(config, keys[i], &dwb));
+    }
+    RETURN_NOT_OK(WriteToRocksDBAndClear(&dwb, write_time));
+  }
+  meter.Finish(keys.size());
+  return Status::OK();
+}
+
+Status DocDBBench::Load(const BenchConfig& config) {
+  std::vector<ColumnSchema> columns;
+  std::vector<ColumnId> column_ids;
+  columns.emplace_back("k", DataType::INT64, /* is_nullable= */ false);
+  column_ids.emplace_back(10);
+  for (size_t i = 0; i != config.num_columns; ++i) {
+    columns.emplace_back(
+        Format("c$0", i), i % 2 ? DataType::STRING : DataType::INT64, /* is_nullable= */ true);
+    column_ids.emplace_back(narrow_cast<ColumnIdRep>(11 + i));
+  }
+  schema_ = Schema(columns, column_ids, 1);
+  schema_packing_ = std::make_unique<SchemaPacking>(schema_);
+  doc_read_context_ = std::make_unique<DocReadContext>(DocReadContext::TEST_Create(schema_));
+  string_value_ = RandomHumanReadableString(FLAGS_docdb_bench_string_value_size);
+
+  const size_t num_rows = FLAGS_docdb_bench_rows;
+  RETURN_NOT_OK(WriteRows(
+      config, MakeKeys(num_rows, num_rows), /* transactional= */ false, kWriteTime, "Write"));
+
+  if (config.intent_ratio > 0) {
+    std::vector<int64_t> intent_keys(
+        std::min(static_cast<size_t>(num_rows * config.intent_ratio), num_rows));
+    std::iota(intent_keys.begin(), intent_keys.end(), 0);
+    auto stride = num_rows / std::max<size_t>(intent_keys.size(), 1);
+    for (auto& key : intent_keys) {
+      key *= stride;
+    }
+    SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+    auto status = WriteRows(
+        config, intent_keys, /* transactional= */ true, kIntentWriteTime, "Write intents");
+    ResetCurrentTransactionId();
+    SetTransactionIsolationLevel(IsolationLevel::NON_TRANSACTIONAL);
+    RETURN_NOT_OK(status);
+  }
+
+  return FlushRocksDbAndWait();
+}
+
+Status DocDBBench::ScanRows(const BenchConfig& config) {
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager_);
+  QLTableRow row;
+  size_t rows = 0;
+  PhaseMeter meter(Format("Scan $0", config));
+  DocRowwiseIterator iter(
+      schema_, *doc_read_context_, txn_context, doc_db(), CoarseTimePoint::max(), kReadTime);
+  RETURN_NOT_OK(iter.Init(YQL_TABLE_TYPE));
+  while (VERIFY_RESULT(iter.HasNext())) {
+    RETURN_NOT_OK(iter.NextRow(&row));
+    ++rows;
+  }
+  meter.Finish(rows);
+  SCHECK_EQ(rows, static_cast<size_t>(FLAGS_docdb_bench_rows), IllegalState,
+            "Wrong number of rows");
+  return Status::OK();
+}
+
+Status DocDBBench::PointReads(const BenchConfig& config) {
+  auto keys = MakeKeys(FLAGS_docdb_bench_point_reads, FLAGS_docdb_bench_rows);
+  std::vector<KeyBytes> encoded_keys;
+  encoded_keys.reserve(keys.size());
+  for (auto key : keys) {
+    encoded_keys.push_back(DocKey(KeyEntryValues(key)).Encode());
+  }
+
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager_);
+  PhaseMeter meter(Format("Point read $0", config));
+  auto iter = CreateIntentAwareIterator(
+      doc_db(), BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none, rocksdb::kDefaultQueryId,
+      txn_context, CoarseTimePoint::max(), kReadTime);
+  for (const auto& encoded_key : encoded_keys) {
+    iter->Seek(encoded_key.AsSlice());
+    SCHECK(iter->valid(), IllegalState, "Key not found");
+    auto key_data = VERIFY_RESULT(iter->FetchKey());
+    SCHECK(key_data.key.starts_with(encoded_key.AsSlice()), IllegalState, "Wrong key found");
+  }
+  meter.Finish(encoded_keys.size());
+  return Status::OK();
+}
+
+void DocDBBench::RunConfig(const BenchConfig& config) {
+  LOG(INFO) << "Running " << config;
+  ASSERT_OK(Load(config));
+  ASSERT_OK(ScanRows(config));
+  ASSERT_OK(PointReads(config));
+  ASSERT_OK(DestroyRocksDB());
+  ASSERT_OK(OpenRocksDB());
+}
+
+TEST_F(DocDBBench, ReadWriteKernels) {
+  for (const auto& num_columns_str : SplitList(FLAGS_docdb_bench_num_columns)) {
+    for (const auto& format : SplitList(FLAGS_docdb_bench_row_formats)) {
+      for (const auto& intent_ratio_str : SplitList(FLAGS_docdb_bench_intent_ratios)) {
+        BenchConfig config {
+          .num_columns = std::stoul(num_columns_str),
+          .packed = format == "packed",
+          .intent_ratio = std::stod(intent_ratio_str),
+        };
+        ASSERT_TRUE(config.packed || format == "unpacked") << "Unknown row format: " << format;
+        ASSERT_NO_FATALS(RunConfig(config));
+      }
+    }
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
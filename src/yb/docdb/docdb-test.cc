@@ -21,6 +21,7 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ql_filefilter.h"
 #include "yb/docdb/doc_reader.h"
 #include "yb/docdb/doc_reader_redis.h"
 #include "yb/docdb/docdb-internal.h"
@@ -76,6 +77,7 @@ using namespace std::literals;
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
 DECLARE_bool(TEST_docdb_sort_weak_intents);
+DECLARE_bool(docdb_record_file_column_bounds);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
 
@@ -92,6 +94,12 @@ constexpr int64_t kIntKey2 = 789123;
 Result<KeyEntryValue> TEST_GetKeyEntryValue(
     const rocksdb::UserBoundaryValues& values, size_t index);
 
+Result<DocHybridTime> TEST_GetHybridTime(const rocksdb::UserBoundaryValues& values);
+
+rocksdb::UserBoundaryTag TagForHybridTime();
+rocksdb::UserBoundaryTag TagForColumnValues();
+rocksdb::UserBoundaryTag TagForColumnValue(ColumnId column_id);
+
 YB_STRONGLY_TYPED_BOOL(InitMarkerExpired);
 YB_STRONGLY_TYPED_BOOL(UseIntermediateFlushes);
 
@@ -2805,6 +2813,14 @@ class DocDBTestBoundaryValues: public DocDBTestWrapper {
           temp = ASSERT_RESULT(TEST_GetKeyEntryValue(largest, 1));
           ASSERT_EQ(KeyEntryValue::Int64(key_ints.max), temp);
         }
+        {
+          // Doc hybrid time is encoded in the reverse order.
+          auto &times = trackers[j].times;
+          auto temp = ASSERT_RESULT(TEST_GetHybridTime(largest));
+          ASSERT_EQ(times.min, temp.hybrid_time());
+          temp = ASSERT_RESULT(TEST_GetHybridTime(smallest));
+          ASSERT_EQ(times.max, temp.hybrid_time());
+        }
       }
     }
   }
@@ -2819,6 +2835,221 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+TEST_P(DocDBTestWrapper, HybridTimeFileFilter) {
+  // The hybrid time boundaries and the filter rely on EncodedDocHybridTime being ordered by
+  // hybrid time, while its bytes are ordered in the reverse direction.
+  EncodedDocHybridTime encoded_1000(HybridTime::FromMicros(1000), 0);
+  EncodedDocHybridTime encoded_3000(HybridTime::FromMicros(3000), 0);
+  ASSERT_LT(encoded_1000, encoded_3000);
+  ASSERT_GT(encoded_1000.AsSlice().compare(encoded_3000.AsSlice()), 0);
+
+  auto fill_file = [](rocksdb::FileMetaData* meta) {
+    meta->fd = rocksdb::FileDescriptor(1, 0, 0, 0);
+    meta->smallest.key = rocksdb::InternalKey("a", 1, rocksdb::kTypeValue);
+    meta->largest.key = rocksdb::InternalKey("z", 1, rocksdb::kTypeValue);
+  };
+
+  rocksdb::FileMetaData file_meta;
+  fill_file(&file_meta);
+  // The largest hybrid time has the smallest encoded value.
+  file_meta.smallest.user_values.emplace_back(TagForHybridTime(), encoded_3000.AsSlice());
+  file_meta.largest.user_values.emplace_back(TagForHybridTime(), encoded_1000.AsSlice());
+  rocksdb::FileMetaData no_bounds_meta;
+  fill_file(&no_bounds_meta);
+
+  rocksdb::Arena arena;
+  const rocksdb::FdWithBoundaries file(&arena, file_meta);
+  const rocksdb::FdWithBoundaries file_without_bounds(&arena, no_bounds_meta);
+
+  auto filter = [](int64_t read_time_micros, std::shared_ptr<rocksdb::ReadFileFilter> next) {
+    return HybridTimeFileFilter(HybridTime::FromMicros(read_time_micros), std::move(next));
+  };
+
+  // All records of the file were written after the read time.
+  ASSERT_FALSE(filter(500, nullptr).Filter(file));
+  ASSERT_FALSE(filter(999, nullptr).Filter(file));
+  // The file has records at or before the read time.
+  ASSERT_TRUE(filter(1000, nullptr).Filter(file));
+  ASSERT_TRUE(filter(2000, nullptr).Filter(file));
+  ASSERT_TRUE(filter(5000, nullptr).Filter(file));
+  // Files written before hybrid time boundaries were introduced are never skipped.
+  ASSERT_TRUE(filter(500, nullptr).Filter(file_without_bounds));
+
+  // The next filter is consulted for the files that are not skipped.
+  auto next = std::make_shared<KeyBoundsFileFilter>(
+      KeyBytes(Slice("x")), KeyBytes(), nullptr /* next_filter */);
+  ASSERT_FALSE(filter(2000, next).Filter(file));
+  next = std::make_shared<KeyBoundsFileFilter>(KeyBytes(Slice("b")), KeyBytes(), nullptr);
+  ASSERT_TRUE(filter(2000, next).Filter(file));
+}
+
+TEST_P(DocDBTestWrapper, RecordColumnBounds) {
+  const ColumnId kColumn(11);
+  const auto kTag = TagForColumnValue(kColumn);
+  auto encoded = [](int64_t value) {
+    KeyBytes result;
+    KeyEntryValue::Int64(value).AppendToKey(&result);
+    return result;
+  };
+  auto write = [this, kColumn](const std::string& key, const QLValuePB& value, HybridTime ht) {
+    return SetPrimitive(
+        DocPath(DocKey(KeyEntryValues(key)).Encode(), KeyEntryValue::MakeColumnId(kColumn)),
+        value, ht);
+  };
+  auto sorted_files = [this] {
+    std::vector<rocksdb::LiveFileMetaData> files;
+    rocksdb()->GetLiveFilesMetaData(&files);
+    std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.name_id < rhs.name_id;
+    });
+    return files;
+  };
+  auto check_bounds = [&kTag, &encoded](
+      const rocksdb::LiveFileMetaData& file, int64_t min_value, int64_t max_value) {
+    auto* smallest = rocksdb::TEST_UserValueWithTag(file.smallest.user_values, kTag);
+    auto* largest = rocksdb::TEST_UserValueWithTag(file.largest.user_values, kTag);
+    ASSERT_NE(smallest, nullptr);
+    ASSERT_NE(largest, nullptr);
+    ASSERT_EQ(smallest->AsSlice(), encoded(min_value).AsSlice());
+    ASSERT_EQ(largest->AsSlice(), encoded(max_value).AsSlice());
+    auto* column_values = rocksdb::TEST_UserValueWithTag(
+        file.largest.user_values, TagForColumnValues());
+    ASSERT_NE(column_values, nullptr);
+    ASSERT_EQ(column_values->AsSlice(), Slice("\0", 1));
+  };
+
+  // Files written with the flag off have no column bounds.
+  ASSERT_OK(write("a", QLValue::Primitive(int64_t{20}), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  auto files = sorted_files();
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_EQ(rocksdb::TEST_UserValueWithTag(files[0].largest.user_values, TagForColumnValues()),
+            nullptr);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_record_file_column_bounds) = true;
+  ASSERT_OK(write("b", QLValue::Primitive(int64_t{-5}), 2000_usec_ht));
+  ASSERT_OK(write("c", QLValue::Primitive(int64_t{7}), 3000_usec_ht));
+  // Values of other types are not recorded.
+  ASSERT_OK(write("d", QLValue::Primitive(std::string("string value")), 4000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(write("e", QLValue::Primitive(int64_t{100}), 5000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  files = sorted_files();
+  ASSERT_EQ(files.size(), 3);
+  ASSERT_NO_FATALS(check_bounds(files[1], -5, 7));
+  ASSERT_NO_FATALS(check_bounds(files[2], 100, 100));
+
+  // Bounds of the compaction output cover the values of all inputs, including the input written
+  // without column bounds.
+  FullyCompactHistoryBefore(500_usec_ht);
+  files = sorted_files();
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_NO_FATALS(check_bounds(files[0], -5, 100));
+
+  // Compaction outputs written with the flag off have no column bounds, even if the inputs had.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_record_file_column_bounds) = false;
+  ASSERT_OK(write("f", QLValue::Primitive(int64_t{1}), 6000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  FullyCompactHistoryBefore(500_usec_ht);
+  files = sorted_files();
+  ASSERT_EQ(files.size(), 1);
+  ASSERT_EQ(rocksdb::TEST_UserValueWithTag(files[0].smallest.user_values, kTag), nullptr);
+  ASSERT_EQ(rocksdb::TEST_UserValueWithTag(files[0].largest.user_values, TagForColumnValues()),
+            nullptr);
+}
+
+TEST_P(DocDBTestWrapper, ColumnBoundsFileFilter) {
+  const ColumnId kColumn(11);
+  auto encoded_value = [](int64_t value) {
+    KeyBytes result;
+    KeyEntryValue::Int64(value).AppendToKey(&result);
+    return result;
+  };
+  auto make_file = [&encoded_value, kColumn](
+      int64_t min_ht, int64_t max_ht, int64_t min_value, int64_t max_value,
+      bool complete = true) {
+    rocksdb::FileMetaData meta;
+    meta.fd = rocksdb::FileDescriptor(1, 0, 0, 0);
+    meta.smallest.key = rocksdb::InternalKey("a", 1, rocksdb::kTypeValue);
+    meta.largest.key = rocksdb::InternalKey("z", 1, rocksdb::kTypeValue);
+    // Doc hybrid time is encoded in the reverse order.
+    meta.smallest.user_values.emplace_back(
+        TagForHybridTime(),
+        EncodedDocHybridTime(HybridTime::FromMicros(max_ht), 0).AsSlice());
+    meta.largest.user_values.emplace_back(
+        TagForHybridTime(),
+        EncodedDocHybridTime(HybridTime::FromMicros(min_ht), 0).AsSlice());
+    meta.smallest.user_values.emplace_back(TagForColumnValues(), Slice("\0", 1));
+    meta.largest.user_values.emplace_back(
+        TagForColumnValues(), complete ? Slice("\0", 1) : Slice("\1", 1));
+    meta.smallest.user_values.emplace_back(
+        TagForColumnValue(kColumn), encoded_value(min_value).AsSlice());
+    meta.largest.user_values.emplace_back(
+        TagForColumnValue(kColumn), encoded_value(max_value).AsSlice());
+    return meta;
+  };
+
+  rocksdb::Arena arena;
+  auto filter_files = [&arena](
+      const std::vector<rocksdb::FileMetaData>& metas, const rocksdb::ReadFileFilter& filter) {
+    std::vector<rocksdb::FdWithBoundaries> files;
+    for (const auto& meta : metas) {
+      files.emplace_back(&arena, meta);
+    }
+    std::vector<bool> read;
+    filter.FilterFiles(files.data(), files.size(), &read);
+    return read;
+  };
+
+  // Scan for values of at least 50.
+  auto make_filter = [&encoded_value, kColumn](
+      std::shared_ptr<rocksdb::ReadFileFilter> next = nullptr) {
+    return ColumnBoundsFileFilter(
+        {ColumnValueBounds{.column_id = kColumn, .lower = encoded_value(50), .upper = KeyBytes()}},
+        std::move(next));
+  };
+  auto filter = make_filter();
+
+  auto old_file = make_file(100, 200, 0, 10);
+  auto middle_file = make_file(300, 400, 20, 30);
+  auto new_file = make_file(500, 600, 40, 60);
+
+  // Files without matching values, older than all files that are read, are skipped.
+  ASSERT_EQ(filter_files({old_file, middle_file, new_file}, filter),
+            std::vector<bool>({false, false, true}));
+  // A file without matching values that is newer than a file that is read could hide older
+  // versions of rows, so it is read.
+  auto newest_file = make_file(700, 800, 0, 10);
+  ASSERT_EQ(filter_files({old_file, new_file, newest_file}, filter),
+            std::vector<bool>({false, true, true}));
+  // A file, that is read because its records are not older than the records of the files to
+  // read, makes other files not older as well.
+  auto long_file = make_file(150, 550, 0, 10);
+  ASSERT_EQ(filter_files({middle_file, long_file, new_file}, filter),
+            std::vector<bool>({true, true, true}));
+  // Files with column values, that are missing from the bounds, are read.
+  auto incomplete_file = make_file(500, 600, 0, 10, /* complete= */ false);
+  ASSERT_EQ(filter_files({old_file, incomplete_file}, filter),
+            std::vector<bool>({false, true}));
+  // Files without bounds could have records older than any other file, so nothing is skipped.
+  rocksdb::FileMetaData no_bounds_file;
+  no_bounds_file.fd = rocksdb::FileDescriptor(1, 0, 0, 0);
+  no_bounds_file.smallest.key = rocksdb::InternalKey("a", 1, rocksdb::kTypeValue);
+  no_bounds_file.largest.key = rocksdb::InternalKey("z", 1, rocksdb::kTypeValue);
+  ASSERT_EQ(filter_files({old_file, no_bounds_file, new_file}, filter),
+            std::vector<bool>({true, true, true}));
+
+  // Files skipped by the next filter are not read, so they don't prevent skipping other files.
+  auto hybrid_time_filter = std::make_shared<HybridTimeFileFilter>(
+      HybridTime::FromMicros(450), nullptr /* next_filter */);
+  ASSERT_EQ(filter_files({old_file, middle_file, new_file}, make_filter(hybrid_time_filter)),
+            std::vector<bool>({false, false, false}));
+  hybrid_time_filter = std::make_shared<HybridTimeFileFilter>(
+      HybridTime::FromMicros(350), nullptr /* next_filter */);
+  ASSERT_EQ(filter_files({old_file, long_file, new_file}, make_filter(hybrid_time_filter)),
+            std::vector<bool>({false, false, false}));
+}
+
 TEST_P(DocDBTestWrapper, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
@@ -3019,6 +3250,35 @@ TEST_P(DocDBTestWrapper, SetPrimitiveWithInitMarker) {
   }
 }
 
+TEST_P(DocDBTestWrapper, SetPackedRowMatchesSetPrimitive) {
+  std::string encoded_value;
+  AppendEncodedValue(QLValue::Primitive("value1").value(), &encoded_value);
+  const Slice encoded_value_slice(encoded_value);
+
+  auto expected = MakeDocWriteBatch();
+  auto expected_write_id = expected.ReserveWriteId();
+  ASSERT_OK(expected.SetPrimitive(
+      DocPath(kEncodedDocKey1), ValueControlFields(), ValueRef(encoded_value_slice),
+      ReadHybridTime::Max(), CoarseTimePoint::max(), rocksdb::kDefaultQueryId,
+      expected_write_id));
+
+  auto actual = MakeDocWriteBatch();
+  auto actual_write_id = actual.ReserveWriteId();
+  ASSERT_OK(actual.SetPackedRow(kEncodedDocKey1.AsSlice(), encoded_value, actual_write_id));
+  ASSERT_NOK(actual.SetPackedRow(kEncodedDocKey1.AsSlice(), encoded_value, actual_write_id + 1));
+
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i != expected.size(); ++i) {
+    ASSERT_EQ(expected.key_value_pairs()[i].key, actual.key_value_pairs()[i].key);
+    ASSERT_EQ(expected.key_value_pairs()[i].value, actual.key_value_pairs()[i].value);
+  }
+
+  ASSERT_OK(WriteToRocksDBAndClear(&actual, 1000_usec_ht));
+  ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(R"#(
+SubDocKey(DocKey([], ["row1", 11111]), [HT{ physical: 1000 }]) -> "value1"
+      )#");
+}
+
 TEST_P(DocDBTestWrapper, TestInetSortOrder) {
   InsertInet("1.2.3.4");
   InsertInet("2.2.3.4");
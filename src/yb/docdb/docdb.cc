@@ -86,10 +86,18 @@ namespace docdb {
 
 namespace {
 
+// Index of weak intents already added to a lock batch, by key. Weak intents of different doc
+// paths usually share prefixes, e.g. the empty key, or the hash components of rows in the same
+// hash bucket. Merging them as they are added keeps the lock batch of a large write proportional
+// to the number of distinct prefixes, instead of the number of doc paths times their depth.
+// Keys point to the buffers of the entries in the batch, that are kept alive by those entries.
+using WeakIntentIndex = std::unordered_map<Slice, size_t, Slice::Hash>;
+
 // key should be valid prefix of doc key, ending with some complete pritimive value or group end.
 Status ApplyIntent(RefCntPrefix key,
                    const IntentTypeSet intent_types,
-                   LockBatchEntries *keys_locked) {
+                   LockBatchEntries *keys_locked,
+                   WeakIntentIndex* weak_intents = nullptr) {
   // Have to strip kGroupEnd from end of key, because when only hash key is specified, we will
   // get two kGroupEnd at end of strong intent.
   size_t size = key.size();
@@ -107,6 +115,13 @@ Status ApplyIntent(RefCntPrefix key,
     }
   }
   key.Resize(size);
+  if (weak_intents) {
+    auto [it, inserted] = weak_intents->try_emplace(key.as_slice(), keys_locked->size());
+    if (!inserted) {
+      (*keys_locked)[it->second].intent_types |= intent_types;
+      return Status::OK();
+    }
+  }
   keys_locked->push_back({key, intent_types});
   return Status::OK();
 }
@@ -131,6 +146,7 @@ Result<DetermineKeysToLockResult> DetermineKeysToLock(
   DetermineKeysToLockResult result;
   boost::container::small_vector<RefCntPrefix, 8> doc_paths;
   boost::container::small_vector<size_t, 32> key_prefix_lengths;
+  WeakIntentIndex weak_intents;
   result.need_read_snapshot = false;
   for (const unique_ptr<DocOperation>& doc_op : doc_write_ops) {
     doc_paths.clear();
@@ -163,12 +179,12 @@ Result<DetermineKeysToLockResult> DetermineKeysToLock(
       if (doc_path.size() > 0 && transactional_table) {
         partial_key.Resize(0);
         RETURN_NOT_OK(ApplyIntent(
-            partial_key, StrongToWeak(strong_intent_types), &result.lock_batch));
+            partial_key, StrongToWeak(strong_intent_types), &result.lock_batch, &weak_intents));
       }
       for (size_t prefix_length : key_prefix_lengths) {
         partial_key.Resize(prefix_length);
         RETURN_NOT_OK(ApplyIntent(
-            partial_key, StrongToWeak(strong_intent_types), &result.lock_batch));
+            partial_key, StrongToWeak(strong_intent_types), &result.lock_batch, &weak_intents));
       }
 
       RETURN_NOT_OK(ApplyIntent(doc_path, strong_intent_types, &result.lock_batch));
@@ -184,14 +200,21 @@ Result<DetermineKeysToLockResult> DetermineKeysToLock(
         isolation_level, OperationKind::kRead, row_mark_type);
     RETURN_NOT_OK(EnumerateIntents(
         read_pairs,
-        [&result, &strong_read_intent_types](
+        [&result, &strong_read_intent_types, &weak_intents](
             IntentStrength strength, FullDocKey, Slice value, KeyBytes* key, LastKey) {
-          RefCntPrefix prefix(key->AsSlice());
-          return ApplyIntent(prefix,
-                             strength == IntentStrength::kStrong
-                                ? strong_read_intent_types
-                                : StrongToWeak(strong_read_intent_types),
-                             &result.lock_batch);
+          if (strength == IntentStrength::kStrong) {
+            return ApplyIntent(
+                RefCntPrefix(key->AsSlice()), strong_read_intent_types, &result.lock_batch);
+          }
+          auto it = weak_intents.find(key->AsSlice());
+          if (it != weak_intents.end()) {
+            // Avoid copying the key of a weak intent that is already in the batch.
+            result.lock_batch[it->second].intent_types |= StrongToWeak(strong_read_intent_types);
+            return Status::OK();
+          }
+          return ApplyIntent(
+              RefCntPrefix(key->AsSlice()), StrongToWeak(strong_read_intent_types),
+              &result.lock_batch, &weak_intents);
         }, partial_range_key_intents));
   }
 
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/docdb_compaction_context.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <glog/logging.h>
@@ -50,8 +51,29 @@ DECLARE_uint64(ysql_packed_row_size_limit);
 namespace yb {
 namespace docdb {
 
+rocksdb::UserBoundaryTag TagForHybridTime();
+bool IsColumnValuesTag(rocksdb::UserBoundaryTag tag);
+
 namespace {
 
+void SetUserValue(
+    rocksdb::UserBoundaryTag tag, const Slice& value, rocksdb::UserBoundaryValues* values) {
+  for (auto& existing : *values) {
+    if (existing.tag == tag) {
+      existing.value.Assign(value);
+      return;
+    }
+  }
+  values->emplace_back(tag, value);
+}
+
+void EraseColumnValues(rocksdb::UserBoundaryValues* values) {
+  values->erase(
+      std::remove_if(values->begin(), values->end(),
+                     [](const auto& value) { return IsColumnValuesTag(value.tag); }),
+      values->end());
+}
+
 struct OverwriteData {
   EncodedDocHybridTime encoded_doc_ht;
   Expiration expiration;
@@ -450,6 +472,7 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
         could_change_key_range_(
             !CanHaveOtherDataBefore(EncodedDocHybridTime(min_input_hybrid_time, kMinWriteId))),
         boundary_extractor_(boundary_extractor),
+        extract_from_values_(boundary_extractor && boundary_extractor->ExtractsFromValues()),
         packed_row_(this, schema_packing_provider, retention_.history_cutoff) {
   }
 
@@ -460,6 +483,22 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
       meta->smallest.user_values = smallest_;
       meta->largest.user_values = largest_;
     }
+    // Inputs written before the hybrid time boundary was introduced don't have it, so the union of
+    // input boundaries is not enough. Always use the hybrid times of the keys that were written.
+    if (has_hybrid_time_bounds_) {
+      // Doc hybrid time is encoded in the reverse order.
+      SetUserValue(TagForHybridTime(), max_hybrid_time_.AsSlice(), &meta->smallest.user_values);
+      SetUserValue(TagForHybridTime(), min_hybrid_time_.AsSlice(), &meta->largest.user_values);
+    }
+    // Same for column bounds, inputs written without them would be missed by the union.
+    EraseColumnValues(&meta->smallest.user_values);
+    EraseColumnValues(&meta->largest.user_values);
+    if (extract_from_values_) {
+      rocksdb::UpdateUserValues(
+          column_smallest_, rocksdb::UpdateUserValueType::kSmallest, &meta->smallest.user_values);
+      rocksdb::UpdateUserValues(
+          column_largest_, rocksdb::UpdateUserValueType::kLargest, &meta->largest.user_values);
+    }
     return packed_row_.UpdateMeta(meta);
   }
 
@@ -526,9 +565,46 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
       RETURN_NOT_OK(UpdateBoundaryValues(key));
       last_passed_doc_key_serial_ = doc_key_serial;
     }
+    RETURN_NOT_OK(UpdateHybridTimeBounds(key));
+    if (extract_from_values_) {
+      RETURN_NOT_OK(UpdateColumnBounds(key, value));
+    }
     return next_feed_.Feed(key, value);
   }
 
+  // Column values differ between keys of the same document as well.
+  Status UpdateColumnBounds(const Slice& key, const Slice& value) {
+    user_values_.clear();
+    RETURN_NOT_OK(boundary_extractor_->ExtractFromValue(
+        rocksdb::ExtractUserKey(key), value, &column_value_buffer_, &user_values_));
+    rocksdb::UpdateUserValues(
+        user_values_, rocksdb::UpdateUserValueType::kSmallest, &column_smallest_);
+    rocksdb::UpdateUserValues(
+        user_values_, rocksdb::UpdateUserValueType::kLargest, &column_largest_);
+    return Status::OK();
+  }
+
+  // Unlike range components, hybrid times differ between keys of the same document, so they are
+  // tracked for every key. EncodedDocHybridTime compares by hybrid time, i.e. in the reverse order
+  // of its bytes, so min_hybrid_time_ holds the largest encoded value.
+  Status UpdateHybridTimeBounds(const Slice& key) {
+    auto user_key = rocksdb::ExtractUserKey(key);
+    if (IsInternalRecordKeyType(DecodeKeyEntryType(user_key))) {
+      return Status::OK();
+    }
+    RETURN_NOT_OK(DocHybridTime::EncodedFromEnd(user_key, &encoded_hybrid_time_));
+    if (!has_hybrid_time_bounds_) {
+      min_hybrid_time_ = encoded_hybrid_time_;
+      max_hybrid_time_ = encoded_hybrid_time_;
+      has_hybrid_time_bounds_ = true;
+    } else if (encoded_hybrid_time_ < min_hybrid_time_) {
+      min_hybrid_time_ = encoded_hybrid_time_;
+    } else if (encoded_hybrid_time_ > max_hybrid_time_) {
+      max_hybrid_time_ = encoded_hybrid_time_;
+    }
+    return Status::OK();
+  }
+
   Status UpdateBoundaryValues(const Slice& key) {
     if (!could_change_key_range_) {
       return Status::OK();
@@ -583,6 +659,7 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
   const EncodedDocHybridTime encoded_min_other_data_ht_;
   const bool could_change_key_range_;
   rocksdb::BoundaryValuesExtractor* boundary_extractor_;
+  const bool extract_from_values_;
   ValueBuffer new_value_buffer_;
 
   std::vector<char> prev_subdoc_key_;
@@ -596,6 +673,13 @@ class DocDBCompactionFeed : public rocksdb::CompactionFeed, public PackedRowFeed
   boost::container::small_vector<rocksdb::UserBoundaryValueRef, 0x10> user_values_;
   boost::container::small_vector<rocksdb::UserBoundaryValue, 0x10> smallest_;
   boost::container::small_vector<rocksdb::UserBoundaryValue, 0x10> largest_;
+  EncodedDocHybridTime encoded_hybrid_time_;
+  bool has_hybrid_time_bounds_ = false;
+  EncodedDocHybridTime min_hybrid_time_;
+  EncodedDocHybridTime max_hybrid_time_;
+  std::string column_value_buffer_;
+  boost::container::small_vector<rocksdb::UserBoundaryValue, 0x10> column_smallest_;
+  boost::container::small_vector<rocksdb::UserBoundaryValue, 0x10> column_largest_;
 
   // A stack of highest hybrid_times lower than or equal to history_cutoff_ at which parent
   // subdocuments of the key that has just been processed, or the subdocument / primitive value
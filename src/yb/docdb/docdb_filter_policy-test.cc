@@ -39,8 +39,7 @@ std::string EncodeSimpleSubDocKeyWithDifferentNonHashPart(const std::string& has
   return EncodeSubDocKey(hash_key, "another_range_key", "another_sub_key", 55555L);
 }
 
-TEST_F(DocDBFilterPolicyTest, TestKeyMatching) {
-  DocDbAwareV2FilterPolicy policy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr);
+void CheckKeyMatching(const rocksdb::FilterPolicy& policy) {
   std::string keys[] = { "foo", "bar", "test" };
   std::string absent_key = "fake";
 
@@ -67,4 +66,16 @@ TEST_F(DocDBFilterPolicyTest, TestKeyMatching) {
   ASSERT_FALSE(may_match(EncodeSimpleSubDocKey(absent_key))) << "Key: " << absent_key;
 }
 
+TEST_F(DocDBFilterPolicyTest, TestKeyMatching) {
+  ASSERT_NO_FATALS(CheckKeyMatching(
+      DocDbAwareV2FilterPolicy(rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits, nullptr)));
+}
+
+TEST_F(DocDBFilterPolicyTest, TestKeyMatchingV3Variants) {
+  constexpr auto kBits = rocksdb::FilterPolicy::kDefaultFixedSizeFilterBits;
+  ASSERT_NO_FATALS(CheckKeyMatching(DocDbAwareV3FilterPolicy(kBits, nullptr)));
+  ASSERT_NO_FATALS(CheckKeyMatching(DocDbAwareV3BlockedBloomFilterPolicy(kBits, nullptr)));
+  ASSERT_NO_FATALS(CheckKeyMatching(DocDbAwareV3RibbonFilterPolicy(kBits, nullptr)));
+}
+
 }  // namespace yb::docdb
@@ -19,10 +19,14 @@ namespace yb::docdb {
 
 class DocDbAwareFilterPolicyBase : public rocksdb::FilterPolicy {
  public:
-  explicit DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger) {
-    builtin_policy_.reset(rocksdb::NewFixedSizeFilterPolicy(
-        filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate, logger));
-  }
+  explicit DocDbAwareFilterPolicyBase(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareFilterPolicyBase(rocksdb::NewFixedSizeFilterPolicy(
+            filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+            logger)) {}
+
+  // Takes ownership of builtin_policy.
+  explicit DocDbAwareFilterPolicyBase(const rocksdb::FilterPolicy* builtin_policy)
+      : builtin_policy_(builtin_policy) {}
 
   void CreateFilter(const Slice* keys, int n, std::string* dst) const override;
 
@@ -76,6 +80,34 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const char* Name() const override { return "DocKeyV3Filter"; }
 
   const KeyTransformer* GetKeyTransformer() const override;
+
+ protected:
+  explicit DocDbAwareV3FilterPolicy(const rocksdb::FilterPolicy* builtin_policy)
+      : DocDbAwareFilterPolicyBase(builtin_policy) {}
+};
+
+// Same keys as DocDbAwareV3FilterPolicy, but stored in Ribbon filter, that uses about 25% less
+// memory for the same false positive rate.
+class DocDbAwareV3RibbonFilterPolicy : public DocDbAwareV3FilterPolicy {
+ public:
+  DocDbAwareV3RibbonFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareV3FilterPolicy(rocksdb::NewFixedSizeRibbonFilterPolicy(
+            filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+            logger)) {}
+
+  const char* Name() const override { return "DocKeyV3RibbonFilter"; }
+};
+
+// Same keys as DocDbAwareV3FilterPolicy, but stored in cache-line-blocked bloom filter, that has
+// faster lookups.
+class DocDbAwareV3BlockedBloomFilterPolicy : public DocDbAwareV3FilterPolicy {
+ public:
+  DocDbAwareV3BlockedBloomFilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
+      : DocDbAwareV3FilterPolicy(rocksdb::NewFixedSizeBlockedBloomFilterPolicy(
+            filter_block_size_bits, rocksdb::FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+            logger)) {}
+
+  const char* Name() const override { return "DocKeyV3BlockedBloomFilter"; }
 };
 
 }  // namespace yb::docdb
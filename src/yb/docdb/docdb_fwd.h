@@ -55,12 +55,14 @@ class YQLStorageIf;
 
 struct ApplyTransactionState;
 struct ColumnPackingData;
+struct ColumnValueBounds;
 struct CompactionSchemaPacking;
 struct DocDB;
 struct DocReadContext;
 struct IntentKeyValueForCDC;
 struct KeyBounds;
 struct LockBatchEntry;
+struct SeekStats;
 struct ValueControlFields;
 
 using DocKeyHash = uint16_t;
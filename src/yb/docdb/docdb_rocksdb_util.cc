@@ -39,6 +39,7 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/sst_file_manager.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
 #include "yb/rocksdb/types.h"
@@ -48,6 +49,7 @@
 
 #include "yb/util/flags.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/path_util.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
@@ -91,6 +93,20 @@ DEFINE_UNKNOWN_int32(rocksdb_universal_compaction_size_ratio, 20,
              "The percentage upto which files that are larger are include in a compaction.");
 DEFINE_UNKNOWN_uint64(rocksdb_universal_compaction_always_include_size_threshold, 64_MB,
              "Always include files of smaller or equal size in a compaction.");
+DEFINE_NON_RUNTIME_uint32(rocksdb_max_subcompactions, 1,
+    "Maximum number of threads a single compaction is split into. Subcompactions compact "
+    "disjoint ranges of documents in parallel, on threads in addition to the background "
+    "compaction threads.");
+TAG_FLAG(rocksdb_max_subcompactions, advanced);
+DEFINE_NON_RUNTIME_uint64(rocksdb_compaction_readahead_size_bytes, 0,
+    "If non-zero, compactions read their input files in chunks of this size, through table "
+    "readers separate from the ones used by foreground reads.");
+TAG_FLAG(rocksdb_compaction_readahead_size_bytes, advanced);
+DEFINE_NON_RUNTIME_bool(rocksdb_compaction_drop_os_cache, false,
+    "Whether compactions drop the pages of the files they write from the OS page cache once "
+    "their writeback was started, so compaction output does not evict data used by foreground "
+    "reads.");
+TAG_FLAG(rocksdb_compaction_drop_os_cache, advanced);
 DEFINE_UNKNOWN_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_UNKNOWN_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 1_GB,
@@ -100,6 +116,18 @@ DEFINE_UNKNOWN_string(rocksdb_compact_flush_rate_limit_sharing_mode, "tserver",
               "  tserver - rate limit is shared across all RocksDB instances"
               " at tabset server level\n"
               "  none - rate limit is calculated independently for every RocksDB instance");
+DEFINE_NON_RUNTIME_int32(rocksdb_max_open_files_per_tserver, 0,
+    "Maximal number of SST files kept open by all RocksDB instances of the tablet server. Open "
+    "table readers are kept in one cache for the whole server, and the least recently used ones "
+    "are closed when there are more. 0 - every RocksDB instance has its own cache of open files.");
+DEFINE_NON_RUNTIME_int32(rocksdb_table_cache_num_shard_bits, 6,
+    "Number of shard bits of the table cache shared by RocksDB instances, used when "
+    "rocksdb_max_open_files_per_tserver is set.");
+DEFINE_NON_RUNTIME_int64(rocksdb_sst_delete_rate_bytes_per_sec, 0,
+    "Rate at which obsolete SST files of all RocksDB instances on one data drive are deleted. "
+    "Files are moved to a trash directory on the same drive and removed in the background, so "
+    "that dropping the inputs of a large compaction or a deleted table does not stall the drive. "
+    "0 - files are deleted right away.");
 DEFINE_UNKNOWN_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
 DEFINE_UNKNOWN_uint64(rocksdb_max_file_size_for_compaction, 0,
@@ -127,6 +155,10 @@ DEFINE_UNKNOWN_int32(memstore_size_mb, 128,
 
 DEFINE_UNKNOWN_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_NON_RUNTIME_string(docdb_bloom_filter_type, "bloom",
+    "Type of DocDB aware filter used for newly written SST files. Possible options: bloom, "
+    "blocked_bloom, ribbon. Files written with any of them remain readable.");
+TAG_FLAG(docdb_bloom_filter_type, advanced);
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_UNKNOWN_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -142,6 +174,11 @@ DEFINE_RUNTIME_AUTO_string(regular_tablets_data_block_key_value_encoding, kExter
 
 DEFINE_UNKNOWN_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
+DEFINE_NON_RUNTIME_uint64(rocksdb_max_manifest_file_size, 16_MB,
+    "Size of the RocksDB MANIFEST file after which it is replaced by a new file that starts with "
+    "the current state of the DB. Keeps the time to open a long-lived tablet bounded. "
+    "0 - the MANIFEST is only replaced when the DB is opened.");
+
 DEFINE_UNKNOWN_int32(num_reserved_small_compaction_threads, -1,
     "Number of reserved small compaction "
     "threads. It allows splitting small vs. large compactions.");
@@ -225,6 +262,14 @@ bool CompressionTypeValidator(const char* flagname, const std::string& flag_comp
   return true;
 }
 
+bool DocDbBloomFilterTypeValidator(const char* flag_name, const std::string& flag_value) {
+  if (flag_value == "bloom" || flag_value == "blocked_bloom" || flag_value == "ribbon") {
+    return true;
+  }
+  LOG(ERROR) << flag_name << ": invalid value " << flag_value;
+  return false;
+}
+
 bool KeyValueEncodingFormatValidator(const char* flag_name, const std::string& flag_value) {
   auto res = yb::docdb::GetConfiguredKeyValueEncodingFormat(flag_value);
   bool ok = res.ok();
@@ -238,6 +283,7 @@ bool KeyValueEncodingFormatValidator(const char* flag_name, const std::string& f
 
 DEFINE_validator(compression_type, &CompressionTypeValidator);
 DEFINE_validator(regular_tablets_data_block_key_value_encoding, &KeyValueEncodingFormatValidator);
+DEFINE_validator(docdb_bloom_filter_type, &DocDbBloomFilterTypeValidator);
 
 using std::shared_ptr;
 using std::string;
@@ -272,8 +318,12 @@ void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter) {
 }
 
 SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key) {
+  return SeekPossiblyUsingNext(iter, seek_key, FLAGS_max_nexts_to_avoid_seek);
+}
+
+SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key, int max_nexts) {
   SeekStats result;
-  for (int nexts = FLAGS_max_nexts_to_avoid_seek; nexts-- > 0;) {
+  for (int nexts = max_nexts; nexts-- > 0;) {
     if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
       VTRACE(3, "Did $0 Next(s) instead of a Seek", result.next);
       return result;
@@ -284,7 +334,7 @@ SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key)
     ++result.next;
   }
 
-  VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", FLAGS_max_nexts_to_avoid_seek);
+  VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", max_nexts);
   iter->Seek(seek_key);
   ++result.seek;
   return result;
@@ -295,6 +345,15 @@ void PerformRocksDBSeek(
     const rocksdb::Slice &seek_key,
     const char* file_name,
     int line) {
+  PerformRocksDBSeek(iter, seek_key, FLAGS_max_nexts_to_avoid_seek, file_name, line);
+}
+
+SeekStats PerformRocksDBSeek(
+    rocksdb::Iterator *iter,
+    const rocksdb::Slice &seek_key,
+    int max_nexts,
+    const char* file_name,
+    int line) {
   SeekStats stats;
   if (seek_key.size() == 0) {
     iter->SeekToFirst();
@@ -303,7 +362,7 @@ void PerformRocksDBSeek(
     iter->Seek(seek_key);
     ++stats.seek;
   } else {
-    stats = SeekPossiblyUsingNext(iter, seek_key);
+    stats = SeekPossiblyUsingNext(iter, seek_key, max_nexts);
   }
   VLOG(4) << Substitute(
       "PerformRocksDBSeek at $0:$1:\n"
@@ -322,6 +381,7 @@ void PerformRocksDBSeek(
       iter->Valid() ? FormatSliceAsStr(iter->value()) : "N/A",
       stats.next,
       stats.seek);
+  return stats;
 }
 
 namespace {
@@ -617,6 +677,9 @@ void InitRocksDBOptions(
   options->statistics = statistics;
   options->info_log_level = YBRocksDBLogger::ConvertToRocksDBLogLevel(FLAGS_minloglevel);
   options->initial_seqno = FLAGS_initial_seqno;
+  if (FLAGS_rocksdb_max_manifest_file_size > 0) {
+    options->max_manifest_file_size = FLAGS_rocksdb_max_manifest_file_size;
+  }
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
   options->compaction_measure_io_stats = FLAGS_rocksdb_compaction_measure_io_stats;
   options->memory_monitor = tablet_options.memory_monitor;
@@ -642,11 +705,20 @@ void InitRocksDBOptions(
       options->listeners.end(), tablet_options.listeners.begin(),
       tablet_options.listeners.end()); // Append listeners
 
+  options->table_cache = tablet_options.table_cache;
+  auto sst_file_manager_it = tablet_options.sst_file_managers.find(group_no);
+  if (sst_file_manager_it != tablet_options.sst_file_managers.end()) {
+    options->sst_file_manager = sst_file_manager_it->second;
+  }
+
   // Set block cache options.
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    // Keep top level index and filter index of frequently used tables in cache, while their
+    // partitions compete with data blocks.
+    table_options.cache_top_level_index_and_filter_with_high_priority = true;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -657,14 +729,34 @@ void InitRocksDBOptions(
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
     const auto filter_block_size_bits = table_options.filter_block_size * 8;
-    table_options.filter_policy = std::make_shared<const DocDbAwareV3FilterPolicy>(
-        filter_block_size_bits, options->info_log.get());
+    auto* logger = options->info_log.get();
     table_options.supported_filter_policies =
         std::make_shared<rocksdb::BlockBasedTableOptions::FilterPoliciesMap>();
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareHashedComponentsFilterPolicy>(
-            filter_block_size_bits, options->info_log.get()), &table_options);
+            filter_block_size_bits, logger), &table_options);
     AddSupportedFilterPolicy(std::make_shared<const DocDbAwareV2FilterPolicy>(
-            filter_block_size_bits, options->info_log.get()), &table_options);
+            filter_block_size_bits, logger), &table_options);
+
+    // All V3 filter variants are supported for reading, so docdb_bloom_filter_type could be
+    // changed without losing filters of existing files.
+    using FilterPolicyPtr = rocksdb::BlockBasedTableOptions::FilterPolicyPtr;
+    FilterPolicyPtr bloom_policy =
+        std::make_shared<const DocDbAwareV3FilterPolicy>(filter_block_size_bits, logger);
+    FilterPolicyPtr blocked_bloom_policy =
+        std::make_shared<const DocDbAwareV3BlockedBloomFilterPolicy>(
+            filter_block_size_bits, logger);
+    FilterPolicyPtr ribbon_policy =
+        std::make_shared<const DocDbAwareV3RibbonFilterPolicy>(filter_block_size_bits, logger);
+    for (const auto& policy : {bloom_policy, blocked_bloom_policy, ribbon_policy}) {
+      AddSupportedFilterPolicy(policy, &table_options);
+    }
+    if (FLAGS_docdb_bloom_filter_type == "ribbon") {
+      table_options.filter_policy = ribbon_policy;
+    } else if (FLAGS_docdb_bloom_filter_type == "blocked_bloom") {
+      table_options.filter_policy = blocked_bloom_policy;
+    } else {
+      table_options.filter_policy = bloom_policy;
+    }
   }
 
   if (FLAGS_use_multi_level_index) {
@@ -687,6 +779,16 @@ void InitRocksDBOptions(
 
   AutoInitFromRocksDBFlags(options);
   if (compactions_enabled) {
+    options->max_subcompactions = FLAGS_rocksdb_max_subcompactions;
+    options->compaction_readahead_size = FLAGS_rocksdb_compaction_readahead_size_bytes;
+    options->compaction_drop_os_cache = FLAGS_rocksdb_compaction_drop_os_cache;
+    // All records of a document have to be seen by the same compaction feed, so subcompactions
+    // are split at whole doc key boundaries. Keys that are not in DocKey format, such as intents
+    // DB reverse index keys, are not used as boundaries.
+    options->subcompaction_boundary_extractor = [](Slice user_key) {
+      auto size_result = DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey);
+      return size_result.ok() ? user_key.Prefix(*size_result) : Slice();
+    };
     options->level0_file_num_compaction_trigger = FLAGS_rocksdb_level0_file_num_compaction_trigger;
     options->level0_slowdown_writes_trigger = max_if_negative(
         FLAGS_rocksdb_level0_slowdown_writes_trigger);
@@ -998,6 +1100,35 @@ std::shared_ptr<rocksdb::RateLimiter> CreateRocksDBRateLimiter() {
   return nullptr;
 }
 
+std::shared_ptr<rocksdb::Cache> CreateSharedRocksDBTableCache() {
+  if (FLAGS_rocksdb_max_open_files_per_tserver <= 0) {
+    return nullptr;
+  }
+  return rocksdb::NewLRUCache(
+      FLAGS_rocksdb_max_open_files_per_tserver, FLAGS_rocksdb_table_cache_num_shard_bits);
+}
+
+Result<std::shared_ptr<rocksdb::SstFileManager>> CreateRocksDBSstFileManager(
+    rocksdb::Env* env, const std::string& data_root) {
+  auto trash_dir = JoinPathSegments(data_root, kRocksDBTrashDirName);
+  if (FLAGS_rocksdb_sst_delete_rate_bytes_per_sec <= 0) {
+    // Files left in the trash while deletion was throttled are not tracked by anybody else.
+    if (env->FileExists(trash_dir).ok()) {
+      std::vector<std::string> files;
+      RETURN_NOT_OK(env->GetChildren(trash_dir, &files));
+      for (const auto& file : files) {
+        if (file != "." && file != "..") {
+          RETURN_NOT_OK(env->DeleteFile(JoinPathSegments(trash_dir, file)));
+        }
+      }
+    }
+    return nullptr;
+  }
+  return std::shared_ptr<rocksdb::SstFileManager>(VERIFY_RESULT(rocksdb::NewSstFileManager(
+      env, /* info_log= */ nullptr, trash_dir, FLAGS_rocksdb_sst_delete_rate_bytes_per_sec,
+      /* delete_exisitng_trash= */ true)));
+}
+
 void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
     return;
@@ -48,6 +48,9 @@ struct SeekStats {
 // Seek forward using Next call.
 SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key);
 
+// Seek forward using up to max_nexts Next calls.
+SeekStats SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key, int max_nexts);
+
 // When we replace HybridTime::kMin in the end of seek key, next seek will skip older versions of
 // this key, but will not skip any subkeys in its subtree. If the iterator is already positioned far
 // enough, does not perform a seek.
@@ -69,6 +72,14 @@ void PerformRocksDBSeek(
     const char* file_name,
     int line);
 
+// Same as above, but uses up to max_nexts Next() calls instead of the configured number.
+SeekStats PerformRocksDBSeek(
+    rocksdb::Iterator *iter,
+    const rocksdb::Slice &seek_key,
+    int max_nexts,
+    const char* file_name,
+    int line);
+
 // TODO: is there too much overhead in passing file name and line here in release mode?
 #define ROCKSDB_SEEK(iter, key) \
   do { \
@@ -135,6 +146,18 @@ RateLimiterSharingMode GetRocksDBRateLimiterSharingMode();
 // calls `rocksdb::NewGenericRateLimiter` internally
 std::shared_ptr<rocksdb::RateLimiter> CreateRocksDBRateLimiter();
 
+// Creates the cache of open table readers shared by all RocksDB instances of the tablet server.
+// Returns nullptr when every instance should have its own cache.
+std::shared_ptr<rocksdb::Cache> CreateSharedRocksDBTableCache();
+
+// Name of the directory under a data root, where obsolete SST files wait for deletion.
+constexpr const char* kRocksDBTrashDirName = "rocksdb_trash";
+
+// Creates the manager that paces deletion of obsolete SST files of all RocksDB instances under
+// 'data_root'. Returns nullptr when files should be deleted right away.
+Result<std::shared_ptr<rocksdb::SstFileManager>> CreateRocksDBSstFileManager(
+    rocksdb::Env* env, const std::string& data_root);
+
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
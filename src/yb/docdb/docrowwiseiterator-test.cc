@@ -40,6 +40,8 @@
 using std::string;
 
 DECLARE_bool(TEST_docdb_sort_weak_intents);
+DECLARE_bool(docdb_scan_skip_files_newer_than_read_time);
+DECLARE_bool(skip_intent_seeks_without_intents);
 
 namespace yb {
 namespace docdb {
@@ -145,6 +147,7 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void TestDocRowwiseIteratorHasNextIdempotence();
   void TestDocRowwiseIteratorIncompleteProjection();
   void TestColocatedTableTombstone();
+  void TestColocatedTablesInSeparateFiles();
   void TestDocRowwiseIteratorMultipleDeletes();
   void TestDocRowwiseIteratorValidColumnNotInProjection();
   void TestDocRowwiseIteratorKeyProjection();
@@ -152,11 +155,15 @@ class DocRowwiseIteratorTest : public DocDBTestBase {
   void TestIntentAwareIteratorSeek();
   void TestSeekTwiceWithinTheSameTxn();
   void TestScanWithinTheSameTxn();
+  void TestScanWithSparseIntents();
+  void TestScanSkipsFilesNewerThanReadTime();
   void TestLargeKeys();
   void TestPackedRow();
+  void TestPackedRowWithNullColumns();
   // Restore doesn't use delete tombstones for rows, instead marks all columns
   // as deleted.
   void TestDeletedDocumentUsingLivenessColumnDelete();
+  void TestSeekTupleInSortedOrder();
 };
 
 const std::string kStrKey1 = "row1";
@@ -1623,6 +1630,39 @@ SubDocKey(DocKey(ColocationId=16385, [], ["row1", 11111]), [SystemColumnId(0); \
   }
 }
 
+void DocRowwiseIteratorTest::TestColocatedTablesInSeparateFiles() {
+  constexpr ColocationId kColocationId1(0x4001);
+  constexpr ColocationId kColocationId2(0x4002);
+  auto dwb = MakeDocWriteBatch();
+
+  for (auto colocation_id : {kColocationId1, kColocationId2}) {
+    DocKey doc_key;
+    ASSERT_OK(doc_key.FullyDecodeFrom(kEncodedDocKey1));
+    doc_key.set_colocation_id(colocation_id);
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(doc_key.Encode(), KeyEntryValue::kLivenessColumn),
+        ValueRef(ValueEntryType::kNullLow)));
+    ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+    FlushRocksDB();
+  }
+
+  // The table tombstone is stored before the rows of the table, in a file of its own.
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(DocKey(kColocationId1).Encode())));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(2000)));
+  FlushRocksDB();
+
+  Schema projection;
+  for (auto colocation_id : {kColocationId1, kColocationId2}) {
+    Schema schema_copy = kSchemaForIteratorTests;
+    schema_copy.set_colocation_id(colocation_id);
+    auto doc_read_context = DocReadContext::TEST_Create(schema_copy);
+    auto iter = ASSERT_RESULT(CreateIterator(
+        projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max(), nullptr));
+    ASSERT_EQ(ASSERT_RESULT(iter->HasNext()), colocation_id == kColocationId2);
+  }
+}
+
 void DocRowwiseIteratorTest::TestDocRowwiseIteratorMultipleDeletes() {
   auto dwb = MakeDocWriteBatch();
 
@@ -2247,6 +2287,117 @@ void DocRowwiseIteratorTest::TestScanWithinTheSameTxn() {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 3);
 }
 
+void DocRowwiseIteratorTest::TestScanWithSparseIntents() {
+  google::FlagSaver flag_saver;
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+
+  TransactionStatusManagerMock txn_status_manager;
+
+  constexpr int kNumRows = 10;
+  auto doc_key = [](int i) {
+    return DocKey(KeyEntryValues(Format("row$0", i), i)).Encode();
+  };
+  for (int i = 0; i != kNumRows; ++i) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key(i), KeyEntryValue::MakeColumnId(40_ColId)),
+        QLValue::PrimitiveInt64(i), HybridTime::FromMicros(1000)));
+  }
+
+  // Only two rows, far from each other, have committed but not applied intents.
+  auto txn = ASSERT_RESULT(FullyDecodeTransactionId("0000000000000001"));
+  SetCurrentTransactionId(txn);
+  for (int i : {2, 7}) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(doc_key(i), KeyEntryValue::MakeColumnId(40_ColId)),
+        QLValue::PrimitiveInt64(i * 100), HybridTime::FromMicros(500)));
+  }
+  ResetCurrentTransactionId();
+  txn_status_manager.Commit(txn, HybridTime::FromMicros(1500));
+
+  const Schema &projection = kProjectionForIteratorTests;
+  const auto txn_context = TransactionOperationContext(
+      TransactionId::GenerateRandom(), &txn_status_manager);
+  auto doc_read_context = DocReadContext::TEST_Create(kSchemaForIteratorTests);
+
+  for (bool skip_intent_seeks : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_skip_intent_seeks_without_intents) = skip_intent_seeks;
+    auto iter = ASSERT_RESULT(CreateIterator(
+        projection, doc_read_context, txn_context, doc_db(), CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::FromMicros(2000)));
+
+    QLTableRow row;
+    QLValue value;
+    for (int i = 0; i != kNumRows; ++i) {
+      ASSERT_TRUE(ASSERT_RESULT(iter->HasNext()));
+      ASSERT_OK(iter->NextRow(&row));
+      ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+      ASSERT_FALSE(value.IsNull());
+      ASSERT_EQ(i == 2 || i == 7 ? i * 100 : i, value.int64_value())
+          << "Row: " << i << ", skip_intent_seeks: " << skip_intent_seeks;
+    }
+    ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+  }
+}
+
+void DocRowwiseIteratorTest::TestScanSkipsFilesNewerThanReadTime() {
+  google::FlagSaver flag_saver;
+
+  constexpr int kNumRows = 5;
+  auto doc_key = [](int i) {
+    return DocKey(KeyEntryValues(Format("row$0", i), i)).Encode();
+  };
+  auto write_rows = [this, &doc_key](int version, int64_t micros) {
+    for (int i = 0; i != kNumRows; ++i) {
+      ASSERT_OK(SetPrimitive(
+          DocPath(doc_key(i), KeyEntryValue::MakeColumnId(40_ColId)),
+          QLValue::PrimitiveInt64(version * 100 + i), HybridTime::FromMicros(micros)));
+    }
+    ASSERT_OK(FlushRocksDbAndWait());
+  };
+
+  // After the compaction a single file has records both before and after the read times below,
+  // so it must be read.
+  ASSERT_NO_FATALS(write_rows(1, 1000));
+  ASSERT_NO_FATALS(write_rows(2, 3000));
+  ASSERT_OK(FullyCompactDB(rocksdb()));
+  // This file has only records after the read times below, and could be skipped.
+  ASSERT_NO_FATALS(write_rows(3, 4000));
+
+  const Schema &projection = kProjectionForIteratorTests;
+  auto doc_read_context = DocReadContext::TEST_Create(kSchemaForIteratorTests);
+  // Version 0 means that no rows are visible.
+  const std::vector<std::pair<ReadHybridTime, int>> reads = {
+      {ReadHybridTime::FromMicros(500), 0},
+      {ReadHybridTime::FromMicros(1000), 1},
+      {ReadHybridTime::FromMicros(2000), 1},
+      {ReadHybridTime::FromMicros(3500), 2},
+      {ReadHybridTime::Max(), 3},
+  };
+
+  for (bool skip_files : {false, true}) {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_docdb_scan_skip_files_newer_than_read_time) = skip_files;
+    for (const auto& [read_time, version] : reads) {
+      SCOPED_TRACE(Format("Read time: $0, skip files: $1", read_time, skip_files));
+      auto iter = ASSERT_RESULT(CreateIterator(
+          projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+          CoarseTimePoint::max() /* deadline */, read_time));
+      if (version == 0) {
+        ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+        continue;
+      }
+      QLTableRow row;
+      QLValue value;
+      for (int i = 0; i != kNumRows; ++i) {
+        ASSERT_TRUE(ASSERT_RESULT(iter->HasNext()));
+        ASSERT_OK(iter->NextRow(&row));
+        ASSERT_OK(row.GetValue(projection.column_id(1), &value));
+        ASSERT_EQ(version * 100 + i, value.int64_value());
+      }
+      ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+    }
+  }
+}
+
 void DocRowwiseIteratorTest::TestLargeKeys() {
   constexpr size_t str_key_size = 0x100;
   auto str_key = RandomString(str_key_size);
@@ -2384,6 +2535,58 @@ void DocRowwiseIteratorTest::TestPackedRow() {
   }
 }
 
+// Packed row without non-null values should be found through the liveness column.
+void DocRowwiseIteratorTest::TestPackedRowWithNullColumns() {
+  constexpr int kVersion = 1;
+  const Schema &schema = kSchemaForIteratorTests;
+  SchemaPacking schema_packing(schema);
+
+  {
+    RowPacker packer(
+        kVersion, schema_packing, /* packed_size_limit= */ std::numeric_limits<int64_t>::max(),
+        /* value_control_fields= */ Slice());
+    auto packed_row = ASSERT_RESULT(packer.Complete());
+    LOG(INFO) << "Row1 Packed: " << packed_row.ToDebugHexString();
+
+    ASSERT_OK(SetPrimitive(
+        DocPath(kEncodedDocKey1),
+        ValueControlFields(),
+        ValueRef(packed_row),
+        HybridTime::FromMicros(1000)));
+  }
+
+  SchemaPackingStorage schema_packing_storage;
+  schema_packing_storage.AddSchema(kVersion, schema);
+
+  DocDBDebugDumpToConsole(schema_packing_storage);
+
+  auto doc_read_context = DocReadContext::TEST_Create(schema);
+
+  Schema key_projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"a", "b"}, &key_projection));
+
+  for (const Schema* projection : {&kProjectionForIteratorTests, &key_projection}) {
+    auto iter = ASSERT_RESULT(CreateIterator(
+        *projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000)));
+
+    QLTableRow row;
+    QLValue value;
+    ASSERT_TRUE(ASSERT_RESULT(iter->HasNext()));
+    ASSERT_OK(iter->NextRow(&row));
+
+    for (size_t i = 0; i != projection->num_columns(); ++i) {
+      if (projection->is_key_column(i)) {
+        continue;
+      }
+      ASSERT_OK(row.GetValue(projection->column_id(i), &value));
+      ASSERT_TRUE(value.IsNull());
+    }
+
+    ASSERT_FALSE(ASSERT_RESULT(iter->HasNext()));
+  }
+}
+
 void DocRowwiseIteratorTest::TestDeletedDocumentUsingLivenessColumnDelete() {
   // Row 1
   // We don't need any seeks for writes, where column values are primitives.
@@ -2490,6 +2693,40 @@ void DocRowwiseIteratorTest::TestDeletedDocumentUsingLivenessColumnDelete() {
   }
 }
 
+void DocRowwiseIteratorTest::TestSeekTupleInSortedOrder() {
+  SetupDocRowwiseIteratorData();
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+  QLTableRow row;
+  QLValue value;
+  auto doc_read_context = DocReadContext::TEST_Create(schema);
+
+  // Single iterator is used to look up multiple tuples in increasing order, as it is done for
+  // batched ybctid reads.
+  auto iter = ASSERT_RESULT(CreateIterator(
+      projection, doc_read_context, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(5000)));
+
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTuple(kEncodedDocKey1)));
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(projection.column_id(0), &value));
+  ASSERT_EQ("row1_c", value.string_value());
+
+  // Missing tuple between existing ones.
+  const auto missing_key = DocKey(KeyEntryValues(kStrKey1, kIntKey2)).Encode();
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTuple(missing_key)));
+
+  ASSERT_TRUE(ASSERT_RESULT(iter->SeekTuple(kEncodedDocKey2)));
+  ASSERT_OK(iter->NextRow(&row));
+  ASSERT_OK(row.GetValue(projection.column_id(2), &value));
+  ASSERT_EQ("row2_e_prime", value.string_value());
+
+  // Missing tuple after the last one.
+  const auto key_after_last = DocKey(KeyEntryValues("row3", kIntKey1)).Encode();
+  ASSERT_FALSE(ASSERT_RESULT(iter->SeekTuple(key_after_last)));
+}
+
 TEST_F(DocRowwiseIteratorTest, ClusteredFilterTestRange) {
     TestClusteredFilterRange();
 }
@@ -2554,6 +2791,10 @@ TEST_F(DocRowwiseIteratorTest, ColocatedTableTombstoneTest) {
     TestColocatedTableTombstone();
 }
 
+TEST_F(DocRowwiseIteratorTest, ColocatedTablesInSeparateFiles) {
+    TestColocatedTablesInSeparateFiles();
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorMultipleDeletes) {
     TestDocRowwiseIteratorMultipleDeletes();
 }
@@ -2582,6 +2823,14 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
     TestScanWithinTheSameTxn();
 }
 
+TEST_F(DocRowwiseIteratorTest, ScanWithSparseIntents) {
+    TestScanWithSparseIntents();
+}
+
+TEST_F(DocRowwiseIteratorTest, ScanSkipsFilesNewerThanReadTime) {
+    TestScanSkipsFilesNewerThanReadTime();
+}
+
 TEST_F(DocRowwiseIteratorTest, LargeKeysTest) {
     TestLargeKeys();
 }
@@ -2590,9 +2839,17 @@ TEST_F(DocRowwiseIteratorTest, BasicPackedRowTest) {
     TestPackedRow();
 }
 
+TEST_F(DocRowwiseIteratorTest, PackedRowWithNullColumnsTest) {
+    TestPackedRowWithNullColumns();
+}
+
 TEST_F(DocRowwiseIteratorTest, DeletedDocumentUsingLivenessColumnDeleteTest) {
     TestDeletedDocumentUsingLivenessColumnDelete();
 }
 
+TEST_F(DocRowwiseIteratorTest, SeekTupleInSortedOrder) {
+    TestSeekTupleInSortedOrder();
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -35,6 +35,7 @@
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/debug-util.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
@@ -42,6 +43,13 @@
 
 using namespace std::literals;
 
+DEFINE_RUNTIME_bool(skip_intent_seeks_without_intents, false,
+    "Remember where the closest intent after a seek is, so that IntentAwareIterator does not "
+    "reposition the intents iterator on seeks in key ranges without intents.");
+TAG_FLAG(skip_intent_seeks_without_intents, advanced);
+
+DECLARE_int32(max_nexts_to_avoid_seek);
+
 namespace yb {
 namespace docdb {
 
@@ -111,7 +119,8 @@ IntentAwareIterator::IntentAwareIterator(
           read_time_.local_limit > read_time_.read ? Slice(encoded_read_time_local_limit_)
                                                    : Slice(encoded_read_time_read_)),
       txn_op_context_(txn_op_context),
-      transaction_status_cache_(txn_op_context_, read_time, deadline) {
+      transaction_status_cache_(txn_op_context_, read_time, deadline),
+      skip_intent_seeks_(FLAGS_skip_intent_seeks_without_intents) {
   VTRACE(1, __func__);
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txn_op_context: " << txn_op_context_;
@@ -146,15 +155,19 @@ void IntentAwareIterator::Seek(const DocKey &doc_key) {
 }
 
 void IntentAwareIterator::Seek(const Slice& key) {
-  VLOG(4) << "Seek(" << SubDocKey::DebugSliceToString(key) << ")";
+  SeekWithNextsLimit(key, FLAGS_max_nexts_to_avoid_seek);
+}
+
+SeekStats IntentAwareIterator::SeekWithNextsLimit(const Slice& key, int max_nexts) {
+  VLOG(4) << "Seek(" << SubDocKey::DebugSliceToString(key) << ", " << max_nexts << ")";
   DOCDB_DEBUG_SCOPE_LOG(
       key.ToDebugString(),
       std::bind(&IntentAwareIterator::DebugDump, this));
   if (!status_.ok()) {
-    return;
+    return SeekStats();
   }
 
-  ROCKSDB_SEEK(&iter_, key);
+  auto stats = PerformRocksDBSeek(&iter_, key, max_nexts, __FILE__, __LINE__);
   skip_future_records_needed_ = true;
 
   if (intent_iter_.Initialized()) {
@@ -162,6 +175,7 @@ void IntentAwareIterator::Seek(const Slice& key) {
     GetIntentPrefixForKeyWithoutHt(key, &seek_key_buffer_);
     AppendStrongWrite(&seek_key_buffer_);
   }
+  return stats;
 }
 
 void IntentAwareIterator::SeekForward(const Slice& key) {
@@ -267,6 +281,7 @@ void IntentAwareIterator::SeekToLastDocKey() {
   iter_.SeekToLast();
   SkipFutureRecords(Direction::kBackward);
   if (intent_iter_.Initialized()) {
+    intents_probed_ = false;
     ResetIntentUpperbound();
     intent_iter_.SeekToLast();
     SeekToSuitableIntent<Direction::kBackward>();
@@ -356,6 +371,7 @@ bool IntentAwareIterator::PreparePrev(const Slice& key) {
   SkipFutureRecords(Direction::kBackward);
 
   if (intent_iter_.Initialized()) {
+    intents_probed_ = false;
     ResetIntentUpperbound();
     ROCKSDB_SEEK(&intent_iter_, GetIntentPrefixForKeyWithoutHt(key));
     if (intent_iter_.Valid()) {
@@ -428,6 +444,30 @@ void IntentAwareIterator::SeekIntentIterIfNeeded() {
   if (!status_.ok()) {
     return;
   }
+  if (skip_intent_seeks_) {
+    if (NoIntentsBeforeUpperbound(seek_key_buffer_.AsSlice())) {
+      VLOG(4) << __func__ << ", no intents before upperbound: "
+              << SubDocKey::DebugSliceToString(seek_key_buffer_);
+      // Keep already resolved intent after seek_key_prefix_ like SeekForwardToSuitableIntent does.
+      if (seek_intent_iter_needed_ == SeekIntentIterNeeded::kSeek ||
+          resolved_intent_state_ == ResolvedIntentState::kNoIntent ||
+          resolved_intent_key_prefix_.CompareTo(seek_key_prefix_) < 0) {
+        resolved_intent_state_ = ResolvedIntentState::kNoIntent;
+        resolved_intent_txn_dht_ = DocHybridTime::kMin;
+        intent_dht_from_same_txn_ = DocHybridTime::kMin;
+      }
+      seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
+      return;
+    }
+    if (seek_intent_iter_needed_ == SeekIntentIterNeeded::kSeek) {
+      ProbeIntents();
+      if (status_.ok()) {
+        SeekToSuitableIntent<Direction::kForward>();
+      }
+      seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
+      return;
+    }
+  }
   switch (seek_intent_iter_needed_) {
     case SeekIntentIterNeeded::kNoNeed:
       break;
@@ -445,6 +485,43 @@ void IntentAwareIterator::SeekIntentIterIfNeeded() {
   FATAL_INVALID_ENUM_VALUE(SeekIntentIterNeeded, seek_intent_iter_needed_);
 }
 
+void IntentAwareIterator::ProbeIntents() {
+  if (!upperbound_.empty()) {
+    intent_upperbound_keybytes_.Clear();
+    intent_upperbound_keybytes_.AppendRawBytes(upperbound_);
+    intent_upperbound_keybytes_.AppendKeyEntryType(KeyEntryType::kMaxByte);
+    intent_upperbound_ = intent_upperbound_keybytes_.AsSlice();
+    intent_iter_.RevalidateAfterUpperBoundChange();
+  }
+  VLOG(4) << __func__ << ", seek: " << SubDocKey::DebugSliceToString(seek_key_buffer_)
+          << ", upperbound: " << intent_upperbound_.ToDebugString();
+  ROCKSDB_SEEK(&intent_iter_, seek_key_buffer_);
+  // Transaction metadata and reverse index are not intents of any key.
+  while (intent_iter_.Valid() && intent_iter_.key()[0] == KeyEntryTypeAsChar::kTransactionId) {
+    static const std::array<char, 1> kAfterTransactionId{KeyEntryTypeAsChar::kTransactionId + 1};
+    intent_iter_.Seek(Slice(kAfterTransactionId));
+  }
+
+  intents_probe_start_.Reset(seek_key_buffer_.AsSlice());
+  intents_free_until_.Reset(intent_iter_.Valid() ? intent_iter_.key() : intent_upperbound_);
+  intents_probed_ = true;
+  VLOG(4) << __func__ << ", no intents until: " << intents_free_until_.AsSlice().ToDebugString();
+
+  if (!upperbound_.empty()) {
+    status_ = SetIntentUpperbound();
+  }
+}
+
+bool IntentAwareIterator::NoIntentsBeforeUpperbound(const Slice& key) const {
+  if (!intents_probed_ || key.compare(intents_probe_start_.AsSlice()) < 0) {
+    return false;
+  }
+  auto free_until = intents_free_until_.AsSlice();
+  // Intents after upperbound_ are ignored by SatisfyBounds.
+  return free_until.compare(intent_upperbound_) >= 0 ||
+         (!upperbound_.empty() && free_until.compare(upperbound_) > 0);
+}
+
 bool IntentAwareIterator::valid() {
   if (skip_future_records_needed_) {
     SkipFutureRecords(Direction::kForward);
@@ -72,6 +72,8 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
   // hybrid time).
   void Seek(const Slice& key) override;
 
+  SeekStats SeekWithNextsLimit(const Slice& key, int max_nexts) override;
+
   // Seek forward to specified encoded key (it is responsibility of caller to make sure it
   // doesn't have hybrid time). For efficiency, the method that takes a non-const KeyBytes pointer
   // avoids memory allocation by using the KeyBytes buffer to prepare the key to seek to, and may
@@ -201,6 +203,14 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
   template<Direction direction>
   void SeekToSuitableIntent();
 
+  // Seeks intent sub-iterator to seek_key_buffer_, bounded by upperbound_ instead of the current
+  // regular key when it is set, and remembers how far there are no intents after the seek key.
+  void ProbeIntents();
+
+  // Returns true when it is known from the last probe that there are no intents between key and
+  // the intent upperbound, so the intent sub-iterator does not have to be positioned.
+  bool NoIntentsBeforeUpperbound(const Slice& key) const;
+
   // Decodes intent at intent_iter_ position and updates resolved_intent_* fields if that intent
   // matches all following conditions:
   // 1. It is strong write intent.
@@ -318,6 +328,14 @@ class IntentAwareIterator : public IntentAwareIteratorIf {
   // Reusable buffer to prepare seek key to avoid reallocating temporary buffers in critical paths.
   KeyBytes seek_key_buffer_;
   Slice seek_key_prefix_;
+
+  // There are no intents in [intents_probe_start_, intents_free_until_) in the snapshot of
+  // intent_iter_, valid while intents_probed_ is set. Forward seeks in this range do not touch
+  // intent_iter_.
+  const bool skip_intent_seeks_;
+  bool intents_probed_ = false;
+  KeyBytes intents_probe_start_;
+  KeyBytes intents_free_until_;
 };
 
 class NODISCARD_CLASS IntentAwareIteratorPrefixScope {
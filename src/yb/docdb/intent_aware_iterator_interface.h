@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include "yb/docdb/docdb_fwd.h"
+
 #include "yb/util/slice.h"
 
 namespace yb {
@@ -39,6 +41,10 @@ class IntentAwareIteratorIf {
   // hybrid time).
   virtual void Seek(const Slice& key) = 0;
 
+  // Same as Seek, but when the iterator is positioned before the key, tries up to max_nexts Next
+  // calls before resorting to an actual seek. Returns number of performed Next and Seek calls.
+  virtual SeekStats SeekWithNextsLimit(const Slice& key, int max_nexts) = 0;
+
   // Seek forward to specified encoded key (it is responsibility of caller to make sure it
   // doesn't have hybrid time). For efficiency, the method that takes a non-const KeyBytes pointer
   // avoids memory allocation by using the KeyBytes buffer to prepare the key to seek to, and may
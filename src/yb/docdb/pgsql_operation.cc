@@ -14,6 +14,7 @@
 #include "yb/docdb/pgsql_operation.h"
 
 #include <limits>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -87,6 +88,11 @@ DEFINE_UNKNOWN_uint64(
     ysql_packed_row_size_limit, 0,
     "Packed row size limit for YSQL in bytes. 0 to make this equal to SSTable block size.");
 
+DEFINE_RUNTIME_uint64(ysql_min_ybctid_batch_size_for_shared_iterator, 8,
+    "Minimal number of ybctids in a batched read request to look them up in sorted order using "
+    "a single iterator, instead of creating a separate iterator for each ybctid. "
+    "0 to always use separate iterators.");
+
 DEFINE_test_flag(bool, ysql_suppress_ybctid_corruption_details, false,
                  "Whether to show less details on ybctid corruption error status message.  Useful "
                  "during tests that require consistent output.");
@@ -337,11 +343,9 @@ void WriteNumRows(size_t result_rows, const WriteBufferPos& pos, WriteBuffer* bu
 
 class PgsqlWriteOperation::RowPackContext {
  public:
-  RowPackContext(const PgsqlWriteRequestPB& request,
-                 const DocOperationApplyData& data,
+  RowPackContext(const DocOperationApplyData& data,
                  const RowPackerData& packer_data)
-      : query_id_(request.stmt_id()),
-        data_(data),
+      : data_(data),
         write_id_(data.doc_write_batch->ReserveWriteId()),
         packer_(packer_data.schema_version, packer_data.packing, FLAGS_ysql_packed_row_size_limit,
                 ValueControlFields()) {
@@ -353,15 +357,11 @@ class PgsqlWriteOperation::RowPackContext {
 
   Status Complete(const RefCntPrefix& encoded_doc_key) {
     auto encoded_value = VERIFY_RESULT(packer_.Complete());
-    return data_.doc_write_batch->SetPrimitive(
-        DocPath(encoded_doc_key.as_slice()),
-        ValueControlFields(), ValueRef(encoded_value),
-        data_.read_time, data_.deadline, query_id_,
-        write_id_);
+    return data_.doc_write_batch->SetPackedRow(
+        encoded_doc_key.as_slice(), encoded_value, write_id_);
   }
 
  private:
-  rocksdb::QueryId query_id_;
   const DocOperationApplyData& data_;
   const IntraTxnWriteId write_id_;
   RowPacker packer_;
@@ -589,7 +589,7 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
 
   if (ShouldYsqlPackRow(doc_read_context_->schema.is_colocated())) {
     RowPackContext pack_context(
-        request_, data, VERIFY_RESULT(RowPackerData::Create(request_, *doc_read_context_)));
+        data, VERIFY_RESULT(RowPackerData::Create(request_, *doc_read_context_)));
 
     auto column_id_extractor = [](const PgsqlColumnValuePB& column_value) {
       return column_value.column_id();
@@ -695,7 +695,7 @@ Status PgsqlWriteOperation::ApplyUpdate(const DocOperationApplyData& data) {
     if (ShouldYsqlPackRow(schema.is_colocated()) &&
         make_unsigned(request_.column_new_values().size()) == num_non_key_columns) {
       RowPackContext pack_context(
-          request_, data, VERIFY_RESULT(RowPackerData::Create(request_, *doc_read_context_)));
+          data, VERIFY_RESULT(RowPackerData::Create(request_, *doc_read_context_)));
 
       auto column_id_extractor = [](const PgsqlColumnValuePB& column_value) {
         return column_value.column_id();
@@ -1063,8 +1063,9 @@ Result<size_t> PgsqlReadOperation::ExecuteSample(const YQLStorageIf& ql_storage,
         k = static_cast<int>(targrows * rvalue);
         // Overwrite previous value with new one
         reservoir[k].set_binary_value(ybctid.data(), ybctid.size());
-        // Choose next number of rows to skip
-        YbgReservoirGetNextS(rstate, samplerows, targrows, &rowstoskip);
+        // Choose next number of rows to skip. The algorithm expects the number of rows seen so far,
+        // including ones scanned by this page.
+        YbgReservoirGetNextS(rstate, samplerows + scanned_rows, targrows, &rowstoskip);
         VLOG(3) << "Next reservoir sampling rowstoskip=" << rowstoskip;
       } else {
         rowstoskip -= 1;
@@ -1346,26 +1347,75 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
     VLOG(1) << "Added where expression to the executor";
   }
 
-  for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+  const auto& batch_arguments = request_.batch_arguments();
+  for (const PgsqlBatchArgumentPB& batch_argument : batch_arguments) {
     SCHECK(batch_argument.has_ybctid(),
            InternalError,
            "ybctid arguments can be batched only");
-    // Get the row.
-    RETURN_NOT_OK(ql_storage.GetIterator(
-        request_.stmt_id(), projection, doc_read_context, txn_op_context_,
-        deadline, read_time, batch_argument.ybctid().value(), &table_iter_));
+  }
 
-    if (VERIFY_RESULT(table_iter_->HasNext())) {
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+  const auto min_batch_size_for_shared_iterator =
+      FLAGS_ysql_min_ybctid_batch_size_for_shared_iterator;
+  if (min_batch_size_for_shared_iterator == 0 ||
+      make_unsigned(batch_arguments.size()) < min_batch_size_for_shared_iterator) {
+    for (const PgsqlBatchArgumentPB& batch_argument : batch_arguments) {
+      // Get the row.
+      RETURN_NOT_OK(ql_storage.GetIterator(
+          request_.stmt_id(), projection, doc_read_context, txn_op_context_,
+          deadline, read_time, batch_argument.ybctid().value(), &table_iter_));
+
+      if (VERIFY_RESULT(table_iter_->HasNext())) {
+        row.Clear();
+        RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+        bool is_match = true;
+        RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
+        if (is_match) {
+          // Populate result set.
+          RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+          response_.add_batch_orders(batch_argument.order());
+          row_count++;
+        }
+      }
+    }
+  } else {
+    // Look up all ybctids with a single iterator, visiting them in sorted order, so the iterator
+    // only moves forward and data blocks are reused between neighbour keys. Client expects rows in
+    // the order of batch arguments, so found rows are kept until all ybctids are processed.
+    std::vector<int> lookup_order(batch_arguments.size());
+    std::iota(lookup_order.begin(), lookup_order.end(), 0);
+    std::sort(lookup_order.begin(), lookup_order.end(),
+              [&batch_arguments](int lhs, int rhs) {
+      return Slice(batch_arguments[lhs].ybctid().value().binary_value()).compare(
+          batch_arguments[rhs].ybctid().value().binary_value()) < 0;
+    });
+
+    RETURN_NOT_OK(ql_storage.GetIteratorForYbctids(
+        request_.stmt_id(), projection, doc_read_context, txn_op_context_, deadline, read_time,
+        &table_iter_));
+
+    std::vector<boost::optional<QLTableRow>> rows(batch_arguments.size());
+    for (auto idx : lookup_order) {
+      if (!VERIFY_RESULT(table_iter_->SeekTuple(
+              batch_arguments[idx].ybctid().value().binary_value()))) {
+        continue;
+      }
+      auto& found_row = rows[idx].emplace();
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &found_row));
       bool is_match = true;
-      RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
-      if (is_match) {
-        // Populate result set.
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
-        response_.add_batch_orders(batch_argument.order());
-        row_count++;
+      RETURN_NOT_OK(expr_exec.Exec(found_row, nullptr, &is_match));
+      if (!is_match) {
+        rows[idx].reset();
+      }
+    }
+
+    for (int idx = 0; idx != batch_arguments.size(); ++idx) {
+      if (!rows[idx]) {
+        continue;
       }
+      // Populate result set.
+      RETURN_NOT_OK(PopulateResultSet(*rows[idx], result_buffer));
+      response_.add_batch_orders(batch_arguments[idx].order());
+      row_count++;
     }
   }
 
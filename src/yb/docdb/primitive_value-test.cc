@@ -217,10 +217,17 @@ void TestRoundTrip(const PrimitiveValue& primitive_value, DataType data_type) {
 
   ASSERT_EQ(QLValue(ql_value), QLValue(decoded_ql_value))
       << Format("{ expected: $0, actual: $1 }", ql_value, decoded_ql_value);
+
+  PrimitiveValue moved_from = primitive_value;
+  QLValuePB moved_ql_value;
+  moved_from.MoveToQLValuePB(ql_type, &moved_ql_value);
+  ASSERT_EQ(QLValue(ql_value), QLValue(moved_ql_value))
+      << Format("{ expected: $0, actual: $1 }", ql_value, moved_ql_value);
 }
 
 TEST(PrimitiveValueTest, PrimitiveValueRoundTrip) {
   TestRoundTrip(PrimitiveValue("foo"), DataType::STRING);
+  TestRoundTrip(PrimitiveValue(string("foo\0bar\xff", 8)), DataType::BINARY);
   TestRoundTrip(PrimitiveValue::Int64(123456789000l), DataType::INT64);
   TestRoundTrip(PrimitiveValue::Int64(-123456789000l), DataType::INT64);
   TestRoundTrip(PrimitiveValue::Int64(numeric_limits<int64_t>::max()), DataType::INT64);
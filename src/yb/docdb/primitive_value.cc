@@ -320,6 +320,7 @@ std::string PrimitiveValue::ToString() const {
     case KeyEntryType::kNullHigh: FALLTHROUGH_INTENDED; \
     case KeyEntryType::kNullLow: FALLTHROUGH_INTENDED; \
     case KeyEntryType::kSSForward: FALLTHROUGH_INTENDED; \
+    case KeyEntryType::kSSBuckets: FALLTHROUGH_INTENDED; \
     case KeyEntryType::kSSReverse: FALLTHROUGH_INTENDED; \
     case KeyEntryType::kTrue: FALLTHROUGH_INTENDED; \
     case KeyEntryType::kTrueDescending:
@@ -2205,6 +2206,29 @@ void PrimitiveValue::ToQLValuePB(const std::shared_ptr<QLType>& ql_type,
   LOG(FATAL) << "Unsupported datatype " << ql_type->ToString();
 }
 
+void PrimitiveValue::MoveToQLValuePB(const std::shared_ptr<QLType>& ql_type,
+                                     QLValuePB* ql_value) {
+  if (IsStoredAsString()) {
+    switch (ql_type->main()) {
+      case DataType::STRING:
+        ql_value->set_string_value(std::move(str_val_));
+        return;
+      case DataType::BINARY:
+        ql_value->set_binary_value(std::move(str_val_));
+        return;
+      case DataType::DECIMAL:
+        ql_value->set_decimal_value(std::move(str_val_));
+        return;
+      case DataType::JSONB:
+        ql_value->set_jsonb_value(std::move(str_val_));
+        return;
+      default:
+        break;
+    }
+  }
+  ToQLValuePB(ql_type, ql_value);
+}
+
 KeyEntryValue::KeyEntryValue() : type_(KeyEntryType::kInvalid) {
 }
 
@@ -2565,6 +2589,8 @@ std::string KeyEntryValue::ToString(AutoDecodeKeys auto_decode_keys) const {
       return "SSforward";
     case KeyEntryType::kSSReverse:
       return "SSreverse";
+    case KeyEntryType::kSSBuckets:
+      return "SSbuckets";
     case KeyEntryType::kFalse: FALLTHROUGH_INTENDED;
     case KeyEntryType::kFalseDescending:
       return "false";
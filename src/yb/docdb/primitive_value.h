@@ -97,6 +97,10 @@ class PrimitiveValue {
   // Set a primitive value in a QLValuePB.
   void ToQLValuePB(const std::shared_ptr<QLType>& ql_type, QLValuePB* ql_val) const;
 
+  // Same as ToQLValuePB, but moves string, binary, decimal and jsonb payloads into ql_val instead
+  // of copying them. This value is left in a valid but unspecified state.
+  void MoveToQLValuePB(const std::shared_ptr<QLType>& ql_type, QLValuePB* ql_val);
+
   ValueEntryType value_type() const { return type_; }
   ValueEntryType type() const { return type_; }
 
@@ -148,6 +148,23 @@ Status QLRocksDBStorage::GetIterator(
   return Status::OK();
 }
 
+Status QLRocksDBStorage::GetIteratorForYbctids(
+    uint64 stmt_id,
+    const Schema& projection,
+    std::reference_wrapper<const DocReadContext> doc_read_context,
+    const TransactionOperationContext& txn_op_context,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    YQLRowwiseIteratorIf::UniPtr* iter) const {
+  auto doc_iter = std::make_unique<DocRowwiseIterator>(
+      projection, doc_read_context, txn_op_context, doc_db_, deadline, read_time);
+  // Rows are looked up with SeekTuple, so no scan spec is required. Bloom filters are not used
+  // because a single iterator is shared by all keys of the batch.
+  RETURN_NOT_OK(doc_iter->Init(TableType::PGSQL_TABLE_TYPE, Slice(), stmt_id));
+  *iter = std::move(doc_iter);
+  return Status::OK();
+}
+
 Status QLRocksDBStorage::GetIterator(
     const PgsqlReadRequestPB& request,
     const Schema& projection,
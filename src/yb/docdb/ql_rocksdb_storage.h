@@ -83,6 +83,15 @@ class QLRocksDBStorage : public YQLStorageIf {
       const QLValuePB& ybctid,
       YQLRowwiseIteratorIf::UniPtr* iter) const override;
 
+  Status GetIteratorForYbctids(
+      uint64 stmt_id,
+      const Schema& projection,
+      std::reference_wrapper<const DocReadContext> doc_read_context,
+      const TransactionOperationContext& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
  private:
   const DocDB doc_db_;
 };
@@ -102,6 +102,17 @@ class YQLStorageIf {
       const ReadHybridTime& read_time,
       const QLValuePB& ybctid,
       std::unique_ptr<YQLRowwiseIteratorIf>* iter) const = 0;
+
+  // Create iterator for querying multiple rows by ybctid using SeekTuple. Rows are expected to be
+  // looked up in increasing order of their ybctids.
+  virtual Status GetIteratorForYbctids(
+      uint64 stmt_id,
+      const Schema& projection,
+      std::reference_wrapper<const DocReadContext> doc_read_context,
+      const TransactionOperationContext& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      std::unique_ptr<YQLRowwiseIteratorIf>* iter) const = 0;
 };
 
 }  // namespace docdb
@@ -13,6 +13,9 @@
 
 #include "yb/docdb/redis_operation.h"
 
+#include <map>
+#include <optional>
+
 #include "yb/common/value.pb.h"
 #include "yb/common/ql_value.h"
 
@@ -27,6 +30,7 @@
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/redis_util.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stol_utils.h"
@@ -43,6 +47,16 @@ DEFINE_UNKNOWN_bool(emulate_redis_responses,
     "and HDEL. If emulate_redis_responses is true, we read the required records to compute the "
     "response as specified by the official Redis API documentation. https://redis.io/commands");
 
+DEFINE_RUNTIME_AUTO_bool(redis_sorted_set_rank_index, kLocalPersisted, false, true,
+    "Maintain member counts of ranges of sorted sets created while this flag is set, so that "
+    "ZRANGE and ZREVRANGE seek to the requested rank instead of counting the members from the "
+    "start of the set.");
+
+DEFINE_RUNTIME_uint32(redis_sorted_set_rank_bucket_size, 512,
+    "Number of sorted set members in one range of the rank index. A range is split in two when "
+    "it holds twice as many members.");
+TAG_FLAG(redis_sorted_set_rank_bucket_size, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -528,6 +542,238 @@ void GetNormalizedBounds(int64 low_idx, int64 high_idx, int64 card, bool reverse
   }
 }
 
+// Rank index of sorted sets.
+// A sorted set created while redis_sorted_set_rank_index is set has a kSSBuckets subkey, that
+// splits the members into buckets of consecutive members. A bucket is keyed by the lowest
+// (score, member) it could hold, and its value is the number of members in it. The first bucket
+// starts at (-inf, ""), so every member falls into the bucket with the highest start not above
+// the member. Both parts of the bucket key are stored in descending order, so this bucket is the
+// first one found by a forward seek to the member. Buckets are never removed, a bucket that
+// reaches twice redis_sorted_set_rank_bucket_size members is split in two instead.
+struct SortedSetBucket {
+  double score;
+  std::string member;
+  int64_t count;
+  // The start of the bucket, encoded as in the forward mapping.
+  KeyBytes forward_suffix;
+};
+
+struct SortedSetChange {
+  double score;
+  std::string member;
+  // 1 for an added member and -1 for a removed member.
+  int64_t delta;
+};
+
+KeyBytes SortedSetForwardSuffix(double score, const std::string& member) {
+  KeyBytes result;
+  KeyEntryValue::Double(score).AppendToKey(&result);
+  KeyEntryValue(member).AppendToKey(&result);
+  return result;
+}
+
+KeyBytes SortedSetBucketsKey(const RedisKeyValuePB& kv) {
+  auto result = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  KeyEntryValue(KeyEntryType::kSSBuckets).AppendToKey(&result);
+  return result;
+}
+
+KeyBytes SortedSetBucketKey(const RedisKeyValuePB& kv, double score, const std::string& member) {
+  auto result = SortedSetBucketsKey(kv);
+  KeyEntryValue::Double(score, SortOrder::kDescending).AppendToKey(&result);
+  KeyEntryValue(member, SortOrder::kDescending).AppendToKey(&result);
+  return result;
+}
+
+// Reads the buckets of a sorted set in the order of their starts. Reads all buckets if low_subkey
+// is not set, and only the bucket that holds the member low_subkey is built from otherwise.
+Result<std::vector<SortedSetBucket>> ReadSortedSetBuckets(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv,
+    const SliceKeyBound& low_subkey = SliceKeyBound::Invalid()) {
+  auto encoded_key = SortedSetBucketsKey(kv);
+  SubDocument doc;
+  bool doc_found = false;
+  GetRedisSubDocumentData data = { encoded_key, &doc, &doc_found };
+  if (low_subkey.is_valid()) {
+    data.low_subkey = &low_subkey;
+    data.limit = 1;
+  }
+  RETURN_NOT_OK(GetRedisSubDocument(
+      iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+  std::vector<SortedSetBucket> result;
+  if (!doc_found || doc.value_type() != ValueEntryType::kObject) {
+    return result;
+  }
+  for (const auto& [score, members] : doc.object_container()) {
+    if (members.value_type() != ValueEntryType::kObject) {
+      continue;
+    }
+    for (const auto& [member, count] : members.object_container()) {
+      if (count.value_type() != ValueEntryType::kInt64) {
+        return STATUS_FORMAT(
+            Corruption, "Unexpected sorted set bucket value type: $0", count.value_type());
+      }
+      result.push_back(SortedSetBucket {
+        .score = score.GetDouble(),
+        .member = member.GetString(),
+        .count = count.GetInt64(),
+        .forward_suffix = SortedSetForwardSuffix(score.GetDouble(), member.GetString()),
+      });
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.forward_suffix < rhs.forward_suffix;
+  });
+  return result;
+}
+
+// Returns the bucket that holds the given member, or nullopt if the set has no rank index.
+Result<std::optional<SortedSetBucket>> FindSortedSetBucket(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, double score,
+    const std::string& member) {
+  auto bound_key = SortedSetBucketKey(kv, score, member);
+  auto buckets = VERIFY_RESULT(ReadSortedSetBuckets(
+      iterator, kv, SliceKeyBound(bound_key, BoundType::kInclusiveLower)));
+  if (buckets.empty()) {
+    return std::nullopt;
+  }
+  return std::move(buckets.back());
+}
+
+// Returns the member that has the given index among the members starting from the bucket start.
+Result<std::optional<std::pair<double, std::string>>> GetSortedSetMemberAt(
+    IntentAwareIterator* iterator, const RedisKeyValuePB& kv, const SortedSetBucket& bucket,
+    int64_t index) {
+  auto encoded_key = DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key());
+  KeyEntryValue(KeyEntryType::kSSForward).AppendToKey(&encoded_key);
+  auto bound_key = encoded_key;
+  bound_key.AppendRawBytes(bucket.forward_suffix.AsSlice());
+  SliceKeyBound low_subkey(bound_key, BoundType::kInclusiveLower);
+  IndexBound low_index(index, /* is_lower_bound */ true);
+  IndexBound high_index(index, /* is_lower_bound */ false);
+
+  SubDocument doc;
+  bool doc_found = false;
+  GetRedisSubDocumentData data = { encoded_key, &doc, &doc_found };
+  data.low_subkey = &low_subkey;
+  data.low_index = &low_index;
+  data.high_index = &high_index;
+  RETURN_NOT_OK(GetRedisSubDocument(
+      iterator, data, /* projection */ nullptr, SeekFwdSuffices::kFalse));
+
+  if (!doc_found || doc.value_type() != ValueEntryType::kObject) {
+    return std::nullopt;
+  }
+  for (const auto& [score, members] : doc.object_container()) {
+    if (members.value_type() != ValueEntryType::kObject) {
+      continue;
+    }
+    if (!members.object_container().empty()) {
+      const auto& member = members.object_container().begin()->first;
+      return std::make_pair(score.GetDouble(), member.GetString());
+    }
+  }
+  return std::nullopt;
+}
+
+Status WriteSortedSetBucket(
+    const DocOperationApplyData& data, rocksdb::QueryId query_id, const RedisKeyValuePB& kv,
+    const SortedSetBucket& bucket) {
+  DocPath doc_path(
+      DocKey::EncodedFromRedisKey(kv.hash_code(), kv.key()),
+      KeyEntryValue(KeyEntryType::kSSBuckets),
+      KeyEntryValue::Double(bucket.score, SortOrder::kDescending),
+      KeyEntryValue(bucket.member, SortOrder::kDescending));
+  QLValuePB count;
+  count.set_int64_value(bucket.count);
+  return data.doc_write_batch->SetPrimitive(
+      doc_path, ValueControlFields(), ValueRef(count, SortingType::kNotSpecified), data.read_time,
+      data.deadline, query_id);
+}
+
+// Updates the rank index of a sorted set for the members added and removed by the operation.
+// new_set should be set when the operation creates the set, the rank index is created then.
+Status UpdateSortedSetRankIndex(
+    const DocOperationApplyData& data, IntentAwareIterator* iterator, rocksdb::QueryId query_id,
+    const RedisKeyValuePB& kv, bool new_set, const std::vector<SortedSetChange>& changes) {
+  if (changes.empty()) {
+    return Status::OK();
+  }
+
+  struct BucketUpdate {
+    SortedSetBucket bucket;
+    std::vector<const SortedSetChange*> changes;
+  };
+  // Buckets touched by the operation, keyed by the bucket start.
+  std::map<KeyBytes, BucketUpdate> updates;
+  if (new_set) {
+    if (!GetAtomicFlag(&FLAGS_redis_sorted_set_rank_index)) {
+      return Status::OK();
+    }
+    const auto kLowestScore = -std::numeric_limits<double>::infinity();
+    auto& update = updates[KeyBytes()];
+    update.bucket = SortedSetBucket {
+      .score = kLowestScore,
+      .member = std::string(),
+      .count = 0,
+      .forward_suffix = SortedSetForwardSuffix(kLowestScore, std::string()),
+    };
+    for (const auto& change : changes) {
+      update.changes.push_back(&change);
+    }
+  } else {
+    for (const auto& change : changes) {
+      auto bucket = VERIFY_RESULT(FindSortedSetBucket(iterator, kv, change.score, change.member));
+      if (!bucket) {
+        // The set was created without the rank index.
+        return Status::OK();
+      }
+      auto it = updates.find(bucket->forward_suffix);
+      if (it == updates.end()) {
+        auto key = bucket->forward_suffix;
+        it = updates.emplace(std::move(key), BucketUpdate { .bucket = std::move(*bucket) }).first;
+      }
+      it->second.changes.push_back(&change);
+    }
+  }
+
+  const int64_t bucket_size = std::max<int64_t>(
+      GetAtomicFlag(&FLAGS_redis_sorted_set_rank_bucket_size), 1);
+  for (auto& [_, update] : updates) {
+    auto& bucket = update.bucket;
+    // The count of a stored bucket matches the members visible to the iterator, so the bucket is
+    // split by reading them. Members changed by this operation are then counted in the half
+    // they fall into.
+    std::optional<SortedSetBucket> upper_half;
+    if (bucket.count >= 2 * bucket_size) {
+      auto middle = VERIFY_RESULT(GetSortedSetMemberAt(iterator, kv, bucket, bucket_size));
+      if (middle) {
+        upper_half = SortedSetBucket {
+          .score = middle->first,
+          .member = middle->second,
+          .count = bucket.count - bucket_size,
+          .forward_suffix = SortedSetForwardSuffix(middle->first, middle->second),
+        };
+        bucket.count = bucket_size;
+      }
+    }
+    for (const auto* change : update.changes) {
+      auto* target = &bucket;
+      if (upper_half &&
+          SortedSetForwardSuffix(change->score, change->member) >= upper_half->forward_suffix) {
+        target = &*upper_half;
+      }
+      target->count += change->delta;
+    }
+    RETURN_NOT_OK(WriteSortedSetBucket(data, query_id, kv, bucket));
+    if (upper_half) {
+      RETURN_NOT_OK(WriteSortedSetBucket(data, query_id, kv, *upper_half));
+    }
+  }
+  return Status::OK();
+}
+
 } // anonymous namespace
 
 void RedisWriteOperation::InitializeIterator(const DocOperationApplyData& data) {
@@ -670,6 +916,7 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
 
         int new_elements_added = 0;
         int return_value = 0;
+        std::vector<SortedSetChange> rank_index_changes;
         for (int i = 0; i < kv.subkey_size(); i++) {
           // Check whether the value is already in the document, if so delete it.
           SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
@@ -739,6 +986,11 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
 
           if (should_remove_existing_entry) {
             double score_to_remove = subdoc_reverse.GetDouble();
+            rank_index_changes.push_back(SortedSetChange {
+              .score = score_to_remove,
+              .member = kv.value(i),
+              .delta = -1,
+            });
             EnsureMapEntry(QLVirtualValuePB::SS_FORWARD, &kv_entries, &kv_entries_forward);
             kv_entries_forward->mutable_keys()->Add()->set_double_value(score_to_remove);
             auto* value = kv_entries_forward->mutable_values()->Add()->mutable_map_value();
@@ -770,6 +1022,15 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             // Add the reverse mapping to the entries.
             kv_entries_reverse->mutable_keys()->Add()->set_string_value(kv.value(i));
             kv_entries_reverse->mutable_values()->Add()->set_double_value(score_to_add);
+
+            // Rewriting a member with the same score does not change the member count.
+            if (!subdoc_reverse_found || should_remove_existing_entry) {
+              rank_index_changes.push_back(SortedSetChange {
+                .score = score_to_add,
+                .member = kv.value(i),
+                .delta = 1,
+              });
+            }
           }
         }
 
@@ -791,6 +1052,9 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
             RETURN_NOT_OK(data.doc_write_batch->ExtendSubDocument(
                 doc_path, value, data.read_time, data.deadline, redis_query_id(), ttl));
           }
+          RETURN_NOT_OK(UpdateSortedSetRankIndex(
+              data, iterator_.get(), redis_query_id(), kv, data_type == REDIS_TYPE_NONE,
+              rank_index_changes));
         }
         response_.set_code(RedisResponsePB::OK);
         response_.set_int_response(return_value);
@@ -1018,6 +1282,7 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
     }
     case REDIS_TYPE_SORTEDSET: {
       num_keys = kv.subkey_size();
+      std::vector<SortedSetChange> rank_index_changes;
 
       auto& map = *value.mutable_map_value();
       map.mutable_keys()->Add()->set_virtual_value(QLVirtualValuePB::SS_FORWARD);
@@ -1052,6 +1317,11 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
           auto& fwd_map = *values_forward.mutable_values()->Add()->mutable_map_value();
           fwd_map.mutable_keys()->Add()->set_string_value(kv.subkey(i).string_subkey());
           fwd_map.mutable_values()->Add()->set_virtual_value(QLVirtualValuePB::TOMBSTONE);
+          rank_index_changes.push_back(SortedSetChange {
+            .score = doc_reverse.GetDouble(),
+            .member = kv.subkey(i).string_subkey(),
+            .delta = -1,
+          });
         } else {
           // If the key is absent, it doesn't contribute to the count of keys being deleted.
           num_keys--;
@@ -1062,6 +1332,11 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
       map.mutable_keys()->Add()->set_virtual_value(QLVirtualValuePB::COUNTER);
       map.mutable_values()->Add()->set_int64_value(card - num_keys);
 
+      if (num_keys != 0) {
+        RETURN_NOT_OK(UpdateSortedSetRankIndex(
+            data, iterator_.get(), redis_query_id(), kv, /* new_set= */ false,
+            rank_index_changes));
+      }
       break;
     }
     default: {
@@ -1662,13 +1937,48 @@ Status RedisReadOperation::ExecuteCollectionGetRange() {
 
       bool add_keys = request_.get_collection_range_request().with_scores();
 
-      IndexBound low_bound = IndexBound(low_idx_normalized, true /* is_lower */);
-      IndexBound high_bound = IndexBound(high_idx_normalized, false /* is_lower */);
+      // If the set has a rank index, start reading from the bucket that holds the lowest requested
+      // member instead of counting the members from the start of the set. The counts are only
+      // trusted when they add up to the cardinality.
+      auto buckets = VERIFY_RESULT(ReadSortedSetBuckets(iterator_.get(), request_.key_value()));
+      int64_t total_count = 0;
+      for (const auto& bucket : buckets) {
+        total_count += bucket.count;
+      }
+      const SortedSetBucket* start_bucket = nullptr;
+      int64_t members_before_start = 0;
+      if (!buckets.empty() && total_count == card) {
+        for (const auto& bucket : buckets) {
+          if (members_before_start + bucket.count > low_idx_normalized) {
+            start_bucket = &bucket;
+            break;
+          }
+          members_before_start += bucket.count;
+        }
+      } else if (!buckets.empty()) {
+        VLOG(1) << "Sorted set rank index counts " << total_count << " members, while "
+                << "cardinality is " << card;
+      }
+      KeyBytes low_sub_key_bound;
+      SliceKeyBound low_subkey;
+      if (start_bucket) {
+        low_sub_key_bound = encoded_doc_key;
+        low_sub_key_bound.AppendRawBytes(start_bucket->forward_suffix.AsSlice());
+        low_subkey = SliceKeyBound(low_sub_key_bound, BoundType::kInclusiveLower);
+      } else {
+        members_before_start = 0;
+      }
+
+      IndexBound low_bound = IndexBound(
+          low_idx_normalized - members_before_start, true /* is_lower */);
+      IndexBound high_bound = IndexBound(
+          high_idx_normalized - members_before_start, false /* is_lower */);
 
       SubDocument doc;
       bool doc_found = false;
       GetRedisSubDocumentData data = { encoded_doc_key, &doc, &doc_found};
       data.deadline_info = deadline_info_.get_ptr();
+      data.low_subkey = &low_subkey;
       data.low_index = &low_bound;
       data.high_index = &high_bound;
 
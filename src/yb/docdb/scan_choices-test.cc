@@ -18,6 +18,7 @@
 #include "yb/common/schema.h"
 
 #include "yb/docdb/doc_pgsql_scanspec.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/scan_choices.h"
 
 #include "yb/docdb/value_type.h"
@@ -108,6 +109,7 @@ class ScanChoicesTest : public YBTest {
       const Schema &schema,
       const std::vector<TestCondition> &conds,
       std::vector<std::vector<OptionRange>> &&expected);
+  void CheckMaxNextsAdjustment();
 
  private:
   const Schema *current_schema_;
@@ -266,6 +268,37 @@ void ScanChoicesTest::CheckSkipTargetsUpTo(
   }
 }
 
+void ScanChoicesTest::CheckMaxNextsAdjustment() {
+  PgsqlConditionPB cond;
+  SetupCondition(&cond, {{{10_ColId}, QL_OP_IN, {{5}, {6}}}});
+  InitializeScanChoicesInstance(test_range_schema, cond);
+
+  constexpr int kLimit = 8;
+  choices_->max_nexts_ = 2;
+
+  // Targets reached using Next calls only let the limit grow, but not above the upper limit.
+  choices_->UpdateMaxNexts(SeekStats{.next = 2, .seek = 0}, kLimit);
+  ASSERT_EQ(choices_->max_nexts_, 4);
+  choices_->UpdateMaxNexts(SeekStats{.next = 3, .seek = 0}, kLimit);
+  ASSERT_EQ(choices_->max_nexts_, 8);
+  choices_->UpdateMaxNexts(SeekStats{.next = 8, .seek = 0}, kLimit);
+  ASSERT_EQ(choices_->max_nexts_, kLimit);
+
+  // Nearby target does not change the limit.
+  choices_->UpdateMaxNexts(SeekStats{.next = 1, .seek = 0}, kLimit);
+  ASSERT_EQ(choices_->max_nexts_, kLimit);
+
+  // Seek without Next calls does not tell anything about distance to target.
+  choices_->UpdateMaxNexts(SeekStats{.next = 0, .seek = 1}, kLimit);
+  ASSERT_EQ(choices_->max_nexts_, kLimit);
+
+  // Wasted Next calls shrink the limit, but at least one Next is always tried.
+  for (int expected : {4, 2, 1, 1}) {
+    choices_->UpdateMaxNexts(SeekStats{.next = choices_->max_nexts_, .seek = 1}, kLimit);
+    ASSERT_EQ(choices_->max_nexts_, expected);
+  }
+}
+
 // Tests begin here
 TEST_F(ScanChoicesTest, SimpleInFilterHybridScan) {
   std::vector<TestCondition> conds =
@@ -351,5 +384,9 @@ TEST_F(ScanChoicesTest, MixedTupleFilterHybridScan) {
        {{12, 11, 4, 23, 14, 22}, {12, 11, 4, 23, 14, 12}}});
 }
 
+TEST_F(ScanChoicesTest, MaxNextsAdjustment) {
+  CheckMaxNextsAdjustment();
+}
+
 }  // namespace docdb
 }  // namespace yb
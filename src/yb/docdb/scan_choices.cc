@@ -13,6 +13,8 @@
 
 #include "yb/docdb/scan_choices.h"
 
+#include <algorithm>
+
 #include "yb/common/ql_scanspec.h"
 #include "yb/common/schema.h"
 
@@ -21,13 +23,22 @@
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/doc_pgsql_scanspec.h"
 #include "yb/docdb/doc_scanspec_util.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator_interface.h"
 #include "yb/docdb/value_type.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
 
+DEFINE_RUNTIME_int32(max_nexts_to_avoid_seek_in_scan_choices, 16,
+    "Upper limit for the number of Next calls tried before resorting to seek, when moving forward "
+    "to the next target of IN-list or range scan. The actual number is adjusted at runtime "
+    "basing on the observed distance between targets. 0 to always use max_nexts_to_avoid_seek.");
+
+DECLARE_int32(max_nexts_to_avoid_seek);
+
 namespace yb {
 namespace docdb {
 
@@ -738,7 +749,16 @@ Status HybridScanChoices::SeekToCurrentTarget(IntentAwareIteratorIf* db_iter) {
       if (is_forward_scan_) {
         VLOG(3) << __PRETTY_FUNCTION__ << " Seeking to "
                 << DocKey::DebugSliceToString(current_scan_target_);
-        db_iter->Seek(current_scan_target_);
+        const auto max_nexts_limit = FLAGS_max_nexts_to_avoid_seek_in_scan_choices;
+        if (max_nexts_limit > 0) {
+          if (max_nexts_ < 0) {
+            max_nexts_ = std::clamp(FLAGS_max_nexts_to_avoid_seek, 1, max_nexts_limit);
+          }
+          UpdateMaxNexts(
+              db_iter->SeekWithNextsLimit(current_scan_target_, max_nexts_), max_nexts_limit);
+        } else {
+          db_iter->Seek(current_scan_target_);
+        }
       } else {
         // seek to the highest key <= current_scan_target_
         // seeking to the highest key < current_scan_target_ + kHighest
@@ -759,6 +779,20 @@ Status HybridScanChoices::SeekToCurrentTarget(IntentAwareIteratorIf* db_iter) {
   return Status::OK();
 }
 
+void HybridScanChoices::UpdateMaxNexts(const SeekStats& stats, int max_nexts_limit) {
+  if (stats.seek != 0) {
+    // Target was too far to be reached using Next calls, so they were wasted.
+    if (stats.next != 0) {
+      max_nexts_ = std::max(max_nexts_ / 2, 1);
+    }
+  } else if (stats.next * 2 > max_nexts_) {
+    // Target was reached using most of the Next calls, keys are dense, so allow more of them.
+    max_nexts_ = std::min(max_nexts_ * 2, max_nexts_limit);
+  }
+  VLOG_WITH_FUNC(4) << "next: " << stats.next << ", seek: " << stats.seek
+                    << ", max_nexts: " << max_nexts_;
+}
+
 ScanChoicesPtr ScanChoices::Create(
     const Schema& schema, const DocQLScanSpec& doc_spec,
     const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key,
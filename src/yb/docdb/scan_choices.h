@@ -305,6 +305,10 @@ class HybridScanChoices : public ScanChoices {
   // Sets an entire group to a particular logical option index.
   void SetGroup(size_t opt_list_idx, size_t opt_index);
 
+  // Adjusts the number of Next calls used to reach the next scan target, basing on the result of
+  // the last move to scan target.
+  void UpdateMaxNexts(const SeekStats& stats, int max_nexts_limit);
+
   KeyBytes prev_scan_target_;
 
   // The following fields aid in the goal of iterating through all possible
@@ -342,6 +346,12 @@ class HybridScanChoices : public ScanChoices {
   ColGroupHolder col_groups_;
 
   size_t prefix_length_ = 0;
+
+  // The number of Next calls to try before resorting to seek, when moving forward to the next scan
+  // target. It grows while targets are reached using Next calls and shrinks when they are too far,
+  // so dense scans avoid seeks and sparse scans do not waste Next calls.
+  // Negative until the first move to scan target.
+  int max_nexts_ = -1;
 };
 
 }  // namespace docdb
@@ -29,7 +29,7 @@ namespace docdb {
 namespace {
 
 // Used to mark column as skipped by packer. For instance in case of collection column.
-constexpr int64_t kSkippedColumnIdx = -1;
+constexpr int64_t kSkippedColumnIdx = SchemaPacking::kNotPackedColumnIdx;
 
 bool IsVarlenColumn(const ColumnSchema& column_schema) {
   return column_schema.is_nullable() || column_schema.type_info()->var_length();
@@ -121,6 +121,11 @@ bool SchemaPacking::SkippedColumn(ColumnId column_id) const {
   return it != column_to_idx_.end() && it->second == kSkippedColumnIdx;
 }
 
+int64_t SchemaPacking::GetIndex(ColumnId column_id) const {
+  auto it = column_to_idx_.find(column_id);
+  return it == column_to_idx_.end() ? kNotPackedColumnIdx : it->second;
+}
+
 Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
   const auto& column_data = columns_[idx];
   size_t offset = column_data.num_varlen_columns_before
@@ -133,11 +138,11 @@ Slice SchemaPacking::GetValue(size_t idx, const Slice& packed) const {
 }
 
 std::optional<Slice> SchemaPacking::GetValue(ColumnId column_id, const Slice& packed) const {
-  auto it = column_to_idx_.find(column_id);
-  if (it == column_to_idx_.end() || it->second == kSkippedColumnIdx) {
+  auto idx = GetIndex(column_id);
+  if (idx == kNotPackedColumnIdx) {
     return {};
   }
-  return GetValue(it->second, packed);
+  return GetValue(idx, packed);
 }
 
 std::string SchemaPacking::ToString() const {
@@ -62,6 +62,8 @@ struct ColumnPackingData {
 
 class SchemaPacking {
  public:
+  static constexpr int64_t kNotPackedColumnIdx = -1;
+
   explicit SchemaPacking(const Schema& schema);
   explicit SchemaPacking(const SchemaPackingPB& pb);
 
@@ -83,6 +85,12 @@ class SchemaPacking {
   }
 
   bool SkippedColumn(ColumnId column_id) const;
+
+  // Returns index of the column in this packing, or kNotPackedColumnIdx when the column is not
+  // present in the packing or was skipped by packer.
+  // Could be used to resolve column ids once and then fetch values by index for every row.
+  int64_t GetIndex(ColumnId column_id) const;
+
   Slice GetValue(size_t idx, const Slice& packed) const;
   std::optional<Slice> GetValue(ColumnId column_id, const Slice& packed) const;
   void ToPB(SchemaPackingPB* out) const;
@@ -190,6 +190,36 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+// Lock a batch of keys that span all lock table stripes, and check that every key is locked.
+TEST_F(SharedLockManagerTest, LockManyKeys) {
+  constexpr size_t kNumKeys = 100;
+  const IntentTypeSet kIntents({IntentType::kStrongWrite, IntentType::kStrongRead});
+
+  LockBatchEntries entries;
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    entries.push_back(LockBatchEntry {
+      .key = RefCntPrefix(Format("key_$0", i)),
+      .intent_types = kIntents,
+    });
+  }
+  LockBatch lb(&lm_, std::move(entries), CoarseTimePoint::max());
+  ASSERT_OK(lb.status());
+  ASSERT_EQ(lb.size(), kNumKeys);
+
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    LockBatch conflicting(
+        &lm_, {{RefCntPrefix(Format("key_$0", i)), kIntents}}, CoarseMonoClock::now());
+    ASSERT_NOK(conflicting.status());
+  }
+
+  lb.Reset();
+  for (size_t i = 0; i != kNumKeys; ++i) {
+    LockBatch relocked(
+        &lm_, {{RefCntPrefix(Format("key_$0", i)), kIntents}}, CoarseMonoClock::now());
+    ASSERT_OK(relocked.status());
+  }
+}
+
 TEST_F(SharedLockManagerTest, DumpKeys) {
   FLAGS_dump_lock_keys = true;
 
@@ -24,10 +24,13 @@
 
 #include "yb/docdb/lock_batch.h"
 
+#include "yb/gutil/port.h"
+
 #include "yb/util/enums.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
+#include "yb/util/wait_state.h"
 
 using std::string;
 
@@ -135,8 +138,9 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and covers this field for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the stripe mutex is locked.
+  // Stripe mutex resides in lock manager and covers this field for all LockBatchEntries of the
+  // stripe.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -162,28 +166,42 @@ class SharedLockManager::Impl {
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      LOG_IF(DFATAL, !stripe.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(stripe.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Lock entries are partitioned by key hash, so concurrent writers to the same tablet mostly
+  // don't contend on a single mutex while reserving and releasing entries.
+  static constexpr size_t kNumStripes = 16;
+
+  struct Stripe {
+    // The stripe mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  } CACHELINE_ALIGNED;
+
+  Stripe& StripeFor(const RefCntPrefix& key) {
+    return stripes_[RefCntPrefixHash()(key) % kNumStripes];
+  }
+
+  // Make sure the entries exist in the stripe maps and return pointers so we can access
+  // them without holding the stripe lock. Fills locked field of each entry in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
-
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::array<Stripe, kNumStripes> stripes_;
 };
 
 std::string SharedLockManager::ToString(const LockState& state) {
@@ -223,6 +241,7 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
     std::unique_lock<std::mutex> lock(mutex);
     old_value = num_holding.load(std::memory_order_acquire);
     if ((old_value & kIntentTypeSetConflicts[type_idx]) != 0) {
+      SCOPED_WAIT_STATUS(kLockWait);
       if (deadline != CoarseTimePoint::max()) {
         // Note -- even if we wait here, we don't need to be aware for the purposes of deadlock
         // detection since this eventually succeeds (in which case thread gets to queue) or times
@@ -303,16 +322,28 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  // Consecutive keys of a batch frequently belong to the same stripe, so the stripe lock is kept
+  // while the stripe does not change.
+  Stripe* locked_stripe = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& stripe = StripeFor(key_and_intent_type.key);
+    if (&stripe != locked_stripe) {
+      // Release the previous stripe first, so that at most one stripe mutex is held at a time.
+      if (lock.owns_lock()) {
+        lock.unlock();
+      }
+      lock = std::unique_lock<std::mutex>(stripe.mutex);
+      locked_stripe = &stripe;
+    }
+    auto& value = stripe.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!stripe.free_lock_entries.empty()) {
+        value = stripe.free_lock_entries.back();
+        stripe.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        stripe.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = stripe.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -331,11 +362,21 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  Stripe* locked_stripe = nullptr;
+  std::unique_lock<std::mutex> lock;
   for (const auto& item : key_to_intent_type) {
+    auto& stripe = StripeFor(item.key);
+    if (&stripe != locked_stripe) {
+      // Release the previous stripe first, so that at most one stripe mutex is held at a time.
+      if (lock.owns_lock()) {
+        lock.unlock();
+      }
+      lock = std::unique_lock<std::mutex>(stripe.mutex);
+      locked_stripe = &stripe;
+    }
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      stripe.locks.erase(item.key);
+      stripe.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -505,6 +505,19 @@ void SubDocument::ToQLValuePB(const shared_ptr<QLType>& ql_type, QLValuePB* ql_v
   LOG(FATAL) << "Unsupported datatype in SubDocument: " << ql_type->ToString();
 }
 
+void SubDocument::MoveToQLValuePB(const shared_ptr<QLType>& ql_type, QLValuePB* ql_value) {
+  switch (ql_type->main()) {
+    case MAP: FALLTHROUGH_INTENDED;
+    case SET: FALLTHROUGH_INTENDED;
+    case LIST: FALLTHROUGH_INTENDED;
+    case USER_DEFINED_TYPE: FALLTHROUGH_INTENDED;
+    case TUPLE:
+      return ToQLValuePB(ql_type, ql_value);
+    default:
+      return PrimitiveValue::MoveToQLValuePB(ql_type, ql_value);
+  }
+}
+
 int SubDocument::object_num_keys() const {
   DCHECK(IsObjectType(type_));
   if (!has_valid_object_container()) {
@@ -172,6 +172,9 @@ class SubDocument : public PrimitiveValue {
   // Construct a QLValuePB from a SubDocument.
   void ToQLValuePB(const std::shared_ptr<QLType>& ql_type, QLValuePB* v) const;
 
+  // Same as ToQLValuePB, but moves the payload of a primitive value instead of copying it.
+  void MoveToQLValuePB(const std::shared_ptr<QLType>& ql_type, QLValuePB* v);
+
  private:
 
   Status ConvertToCollection(ValueEntryType value_type);
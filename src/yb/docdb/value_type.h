@@ -72,6 +72,8 @@ namespace docdb {
     /* Forward and reverse mappings for sorted sets. */ \
     ((kSSForward, '&')) /* ASCII code 38 */ \
     ((kSSReverse, '\'')) /* ASCII code 39 */ \
+    /* Member counts of ranges of a sorted set, used to seek to a rank. */ \
+    ((kSSBuckets, '(')) /* ASCII code 40 */ \
     ((kInetaddress, '-'))  /* ASCII code 45 */ \
     ((kInetaddressDescending, '.'))  /* ASCII code 46 */ \
     ((kColocationId, '0')) /* ASCII code 48 */ \
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/wait_queue.h"
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -49,6 +50,12 @@ DEFINE_RUNTIME_uint64(wait_for_relock_unblocked_txn_keys_ms, 0,
 TAG_FLAG(wait_for_relock_unblocked_txn_keys_ms, advanced);
 TAG_FLAG(wait_for_relock_unblocked_txn_keys_ms, hidden);
 
+DEFINE_RUNTIME_bool(wait_queue_signal_resolved_blockers, true,
+    "Whether to resume waiters as soon as the local transaction participant learns that their "
+    "blocker was committed or aborted. Otherwise, waiters are only resumed by the periodic poll "
+    "of blocker statuses.");
+TAG_FLAG(wait_queue_signal_resolved_blockers, advanced);
+
 DEFINE_UNKNOWN_uint64(force_single_shard_waiter_retry_ms, 30000,
               "The amount of time to wait before sending the client of a single shard transaction "
               "a retryable error. Such clients are periodically sent a retryable error to ensure "
@@ -565,6 +572,13 @@ class WaitQueue::Impl {
     }
   }
 
+  void SignalResolved(const TransactionId& id, const TransactionStatusResult& result) {
+    if (!FLAGS_wait_queue_signal_resolved_blockers) {
+      return;
+    }
+    MaybeSignalWaitingTransactions(id, result);
+  }
+
   bool StartShutdown() EXCLUDES(mutex_) {
     decltype(waiter_status_) waiter_status_copy;
     decltype(single_shard_waiters_) single_shard_waiters_copy;
@@ -720,8 +734,20 @@ class WaitQueue::Impl {
       return;
     }
 
-    for (const auto& waiter : resolved_blocker->Signal(std::move(res))) {
-      WARN_NOT_OK(thread_pool_token_->SubmitFunc([weak_waiter = std::weak_ptr(waiter), this]() {
+    auto waiters = resolved_blocker->Signal(std::move(res));
+    if (waiters.empty()) {
+      return;
+    }
+    // Resume waiters in the order they started waiting, so the oldest one gets the first chance
+    // to re-acquire its locks. All of them are resumed by a single task.
+    std::stable_sort(waiters.begin(), waiters.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs->created_at < rhs->created_at;
+    });
+    std::vector<std::weak_ptr<WaiterData>> weak_waiters(waiters.begin(), waiters.end());
+    waiters.clear();
+    WARN_NOT_OK(thread_pool_token_->SubmitFunc(
+        [weak_waiters = std::move(weak_waiters), this]() {
+      for (const auto& weak_waiter : weak_waiters) {
         {
           SharedLock<decltype(mutex_)> l(mutex_);
           if (shutting_down_) {
@@ -734,8 +760,8 @@ class WaitQueue::Impl {
         } else {
           LOG(INFO) << "Failed to lock weak_ptr to waiter to signal. Skipping.";
         }
-      }), "Failed to submit waiter resumption");
-    }
+      }
+    }), "Failed to submit waiter resumption");
   }
 
   void InvokeWaiterCallback(
@@ -856,6 +882,10 @@ void WaitQueue::Poll(HybridTime now) {
   return impl_->Poll(now);
 }
 
+void WaitQueue::SignalResolved(const TransactionId& id, const TransactionStatusResult& result) {
+  return impl_->SignalResolved(id, result);
+}
+
 void WaitQueue::StartShutdown() {
   impl_->StartShutdown();
 }
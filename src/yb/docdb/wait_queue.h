@@ -79,6 +79,11 @@ class WaitQueue {
 
   void Poll(HybridTime now);
 
+  // Signal waiters blocked on the provided transaction, whose status became known to the local
+  // participant, e.g. when the coordinator pushed its commit or cleanup to this tablet. Waiters
+  // are resumed right away instead of at the next Poll.
+  void SignalResolved(const TransactionId& id, const TransactionStatusResult& result);
+
   void StartShutdown();
 
   void CompleteShutdown();
@@ -15,7 +15,10 @@
 
 #include <openssl/ossl_typ.h>
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/encryption/cipher_stream_fwd.h"
 
@@ -35,6 +38,7 @@ class BlockAccessCipherStream {
   static Result<std::unique_ptr<BlockAccessCipherStream>> FromEncryptionParams(
       EncryptionParamsPtr encryption_params);
   explicit BlockAccessCipherStream(EncryptionParamsPtr encryption_params);
+  ~BlockAccessCipherStream();
   Status Init();
 
   // Encrypt data at an offset.
@@ -69,9 +73,17 @@ class BlockAccessCipherStream {
   void IncrementCounter(const uint64_t start_idx, uint8_t* iv,
                         EncryptionOverflowWorkaround counter_overflow_workaround);
 
+  // Returns a context with the key of this stream, for use by one thread at a time.
+  Result<EVP_CIPHER_CTX*> AcquireContext();
+  void ReleaseContext(EVP_CIPHER_CTX* ctx);
+
   EncryptionParamsPtr encryption_params_;
+  // Keyed context that the contexts used for encryption are copied from. Not modified after Init.
   std::unique_ptr<EVP_CIPHER_CTX, std::function<void(EVP_CIPHER_CTX*)>> encryption_context_;
   mutable simple_spinlock mutex_;
+  // Contexts that are not used by any thread, so concurrent reads of the same file don't wait for
+  // each other to encrypt or decrypt.
+  std::vector<EVP_CIPHER_CTX*> free_contexts_ GUARDED_BY(mutex_);
 };
 
 } // namespace encryption
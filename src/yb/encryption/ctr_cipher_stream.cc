@@ -19,6 +19,8 @@
 #include "yb/gutil/casts.h"
 #include "yb/gutil/endian.h"
 
+#include "yb/util/result.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
 
 namespace yb {
@@ -39,6 +41,13 @@ BlockAccessCipherStream::BlockAccessCipherStream(
       EVP_CIPHER_CTX_free(ctx);
     }) {}
 
+BlockAccessCipherStream::~BlockAccessCipherStream() {
+  for (auto* ctx : free_contexts_) {
+    EVP_CIPHER_CTX_cleanup(ctx);
+    EVP_CIPHER_CTX_free(ctx);
+  }
+}
+
 Status BlockAccessCipherStream::Init() {
   EVP_CIPHER_CTX_init(encryption_context_.get());
   const EVP_CIPHER* cipher;
@@ -57,8 +66,10 @@ Status BlockAccessCipherStream::Init() {
           encryption_params_->key_size);
   }
 
+  // Expand the key once here. Contexts used for encryption are copies of this one, and only get
+  // the IV of each call.
   const auto encrypt_init_ex_result = EVP_EncryptInit_ex(
-      encryption_context_.get(), cipher, /* impl */ nullptr, /* key */ nullptr,
+      encryption_context_.get(), cipher, /* impl */ nullptr, encryption_params_->key,
       /* iv */ nullptr);
   if (encrypt_init_ex_result != 1) {
     return STATUS_FORMAT(InternalError,
@@ -149,12 +160,14 @@ Status BlockAccessCipherStream::EncryptByBlock(
   const uint64_t start_index = encryption_params_->counter + block_index;
   IncrementCounter(start_index, iv, counter_overflow_workaround);
 
-  // Lock the encryption op since we modify encryption context.
-  std::lock_guard<simple_spinlock> l(mutex_);
+  auto* ctx = VERIFY_RESULT(AcquireContext());
+  auto se = ScopeExit([this, ctx] {
+    ReleaseContext(ctx);
+  });
 
+  // The key is already set, so only the IV is updated, without expanding the key again.
   const int init_result =
-      EVP_EncryptInit_ex(encryption_context_.get(), /* cipher */ nullptr, /* impl */ nullptr,
-                         encryption_params_->key, iv);
+      EVP_EncryptInit_ex(ctx, /* cipher */ nullptr, /* impl */ nullptr, /* key */ nullptr, iv);
   if (init_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptInit_ex returned $0 when encrypting/decrypting $1 bytes "
@@ -165,8 +178,7 @@ Status BlockAccessCipherStream::EncryptByBlock(
   // Perform the encryption.
   int bytes_updated = 0;
   const int update_result = EVP_EncryptUpdate(
-      encryption_context_.get(), static_cast<uint8_t*>(output), &bytes_updated, input.data(),
-      data_size);
+      ctx, static_cast<uint8_t*>(output), &bytes_updated, input.data(), data_size);
   if (update_result != 1) {
     return STATUS_FORMAT(InternalError,
                          "EVP_EncryptUpdate returned $0 when encrypting/decrypting $1 bytes "
@@ -184,6 +196,34 @@ Status BlockAccessCipherStream::EncryptByBlock(
   return Status::OK();
 }
 
+Result<EVP_CIPHER_CTX*> BlockAccessCipherStream::AcquireContext() {
+  {
+    std::lock_guard<simple_spinlock> l(mutex_);
+    if (!free_contexts_.empty()) {
+      auto* result = free_contexts_.back();
+      free_contexts_.pop_back();
+      return result;
+    }
+  }
+
+  // encryption_context_ is not modified after Init, so it can be copied without the lock.
+  auto* result = EVP_CIPHER_CTX_new();
+  if (!result) {
+    return STATUS(InternalError, "EVP_CIPHER_CTX_new failed");
+  }
+  const int copy_result = EVP_CIPHER_CTX_copy(result, encryption_context_.get());
+  if (copy_result != 1) {
+    EVP_CIPHER_CTX_free(result);
+    return STATUS_FORMAT(InternalError, "EVP_CIPHER_CTX_copy returned $0", copy_result);
+  }
+  return result;
+}
+
+void BlockAccessCipherStream::ReleaseContext(EVP_CIPHER_CTX* ctx) {
+  std::lock_guard<simple_spinlock> l(mutex_);
+  free_contexts_.push_back(ctx);
+}
+
 void BlockAccessCipherStream::IncrementCounter(
     const uint64_t start_idx, uint8_t* iv,
     EncryptionOverflowWorkaround counter_overflow_workaround) {
@@ -47,7 +47,10 @@ Status EncryptedRandomAccessFile::ReadInternal(
   if (!scratch) {
     return STATUS(InvalidArgument, "scratch argument is null.");
   }
-  uint8_t* buf = static_cast<uint8_t*>(EncryptionBuffer::Get()->GetBuffer(n));
+  // Read straight into scratch, which is usually the block cache buffer, and decrypt there. CTR
+  // mode allows the input and the output to be the same buffer. If the underlying file returned
+  // data from its own memory instead, it is decrypted from there into scratch.
+  auto* buf = pointer_cast<uint8_t*>(scratch);
   RETURN_NOT_OK(RandomAccessFileWrapper::Read(offset + header_size_, n, result, buf));
   RETURN_NOT_OK(stream_->Decrypt(offset, *result, scratch, counter_overflow_workaround));
   *result = Slice(scratch, result->size());
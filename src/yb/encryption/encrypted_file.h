@@ -52,6 +52,10 @@ class EncryptedRandomAccessFile : public RandomAccessFileWrapper {
 
   Result<uint64_t> Size() const override;
 
+  void Prefetch(uint64_t offset, size_t length) const override {
+    RandomAccessFileWrapper::Prefetch(offset + header_size_, length);
+  }
+
   virtual bool IsEncrypted() const override {
     return true;
   }
@@ -84,6 +84,8 @@ DECLARE_bool(TEST_disable_adding_user_frontier_to_sst);
 DECLARE_bool(TEST_disable_getting_user_frontier_from_mem_table);
 DECLARE_int32(scheduled_full_compaction_frequency_hours);
 DECLARE_int32(scheduled_full_compaction_jitter_factor_percentage);
+DECLARE_int32(scheduled_full_compaction_max_per_check);
+DECLARE_int32(scheduled_full_compaction_max_foreground_ops_per_sec);
 DECLARE_bool(TEST_pause_before_full_compaction);
 DECLARE_bool(TEST_disable_adding_last_compaction_to_tablet_metadata);
 DECLARE_int32(full_compaction_pool_max_queue_size);
@@ -851,6 +853,44 @@ TEST_F(ScheduledFullCompactionsTest, WillWaitForPreviousToFinishBeforeScheduling
   ASSERT_TRUE(CheckEachDbHasExactlyNumFiles(1));
 }
 
+TEST_F(ScheduledFullCompactionsTest, LimitedPerCheckAndDeferredUnderLoad) {
+  const int kNumFilesToWrite = 10;
+  const auto kCompactionFrequency = MonoDelta::FromSeconds(1);
+
+  // Disable background compactions.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_level0_file_num_compaction_trigger) = -1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_pause_before_full_compaction) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_scheduled_full_compaction_max_per_check) = 1;
+
+  SetupWorkload(IsolationLevel::NON_TRANSACTIONAL);
+  ASSERT_OK(WriteAtLeastFilesPerDb(kNumFilesToWrite));
+
+  auto compact_manager = cluster_->GetTabletManager(0)->full_compaction_manager();
+
+  // All tablets are due, but only one compaction is started per check. The paused compaction
+  // makes its tablet ineligible, so the next check picks another one.
+  compact_manager->TEST_DoScheduleFullCompactionsWithManualValues(kCompactionFrequency, 0);
+  ASSERT_EQ(compact_manager->num_scheduled_last_execution(), 1);
+  compact_manager->TEST_DoScheduleFullCompactionsWithManualValues(kCompactionFrequency, 0);
+  ASSERT_EQ(compact_manager->num_scheduled_last_execution(), 1);
+
+  // Writes since the previous check are well above one operation per second, so the last due
+  // tablet is not compacted until the load limit is lifted.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_scheduled_full_compaction_max_foreground_ops_per_sec) = 1;
+  rocksdb_listener_->Reset();
+  ASSERT_OK(WriteAtLeastFilesPerDb(kNumFilesToWrite));
+  compact_manager->TEST_DoScheduleFullCompactionsWithManualValues(kCompactionFrequency, 0);
+  ASSERT_EQ(compact_manager->num_scheduled_last_execution(), 0);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_scheduled_full_compaction_max_foreground_ops_per_sec) = 0;
+  compact_manager->TEST_DoScheduleFullCompactionsWithManualValues(kCompactionFrequency, 0);
+  ASSERT_EQ(compact_manager->num_scheduled_last_execution(), 1);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_pause_before_full_compaction) = false;
+  ASSERT_OK(WaitForNumCompactionsPerDb(1));
+  ASSERT_TRUE(CheckEachDbHasExactlyNumFiles(1));
+}
+
 TEST_F(ScheduledFullCompactionsTest, OlderTabletsWillStillScheduleAndCreateMetadata) {
   const int kNumFilesToWrite = 10;
   const int kCompactionFrequencyHours = 24;
@@ -23,6 +23,8 @@
 
 #include "yb/rocksdb/db.h"
 
+#include "yb/server/rpc_server.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/transaction_participant.h"
@@ -37,6 +39,9 @@
 #include "yb/util/thread.h"
 #include "yb/util/tsan_util.h"
 
+#include "yb/yql/cql/cqlserver/cql_service.h"
+#include "yb/yql/cql/cqlserver/cql_statement.h"
+
 using std::string;
 
 using namespace std::literals;
@@ -604,6 +609,45 @@ TEST_F(CqlTest, AlteredSchemaVersion) {
   LOG(INFO) << "Test finished: " << CURRENT_TEST_CASE_AND_TEST_NAME_STR();
 }
 
+// Prepared statements looked up since the last garbage collection pass get a second chance, so a
+// hot statement stays cached while colder statements prepared after it are evicted.
+TEST_F(CqlTest, PreparedStatementSecondChance) {
+  constexpr int kColdStatements = 3;
+
+  auto session = ASSERT_RESULT(EstablishSession(driver_.get()));
+  ASSERT_OK(session.ExecuteQuery("CREATE TABLE t (i INT PRIMARY KEY, j INT)"));
+  const std::string hot_query = "SELECT * FROM t WHERE i = 0";
+  auto hot_prepared = ASSERT_RESULT(session.Prepare(hot_query));
+  std::vector<std::string> cold_queries;
+  for (int i = 1; i <= kColdStatements; ++i) {
+    cold_queries.push_back(Format("SELECT * FROM t WHERE i = $0", i));
+    ASSERT_RESULT(session.Prepare(cold_queries.back()));
+  }
+  // The hot statement is the least recently prepared one, but it is used after the others.
+  ASSERT_OK(session.Execute(hot_prepared.Bind()));
+
+  auto* service = down_cast<cqlserver::CQLServiceImpl*>(
+      cql_server_->rpc_server()->TEST_service_pool("yb.cqlserver.CQLServerService")->
+          TEST_get_service().get());
+  auto is_cached = [service](const std::string& query) {
+    return service->GetPreparedStatement(
+        cqlserver::CQLStatement::GetQueryId(kCqlTestKeyspace, query),
+        ql::StatementParameters::kUseLatest).ok();
+  };
+  auto collect_garbage = [service] {
+    static_cast<GarbageCollector*>(service)->CollectGarbage(0);
+  };
+
+  collect_garbage();
+  ASSERT_FALSE(is_cached(cold_queries[0]));
+  ASSERT_TRUE(is_cached(hot_query));
+
+  collect_garbage();
+  ASSERT_FALSE(is_cached(cold_queries[1]));
+  ASSERT_TRUE(is_cached(hot_query));
+  ASSERT_OK(session.Execute(hot_prepared.Bind()));
+}
+
 void CqlTest::TestAlteredPrepare(bool metadata_in_exec_resp) {
   FLAGS_cql_always_return_metadata_in_execute_response = metadata_in_exec_resp;
 
@@ -13,6 +13,7 @@
 
 #include <chrono>
 #include <regex>
+#include <unordered_set>
 
 #include "yb/client/table.h"
 
@@ -46,6 +47,7 @@ using namespace std::literals;
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_int64(global_memstore_size_percentage);
 DECLARE_int64(global_memstore_size_mb_max);
+DECLARE_bool(global_memstore_flush_by_write_amplification);
 DECLARE_int32(memstore_size_mb);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_int32(rocksdb_max_background_flushes);
@@ -265,6 +267,33 @@ TEST_F(FlushITest, TestFlushHappens) {
   ASSERT_GT(flushed_after_writes, 0);
 }
 
+TEST_F(FlushITest, TestFlushByWriteAmplificationHappens) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_global_memstore_flush_by_write_amplification) = true;
+
+  // Tablets of the first table get small memtables that hold the oldest writes.
+  WriteAtLeast(kServerLimitMB * 1_MB / 10);
+  std::unordered_set<TabletId> small_memtable_tablets;
+  for (auto& peer : cluster_->GetTabletPeers(0)) {
+    small_memtable_tablets.insert(peer->tablet_id());
+  }
+
+  SetupWorkload(GetTableName(1));
+  const size_t flushed_before_writes = TotalBytesFlushed();
+  WriteAtLeast((kServerLimitMB * 1_MB) + 1);
+  ASSERT_OK(LoggedWaitFor(
+      [this] { return !memory_monitor()->Exceeded(); }, 30s,
+      "Waiting until memory is freed by flushes...", kWaitDelay));
+  ASSERT_GT(TotalBytesFlushed(), flushed_before_writes);
+
+  // Neither table has SST files, so the tablet with the largest memtable is flushed first, even
+  // though the small memtables have older writes.
+  const auto flushed_tablets = tablet_manager_listener_->GetFlushedTablets();
+  ASSERT_FALSE(flushed_tablets.empty());
+  ASSERT_EQ(small_memtable_tablets.count(flushed_tablets.front()), 0)
+      << "Tablet with a small memtable was flushed first: " << flushed_tablets.front()
+      << ", flushed tablets: " << yb::ToString(flushed_tablets);
+}
+
 void FlushITest::TestFlushPicksOldestInactiveTabletAfterCompaction(bool with_restart) {
   // Trigger compaction early.
   FLAGS_rocksdb_level0_file_num_compaction_trigger = 2;
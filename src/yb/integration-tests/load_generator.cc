@@ -13,8 +13,10 @@
 
 #include "yb/integration-tests/load_generator.h"
 
+#include <fstream>
 #include <memory>
 #include <random>
+#include <sstream>
 #include <thread>
 
 #include <boost/range/iterator_range.hpp>
@@ -35,6 +37,8 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/debug/leakcheck_disabler.h"
+#include "yb/util/format.h"
+#include "yb/util/jsonwriter.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/result.h"
 #include "yb/util/status_log.h"
@@ -92,6 +96,11 @@ DEFINE_UNKNOWN_int32(load_gen_wait_time_increment_step_ms,
              "In retry loops used in the load test we increment the wait time by this number of "
              "milliseconds after every attempt.");
 
+DEFINE_NON_RUNTIME_string(load_gen_results_file, "",
+    "If set, every load generator action appends a JSON line with its throughput and latency "
+    "percentiles to this file when it completes, so that runs of different builds can be "
+    "compared.");
+
 namespace {
 
 void ConfigureYBSession(YBSession* session) {
@@ -220,7 +229,8 @@ MultiThreadedAction::MultiThreadedAction(
       client_id_(client_id),
       running_threads_latch_(num_action_threads),
       stop_requested_(stop_requested_flag),
-      value_size_(value_size) {
+      value_size_(value_size),
+      latency_histogram_(kMaxRecordedLatencyUs, 2) {
   CHECK_OK(
       ThreadPoolBuilder(description)
           .set_max_threads(num_action_threads_ + num_extra_threads)
@@ -254,6 +264,7 @@ string MultiThreadedAction::GetValueByIndex(int64_t key_index) {
 
 void MultiThreadedAction::Start() {
   LOG(INFO) << "Starting " << num_action_threads_ << " " << description_ << " threads";
+  start_time_ = MonoTime::Now();
   CHECK_OK(thread_pool_->SubmitFunc(std::bind(&MultiThreadedAction::RunStatsThread, this)));
   for (int i = 0; i < num_action_threads_; i++) {
     CHECK_OK(thread_pool_->SubmitFunc(std::bind(&MultiThreadedAction::RunActionThread, this, i)));
@@ -262,6 +273,54 @@ void MultiThreadedAction::Start() {
 
 void MultiThreadedAction::WaitForCompletion() {
   thread_pool_->Wait();
+  finish_time_ = MonoTime::Now();
+
+  auto results = ResultsToJson();
+  LOG(INFO) << "Results of " << description_ << ": " << results;
+  if (!FLAGS_load_gen_results_file.empty()) {
+    std::ofstream out(FLAGS_load_gen_results_file, std::ios::app);
+    out << results << std::endl;
+    if (!out) {
+      LOG(WARNING) << "Failed to append results to " << FLAGS_load_gen_results_file;
+    }
+  }
+}
+
+string MultiThreadedAction::ResultsToJson() const {
+  const auto finish_time = finish_time_ ? finish_time_ : MonoTime::Now();
+  const auto elapsed_sec = start_time_ ? (finish_time - start_time_).ToSeconds() : 0.0;
+  const auto num_ops = latency_histogram_.TotalCount();
+
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::COMPACT);
+  writer.StartObject();
+  writer.String("action");
+  writer.String(description_);
+  writer.String("threads");
+  writer.Int(num_action_threads_);
+  writer.String("value_size");
+  writer.Int(value_size_);
+  writer.String("ops");
+  writer.Uint64(num_ops);
+  writer.String("errors");
+  writer.Uint64(NumErrors());
+  writer.String("elapsed_sec");
+  writer.Double(elapsed_sec);
+  writer.String("ops_per_sec");
+  writer.Double(elapsed_sec > 0 ? num_ops / elapsed_sec : 0.0);
+  writer.String("latency_us");
+  writer.StartObject();
+  writer.String("mean");
+  writer.Double(latency_histogram_.MeanValue());
+  for (auto percentile : {50.0, 95.0, 99.0, 99.9}) {
+    writer.String(Format("p$0", percentile));
+    writer.Uint64(latency_histogram_.ValueAtPercentile(percentile));
+  }
+  writer.String("max");
+  writer.Uint64(latency_histogram_.MaxValue());
+  writer.EndObject();
+  writer.EndObject();
+  return out.str();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -315,7 +374,10 @@ void SingleThreadedWriter::Run() {
     string key_str(multi_threaded_writer_->GetKeyByIndex(key_index));
     string value_str(multi_threaded_writer_->GetValueByIndex(key_index));
 
-    if (Write(key_index, key_str, value_str)) {
+    const auto start = MonoTime::Now();
+    const bool written = Write(key_index, key_str, value_str);
+    multi_threaded_writer_->RecordLatency(start);
+    if (written) {
       multi_threaded_writer_->inserted_keys_.Insert(key_index);
     } else {
       multi_threaded_writer_->failed_keys_.Insert(key_index);
@@ -689,7 +751,9 @@ void SingleThreadedReader::Run() {
     ++multi_threaded_reader_->num_reads_;
     const string key_str(multi_threaded_reader_->GetKeyByIndex(key_index));
     const string expected_value_str(multi_threaded_reader_->GetValueByIndex(key_index));
+    const auto start = MonoTime::Now();
     const ReadStatus read_status = PerformRead(key_index, key_str, expected_value_str);
+    multi_threaded_reader_->RecordLatency(start);
 
     // Read operation returning zero rows is treated as a read error.
     // See: https://yugabyte.atlassian.net/browse/ENG-1272
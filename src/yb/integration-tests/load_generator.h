@@ -17,6 +17,7 @@
 #include <signal.h>
 #include <spawn.h>
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <map>
@@ -33,6 +34,8 @@
 #include "yb/client/client_fwd.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/tsan_util.h"
@@ -135,10 +138,27 @@ class MultiThreadedAction {
   void set_client_id(const std::string& client_id) { client_id_ = client_id; }
   bool IsRunning() { return running_threads_latch_.count() > 0; }
 
+  // Latencies of completed operations, in microseconds.
+  const HdrHistogram& latency_histogram() const { return latency_histogram_; }
+
+  // Results of the action as a single line JSON object: number of operations and errors,
+  // throughput and latency percentiles. Meant to be compared between builds.
+  std::string ResultsToJson() const;
+
  protected:
   friend class SingleThreadedReader;
   friend class SingleThreadedWriter;
 
+  virtual size_t NumErrors() const = 0;
+
+  void RecordLatency(MonoTime start) {
+    latency_histogram_.Increment(
+        std::min((MonoTime::Now() - start).ToMicroseconds(), kMaxRecordedLatencyUs));
+  }
+
+  // Operations time out well before that.
+  static constexpr int64_t kMaxRecordedLatencyUs = 300'000'000;
+
   std::string GetKeyByIndex(int64_t key_index);
 
   // The value returned is compared as a string on read, so having a '\0' will use incorrect size.
@@ -161,6 +181,10 @@ class MultiThreadedAction {
   std::atomic<bool> paused_ { false };
 
   const int value_size_;
+
+  HdrHistogram latency_histogram_;
+  MonoTime start_time_;
+  MonoTime finish_time_;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -188,6 +212,9 @@ class MultiThreadedWriter : public MultiThreadedAction {
 
   void set_pause_flag(std::atomic<bool>* pause_flag) { pause_flag_ = pause_flag; }
 
+ protected:
+  size_t NumErrors() const override { return failed_keys_.NumElements(); }
+
  private:
   friend class SingleThreadedWriter;
   friend class RedisSingleThreadedWriter;
@@ -337,6 +364,7 @@ class MultiThreadedReader : public MultiThreadedAction {
  protected:
   virtual void RunActionThread(int reader_index) override;
   virtual void RunStatsThread() override;
+  size_t NumErrors() const override { return num_read_errors_.load(); }
 
  private:
   friend class SingleThreadedReader;
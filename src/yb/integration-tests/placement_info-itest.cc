@@ -38,6 +38,7 @@ using std::vector;
 using std::string;
 
 DECLARE_bool(TEST_check_broadcast_address);
+DECLARE_bool(latency_aware_replica_selection);
 
 namespace yb {
 namespace client {
@@ -220,5 +221,54 @@ TEST_F(PlacementInfoTest, TestSelectTServer) {
   }
 }
 
+TEST_F(PlacementInfoTest, TestLatencyAwareSelectTServer) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_latency_aware_replica_selection) = true;
+
+  master::TabletLocationsPB tablet_locations;
+  GetTabletLocations(&tablet_locations);
+
+  Partition partition;
+  Partition::FromPB(tablet_locations.partition(), &partition);
+  internal::RemoteTabletPtr remote_tablet = new internal::RemoteTablet(
+      tablet_locations.tablet_id(), partition, /* partition_list_version = */ 0,
+      /* split_depth = */ 0, /* split_parent_id = */ "");
+
+  internal::TabletServerMap tserver_map;
+  for (const master::TabletLocationsPB::ReplicaPB& replica : tablet_locations.replicas()) {
+    tserver_map.emplace(replica.ts_info().permanent_uuid(),
+                        std::make_unique<internal::RemoteTabletServer>(replica.ts_info()));
+  }
+  remote_tablet->Refresh(tserver_map, tablet_locations.replicas());
+
+  auto tserver = [this, &tserver_map](int ts_index) {
+    return tserver_map[cluster_->mini_tablet_server(ts_index)->server()->permanent_uuid()].get();
+  };
+  auto validate = [this, &remote_tablet](int expected_ts_index) {
+    ValidateSelectTServer(
+        "", PlacementZone(0), PlacementRegion(0), expected_ts_index, remote_tablet.get());
+  };
+
+  // Without measurements the closest replica is selected, unmeasured replicas are not preferred.
+  ASSERT_NO_FATALS(validate(0));
+
+  // The closest replica is kept while the others are not measured.
+  tserver(0)->RecordResponseTime(MonoDelta::FromMilliseconds(100));
+  ASSERT_NO_FATALS(validate(0));
+
+  // A farther replica that is faster, but not by enough, does not win.
+  tserver(1)->RecordResponseTime(MonoDelta::FromMilliseconds(60));
+  ASSERT_NO_FATALS(validate(0));
+
+  // A farther replica that is much faster wins.
+  tserver(2)->RecordResponseTime(MonoDelta::FromMilliseconds(10));
+  ASSERT_NO_FATALS(validate(2));
+
+  // The closest replica is selected again once it is faster.
+  for (int i = 0; i != 20; ++i) {
+    tserver(0)->RecordResponseTime(MonoDelta::FromMilliseconds(5));
+  }
+  ASSERT_NO_FATALS(validate(0));
+}
+
 } // namespace client
 } // namespace yb
@@ -47,6 +47,7 @@
 #include "yb/integration-tests/test_workload.h"
 
 #include "yb/master/catalog_entity_info.h"
+#include "yb/master/catalog_manager.h"
 #include "yb/master/catalog_manager_if.h"
 #include "yb/master/master_admin.proxy.h"
 #include "yb/master/master_admin.pb.h"
@@ -55,6 +56,7 @@
 #include "yb/master/master_defaults.h"
 #include "yb/master/master_error.h"
 #include "yb/master/master_heartbeat.pb.h"
+#include "yb/master/mini_master.h"
 #include "yb/master/tablet_split_manager.h"
 #include "yb/master/ts_descriptor.h"
 
@@ -103,6 +105,7 @@ DECLARE_int64(db_block_size_bytes);
 DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(enable_load_balancing);
 DECLARE_bool(enable_maintenance_manager);
+DECLARE_bool(enable_post_split_full_compaction);
 DECLARE_int32(load_balancer_max_concurrent_adds);
 DECLARE_int32(load_balancer_max_concurrent_removals);
 DECLARE_int32(load_balancer_max_concurrent_moves);
@@ -110,6 +113,8 @@ DECLARE_int32(maintenance_manager_polling_interval_ms);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_bool(rocksdb_disable_compactions);
+DECLARE_uint64(rocksdb_universal_compaction_always_include_size_threshold);
+DECLARE_int32(rocksdb_universal_compaction_min_merge_width);
 DECLARE_bool(TEST_do_not_start_election_test_only);
 DECLARE_int32(TEST_apply_tablet_split_inject_delay_ms);
 DECLARE_int32(heartbeat_interval_ms);
@@ -132,6 +137,8 @@ DECLARE_int64(tablet_split_high_phase_shard_count_per_node);
 DECLARE_int64(tablet_split_low_phase_size_threshold_bytes);
 DECLARE_int64(tablet_split_high_phase_size_threshold_bytes);
 DECLARE_int64(tablet_force_split_threshold_bytes);
+DECLARE_double(tablet_split_load_threshold_ops_per_sec);
+DECLARE_int64(tablet_split_load_min_size_bytes);
 DECLARE_int32(tserver_heartbeat_metrics_interval_ms);
 DECLARE_bool(TEST_validate_all_tablet_candidates);
 DECLARE_uint64(outstanding_tablet_split_limit);
@@ -221,6 +228,40 @@ TEST_F(TabletSplitITest, SplitTabletIsAsync) {
   ASSERT_OK(WaitForTestTablePostSplitTabletsFullyCompacted(15s * kTimeMultiplier));
 }
 
+TEST_F(TabletSplitITest, PostSplitFullCompactionDisabled) {
+  constexpr auto kNumRows = kDefaultNumRows;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_post_split_full_compaction) = false;
+  // Let a compaction pick the parent file together with a larger newer file, but not the small
+  // file flushed last. So the data of the other child is dropped by a compaction that is not full.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_level0_file_num_compaction_trigger) = 3;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_universal_compaction_min_merge_width) = 2;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_universal_compaction_always_include_size_threshold) = 0;
+
+  ASSERT_OK(CreateSingleTabletAndSplit(kNumRows));
+
+  std::this_thread::sleep_for(1s * kTimeMultiplier);
+  for (auto peer : ASSERT_RESULT(ListPostSplitChildrenTabletPeers())) {
+    EXPECT_TRUE(peer->shared_tablet()->MayHaveOrphanedPostSplitData());
+  }
+
+  // Children read from the parent's files until a compaction drops the data of the other child.
+  ASSERT_OK(CheckRowsCount(kNumRows));
+
+  constexpr auto kNumLargeFileRows = 3 * kNumRows;
+  constexpr auto kNumSmallFileRows = 20;
+  ASSERT_OK(WriteRowsAndFlush(kNumLargeFileRows, kNumRows + 1));
+  ASSERT_OK(WriteRowsAndFlush(kNumSmallFileRows, kNumRows + kNumLargeFileRows + 1));
+
+  ASSERT_OK(WaitForTestTablePostSplitTabletsFullyCompacted(15s * kTimeMultiplier));
+  for (auto peer : ASSERT_RESULT(ListPostSplitChildrenTabletPeers())) {
+    // The small file was not compacted, so the tablet was marked compacted by a compaction that
+    // was not full.
+    ASSERT_EQ(peer->shared_tablet()->TEST_db()->GetCurrentVersionNumSSTFiles(), 2);
+  }
+  ASSERT_OK(CheckRowsCount(kNumRows + kNumLargeFileRows + kNumSmallFileRows));
+}
+
 TEST_F(TabletSplitITest, ParentTabletCleanup) {
   constexpr auto kNumRows = kDefaultNumRows;
 
@@ -1214,6 +1255,43 @@ TEST_F(AutomaticTabletSplitITest, DisableTabletSplitting) {
 // as created to track a new unit test for ShouldSplitValidCandidate() only.
 // This comment should be removed in the context of that new issue.
 
+TEST_F(AutomaticTabletSplitITest, LoadBasedSplitCandidate) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_low_phase_size_threshold_bytes) = 1_GB;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_min_size_bytes) = 1_MB;
+  CreateSingleTablet();
+
+  auto& catalog_mgr = ASSERT_RESULT(cluster_->GetLeaderMiniMaster())->catalog_manager_impl();
+  const auto tablets = catalog_mgr.GetTableInfo(table_->id())->GetTablets();
+  ASSERT_EQ(tablets.size(), 1);
+  const auto& tablet = *tablets[0];
+
+  master::TabletReplicaDriveInfo drive_info;
+  drive_info.may_have_orphaned_post_split_data = false;
+  drive_info.sst_files_size = 10_MB;
+  drive_info.read_ops_per_sec = 600;
+  drive_info.write_ops_per_sec = 500;
+
+  // Load based splitting is disabled by default, the tablet is below the size threshold.
+  ASSERT_NOK(catalog_mgr.ShouldSplitValidCandidate(tablet, drive_info));
+
+  // Reads and writes add up to the load threshold.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_load_threshold_ops_per_sec) = 1000;
+  ASSERT_OK(catalog_mgr.ShouldSplitValidCandidate(tablet, drive_info));
+
+  drive_info.write_ops_per_sec = 300;
+  ASSERT_NOK(catalog_mgr.ShouldSplitValidCandidate(tablet, drive_info));
+
+  // A loaded tablet is not split when it is too small.
+  drive_info.write_ops_per_sec = 500;
+  drive_info.sst_files_size = 100_KB;
+  ASSERT_NOK(catalog_mgr.ShouldSplitValidCandidate(tablet, drive_info));
+
+  // A loaded tablet is not split while it may have post split data.
+  drive_info.sst_files_size = 10_MB;
+  drive_info.may_have_orphaned_post_split_data = true;
+  ASSERT_NOK(catalog_mgr.ShouldSplitValidCandidate(tablet, drive_info));
+}
+
 TEST_F(AutomaticTabletSplitITest, AutomaticTabletSplittingWaitsForAllPeersCompacted) {
   constexpr auto kNumRowsPerBatch = 1000;
 
@@ -579,6 +579,39 @@ TabletServerId AsyncTabletLeaderTask::permanent_uuid() const {
 // ============================================================================
 //  Class AsyncCreateReplica.
 // ============================================================================
+namespace {
+
+void FillCreateTabletRequest(
+    const std::string& permanent_uuid, TabletInfo& tablet,
+    const std::vector<SnapshotScheduleId>& snapshot_schedules,
+    tserver::CreateTabletRequestPB* req) {
+  auto table_lock = tablet.table()->LockForRead();
+  const SysTabletsEntryPB& tablet_pb = tablet.metadata().dirty().pb;
+
+  req->set_dest_uuid(permanent_uuid);
+  req->set_table_id(tablet.table()->id());
+  req->set_tablet_id(tablet.tablet_id());
+  req->set_table_type(tablet.table()->metadata().state().pb.table_type());
+  req->mutable_partition()->CopyFrom(tablet_pb.partition());
+  req->set_namespace_id(table_lock->pb.namespace_id());
+  req->set_namespace_name(table_lock->pb.namespace_name());
+  req->set_table_name(table_lock->pb.name());
+  req->mutable_schema()->CopyFrom(table_lock->pb.schema());
+  req->mutable_partition_schema()->CopyFrom(table_lock->pb.partition_schema());
+  req->mutable_config()->CopyFrom(tablet_pb.committed_consensus_state().config());
+  req->set_colocated(tablet_pb.colocated());
+  if (table_lock->pb.has_index_info()) {
+    req->mutable_index_info()->CopyFrom(table_lock->pb.index_info());
+  }
+  auto& req_schedules = *req->mutable_snapshot_schedules();
+  req_schedules.Reserve(narrow_cast<int>(snapshot_schedules.size()));
+  for (const auto& id : snapshot_schedules) {
+    req_schedules.Add()->assign(id.AsSlice().cdata(), id.size());
+  }
+}
+
+} // namespace
+
 AsyncCreateReplica::AsyncCreateReplica(Master *master,
                                        ThreadPool *callback_pool,
                                        const string& permanent_uuid,
@@ -590,29 +623,7 @@ AsyncCreateReplica::AsyncCreateReplica(Master *master,
   deadline_ = start_ts_;
   deadline_.AddDelta(MonoDelta::FromMilliseconds(FLAGS_tablet_creation_timeout_ms));
 
-  auto table_lock = tablet->table()->LockForRead();
-  const SysTabletsEntryPB& tablet_pb = tablet->metadata().dirty().pb;
-
-  req_.set_dest_uuid(permanent_uuid);
-  req_.set_table_id(tablet->table()->id());
-  req_.set_tablet_id(tablet->tablet_id());
-  req_.set_table_type(tablet->table()->metadata().state().pb.table_type());
-  req_.mutable_partition()->CopyFrom(tablet_pb.partition());
-  req_.set_namespace_id(table_lock->pb.namespace_id());
-  req_.set_namespace_name(table_lock->pb.namespace_name());
-  req_.set_table_name(table_lock->pb.name());
-  req_.mutable_schema()->CopyFrom(table_lock->pb.schema());
-  req_.mutable_partition_schema()->CopyFrom(table_lock->pb.partition_schema());
-  req_.mutable_config()->CopyFrom(tablet_pb.committed_consensus_state().config());
-  req_.set_colocated(tablet_pb.colocated());
-  if (table_lock->pb.has_index_info()) {
-    req_.mutable_index_info()->CopyFrom(table_lock->pb.index_info());
-  }
-  auto& req_schedules = *req_.mutable_snapshot_schedules();
-  req_schedules.Reserve(narrow_cast<int>(snapshot_schedules.size()));
-  for (const auto& id : snapshot_schedules) {
-    req_schedules.Add()->assign(id.AsSlice().cdata(), id.size());
-  }
+  FillCreateTabletRequest(permanent_uuid, *tablet, snapshot_schedules, &req_);
 }
 
 std::string AsyncCreateReplica::description() const {
@@ -648,6 +659,81 @@ bool AsyncCreateReplica::SendRequest(int attempt) {
   return true;
 }
 
+// ============================================================================
+//  Class AsyncCreateReplicas.
+// ============================================================================
+AsyncCreateReplicas::AsyncCreateReplicas(Master *master,
+                                         ThreadPool *callback_pool,
+                                         const string& permanent_uuid,
+                                         const std::vector<TabletToCreate>& tablets)
+  : RetrySpecificTSRpcTask(master, callback_pool, permanent_uuid,
+                           tablets.front().tablet->table().get(),
+                           /* async_task_throttler */ nullptr),
+    first_tablet_id_(tablets.front().tablet->tablet_id()) {
+  deadline_ = start_ts_;
+  deadline_.AddDelta(MonoDelta::FromMilliseconds(FLAGS_tablet_creation_timeout_ms));
+
+  req_.set_dest_uuid(permanent_uuid);
+  req_.mutable_tablets()->Reserve(narrow_cast<int>(tablets.size()));
+  for (const auto& tablet : tablets) {
+    FillCreateTabletRequest(
+        permanent_uuid, *tablet.tablet, tablet.snapshot_schedules, req_.add_tablets());
+  }
+}
+
+std::string AsyncCreateReplicas::description() const {
+  return Format("CreateTablets RPC for $0 tablets of $1 starting at $2 on TS=$3",
+                req_.tablets_size(), table_name(), first_tablet_id_, permanent_uuid_);
+}
+
+void AsyncCreateReplicas::HandleResponse(int attempt) {
+  if (resp_.has_error()) {
+    LOG_WITH_PREFIX(WARNING) << "CreateTablets RPC on TS " << permanent_uuid_ << " failed: "
+                             << StatusFromPB(resp_.error().status());
+    return;
+  }
+  if (resp_.tablets_size() != req_.tablets_size()) {
+    LOG_WITH_PREFIX(WARNING) << "CreateTablets RPC on TS " << permanent_uuid_ << " returned "
+                             << resp_.tablets_size() << " responses for "
+                             << req_.tablets_size() << " tablets";
+    return;
+  }
+
+  // Keep only the tablets that failed, so that a retry does not send the others again.
+  auto& tablets = *req_.mutable_tablets();
+  int num_failed = 0;
+  for (int i = 0; i != tablets.size(); ++i) {
+    const auto& tablet_resp = resp_.tablets(i);
+    if (tablet_resp.has_error()) {
+      Status s = StatusFromPB(tablet_resp.error().status());
+      if (!s.IsAlreadyPresent()) {
+        LOG_WITH_PREFIX(WARNING) << "CreateTablets RPC for tablet " << tablets.Get(i).tablet_id()
+                                 << " on TS " << permanent_uuid_ << " failed: " << s;
+        tablets.SwapElements(num_failed++, i);
+        continue;
+      }
+      LOG_WITH_PREFIX(INFO) << "CreateTablets RPC for tablet " << tablets.Get(i).tablet_id()
+                            << " on TS " << permanent_uuid_ << " returned already present: "
+                            << s;
+    }
+    VLOG_WITH_PREFIX(1) << "TS " << permanent_uuid_ << ": complete on tablet "
+                        << tablets.Get(i).tablet_id();
+  }
+  tablets.DeleteSubrange(num_failed, tablets.size() - num_failed);
+
+  if (tablets.empty()) {
+    TransitionToCompleteState();
+  }
+}
+
+bool AsyncCreateReplicas::SendRequest(int attempt) {
+  ts_admin_proxy_->CreateTabletsAsync(req_, &resp_, &rpc_, BindRpcCallback());
+  VLOG_WITH_PREFIX(1) << "Send create tablets request to " << permanent_uuid_
+                      << " for " << req_.tablets_size() << " tablets"
+                      << " (attempt " << attempt << ")";
+  return true;
+}
+
 // ============================================================================
 //  Class AsyncStartElection.
 // ============================================================================
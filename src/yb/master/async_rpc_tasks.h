@@ -342,6 +342,40 @@ class AsyncCreateReplica : public RetrySpecificTSRpcTask {
   tserver::CreateTabletResponsePB resp_;
 };
 
+struct TabletToCreate {
+  scoped_refptr<TabletInfo> tablet;
+  std::vector<SnapshotScheduleId> snapshot_schedules;
+};
+
+// Creates the replicas of several tablets of the same table on one tablet server, with a single
+// CreateTablets RPC. Retries only send the tablets that failed.
+class AsyncCreateReplicas : public RetrySpecificTSRpcTask {
+ public:
+  AsyncCreateReplicas(Master *master,
+                      ThreadPool *callback_pool,
+                      const std::string& permanent_uuid,
+                      const std::vector<TabletToCreate>& tablets);
+
+  server::MonitoredTaskType type() const override {
+    return server::MonitoredTaskType::kCreateReplica;
+  }
+
+  std::string type_name() const override { return "Create Tablets"; }
+
+  std::string description() const override;
+
+ protected:
+  TabletId tablet_id() const override { return first_tablet_id_; }
+
+  void HandleResponse(int attempt) override;
+  bool SendRequest(int attempt) override;
+
+ private:
+  const TabletId first_tablet_id_;
+  tserver::CreateTabletsRequestPB req_;
+  tserver::CreateTabletsResponsePB resp_;
+};
+
 // Task to start election at hinted leader for a newly created tablet.
 class AsyncStartElection : public RetrySpecificTSRpcTask {
  public:
@@ -30,6 +30,7 @@
 DECLARE_bool(load_balancer_count_move_as_add);
 
 DECLARE_bool(load_balancer_ignore_cloud_info_similarity);
+DECLARE_bool(load_balancer_leader_balancing_by_ops);
 
 namespace yb {
 namespace master {
@@ -227,6 +228,9 @@ class TestLoadBalancerBase {
     PrepareTestState(ts_descs_multi_az);
     TestBalancingLeaders();
 
+    PrepareTestState(ts_descs_multi_az);
+    TestBalancingLeadersByOps();
+
     PrepareTestState(ts_descs_single_az);
     TestMissingPlacementSingleAz();
 
@@ -865,6 +869,38 @@ class TestLoadBalancerBase {
     ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
   }
 
+  void TestBalancingLeadersByOps() {
+    LOG(INFO) << "Testing moving leaders weighted by their ops";
+    // Tablets 0 and 3 have their leaders on ts0, 1 on ts1 and 2 on ts2. Make the leaders of ts0
+    // hot, so that they count twice the average leader.
+    SetLeaderOps(tablets_[0].get(), 1000);
+    SetLeaderOps(tablets_[1].get(), 10);
+    SetLeaderOps(tablets_[2].get(), 10);
+    SetLeaderOps(tablets_[3].get(), 1000);
+    LOG(INFO) << "Leader distribution: 2 1 1, weighted: 4 1 1";
+
+    std::string placeholder, tablet_id;
+    gflags::SetCommandLineOption("load_balancer_leader_balancing_by_ops", "false");
+    ASSERT_OK(AnalyzeTablets());
+    // Leader counts are balanced, so there shouldn't be any move.
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    gflags::SetCommandLineOption("load_balancer_leader_balancing_by_ops", "true");
+    ResetState();
+    ASSERT_OK(AnalyzeTablets());
+
+    // One hot leader should be moved off from ts0 to ts1, giving 2 3 1.
+    TestMoveLeader(&tablet_id, ts_descs_[0]->permanent_uuid(), ts_descs_[1]->permanent_uuid());
+    ASSERT_TRUE(tablet_id == tablets_[0]->tablet_id() || tablet_id == tablets_[3]->tablet_id());
+    // Moving the hot leader on to ts2 would not reduce the imbalance, so the cold one is moved,
+    // giving 2 2 2.
+    TestMoveLeader(&tablet_id, ts_descs_[1]->permanent_uuid(), ts_descs_[2]->permanent_uuid());
+    ASSERT_EQ(tablets_[1]->tablet_id(), tablet_id);
+    ASSERT_FALSE(ASSERT_RESULT(HandleLeaderMoves(&placeholder, &placeholder, &placeholder)));
+
+    gflags::SetCommandLineOption("load_balancer_leader_balancing_by_ops", "false");
+  }
+
   void TestBalancingLeadersWithThreshold() {
     LOG(INFO) << "Testing moving overloaded leaders with threshold = 2";
     // Move all leaders to ts0.
@@ -1100,6 +1136,17 @@ class TestLoadBalancerBase {
     tablet->SetReplicaLocations(replicas);
   }
 
+  void SetLeaderOps(TabletInfo* tablet, double ops_per_sec) {
+    std::shared_ptr<TabletReplicaMap> replicas =
+      std::const_pointer_cast<TabletReplicaMap>(tablet->GetReplicaLocations());
+    for (auto& replica : *replicas) {
+      if (replica.second.role == PeerRole::LEADER) {
+        replica.second.drive_info.read_ops_per_sec = ops_per_sec;
+      }
+    }
+    tablet->SetReplicaLocations(replicas);
+  }
+
   // Clear the tablets_added_ field from the state, used for testing.
   void ClearTabletsAddedForTest() {
     cb_->state_->tablets_added_.clear();
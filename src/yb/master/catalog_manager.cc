@@ -244,6 +244,16 @@ DEFINE_RUNTIME_int32(max_create_tablets_per_ts, 50,
              "The number of tablets per TS that can be requested for a new table.");
 TAG_FLAG(max_create_tablets_per_ts, advanced);
 
+DEFINE_RUNTIME_AUTO_bool(master_batch_create_tablet_rpcs, kLocalVolatile, false, true,
+    "When set, the master creates the replicas of the new tablets of a table that are placed "
+    "on the same tablet server with CreateTablets RPCs, instead of one CreateTablet RPC per "
+    "replica.");
+
+DEFINE_RUNTIME_int32(master_max_tablets_per_create_tablets_rpc, 100,
+    "The max number of tablets whose replicas are created on a tablet server by a single "
+    "CreateTablets RPC. Used when master_batch_create_tablet_rpcs is set.");
+TAG_FLAG(master_max_tablets_per_create_tablets_rpc, advanced);
+
 DEFINE_RUNTIME_int32(catalog_manager_report_batch_size, 1,
     "The max number of tablets evaluated in the heartbeat as a single SysCatalog update.");
 TAG_FLAG(catalog_manager_report_batch_size, advanced);
@@ -446,6 +456,18 @@ DEFINE_RUNTIME_int64(tablet_force_split_threshold_bytes, 100_GB,
     "tablets from forming in your cluster even if both automatic splitting phases have "
     "been finished.");
 
+DEFINE_RUNTIME_double(tablet_split_load_threshold_ops_per_sec, 0,
+    "The number of read and write operations per second served by the leader of a tablet at "
+    "which to split the tablet, regardless of its size and of the splitting phase of the "
+    "table, as long as the tablet is at least tablet_split_load_min_size_bytes. 0 disables "
+    "load based splitting. The tablet is split at the middle key of its data, so with "
+    "monotonically increasing keys the load stays on the child with the upper half of the keys.");
+TAG_FLAG(tablet_split_load_threshold_ops_per_sec, advanced);
+DEFINE_RUNTIME_int64(tablet_split_load_min_size_bytes, 64_MB,
+    "The minimum tablet size for a tablet to be split because of its load. See "
+    "tablet_split_load_threshold_ops_per_sec.");
+TAG_FLAG(tablet_split_load_min_size_bytes, advanced);
+
 DEFINE_test_flag(bool, crash_server_on_sys_catalog_leader_affinity_move, false,
                  "When set, crash the master process if it performs a sys catalog leader affinity "
                  "move.");
@@ -599,6 +621,9 @@ using yb::client::YBTableName;
 
 namespace {
 
+// Number of tables ListTables handles per acquisition of the catalog manager lock.
+constexpr size_t kListTablesBatchSize = 256;
+
 // Macros to access index information in CATALOG.
 //
 // NOTES from file master.proto for SysTablesEntryPB.
@@ -2752,6 +2777,14 @@ Status CatalogManager::ShouldSplitValidCandidate(
   }
   ssize_t size = drive_info.sst_files_size;
   DCHECK(size >= 0) << "Detected overflow in casting sst_files_size to signed int.";
+  const auto load_threshold = FLAGS_tablet_split_load_threshold_ops_per_sec;
+  if (load_threshold > 0 && size >= FLAGS_tablet_split_load_min_size_bytes &&
+      drive_info.read_ops_per_sec + drive_info.write_ops_per_sec >= load_threshold) {
+    VLOG(1) << "Tablet " << tablet_info.id() << " is a split candidate because of its load: "
+            << drive_info.read_ops_per_sec << " reads/s, " << drive_info.write_ops_per_sec
+            << " writes/s";
+    return Status::OK();
+  }
   if (size < FLAGS_tablet_split_low_phase_size_threshold_bytes) {
     return STATUS_FORMAT(IllegalState, "Tablet $0 SST size ($0) < low phase size threshold ($1).",
         tablet_info.id(), size, FLAGS_tablet_split_low_phase_size_threshold_bytes);
@@ -6059,14 +6092,9 @@ void CatalogManager::CleanUpDeletedTables() {
   // TODO(bogdan): Cache tables being deleted to make this iterate only over those?
   vector<scoped_refptr<TableInfo>> tables_to_delete;
   // Garbage collecting.
-  // Going through all tables under the global lock, copying them to not hold lock for too long.
-  std::vector<scoped_refptr<TableInfo>> tables;
-  {
-    LockGuard lock(mutex_);
-    for (const auto& table : tables_->GetAllTables()) {
-      tables.push_back(table);
-    }
-  }
+  // Copying the tables under a shared lock, to not block other readers and hold the lock for too
+  // long.
+  const auto tables = GetTables(GetTablesMode::kAll);
   // Mark the tables as DELETED and remove them from the in-memory maps.
   vector<TableInfo*> tables_to_update_on_disk;
   vector<TableInfo::WriteLock> table_locks;
@@ -7026,74 +7054,82 @@ Status CatalogManager::ListTables(const ListTablesRequestPB* req,
     }
   }
 
-  SharedLock lock(mutex_);
+  // Only hold the lock for a batch of tables at a time, so that DDLs and other writers, and the
+  // readers queued behind them, are not stalled while every table of a large catalog is listed.
+  const auto tables = GetTables(GetTablesMode::kAll);
   RelationType relation_type;
 
-  for (const auto& table_info : tables_->GetAllTables()) {
-    auto ltm = table_info->LockForRead();
-
-    if (!ltm->visible_to_client() && !req->include_not_running()) {
-      continue;
-    }
-
-    if (!namespace_id.empty() && namespace_id != table_info->namespace_id()) {
-      continue; // Skip tables from other namespaces.
-    }
+  for (size_t batch_start = 0; batch_start < tables.size();
+       batch_start += kListTablesBatchSize) {
+    SharedLock lock(mutex_);
+    const auto batch_end = std::min(tables.size(), batch_start + kListTablesBatchSize);
+    for (auto i = batch_start; i != batch_end; ++i) {
+      const auto& table_info = tables[i];
+      auto ltm = table_info->LockForRead();
 
-    if (req->has_name_filter()) {
-      size_t found = ltm->name().find(req->name_filter());
-      if (found == string::npos) {
+      if (!ltm->visible_to_client() && !req->include_not_running()) {
         continue;
       }
-    }
 
-    if (IsUserIndexUnlocked(*table_info)) {
-      if (!include_user_index) {
-        continue;
+      if (!namespace_id.empty() && namespace_id != table_info->namespace_id()) {
+        continue; // Skip tables from other namespaces.
       }
-      relation_type = INDEX_TABLE_RELATION;
-    } else if (IsMatviewTable(*table_info)) {
-      if (!include_user_matview) {
-        continue;
+
+      if (req->has_name_filter()) {
+        size_t found = ltm->name().find(req->name_filter());
+        if (found == string::npos) {
+          continue;
+        }
       }
-      relation_type = MATVIEW_TABLE_RELATION;
-    } else if (IsUserTableUnlocked(*table_info)) {
-      if (!include_user_table) {
-        continue;
+
+      if (IsUserIndexUnlocked(*table_info)) {
+        if (!include_user_index) {
+          continue;
+        }
+        relation_type = INDEX_TABLE_RELATION;
+      } else if (IsMatviewTable(*table_info)) {
+        if (!include_user_matview) {
+          continue;
+        }
+        relation_type = MATVIEW_TABLE_RELATION;
+      } else if (IsUserTableUnlocked(*table_info)) {
+        if (!include_user_table) {
+          continue;
+        }
+        relation_type = USER_TABLE_RELATION;
+      } else {
+        if (!include_system_table) {
+          continue;
+        }
+        relation_type = SYSTEM_TABLE_RELATION;
       }
-      relation_type = USER_TABLE_RELATION;
-    } else {
-      if (!include_system_table) {
+
+      NamespaceIdentifierPB ns_identifier;
+      ns_identifier.set_id(ltm->namespace_id());
+      auto ns = FindNamespaceUnlocked(ns_identifier);
+      if (!ns.ok() || (**ns).state() != SysNamespaceEntryPB::RUNNING) {
+        if (PREDICT_FALSE(FLAGS_TEST_return_error_if_namespace_not_found)) {
+          VERIFY_NAMESPACE_FOUND(std::move(ns), resp);
+        }
+        LOG(ERROR) << "Unable to find namespace with id " << ltm->namespace_id()
+                   << " for table " << ltm->name();
         continue;
       }
-      relation_type = SYSTEM_TABLE_RELATION;
-    }
 
-    NamespaceIdentifierPB ns_identifier;
-    ns_identifier.set_id(ltm->namespace_id());
-    auto ns = FindNamespaceUnlocked(ns_identifier);
-    if (!ns.ok() || (**ns).state() != SysNamespaceEntryPB::RUNNING) {
-      if (PREDICT_FALSE(FLAGS_TEST_return_error_if_namespace_not_found)) {
-        VERIFY_NAMESPACE_FOUND(std::move(ns), resp);
+      ListTablesResponsePB::TableInfo *table = resp->add_tables();
+      {
+        auto namespace_lock = (**ns).LockForRead();
+        table->mutable_namespace_()->set_id((**ns).id());
+        table->mutable_namespace_()->set_name(namespace_lock->name());
+        table->mutable_namespace_()->set_database_type(namespace_lock->pb.database_type());
       }
-      LOG(ERROR) << "Unable to find namespace with id " << ltm->namespace_id()
-                 << " for table " << ltm->name();
-      continue;
-    }
-
-    ListTablesResponsePB::TableInfo *table = resp->add_tables();
-    {
-      auto namespace_lock = (**ns).LockForRead();
-      table->mutable_namespace_()->set_id((**ns).id());
-      table->mutable_namespace_()->set_name(namespace_lock->name());
-      table->mutable_namespace_()->set_database_type(namespace_lock->pb.database_type());
+      table->set_id(table_info->id());
+      table->set_name(ltm->name());
+      table->set_table_type(ltm->table_type());
+      table->set_relation_type(relation_type);
+      table->set_state(ltm->pb.state());
+      table->set_pgschema_name(ltm->schema().pgschema_name());
     }
-    table->set_id(table_info->id());
-    table->set_name(ltm->name());
-    table->set_table_type(ltm->table_type());
-    table->set_relation_type(relation_type);
-    table->set_state(ltm->pb.state());
-    table->set_pgschema_name(ltm->schema().pgschema_name());
   }
   return Status::OK();
 }
@@ -10421,9 +10457,7 @@ void CatalogManager::ExtractTabletsToProcess(
 }
 
 bool CatalogManager::AreTablesDeleting() {
-  SharedLock lock(mutex_);
-
-  for (const auto& table : tables_->GetAllTables()) {
+  for (const auto& table : GetTables(GetTablesMode::kAll)) {
     auto table_lock = table->LockForRead();
     // TODO(jason): possibly change this to started_deleting when we begin removing DELETED tables
     // from tables_ (see CleanUpDeletedTables).
@@ -10909,6 +10943,10 @@ Result<vector<shared_ptr<TSDescriptor>>> CatalogManager::FindTServersForPlacemen
 Status CatalogManager::SendCreateTabletRequests(const vector<TabletInfo*>& tablets) {
   auto schedules_to_tablets_map = VERIFY_RESULT(MakeSnapshotSchedulesToObjectIdsMap(
       SysRowEntryType::TABLET));
+  const bool batch = FLAGS_master_batch_create_tablet_rpcs;
+  const size_t max_batch_size = std::max(FLAGS_master_max_tablets_per_create_tablets_rpc, 1);
+  // Replicas to create, grouped by table and then by tablet server.
+  std::map<TableId, std::map<TabletServerId, std::vector<TabletToCreate>>> batches;
   for (TabletInfo *tablet : tablets) {
     const consensus::RaftConfigPB& config =
         tablet->metadata().dirty().pb.committed_consensus_state().config();
@@ -10920,6 +10958,13 @@ Status CatalogManager::SendCreateTabletRequests(const vector<TabletInfo*>& table
       }
     }
     for (const RaftPeerPB& peer : config.peers()) {
+      if (batch) {
+        batches[tablet->table()->id()][peer.permanent_uuid()].push_back(TabletToCreate {
+          .tablet = tablet,
+          .snapshot_schedules = schedules,
+        });
+        continue;
+      }
       auto task = std::make_shared<AsyncCreateReplica>(master_, AsyncTaskPool(),
           peer.permanent_uuid(), tablet, schedules);
       tablet->table()->AddTask(task);
@@ -10927,6 +10972,19 @@ Status CatalogManager::SendCreateTabletRequests(const vector<TabletInfo*>& table
     }
   }
 
+  for (const auto& [table_id, table_batches] : batches) {
+    for (const auto& [ts_uuid, ts_tablets] : table_batches) {
+      for (size_t begin = 0; begin < ts_tablets.size(); begin += max_batch_size) {
+        auto end = std::min(begin + max_batch_size, ts_tablets.size());
+        auto task = std::make_shared<AsyncCreateReplicas>(
+            master_, AsyncTaskPool(), ts_uuid,
+            std::vector<TabletToCreate>(ts_tablets.begin() + begin, ts_tablets.begin() + end));
+        ts_tablets.front().tablet->table()->AddTask(task);
+        WARN_NOT_OK(ScheduleTask(task), "Failed to send new tablets request");
+      }
+    }
+  }
+
   return Status::OK();
 }
 
@@ -12206,7 +12264,9 @@ void CatalogManager::ProcessTabletStorageMetadata(
         storage_metadata.sst_file_size(),
         storage_metadata.wal_file_size(),
         storage_metadata.uncompressed_sst_file_size(),
-        storage_metadata.may_have_orphaned_post_split_data()};
+        storage_metadata.may_have_orphaned_post_split_data(),
+        storage_metadata.read_ops_per_sec(),
+        storage_metadata.write_ops_per_sec()};
   tablet->UpdateReplicaDriveInfo(ts_uuid, drive_info);
 }
 
@@ -12270,8 +12330,7 @@ void CatalogManager::InitializeGlobalLoadState(
     state->per_ts_protege_load_[ts->permanent_uuid()];
   }
 
-  SharedLock l(mutex_);
-  for (const auto& info : tables_->GetAllTables()) {
+  for (const auto& info : GetTables(GetTablesMode::kAll)) {
     // Ignore system, colocated and deleting/deleted tables.
     {
       auto l = info->LockForRead();
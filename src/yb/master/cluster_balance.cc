@@ -117,6 +117,12 @@ DEFINE_RUNTIME_bool(load_balancer_drive_aware, true,
     "When LB decides to move a tablet from server A to B, on the target LB "
     "should select the tablet to move from most loaded drive.");
 
+DEFINE_RUNTIME_bool(load_balancer_leader_balancing_by_ops, false,
+    "When set, leaders are balanced by the read and write ops reported for each tablet leader "
+    "instead of by their count. A leader counts for its ops relative to the average leader of its "
+    "table, and is only moved if that reduces the imbalance between the two tablet servers.");
+TAG_FLAG(load_balancer_leader_balancing_by_ops, advanced);
+
 DEFINE_RUNTIME_bool(load_balancer_ignore_cloud_info_similarity, false,
     "If true, ignore the similarity between cloud infos when deciding which tablet to move");
 
@@ -1198,6 +1204,12 @@ Result<bool> ClusterLoadBalancer::GetLeaderToMove(
       for (const auto& tablet : GetLeadersOnTSToMove(global_state_->drive_aware_,
                                                      leaders,
                                                      state_->per_ts_meta_[low_load_uuid])) {
+        // A leader that weighs as much as the imbalance would just move the imbalance to the
+        // other tablet server, and the next run would move it back.
+        if (!high_leader_blacklisted && !is_global_balancing_move &&
+            implicit_cast<ssize_t>(state_->GetLeaderWeight(tablet.first)) >= load_variance) {
+          continue;
+        }
         *moving_tablet_id = tablet.first;
         *to_ts_path = tablet.second;
         *from_ts = high_load_uuid;
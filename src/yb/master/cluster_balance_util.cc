@@ -13,6 +13,8 @@
 
 #include "yb/master/cluster_balance_util.h"
 
+#include <cmath>
+
 #include "yb/gutil/map-util.h"
 
 #include "yb/master/catalog_entity_info.h"
@@ -33,6 +35,8 @@ DECLARE_int32(replication_factor);
 
 DECLARE_bool(allow_leader_balancing_dead_node);
 
+DECLARE_bool(load_balancer_leader_balancing_by_ops);
+
 namespace yb {
 namespace master {
 
@@ -52,7 +56,8 @@ std::string CBTabletMetadata::ToString() const {
       running, starting, is_under_replicated, under_replicated_placements,
       is_over_replicated, over_replicated_tablet_servers,
       wrong_placement_tablet_servers, blacklisted_tablet_servers,
-      leader_uuid, leader_stepdown_failures, leader_blacklisted_tablet_servers);
+      leader_uuid, leader_stepdown_failures, leader_blacklisted_tablet_servers,
+      leader_ops_per_sec);
 }
 
 int GlobalLoadState::GetGlobalLoad(const TabletServerId& ts_uuid) const {
@@ -67,6 +72,7 @@ int GlobalLoadState::GetGlobalLeaderLoad(const TabletServerId& ts_uuid) const {
 
 PerTableLoadState::PerTableLoadState(GlobalLoadState* global_state)
     : leader_balance_threshold_(FLAGS_leader_balance_threshold),
+      leader_balancing_by_ops_(FLAGS_load_balancer_leader_balancing_by_ops),
       current_time_(MonoTime::Now()),
       global_state_(global_state) {}
 
@@ -119,7 +125,27 @@ size_t PerTableLoadState::GetLoad(const TabletServerId& ts_uuid) const {
 }
 
 size_t PerTableLoadState::GetLeaderLoad(const TabletServerId& ts_uuid) const {
-  return per_ts_meta_.at(ts_uuid).leaders.size();
+  const auto& leaders = per_ts_meta_.at(ts_uuid).leaders;
+  if (!leader_balancing_by_ops_) {
+    return leaders.size();
+  }
+  size_t load = 0;
+  for (const auto& tablet_id : leaders) {
+    load += GetLeaderWeight(tablet_id);
+  }
+  return load;
+}
+
+size_t PerTableLoadState::GetLeaderWeight(const TabletId& tablet_id) const {
+  if (!leader_balancing_by_ops_ || num_leaders_ == 0 || total_leader_ops_per_sec_ <= 0) {
+    return 1;
+  }
+  auto it = per_tablet_meta_.find(tablet_id);
+  if (it == per_tablet_meta_.end()) {
+    return 1;
+  }
+  const auto average_ops_per_sec = total_leader_ops_per_sec_ / num_leaders_;
+  return std::max<size_t>(1, std::llround(it->second.leader_ops_per_sec / average_ops_per_sec));
 }
 
 bool PerTableLoadState::ShouldSkipReplica(const TabletReplica& replica) {
@@ -216,6 +242,10 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
     // Fill leader info.
     if (replica.role == PeerRole::LEADER) {
       tablet_meta.leader_uuid = ts_uuid;
+      tablet_meta.leader_ops_per_sec =
+          replica.drive_info.read_ops_per_sec + replica.drive_info.write_ops_per_sec;
+      total_leader_ops_per_sec_ += tablet_meta.leader_ops_per_sec;
+      ++num_leaders_;
       RETURN_NOT_OK(AddLeaderTablet(tablet_id, ts_uuid, replica.fs_data_dir));
     }
 
@@ -107,6 +107,9 @@ struct CBTabletMetadata {
   // Leader stepdown failures. We use this to prevent retrying the same leader stepdown too soon.
   LeaderStepDownFailureTimes leader_stepdown_failures;
 
+  // Read and write ops per second reported by the leader of this tablet.
+  double leader_ops_per_sec = 0;
+
   std::string ToString() const;
 };
 
@@ -283,9 +286,14 @@ class PerTableLoadState {
   // Get the load for a certain TS.
   size_t GetLoad(const TabletServerId& ts_uuid) const;
 
-  // Get the load for a certain TS.
+  // Get the leader load for a certain TS. This is the number of leaders on the TS, unless
+  // leaders are balanced by ops, in which case each leader counts for its weight.
   size_t GetLeaderLoad(const TabletServerId& ts_uuid) const;
 
+  // Get the weight of the leader of a certain tablet: its reported ops relative to the average
+  // leader of this table, rounded and at least 1. Always 1 unless leaders are balanced by ops.
+  size_t GetLeaderWeight(const TabletId& tablet_id) const;
+
   bool IsTsInLivePlacement(TSDescriptor* ts_desc) {
     return ts_desc->placement_uuid() == options_->live_placement_uuid;
   }
@@ -391,6 +399,13 @@ class PerTableLoadState {
   // Number of leaders per each tablet server to balance below.
   const int leader_balance_threshold_ = 0;
 
+  // Whether leader load is weighted by the ops reported for each leader.
+  const bool leader_balancing_by_ops_ = false;
+
+  // Sum of leader_ops_per_sec and number of leaders of this table, used to get leader weights.
+  double total_leader_ops_per_sec_ = 0;
+  size_t num_leaders_ = 0;
+
   // Table server ids that are eligible for leader placement.
   // The outer list is sorted by descending priority (value 1 is highest priority).
   // The inner list servers are sorted by ascending leader load.
@@ -93,6 +93,10 @@ bool MasterTabletServer::LeaderAndReady(const TabletId& tablet_id, bool allow_st
   return (**tablet_peer).LeaderStatus(allow_stale) == consensus::LeaderStatus::LEADER_AND_READY;
 }
 
+HybridTime MasterTabletServer::SafeTimeForFollowerRead(const TabletId&) const {
+  return HybridTime::kInvalid;
+}
+
 const NodeInstancePB& MasterTabletServer::NodeInstance() const {
   return master_->catalog_manager()->NodeInstance();
 }
@@ -45,6 +45,8 @@ class MasterTabletServer : public tserver::TabletServerIf,
 
   bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const override;
 
+  HybridTime SafeTimeForFollowerRead(const TabletId& tablet_id) const override;
+
   const NodeInstancePB& NodeInstance() const override;
 
   Status GetRegistration(ServerRegistrationPB* reg) const override;
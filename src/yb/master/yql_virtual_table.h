@@ -116,6 +116,18 @@ class YQLVirtualTable : public docdb::YQLStorageIf {
     return Status::OK();
   }
 
+  Status GetIteratorForYbctids(
+      uint64 stmt_id,
+      const Schema& projection,
+      std::reference_wrapper<const docdb::DocReadContext> doc_read_context,
+      const TransactionOperationContext& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      docdb::YQLRowwiseIteratorIf::UniPtr* iter) const override {
+    LOG(FATAL) << "Postgresql virtual tables are not yet implemented";
+    return Status::OK();
+  }
+
  protected:
   // Finds the given column name in the schema and updates the specified column in the given row
   // with the provided value.
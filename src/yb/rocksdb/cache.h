@@ -37,6 +37,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 
 #include "yb/rocksdb/statistics.h"
@@ -66,6 +67,14 @@ extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern std::shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache that uses CLOCK eviction policy. Lookups in this cache don't take exclusive
+// locks, so it scales better than LRU cache for read heavy workloads on many cores.
+// It does not distinguish single touch and multi touch entries, all entries are treated as multi
+// touch. Sharding and capacity semantics are the same as for NewLRUCache.
+extern std::shared_ptr<Cache> NewClockCache(size_t capacity);
+extern std::shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                            bool strict_capacity_limit);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -184,6 +193,13 @@ class Cache {
   virtual void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
                                       bool thread_safe) = 0;
 
+  using CacheKeyCallback = std::function<void(const Slice& key, SubCacheType subcache_type)>;
+
+  // Apply callback to the key of every entry in the cache, together with the sub cache the entry
+  // is in. Locks one shard at a time, so the callback should be cheap. The key is only valid
+  // during the call.
+  virtual void ApplyToAllCacheKeys(const CacheKeyCallback& callback) {}
+
   virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) = 0;
 
   // Tries to evict specified amount of bytes from cache.
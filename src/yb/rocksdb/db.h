@@ -56,6 +56,7 @@ struct CompactionOptions;
 struct CompactRangeOptions;
 struct TableProperties;
 struct ExternalSstFileInfo;
+class BlockCacheKeys;
 class WriteBatch;
 class Env;
 class EventListener;
@@ -826,6 +827,18 @@ class DB {
 
   virtual void ListenFilesChanged(std::function<void()> listener) {}
 
+  // Saves the list of data blocks of live SST files that are in the block cache, according to
+  // cache_keys, so that WarmUpBlockCache could load them back after a restart.
+  virtual Status SaveBlockCacheWarmupState(const BlockCacheKeys& cache_keys) {
+    return Status::OK();
+  }
+
+  // Loads the data blocks listed by the last SaveBlockCacheWarmupState into the block cache.
+  // Returns the number of blocks read.
+  virtual yb::Result<size_t> WarmUpBlockCache() {
+    return 0;
+  }
+
   // Obtains the meta data of the specified column family of the DB.
   // STATUS(NotFound, "") will be returned if the current DB does not have
   // any column family match the specified name.
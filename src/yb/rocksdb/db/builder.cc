@@ -169,6 +169,9 @@ Status BuildTable(const std::string& dbname,
     }
 
     boost::container::small_vector<UserBoundaryValueRef, 0x10> user_values;
+    const bool extract_from_values =
+        boundary_values_extractor && boundary_values_extractor->ExtractsFromValues();
+    std::string value_boundaries_buffer;
     for (; c_iter.Valid(); c_iter.Next()) {
       const Slice& key = c_iter.key();
       const Slice& value = c_iter.value();
@@ -177,6 +180,10 @@ Status BuildTable(const std::string& dbname,
       if (boundary_values_extractor) {
         user_values.clear();
         auto status = boundary_values_extractor->Extract(ExtractUserKey(key), &user_values);
+        if (status.ok() && extract_from_values) {
+          status = boundary_values_extractor->ExtractFromValue(
+              ExtractUserKey(key), value, &value_boundaries_buffer, &user_values);
+        }
         if (!status.ok()) {
           builder->Abandon();
           return status;
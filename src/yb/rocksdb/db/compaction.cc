@@ -588,7 +588,15 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level, every input and the output are in level 0, so the key ranges of
+    // subcompactions are taken from the boundaries of the input files. Each output file is then
+    // a separate sorted run, and would trigger another compaction if automatic compactions
+    // formed subcompactions too. So only manual full compactions are split, and the automatic
+    // compaction that may follow merges their outputs on a single thread.
+    if (number_levels_ == 1) {
+      return is_manual_compaction_ && is_full_compaction_;
+    }
+    return output_level_ > 0;
   } else {
     return false;
   }
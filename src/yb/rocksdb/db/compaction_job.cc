@@ -111,6 +111,7 @@ struct CompactionJob::SubcompactionState : public CompactionFeed {
 
   CompactionFeed* feed = nullptr; // Owned externally.
   CompactionContextPtr context;
+  UserFrontierPtr largest_user_frontier;
 
   Output* current_output() {
     if (outputs.empty()) {
@@ -428,7 +429,17 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (db_options_.subcompaction_boundary_extractor) {
+          boundary = db_options_.subcompaction_boundary_extractor(boundary);
+          // Keep the range in the current subcompaction when its limit could not be aligned,
+          // or is aligned to the previous boundary.
+          if (boundary.empty() || (!boundaries_.empty() &&
+                                   cfd_comparator->Compare(boundary, boundaries_.back()) <= 0)) {
+            continue;
+          }
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -711,7 +722,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
   // filter.
   if (sub_compact->context) {
-    largest_user_frontier_ = sub_compact->context->GetLargestUserFrontier();
+    sub_compact->largest_user_frontier = sub_compact->context->GetLargestUserFrontier();
   }
 
   sub_compact->num_input_records = c_iter_stats.num_input_records;
@@ -939,13 +950,19 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  UserFrontierPtr largest_user_frontier;
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
       compaction->edit()->AddFile(compaction->output_level(), out.meta);
     }
+    if (sub_compact.largest_user_frontier) {
+      UpdateUserFrontier(
+          &largest_user_frontier, sub_compact.largest_user_frontier,
+          UpdateUserValueType::kLargest);
+    }
   }
-  if (largest_user_frontier_) {
-    compaction->edit()->UpdateFlushedFrontier(largest_user_frontier_);
+  if (largest_user_frontier) {
+    compaction->edit()->UpdateFlushedFrontier(largest_user_frontier);
   }
   return versions_->LogAndApply(compaction->column_family_data(),
                                 mutable_cf_options, compaction->edit(),
@@ -1007,7 +1024,9 @@ Status CompactionJob::OpenCompactionOutputFile(
   ColumnFamilyData* cfd = sub_compact->compaction->column_family_data();
 
   {
-    auto setup_outfile = [this, sub_compact] (
+    EnvOptions writer_env_options = env_options_;
+    writer_env_options.drop_os_cache_after_sync = db_options_.compaction_drop_os_cache;
+    auto setup_outfile = [sub_compact, &writer_env_options] (
         size_t preallocation_block_size, std::unique_ptr<WritableFile>* writable_file,
         std::unique_ptr<WritableFileWriter>* writer) {
       (*writable_file)->SetIOPriority(yb::IOPriority::kLow);
@@ -1015,7 +1034,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), writer_env_options, sub_compact->compaction->suspender()));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -178,8 +178,6 @@ class CompactionJob {
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
-
-  UserFrontierPtr largest_user_frontier_;
 };
 
 }  // namespace rocksdb
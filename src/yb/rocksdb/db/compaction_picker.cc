@@ -54,6 +54,12 @@ DEFINE_UNKNOWN_bool(aggressive_compaction_for_read_amp, false,
             "Determines if we should compact aggressively to reduce read amplification based on "
             "number of files alone, without regards to relative sizes of the SSTable files.");
 
+DEFINE_RUNTIME_bool(compaction_delete_expired_files_below_trigger, true,
+            "Schedule a universal compaction as soon as the compaction file filter finds files "
+            "that could be deleted directly, without waiting for the number of files to reach "
+            "level0_file_num_compaction_trigger.");
+TAG_FLAG(compaction_delete_expired_files_below_trigger, advanced);
+
 namespace rocksdb {
 
 namespace {
@@ -482,6 +488,28 @@ void CompactionPicker::MarkL0FilesForDeletion(
   }
 }
 
+bool CompactionPicker::HasL0FilesForDeletion(
+    const VersionStorageInfo* vstorage,
+    const ImmutableCFOptions* ioptions) {
+  if (!ioptions->compaction_file_filter_factory) {
+    return false;
+  }
+  // Same check as MarkL0FilesForDeletion, but leaves the files unmarked. The files are marked when
+  // the compaction is picked.
+  auto file_filter = ioptions->compaction_file_filter_factory->CreateCompactionFileFilter(
+      vstorage->LevelFiles(0));
+  for (const FileMetaData* f : vstorage->LevelFiles(0)) {
+    if (f->being_compacted) {
+      continue;
+    }
+    if (f->delete_after_compaction() ||
+        (file_filter && file_filter->Filter(f) == FilterDecision::kDiscard)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
     VersionStorageInfo* vstorage, int input_level, int output_level,
@@ -1184,7 +1212,16 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  // Expired files are dropped without being read, so there is no reason to keep them around until
+  // enough new files are flushed. PickCompactionUniversalDeletion does not depend on the trigger.
+  if (!FLAGS_compaction_delete_expired_files_below_trigger ||
+      !ioptions_.compaction_file_filter_factory || vstorage->num_levels() > 1) {
+    return false;
+  }
+  return HasL0FilesForDeletion(vstorage, &ioptions_);
 }
 
 struct UniversalCompactionPicker::SortedRun {
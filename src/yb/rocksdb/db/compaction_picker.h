@@ -185,6 +185,11 @@ class CompactionPicker {
   static void MarkL0FilesForDeletion(const VersionStorageInfo* vstorage,
                                      const ImmutableCFOptions* ioptions);
 
+  // Returns true if a level 0 file that is not being compacted could be deleted by compaction
+  // without being read.
+  static bool HasL0FilesForDeletion(const VersionStorageInfo* vstorage,
+                                    const ImmutableCFOptions* ioptions);
+
   const ImmutableCFOptions& ioptions_;
 
   // A helper function to SanitizeCompactionInputFiles() that
@@ -22,6 +22,9 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
+#include "yb/rocksdb/util/block_cache_warmup.h"
+
+#include "yb/util/test_macros.h"
 
 DECLARE_double(cache_single_touch_ratio);
 DECLARE_bool(cache_overflow_single_touch);
@@ -217,6 +220,45 @@ TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
 }
 #endif
 
+TEST_F(DBBlockCacheTest, WarmUpAfterReopen) {
+  auto table_options = GetTableOptions();
+  table_options.block_cache = NewLRUCache(8 * 1024 * 1024);
+  auto options = GetOptions(table_options);
+  DestroyAndReopen(options);
+  InitTable(options);
+  ASSERT_OK(Flush());
+
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_NE("NOT_FOUND", Get(ToString(i)));
+  }
+  ASSERT_OK(db_->SaveBlockCacheWarmupState(
+      BlockCacheKeys::Collect(table_options.block_cache.get())));
+
+  // Reopen with an empty block cache, and load the blocks recorded above.
+  table_options.block_cache = NewLRUCache(8 * 1024 * 1024);
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_EQ(kNumBlocks, ASSERT_RESULT(db_->WarmUpBlockCache()));
+
+  auto data_misses = TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS);
+  for (size_t i = 0; i < kNumBlocks; i++) {
+    ASSERT_NE("NOT_FOUND", Get(ToString(i)));
+  }
+  ASSERT_EQ(data_misses, TestGetTickerCount(options, BLOCK_CACHE_DATA_MISS));
+}
+
+TEST_F(DBBlockCacheTest, WarmUpStateEncoding) {
+  CachedBlocksByFile blocks;
+  blocks[7] = {{0, SINGLE_TOUCH}, {4096, MULTI_TOUCH}, {100000, SINGLE_TOUCH}};
+  blocks[12] = {{512, MULTI_TOUCH}};
+  auto encoded = EncodeCachedBlocks(blocks);
+  ASSERT_EQ(blocks, ASSERT_RESULT(DecodeCachedBlocks(encoded)));
+
+  encoded[encoded.size() / 2] ^= 1;
+  ASSERT_NOK(DecodeCachedBlocks(encoded));
+  ASSERT_NOK(DecodeCachedBlocks(Slice()));
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -571,6 +571,46 @@ TEST_F(DBCompactionTest, DisableStatsUpdateReopen) {
   }
 }
 
+TEST_F(DBCompactionTest, CompensatedSizeAfterReopen) {
+  // Compaction scoring uses the compensated file size, which boosts files with many deletions. It
+  // is only computed from the table properties of files that existed before the DB was opened when
+  // their stats are loaded on open.
+  Options options = CurrentOptions();
+  options.compression = kNoCompression;
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+  Random rnd(301);
+
+  const int kNumKeys = 100;
+  for (int k = 0; k < kNumKeys; ++k) {
+    ASSERT_OK(Put(Key(k), RandomString(&rnd, 100)));
+  }
+  ASSERT_OK(Flush());
+  for (int k = 0; k < kNumKeys; ++k) {
+    ASSERT_OK(Delete(Key(k)));
+  }
+  ASSERT_OK(Flush());
+
+  for (bool skip_stats : {false, true}) {
+    options.skip_stats_update_on_db_open = skip_stats;
+    Reopen(options);
+
+    std::vector<std::vector<FileMetaData>> files;
+    dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+    ASSERT_EQ(files[0].size(), 2);
+    size_t num_files_with_deletions = 0;
+    for (const auto& file : files[0]) {
+      if (file.num_deletions > 0) {
+        ++num_files_with_deletions;
+        ASSERT_GT(file.compensated_file_size, file.fd.GetTotalFileSize());
+      } else {
+        ASSERT_EQ(file.compensated_file_size, file.fd.GetTotalFileSize());
+      }
+    }
+    ASSERT_EQ(num_files_with_deletions, skip_stats ? 0 : 1);
+  }
+}
+
 
 TEST_P(DBCompactionTestWithParam, CompactionTrigger) {
   const int kNumKeysPerFile = 100;
@@ -2717,6 +2757,117 @@ TEST_P(DBCompactionTestWithParam, ForceBottommostLevelCompaction) {
   rocksdb::SyncPoint::GetInstance()->DisableProcessing();
 }
 
+TEST_P(DBCompactionTestWithParam, SingleLevelUniversalSubcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kGroupsPerFile = 10;
+  // Neighbouring files share groups, so subcompaction boundaries taken from file boundaries have
+  // to be aligned to keep every group in a single subcompaction.
+  constexpr int kOverlappingGroups = 2;
+  constexpr int kKeysPerGroup = 10;
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.max_subcompactions = max_subcompactions_;
+  options.target_file_size_base = 4096;
+  // The group of a key is the prefix before '_'.
+  options.subcompaction_boundary_extractor = [](Slice user_key) {
+    auto* pos = std::find(user_key.cdata(), user_key.cend(), '_');
+    return pos == user_key.cend() ? Slice() : Slice(user_key.cdata(), pos);
+  };
+  DestroyAndReopen(options);
+
+  auto group_key = [](int group, int key) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "g%04d_%04d", group, key);
+    return std::string(buf);
+  };
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  for (int file = 0; file != kNumFiles; ++file) {
+    for (int group = file * kGroupsPerFile;
+         group != (file + 1) * kGroupsPerFile + kOverlappingGroups; ++group) {
+      for (int key = 0; key != kKeysPerGroup; ++key) {
+        auto value = RandomString(&rnd, 100);
+        ASSERT_OK(Put(group_key(group, key), value));
+        expected[group_key(group, key)] = value;
+      }
+    }
+    ASSERT_OK(Flush());
+  }
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+
+  std::vector<LiveFileMetaData> files;
+  db_->GetLiveFilesMetaData(&files);
+  if (max_subcompactions_ > 1) {
+    ASSERT_GT(files.size(), 1);
+  } else {
+    ASSERT_EQ(files.size(), 1);
+  }
+  std::sort(files.begin(), files.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.smallest.key < rhs.smallest.key;
+  });
+  for (size_t i = 1; i < files.size(); ++i) {
+    ASSERT_LT(files[i - 1].largest.key.substr(0, 5), files[i].smallest.key.substr(0, 5));
+  }
+
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(Get(key), value);
+  }
+}
+
+// Outputs of a single level subcompacted compaction are separate sorted runs. Automatic
+// compactions must merge them back without splitting again, instead of compacting forever.
+TEST_P(DBCompactionTestWithParam, SingleLevelUniversalSubcompactionsAutoCompaction) {
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 100;
+
+  Options options = CurrentOptions();
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.disable_auto_compactions = true;
+  options.level0_file_num_compaction_trigger = 2;
+  options.max_subcompactions = max_subcompactions_;
+  DestroyAndReopen(options);
+
+  Random rnd(301);
+  std::map<std::string, std::string> expected;
+  auto write_files = [this, &rnd, &expected](int first_file, int num_files) {
+    for (int file = first_file; file != first_file + num_files; ++file) {
+      for (int i = 0; i != kKeysPerFile; ++i) {
+        auto key = Key(file * kKeysPerFile + i);
+        auto value = RandomString(&rnd, 100);
+        ASSERT_OK(Put(key, value));
+        expected[key] = value;
+      }
+      ASSERT_OK(Flush());
+    }
+  };
+
+  ASSERT_NO_FATALS(write_files(0, kNumFiles));
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  if (max_subcompactions_ > 1) {
+    ASSERT_GT(NumTableFilesAtLevel(0), 1);
+  } else {
+    ASSERT_EQ(NumTableFilesAtLevel(0), 1);
+  }
+
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "false"}}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(NumTableFilesAtLevel(0), 1);
+
+  ASSERT_NO_FATALS(write_files(kNumFiles, kNumFiles));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(NumTableFilesAtLevel(0), 1);
+
+  for (const auto& [key, value] : expected) {
+    ASSERT_EQ(Get(key), value);
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(DBCompactionTestWithParam, DBCompactionTestWithParam,
                         ::testing::Values(std::make_tuple(1, true),
                                           std::make_tuple(1, false),
@@ -98,6 +98,7 @@
 #include "yb/rocksdb/table/scoped_arena_iterator.h"
 #include "yb/rocksdb/table/table_builder.h"
 #include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/block_cache_warmup.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/crc32c.h"
@@ -742,12 +743,16 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname)
       opened_successfully_(false) {
   CHECK_OK(env_->GetAbsolutePath(dbname, &db_absolute_path_));
 
-  // Reserve ten files or so for other uses and give the rest to TableCache.
-  // Give a large number for setting of "infinite" open files.
-  const int table_cache_size = (db_options_.max_open_files == -1) ?
-        4194304 : db_options_.max_open_files - 10;
-  table_cache_ =
-      NewLRUCache(table_cache_size, db_options_.table_cache_numshardbits);
+  if (db_options_.table_cache) {
+    table_cache_ = NewSharedTableCache(db_options_.table_cache);
+  } else {
+    // Reserve ten files or so for other uses and give the rest to TableCache.
+    // Give a large number for setting of "infinite" open files.
+    const int table_cache_size = (db_options_.max_open_files == -1) ?
+          4194304 : db_options_.max_open_files - 10;
+    table_cache_ =
+        NewLRUCache(table_cache_size, db_options_.table_cache_numshardbits);
+  }
 
   versions_.reset(new VersionSet(dbname_, &db_options_, env_options_,
                                  table_cache_.get(), &write_buffer_,
@@ -3023,6 +3028,87 @@ FlushAbility DBImpl::GetFlushAbility() {
   return cfd->mem()->IsEmpty() ? FlushAbility::kNoNewData : FlushAbility::kHasNewData;
 }
 
+Status DBImpl::ForEachLiveTableReader(
+    bool no_io, const std::function<Status(uint64_t, TableReader*)>& callback) {
+  auto cfd = default_cf_handle_->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  auto scope_exit = yb::ScopeExit([this, cfd, sv] {
+    ReturnAndCleanupSuperVersion(cfd, sv);
+  });
+
+  const auto* storage_info = sv->current->storage_info();
+  for (int level = 0; level < storage_info->num_levels(); ++level) {
+    for (const auto* file : storage_info->LevelFiles(level)) {
+      auto trwh = cfd->table_cache()->GetTableReader(
+          env_options_, cfd->internal_comparator(), file->fd, kDefaultQueryId, no_io,
+          /* file_read_hist = */ nullptr, /* skip_filters = */ false);
+      if (!trwh.ok()) {
+        if (no_io && trwh.status().IsIncomplete()) {
+          continue;
+        }
+        return trwh.status();
+      }
+      RETURN_NOT_OK(callback(file->fd.GetNumber(), trwh->table_reader));
+    }
+  }
+  return Status::OK();
+}
+
+Status DBImpl::SaveBlockCacheWarmupState(const BlockCacheKeys& cache_keys) {
+  CachedBlocksByFile blocks;
+  RETURN_NOT_OK(ForEachLiveTableReader(
+      /* no_io = */ true, [&blocks, &cache_keys](uint64_t file_number, TableReader* reader) {
+        auto file_blocks = reader->GetCachedDataBlocks(cache_keys);
+        if (!file_blocks.empty()) {
+          blocks.emplace(file_number, std::move(file_blocks));
+        }
+        return Status::OK();
+      }));
+
+  const auto path = dbname_ + "/" + kBlockCacheWarmupFileName;
+  if (blocks.empty()) {
+    if (env_->FileExists(path).ok()) {
+      return env_->DeleteFile(path);
+    }
+    return Status::OK();
+  }
+  const auto tmp_path = path + ".tmp";
+  RETURN_NOT_OK(WriteStringToFile(
+      env_, EncodeCachedBlocks(blocks), tmp_path, /* should_sync = */ true));
+  return env_->RenameFile(tmp_path, path);
+}
+
+yb::Result<size_t> DBImpl::WarmUpBlockCache() {
+  const auto path = dbname_ + "/" + kBlockCacheWarmupFileName;
+  if (!env_->FileExists(path).ok()) {
+    return 0;
+  }
+  std::string data;
+  RETURN_NOT_OK(ReadFileToString(env_, path, &data));
+  auto blocks = DecodeCachedBlocks(data);
+  if (!blocks.ok()) {
+    // The file is only a hint, so a bad one is dropped rather than failing the warm-up.
+    LOG_WITH_PREFIX(WARNING) << "Ignoring " << path << ": " << blocks.status();
+    return 0;
+  }
+
+  size_t result = 0;
+  RETURN_NOT_OK(ForEachLiveTableReader(
+      /* no_io = */ false,
+      [this, &blocks, &result](uint64_t file_number, TableReader* reader) -> Status {
+        if (IsShuttingDown()) {
+          return STATUS(ShutdownInProgress, "Block cache warm-up interrupted by shutdown");
+        }
+        auto it = blocks->find(file_number);
+        if (it != blocks->end()) {
+          result += VERIFY_RESULT(reader->WarmUpDataBlocks(
+              it->second, [this] { return IsShuttingDown(); }));
+        }
+        return Status::OK();
+      }));
+  return result;
+}
+
 Status DBImpl::FlushMemTable(ColumnFamilyData* cfd,
                              const FlushOptions& flush_options) {
   Status s;
@@ -5102,6 +5188,10 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     // 5. YugaByte-specific user-specified sequence numbers are currently not compatible with
     //    parallel memtable writes.
     //
+    // 6. Batches with a direct writer are not okay. The number of their entries is only known
+    //    after the insert, so sequence numbers of the following batches cannot be assigned
+    //    upfront.
+    //
     // Rules 1..3 are enforced by checking the options
     // during startup (CheckConcurrentWritesSupported), so if
     // options.allow_concurrent_memtable_write is true then they can be
@@ -5117,7 +5207,7 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         total_count += WriteBatchInternal::Count(writer->batch);
         total_byte_size = WriteBatchInternal::AppendedByteSize(
             total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
-        parallel = parallel && !writer->batch->HasMerge();
+        parallel = parallel && !writer->batch->HasMerge() && !writer->batch->HasDirectWriter();
       }
     }
 
@@ -226,6 +226,10 @@ class DBImpl : public DB {
 
   FlushAbility GetFlushAbility() override;
 
+  Status SaveBlockCacheWarmupState(const BlockCacheKeys& cache_keys) override;
+
+  yb::Result<size_t> WarmUpBlockCache() override;
+
   UserFrontierPtr GetMutableMemTableFrontier(UpdateUserValueType type) override;
 
   // Calculates specified frontier_type for all mem tables (active and immutable).
@@ -678,6 +682,11 @@ class DBImpl : public DB {
 
   void ListenFilesChanged(std::function<void()> listener) override;
 
+  // Calls callback with the number and the table reader of every live SST file. When no_io is
+  // true, files whose table readers are not open are skipped.
+  Status ForEachLiveTableReader(
+      bool no_io, const std::function<Status(uint64_t, TableReader*)>& callback);
+
   std::function<void()> GetFilesChangedListener() const;
 
   bool HasFilesChangedListener() const;
@@ -5316,6 +5316,90 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
 
+namespace {
+
+class PutKeysDirectWriter : public DirectWriter {
+ public:
+  PutKeysDirectWriter(int thread, int batch, int num_keys)
+      : thread_(thread), batch_(batch), num_keys_(num_keys) {}
+
+  Status Apply(DirectWriteHandler* handler) override {
+    for (int i = 0; i != num_keys_; ++i) {
+      auto key = yb::Format("key_$0_$1_$2", thread_, batch_, i);
+      auto value = yb::Format("value_$0", i);
+      Slice key_slice(key);
+      Slice value_slice(value);
+      handler->Put(SliceParts(&key_slice, 1), SliceParts(&value_slice, 1));
+    }
+    return Status::OK();
+  }
+
+ private:
+  const int thread_;
+  const int batch_;
+  const int num_keys_;
+};
+
+} // namespace
+
+TEST_F(DBTest, ConcurrentMemtableMixedDirectWrites) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumBatches = 200;
+  constexpr int kKeysPerBatch = 10;
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.memtable_factory.reset(new SkipListFactory);
+  DestroyAndReopen(options);
+
+  // Even threads write through a direct writer, odd threads write regular batches, so write
+  // groups mix both kinds.
+  yb::TestThreadHolder workers;
+  for (int thread = 0; thread != kNumThreads; ++thread) {
+    workers.AddThread([this, thread] {
+      for (int batch = 0; batch != kNumBatches; ++batch) {
+        PutKeysDirectWriter writer(thread, batch, kKeysPerBatch);
+        WriteBatch write_batch;
+        if (thread % 2 == 0) {
+          write_batch.SetDirectWriter(&writer);
+        } else {
+          for (int i = 0; i != kKeysPerBatch; ++i) {
+            write_batch.Put(
+                yb::Format("key_$0_$1_$2", thread, batch, i), yb::Format("value_$0", i));
+          }
+        }
+        ASSERT_OK(db_->Write(WriteOptions(), &write_batch));
+      }
+    });
+  }
+  workers.JoinAll();
+
+  constexpr SequenceNumber kNumEntries = kNumThreads * kNumBatches * kKeysPerBatch;
+  ASSERT_EQ(kNumEntries, db_->GetLatestSequenceNumber());
+  for (int thread = 0; thread != kNumThreads; ++thread) {
+    for (int batch = 0; batch != kNumBatches; ++batch) {
+      for (int i = 0; i != kKeysPerBatch; ++i) {
+        ASSERT_EQ(yb::Format("value_$0", i), Get(yb::Format("key_$0_$1_$2", thread, batch, i)));
+      }
+    }
+  }
+
+  // Every entry should have its own sequence number.
+  std::unordered_set<SequenceNumber> sequence_numbers;
+  Arena arena;
+  ScopedArenaIterator iter(dbfull()->NewInternalIterator(&arena));
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ParsedInternalKey ikey;
+    ASSERT_TRUE(ParseInternalKey(iter->key(), &ikey));
+    ASSERT_GE(ikey.sequence, 1U);
+    ASSERT_LE(ikey.sequence, kNumEntries);
+    ASSERT_TRUE(sequence_numbers.insert(ikey.sequence).second)
+        << "Duplicate sequence number " << ikey.sequence << " of " << ikey.user_key.ToString();
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(kNumEntries, sequence_numbers.size());
+}
+
 TEST_F(DBTest, SanitizeNumThreads) {
   for (int attempt = 0; attempt < 2; attempt++) {
     const size_t kTotalTasks = 8;
@@ -7156,6 +7240,40 @@ TEST_F(DBTest, RowCache) {
   ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_MISS), 1);
 }
 
+TEST_F(DBTest, SharedTableCache) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  auto table_cache = NewLRUCache(100);
+  options.table_cache = table_cache;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("foo", "bar"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(Get("foo"), "bar");
+  const auto usage = table_cache->GetUsage();
+  ASSERT_GT(usage, 0);
+
+  // File numbers of the other DB are the same, so its readers should not be mixed up.
+  const auto other_dbname = dbname_ + "_other";
+  ASSERT_OK(DestroyDB(other_dbname, options));
+  DB* other_db = nullptr;
+  ASSERT_OK(DB::Open(options, other_dbname, &other_db));
+  ASSERT_OK(other_db->Put(WriteOptions(), "foo", "other_bar"));
+  ASSERT_OK(other_db->Flush(FlushOptions()));
+  std::string value;
+  ASSERT_OK(other_db->Get(ReadOptions(), "foo", &value));
+  ASSERT_EQ(value, "other_bar");
+  ASSERT_EQ(Get("foo"), "bar");
+  ASSERT_GT(table_cache->GetUsage(), usage);
+
+  // Readers of a DB are removed from the shared cache when it is closed.
+  delete other_db;
+  ASSERT_EQ(table_cache->GetUsage(), usage);
+  ASSERT_OK(DestroyDB(other_dbname, options));
+  Close();
+  ASSERT_EQ(table_cache->GetUsage(), 0);
+}
+
 // TODO(3.13): fix the issue of Seek() + Prev() which might not necessary
 //             return the biggest key which is smaller than the seek key.
 TEST_F(DBTest, PrevAfterMerge) {
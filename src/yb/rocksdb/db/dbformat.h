@@ -230,6 +230,21 @@ class InternalKey {
 class BoundaryValuesExtractor {
  public:
   virtual Status Extract(Slice user_key, UserBoundaryValueRefs* values) = 0;
+
+  // Whether ExtractFromValue should be called for the records of a new file. Checked once per file,
+  // so that the values are extracted from either all or none of the records of the file.
+  virtual bool ExtractsFromValues() {
+    return false;
+  }
+
+  // Extracts boundary values from the value of a record, in addition to the ones extracted from
+  // its key. Values that are not slices of the record are stored in buffer, that is kept until
+  // they are consumed.
+  virtual Status ExtractFromValue(
+      Slice user_key, Slice value, std::string* buffer, UserBoundaryValueRefs* values) {
+    return Status::OK();
+  }
+
   virtual UserFrontierPtr CreateFrontier() = 0;
  protected:
   ~BoundaryValuesExtractor() {}
@@ -41,11 +41,18 @@
 #include "yb/rocksdb/util/statistics.h"
 #include "yb/rocksdb/util/stop_watch.h"
 
+#include "yb/util/flags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/stats/perf_step_timer.h"
 
 using std::ostringstream;
 
+DEFINE_RUNTIME_int32(memstore_arena_initial_block_size_kb, 0,
+    "Size of the first arena block of a memstore, in KB. Each next block doubles until "
+    "memstore_arena_size_kb is reached. Lowers the memory pinned by memstores of idle and small "
+    "tablets. 0 means that all blocks have memstore_arena_size_kb.");
+TAG_FLAG(memstore_arena_initial_block_size_kb, advanced);
+
 namespace rocksdb {
 
 MemTableOptions::MemTableOptions(
@@ -79,7 +86,8 @@ MemTable::MemTable(const InternalKeyComparator& cmp,
       moptions_(ioptions, mutable_cf_options),
       refs_(0),
       kArenaBlockSize(OptimizeBlockSize(moptions_.arena_block_size)),
-      arena_(moptions_.arena_block_size, 0),
+      arena_(moptions_.arena_block_size, 0,
+             static_cast<size_t>(FLAGS_memstore_arena_initial_block_size_kb) << 10),
       allocator_(&arena_, write_buffer),
       table_(ioptions.memtable_factory->CreateMemTableRep(
           comparator_, &allocator_, ioptions.prefix_extractor,
@@ -23,6 +23,9 @@
 
 #include "yb/rocksdb/db/table_cache.h"
 
+#include <mutex>
+#include <unordered_set>
+
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/version_edit.h"
@@ -496,4 +499,119 @@ void TableCache::Evict(Cache* cache, uint64_t file_number) {
   cache->Erase(GetSliceForFileNumber(&file_number));
 }
 
+namespace {
+
+class SharedTableCache : public Cache {
+ public:
+  explicit SharedTableCache(std::shared_ptr<Cache> shared_cache)
+      : shared_cache_(std::move(shared_cache)) {
+    PutVarint64(&prefix_, shared_cache_->NewId());
+  }
+
+  ~SharedTableCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& key : keys_) {
+      shared_cache_->Erase(key);
+    }
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Handle** handle,
+                Statistics* statistics) override {
+    auto prefixed_key = PrefixedKey(key);
+    auto status = shared_cache_->Insert(
+        prefixed_key, query_id, value, charge, deleter, handle, statistics);
+    if (status.ok()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      keys_.insert(std::move(prefixed_key));
+    }
+    return status;
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    return shared_cache_->Lookup(PrefixedKey(key), query_id, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    shared_cache_->Release(handle);
+  }
+
+  void* Value(Handle* handle) override {
+    return shared_cache_->Value(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    auto prefixed_key = PrefixedKey(key);
+    shared_cache_->Erase(prefixed_key);
+    std::lock_guard<std::mutex> lock(mutex_);
+    keys_.erase(prefixed_key);
+  }
+
+  uint64_t NewId() override {
+    return shared_cache_->NewId();
+  }
+
+  void SetCapacity(size_t capacity) override {
+    LOG(DFATAL) << "Capacity of a shared table cache should be changed through the shared cache";
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return shared_cache_->HasStrictCapacityLimit();
+  }
+
+  size_t GetCapacity() const override {
+    return shared_cache_->GetCapacity();
+  }
+
+  size_t GetUsage() const override {
+    return shared_cache_->GetUsage();
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return shared_cache_->GetUsage(handle);
+  }
+
+  size_t GetPinnedUsage() const override {
+    return shared_cache_->GetPinnedUsage();
+  }
+
+  SubCacheType GetSubCacheType(Handle* e) const override {
+    return shared_cache_->GetSubCacheType(e);
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    shared_cache_->ApplyToAllCacheEntries(callback, thread_safe);
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    return shared_cache_->TEST_GetIndividualUsages();
+  }
+
+ private:
+  std::string PrefixedKey(const Slice& key) const {
+    std::string result;
+    result.reserve(prefix_.size() + key.size());
+    result.append(prefix_);
+    result.append(key.cdata(), key.size());
+    return result;
+  }
+
+  const std::shared_ptr<Cache> shared_cache_;
+  std::string prefix_;
+
+  std::mutex mutex_;
+  // Keys inserted by this cache. Keys of entries evicted from the shared cache stay here until
+  // the file is deleted or the cache is destroyed, erasing them is a no-op.
+  std::unordered_set<std::string> keys_;
+};
+
+} // namespace
+
+std::shared_ptr<Cache> NewSharedTableCache(std::shared_ptr<Cache> shared_cache) {
+  return std::make_shared<SharedTableCache>(std::move(shared_cache));
+}
+
 }  // namespace rocksdb
@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -188,4 +189,10 @@ class TableCache {
   std::string row_cache_id_;
 };
 
+// Returns a table cache that keeps its entries in shared_cache, so several DBs could share one
+// budget of open table files. Keys are prefixed with an id of the returned cache, because file
+// numbers are only unique within a DB. Entries are erased from shared_cache when the returned
+// cache is destroyed, since table readers refer to the options of the DB that opened them.
+std::shared_ptr<Cache> NewSharedTableCache(std::shared_ptr<Cache> shared_cache);
+
 }  // namespace rocksdb
@@ -822,9 +822,15 @@ void Version::AddIterators(const ReadOptions& read_options,
   auto* arena = merge_iter_builder->GetArena();
 
   // Merge all level zero files together since they may overlap
-  for (size_t i = 0; i < storage_info_.LevelFilesBrief(0).num_files; i++) {
-    const auto& file = storage_info_.LevelFilesBrief(0).files[i];
-    if (!read_options.file_filter || read_options.file_filter->Filter(file)) {
+  const auto& level0_files = storage_info_.LevelFilesBrief(0);
+  std::vector<bool> read_level0_file;
+  if (read_options.file_filter) {
+    read_options.file_filter->FilterFiles(
+        level0_files.files, level0_files.num_files, &read_level0_file);
+  }
+  for (size_t i = 0; i < level0_files.num_files; i++) {
+    if (read_level0_file.empty() || read_level0_file[i]) {
+      const auto& file = level0_files.files[i];
       InternalIterator *file_iter;
       TableCache::TableReaderWithHandle trwh;
       Status s = cfd_->table_cache()->GetTableReaderForIterator(read_options, soptions,
@@ -771,6 +771,7 @@ class MemTableInserter : public WriteBatch::Handler {
     MemTable* mem = cf_mems_->GetMemTable();
     if ((delete_type == ValueType::kTypeSingleDeletion ||
          delete_type == ValueType::kTypeColumnFamilySingleDeletion) &&
+        !insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites) &&
         mem->Erase(key)) {
       return Status::OK();
     }
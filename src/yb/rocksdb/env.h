@@ -103,6 +103,10 @@ struct EnvOptions : public yb::FileSystemOptions {
   // See DBOPtions doc
   size_t compaction_readahead_size;
 
+  // If true, WritableFileWriter drops the pages of the file from the OS page cache once their
+  // writeback was started through bytes_per_sync.
+  bool drop_os_cache_after_sync = false;
+
   // See DBOPtions doc
   size_t random_access_max_buffer_size;
 
@@ -214,4 +214,18 @@ extern const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
 extern const FilterPolicy* NewFixedSizeFilterPolicy(size_t total_bits,
                                                     double error_rate,
                                                     Logger* logger);
+
+// Same as NewFixedSizeFilterPolicy, but each filter block is a Ribbon filter instead of a bloom
+// filter. It needs about 25% less space for the same false positive rate, at the cost of buffering
+// key hashes and solving a banded linear system when filter block is finished.
+extern const FilterPolicy* NewFixedSizeRibbonFilterPolicy(size_t total_bits,
+                                                          double error_rate,
+                                                          Logger* logger);
+
+// Same as NewFixedSizeFilterPolicy, but each key is mapped to a single 256-bit block and probes
+// all its bits at once (split block bloom filter). Lookups are faster and branch-free, at the
+// cost of about 10% more space for the same false positive rate.
+extern const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(size_t total_bits,
+                                                                double error_rate,
+                                                                Logger* logger);
 }  // namespace rocksdb
@@ -1171,6 +1171,13 @@ struct DBOptions {
   // Default: 0
   size_t compaction_readahead_size;
 
+  // If true, compactions drop the pages of their output files from the OS page cache once their
+  // writeback was started, so bytes_per_sync should be set. Input files are left alone, because
+  // they are still used by foreground reads until the compaction is installed.
+  //
+  // Default: false
+  bool compaction_drop_os_cache;
+
   // This is a maximum buffer size that is used by WinMmapReadableFile in
   // unbuffered disk I/O mode. We need to maintain an aligned buffer for
   // reads. We allow the buffer to grow until the specified value and then
@@ -1304,6 +1311,11 @@ struct DBOptions {
   // Default: nullptr (disabled)
   std::shared_ptr<Cache> row_cache;
 
+  // A cache of open table readers that could be shared by several DBs. When set, max_open_files
+  // does not limit the number of open table files, the capacity of this cache does.
+  // Default: nullptr (every DB has its own cache sized by max_open_files)
+  std::shared_ptr<Cache> table_cache;
+
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
   // records, ignoring a particular record or skipping replay.
@@ -1328,6 +1340,11 @@ struct DBOptions {
 
   std::shared_ptr<CompactionContextFactory> compaction_context_factory;
 
+  // Used to align subcompaction boundaries to groups of keys that must be compacted together,
+  // for instance all keys of a document. Returns the prefix of the specified user key shared by
+  // its group, or an empty slice when the key could not be used as a boundary.
+  std::function<Slice(Slice)> subcompaction_boundary_extractor;
+
   // Function that returns max file size for compaction.
   // Supported only for level0 of universal style compactions.
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction;
@@ -1407,6 +1424,12 @@ class ReadFileFilter {
  public:
   virtual bool Filter(const FdWithBoundaries&) const = 0;
 
+  // Filters level 0 files, whose key ranges could overlap, all at once. Sets (*read)[i] to whether
+  // files[i] should be read. Calls Filter for every file by default. Filters that could only skip a
+  // file depending on which of the other files are read override it.
+  virtual void FilterFiles(
+      const FdWithBoundaries* files, size_t num_files, std::vector<bool>* read) const;
+
  protected:
   virtual ~ReadFileFilter() {}
 };
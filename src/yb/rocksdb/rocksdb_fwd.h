@@ -19,6 +19,7 @@
 
 namespace rocksdb {
 
+class BlockCacheKeys;
 class CompactionContext;
 class CompactionFeed;
 class DB;
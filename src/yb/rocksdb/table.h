@@ -93,6 +93,12 @@ struct BlockBasedTableOptions {
   // Note: Fixed-size bloom filter data blocks are never pre-loaded.
   bool cache_index_and_filter_blocks = false;
 
+  // Only used when cache_index_and_filter_blocks is set. Top level of data index and fixed-size
+  // filter index are added to block cache with high priority (directly to multi touch part of the
+  // cache), so they are evicted after index partitions and filter blocks that are loaded on
+  // demand with the priority of the query.
+  bool cache_top_level_index_and_filter_with_high_priority = false;
+
   IndexType index_type = IndexType::kMultiLevelBinarySearch;
 
   // Influence the behavior when kHashSearch is used.
@@ -23,6 +23,7 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 
@@ -62,6 +63,7 @@
 
 #include "yb/util/atomic.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
@@ -69,6 +71,11 @@
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
 
+DEFINE_RUNTIME_uint64(rocksdb_iterator_sequential_prefetch_bytes, 0,
+    "If non-zero, iterators that read data blocks of an SST file one after another ask the OS to "
+    "start reading this number of bytes following the current block in the background.");
+TAG_FLAG(rocksdb_iterator_sequential_prefetch_bytes, advanced);
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -219,7 +226,9 @@ struct BlockBasedTable::Rep {
   std::mutex data_index_reader_mutex;
   yb::AtomicUniquePtr<IndexReader> data_index_reader;
   unique_ptr<BlockEntryIteratorState> data_index_iterator_state;
-  unique_ptr<IndexReader> filter_index_reader;
+  // Fixed-size filter index, only used when it is not stored in block cache.
+  std::mutex filter_index_reader_mutex;
+  yb::AtomicUniquePtr<IndexReader> filter_index_reader;
   unique_ptr<FilterBlockReader> filter;
 
   FilterType filter_type;
@@ -270,6 +279,30 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
     return table_->PrefixMayMatch(internal_key);
   }
 
+  uint64_t PrefetchFollowingBlocks(const Slice& index_value, uint64_t prefetched_up_to) override {
+    const auto prefetch_bytes = FLAGS_rocksdb_iterator_sequential_prefetch_bytes;
+    if (prefetch_bytes == 0 || block_type_ != BlockType::kData ||
+        read_options_.read_tier == kBlockCacheTier) {
+      return prefetched_up_to;
+    }
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      return prefetched_up_to;
+    }
+    // Data blocks are stored one after another, so the following blocks start after the current
+    // one. The range is requested again once half of it was read, so the scan does not catch up
+    // with the readahead.
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (block_end + prefetch_bytes / 2 <= prefetched_up_to) {
+      return prefetched_up_to;
+    }
+    const uint64_t start = std::max(block_end, prefetched_up_to);
+    const uint64_t end = block_end + prefetch_bytes;
+    table_->GetBlockReader(block_type_)->reader->file()->Prefetch(start, end - start);
+    return end;
+  }
+
  private:
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
@@ -457,10 +490,13 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   if (prefetch_filter == PrefetchFilter::YES) {
     // pre-fetching of blocks is turned on
     // NOTE: Table reader objects are cached in table cache (table_cache.cc).
-    if (rep->filter_policy && rep->filter_type == FilterType::kFixedSizeFilter) {
-      // TODO: may be put it in block cache instead of table reader in case
-      // table_options.cache_index_and_filter_blocks is set?
-      RETURN_NOT_OK(new_table->CreateFilterIndexReader(&rep->filter_index_reader));
+    // When block cache is used for index and filter blocks, fixed-size filter index is loaded on
+    // demand through block cache, so it does not take memory for tables that are not accessed.
+    if (rep->filter_policy && rep->filter_type == FilterType::kFixedSizeFilter &&
+        !new_table->UseCacheForFilterIndex()) {
+      std::unique_ptr<IndexReader> filter_index_reader;
+      RETURN_NOT_OK(new_table->CreateFilterIndexReader(&filter_index_reader));
+      rep->filter_index_reader.reset(filter_index_reader.release());
     }
 
     // Will use block cache for filter blocks access?
@@ -691,8 +727,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->filter) {
     usage += rep_->filter->ApproximateMemoryUsage();
   }
-  if (rep_->filter_index_reader) {
-    usage += rep_->filter_index_reader->ApproximateMemoryUsage();
+  IndexReader* filter_index_reader = rep_->filter_index_reader.get(std::memory_order_relaxed);
+  if (filter_index_reader) {
+    usage += filter_index_reader->ApproximateMemoryUsage();
   }
   IndexReader* data_index_reader = rep_->data_index_reader.get(std::memory_order_relaxed);
   if (data_index_reader) {
@@ -888,7 +925,8 @@ Status BlockBasedTable::PutDataBlockToCache(
   return s;
 }
 
-Status BlockBasedTable::CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader) {
+Status BlockBasedTable::CreateFilterIndexReader(
+    std::unique_ptr<IndexReader>* filter_index_reader) const {
   auto base_file_reader = rep_->base_reader_with_cache_prefix->reader.get();
   auto env = rep_->ioptions.env;
   auto footer = rep_->footer;
@@ -934,9 +972,11 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
           rep->whole_key_filtering, std::move(block), filter_bits_reader);
     }
     case FilterType::kFixedSizeFilter:
+      // File could be written with another supported filter policy, that has different filter
+      // block format.
       return new FixedSizeFilterBlockReader(
           rep->prefix_filtering ? rep->ioptions.prefix_extractor : nullptr,
-          rep->table_options, rep->whole_key_filtering, std::move(block));
+          rep->table_options, rep->whole_key_filtering, std::move(block), rep->filter_policy);
       break;
   }
   RLOG(InfoLogLevel::FATAL_LEVEL, rep->ioptions.info_log, "Corrupted filter_type: %d",
@@ -944,12 +984,74 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
   return nullptr;
 }
 
-Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
+bool BlockBasedTable::UseCacheForFilterIndex() const {
+  return rep_->table_options.cache_index_and_filter_blocks &&
+         rep_->table_options.block_cache != nullptr;
+}
+
+QueryId BlockBasedTable::TopLevelQueryId(QueryId query_id) const {
+  if (query_id == kNoCacheQueryId ||
+      !rep_->table_options.cache_top_level_index_and_filter_with_high_priority) {
+    return query_id;
+  }
+  return kInMultiTouchId;
+}
+
+yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetFilterIndexReader(
+    QueryId query_id) const {
+  auto* filter_index_reader = rep_->filter_index_reader.get(std::memory_order_acquire);
+  if (filter_index_reader) {
+    return CachableEntry<IndexReader>{filter_index_reader, /* cache_handle =*/ nullptr};
+  }
+
+  if (UseCacheForFilterIndex()) {
+    Cache* const block_cache = rep_->table_options.block_cache.get();
+    char cache_key[block_based_table::kCacheKeyBufferSize];
+    auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
+        rep_->filter_handle, cache_key);
+    Statistics* statistics = rep_->ioptions.statistics;
+    query_id = TopLevelQueryId(query_id);
+    auto cache_handle = GetEntryFromCache(
+        block_cache, key, BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, query_id);
+    if (cache_handle != nullptr) {
+      filter_index_reader = static_cast<IndexReader*>(block_cache->Value(cache_handle));
+    } else {
+      std::unique_ptr<IndexReader> filter_index_reader_holder;
+      RETURN_NOT_OK(CreateFilterIndexReader(
+          &filter_index_reader_holder));
+      RETURN_NOT_OK(block_cache->Insert(
+          key, query_id, filter_index_reader_holder.get(),
+          filter_index_reader_holder->usable_size(), &DeleteCachedEntry<IndexReader>,
+          &cache_handle, statistics));
+      DCHECK_ONLY_NOTNULL(cache_handle);
+      filter_index_reader = filter_index_reader_holder.release();
+    }
+    return CachableEntry<IndexReader>{filter_index_reader, cache_handle};
+  }
+
+  // Filter index was not prefetched on Open, load it into table reader.
+  std::lock_guard<std::mutex> lock(rep_->filter_index_reader_mutex);
+  filter_index_reader = rep_->filter_index_reader.get(std::memory_order_relaxed);
+  if (!filter_index_reader) {
+    std::unique_ptr<IndexReader> filter_index_reader_holder;
+    RETURN_NOT_OK(CreateFilterIndexReader(
+        &filter_index_reader_holder));
+    filter_index_reader = filter_index_reader_holder.release();
+    rep_->filter_index_reader.reset(filter_index_reader, std::memory_order_acq_rel);
+  }
+  return CachableEntry<IndexReader>{filter_index_reader, /* cache_handle =*/ nullptr};
+}
+
+Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key, QueryId query_id,
     BlockHandle* filter_block_handle) const {
+  auto filter_index_reader = VERIFY_RESULT(GetFilterIndexReader(query_id));
+  auto se = yb::ScopeExit([this, &filter_index_reader] {
+    filter_index_reader.Release(rep_->table_options.block_cache.get());
+  });
   // Determine block of fixed-size bloom filter using filter index. It is expected `NewIterator()`
   // is reusing `fiter` and not creating a new iterator (multi-level index case).
   BlockIter fiter;
-  RSTATUS_DCHECK(!rep_->filter_index_reader->NewIterator(&fiter,
+  RSTATUS_DCHECK(!filter_index_reader.value->NewIterator(&fiter,
       // Following parameters are ignored by BinarySearchIndexReader which we use as
       // filter_index_reader.
       /* index_iterator_state = */ nullptr, /* total_order_seek = */ true),
@@ -1012,7 +1114,8 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
   // Determine filter block handle
   BlockHandle fixed_size_filter_block_handle;
   if (is_fixed_size_filter) {
-    Status s = GetFixedSizeFilterBlockHandle(*filter_key, &fixed_size_filter_block_handle);
+    Status s = GetFixedSizeFilterBlockHandle(
+        *filter_key, query_id, &fixed_size_filter_block_handle);
     if (s.ok()) {
       if (fixed_size_filter_block_handle.IsNull()) {
         // Key is beyond filter index - return stub filter.
@@ -1103,9 +1206,12 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
     auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
         rep_->footer.index_handle(), cache_key);
     Statistics* statistics = rep_->ioptions.statistics;
+    // Lower levels of multi-level index are loaded on demand as kIndex blocks with priority of the
+    // query, only top level index could be cached with high priority.
+    const auto query_id = TopLevelQueryId(read_options.query_id);
     auto cache_handle =
         GetEntryFromCache(block_cache, key, BLOCK_CACHE_INDEX_MISS,
-            BLOCK_CACHE_INDEX_HIT, statistics, read_options.query_id);
+            BLOCK_CACHE_INDEX_HIT, statistics, query_id);
 
     if (cache_handle == nullptr && no_io) {
       return ReturnNoIOError();
@@ -1118,7 +1224,7 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
       std::unique_ptr<IndexReader> index_reader_unique;
       RETURN_NOT_OK(CreateDataBlockIndexReader(&index_reader_unique));
       RETURN_NOT_OK(block_cache->Insert(
-          key, read_options.query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
+          key, query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
           &DeleteCachedEntry<IndexReader>, &cache_handle, statistics));
       assert(cache_handle);
       index_reader = index_reader_unique.release();
@@ -1540,6 +1646,54 @@ Status BlockBasedTable::Prefetch(const Slice* const begin,
   return Status::OK();
 }
 
+CachedBlocks BlockBasedTable::GetCachedDataBlocks(const BlockCacheKeys& cache_keys) const {
+  auto* reader = GetBlockReader(BlockType::kData);
+  if (!rep_->table_options.block_cache || !reader) {
+    return CachedBlocks();
+  }
+  return cache_keys.BlocksWithPrefix(
+      Slice(reader->cache_key_prefix.data, reader->cache_key_prefix.size));
+}
+
+yb::Result<size_t> BlockBasedTable::WarmUpDataBlocks(
+    const CachedBlocks& blocks, const std::function<bool()>& should_stop) {
+  Cache* block_cache = rep_->table_options.block_cache.get();
+  if (!block_cache || blocks.empty()) {
+    return 0;
+  }
+
+  IndexIteratorHolder iiter_holder(this, ReadOptions::kDefault);
+  InternalIterator& iiter = *iiter_holder.iter();
+  RETURN_NOT_OK(iiter.status());
+
+  ReadOptions read_options;
+  size_t num_loaded = 0;
+  for (iiter.SeekToFirst(); iiter.Valid(); iiter.Next()) {
+    if (block_cache->GetUsage() >= block_cache->GetCapacity() || should_stop()) {
+      break;
+    }
+    BlockHandle handle;
+    Slice input = iiter.value();
+    RETURN_NOT_OK(handle.DecodeFrom(&input));
+    auto it = blocks.find(handle.offset());
+    if (it == blocks.end()) {
+      continue;
+    }
+    // Blocks that were read by several queries go straight to the multi-touch sub cache, as they
+    // would after their second read.
+    read_options.query_id = it->second == MULTI_TOUCH ? kInMultiTouchId : kDefaultQueryId;
+    auto block = VERIFY_RESULT(RetrieveBlock(read_options, iiter.value(), BlockType::kData));
+    if (block.cache_handle) {
+      block.Release(block_cache);
+    } else {
+      delete block.value;
+    }
+    ++num_loaded;
+  }
+  RETURN_NOT_OK(iiter.status());
+  return num_loaded;
+}
+
 bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
                                       const Slice& key) {
   std::unique_ptr<InternalIterator> iiter(NewIndexIterator(options));
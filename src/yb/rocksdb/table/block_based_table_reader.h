@@ -203,6 +203,11 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  CachedBlocks GetCachedDataBlocks(const BlockCacheKeys& cache_keys) const override;
+
+  yb::Result<size_t> WarmUpDataBlocks(
+      const CachedBlocks& blocks, const std::function<bool()>& should_stop) override;
+
   // Helper function that force reading block from a file and takes care about block cleanup.
   yb::Result<std::unique_ptr<Block>> RetrieveBlockFromFile(const ReadOptions& ro,
       const Slice& index_value, BlockType block_type);
@@ -229,9 +234,18 @@ class BlockBasedTable : public TableReader {
   class IndexIteratorHolder;
 
   // Returns filter block handle for fixed-size bloom filter using filter index and filter key.
-  Status GetFixedSizeFilterBlockHandle(const Slice& filter_key,
+  Status GetFixedSizeFilterBlockHandle(const Slice& filter_key, QueryId query_id,
       BlockHandle* filter_block_handle) const;
 
+  // Returns fixed-size filter index reader, loads it into block cache or table reader if needed.
+  yb::Result<CachableEntry<IndexReader>> GetFilterIndexReader(QueryId query_id) const;
+
+  // Whether fixed-size filter index is stored in block cache instead of table reader.
+  bool UseCacheForFilterIndex() const;
+
+  // Returns query id to be used for accessing top level index and filter blocks in block cache.
+  QueryId TopLevelQueryId(QueryId query_id) const;
+
   // Returns key to be added to filter or verified against filter based on internal_key.
   Slice GetFilterKeyFromInternalKey(const Slice &internal_key) const;
 
@@ -312,7 +326,7 @@ class BlockBasedTable : public TableReader {
       size_t* filter_size = nullptr);
 
   // CreateFilterIndexReader from sst
-  Status CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader);
+  Status CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader) const;
 
   // Helper function to setup the cache key's prefix for block of file passed within a reader
   // instance. Used for both data and metadata files.
@@ -116,8 +116,9 @@ FixedSizeFilterBlockReader::FixedSizeFilterBlockReader(
     const SliceTransform* prefix_extractor,
     const BlockBasedTableOptions& table_opt,
     bool whole_key_filtering,
-    BlockContents&& contents)
-    : policy_(table_opt.filter_policy.get()),
+    BlockContents&& contents,
+    const FilterPolicy* policy)
+    : policy_(policy ? policy : table_opt.filter_policy.get()),
       prefix_extractor_(prefix_extractor),
       whole_key_filtering_(whole_key_filtering),
       contents_(std::move(contents)) {
@@ -81,10 +81,13 @@ class FixedSizeFilterBlockBuilder : public FilterBlockBuilder {
 class FixedSizeFilterBlockReader : public FilterBlockReader {
  public:
   // REQUIRES: "contents" and *policy must stay live while *this is live.
+  // policy is the filter policy used to write the filter block, table_opt.filter_policy is used
+  // when it is not specified.
   FixedSizeFilterBlockReader(const SliceTransform* prefix_extractor,
                              const BlockBasedTableOptions& table_opt,
                              bool whole_key_filtering,
-                             BlockContents&& contents);
+                             BlockContents&& contents,
+                             const FilterPolicy* policy = nullptr);
   FixedSizeFilterBlockReader(const FixedSizeFilterBlockReader&) = delete;
   void operator=(const FixedSizeFilterBlockReader&) = delete;
 
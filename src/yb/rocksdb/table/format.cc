@@ -43,6 +43,7 @@
 #include "yb/util/status_format.h"
 #include "yb/util/std_util.h"
 #include "yb/util/string_util.h"
+#include "yb/util/wait_state.h"
 
 using yb::Format;
 using yb::Result;
@@ -356,6 +357,7 @@ Status ReadBlock(
   Status s;
   {
     PERF_TIMER_GUARD(block_read_time);
+    SCOPED_WAIT_STATUS(kBlockRead);
     struct BlockChecksumValidator : public yb::ReadValidator {
       BlockChecksumValidator(
           RandomAccessFileReader* file_, const Footer& footer_, const ReadOptions& options_,
@@ -23,9 +23,11 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 
 #include "yb/rocksdb/status.h"
+#include "yb/rocksdb/util/block_cache_warmup.h"
 
 #include "yb/util/result.h"
 
@@ -123,6 +125,19 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns the offsets of the data blocks of this table that are present in the block cache,
+  // according to the given snapshot of block cache keys.
+  virtual CachedBlocks GetCachedDataBlocks(const BlockCacheKeys& cache_keys) const {
+    return CachedBlocks();
+  }
+
+  // Loads the given data blocks into the block cache, stopping when the cache is full or when
+  // should_stop returns true. Returns the number of blocks loaded.
+  virtual yb::Result<size_t> WarmUpDataBlocks(
+      const CachedBlocks& blocks, const std::function<bool()>& should_stop) {
+    return 0;
+  }
 };
 
 }  // namespace rocksdb
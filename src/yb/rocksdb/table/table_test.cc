@@ -74,6 +74,7 @@ using std::unique_ptr;
 using namespace std::literals;
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_uint64(rocksdb_iterator_sequential_prefetch_bytes);
 
 namespace rocksdb {
 
@@ -339,8 +340,8 @@ class TableConstructor: public Constructor {
 
     // Open the table
     uniq_id_ = cur_uniq_id_++;
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, internal_comparator),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -361,8 +362,8 @@ class TableConstructor: public Constructor {
   }
 
   virtual Status Reopen(const ImmutableCFOptions& ioptions) {
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, last_internal_key_),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -372,6 +373,11 @@ class TableConstructor: public Constructor {
     return table_reader_.get();
   }
 
+  // File the table reader reads from, owned by the table reader.
+  const test::StringSource* GetSource() const {
+    return source_;
+  }
+
   bool AnywayDeleteIterator() const override {
     return convert_to_internal_key_;
   }
@@ -385,6 +391,7 @@ class TableConstructor: public Constructor {
  private:
   void Reset() {
     uniq_id_ = 0;
+    source_ = nullptr;
     table_reader_.reset();
     file_writer_.reset();
     file_reader_.reset();
@@ -398,6 +405,7 @@ class TableConstructor: public Constructor {
   unique_ptr<WritableFileWriter> file_writer_;
   unique_ptr<RandomAccessFileReader> file_reader_;
   unique_ptr<TableReader> table_reader_;
+  test::StringSource* source_ = nullptr;
   bool convert_to_internal_key_;
 
   TableConstructor();
@@ -1580,6 +1588,62 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, SequentialScanPrefetch) {
+  constexpr uint64_t kPrefetchBytes = 16_KB;
+  Random rnd(test::RandomSeed());
+  TableConstructor c(BytewiseComparator());
+  Options options;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_restart_interval = 1;
+  table_options.block_size = 1000;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  for (int i = 0; i < 200; ++i) {
+    // Each block holds roughly one key/value pair.
+    c.Add(RandomString(&rnd, 900), "val");
+  }
+
+  std::vector<std::string> ks;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &ks, &kvmap);
+
+  auto scan = [&c, &kvmap] {
+    std::unique_ptr<InternalIterator> iter(c.NewIterator());
+    size_t num_entries = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_entries;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(num_entries, kvmap.size());
+  };
+
+  // Nothing is prefetched by default.
+  ASSERT_NO_FATALS(scan());
+  ASSERT_TRUE(c.GetSource()->prefetched_ranges().empty());
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_iterator_sequential_prefetch_bytes) = kPrefetchBytes;
+  ASSERT_NO_FATALS(scan());
+  const auto& ranges = c.GetSource()->prefetched_ranges();
+  ASSERT_FALSE(ranges.empty());
+  // The range following the previously requested one is requested once half of it was read, so
+  // the whole file is requested once, in pieces of at most kPrefetchBytes.
+  const auto file_size = c.GetTableReader()->GetTableProperties()->data_size;
+  ASSERT_GE(ranges.size(), file_size / kPrefetchBytes);
+  ASSERT_LE(ranges.size(), 2 * file_size / kPrefetchBytes + 2);
+  for (size_t i = 0; i != ranges.size(); ++i) {
+    SCOPED_TRACE(yb::Format("Range: $0", i));
+    ASSERT_LT(ranges[i].first, ranges[i].second);
+    ASSERT_LE(ranges[i].second - ranges[i].first, kPrefetchBytes);
+    if (i != 0) {
+      ASSERT_EQ(ranges[i].first, ranges[i - 1].second);
+    }
+  }
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rocksdb_iterator_sequential_prefetch_bytes) = 0;
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -1689,6 +1753,55 @@ TEST_F(BlockBasedTableTest, BlockCacheDisabledTest) {
   ASSERT_TRUE(reader->TEST_index_reader_loaded());
 }
 
+// Fixed-size filter index should be loaded on demand through block cache when
+// cache_index_and_filter_blocks is set.
+TEST_F(BlockBasedTableTest, FixedSizeFilterIndexInBlockCache) {
+  Options options;
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatisticsForTests();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1024 * 1024);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.cache_top_level_index_and_filter_with_high_priority = true;
+  SetFixedSizeFilterPolicy(&table_options);
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+
+  TableConstructor c(BytewiseComparator(), true);
+  c.Add("key", "value");
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+  auto* reader = dynamic_cast<BlockBasedTable*>(c.GetTableReader());
+  Statistics* statistics = options.statistics.get();
+  {
+    // Filter index is not loaded on open.
+    BlockCachePropertiesSnapshot props(statistics);
+    props.AssertFilterBlockStat(0, 0);
+  }
+
+  auto do_get = [reader, &options] {
+    GetContext get_context(options.comparator, nullptr, nullptr, nullptr,
+                           GetContext::kNotFound, Slice(), nullptr, nullptr,
+                           nullptr, nullptr);
+    InternalKey ikey("key", kMaxSequenceNumber, kTypeValue);
+    ASSERT_OK(reader->Get(ReadOptions(), ikey.Encode(), &get_context));
+  };
+
+  do_get();
+  const auto filter_misses = statistics->getTickerCount(BLOCK_CACHE_FILTER_MISS);
+  const auto filter_hits = statistics->getTickerCount(BLOCK_CACHE_FILTER_HIT);
+  // At least filter index was read from file.
+  ASSERT_GE(filter_misses, 1U);
+
+  // Second access is served from block cache.
+  do_get();
+  ASSERT_EQ(filter_misses, statistics->getTickerCount(BLOCK_CACHE_FILTER_MISS));
+  ASSERT_GE(statistics->getTickerCount(BLOCK_CACHE_FILTER_HIT), filter_hits + filter_misses);
+}
+
 // Due to the difficulities of the intersaction between statistics, this test
 // only tests the case when "index block is put to block cache"
 TEST_F(BlockBasedTableTest, FilterBlockInBlockCache) {
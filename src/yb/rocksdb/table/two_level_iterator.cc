@@ -32,6 +32,9 @@ namespace rocksdb {
 
 namespace {
 
+// Number of blocks that should be read one after another before a scan is considered sequential.
+constexpr size_t kMinSequentialBlocksToPrefetch = 2;
+
 class TwoLevelIterator : public InternalIterator {
  public:
   explicit TwoLevelIterator(TwoLevelIteratorState* state,
@@ -93,6 +96,10 @@ class TwoLevelIterator : public InternalIterator {
   void SkipEmptyDataBlocksBackward();
   void SetSecondLevelIterator(InternalIterator* iter);
   void InitDataBlock();
+  void ResetSequentialScan() {
+    sequential_blocks_ = 0;
+    prefetched_up_to_ = 0;
+  }
 
   TwoLevelIteratorState* state_;
   IteratorWrapper first_level_iter_;
@@ -102,6 +109,9 @@ class TwoLevelIterator : public InternalIterator {
   // If second_level_iter is non-nullptr, then "data_block_handle_" holds the
   // "index_value" passed to block_function_ to create the second_level_iter.
   std::string data_block_handle_;
+  // Number of blocks the current forward scan moved to with Next, since the last repositioning.
+  size_t sequential_blocks_ = 0;
+  uint64_t prefetched_up_to_ = 0;
 };
 
 TwoLevelIterator::TwoLevelIterator(TwoLevelIteratorState* state,
@@ -112,6 +122,7 @@ TwoLevelIterator::TwoLevelIterator(TwoLevelIteratorState* state,
       need_free_iter_and_state_(need_free_iter_and_state) {}
 
 void TwoLevelIterator::Seek(const Slice& target) {
+  ResetSequentialScan();
   if (state_->check_prefix_may_match &&
       !state_->PrefixMayMatch(target)) {
     SetSecondLevelIterator(nullptr);
@@ -127,6 +138,7 @@ void TwoLevelIterator::Seek(const Slice& target) {
 }
 
 void TwoLevelIterator::SeekToFirst() {
+  ResetSequentialScan();
   first_level_iter_.SeekToFirst();
   InitDataBlock();
   if (second_level_iter_.iter() != nullptr) {
@@ -136,6 +148,7 @@ void TwoLevelIterator::SeekToFirst() {
 }
 
 void TwoLevelIterator::SeekToLast() {
+  ResetSequentialScan();
   first_level_iter_.SeekToLast();
   InitDataBlock();
   if (second_level_iter_.iter() != nullptr) {
@@ -152,6 +165,7 @@ void TwoLevelIterator::Next() {
 
 void TwoLevelIterator::Prev() {
   assert(Valid());
+  ResetSequentialScan();
   second_level_iter_.Prev();
   SkipEmptyDataBlocksBackward();
 }
@@ -190,6 +204,10 @@ void TwoLevelIterator::SkipEmptyDataBlocksForward() {
     first_level_iter_.Next();
     InitDataBlock();
     if (second_level_iter_.iter() != nullptr) {
+      if (++sequential_blocks_ >= kMinSequentialBlocksToPrefetch) {
+        prefetched_up_to_ = state_->PrefetchFollowingBlocks(
+            first_level_iter_.value(), prefetched_up_to_);
+      }
       second_level_iter_.SeekToFirst();
     }
   }
@@ -40,6 +40,14 @@ struct TwoLevelIteratorState {
   virtual InternalIterator* NewSecondaryIterator(const Slice& handle) = 0;
   virtual bool PrefixMayMatch(const Slice& internal_key) = 0;
 
+  // Called when a forward scan moved to the secondary block with the specified handle, after
+  // reading the preceding blocks one by one. prefetched_up_to is the value returned by the
+  // previous call for the same scan, or 0. Could ask the storage to start reading the following
+  // blocks, and returns the position they were requested up to.
+  virtual uint64_t PrefetchFollowingBlocks(const Slice& handle, uint64_t prefetched_up_to) {
+    return prefetched_up_to;
+  }
+
   // If call PrefixMayMatch()
   bool check_prefix_may_match;
 };
@@ -61,8 +61,11 @@ size_t OptimizeBlockSize(size_t block_size) {
   return block_size;
 }
 
-Arena::Arena(size_t block_size, size_t huge_page_size)
-    : kBlockSize(OptimizeBlockSize(block_size)) {
+Arena::Arena(size_t block_size, size_t huge_page_size, size_t initial_block_size)
+    : kBlockSize(OptimizeBlockSize(block_size)),
+      next_block_size_(initial_block_size
+                           ? std::min(OptimizeBlockSize(initial_block_size), kBlockSize)
+                           : kBlockSize) {
   assert(kBlockSize >= kMinBlockSize && kBlockSize <= kMaxBlockSize &&
          kBlockSize % kAlignUnit == 0);
   alloc_bytes_remaining_ = sizeof(inline_block_);
@@ -97,7 +100,11 @@ Arena::~Arena() {
 }
 
 char* Arena::AllocateFallback(size_t bytes, bool aligned) {
-  if (bytes > kBlockSize / 4) {
+  const size_t block_size = next_block_size_;
+  // Grow blocks on irregular allocations as well, otherwise an arena that starts with small
+  // blocks and gets only large entries would allocate each of them separately forever.
+  next_block_size_ = std::min(block_size * 2, kBlockSize);
+  if (bytes > block_size / 4) {
     ++irregular_block_num;
     // Object is more than a quarter of our block size.  Allocate it separately
     // to avoid wasting too much space in leftover bytes.
@@ -108,13 +115,14 @@ char* Arena::AllocateFallback(size_t bytes, bool aligned) {
   size_t size = 0;
   char* block_head = nullptr;
 #ifdef MAP_HUGETLB
-  if (hugetlb_size_) {
+  // Huge pages are only used once blocks have grown to their full size.
+  if (hugetlb_size_ && block_size == kBlockSize) {
     size = hugetlb_size_;
     block_head = AllocateFromHugePage(size);
   }
 #endif
   if (!block_head) {
-    size = kBlockSize;
+    size = block_size;
     block_head = AllocateNewBlock(size);
   }
   alloc_bytes_remaining_ = size - bytes;
@@ -62,7 +62,11 @@ class Arena : public Allocator {
   // huge_page_size: if 0, don't use huge page TLB. If > 0 (should set to the
   // supported hugepage size of the system), block allocation will try huge
   // page TLB first. If allocation fails, will fall back to normal case.
-  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0);
+  // initial_block_size: if 0, all regular blocks have block_size bytes. Otherwise the first
+  // regular block has initial_block_size bytes, and each next one doubles until block_size is
+  // reached, so an arena that only gets a few allocations does not pin a whole block.
+  explicit Arena(size_t block_size = kMinBlockSize, size_t huge_page_size = 0,
+                 size_t initial_block_size = 0);
   ~Arena();
 
   char* Allocate(size_t bytes) override;
@@ -108,6 +112,8 @@ class Arena : public Allocator {
   char inline_block_[kInlineSize] __attribute__((__aligned__(sizeof(void*))));
   // Number of bytes allocated in one block
   const size_t kBlockSize;
+  // Size of the next regular block, grows up to kBlockSize.
+  size_t next_block_size_;
   // Array of new[] allocated memory blocks
   typedef std::vector<char*> Blocks;
   Blocks blocks_;
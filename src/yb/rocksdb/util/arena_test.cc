@@ -21,6 +21,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <algorithm>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -208,6 +209,54 @@ TEST_F(ArenaTest, Simple) {
   SimpleTest(0);
   SimpleTest(kHugePageSize);
 }
+
+TEST_F(ArenaTest, GrowingBlocks) {
+  const size_t kInitialBlockSize = 4 * 1024;
+  const size_t kBlockSize = 64 * 1024;
+  const size_t kAllocSize = 512;
+  Arena arena(kBlockSize, 0 /* huge_page_size */, kInitialBlockSize);
+
+  // Fill the inline block, so the next allocation needs a new block.
+  for (size_t i = 0; i < Arena::kInlineSize / kAllocSize; ++i) {
+    arena.Allocate(kAllocSize);
+  }
+  size_t expected_memory_allocated = Arena::kInlineSize;
+  ASSERT_TRUE(CheckMemoryAllocated(arena.MemoryAllocatedBytes(), expected_memory_allocated));
+
+  // Blocks of 4, 8, 16, 32, 64 and 64 KB.
+  size_t block_size = kInitialBlockSize;
+  for (int i = 0; i < 6; ++i) {
+    for (size_t j = 0; j < block_size / kAllocSize; ++j) {
+      arena.Allocate(kAllocSize);
+    }
+    expected_memory_allocated += block_size;
+    ASSERT_TRUE(CheckMemoryAllocated(arena.MemoryAllocatedBytes(), expected_memory_allocated));
+    block_size = std::min(block_size * 2, kBlockSize);
+  }
+  ASSERT_EQ(0U, arena.IrregularBlockNum());
+
+  // Allocations larger than a quarter of the current block get their own block.
+  Arena small_arena(kBlockSize, 0 /* huge_page_size */, kInitialBlockSize);
+  small_arena.Allocate(Arena::kInlineSize);
+  small_arena.Allocate(kInitialBlockSize / 2);
+  ASSERT_EQ(1U, small_arena.IrregularBlockNum());
+  ASSERT_TRUE(CheckMemoryAllocated(
+      small_arena.MemoryAllocatedBytes(), Arena::kInlineSize + kInitialBlockSize / 2));
+}
+
+TEST_F(ArenaTest, GrowingBlocksLargeEntries) {
+  const size_t kInitialBlockSize = 4 * 1024;
+  const size_t kBlockSize = 64 * 1024;
+  const size_t kAllocSize = 8 * 1024;
+  Arena arena(kBlockSize, 0 /* huge_page_size */, kInitialBlockSize);
+
+  // Entries larger than a quarter of the 4, 8 and 16 KB blocks are allocated separately, but the
+  // blocks still grow, so following entries fit into 32 and 64 KB blocks.
+  for (int i = 0; i < 100; ++i) {
+    arena.Allocate(kAllocSize);
+  }
+  ASSERT_EQ(3U, arena.IrregularBlockNum());
+}
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -0,0 +1,130 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/util/block_cache_warmup.h"
+
+#include <algorithm>
+
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+
+#include "yb/util/status_format.h"
+
+namespace rocksdb {
+
+const char kBlockCacheWarmupFileName[] = "BLOCK_CACHE_WARMUP";
+
+namespace {
+
+constexpr uint32_t kCachedBlocksFormatVersion = 1;
+
+} // namespace
+
+BlockCacheKeys BlockCacheKeys::Collect(Cache* cache) {
+  BlockCacheKeys result;
+  cache->ApplyToAllCacheKeys([&result](const Slice& key, SubCacheType subcache_type) {
+    result.keys_.emplace_back(key.ToBuffer(), subcache_type);
+  });
+  std::sort(result.keys_.begin(), result.keys_.end());
+  return result;
+}
+
+CachedBlocks BlockCacheKeys::BlocksWithPrefix(Slice prefix) const {
+  CachedBlocks result;
+  if (prefix.empty()) {
+    return result;
+  }
+  auto it = std::lower_bound(
+      keys_.begin(), keys_.end(), prefix,
+      [](const auto& entry, const Slice& key) { return Slice(entry.first) < key; });
+  for (; it != keys_.end() && Slice(it->first).starts_with(prefix); ++it) {
+    Slice rest(it->first);
+    rest.remove_prefix(prefix.size());
+    uint64_t offset;
+    // The key of another table could start with this prefix, its remainder would not be a single
+    // varint then.
+    if (GetVarint64(&rest, &offset) && rest.empty()) {
+      result.emplace(offset, it->second);
+    }
+  }
+  return result;
+}
+
+std::string EncodeCachedBlocks(const CachedBlocksByFile& blocks) {
+  std::string result;
+  PutFixed32(&result, kCachedBlocksFormatVersion);
+  PutVarint64(&result, blocks.size());
+  std::vector<std::pair<uint64_t, SubCacheType>> sorted_blocks;
+  for (const auto& [file_number, file_blocks] : blocks) {
+    PutVarint64(&result, file_number);
+    PutVarint64(&result, file_blocks.size());
+    sorted_blocks.assign(file_blocks.begin(), file_blocks.end());
+    std::sort(sorted_blocks.begin(), sorted_blocks.end());
+    uint64_t prev_offset = 0;
+    for (const auto& [offset, subcache_type] : sorted_blocks) {
+      PutVarint64(&result, offset - prev_offset);
+      PutFixed8(&result, subcache_type == MULTI_TOUCH ? 1 : 0);
+      prev_offset = offset;
+    }
+  }
+  PutFixed32(&result, crc32c::Mask(crc32c::Value(result.data(), result.size())));
+  return result;
+}
+
+yb::Result<CachedBlocksByFile> DecodeCachedBlocks(Slice data) {
+  if (data.size() < 2 * sizeof(uint32_t)) {
+    return STATUS_FORMAT(Corruption, "Block cache warm-up data too short: $0", data.size());
+  }
+  auto body_size = data.size() - sizeof(uint32_t);
+  auto expected_crc = crc32c::Unmask(DecodeFixed32(data.data() + body_size));
+  if (crc32c::Value(data.cdata(), body_size) != expected_crc) {
+    return STATUS(Corruption, "Block cache warm-up data checksum mismatch");
+  }
+  data.remove_suffix(sizeof(uint32_t));
+
+  auto version = DecodeFixed32(data.data());
+  if (version != kCachedBlocksFormatVersion) {
+    return STATUS_FORMAT(NotSupported, "Unknown block cache warm-up format version: $0", version);
+  }
+  data.remove_prefix(sizeof(uint32_t));
+
+  CachedBlocksByFile result;
+  uint64_t num_files;
+  if (!GetVarint64(&data, &num_files)) {
+    return STATUS(Corruption, "Bad number of files in block cache warm-up data");
+  }
+  for (uint64_t i = 0; i != num_files; ++i) {
+    uint64_t file_number, num_blocks;
+    if (!GetVarint64(&data, &file_number) || !GetVarint64(&data, &num_blocks)) {
+      return STATUS(Corruption, "Bad file entry in block cache warm-up data");
+    }
+    auto& file_blocks = result[file_number];
+    uint64_t offset = 0;
+    for (uint64_t j = 0; j != num_blocks; ++j) {
+      uint64_t delta;
+      if (!GetVarint64(&data, &delta) || data.empty()) {
+        return STATUS(Corruption, "Bad block entry in block cache warm-up data");
+      }
+      offset += delta;
+      file_blocks.emplace(offset, data[0] ? MULTI_TOUCH : SINGLE_TOUCH);
+      data.remove_prefix(1);
+    }
+  }
+  if (!data.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "$0 extra bytes in block cache warm-up data", data.size());
+  }
+  return result;
+}
+
+} // namespace rocksdb
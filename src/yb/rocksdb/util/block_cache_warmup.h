@@ -0,0 +1,61 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "yb/rocksdb/cache.h"
+
+#include "yb/util/result.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+// Name of the file in the DB directory that lists the data blocks to load into the block cache
+// when the DB is opened.
+extern const char kBlockCacheWarmupFileName[];
+
+// Data blocks of a single SST file, keyed by block offset, with the sub cache each block was in.
+using CachedBlocks = std::unordered_map<uint64_t, SubCacheType>;
+
+// Data blocks of all SST files of a DB, keyed by SST file number.
+using CachedBlocksByFile = std::unordered_map<uint64_t, CachedBlocks>;
+
+// Keys of all entries of a block cache at some moment. The keys are sorted, so the blocks of a
+// table can be found by the cache key prefix of the table. Collecting the keys once and matching
+// them against the tables of every DB avoids walking a cache shared by many DBs once per DB.
+class BlockCacheKeys {
+ public:
+  static BlockCacheKeys Collect(Cache* cache);
+
+  // Returns the offsets of the blocks cached with the given cache key prefix.
+  CachedBlocks BlocksWithPrefix(Slice prefix) const;
+
+  size_t size() const {
+    return keys_.size();
+  }
+
+ private:
+  std::vector<std::pair<std::string, SubCacheType>> keys_;
+};
+
+std::string EncodeCachedBlocks(const CachedBlocksByFile& blocks);
+yb::Result<CachedBlocksByFile> DecodeCachedBlocks(Slice data);
+
+} // namespace rocksdb
@@ -23,10 +23,15 @@
 
 #include <math.h>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "yb/rocksdb/filter_policy.h"
 
 #include "yb/rocksdb/util/hash.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/util/hash_util.h"
 #include "yb/util/slice.h"
 #include "yb/util/math_util.h"
 
@@ -530,6 +535,191 @@ class FixedSizeFilterPolicy : public FilterPolicy {
   Logger* logger_;
 };
 
+// Cache-line-blocked Bloom filter, where each key sets exactly one bit in each of 8 32-bit words
+// of a single 256-bit block (split block Bloom filter). Probing touches a single cache line and
+// has no data-dependent branches: all 8 bit positions are computed with independent
+// multiplications and checked at once, which is done with AVX2 instructions when available.
+// It needs about 10% more bits per key than FixedSizeFilterBitsBuilder for the same false positive
+// rate, trading memory for probe latency.
+//
+// Encoding is similar to FullFilter: blocks followed by num_probes (1 byte, always 8) and
+// num_blocks (4 bytes).
+constexpr size_t kBlockedBloomWords = 8;
+constexpr size_t kBlockedBloomBlockSize = kBlockedBloomWords * sizeof(uint32_t);
+constexpr size_t kBlockedBloomMetaDataSize = 5;
+
+alignas(32) constexpr uint32_t kBlockedBloomSalts[kBlockedBloomWords] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+inline uint64_t BlockedBloomHash(const Slice& key) {
+  return yb::HashUtil::MurmurHash2_64(key.data(), key.size(), /* seed = */ 0);
+}
+
+inline size_t BlockedBloomBlockIndex(uint64_t hash, size_t num_blocks) {
+  return static_cast<size_t>(((hash >> 32) * num_blocks) >> 32);
+}
+
+inline uint32_t BlockedBloomBit(uint32_t hash, size_t word) {
+  return 1U << ((hash * kBlockedBloomSalts[word]) >> 27);
+}
+
+// Expected false positive rate when each block contains keys_per_block keys on average.
+double BlockedBloomErrorRate(double keys_per_block) {
+  // Number of keys in a block follows Poisson distribution.
+  double probability = exp(-keys_per_block);
+  double result = 0;
+  for (size_t keys = 0; keys != 1000; ++keys) {
+    result += probability * pow(1 - pow(1 - 1.0 / 32, keys), kBlockedBloomWords);
+    probability *= keys_per_block / (keys + 1);
+  }
+  return result;
+}
+
+class FixedSizeBlockedBloomBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeBlockedBloomBitsBuilder(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsBuilder&) = delete;
+
+  FixedSizeBlockedBloomBitsBuilder(size_t total_bits, size_t max_keys_per_block)
+      : num_blocks_(std::max<size_t>(total_bits / (kBlockedBloomBlockSize * 8), 1)),
+        max_keys_(num_blocks_ * max_keys_per_block) {
+    data_.reset(new char[FilterSize()]);
+    memset(data_.get(), 0, FilterSize());
+  }
+
+  void AddKey(const Slice& key) override {
+    ++keys_added_;
+    const uint64_t hash = BlockedBloomHash(key);
+    char* block = data_.get() + BlockedBloomBlockIndex(hash, num_blocks_) * kBlockedBloomBlockSize;
+    for (size_t i = 0; i != kBlockedBloomWords; ++i) {
+      char* word = block + i * sizeof(uint32_t);
+      EncodeFixed32(word, DecodeFixed32(word) | BlockedBloomBit(static_cast<uint32_t>(hash), i));
+    }
+  }
+
+  bool IsFull() const override { return keys_added_ >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    const size_t data_size = num_blocks_ * kBlockedBloomBlockSize;
+    data_[data_size] = static_cast<char>(kBlockedBloomWords);
+    EncodeFixed32(data_.get() + data_size + 1, static_cast<uint32_t>(num_blocks_));
+    buf->reset(data_.release());
+    return Slice(buf->get(), FilterSize());
+  }
+
+ private:
+  size_t FilterSize() const {
+    return num_blocks_ * kBlockedBloomBlockSize + kBlockedBloomMetaDataSize;
+  }
+
+  std::unique_ptr<char[]> data_;
+  const size_t num_blocks_;
+  const size_t max_keys_;
+  size_t keys_added_ = 0;
+};
+
+class FixedSizeBlockedBloomBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeBlockedBloomBitsReader(const FixedSizeBlockedBloomBitsReader&) = delete;
+  void operator=(const FixedSizeBlockedBloomBitsReader&) = delete;
+
+  FixedSizeBlockedBloomBitsReader(const Slice& contents, Logger* logger)
+      : data_(contents.cdata()) {
+    if (contents.size() <= kBlockedBloomMetaDataSize) {
+      // Filter is empty or broken.
+      num_blocks_ = 0;
+      return;
+    }
+    const size_t data_size = contents.size() - kBlockedBloomMetaDataSize;
+    num_blocks_ = DecodeFixed32(data_ + data_size + 1);
+    if (static_cast<size_t>(data_[data_size]) != kBlockedBloomWords ||
+        data_size != num_blocks_ * kBlockedBloomBlockSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Bloom filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      num_blocks_ = 0;
+    }
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (num_blocks_ == 0) {
+      // Broken filter regarded as match.
+      return true;
+    }
+    const uint64_t hash = BlockedBloomHash(entry);
+    const char* block = data_ + BlockedBloomBlockIndex(hash, num_blocks_) * kBlockedBloomBlockSize;
+#ifdef __AVX2__
+    const __m256i salts = _mm256_load_si256(reinterpret_cast<const __m256i*>(kBlockedBloomSalts));
+    const __m256i shifts = _mm256_srli_epi32(
+        _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<uint32_t>(hash)), salts), 27);
+    const __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+    const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    return _mm256_testc_si256(bits, mask);
+#else
+    uint32_t missing = 0;
+    for (size_t i = 0; i != kBlockedBloomWords; ++i) {
+      const uint32_t bit = BlockedBloomBit(static_cast<uint32_t>(hash), i);
+      missing |= ~DecodeFixed32(block + i * sizeof(uint32_t)) & bit;
+    }
+    return missing == 0;
+#endif
+  }
+
+ private:
+  const char* data_;
+  size_t num_blocks_;
+};
+
+class FixedSizeBlockedBloomFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeBlockedBloomFilterPolicy(size_t total_bits, double error_rate, Logger* logger)
+      : total_bits_(total_bits),
+        logger_(logger) {
+    DCHECK_GT(error_rate, 0);
+    // Binary search for the maximum average number of keys per block meeting error rate.
+    double min_keys = 0;
+    double max_keys = kBlockedBloomBlockSize * 8;
+    for (int i = 0; i != 50; ++i) {
+      const double keys = (min_keys + max_keys) / 2;
+      if (BlockedBloomErrorRate(keys) <= error_rate) {
+        min_keys = keys;
+      } else {
+        max_keys = keys;
+      }
+    }
+    max_keys_per_block_ = std::max<size_t>(static_cast<size_t>(min_keys), 1);
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeBlockedBloomFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeBlockedBloomFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeBlockedBloomBitsBuilder(total_bits_, max_keys_per_block_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeBlockedBloomBitsReader(contents, logger_);
+  }
+
+ private:
+  size_t total_bits_;
+  size_t max_keys_per_block_;
+  Logger* logger_;
+};
+
 }  // namespace
 
 const FilterPolicy* NewBloomFilterPolicy(int bits_per_key,
@@ -544,4 +734,10 @@ const FilterPolicy* NewFixedSizeFilterPolicy(size_t total_bits,
   return new FixedSizeFilterPolicy(total_bits, error_rate, logger);
 }
 
+const FilterPolicy* NewFixedSizeBlockedBloomFilterPolicy(size_t total_bits,
+                                                         double error_rate,
+                                                         Logger* logger) {
+  return new FixedSizeBlockedBloomFilterPolicy(total_bits, error_rate, logger);
+}
+
 }  // namespace rocksdb
@@ -236,7 +236,30 @@ class FixedSizeFilterBloomTestContext : public BloomTestContext {
           nullptr)};
 };
 
-YB_DEFINE_ENUM(BuilderReaderBloomTestType, (kFullFilter)(kFixedSizeFilter));
+class FixedSizeRibbonFilterTestContext : public FixedSizeFilterBloomTestContext {
+ public:
+  const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
+
+ private:
+  std::unique_ptr<const FilterPolicy> filter_policy_{
+      NewFixedSizeRibbonFilterPolicy(
+          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+          nullptr)};
+};
+
+class FixedSizeBlockedBloomFilterTestContext : public FixedSizeFilterBloomTestContext {
+ public:
+  const FilterPolicy& filter_policy() const override { return *filter_policy_.get(); }
+
+ private:
+  std::unique_ptr<const FilterPolicy> filter_policy_{
+      NewFixedSizeBlockedBloomFilterPolicy(
+          FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+          nullptr)};
+};
+
+YB_DEFINE_ENUM(BuilderReaderBloomTestType,
+    (kFullFilter)(kFixedSizeFilter)(kFixedSizeRibbonFilter)(kFixedSizeBlockedBloomFilter));
 
 namespace {
 
@@ -246,6 +269,10 @@ std::unique_ptr<const BloomTestContext> CreateContext(BuilderReaderBloomTestType
       return std::make_unique<FullFilterBloomTestContext>();
     case BuilderReaderBloomTestType::kFixedSizeFilter:
       return std::make_unique<FixedSizeFilterBloomTestContext>();
+    case BuilderReaderBloomTestType::kFixedSizeRibbonFilter:
+      return std::make_unique<FixedSizeRibbonFilterTestContext>();
+    case BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter:
+      return std::make_unique<FixedSizeBlockedBloomFilterTestContext>();
   }
   FATAL_INVALID_ENUM_VALUE(BuilderReaderBloomTestType, type);
 }
@@ -374,7 +401,37 @@ TEST_P(BuilderReaderBloomTest, FullVaryingLengths) {
 
 INSTANTIATE_TEST_CASE_P(, BuilderReaderBloomTest, ::testing::Values(
     BuilderReaderBloomTestType::kFullFilter,
-    BuilderReaderBloomTestType::kFixedSizeFilter));
+    BuilderReaderBloomTestType::kFixedSizeFilter,
+    BuilderReaderBloomTestType::kFixedSizeRibbonFilter,
+    BuilderReaderBloomTestType::kFixedSizeBlockedBloomFilter));
+
+namespace {
+
+size_t KeysPerFilterBlock(const FilterPolicy& policy) {
+  char buffer[sizeof(size_t)];
+  std::unique_ptr<FilterBitsBuilder> builder(policy.GetFilterBitsBuilder());
+  size_t result = 0;
+  while (!builder->IsFull()) {
+    builder->AddKey(Key(result++, buffer));
+  }
+  return result;
+}
+
+} // namespace
+
+// Ribbon filter block of the same size should fit considerably more keys than bloom filter block.
+TEST_F(BloomTest, RibbonFilterKeysPerBlock) {
+  std::unique_ptr<const FilterPolicy> bloom(NewFixedSizeFilterPolicy(
+      FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+      nullptr));
+  std::unique_ptr<const FilterPolicy> ribbon(NewFixedSizeRibbonFilterPolicy(
+      FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+      nullptr));
+  const auto bloom_keys = KeysPerFilterBlock(*bloom);
+  const auto ribbon_keys = KeysPerFilterBlock(*ribbon);
+  LOG(INFO) << "Keys per filter block, bloom: " << bloom_keys << ", ribbon: " << ribbon_keys;
+  ASSERT_GE(ribbon_keys, bloom_keys * 5 / 4);
+}
 
 }  // namespace rocksdb
 
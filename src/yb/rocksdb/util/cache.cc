@@ -24,6 +24,11 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -49,6 +54,13 @@ DEFINE_UNKNOWN_bool(cache_overflow_single_touch, true,
             "Whether to enable overflow of single touch cache into the multi touch cache "
             "allocation");
 
+DEFINE_NON_RUNTIME_bool(cache_adaptive_single_touch, false,
+            "Whether to adapt the split between single touch and multi touch caches to the "
+            "workload. When enabled, each cache shard remembers keys of recently evicted entries "
+            "(ghost lists, as in ARC) and moves capacity to the sub cache whose evicted entries "
+            "are requested again. cache_single_touch_ratio is used as the initial split. "
+            "Has no effect when cache_single_touch_ratio is 0 or 1.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -376,6 +388,66 @@ class LRUHandleDeleter {
   autovector<LRUHandle*> handles_;
 };
 
+// Ghost list remembers hashes of recently evicted entries with their charge, but not their values.
+// It is used by the adaptive policy to detect that an entry evicted from a sub cache was requested
+// again, i.e. that the sub cache is too small for the current workload.
+class GhostList {
+ public:
+  // Remembers the hash, forgetting the oldest ones while total charge exceeds capacity.
+  void Add(uint32_t hash, size_t charge, size_t capacity) {
+    Remove(hash);
+    entries_.push_back(Entry{hash, charge});
+    index_.emplace(hash, std::prev(entries_.end()));
+    usage_ += charge;
+    Trim(capacity);
+  }
+
+  // Returns true if hash was present in the list.
+  bool Remove(uint32_t hash) {
+    auto it = index_.find(hash);
+    if (it == index_.end()) {
+      return false;
+    }
+    usage_ -= it->second->charge;
+    entries_.erase(it->second);
+    index_.erase(it);
+    return true;
+  }
+
+  void Trim(size_t capacity) {
+    while (usage_ > capacity && !entries_.empty()) {
+      const auto& oldest = entries_.front();
+      usage_ -= oldest.charge;
+      index_.erase(oldest.hash);
+      entries_.pop_front();
+    }
+  }
+
+  // Total charge of the entries that were evicted.
+  size_t Usage() const {
+    return usage_;
+  }
+
+ private:
+  struct Entry {
+    uint32_t hash;
+    size_t charge;
+  };
+
+  // Front is the oldest evicted entry.
+  std::list<Entry> entries_;
+  std::unordered_map<uint32_t, std::list<Entry>::iterator> index_;
+  size_t usage_ = 0;
+};
+
+// Minimal fraction of the shard capacity that adaptive policy keeps for each sub cache.
+constexpr double kMinAdaptiveSubCacheFraction = 0.05;
+
+bool IsAdaptiveSingleTouch() {
+  return FLAGS_cache_adaptive_single_touch &&
+         FLAGS_cache_single_touch_ratio > 0 && FLAGS_cache_single_touch_ratio < 1;
+}
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -388,8 +460,15 @@ class LRUCache {
   void SetCapacity(size_t capacity);
 
   void SetMetrics(shared_ptr<yb::CacheMetrics> metrics) {
+    MutexLock l(&mutex_);
+    if (metrics_) {
+      metrics_->multi_touch_cache_capacity->DecrementBy(multi_touch_capacity_);
+    }
     metrics_ = metrics;
     table_.SetMetrics(metrics);
+    if (metrics_) {
+      metrics_->multi_touch_cache_capacity->IncrementBy(multi_touch_capacity_);
+    }
   }
 
   // Set the flag to reject insertion if cache if full.
@@ -422,6 +501,8 @@ class LRUCache {
   void ApplyToAllCacheEntries(void (*callback)(void*, size_t),
                               bool thread_safe);
 
+  void ApplyToAllCacheKeys(const Cache::CacheKeyCallback& callback);
+
   std::pair<size_t, size_t> TEST_GetIndividualUsages() {
     return std::pair<size_t, size_t>(
         single_touch_sub_cache_.Usage(), multi_touch_sub_cache_.Usage());
@@ -436,8 +517,21 @@ class LRUCache {
   LRUSubCache single_touch_sub_cache_;
   LRUSubCache multi_touch_sub_cache_;
 
-  size_t total_capacity_;
-  size_t multi_touch_capacity_;
+  size_t total_capacity_ = 0;
+  size_t multi_touch_capacity_ = 0;
+
+  // Ghost lists of the adaptive policy. Contain entries recently evicted from the corresponding
+  // sub cache. Used only when IsAdaptiveSingleTouch() is true.
+  GhostList single_touch_ghosts_;
+  GhostList multi_touch_ghosts_;
+
+  // Updates multi_touch_capacity_ together with the related metric.
+  void SetMultiTouchCapacity(size_t capacity);
+
+  // Checks whether entry with specified hash was recently evicted from one of sub caches.
+  // If so, moves capacity to that sub cache and returns true, meaning that the entry should be
+  // inserted into the multi touch cache, since it is accessed repeatedly.
+  bool AdaptOnGhostHit(uint32_t hash, size_t charge);
 
   // Just reduce the reference count by 1.
   // Return true if last reference
@@ -478,7 +572,12 @@ class LRUCache {
 
 LRUCache::LRUCache() {}
 
-LRUCache::~LRUCache() {}
+LRUCache::~LRUCache() {
+  // The capacity of this shard is no longer part of the cache.
+  if (metrics_) {
+    metrics_->multi_touch_cache_capacity->DecrementBy(multi_touch_capacity_);
+  }
+}
 
 bool LRUCache::Unref(LRUHandle* e) {
   assert(e->refs > 0);
@@ -515,6 +614,13 @@ void LRUCache::ApplyToAllCacheEntries(void (*callback)(void*, size_t),
   }
 }
 
+void LRUCache::ApplyToAllCacheKeys(const Cache::CacheKeyCallback& callback) {
+  MutexLock l(&mutex_);
+  table_.ApplyToAllCacheEntries([&callback](LRUHandle* h) {
+    callback(h->key(), h->GetSubCacheType());
+  });
+}
+
 void LRUCache::LRU_Remove(LRUHandle* e) {
   GetSubCache(e->GetSubCacheType())->LRU_Remove(e);
 }
@@ -551,17 +657,67 @@ void LRUCache::EvictFromLRU(const size_t charge,
     old->in_cache = false;
     Unref(old);
     sub_cache->DecrementUsage(old->charge);
+    if (IsAdaptiveSingleTouch()) {
+      auto& ghosts = old->GetSubCacheType() == MULTI_TOUCH ? multi_touch_ghosts_
+                                                           : single_touch_ghosts_;
+      ghosts.Add(old->hash, old->charge, total_capacity_);
+    }
     deleted->Add(old);
   }
 }
 
+void LRUCache::SetMultiTouchCapacity(size_t capacity) {
+  if (metrics_) {
+    if (capacity > multi_touch_capacity_) {
+      metrics_->multi_touch_cache_capacity->IncrementBy(capacity - multi_touch_capacity_);
+    } else {
+      metrics_->multi_touch_cache_capacity->DecrementBy(multi_touch_capacity_ - capacity);
+    }
+  }
+  multi_touch_capacity_ = capacity;
+}
+
+bool LRUCache::AdaptOnGhostHit(uint32_t hash, size_t charge) {
+  const auto min_capacity = static_cast<size_t>(kMinAdaptiveSubCacheFraction * total_capacity_);
+  const size_t max_multi_touch_capacity =
+      total_capacity_ > min_capacity ? total_capacity_ - min_capacity : 0;
+  if (single_touch_ghosts_.Remove(hash)) {
+    // The entry was evicted from the single touch cache before it was requested again,
+    // so the single touch cache should grow. Like ARC, adapt faster when the other ghost list is
+    // larger.
+    size_t delta = charge * std::max<size_t>(
+        1, multi_touch_ghosts_.Usage() / std::max<size_t>(1, single_touch_ghosts_.Usage()));
+    SetMultiTouchCapacity(
+        multi_touch_capacity_ > min_capacity + delta ? multi_touch_capacity_ - delta
+                                                     : std::min(min_capacity,
+                                                                multi_touch_capacity_));
+    if (metrics_) {
+      metrics_->single_touch_ghost_hits->Increment();
+    }
+    return true;
+  }
+  if (multi_touch_ghosts_.Remove(hash)) {
+    size_t delta = charge * std::max<size_t>(
+        1, single_touch_ghosts_.Usage() / std::max<size_t>(1, multi_touch_ghosts_.Usage()));
+    SetMultiTouchCapacity(std::max(
+        multi_touch_capacity_, std::min(multi_touch_capacity_ + delta, max_multi_touch_capacity)));
+    if (metrics_) {
+      metrics_->multi_touch_ghost_hits->Increment();
+    }
+    return true;
+  }
+  return false;
+}
+
 void LRUCache::SetCapacity(size_t capacity) {
   LRUHandleDeleter last_reference_list(metrics_.get());
 
   {
     MutexLock l(&mutex_);
-    multi_touch_capacity_ = round((1 - FLAGS_cache_single_touch_ratio) * capacity);
+    SetMultiTouchCapacity(round((1 - FLAGS_cache_single_touch_ratio) * capacity));
     total_capacity_ = capacity;
+    single_touch_ghosts_.Trim(capacity);
+    multi_touch_ghosts_.Trim(capacity);
     EvictFromLRU(0, &last_reference_list, MULTI_TOUCH);
     EvictFromLRU(0, &last_reference_list, SINGLE_TOUCH);
   }
@@ -744,6 +900,9 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else if (FLAGS_cache_single_touch_ratio == 1) {
       // If there is no multi touch cache, default to single cache.
       subcache_type = SINGLE_TOUCH;
+    } else if (IsAdaptiveSingleTouch() && AdaptOnGhostHit(hash, charge)) {
+      e->query_id = kInMultiTouchId;
+      subcache_type = MULTI_TOUCH;
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
@@ -998,6 +1157,13 @@ class ShardedLRUCache : public Cache {
     }
   }
 
+  void ApplyToAllCacheKeys(const CacheKeyCallback& callback) override {
+    int num_shards = 1 << num_shard_bits_;
+    for (int s = 0; s < num_shards; s++) {
+      shards_[s].ApplyToAllCacheKeys(callback);
+    }
+  }
+
   virtual void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
     int num_shards = 1 << num_shard_bits_;
     metrics_ = std::make_shared<yb::CacheMetrics>(entity);
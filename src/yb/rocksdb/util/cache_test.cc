@@ -21,6 +21,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <cmath>
 #include <forward_list>
 #include <string>
 #include <vector>
@@ -30,12 +31,15 @@
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/util/coding.h"
 
+#include "yb/util/cache_metrics.h"
+#include "yb/util/metrics.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 #include "yb/rocksdb/util/testutil.h"
 
 using std::shared_ptr;
 
+DECLARE_bool(cache_adaptive_single_touch);
 DECLARE_double(cache_single_touch_ratio);
 
 namespace rocksdb {
@@ -467,6 +471,55 @@ TEST_F(CacheTest, EvictionPolicyMultiTouch) {
   ASSERT_LT(kCacheSize * FLAGS_cache_single_touch_ratio, cache_->GetUsage());
 }
 
+TEST_F(CacheTest, AdaptiveSingleTouchGhostHit) {
+  google::FlagSaver saver;
+  FLAGS_cache_adaptive_single_touch = true;
+  const int kCapacity = 100;
+  // With strict capacity limit single touch cache does not overflow into multi touch cache,
+  // so it holds exactly kCapacity * FLAGS_cache_single_touch_ratio entries.
+  auto cache = NewLRUCache(kCapacity, 0, true);
+  const int kSingleTouchCapacity = kCapacity * FLAGS_cache_single_touch_ratio;
+  for (int i = 0; i < kSingleTouchCapacity * 2; i++) {
+    ASSERT_OK(Insert(cache, i, i + 1));
+  }
+  // First half of the entries was evicted from the single touch cache.
+  ASSERT_EQ(-1, Lookup(cache, 0));
+
+  // Entry is inserted again by the same query. It would be placed into the single touch cache
+  // again, but since it was recently evicted from it, it goes to the multi touch cache.
+  ASSERT_OK(Insert(cache, 0, 1));
+  ASSERT_TRUE(LookupAndCheckInMultiTouch(cache, 0, 1));
+
+  // Entry that was never evicted is still single touch.
+  ASSERT_OK(Insert(cache, 1000, 1001));
+  ASSERT_FALSE(LookupAndCheckInMultiTouch(cache, 1000, 1001));
+}
+
+TEST_F(CacheTest, MultiTouchCapacityMetric) {
+  yb::MetricRegistry registry;
+  auto entity = METRIC_ENTITY_server.Instantiate(&registry, "cache_test");
+  // Refers to the same gauges as the metrics created by the cache.
+  yb::CacheMetrics metrics(entity);
+  const size_t kCapacity = 1000;
+  auto multi_touch_capacity = [](size_t capacity) {
+    return static_cast<uint64_t>(round((1 - FLAGS_cache_single_touch_ratio) * capacity));
+  };
+
+  auto cache = NewLRUCache(kCapacity, 0);
+  cache->SetMetrics(entity);
+  ASSERT_EQ(multi_touch_capacity(kCapacity), metrics.multi_touch_cache_capacity->value());
+
+  cache->SetCapacity(kCapacity / 2);
+  ASSERT_EQ(multi_touch_capacity(kCapacity / 2), metrics.multi_touch_cache_capacity->value());
+
+  // Replacing the metrics does not count the capacity twice.
+  cache->SetMetrics(entity);
+  ASSERT_EQ(multi_touch_capacity(kCapacity / 2), metrics.multi_touch_cache_capacity->value());
+
+  cache.reset();
+  ASSERT_EQ(0, metrics.multi_touch_cache_capacity->value());
+}
+
 TEST_F(CacheTest, HeavyEntries) {
   // Add a bunch of light and heavy entries and then count the combined
   // size of items still in the cache, which must be approximately the
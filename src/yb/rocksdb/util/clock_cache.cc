@@ -0,0 +1,646 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// CLOCK cache implementation.
+//
+// Unlike LRU cache, lookup does not need to move the entry in any list, so it does not take
+// exclusive lock. Lookup only takes reader side of per-CPU reader-writer lock of the shard,
+// so concurrent lookups don't share any lock cache line. Found entry is pinned by atomic
+// increment of its reference counter and marked as recently used by setting its referenced bit.
+//
+// Insert, Erase and eviction take the writer side of the shard lock. Eviction uses CLOCK
+// algorithm: clock hand circles over entries of the shard, entries with referenced bit set
+// get a second chance (the bit is cleared), entries pinned by external references are skipped,
+// other entries are evicted.
+//
+// Reference counter of the entry contains number of external references plus one while the entry
+// is in the cache. Entry is freed when the counter reaches zero. Since eviction happens under the
+// writer lock, no concurrent lookup could pin the entry while it is being evicted, so eviction
+// could use compare-and-swap from 1 to 0 to detect unpinned entries.
+
+#include <string.h>
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/hash.h"
+
+#include "yb/util/cache_metrics.h"
+#include "yb/util/locks.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+#include "yb/util/shared_lock.h"
+
+namespace rocksdb {
+
+namespace {
+
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  // Fields below are protected by the writer lock of the shard.
+  ClockHandle* next_hash;
+  // Index of this entry in the clock of the shard.
+  size_t clock_index;
+  bool in_cache;
+
+  size_t charge;
+  size_t key_length;
+  uint32_t hash;
+
+  // Number of external references, plus one while entry is in the cache.
+  std::atomic<uint32_t> refs;
+  // Set by lookup, cleared by clock hand.
+  std::atomic<bool> referenced;
+
+  char key_data[1];   // Beginning of key
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+
+  static ClockHandle* Create(const Slice& key, uint32_t hash, void* value, size_t charge,
+                             void (*deleter)(const Slice&, void* value), uint32_t refs) {
+    auto* result = new (new char[sizeof(ClockHandle) - 1 + key.size()]) ClockHandle;
+    result->value = value;
+    result->deleter = deleter;
+    result->next_hash = nullptr;
+    result->clock_index = 0;
+    result->in_cache = true;
+    result->charge = charge;
+    result->key_length = key.size();
+    result->hash = hash;
+    result->refs.store(refs, std::memory_order_relaxed);
+    result->referenced.store(false, std::memory_order_relaxed);
+    memcpy(result->key_data, key.data(), key.size());
+    return result;
+  }
+
+  // Destroys the handle without calling deleter.
+  void Destroy() {
+    this->~ClockHandle();
+    delete[] reinterpret_cast<char*>(this);
+  }
+
+  void Free(yb::CacheMetrics* metrics) {
+    (*deleter)(key(), value);
+    if (metrics != nullptr) {
+      metrics->multi_touch_cache_usage->DecrementBy(charge);
+      metrics->cache_usage->DecrementBy(charge);
+    }
+    Destroy();
+  }
+};
+
+// Simple chained hash table, modified only under the writer lock of the shard.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() { Resize(); }
+
+  ~ClockHandleTable() {
+    delete[] list_;
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  // Returns previous entry with the same key, if any.
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > length_) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) const {
+    ClockHandle** ptr = &list_[hash & (length_ - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    uint32_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    ClockHandle** new_list = new ClockHandle*[new_length];
+    memset(new_list, 0, sizeof(new_list[0]) * new_length);
+    for (uint32_t i = 0; i < length_; i++) {
+      ClockHandle* h = list_[i];
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash;
+        ClockHandle** ptr = &new_list[h->hash & (new_length - 1)];
+        h->next_hash = *ptr;
+        *ptr = h;
+        h = next;
+      }
+    }
+    delete[] list_;
+    list_ = new_list;
+    length_ = new_length;
+  }
+
+  uint32_t length_ = 0;
+  uint32_t elems_ = 0;
+  ClockHandle** list_ = nullptr;
+};
+
+using ClockHandleList = autovector<ClockHandle*>;
+
+// A single shard of sharded CLOCK cache.
+class ClockCacheShard {
+ public:
+  ClockCacheShard() = default;
+
+  ~ClockCacheShard() {
+    for (auto* e : clock_) {
+      if (e->refs.load(std::memory_order_acquire) == 1) {
+        e->Free(metrics_.get());
+      }
+    }
+  }
+
+  void SetMetrics(std::shared_ptr<yb::CacheMetrics> metrics) {
+    std::lock_guard<yb::percpu_rwlock> lock(lock_);
+    metrics_ = std::move(metrics);
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) {
+    std::lock_guard<yb::percpu_rwlock> lock(lock_);
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetCapacity(size_t capacity) {
+    ClockHandleList evicted;
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(lock_);
+      capacity_ = capacity;
+      EvictFromClock(0, &evicted);
+    }
+    FreeAll(evicted);
+  }
+
+  Status Insert(const Slice& key, uint32_t hash, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+                Statistics* statistics) {
+    // One reference from the cache, one for the returned handle.
+    ClockHandle* e = ClockHandle::Create(
+        key, hash, value, charge, deleter, handle == nullptr ? 1 : 2);
+    ClockHandleList last_reference_list;
+    ClockHandle* rejected = nullptr;
+    Status s;
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(lock_);
+      EvictFromClock(charge, &last_reference_list);
+      if (strict_capacity_limit_ &&
+          usage_.load(std::memory_order_acquire) + charge > capacity_) {
+        if (handle == nullptr) {
+          // Entry was never added, but caller expects value to be cleaned up.
+          rejected = e;
+        } else {
+          e->Destroy();
+          *handle = nullptr;
+        }
+        s = STATUS(Incomplete, "Insert failed due to CLOCK cache being full.");
+      } else {
+        usage_.fetch_add(charge, std::memory_order_acq_rel);
+        ClockHandle* old = table_.Insert(e);
+        if (old != nullptr) {
+          RemoveFromClock(old);
+          if (Unref(old)) {
+            last_reference_list.push_back(old);
+          }
+        }
+        e->clock_index = clock_.size();
+        clock_.push_back(e);
+        if (handle != nullptr) {
+          *handle = reinterpret_cast<Cache::Handle*>(e);
+        }
+        if (metrics_) {
+          metrics_->multi_touch_cache_usage->IncrementBy(charge);
+          metrics_->cache_usage->IncrementBy(charge);
+        }
+      }
+    }
+    if (statistics != nullptr) {
+      if (s.ok()) {
+        RecordTick(statistics, BLOCK_CACHE_ADD);
+        RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+      }
+    }
+    if (rejected != nullptr) {
+      (*rejected->deleter)(rejected->key(), rejected->value);
+      rejected->Destroy();
+    }
+    FreeAll(last_reference_list);
+    return s;
+  }
+
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, Statistics* statistics) {
+    ClockHandle* e;
+    {
+      yb::SharedLock<yb::rw_spinlock> lock(lock_.get_lock());
+      e = table_.Lookup(key, hash);
+      if (e != nullptr) {
+        // Eviction requires writer lock, so entry could not be evicted while we are pinning it.
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        if (!e->referenced.load(std::memory_order_relaxed)) {
+          e->referenced.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+    if (statistics != nullptr) {
+      if (e != nullptr) {
+        RecordTick(statistics, BLOCK_CACHE_HIT);
+        RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+      } else {
+        RecordTick(statistics, BLOCK_CACHE_MISS);
+      }
+    }
+    if (metrics_) {
+      metrics_->lookups->Increment();
+      if (e != nullptr) {
+        metrics_->cache_hits->Increment();
+      } else {
+        metrics_->cache_misses->Increment();
+      }
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+  }
+
+  void Release(Cache::Handle* handle) {
+    if (handle == nullptr) {
+      return;
+    }
+    auto* e = reinterpret_cast<ClockHandle*>(handle);
+    // Entry could reach zero references only after it was removed from the cache, so there is no
+    // need to take the lock.
+    if (Unref(e)) {
+      e->Free(metrics_.get());
+    }
+  }
+
+  void Erase(const Slice& key, uint32_t hash) {
+    ClockHandle* e;
+    bool last_reference = false;
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(lock_);
+      e = table_.Remove(key, hash);
+      if (e != nullptr) {
+        RemoveFromClock(e);
+        last_reference = Unref(e);
+      }
+    }
+    if (last_reference) {
+      e->Free(metrics_.get());
+    }
+  }
+
+  size_t Evict(size_t required) {
+    ClockHandleList evicted;
+    {
+      std::lock_guard<yb::percpu_rwlock> lock(lock_);
+      auto usage = usage_.load(std::memory_order_acquire);
+      if (usage > required) {
+        EvictUntil(usage - required, &evicted);
+      } else {
+        EvictUntil(0, &evicted);
+      }
+    }
+    size_t result = 0;
+    for (auto* e : evicted) {
+      result += e->charge;
+    }
+    FreeAll(evicted);
+    return result;
+  }
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_acquire);
+  }
+
+  size_t GetPinnedUsage() const {
+    yb::SharedLock<yb::rw_spinlock> lock(lock_.get_lock());
+    size_t result = 0;
+    for (auto* e : clock_) {
+      if (e->refs.load(std::memory_order_acquire) > 1) {
+        result += e->charge;
+      }
+    }
+    return result;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+    if (thread_safe) {
+      yb::SharedLock<yb::rw_spinlock> lock(lock_.get_lock());
+      DoApplyToAllCacheEntries(callback);
+    } else {
+      DoApplyToAllCacheEntries(callback);
+    }
+  }
+
+ private:
+  void DoApplyToAllCacheEntries(void (*callback)(void*, size_t)) {
+    for (auto* e : clock_) {
+      callback(e->value, e->charge);
+    }
+  }
+
+  // Returns true if the last reference was released, i.e. the entry should be freed.
+  bool Unref(ClockHandle* e) {
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return false;
+    }
+    usage_.fetch_sub(e->charge, std::memory_order_acq_rel);
+    return true;
+  }
+
+  // Should be called under the writer lock.
+  void RemoveFromClock(ClockHandle* e) {
+    auto index = e->clock_index;
+    DCHECK_EQ(clock_[index], e);
+    clock_[index] = clock_.back();
+    clock_[index]->clock_index = index;
+    clock_.pop_back();
+    if (clock_hand_ >= clock_.size()) {
+      clock_hand_ = 0;
+    }
+    e->in_cache = false;
+  }
+
+  // Frees space for an entry with specified charge.
+  // Should be called under the writer lock.
+  void EvictFromClock(size_t charge, ClockHandleList* evicted) {
+    EvictUntil(capacity_ > charge ? capacity_ - charge : 0, evicted);
+  }
+
+  // Evicts entries until usage is not greater than target_usage, or all entries are pinned.
+  // Should be called under the writer lock.
+  void EvictUntil(size_t target_usage, ClockHandleList* evicted) {
+    // Each entry could be visited twice, first time to clear referenced bit, second time to evict.
+    size_t steps_left = 2 * clock_.size();
+    while (usage_.load(std::memory_order_acquire) > target_usage && !clock_.empty() &&
+           steps_left-- > 0) {
+      ClockHandle* e = clock_[clock_hand_];
+      uint32_t expected_refs = 1;
+      if (e->refs.load(std::memory_order_acquire) != expected_refs ||
+          e->referenced.exchange(false, std::memory_order_acq_rel)) {
+        // Entry is pinned or it was used recently.
+        clock_hand_ = (clock_hand_ + 1) % clock_.size();
+        continue;
+      }
+      // Lookups are blocked by the writer lock, so nobody could pin the entry concurrently.
+      // But external reference could be released, so use compare-and-swap.
+      if (!e->refs.compare_exchange_strong(expected_refs, 0, std::memory_order_acq_rel)) {
+        clock_hand_ = (clock_hand_ + 1) % clock_.size();
+        continue;
+      }
+      usage_.fetch_sub(e->charge, std::memory_order_acq_rel);
+      table_.Remove(e->key(), e->hash);
+      // Moves the last entry to the current position of the clock hand, so the hand stays.
+      RemoveFromClock(e);
+      evicted->push_back(e);
+      if (metrics_) {
+        metrics_->evictions->Increment();
+      }
+    }
+  }
+
+  void FreeAll(const ClockHandleList& handles) {
+    for (auto* e : handles) {
+      e->Free(metrics_.get());
+    }
+  }
+
+  mutable yb::percpu_rwlock lock_;
+
+  ClockHandleTable table_;
+  // All entries of the shard in the cache. Protected by the writer lock.
+  std::vector<ClockHandle*> clock_;
+  size_t clock_hand_ = 0;
+
+  size_t capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+
+  // Total charge of entries that were not freed yet, including pinned entries that were already
+  // removed from the cache.
+  std::atomic<size_t> usage_{0};
+
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+constexpr int kDefaultNumShardBits = 4;
+
+class ShardedClockCache : public Cache {
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : num_shard_bits_(num_shard_bits),
+        shards_(new ClockCacheShard[1 << num_shard_bits]),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    const size_t per_shard = PerShardCapacity(capacity);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+      shards_[s].SetCapacity(per_shard);
+    }
+  }
+
+  virtual ~ShardedClockCache() {
+    delete[] shards_;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(key, hash, value, charge, deleter, handle, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    if (handle == nullptr) {
+      return;
+    }
+    auto* h = reinterpret_cast<ClockHandle*>(handle);
+    shards_[Shard(h->hash)].Release(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t per_shard = PerShardCapacity(capacity);
+    std::lock_guard<std::mutex> lock(capacity_mutex_);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  void DisownData() override {
+    shards_ = nullptr;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetMetrics(metrics_);
+    }
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (int i = 0; bytes_to_evict > total_evicted && i != num_shards(); ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (num_shards() - 1);
+    }
+    return total_evicted;
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    // CLOCK cache does not have single touch sub cache, all entries are reported as multi touch.
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(num_shards());
+    for (int s = 0; s != num_shards(); ++s) {
+      cache_sizes.emplace_back(0, shards_[s].GetUsage());
+    }
+    return cache_sizes;
+  }
+
+ private:
+  static uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) const {
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  int num_shards() const {
+    return 1 << num_shard_bits_;
+  }
+
+  size_t PerShardCapacity(size_t capacity) const {
+    return (capacity + (num_shards() - 1)) / num_shards();
+  }
+
+  const int num_shard_bits_;
+  ClockCacheShard* shards_;
+  std::mutex capacity_mutex_;
+  size_t capacity_;
+  const bool strict_capacity_limit_;
+  std::atomic<uint64_t> last_id_{0};
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+} // namespace
+
+std::shared_ptr<Cache> NewClockCache(size_t capacity) {
+  return NewClockCache(capacity, kDefaultNumShardBits, false);
+}
+
+std::shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                     bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
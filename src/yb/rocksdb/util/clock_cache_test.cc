@@ -0,0 +1,216 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/testutil.h"
+
+#include "yb/util/status_log.h"
+#include "yb/util/test_macros.h"
+
+namespace rocksdb {
+
+namespace {
+
+std::string EncodeKey(int k) {
+  std::string result;
+  PutFixed32(&result, k);
+  return result;
+}
+
+int DecodeKey(const Slice& k) {
+  assert(k.size() == 4);
+  return DecodeFixed32(k.data());
+}
+
+void* EncodeValue(uintptr_t v) {
+  return reinterpret_cast<void*>(v);
+}
+
+int DecodeValue(void* v) {
+  return static_cast<int>(reinterpret_cast<uintptr_t>(v));
+}
+
+constexpr QueryId kTestQueryId = 1;
+
+} // namespace
+
+class ClockCacheTest : public RocksDBTest {
+ public:
+  static ClockCacheTest* current_;
+
+  static void Deleter(const Slice& key, void* v) {
+    current_->deleted_keys_.push_back(DecodeKey(key));
+    current_->deleted_values_.push_back(DecodeValue(v));
+  }
+
+  ClockCacheTest() {
+    current_ = this;
+  }
+
+  int Lookup(const std::shared_ptr<Cache>& cache, int key) {
+    Cache::Handle* handle = cache->Lookup(EncodeKey(key), kTestQueryId);
+    const int r = (handle == nullptr) ? -1 : DecodeValue(cache->Value(handle));
+    if (handle != nullptr) {
+      cache->Release(handle);
+    }
+    return r;
+  }
+
+  Status Insert(const std::shared_ptr<Cache>& cache, int key, int value, int charge = 1) {
+    return cache->Insert(EncodeKey(key), kTestQueryId, EncodeValue(value), charge,
+                         &ClockCacheTest::Deleter);
+  }
+
+  std::vector<int> deleted_keys_;
+  std::vector<int> deleted_values_;
+};
+
+ClockCacheTest* ClockCacheTest::current_;
+
+TEST_F(ClockCacheTest, HitAndMiss) {
+  auto cache = NewClockCache(100, 0, false);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(-1, Lookup(cache, 200));
+
+  ASSERT_OK(Insert(cache, 200, 201));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(201, Lookup(cache, 200));
+
+  // Replacing value frees the old one.
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(100, deleted_keys_[0]);
+  ASSERT_EQ(101, deleted_values_[0]);
+}
+
+TEST_F(ClockCacheTest, EntriesArePinned) {
+  auto cache = NewClockCache(100, 0, false);
+  ASSERT_OK(Insert(cache, 100, 101));
+  Cache::Handle* h1 = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(101, DecodeValue(cache->Value(h1)));
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+
+  cache->Erase(EncodeKey(100));
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  // Value is not freed while handle is held.
+  ASSERT_EQ(0U, deleted_keys_.size());
+
+  cache->Release(h1);
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(0U, cache->GetUsage());
+}
+
+TEST_F(ClockCacheTest, SecondChance) {
+  constexpr int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0, false);
+  for (int i = 0; i != kCapacity; ++i) {
+    ASSERT_OK(Insert(cache, i, i + 1));
+  }
+  // Recently used entry gets a second chance and survives eviction of a single entry.
+  ASSERT_EQ(1, Lookup(cache, 0));
+  ASSERT_OK(Insert(cache, kCapacity, kCapacity + 1));
+  ASSERT_EQ(1, Lookup(cache, 0));
+  ASSERT_EQ(kCapacity + 1, Lookup(cache, kCapacity));
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_NE(0, deleted_keys_[0]);
+  ASSERT_EQ(static_cast<size_t>(kCapacity), cache->GetUsage());
+}
+
+TEST_F(ClockCacheTest, StrictCapacityLimit) {
+  constexpr int kCapacity = 10;
+  auto cache = NewClockCache(kCapacity, 0, true);
+  std::vector<Cache::Handle*> handles;
+  for (int i = 0; i != kCapacity; ++i) {
+    Cache::Handle* handle = nullptr;
+    ASSERT_OK(cache->Insert(
+        EncodeKey(i), kTestQueryId, EncodeValue(i), 1, &ClockCacheTest::Deleter, &handle));
+    handles.push_back(handle);
+  }
+  // All entries are pinned, so nothing could be evicted.
+  Cache::Handle* handle = nullptr;
+  auto s = cache->Insert(
+      EncodeKey(kCapacity), kTestQueryId, EncodeValue(kCapacity), 1, &ClockCacheTest::Deleter,
+      &handle);
+  ASSERT_TRUE(s.IsIncomplete());
+  ASSERT_EQ(nullptr, handle);
+  // When handle is not requested, value is cleaned up by the cache.
+  ASSERT_TRUE(Insert(cache, kCapacity, kCapacity).IsIncomplete());
+  ASSERT_EQ(1U, deleted_keys_.size());
+
+  for (auto* h : handles) {
+    cache->Release(h);
+  }
+  ASSERT_OK(Insert(cache, kCapacity, kCapacity));
+  ASSERT_EQ(static_cast<size_t>(kCapacity), cache->GetUsage());
+}
+
+TEST_F(ClockCacheTest, Evict) {
+  auto cache = NewClockCache(100, 2, false);
+  for (int i = 0; i != 100; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  ASSERT_EQ(100U, cache->GetUsage());
+  ASSERT_GE(cache->Evict(50), 50U);
+  ASSERT_LE(cache->GetUsage(), 50U);
+}
+
+TEST_F(ClockCacheTest, ConcurrentLookups) {
+  constexpr int kNumKeys = 1000;
+  constexpr int kNumThreads = 8;
+  auto cache = NewClockCache(kNumKeys / 2, 4, false);
+
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([cache, &stop, t] {
+      int i = t;
+      while (!stop.load(std::memory_order_acquire)) {
+        auto key = EncodeKey(i % kNumKeys);
+        Cache::Handle* handle = cache->Lookup(key, kTestQueryId);
+        if (handle != nullptr) {
+          CHECK_EQ(DecodeValue(cache->Value(handle)), i % kNumKeys);
+          cache->Release(handle);
+        } else {
+          CHECK_OK(cache->Insert(
+              key, kTestQueryId, EncodeValue(i % kNumKeys), 1, [](const Slice&, void*) {}));
+        }
+        i = (i + kNumThreads + 1) % kNumKeys;
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  stop.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kNumKeys));
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+}
+
+}  // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -30,6 +30,13 @@
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
 #endif
+#ifdef __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
 #include "yb/rocksdb/util/coding.h"
 
 namespace rocksdb {
@@ -305,7 +312,7 @@ static inline uint32_t LE_LOAD32(const uint8_t *p) {
   return DecodeFixed32(reinterpret_cast<const char*>(p));
 }
 
-#ifdef __SSE4_2__
+#if defined(__SSE4_2__) || defined(__ARM_FEATURE_CRC32)
 #ifdef __LP64__
 static inline uint64_t LE_LOAD64(const uint8_t *p) {
   return DecodeFixed64(reinterpret_cast<const char*>(p));
@@ -340,6 +347,9 @@ static inline void Fast_CRC32(uint64_t* l, uint8_t const **p) {
   *l = _mm_crc32_u32(static_cast<unsigned int>(*l), LE_LOAD32(*p));
   *p += 4;
 #endif
+#elif defined(__ARM_FEATURE_CRC32) && defined(__LP64__)
+  *l = __crc32cd(static_cast<uint32_t>(*l), LE_LOAD64(*p));
+  *p += 8;
 #else
   Slow_CRC32(l, p);
 #endif
@@ -403,23 +413,104 @@ static bool isSSE42() {
 
 typedef uint32_t (*Function)(uint32_t, const char*, size_t);
 
-static inline Function Choose_Extend() {
-  return isSSE42() ? ExtendImpl<Fast_CRC32> : ExtendImpl<Slow_CRC32>;
+// Detect if ARMv8 CRC32 instructions are available.
+static bool isArmCrc32() {
+#if defined(__ARM_FEATURE_CRC32) && defined(__LP64__)
+#if defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+  // CRC32 instructions are mandatory since ARMv8.1, and were present on all other supported
+  // platforms before that.
+  return true;
+#endif
+#else
+  return false;
+#endif
 }
 
 bool IsFastCrc32Supported() {
 #ifdef __SSE4_2__
   return isSSE42();
+#elif defined(__ARM_FEATURE_CRC32)
+  return isArmCrc32();
 #else
   return false;
 #endif
 }
 
+static inline Function Choose_Extend() {
+  return IsFastCrc32Supported() ? ExtendImpl<Fast_CRC32> : ExtendImpl<Slow_CRC32>;
+}
+
 Function ChosenExtend = Choose_Extend();
 
 uint32_t Extend(uint32_t crc, const char* buf, size_t size) {
   return ChosenExtend(crc, buf, size);
 }
 
+namespace {
+
+// Multiplies the 32x32 matrix over GF(2) by vec.
+uint32_t Gf2MatrixTimes(const uint32_t* mat, uint32_t vec) {
+  uint32_t sum = 0;
+  while (vec) {
+    if (vec & 1) {
+      sum ^= *mat;
+    }
+    vec >>= 1;
+    ++mat;
+  }
+  return sum;
+}
+
+void Gf2MatrixSquare(uint32_t* square, const uint32_t* mat) {
+  for (int n = 0; n != 32; ++n) {
+    square[n] = Gf2MatrixTimes(mat, mat[n]);
+  }
+}
+
+} // namespace
+
+// The same algorithm as crc32_combine of zlib, with the CRC32C polynomial.
+uint32_t Combine(uint32_t crc1, uint32_t crc2, size_t len2) {
+  if (len2 == 0) {
+    return crc1;
+  }
+
+  uint32_t even[32]; // Operator for an even power of two zeros.
+  uint32_t odd[32];  // Operator for an odd power of two zeros.
+
+  // Operator for one zero bit.
+  odd[0] = 0x82f63b78u; // Reversed CRC32C polynomial.
+  uint32_t row = 1;
+  for (int n = 1; n != 32; ++n) {
+    odd[n] = row;
+    row <<= 1;
+  }
+
+  // Operators for two and four zero bits.
+  Gf2MatrixSquare(even, odd);
+  Gf2MatrixSquare(odd, even);
+
+  // Apply len2 zero bytes to crc1, the first square gives the operator for one zero byte.
+  do {
+    Gf2MatrixSquare(even, odd);
+    if (len2 & 1) {
+      crc1 = Gf2MatrixTimes(even, crc1);
+    }
+    len2 >>= 1;
+    if (len2 == 0) {
+      break;
+    }
+    Gf2MatrixSquare(odd, even);
+    if (len2 & 1) {
+      crc1 = Gf2MatrixTimes(odd, crc1);
+    }
+    len2 >>= 1;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
 }  // namespace crc32c
 }  // namespace rocksdb
@@ -39,6 +39,11 @@ inline uint32_t Extend(uint32_t crc, const uint8_t* buf, size_t size) {
   return Extend(crc, reinterpret_cast<const char*>(buf), size);
 }
 
+// Return the crc32c of concat(A, B) where crc1 is the crc32c of A, and crc2 is the crc32c of B
+// that is len2 bytes long. Takes O(log(len2)) time, so checksums of parts computed separately
+// could be joined without reading the data again.
+uint32_t Combine(uint32_t crc1, uint32_t crc2, size_t len2);
+
 // Return the crc32c of data[0,n-1]
 inline uint32_t Value(const char* data, size_t n) {
   return Extend(0, data, n);
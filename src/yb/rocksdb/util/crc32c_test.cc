@@ -75,6 +75,15 @@ TEST(CRC, Extend) {
             Extend(Value("hello ", 6), "world", 5));
 }
 
+TEST(CRC, Combine) {
+  const std::string data = "hello world, this is a longer string to combine checksums of";
+  for (size_t split = 0; split <= data.size(); ++split) {
+    auto crc1 = Value(data.data(), split);
+    auto crc2 = Value(data.data() + split, data.size() - split);
+    ASSERT_EQ(Value(data.data(), data.size()), Combine(crc1, crc2, data.size() - split));
+  }
+}
+
 TEST(CRC, Mask) {
   uint32_t crc = Value("foo", 3);
   ASSERT_NE(crc, Mask(crc));
@@ -244,6 +244,13 @@ Status WritableFileWriter::Flush() {
       if (offset_sync_to > 0 &&
           offset_sync_to - last_sync_size_ >= bytes_per_sync_) {
         s = RangeSync(last_sync_size_, offset_sync_to - last_sync_size_);
+        if (s.ok() && drop_os_cache_after_sync_ && last_sync_size_ > last_dropped_size_) {
+          // Writeback of the previously synced range was started by the previous RangeSync, so
+          // its pages are likely clean by now and can be dropped.
+          WARN_NOT_OK(InvalidateCache(last_dropped_size_, last_sync_size_ - last_dropped_size_),
+                      "Failed to drop OS cache");
+          last_dropped_size_ = last_sync_size_;
+        }
         last_sync_size_ = offset_sync_to;
       }
     }
@@ -139,6 +139,8 @@ class WritableFileWriter {
   const bool              use_os_buffer_;
   uint64_t                last_sync_size_;
   uint64_t                bytes_per_sync_;
+  const bool              drop_os_cache_after_sync_;
+  uint64_t                last_dropped_size_ = 0;
   RateLimiter*            rate_limiter_;
   // When the writer is used by the priority thread pool's task, this task could pass provided
   // suspender to the writer, so it will be used by writer to check whether task should be
@@ -160,6 +162,7 @@ class WritableFileWriter {
         use_os_buffer_(writable_file_->UseOSBuffer()),
         last_sync_size_(0),
         bytes_per_sync_(options.bytes_per_sync),
+        drop_os_cache_after_sync_(options.drop_os_cache_after_sync),
         rate_limiter_(options.rate_limiter),
         suspender_(suspender) {
 
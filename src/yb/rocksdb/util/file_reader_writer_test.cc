@@ -101,6 +101,63 @@ TEST_F(WritableFileWriterTest, RangeSync) {
   writer->Close();
 }
 
+TEST_F(WritableFileWriterTest, DropOsCacheAfterSync) {
+  class FakeWF : public WritableFile {
+   public:
+    Status Append(const Slice& data) override {
+      size_ += data.size();
+      return Status::OK();
+    }
+    Status Truncate(uint64_t size) override { return Status::OK(); }
+    Status Close() override { return Status::OK(); }
+    Status Flush() override { return Status::OK(); }
+    Status Sync() override { return Status::OK(); }
+    Status Fsync() override { return Status::OK(); }
+    void SetIOPriority(yb::IOPriority pri) override {}
+    uint64_t GetFileSize() override { return size_; }
+    void GetPreallocationStatus(size_t* block_size,
+                                size_t* last_allocated_block) override {}
+    size_t GetUniqueId(char* id) const override { return 0; }
+    Status InvalidateCache(size_t offset, size_t length) override {
+      // Only ranges which writeback was started by an earlier RangeSync are dropped.
+      EXPECT_EQ(offset, dropped_);
+      EXPECT_LE(offset + length, previous_synced_);
+      dropped_ = offset + length;
+      return Status::OK();
+    }
+
+    uint64_t dropped() const { return dropped_; }
+    uint64_t last_synced() const { return last_synced_; }
+
+   protected:
+    Status Allocate(uint64_t offset, uint64_t len) override { return Status::OK(); }
+    Status RangeSync(uint64_t offset, uint64_t nbytes) override {
+      previous_synced_ = last_synced_;
+      last_synced_ = offset + nbytes;
+      return Status::OK();
+    }
+
+    uint64_t size_ = 0;
+    uint64_t previous_synced_ = 0;
+    uint64_t last_synced_ = 0;
+    uint64_t dropped_ = 0;
+  };
+
+  EnvOptions env_options;
+  env_options.bytes_per_sync = kMb;
+  env_options.drop_os_cache_after_sync = true;
+  auto* wf = new FakeWF;
+  WritableFileWriter writer(std::unique_ptr<FakeWF>(wf), env_options);
+  std::unique_ptr<char[]> buf(new char[kMb / 2]);
+  for (int i = 0; i != 20; ++i) {
+    ASSERT_OK(writer.Append(Slice(buf.get(), kMb / 2)));
+    ASSERT_OK(writer.Flush());
+  }
+  ASSERT_GT(wf->dropped(), 0);
+  ASSERT_LT(wf->dropped(), wf->last_synced());
+  ASSERT_OK(writer.Close());
+}
+
 TEST_F(WritableFileWriterTest, AppendStatusReturn) {
   class FakeWF : public WritableFile {
    public:
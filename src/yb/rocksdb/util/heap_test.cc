@@ -111,6 +111,12 @@ TEST_P(HeapTest, Test) {
     if (size > 0) {
       ASSERT_EQ(ref.top(), heap.top());
     }
+    if (size > 1) {
+      auto top = ref.top();
+      ref.pop();
+      ASSERT_EQ(ref.top(), heap.second_top());
+      ref.push(top);
+    }
   }
 
   // Probabilities should be set up to occasionally hit the max heap size and
@@ -167,6 +173,36 @@ TEST(HeapTest, SecondTopTest) {
   ASSERT_EQ(130, heap.second_top());
 }
 
+TEST(HeapTest, ReplaceTopComparisons) {
+  size_t num_comparisons = 0;
+  auto cmp = [&num_comparisons](HeapTestValue lhs, HeapTestValue rhs) {
+    ++num_comparisons;
+    return lhs > rhs;
+  };
+  BinaryHeap<HeapTestValue, decltype(cmp)> heap(cmp);
+  for (HeapTestValue value = 1000; value != 2000; value += 100) {
+    heap.push(value);
+  }
+  ASSERT_EQ(1000, heap.top());
+
+  // The first replacement compares the children of the root, the following ones reuse the result.
+  num_comparisons = 0;
+  heap.replace_top(1);
+  ASSERT_EQ(2, num_comparisons);
+  for (HeapTestValue value = 2; value != 10; ++value) {
+    num_comparisons = 0;
+    heap.replace_top(value);
+    ASSERT_EQ(1, num_comparisons);
+    ASSERT_EQ(value, heap.top());
+    ASSERT_EQ(1100, heap.second_top());
+    ASSERT_EQ(1, num_comparisons);
+  }
+
+  // Replacing with a value larger than the second top moves it down the heap.
+  heap.replace_top(1150);
+  ASSERT_EQ(1100, heap.top());
+  ASSERT_EQ(1150, heap.second_top());
+}
 
 }  // namespace rocksdb
 
@@ -33,6 +33,7 @@
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/compaction_filter.h"
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/filter_policy.h"
@@ -276,6 +277,7 @@ DBOptions::DBOptions()
       access_hint_on_compaction_start(NORMAL),
       new_table_reader_for_compaction_inputs(false),
       compaction_readahead_size(0),
+      compaction_drop_os_cache(false),
       random_access_max_buffer_size(1024 * 1024),
       writable_file_max_buffer_size(1024 * 1024),
       use_adaptive_mutex(false),
@@ -375,6 +377,8 @@ void DBOptions::Dump(Logger* log) const {
       "               Options.compaction_readahead_size: %" ROCKSDB_PRIszt
          "d",
          compaction_readahead_size);
+  RHEADER(log, "                Options.compaction_drop_os_cache: %d",
+      compaction_drop_os_cache);
   RHEADER(
       log,
       "               Options.random_access_max_buffer_size: %" ROCKSDB_PRIszt
@@ -413,6 +417,12 @@ void DBOptions::Dump(Logger* log) const {
     } else {
       RHEADER(log, "                               Options.row_cache: None");
     }
+    if (table_cache) {
+      RHEADER(log, "                             Options.table_cache: %" PRIu64,
+          table_cache->GetCapacity());
+    } else {
+      RHEADER(log, "                             Options.table_cache: None");
+    }
   RHEADER(log, "                           Options.initial_seqno: %" PRIu64, initial_seqno);
   RHEADER(log, "       Options.wal_filter: %s",
       wal_filter ? wal_filter->Name() : "None");
@@ -714,6 +724,14 @@ ReadOptions::ReadOptions(bool cksum, bool cache)
       query_id(rocksdb::kDefaultQueryId) {
 }
 
+void ReadFileFilter::FilterFiles(
+    const FdWithBoundaries* files, size_t num_files, std::vector<bool>* read) const {
+  read->resize(num_files);
+  for (size_t i = 0; i != num_files; ++i) {
+    (*read)[i] = Filter(files[i]);
+  }
+}
+
 std::atomic<int64_t> flush_tick_(1);
 
 int64_t FlushTick() {
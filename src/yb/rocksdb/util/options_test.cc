@@ -1596,6 +1596,7 @@ void InitDefault(BlockBasedTableOptions*) {}
 Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* destination) {
   const char* const kOptionsString =
       "cache_index_and_filter_blocks=1;index_type=kHashSearch;"
+      "cache_top_level_index_and_filter_with_high_priority=1;"
       "checksum=kxxHash;hash_index_allow_collision=1;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
       "block_size_deviation=8;block_restart_interval=4; "
@@ -1636,6 +1637,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "use_adaptive_mutex=true;"
       "max_total_wal_size=4295005604;"
       "compaction_readahead_size=0;"
+      "compaction_drop_os_cache=true;"
       "new_table_reader_for_compaction_inputs=true;"
       "keep_log_file_num=4890;"
       "skip_stats_update_on_db_open=true;"
@@ -1911,6 +1913,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, compaction_context_factory),
+      BLACKLIST_ENTRY(DBOptions, subcompaction_boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, max_file_size_for_compaction),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
       BLACKLIST_ENTRY(DBOptions, log_prefix),
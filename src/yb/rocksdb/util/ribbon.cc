@@ -0,0 +1,354 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "yb/gutil/bits.h"
+
+#include "yb/rocksdb/filter_policy.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/hash_util.h"
+#include "yb/util/logging.h"
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Standard Ribbon filter (Dillinger & Walzer, "Ribbon filter: practically smaller than Bloom and
+// Xor", 2021) with 64-bit coefficient rows.
+//
+// Each key is mapped to a start slot, a 64-bit coefficient row and an r-bit fingerprint. The
+// filter stores an r-bit value per slot, chosen so that for every added key the XOR of values of
+// slots selected by its coefficient row (starting at its start slot) equals its fingerprint.
+// A non-added key matches with probability 2^-r, while the filter uses only
+// r * (1 + overhead) bits per key, where overhead is a few percent. A Bloom filter with the same
+// false positive rate needs about 1.44 * r bits per key.
+//
+// Solution is stored in "interleaved" layout: slots are grouped into segments of 64 slots, each
+// segment is stored as r 64-bit words, where word j contains bit j of the values of all slots of
+// the segment. So query needs r words of at most two adjacent segments.
+//
+// Filter encoding:
+// +-----------------------------------------------------------------------------+
+// |        solution: num_segments * result_bits 64-bit words                    |
+// +-----------------------------------------------------------------------------+
+// | result_bits : 1 byte | seed : 1 byte | num_segments : 4 bytes               |
+// +-----------------------------------------------------------------------------+
+//
+// Construction (banding) could fail with low probability, in this case it is retried with
+// another seed. If all seeds fail, kNoSolutionSeed is stored and filter matches all keys.
+
+constexpr size_t kCoeffBits = 64;
+constexpr size_t kMetaDataSize = 6;
+constexpr size_t kMaxResultBits = 16;
+constexpr uint8_t kMaxSeeds = 32;
+constexpr uint8_t kNoSolutionSeed = 0xff;
+
+constexpr uint64_t kSeedMultiplier = 0x9e3779b97f4a7c15ULL;
+constexpr uint64_t kCoeffSalt = 0xc2b2ae3d27d4eb4fULL;
+
+// Finalization mix of MurmurHash3.
+inline uint64_t Remix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline uint64_t KeyHash(const Slice& key) {
+  return yb::HashUtil::MurmurHash2_64(key.data(), key.size(), /* seed = */ 0);
+}
+
+// Number of slots used for filter with specified number of keys.
+inline size_t NumSlots(size_t num_keys) {
+  const size_t slots = num_keys + num_keys / 16 + kCoeffBits / 2;
+  return (slots + kCoeffBits - 1) / kCoeffBits * kCoeffBits;
+}
+
+size_t ResultBits(double error_rate) {
+  DCHECK_GT(error_rate, 0);
+  const auto result = static_cast<size_t>(ceil(-log2(error_rate)));
+  return std::min(std::max<size_t>(result, 1), kMaxResultBits);
+}
+
+struct RibbonHash {
+  RibbonHash(uint64_t key_hash, uint8_t seed, size_t num_starts, size_t result_bits) {
+    const uint64_t h = Remix(key_hash + seed * kSeedMultiplier);
+    start = static_cast<size_t>(((h >> 32) * num_starts) >> 32);
+    // Lowest bit should be set, so the row is never empty and starts at the start slot.
+    coeff = Remix(h ^ kCoeffSalt) | 1;
+    result = static_cast<uint32_t>(h) & ((1U << result_bits) - 1);
+  }
+
+  size_t start;
+  uint64_t coeff;
+  uint32_t result;
+};
+
+// Incremental Gaussian elimination of added keys into a band matrix with 64 columns per row.
+class RibbonBanding {
+ public:
+  explicit RibbonBanding(size_t num_slots) : coeffs_(num_slots), results_(num_slots) {
+    DCHECK_GE(num_slots, kCoeffBits);
+    DCHECK_EQ(num_slots % kCoeffBits, 0);
+  }
+
+  bool AddAll(const std::vector<uint64_t>& key_hashes, uint8_t seed, size_t result_bits) {
+    std::fill(coeffs_.begin(), coeffs_.end(), 0);
+    std::fill(results_.begin(), results_.end(), 0);
+    const size_t num_starts = coeffs_.size() - kCoeffBits + 1;
+    for (auto key_hash : key_hashes) {
+      RibbonHash hash(key_hash, seed, num_starts, result_bits);
+      if (!Add(hash.start, hash.coeff, hash.result)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Solves banded system from the last slot to the first one and writes solution in interleaved
+  // layout to out.
+  void BackSubstitute(size_t result_bits, char* out) const {
+    // state[j] contains bit j of the solution for the next 64 slots, lowest bit - for the current
+    // slot.
+    uint64_t state[kMaxResultBits] = {0};
+    const size_t num_segments = coeffs_.size() / kCoeffBits;
+    for (size_t segment = num_segments; segment-- > 0;) {
+      uint64_t words[kMaxResultBits] = {0};
+      for (size_t bit = kCoeffBits; bit-- > 0;) {
+        const size_t slot = segment * kCoeffBits + bit;
+        const uint64_t coeff = coeffs_[slot];
+        const uint32_t result = results_[slot];
+        for (size_t j = 0; j != result_bits; ++j) {
+          state[j] <<= 1;
+          const uint64_t solution_bit = ((result >> j) ^ __builtin_parityll(state[j] & coeff)) & 1;
+          state[j] |= solution_bit;
+          words[j] |= solution_bit << bit;
+        }
+      }
+      for (size_t j = 0; j != result_bits; ++j) {
+        EncodeFixed64(out + (segment * result_bits + j) * sizeof(uint64_t), words[j]);
+      }
+    }
+  }
+
+ private:
+  bool Add(size_t start, uint64_t coeff, uint32_t result) {
+    for (;;) {
+      auto& row = coeffs_[start];
+      if (row == 0) {
+        row = coeff;
+        results_[start] = result;
+        return true;
+      }
+      coeff ^= row;
+      result ^= results_[start];
+      if (coeff == 0) {
+        // Linearly dependent row, it is consistent only for duplicate key.
+        return result == 0;
+      }
+      // Row span never grows, so it is guaranteed that start stays within first
+      // num_slots - kCoeffBits + 1 slots.
+      const int shift = Bits::FindLSBSetNonZero64(coeff);
+      start += shift;
+      coeff >>= shift;
+    }
+  }
+
+  std::vector<uint64_t> coeffs_;
+  std::vector<uint32_t> results_;
+};
+
+// Buffers hashes of added keys, since Ribbon filter could be constructed only when all keys are
+// known. Reports itself as full when filter for added keys would reach total_bits.
+class FixedSizeRibbonBitsBuilder : public FilterBitsBuilder {
+ public:
+  FixedSizeRibbonBitsBuilder(const FixedSizeRibbonBitsBuilder&) = delete;
+  void operator=(const FixedSizeRibbonBitsBuilder&) = delete;
+
+  FixedSizeRibbonBitsBuilder(size_t total_bits, size_t result_bits)
+      : result_bits_(result_bits) {
+    DCHECK_GT(total_bits, 0);
+    const size_t max_slots =
+        std::max(total_bits / (result_bits_ * kCoeffBits), static_cast<size_t>(1)) * kCoeffBits;
+    max_keys_ = (max_slots - kCoeffBits / 2) * 16 / 17;
+    while (NumSlots(max_keys_ + 1) <= max_slots) {
+      ++max_keys_;
+    }
+    while (max_keys_ > 1 && NumSlots(max_keys_) > max_slots) {
+      --max_keys_;
+    }
+    key_hashes_.reserve(max_keys_);
+  }
+
+  void AddKey(const Slice& key) override {
+    key_hashes_.push_back(KeyHash(key));
+  }
+
+  bool IsFull() const override { return key_hashes_.size() >= max_keys_; }
+
+  Slice Finish(std::unique_ptr<const char[]>* buf) override {
+    const size_t num_slots = key_hashes_.empty() ? 0 : NumSlots(key_hashes_.size());
+    const size_t num_segments = num_slots / kCoeffBits;
+    const size_t data_size = num_segments * result_bits_ * sizeof(uint64_t);
+    const size_t filter_size = data_size + kMetaDataSize;
+    std::unique_ptr<char[]> data(new char[filter_size]);
+    memset(data.get(), 0, filter_size);
+
+    uint8_t seed = 0;
+    if (num_slots != 0) {
+      RibbonBanding banding(num_slots);
+      while (seed != kMaxSeeds && !banding.AddAll(key_hashes_, seed, result_bits_)) {
+        ++seed;
+      }
+      if (seed == kMaxSeeds) {
+        seed = kNoSolutionSeed;
+      } else {
+        banding.BackSubstitute(result_bits_, data.get());
+      }
+    }
+
+    data[data_size] = static_cast<char>(result_bits_);
+    data[data_size + 1] = static_cast<char>(seed);
+    EncodeFixed32(data.get() + data_size + 2, static_cast<uint32_t>(num_segments));
+    key_hashes_.clear();
+
+    buf->reset(data.release());
+    return Slice(buf->get(), filter_size);
+  }
+
+ private:
+  const size_t result_bits_;
+  size_t max_keys_;
+  std::vector<uint64_t> key_hashes_;
+};
+
+class FixedSizeRibbonBitsReader : public FilterBitsReader {
+ public:
+  FixedSizeRibbonBitsReader(const FixedSizeRibbonBitsReader&) = delete;
+  void operator=(const FixedSizeRibbonBitsReader&) = delete;
+
+  FixedSizeRibbonBitsReader(const Slice& contents, Logger* logger) : data_(contents.cdata()) {
+    if (contents.size() < kMetaDataSize) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Ribbon filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      always_match_ = true;
+      return;
+    }
+    const size_t data_size = contents.size() - kMetaDataSize;
+    result_bits_ = static_cast<uint8_t>(data_[data_size]);
+    seed_ = static_cast<uint8_t>(data_[data_size + 1]);
+    num_segments_ = DecodeFixed32(data_ + data_size + 2);
+    if (num_segments_ == 0) {
+      return;
+    }
+    if (seed_ == kNoSolutionSeed) {
+      always_match_ = true;
+      return;
+    }
+    if (seed_ >= kMaxSeeds || result_bits_ == 0 || result_bits_ > kMaxResultBits ||
+        data_size != num_segments_ * result_bits_ * sizeof(uint64_t)) {
+      RLOG(InfoLogLevel::ERROR_LEVEL, logger, "Ribbon filter data is broken, won't be used.");
+      FAIL_IF_NOT_PRODUCTION();
+      always_match_ = true;
+    }
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    if (always_match_) {
+      return true;
+    }
+    if (num_segments_ == 0) {
+      // Empty filter.
+      return false;
+    }
+    const RibbonHash hash(
+        KeyHash(entry), seed_, (num_segments_ - 1) * kCoeffBits + 1, result_bits_);
+    const size_t segment_size = result_bits_ * sizeof(uint64_t);
+    const char* segment = data_ + hash.start / kCoeffBits * segment_size;
+    const size_t shift = hash.start % kCoeffBits;
+    for (size_t j = 0; j != result_bits_; ++j) {
+      uint64_t word = DecodeFixed64(segment + j * sizeof(uint64_t)) >> shift;
+      if (shift) {
+        word |=
+            DecodeFixed64(segment + segment_size + j * sizeof(uint64_t)) << (kCoeffBits - shift);
+      }
+      if ((__builtin_parityll(word & hash.coeff) ^ (hash.result >> j)) & 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t result_bits_ = 0;
+  uint8_t seed_ = 0;
+  size_t num_segments_ = 0;
+  bool always_match_ = false;
+};
+
+class FixedSizeRibbonFilterPolicy : public FilterPolicy {
+ public:
+  FixedSizeRibbonFilterPolicy(size_t total_bits, double error_rate, Logger* logger)
+      : total_bits_(total_bits),
+        result_bits_(ResultBits(error_rate)),
+        logger_(logger) {
+  }
+
+  FilterType GetFilterType() const override { return FilterType::kFixedSizeFilter; }
+
+  const char* Name() const override {
+    return "rocksdb.FixedSizeRibbonFilter";
+  }
+
+  // Not used in FixedSizeFilter. GetFilterBitsBuilder/Reader interface should be used.
+  void CreateFilter(const Slice* keys, int n, std::string* dst) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::CreateFilter is not supported");
+  }
+
+  bool KeyMayMatch(const Slice& key, const Slice& filter) const override {
+    assert(!"FixedSizeRibbonFilterPolicy::KeyMayMatch is not supported");
+    return true;
+  }
+
+  FilterBitsBuilder* GetFilterBitsBuilder() const override {
+    return new FixedSizeRibbonBitsBuilder(total_bits_, result_bits_);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    return new FixedSizeRibbonBitsReader(contents, logger_);
+  }
+
+ private:
+  size_t total_bits_;
+  size_t result_bits_;
+  Logger* logger_;
+};
+
+} // namespace
+
+const FilterPolicy* NewFixedSizeRibbonFilterPolicy(size_t total_bits,
+                                                   double error_rate,
+                                                   Logger* logger) {
+  return new FixedSizeRibbonFilterPolicy(total_bits, error_rate, logger);
+}
+
+}  // namespace rocksdb
@@ -27,6 +27,7 @@
 #include <deque>
 #include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -285,16 +286,26 @@ class StringSource: public RandomAccessFile {
 
   size_t memory_footprint() const override { LOG(FATAL) << "Not supported"; }
 
+  void Prefetch(uint64_t offset, size_t length) const override {
+    prefetched_ranges_.emplace_back(offset, offset + length);
+  }
+
   int total_reads() const { return total_reads_; }
 
   void set_total_reads(int tr) { total_reads_ = tr; }
 
+  // Ranges passed to Prefetch, as [begin, end) pairs.
+  const std::vector<std::pair<uint64_t, uint64_t>>& prefetched_ranges() const {
+    return prefetched_ranges_;
+  }
+
  private:
   std::string filename_ = "StringSource";
   std::string contents_;
   uint64_t uniq_id_;
   bool mmap_;
   mutable int total_reads_;
+  mutable std::vector<std::pair<uint64_t, uint64_t>> prefetched_ranges_;
 };
 
 class NullLogger : public Logger {
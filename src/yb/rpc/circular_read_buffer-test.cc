@@ -0,0 +1,100 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/rpc/circular_read_buffer.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/result.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DECLARE_uint64(rpc_read_buffer_pool_max_blocks_per_size);
+
+namespace yb {
+namespace rpc {
+
+constexpr size_t kCapacity = 0x100;
+
+class CircularReadBufferTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    tracker_ = MemTracker::CreateTracker("test", MemTracker::GetRootTracker());
+    pool_ = ReadBufferPool::Create(tracker_);
+  }
+
+  size_t PooledBytes() {
+    return tracker_->FindChild("Pool")->consumption();
+  }
+
+  MemTrackerPtr tracker_;
+  ReadBufferPoolPtr pool_;
+};
+
+TEST_F(CircularReadBufferTest, ReleaseToPool) {
+  CircularReadBuffer buffer(kCapacity, tracker_, pool_);
+
+  auto iov = ASSERT_RESULT(buffer.PrepareAppend());
+  ASSERT_EQ(iov.size(), 1);
+  ASSERT_EQ(iov[0].iov_len, kCapacity);
+  auto* block = iov[0].iov_base;
+
+  buffer.DataAppended(10);
+  ASSERT_EQ(buffer.Release(), 0);
+
+  buffer.Consume(10, Slice());
+  ASSERT_EQ(buffer.Release(), kCapacity);
+  ASSERT_EQ(PooledBytes(), kCapacity);
+
+  // The released block is taken back from the pool.
+  iov = ASSERT_RESULT(buffer.PrepareAppend());
+  ASSERT_EQ(iov[0].iov_base, block);
+  ASSERT_EQ(PooledBytes(), 0);
+}
+
+TEST_F(CircularReadBufferTest, Reset) {
+  CircularReadBuffer buffer(kCapacity, tracker_, pool_);
+
+  ASSERT_OK(buffer.PrepareAppend());
+  buffer.Reset();
+  ASSERT_EQ(PooledBytes(), kCapacity);
+  ASSERT_NOK(buffer.PrepareAppend());
+}
+
+TEST_F(CircularReadBufferTest, PoolLimit) {
+  constexpr size_t kMaxBlocks = 2;
+  FLAGS_rpc_read_buffer_pool_max_blocks_per_size = kMaxBlocks;
+
+  for (size_t i = 0; i != kMaxBlocks + 2; ++i) {
+    pool_->Return(pool_->Take(kCapacity), kCapacity);
+  }
+  // Blocks are reused, so the pool holds a single one.
+  ASSERT_EQ(PooledBytes(), kCapacity);
+
+  std::vector<char*> blocks;
+  for (size_t i = 0; i != kMaxBlocks + 2; ++i) {
+    blocks.push_back(pool_->Take(kCapacity));
+  }
+  for (auto* block : blocks) {
+    pool_->Return(block, kCapacity);
+  }
+  // Blocks above the limit are freed on return.
+  ASSERT_EQ(PooledBytes(), kMaxBlocks * kCapacity);
+}
+
+} // namespace rpc
+} // namespace yb
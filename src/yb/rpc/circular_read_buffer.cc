@@ -13,16 +13,137 @@
 
 #include "yb/rpc/circular_read_buffer.h"
 
+#include <limits>
+
+#include "yb/util/flags.h"
 #include "yb/util/result.h"
 #include "yb/util/tostring.h"
 
+DEFINE_RUNTIME_uint64(rpc_read_buffer_pool_max_blocks_per_size, 16,
+    "Maximum number of released read buffer blocks of the same size kept in the pool for reuse "
+    "by other connections. Blocks released above this limit are freed immediately.");
+TAG_FLAG(rpc_read_buffer_pool_max_blocks_per_size, advanced);
+
 namespace yb {
 namespace rpc {
 
-CircularReadBuffer::CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker)
+ReadBufferPoolPtr ReadBufferPool::Create(const MemTrackerPtr& parent_tracker) {
+  auto result = std::make_shared<ReadBufferPool>(parent_tracker);
+  parent_tracker->AddGarbageCollector(result);
+  return result;
+}
+
+ReadBufferPool::ReadBufferPool(const MemTrackerPtr& parent_tracker)
+    : tracker_(MemTracker::FindOrCreateTracker("Pool", parent_tracker)) {
+}
+
+ReadBufferPool::~ReadBufferPool() {
+  CollectGarbage(std::numeric_limits<size_t>::max());
+}
+
+ReadBufferPool::SizeClass& ReadBufferPool::GetSizeClass(size_t size) {
+  auto it = size_classes_.find(size);
+  if (it == size_classes_.end()) {
+    it = size_classes_.emplace(size, SizeClass {
+      .tracker = MemTracker::FindOrCreateTracker(std::to_string(size), tracker_),
+      .blocks = {},
+    }).first;
+  }
+  return it->second;
+}
+
+char* ReadBufferPool::Take(size_t size) {
+  {
+    std::lock_guard lock(mutex_);
+    auto& size_class = GetSizeClass(size);
+    if (!size_class.blocks.empty()) {
+      auto* result = size_class.blocks.back();
+      size_class.blocks.pop_back();
+      size_class.tracker->Release(size);
+      return result;
+    }
+  }
+  return static_cast<char*>(malloc(size));
+}
+
+void ReadBufferPool::Return(char* block, size_t size) {
+  const auto max_blocks = FLAGS_rpc_read_buffer_pool_max_blocks_per_size;
+  MemTrackerPtr tracker;
+  {
+    std::lock_guard lock(mutex_);
+    auto& size_class = GetSizeClass(size);
+    if (size_class.blocks.size() < max_blocks) {
+      tracker = size_class.tracker;
+    }
+  }
+  // TryConsume could collect garbage, so it should not be invoked under the mutex.
+  if (!tracker || !tracker->TryConsume(size)) {
+    free(block);
+    return;
+  }
+  {
+    std::lock_guard lock(mutex_);
+    auto& size_class = GetSizeClass(size);
+    // Other blocks could be returned concurrently, so check the limit again.
+    if (size_class.blocks.size() < max_blocks) {
+      size_class.blocks.push_back(block);
+      return;
+    }
+  }
+  tracker->Release(size);
+  free(block);
+}
+
+void ReadBufferPool::CollectGarbage(size_t required) {
+  std::vector<char*> blocks;
+  {
+    std::lock_guard lock(mutex_);
+    size_t total = 0;
+    for (auto& [size, size_class] : size_classes_) {
+      size_t released = 0;
+      while (total < required && !size_class.blocks.empty()) {
+        blocks.push_back(size_class.blocks.back());
+        size_class.blocks.pop_back();
+        released += size;
+        total += size;
+      }
+      size_class.tracker->Release(released);
+    }
+  }
+  for (auto* block : blocks) {
+    free(block);
+  }
+}
+
+CircularReadBuffer::CircularReadBuffer(
+    size_t capacity, const MemTrackerPtr& parent_tracker, ReadBufferPoolPtr pool)
     : consumption_(MemTracker::FindOrCreateTracker("Receive", parent_tracker, AddToParent::kFalse),
-                   capacity),
-      buffer_(static_cast<char*>(malloc(capacity))), capacity_(capacity) {
+                   0),
+      pool_(std::move(pool)), capacity_(capacity) {
+  if (!pool_) {
+    buffer_.reset(static_cast<char*>(malloc(capacity_)));
+    consumption_.Reset(capacity_);
+  }
+}
+
+CircularReadBuffer::~CircularReadBuffer() {
+  ReleaseBuffer();
+}
+
+void CircularReadBuffer::ReleaseBuffer() {
+  if (pool_ && buffer_) {
+    pool_->Return(buffer_.release(), capacity_);
+  }
+  buffer_.reset();
+  consumption_.Reset(0);
+}
+
+size_t CircularReadBuffer::Release() {
+  if (!pool_ || !buffer_ || size_ != 0 || !prepend_.empty()) {
+    return 0;
+  }
+  ReleaseBuffer();
+  return capacity_;
 }
 
 bool CircularReadBuffer::Empty() {
@@ -30,14 +151,20 @@ bool CircularReadBuffer::Empty() {
 }
 
 void CircularReadBuffer::Reset() {
-  buffer_.reset();
+  ReleaseBuffer();
+  reset_ = true;
 }
 
 Result<IoVecs> CircularReadBuffer::PrepareAppend() {
-  if (!buffer_) {
+  if (reset_) {
     return STATUS(IllegalState, "Read buffer was reset");
   }
 
+  if (!buffer_) {
+    buffer_.reset(pool_->Take(capacity_));
+    consumption_.Reset(capacity_);
+  }
+
   IoVecs result;
 
   if (!prepend_.empty()) {
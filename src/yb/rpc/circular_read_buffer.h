@@ -13,6 +13,13 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/rpc/rpc_fwd.h"
 #include "yb/rpc/stream.h"
 
 #include "yb/util/mem_tracker.h"
@@ -26,10 +33,45 @@ struct FreeMemory {
   }
 };
 
+// Pool of read buffer blocks shared by the connections of a messenger. Blocks are grouped by size,
+// and every size class has its own MemTracker under "Pool", that accounts blocks held by the pool.
+// Pooled blocks are freed when the parent tracker runs out of memory.
+class ReadBufferPool : public GarbageCollector {
+ public:
+  static ReadBufferPoolPtr Create(const MemTrackerPtr& parent_tracker);
+
+  explicit ReadBufferPool(const MemTrackerPtr& parent_tracker);
+  virtual ~ReadBufferPool();
+
+  // Returns block of specified size, taken from the pool or newly allocated.
+  char* Take(size_t size);
+
+  // Returns block to the pool, or frees it when the pool is over its memory limit.
+  void Return(char* block, size_t size);
+
+ private:
+  struct SizeClass {
+    MemTrackerPtr tracker;
+    std::vector<char*> blocks;
+  };
+
+  void CollectGarbage(size_t required) override;
+
+  SizeClass& GetSizeClass(size_t size) REQUIRES(mutex_);
+
+  const MemTrackerPtr tracker_;
+  std::mutex mutex_;
+  std::map<size_t, SizeClass> size_classes_ GUARDED_BY(mutex_);
+};
+
 // StreamReadBuffer implementation that is based on circular buffer of fixed capacity.
+// When pool is specified, memory is allocated on the first append and could be returned to the
+// pool by Release, while the buffer is empty.
 class CircularReadBuffer : public StreamReadBuffer {
  public:
-  explicit CircularReadBuffer(size_t capacity, const MemTrackerPtr& parent_tracker);
+  CircularReadBuffer(
+      size_t capacity, const MemTrackerPtr& parent_tracker, ReadBufferPoolPtr pool = nullptr);
+  ~CircularReadBuffer();
 
   bool ReadyToRead() override;
   bool Empty() override;
@@ -41,15 +83,20 @@ class CircularReadBuffer : public StreamReadBuffer {
   bool Full() override;
   void Consume(size_t count, const Slice& prepend) override;
   size_t DataAvailable() override;
+  size_t Release() override;
 
  private:
+  void ReleaseBuffer();
+
   ScopedTrackedConsumption consumption_;
+  const ReadBufferPoolPtr pool_;
   std::unique_ptr<char, FreeMemory> buffer_;
   const size_t capacity_;
   size_t pos_ = 0;
   size_t size_ = 0;
   Slice prepend_;
   bool had_prepend_ = false;
+  bool reset_ = false;
 };
 
 } // namespace rpc
@@ -18,10 +18,14 @@
 #include <snappy.h>
 #include <zlib.h>
 
+#include <boost/asio/ip/network_v4.hpp>
+#include <boost/asio/ip/network_v6.hpp>
+#include <boost/asio/ip/tcp.hpp>
 #include <boost/preprocessor/cat.hpp>
 #include <boost/range/iterator_range.hpp>
 
 #include "yb/gutil/casts.h"
+#include "yb/gutil/strings/split.h"
 
 #include "yb/rpc/circular_read_buffer.h"
 #include "yb/rpc/outbound_data.h"
@@ -38,6 +42,12 @@ using namespace std::literals;
 DEFINE_UNKNOWN_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
                                          "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
 
+DEFINE_RUNTIME_string(stream_compression_excluded_networks, "",
+    "Comma separated list of networks in CIDR notation, e.g. 10.1.0.0/16,fd00::/8. Outbound "
+    "connections to addresses in these networks are not compressed, even when "
+    "stream_compression_algo is set. Allows compressing only the traffic that leaves the local "
+    "zone or region.");
+
 namespace yb {
 namespace rpc {
 
@@ -45,6 +55,59 @@ using SmallRefCntBuffers = ByteBlocks;
 
 namespace {
 
+// Returns whether address belongs to network specified in CIDR notation, e.g. 10.0.0.0/8.
+Result<bool> NetworkContains(const std::string& network, const IpAddress& address) {
+  boost::system::error_code ec;
+  auto network_v4 = boost::asio::ip::make_network_v4(network, ec);
+  if (!ec) {
+    return address.is_v4() &&
+           boost::asio::ip::make_network_v4(address.to_v4(), network_v4.prefix_length())
+               .canonical() == network_v4.canonical();
+  }
+  auto network_v6 = boost::asio::ip::make_network_v6(network, ec);
+  if (!ec) {
+    return address.is_v6() &&
+           boost::asio::ip::make_network_v6(address.to_v6(), network_v6.prefix_length())
+               .canonical() == network_v6.canonical();
+  }
+  return STATUS_FORMAT(InvalidArgument, "Invalid network: $0", network);
+}
+
+bool ValidateNetworks(const char* flag_name, const std::string& value) {
+  for (const auto& network : strings::Split(value, ",", strings::SkipEmpty())) {
+    auto status = ResultToStatus(NetworkContains(network.ToString(), IpAddress()));
+    if (!status.ok()) {
+      LOG(ERROR) << "Invalid value for " << flag_name << ": " << status;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsCompressionExcluded(const Endpoint& remote) {
+  const auto networks = FLAGS_stream_compression_excluded_networks;
+  if (networks.empty()) {
+    return false;
+  }
+  for (const auto& network : strings::Split(networks, ",", strings::SkipEmpty())) {
+    auto contains = NetworkContains(network.ToString(), remote.address());
+    if (!contains.ok()) {
+      YB_LOG_EVERY_N_SECS(DFATAL, 5) << contains.status();
+      continue;
+    }
+    if (*contains) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(stream_compression_excluded_networks, &ValidateNetworks);
+
+namespace {
+
 class Compressor {
  public:
   virtual std::string ToString() const = 0;
@@ -799,7 +862,9 @@ class CompressedRefiner : public StreamRefiner {
 
   Status Handshake() override {
     if (stream_->local_side() == LocalSide::kClient) {
-      compressor_ = CreateOutboundCompressor(stream_->buffer_tracker());
+      if (!IsCompressionExcluded(stream_->Remote())) {
+        compressor_ = CreateOutboundCompressor(stream_->buffer_tracker());
+      }
       if (!compressor_) {
         return stream_->Established(RefinedStreamState::kDisabled);
       }
@@ -510,6 +510,12 @@ void Connection::Close() {
   stream_->Close();
 }
 
+size_t Connection::ReleaseReadBuffer() {
+  DCHECK(reactor_->IsCurrentThread());
+
+  return context_->ReadBuffer().Release();
+}
+
 void Connection::UpdateLastActivity() {
   last_activity_time_ = reactor_->cur_time();
   VLOG_WITH_PREFIX(4) << "Updated last_activity_time_=" << AsString(last_activity_time_);
@@ -129,6 +129,10 @@ class Connection final : public StreamContext, public std::enable_shared_from_th
   // A human-readable reason why the connection is not idle. Empty string if connection is idle.
   std::string ReasonNotIdle() const;
 
+  // Returns memory of the read buffer to its pool, when the buffer is empty.
+  // Returns the number of released bytes.
+  size_t ReleaseReadBuffer();
+
   // Fail any calls which are currently queued or awaiting response.
   // Prohibits any future calls (they will be failed immediately with this
   // same Status).
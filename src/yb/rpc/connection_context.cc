@@ -13,6 +13,7 @@
 
 #include "yb/rpc/connection_context.h"
 
+#include "yb/rpc/circular_read_buffer.h"
 #include "yb/rpc/connection.h"
 
 #include "yb/util/mem_tracker.h"
@@ -52,6 +53,7 @@ ConnectionContextFactory::ConnectionContextFactory(
     return root_buffer_tracker->limit();
   });
   buffer_tracker_ = MemTracker::FindOrCreateTracker(memory_limit, name, root_buffer_tracker);
+  read_buffer_pool_ = ReadBufferPool::Create(buffer_tracker_);
   auto root_call_tracker = MemTracker::FindOrCreateTracker("Call", parent_mem_tracker);
   call_tracker_ = MemTracker::FindOrCreateTracker(name, root_call_tracker);
 }
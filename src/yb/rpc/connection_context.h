@@ -104,12 +104,17 @@ class ConnectionContextFactory {
     return buffer_tracker_;
   }
 
+  const ReadBufferPoolPtr& read_buffer_pool() {
+    return read_buffer_pool_;
+  }
+
  protected:
   ~ConnectionContextFactory();
 
   std::shared_ptr<MemTracker> parent_tracker_;
   std::shared_ptr<MemTracker> call_tracker_;
   std::shared_ptr<MemTracker> buffer_tracker_;
+  ReadBufferPoolPtr read_buffer_pool_;
 };
 
 template <class ContextType>
@@ -122,7 +127,8 @@ class ConnectionContextFactoryImpl : public ConnectionContextFactory {
           memory_limit, ContextType::Name(), parent_mem_tracker) {}
 
   std::unique_ptr<ConnectionContext> Create(size_t receive_buffer_size) override {
-    return std::make_unique<ContextType>(receive_buffer_size, buffer_tracker_, call_tracker_);
+    return std::make_unique<ContextType>(
+        receive_buffer_size, buffer_tracker_, call_tracker_, read_buffer_pool_);
   }
 
   virtual ~ConnectionContextFactoryImpl() {}
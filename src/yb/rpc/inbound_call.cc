@@ -195,6 +195,7 @@ bool InboundCall::ClientTimedOut() const {
 void InboundCall::QueueResponse(bool is_success) {
   TRACE_TO(trace_, is_success ? "Queueing success response" : "Queueing failure response");
   LogTrace();
+  wait_state_->set_code(WaitStateCode::kResponseQueued);
   bool expected = false;
   if (responded_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
     connection()->context().QueueResponse(connection(), shared_from(this));
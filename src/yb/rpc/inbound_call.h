@@ -60,6 +60,7 @@
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/slice.h"
 #include "yb/util/status_fwd.h"
+#include "yb/util/wait_state.h"
 
 namespace google {
 namespace protobuf {
@@ -130,6 +131,10 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   Trace* trace();
 
+  const WaitStateInfoPtr& wait_state() const {
+    return wait_state_;
+  }
+
   // When this InboundCall was received (instantiated).
   // Should only be called once on a given instance.
   // Not thread-safe. Should only be called by the current "owner" thread.
@@ -242,6 +247,9 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // The trace buffer.
   scoped_refptr<Trace> trace_;
 
+  // What the call is currently waiting on, reported when dumping running calls.
+  WaitStateInfoPtr wait_state_ = std::make_shared<WaitStateInfo>();
+
   // Timing information related to this RPC call.
   InboundCallTiming timing_;
 
@@ -93,6 +93,11 @@ DEFINE_UNKNOWN_int64(outbound_rpc_memory_limit, 0, "Outbound RPC memory limit");
 
 DEFINE_NON_RUNTIME_int32(rpc_queue_limit, 10000, "Queue limit for rpc server");
 DEFINE_NON_RUNTIME_int32(rpc_workers_limit, 1024, "Workers limit for rpc server");
+DEFINE_NON_RUNTIME_uint64(rpc_thread_pool_num_task_queues, 1,
+    "Number of task queues in each RPC worker thread pool. Inbound calls are spread over the "
+    "queues by the enqueuing thread, and idle workers take calls from other queues. Values "
+    "above 1 reduce contention on the queue when many reactor threads enqueue calls.");
+TAG_FLAG(rpc_thread_pool_num_task_queues, advanced);
 
 DEFINE_UNKNOWN_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
@@ -396,7 +401,8 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
       const ThreadPoolOptions& options = normal_thread_pool_->options();
       high_priority_thread_pool_.reset(new rpc::ThreadPool(rpc::ThreadPoolOptions {
         .name = name_ + "-high-pri",
-        .max_workers = options.max_workers
+        .max_workers = options.max_workers,
+        .num_task_queues = options.num_task_queues,
       }));
       return *high_priority_thread_pool_.get();
   }
@@ -556,6 +562,7 @@ Messenger::Messenger(const MessengerBuilder &bld)
       normal_thread_pool_(new rpc::ThreadPool(rpc::ThreadPoolOptions {
         .name = name_,
         .max_workers = bld.workers_limit_,
+        .num_task_queues = FLAGS_rpc_thread_pool_num_task_queues,
       })),
       resolver_(new DnsResolver(&io_thread_pool_.io_service())),
       rpc_metrics_(std::make_shared<RpcMetrics>(bld.metric_entity_)),
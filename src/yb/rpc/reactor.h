@@ -417,6 +417,10 @@ class Reactor {
   // connection_keepalive_time_
   void ScanIdleConnections();
 
+  // Returns read buffers of connections without activity for rpc_read_buffer_release_idle_ms
+  // to their pools.
+  void ReleaseIdleReadBuffers();
+
   // Assign a new outbound call to the appropriate connection object.
   // If this fails, the call is marked failed and completed.
   ConnectionPtr AssignOutboundCall(const OutboundCallPtr &call);
@@ -429,6 +433,8 @@ class Reactor {
   void ShutdownInternal();
 
   void ProcessOutboundQueue();
+  void DoProcessOutboundQueue();
+  void OutboundFlushTimerHandler(ev::timer& watcher, int revents); // NOLINT
 
   void CheckReadyToStop();
 
@@ -444,6 +450,8 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
@@ -476,6 +484,10 @@ class Reactor {
   // Handles the periodic timer.
   ev::timer timer_;
 
+  // Delays processing of the outbound queue by rpc_outbound_flush_delay_us, so calls queued
+  // during this interval are sent to their connections together.
+  ev::timer outbound_flush_timer_;
+
   // Scheduled (but not yet run) delayed tasks.
   std::set<std::shared_ptr<DelayedTask>> scheduled_tasks_;
 
@@ -487,6 +499,9 @@ class Reactor {
   // last time we did TCP timeouts.
   CoarseTimePoint last_unused_tcp_scan_;
 
+  // Next time to look for idle connections with read buffers.
+  CoarseTimePoint next_read_buffers_release_;
+
   // Map of sockaddrs to Connection objects for outbound (client) connections.
   ConnectionMap client_conns_;
 
@@ -35,12 +35,21 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/gutil/strings/numbers.h"
+#include "yb/gutil/strings/split.h"
+
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/proxy.h"
 #include "yb/rpc/rpc-test-base.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rtest.proxy.h"
+#include "yb/rpc/tcp_stream.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/flags.h"
+#include "yb/util/format.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
@@ -51,6 +60,20 @@ using namespace std::literals; // NOLINT
 using std::string;
 using std::shared_ptr;
 
+// The default sweep is kept short, so it can run with the other tests. Pass larger lists and
+// durations to get stable numbers.
+DEFINE_NON_RUNTIME_string(rpc_bench_payload_sizes, "16,65536",
+    "Comma separated list of echo payload sizes used by BenchmarkLatencyDistribution.");
+DEFINE_NON_RUNTIME_string(rpc_bench_concurrency, "1,16",
+    "Comma separated list of client thread counts used by BenchmarkLatencyDistribution.");
+DEFINE_NON_RUNTIME_int32(rpc_bench_run_seconds, 1,
+    "Duration of each payload size and concurrency combination in BenchmarkLatencyDistribution.");
+DEFINE_NON_RUNTIME_int32(rpc_bench_compression_algo, 0,
+    "Stream compression algorithm used by BenchmarkLatencyDistribution, 0 for no compression. "
+    "See stream_compression_algo for possible values.");
+
+DECLARE_int32(stream_compression_algo);
+
 namespace yb {
 namespace rpc {
 
@@ -155,5 +178,102 @@ TEST_F(RpcBench, BenchmarkCalls) {
   LOG(INFO) << "Sys CPU per req:  " << sys_cpu_micros_per_req << "us";
 }
 
+namespace {
+
+std::vector<uint64_t> ParseSizes(const std::string& input) {
+  std::vector<uint64_t> result;
+  for (const auto& str : strings::Split(input, ",", strings::SkipEmpty())) {
+    uint64 value;
+    CHECK(safe_strtou64(str.as_string(), &value)) << "Bad number: " << str;
+    result.push_back(value);
+  }
+  return result;
+}
+
+} // namespace
+
+class RpcLatencyBench : public RpcBench {
+ protected:
+  std::unique_ptr<Messenger> CreateBenchMessenger(
+      const std::string& name, const MessengerOptions& options = kDefaultClientMessengerOptions) {
+    auto builder = CreateMessengerBuilder(name, options);
+    if (FLAGS_rpc_bench_compression_algo) {
+      builder.SetListenProtocol(CompressedStreamProtocol());
+      builder.AddStreamFactory(
+          CompressedStreamProtocol(),
+          CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+    }
+    return EXPECT_RESULT(builder.Build());
+  }
+
+  // Runs echo calls with the specified payload from num_threads client threads, each of them
+  // sending the next call only after the previous one completes.
+  void RunEcho(size_t payload_size, size_t num_threads) {
+    // Latencies are tracked in microseconds, up to one minute.
+    HdrHistogram latency(60000000, 3);
+    const std::string payload(payload_size, 'x');
+    should_run_.store(true, std::memory_order_release);
+
+    Stopwatch sw(Stopwatch::ALL_THREADS);
+    sw.start();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i != num_threads; ++i) {
+      threads.emplace_back([this, &latency, &payload] {
+        CDSAttacher attacher;
+        auto client_messenger = CreateAutoShutdownMessengerHolder(CreateBenchMessenger("Client"));
+        ProxyCache proxy_cache(client_messenger.get());
+        rpc_test::CalculatorServiceProxy proxy(
+            &proxy_cache, server_hostport_, client_messenger->DefaultProtocol());
+
+        rpc_test::EchoRequestPB req;
+        req.set_data(payload);
+        rpc_test::EchoResponsePB resp;
+        while (should_run_.load(std::memory_order_acquire)) {
+          RpcController controller;
+          controller.set_timeout(MonoDelta::FromSeconds(10));
+          auto start = MonoTime::Now();
+          CHECK_OK(proxy.Echo(req, &resp, &controller));
+          latency.Increment((MonoTime::Now() - start).ToMicroseconds());
+          CHECK_EQ(resp.data().size(), payload.size());
+        }
+      });
+    }
+
+    std::this_thread::sleep_for(FLAGS_rpc_bench_run_seconds * 1s);
+    should_run_.store(false, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    sw.stop();
+
+    auto total_calls = latency.TotalCount();
+    ASSERT_GT(total_calls, 0);
+    auto elapsed = sw.elapsed();
+    LOG(INFO) << Format(
+        "Payload: $0, threads: $1, compression: $2, calls/sec: $3, latency us: "
+        "mean $4, p50 $5, p99 $6, p99.9 $7, max $8, CPU per call us: user $9, sys $10",
+        payload_size, num_threads, FLAGS_rpc_bench_compression_algo,
+        total_calls / elapsed.wall_seconds(), latency.MeanValue(),
+        latency.ValueAtPercentile(50), latency.ValueAtPercentile(99),
+        latency.ValueAtPercentile(99.9), latency.MaxValue(),
+        elapsed.user / 1000.0 / total_calls, elapsed.system / 1000.0 / total_calls);
+  }
+};
+
+// Measures latency distribution and CPU cost of echo calls for every combination of
+// rpc_bench_payload_sizes and rpc_bench_concurrency.
+TEST_F(RpcLatencyBench, BenchmarkLatencyDistribution) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_stream_compression_algo) = FLAGS_rpc_bench_compression_algo;
+  StartTestServerWithGeneratedCode(
+      CreateBenchMessenger("TestServer", TestServerOptions().messenger_options),
+      &server_hostport_);
+
+  for (auto payload_size : ParseSizes(FLAGS_rpc_bench_payload_sizes)) {
+    for (auto num_threads : ParseSizes(FLAGS_rpc_bench_concurrency)) {
+      ASSERT_NO_FATALS(RunEcho(payload_size, num_threads));
+    }
+  }
+}
+
 } // namespace rpc
 } // namespace yb
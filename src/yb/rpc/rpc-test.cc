@@ -87,9 +87,12 @@ DECLARE_int32(num_connections_to_server);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
 DECLARE_int64(memory_limit_hard_bytes);
+DECLARE_string(stream_compression_excluded_networks);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
+DECLARE_uint64(rpc_outbound_flush_delay_us);
 DECLARE_uint64(rpc_read_buffer_size);
+DECLARE_uint64(ssl_bio_buffer_size);
 
 using namespace std::chrono_literals;
 using std::string;
@@ -1170,6 +1173,11 @@ TEST_F(TestRpcSecure, BigOpWithSmallBuffer) {
   RunSecureTest(&TestBigOp);
 }
 
+TEST_F(TestRpcSecure, BigOpWithBigBioBuffer) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_ssl_bio_buffer_size) = 1_MB;
+  RunSecureTest(&TestBigOp);
+}
+
 void TestManyOps(CalculatorServiceProxy* proxy) {
   for (int i = 0; i != RegularBuildVsSanitizers(1000, 100); ++i) {
     RpcController controller;
@@ -1212,6 +1220,11 @@ TEST_F(TestRpcSecure, ConcurrentOps) {
   RunSecureTest(&TestConcurrentOps);
 }
 
+TEST_F(TestRpc, ConcurrentOpsWithOutboundFlushDelay) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_rpc_outbound_flush_delay_us) = 100;
+  RunPlainTest(&TestConcurrentOps);
+}
+
 TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   RunSecureTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
@@ -1268,7 +1281,9 @@ TEST_P(TestRpcCompression, CantAllocateReadBuffer) {
   RunCompressionTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
 
-void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity) {
+void TestCompression(
+    CalculatorServiceProxy* proxy, const MetricEntityPtr& metric_entity,
+    bool expect_compressed = true) {
   constexpr size_t kStringLen = 4_KB;
 
   size_t prev_sent = 0;
@@ -1292,6 +1307,11 @@ void TestCompression(CalculatorServiceProxy* proxy, const MetricEntityPtr& metri
       auto received = received_counter->value() - prev_received;
       LOG(INFO) << "Sent: " << sent << ", received: " << received;
 
+      if (!expect_compressed) {
+        ASSERT_GE(sent, kStringLen);
+        ASSERT_GE(received, kStringLen);
+        break;
+      }
       ASSERT_GT(sent, 10); // Check that metric even work.
       ASSERT_LE(sent, kStringLen / 5); // Check that compression work.
       ASSERT_GT(received, 10); // Check that metric even work.
@@ -1310,6 +1330,13 @@ TEST_P(TestRpcCompression, Compression) {
   });
 }
 
+TEST_P(TestRpcCompression, ExcludedNetwork) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_stream_compression_excluded_networks) = "127.0.0.0/8,::1/128";
+  RunCompressionTest([this](CalculatorServiceProxy* proxy) {
+    TestCompression(proxy, metric_entity(), /* expect_compressed= */ false);
+  });
+}
+
 std::string CompressionName(const testing::TestParamInfo<int>& info) {
   switch (info.param) {
     case 1: return "Zlib";
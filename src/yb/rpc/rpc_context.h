@@ -135,7 +135,8 @@ class RpcCallLWParamsImpl : public RpcCallLWParams {
     return resp_;
   }
 
-  RpcCallLWParamsImpl() : req_(&arena_), resp_(&arena_) {}
+  RpcCallLWParamsImpl()
+      : arena_(ThreadCachedBufferAllocator::Get()), req_(&arena_), resp_(&arena_) {}
 
  private:
   ThreadSafeArena arena_;
@@ -129,6 +129,9 @@ typedef std::shared_ptr<ConnectionContextFactory> ConnectionContextFactoryPtr;
 class StreamFactory;
 typedef std::shared_ptr<StreamFactory> StreamFactoryPtr;
 
+class ReadBufferPool;
+using ReadBufferPoolPtr = std::shared_ptr<ReadBufferPool>;
+
 YB_STRONGLY_TYPED_BOOL(ReadBufferFull);
 YB_STRONGLY_TYPED_BOOL(Queue);
 
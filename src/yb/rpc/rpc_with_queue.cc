@@ -29,8 +29,10 @@ namespace rpc {
 
 ConnectionContextWithQueue::ConnectionContextWithQueue(
     size_t max_concurrent_calls,
-    size_t max_queued_bytes)
-    : max_concurrent_calls_(max_concurrent_calls), max_queued_bytes_(max_queued_bytes) {
+    size_t max_queued_bytes,
+    size_t max_concurrent_overlappable_calls)
+    : max_concurrent_calls_(max_concurrent_calls), max_queued_bytes_(max_queued_bytes),
+      max_concurrent_overlappable_calls_(max_concurrent_overlappable_calls) {
 }
 
 ConnectionContextWithQueue::~ConnectionContextWithQueue() {
@@ -66,15 +68,42 @@ void ConnectionContextWithQueue::Enqueue(std::shared_ptr<QueueableInboundCall> c
   if (size == replies_being_sent_ + 1) {
     first_without_reply_.store(call.get(), std::memory_order_release);
   }
-  if (size <= max_concurrent_calls_) {
-    reactor->messenger()->Handle(call, Queue::kTrue);
+  StartCalls(reactor);
+}
+
+bool ConnectionContextWithQueue::CanStartNextCall() const {
+  if (started_calls_ >= calls_queue_.size()) {
+    return false;
+  }
+  if (started_calls_ < max_concurrent_calls_) {
+    return true;
+  }
+  if (started_calls_ >= max_concurrent_overlappable_calls_ ||
+      !calls_queue_[started_calls_]->overlappable()) {
+    return false;
+  }
+  // A call that is not overlappable should be fully processed before overlappable calls after it
+  // are started.
+  for (size_t i = 0; i != started_calls_; ++i) {
+    const auto& call = *calls_queue_[i];
+    if (!call.overlappable() && !call.has_reply()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConnectionContextWithQueue::StartCalls(Reactor* reactor) {
+  while (CanStartNextCall()) {
+    reactor->messenger()->Handle(calls_queue_[started_calls_], Queue::kTrue);
+    ++started_calls_;
   }
 }
 
 void ConnectionContextWithQueue::Shutdown(const Status& status) {
   // Could erase calls, that we did not start to process yet.
-  if (calls_queue_.size() > max_concurrent_calls_) {
-    calls_queue_.erase(calls_queue_.begin() + max_concurrent_calls_, calls_queue_.end());
+  if (calls_queue_.size() > started_calls_) {
+    calls_queue_.erase(calls_queue_.begin() + started_calls_, calls_queue_.end());
   }
 
   for (auto& call : calls_queue_) {
@@ -97,10 +126,8 @@ void ConnectionContextWithQueue::CallProcessed(InboundCall* call) {
 
   calls_queue_.pop_front();
   --replies_being_sent_;
-  if (calls_queue_.size() >= max_concurrent_calls_) {
-    auto call_ptr = calls_queue_[max_concurrent_calls_ - 1];
-    reactor->messenger()->Handle(call_ptr, Queue::kTrue);
-  }
+  --started_calls_;
+  StartCalls(reactor);
   if (Idle() && idle_listener_) {
     idle_listener_();
   }
@@ -148,6 +175,10 @@ void ConnectionContextWithQueue::FlushOutboundQueue(Connection* conn) {
         calls_queue_.begin() + begin,
         calls_queue_.begin() + end);
     conn->QueueOutboundDataBatch(batch);
+    // Overlappable calls could wait for the calls that just got their replies.
+    if (max_concurrent_overlappable_calls_ > max_concurrent_calls_) {
+      StartCalls(conn->reactor());
+    }
   }
 }
 
@@ -53,6 +53,17 @@ class QueueableInboundCall : public InboundCall {
     return aborted_.load(std::memory_order_acquire);
   }
 
+  // Marks the call as one that may be processed concurrently with other overlappable calls of the
+  // same connection, for instance because it only reads. Should be called before the call is
+  // enqueued.
+  void SetOverlappable() {
+    overlappable_ = true;
+  }
+
+  bool overlappable() const {
+    return overlappable_;
+  }
+
   // Context with queue has limit on bytes used by queued commands.
   // `weight_in_bytes` function is used to determine how many bytes consumes this call.
   size_t weight_in_bytes() const { return weight_in_bytes_; }
@@ -60,15 +71,21 @@ class QueueableInboundCall : public InboundCall {
  private:
   std::atomic<bool> has_reply_{false};
   std::atomic<bool> aborted_{false};
+  bool overlappable_ = false;
   const size_t weight_in_bytes_;
 };
 
 class ConnectionContextWithQueue : public ConnectionContextBase,
                                    public InboundCall::CallProcessedListener {
  protected:
-  explicit ConnectionContextWithQueue(
+  // Up to max_concurrent_calls calls are processed at once. A call marked as overlappable could
+  // also be started when there are max_concurrent_calls or more calls ahead of it, as long as
+  // there are less than max_concurrent_overlappable_calls of them and each of them is
+  // overlappable or already has its reply.
+  ConnectionContextWithQueue(
       size_t max_concurrent_calls,
-      size_t max_queued_bytes);
+      size_t max_queued_bytes,
+      size_t max_concurrent_overlappable_calls = 0);
 
   ~ConnectionContextWithQueue();
 
@@ -93,19 +110,29 @@ class ConnectionContextWithQueue : public ConnectionContextBase,
 
   void CallProcessed(InboundCall* call) override;
   void FlushOutboundQueue(Connection* conn);
+
+  // Whether the call at position started_calls_ in calls_queue_ could be started.
+  bool CanStartNextCall() const;
+
+  // Starts processing of calls that could be started, in queue order.
+  void StartCalls(Reactor* reactor);
   void FlushOutboundQueueAborted(const Status& status);
 
   const size_t max_concurrent_calls_;
   const size_t max_queued_bytes_;
+  const size_t max_concurrent_overlappable_calls_;
   size_t replies_being_sent_ = 0;
+  // Number of calls at the top of calls_queue_, whose processing was started.
+  size_t started_calls_ = 0;
   size_t queued_bytes_ = 0;
 
   // Calls that are being processed by this connection/context.
   // At the top or queue there are replies_being_sent_ calls, for which we are sending reply.
   // After that there are calls that are being processed.
   // first_without_reply_ points to the first of them.
-  // There are not more than max_concurrent_calls_ entries in first two groups.
-  // After end of queue there are calls that we received but processing did not start for them.
+  // There are started_calls_ entries in first two groups. It is not more than
+  // max_concurrent_calls_, unless overlappable calls are started, see CanStartNextCall.
+  // After them there are calls that we received but processing did not start for them.
   std::deque<std::shared_ptr<QueueableInboundCall>> calls_queue_;
   std::shared_ptr<ReactorTask> flush_outbound_queue_task_;
 
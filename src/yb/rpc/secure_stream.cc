@@ -52,6 +52,14 @@ DEFINE_UNKNOWN_string(cipher_list, "",
 DEFINE_UNKNOWN_string(ciphersuites, "",
               "Define the available TLSv1.3 ciphersuites.");
 
+DEFINE_RUNTIME_uint64(ssl_bio_buffer_size, 0,
+    "Size of the buffer between OpenSSL and the underlying stream of a secure connection, in "
+    "each direction. Encrypted data is passed to the underlying stream in chunks of at most this "
+    "size, so a bigger buffer means fewer allocations and writes for big messages at the cost of "
+    "memory per connection. 0 to use the OpenSSL default, which fits a single TLS record. "
+    "Applied to new connections.");
+TAG_FLAG(ssl_bio_buffer_size, advanced);
+
 #define YB_RPC_SSL_TYPE(name) \
   struct BOOST_PP_CAT(name, Free) { \
     void operator()(name* value) const { \
@@ -896,7 +904,10 @@ Status SecureRefiner::Init() {
 
   BIO* int_bio = nullptr;
   BIO* temp_bio = nullptr;
-  BIO_new_bio_pair(&int_bio, 0, &temp_bio, 0);
+  const size_t bio_buffer_size = FLAGS_ssl_bio_buffer_size;
+  if (!BIO_new_bio_pair(&int_bio, bio_buffer_size, &temp_bio, bio_buffer_size)) {
+    return SSL_STATUS(IOError, "Create BIO pair failed: $0");
+  }
   SSL_set_bio(ssl_.get(), int_bio, int_bio);
   bio_.reset(temp_bio);
 
@@ -65,6 +65,7 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/trace.h"
+#include "yb/util/wait_state.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -79,6 +80,12 @@ DEFINE_RUNTIME_int64(backpressure_recovery_period_ms, 600000,
     "Once we hit a backpressure/service-overflow we will consider dropping stale requests "
     "for this duration (in ms)");
 TAG_FLAG(backpressure_recovery_period_ms, advanced);
+DEFINE_RUNTIME_int64(min_remaining_deadline_to_handle_ms, 0,
+    "While recovering from backpressure (see backpressure_recovery_period_ms), fail calls whose "
+    "client deadline expires in less than the specified amount of time (in ms) instead of "
+    "handling them, since the client would most likely time out before receiving the response. "
+    "0 to disable.");
+TAG_FLAG(min_remaining_deadline_to_handle_ms, advanced);
 DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
@@ -251,13 +258,11 @@ class ServicePoolImpl final : public InboundCallHandler {
   void Handle(InboundCallPtr incoming) override {
     incoming->RecordHandlingStarted(incoming_queue_time_);
     ADOPT_TRACE(incoming->trace());
+    ADOPT_WAIT_STATE(incoming->wait_state());
 
-    const char* error_message;
-    if (PREDICT_FALSE(incoming->ClientTimedOut())) {
-      error_message = kTimedOutInQueue;
-    } else if (PREDICT_FALSE(ShouldDropRequestDuringHighLoad(incoming))) {
-      error_message = "The server is overloaded. Call waited in the queue past max_time_in_queue.";
-    } else {
+    const char* error_message = PREDICT_FALSE(incoming->ClientTimedOut())
+        ? kTimedOutInQueue : DropReasonDuringHighLoad(incoming);
+    if (PREDICT_TRUE(!error_message)) {
       if (incoming->TryStartProcessing()) {
         TRACE_TO(incoming->trace(), "Handling call $0", AsString(incoming->method_name()));
         service_->Handle(std::move(incoming));
@@ -281,7 +286,27 @@ class ServicePoolImpl final : public InboundCallHandler {
     }
   }
 
-  bool ShouldDropRequestDuringHighLoad(const InboundCallPtr& incoming) {
+  // Returns the reason to drop the call without handling it, or nullptr if it should be handled.
+  const char* DropReasonDuringHighLoad(const InboundCallPtr& incoming) {
+    if (!InBackpressureRecovery()) {
+      return nullptr;
+    }
+
+    if (incoming->GetTimeInQueue().ToMilliseconds() > FLAGS_max_time_in_queue_ms) {
+      return "The server is overloaded. Call waited in the queue past max_time_in_queue.";
+    }
+
+    auto min_remaining_deadline_ms = FLAGS_min_remaining_deadline_to_handle_ms;
+    if (min_remaining_deadline_ms > 0 &&
+        incoming->GetClientDeadline() - CoarseMonoClock::Now() <
+            min_remaining_deadline_ms * 1ms) {
+      return "The server is overloaded. Call could not be handled before its deadline.";
+    }
+
+    return nullptr;
+  }
+
+  bool InBackpressureRecovery() {
     CoarseTimePoint last_backpressure_at(last_backpressure_at_.load(std::memory_order_acquire));
 
     // For testing purposes.
@@ -300,7 +325,7 @@ class ServicePoolImpl final : public InboundCallHandler {
       return false;
     }
 
-    return incoming->GetTimeInQueue().ToMilliseconds() > FLAGS_max_time_in_queue_ms;
+    return true;
   }
 
   void CheckTimeout(ScheduledTaskId task_id, CoarseTimePoint time, const Status& status) {
@@ -62,6 +62,11 @@ class StreamReadBuffer {
 
   virtual size_t DataAvailable() = 0;
 
+  // Releases memory of this buffer, if it does not contain any data. The buffer remains usable,
+  // and allocates memory again on the next PrepareAppend.
+  // Returns the number of released bytes.
+  virtual size_t Release() { return 0; }
+
   // Render this buffer to string.
   virtual std::string ToString() const = 0;
 
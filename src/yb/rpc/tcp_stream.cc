@@ -43,7 +43,9 @@ namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Max number of buffers passed to a single writev. Small calls are serialized into a couple of
+// buffers each, so this limits how many of them are coalesced into one system call.
+const size_t kMaxIov = 64;
 
 }
 
@@ -213,6 +215,10 @@ Status TcpStream::DoWrite() {
       context_->UpdateLastActivity();
     }
 
+    size_t bytes_to_write = 0;
+    for (size_t i = 0; i != fill_result.len; ++i) {
+      bytes_to_write += iov[i].iov_len;
+    }
     auto result = fill_result.len != 0
         ? socket_.Writev(iov, fill_result.len)
         : 0;
@@ -251,6 +257,12 @@ Status TcpStream::DoWrite() {
         context_->Transferred(data, Status::OK());
       }
     }
+
+    // Partial write means that the socket send buffer is full, so the next attempt would fail
+    // with EAGAIN. Wait for the write readiness notification instead.
+    if (*result < bytes_to_write) {
+      break;
+    }
   }
 
   return Status::OK();
@@ -305,7 +317,8 @@ void TcpStream::UpdateEvents() {
   if (waiting_write_ready_) {
     events |= ev::WRITE;
   }
-  if (events) {
+  // Changing the watcher events results in epoll_ctl call, so do it only when they differ.
+  if (events && (io_.events & (ev::READ | ev::WRITE)) != events) {
     io_.set(events);
   }
 }
@@ -313,8 +326,14 @@ void TcpStream::UpdateEvents() {
 Status TcpStream::ReadHandler() {
   context_->UpdateLastRead();
 
+  bool socket_drained = false;
   for (;;) {
-    auto received = Receive();
+    // Previous read did not fill the whole buffer, so there is no more data in the socket.
+    // The watcher is level triggered, so we will be notified when new data arrives.
+    if (socket_drained) {
+      return Status::OK();
+    }
+    auto received = Receive(&socket_drained);
     if (PREDICT_FALSE(!received.ok())) {
       if (Errno(received.status()) == ESHUTDOWN) {
         VLOG_WITH_PREFIX(1) << "Shut down by remote end.";
@@ -339,7 +358,7 @@ Status TcpStream::ReadHandler() {
   }
 }
 
-Result<bool> TcpStream::Receive() {
+Result<bool> TcpStream::Receive(bool* socket_drained) {
   auto iov = ReadBuffer().PrepareAppend();
   if (!iov.ok()) {
     VLOG_WITH_PREFIX(3) << "ReadBuffer().PrepareAppend() error: " << iov.status();
@@ -370,6 +389,7 @@ Result<bool> TcpStream::Receive() {
     } while (inbound_bytes_to_skip_ > 0);
   }
 
+  const auto bytes_to_read = IoVecsFullSize(*iov);
   auto nread = socket_.Recvv(iov.get_ptr());
   if (!nread.ok()) {
     DVLOG_WITH_PREFIX(3) << "socket_.Recvv() error: " << nread.status();
@@ -382,6 +402,7 @@ Result<bool> TcpStream::Receive() {
 
   IncrementCounterBy(bytes_received_counter_, *nread);
   ReadBuffer().DataAppended(*nread);
+  *socket_drained = *nread < bytes_to_read;
   return *nread != 0;
 }
 
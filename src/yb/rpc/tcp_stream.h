@@ -99,7 +99,8 @@ class TcpStream : public Stream {
   Status ReadHandler();
   Status WriteHandler(bool just_connected);
 
-  Result<bool> Receive();
+  // Sets socket_drained to true when the socket did not have enough data to fill the read buffer.
+  Result<bool> Receive(bool* socket_drained);
   // Try to parse received data and process it.
   Result<bool> TryProcessReceived();
 
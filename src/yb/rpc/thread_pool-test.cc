@@ -126,13 +126,14 @@ TEST_F(ThreadPoolTest, TestSingleProducer) {
   }
 }
 
-TEST_F(ThreadPoolTest, TestMultiProducers) {
+void TestMultiProducers(size_t num_task_queues) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
   constexpr size_t kProducers = 4;
   ThreadPool pool(ThreadPoolOptions {
     .name = "test",
     .max_workers = kTotalWorkers,
+    .num_task_queues = num_task_queues,
   });
 
   CountDownLatch latch(kTotalTasks);
@@ -159,6 +160,14 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+TEST_F(ThreadPoolTest, TestMultiProducers) {
+  TestMultiProducers(/* num_task_queues= */ 1);
+}
+
+TEST_F(ThreadPoolTest, TestMultiProducersMultipleQueues) {
+  TestMultiProducers(/* num_task_queues= */ 3);
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
@@ -15,16 +15,23 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/util/flags.h"
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
 #include "yb/util/thread.h"
 
+DECLARE_bool(rpc_numa_affinity);
+
 namespace yb {
 namespace rpc {
 
@@ -37,11 +44,42 @@ typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
 struct ThreadPoolShare {
   ThreadPoolOptions options;
-  TaskQueue task_queue;
+  std::vector<std::unique_ptr<TaskQueue>> task_queues;
   WaitingWorkers waiting_workers;
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)) {
+    options.num_task_queues = std::max<size_t>(options.num_task_queues, 1);
+    task_queues.reserve(options.num_task_queues);
+    for (size_t i = 0; i != options.num_task_queues; ++i) {
+      task_queues.push_back(std::make_unique<TaskQueue>());
+    }
+  }
+
+  void Push(ThreadPoolTask* task) {
+    auto& queue = task_queues.size() == 1
+        ? *task_queues.front() : *task_queues[ProducerIndex() % task_queues.size()];
+    bool added = queue.push(task);
+    DCHECK(added); // BasketQueue always succeed.
+  }
+
+  // Pops task from any queue, starting from the one with specified index.
+  bool Pop(size_t start_index, ThreadPoolTask** task) {
+    const auto size = task_queues.size();
+    for (size_t i = 0; i != size; ++i) {
+      if (task_queues[(start_index + i) % size]->pop(*task)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static size_t ProducerIndex() {
+    static std::atomic<size_t> next_producer_index{0};
+    thread_local size_t producer_index = next_producer_index.fetch_add(
+        1, std::memory_order_relaxed);
+    return producer_index;
+  }
 };
 
 namespace {
@@ -57,6 +95,7 @@ class Worker {
   }
 
   Status Start(size_t index) {
+    index_ = index;
     auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
     return yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_);
   }
@@ -97,6 +136,9 @@ class Worker {
   // Meaning that we does not have work (task queue empty) or
   // does not have free hands (worker queue empty)
   void Execute() {
+    if (FLAGS_rpc_numa_affinity) {
+      WARN_NOT_OK(PinCurrentThreadToNumaNode(index_), "Failed to pin RPC worker thread");
+    }
     Thread::current_thread()->SetUserData(share_);
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
@@ -110,7 +152,7 @@ class Worker {
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (share_->Pop(index_, task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -126,7 +168,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->Pop(index_, task)) {
         return true;
       }
 
@@ -134,7 +176,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (share_->Pop(index_, task)) {
         return true;
       }
     }
@@ -150,6 +192,8 @@ class Worker {
   }
 
   ThreadPoolShare* share_;
+  // Index of the worker, also used to pick the task queue that this worker checks first.
+  size_t index_ = 0;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -179,8 +223,7 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
-    DCHECK(added); // BasketQueue always succeed.
+    share_.Push(task);
     Worker* worker = nullptr;
     while (share_.waiting_workers.pop(worker)) {
       if (worker->Notify()) {
@@ -219,7 +262,9 @@ class ThreadPool::Impl {
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (const auto& queue : share_.task_queues) {
+          CHECK(queue->empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -238,7 +283,7 @@ class ThreadPool::Impl {
     }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
+    while (share_.Pop(0, &task)) {
       task->Done(shutdown_status_);
     }
   }
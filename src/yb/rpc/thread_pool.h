@@ -74,9 +74,13 @@ FunctorThreadPoolTask<F>* MakeFunctorThreadPoolTask(F&& f) {
 struct ThreadPoolOptions {
   std::string name;
   size_t max_workers;
+  // Tasks are spread over this number of queues, to reduce contention between threads that
+  // enqueue tasks. Each worker prefers its own queue, but takes tasks from other queues when its
+  // own queue is empty.
+  size_t num_task_queues = 1;
 
   std::string ToString() const {
-    return YB_STRUCT_TO_STRING(name, max_workers);
+    return YB_STRUCT_TO_STRING(name, max_workers, num_task_queues);
   }
 };
 
@@ -97,11 +97,11 @@ using google::protobuf::io::CodedOutputStream;
 
 YBConnectionContext::YBConnectionContext(
     size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-    const MemTrackerPtr& call_tracker)
+    const MemTrackerPtr& call_tracker, const ReadBufferPoolPtr& read_buffer_pool)
     : parser_(buffer_tracker, kMsgLengthPrefixLength, 0 /* size_offset */,
               FLAGS_rpc_max_message_size, IncludeHeader::kFalse, rpc::SkipEmptyMessages::kTrue,
               this),
-      read_buffer_(receive_buffer_size, buffer_tracker),
+      read_buffer_(receive_buffer_size, buffer_tracker, read_buffer_pool),
       call_tracker_(call_tracker) {}
 
 void YBConnectionContext::SetEventLoop(ev::loop_ref* loop) {
@@ -321,6 +321,7 @@ bool YBInboundCall::DumpPB(const DumpRunningRpcsRequestPB& req,
   }
   resp->set_elapsed_millis(MonoTime::Now().GetDeltaSince(timing_.time_received)
       .ToMilliseconds());
+  resp->set_wait_state(AsString(wait_state_->code()));
   return true;
 }
 
@@ -46,7 +46,7 @@ class YBConnectionContext : public ConnectionContextWithCallId, public BinaryCal
  public:
   YBConnectionContext(
       size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-      const MemTrackerPtr& call_tracker);
+      const MemTrackerPtr& call_tracker, const ReadBufferPoolPtr& read_buffer_pool);
   ~YBConnectionContext();
 
   const MemTrackerPtr& call_tracker() const { return call_tracker_; }
@@ -80,8 +80,9 @@ class YBInboundConnectionContext : public YBConnectionContext {
  public:
   YBInboundConnectionContext(
       size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-      const MemTrackerPtr& call_tracker)
-      : YBConnectionContext(receive_buffer_size, buffer_tracker, call_tracker) {}
+      const MemTrackerPtr& call_tracker, const ReadBufferPoolPtr& read_buffer_pool)
+      : YBConnectionContext(
+            receive_buffer_size, buffer_tracker, call_tracker, read_buffer_pool) {}
 
   static std::string Name() { return "Inbound RPC"; }
  private:
@@ -224,8 +225,9 @@ class YBOutboundConnectionContext : public YBConnectionContext {
  public:
   YBOutboundConnectionContext(
       size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-      const MemTrackerPtr& call_tracker)
-      : YBConnectionContext(receive_buffer_size, buffer_tracker, call_tracker) {}
+      const MemTrackerPtr& call_tracker, const ReadBufferPoolPtr& read_buffer_pool)
+      : YBConnectionContext(
+            receive_buffer_size, buffer_tracker, call_tracker, read_buffer_pool) {}
 
   static std::string Name() { return "Outbound RPC"; }
 
@@ -152,7 +152,7 @@ HybridTimeRange HybridClock::NowRange() {
 void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec) {
   DCHECK_EQ(state_, kInitialized) << "Clock not initialized. Must call Init() first.";
 
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
+  uint64_t current_packed = components_.load(std::memory_order_acquire);
 
   auto now = clock_->Now();
   if (PREDICT_FALSE(!now.ok())) {
@@ -162,6 +162,7 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
 
   // If the current time surpasses the last update just return it
   HybridClockComponents new_components = { now->time_point, 1 };
+  auto current_components = HybridClockComponents::FromPacked(current_packed);
 
   VLOG(4) << __func__ << ", new: " << new_components << ", current: " << current_components;
 
@@ -186,8 +187,9 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
     }
   } else {
     // Loop over the check in case of concurrent updates making the CAS fail.
-    while (now->time_point > current_components.last_usec) {
-      if (components_.compare_exchange_weak(current_components, new_components)) {
+    const auto new_packed = new_components.Packed();
+    while (now->time_point > (current_packed >> HybridTime::kBitsForLogicalComponent)) {
+      if (components_.compare_exchange_weak(current_packed, new_packed)) {
         *hybrid_time = HybridTimeFromMicroseconds(new_components.last_usec);
         *max_error_usec = now->max_error;
         if (PREDICT_FALSE(VLOG_IS_ON(2))) {
@@ -217,19 +219,18 @@ void HybridClock::NowWithError(HybridTime *hybrid_time, uint64_t *max_error_usec
   // This broadens the error interval for both cases but always returns
   // a correct error interval.
 
-  do {
-    new_components.last_usec = current_components.last_usec;
-    new_components.logical = current_components.logical + 1;
-    new_components.HandleLogicalComponentOverflow();
-    // Loop over the check until the CAS succeeds, in case there are concurrent updates.
-  } while (!components_.compare_exchange_weak(current_components, new_components));
+  // The packed value is the next hybrid time to hand out, so a single increment both takes it
+  // and advances the clock. Overflow of the logical component carries into last_usec.
+  auto taken = components_.fetch_add(1, std::memory_order_acq_rel);
+  if (PREDICT_FALSE(((taken + 1) & HybridTime::kLogicalBitMask) == 0)) {
+    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: "
+        << HybridClockComponents::FromPacked(taken);
+  }
 
-  *max_error_usec = new_components.last_usec - (now->time_point - now->max_error);
+  *max_error_usec =
+      ((taken + 1) >> HybridTime::kBitsForLogicalComponent) - (now->time_point - now->max_error);
 
-  // We've already atomically incremented the logical, so subtract 1.
-  *hybrid_time = HybridTimeFromMicrosecondsAndLogicalValue(
-      new_components.last_usec,
-      narrow_cast<LogicalTimeComponent>(new_components.logical)).Decremented();
+  *hybrid_time = HybridTime(taken);
   if (PREDICT_FALSE(VLOG_IS_ON(2))) {
     VLOG(2) << "Current clock is lower than the last one. Returning last read and incrementing"
         " logical values. Hybrid time: " << *hybrid_time << " Error: " << *max_error_usec;
@@ -241,21 +242,20 @@ void HybridClock::Update(const HybridTime& to_update) {
     return;
   }
 
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
-  HybridClockComponents new_components = {
-    GetPhysicalValueMicros(to_update), GetLogicalValue(to_update) + 1
-  };
+  uint64_t current_packed = components_.load(std::memory_order_acquire);
+  // The next hybrid time to hand out, with an overflow of the logical component carried into
+  // the physical one.
+  const uint64_t new_packed = to_update.ToUint64() + 1;
 
   // VLOG(4) crashes in TSAN mode
   if (VLOG_IS_ON(4)) {
-    LOG(INFO) << __func__ << ", new: " << new_components << ", current: " << current_components;
+    LOG(INFO) << __func__ << ", new: " << HybridClockComponents::FromPacked(new_packed)
+              << ", current: " << HybridClockComponents::FromPacked(current_packed);
   }
 
-  new_components.HandleLogicalComponentOverflow();
-
   // Keep trying to CAS until it works or until HT has advanced past this update.
-  while (current_components < new_components &&
-      !components_.compare_exchange_weak(current_components, new_components)) {}
+  while (current_packed < new_packed &&
+      !components_.compare_exchange_weak(current_packed, new_packed)) {}
 }
 
 // Used to get the hybrid_time for metrics.
@@ -273,7 +273,8 @@ uint64_t HybridClock::ErrorForMetrics() {
 }
 
 int64_t HybridClock::SkewForMetrics() {
-  HybridClockComponents current_components = components_.load(boost::memory_order_acquire);
+  auto current_components = HybridClockComponents::FromPacked(
+      components_.load(std::memory_order_acquire));
   auto now = clock_->Now();
   if (PREDICT_FALSE(!now.ok())) {
     LOG(DFATAL) << Substitute("Couldn't get the current time: Clock unsynchronized. "
@@ -293,20 +294,6 @@ std::ostream& operator<<(std::ostream& out, const HybridClockComponents& compone
   return out << components.ToString();
 }
 
-void HybridClockComponents::HandleLogicalComponentOverflow() {
-  if (logical > HybridTime::kLogicalBitMask) {
-    static constexpr uint64_t kMaxOverflowValue = 1ULL << HybridTime::kBitsForLogicalComponent;
-    if (logical > kMaxOverflowValue) {
-      LOG(FATAL) << "Logical component is too high: last_usec=" << last_usec
-                 << "logical=" << logical << ", max allowed is " << kMaxOverflowValue;
-    }
-    YB_LOG_EVERY_N_SECS(WARNING, 5) << "Logical component overflow: "
-        << "last_usec=" << last_usec << ", logical=" << logical;
-
-    last_usec += logical >> HybridTime::kBitsForLogicalComponent;
-    logical &= HybridTime::kLogicalBitMask;
-  }
-}
 
 void HybridClock::RegisterMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
   METRIC_hybrid_clock_hybrid_time.InstantiateFunctionGauge(
@@ -38,8 +38,6 @@
 #include <sys/timex.h>
 #endif // !defined(__APPLE__)
 
-#include <boost/atomic.hpp>
-
 #include "yb/gutil/ref_counted.h"
 #include "yb/server/clock.h"
 #include "yb/util/locks.h"
@@ -75,7 +73,16 @@ struct HybridClockComponents {
     return last_usec < o.last_usec || (last_usec == o.last_usec && logical <= o.logical);
   }
 
-  void HandleLogicalComponentOverflow();
+  // Components are kept in a single word using the HybridTime layout, so an increment of the
+  // logical component that overflows carries into last_usec.
+  static HybridClockComponents FromPacked(uint64_t packed) {
+    return HybridClockComponents(
+        packed >> HybridTime::kBitsForLogicalComponent, packed & HybridTime::kLogicalBitMask);
+  }
+
+  uint64_t Packed() const {
+    return (last_usec << HybridTime::kBitsForLogicalComponent) + logical;
+  }
 
   std::string ToString() const;
 };
@@ -160,7 +167,8 @@ class HybridClock : public Clock {
   int64_t SkewForMetrics();
 
   PhysicalClockPtr clock_;
-  boost::atomic<HybridClockComponents> components_{HybridClockComponents(0, 0)};
+  // HybridClockComponents packed with HybridClockComponents::Packed.
+  std::atomic<uint64_t> components_{0};
   State state_ = kNotInitialized;
 
   // Clock metrics are set to detach to their last value. This means
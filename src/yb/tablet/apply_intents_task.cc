@@ -33,6 +33,13 @@ DEFINE_test_flag(int32, pause_and_skip_apply_intents_task_loop_ms, 0,
                  "If set to a value greater than zero, each loop of the apply intents task will "
                  "sleep for the specified duration and continue without doing apply work.");
 
+DEFINE_RUNTIME_uint32(apply_intents_task_max_batches_per_run, 0,
+    "Max number of apply batches (see txn_max_apply_batch_records) processed by a large "
+    "transaction apply task before it yields the participant strand to other tasks of the "
+    "tablet, such as applies of other large transactions and intent cleanups. "
+    "0 means no limit.");
+TAG_FLAG(apply_intents_task_max_batches_per_run, advanced);
+
 namespace yb {
 namespace tablet {
 
@@ -56,7 +63,15 @@ bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction, ScopedRWOperat
 void ApplyIntentsTask::Run() {
   VLOG_WITH_PREFIX(4) << __func__;
 
+  const auto max_batches = FLAGS_apply_intents_task_max_batches_per_run;
+  uint32_t batches = 0;
   for (;;) {
+    if (max_batches && batches >= max_batches) {
+      VLOG_WITH_PREFIX(3) << "Yield after " << batches << " apply batches";
+      yielded_ = true;
+      break;
+    }
+
     AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
 
     if (running_transaction_context_.Closing()) {
@@ -78,6 +93,7 @@ void ApplyIntentsTask::Run() {
       break;
     }
 
+    ++batches;
     transaction_->SetApplyData(*result);
     VLOG_WITH_PREFIX(2) << "Performed next apply step: " << result->ToString();
 
@@ -88,6 +104,14 @@ void ApplyIntentsTask::Run() {
 }
 
 void ApplyIntentsTask::Done(const Status& status) {
+  if (yielded_) {
+    yielded_ = false;
+    if (status.ok()) {
+      // Continue after the tasks that were enqueued into the strand while this one was running.
+      running_transaction_context_.StrandEnqueue(this);
+      return;
+    }
+  }
   WARN_NOT_OK(status, "Apply intents task failed");
   operation_.Reset();
   transaction_.reset();
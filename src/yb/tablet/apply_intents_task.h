@@ -49,6 +49,10 @@ class ApplyIntentsTask : public rpc::StrandTask {
   // The task can be submitted only once, so this flag never reverts its state to false.
   std::atomic<bool> used_{false};
   RunningTransactionPtr transaction_;
+
+  // Set by Run when it stopped to let other strand tasks run while apply is still active.
+  // Done submits the task to the strand again in this case.
+  bool yielded_ = false;
 };
 
 } // namespace tablet
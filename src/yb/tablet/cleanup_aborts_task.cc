@@ -16,15 +16,28 @@
 #include "yb/tablet/transaction_intent_applier.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/transaction_participant_context.h"
+#include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/util/debug-util.h"
+#include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
 
+DEFINE_RUNTIME_bool(cleanup_aborts_resolve_status_in_batches, true,
+    "Resolve statuses of transactions found by the intents compaction filter with one request "
+    "per status tablet, instead of one request per transaction.");
+TAG_FLAG(cleanup_aborts_resolve_status_in_batches, advanced);
+
+DEFINE_RUNTIME_uint32(cleanup_aborts_resolve_status_timeout_ms, 10000,
+    "Timeout for resolving statuses of transactions found by the intents compaction filter, "
+    "when they are resolved in batches.");
+TAG_FLAG(cleanup_aborts_resolve_status_timeout_ms, advanced);
+
 DECLARE_uint64(aborted_intent_cleanup_ms);
+DECLARE_int32(max_transactions_in_status_request);
 
 namespace yb {
 namespace tablet {
@@ -33,10 +46,12 @@ CleanupAbortsTask::CleanupAbortsTask(TransactionIntentApplier* applier,
                                      TransactionIdSet&& transactions_to_cleanup,
                                      TransactionParticipantContext* participant_context,
                                      TransactionStatusManager* status_manager,
+                                     rpc::Rpcs* rpcs,
                                      const std::string& log_prefix)
     : applier_(applier), transactions_to_cleanup_(std::move(transactions_to_cleanup)),
       participant_context_(*participant_context),
       status_manager_(*status_manager),
+      rpcs_(*rpcs),
       log_prefix_(log_prefix) {}
 
 void CleanupAbortsTask::Prepare(std::shared_ptr<CleanupAbortsTask> cleanup_task) {
@@ -107,14 +122,77 @@ const std::string& CleanupAbortsTask::LogPrefix() {
   return log_prefix_;
 }
 
+TransactionIdSet CleanupAbortsTask::ResolveStatusesInBatches() {
+  const auto max_transactions_per_request = FLAGS_max_transactions_in_status_request;
+  TransactionIdSet resolved;
+  if (!GetAtomicFlag(&FLAGS_cleanup_aborts_resolve_status_in_batches) ||
+      max_transactions_per_request <= 0) {
+    return resolved;
+  }
+
+  TransactionIdSet aborted;
+  TransactionStatusResolver resolver(
+      &participant_context_, &rpcs_, max_transactions_per_request,
+      [this, &resolved, &aborted](const std::vector<TransactionStatusInfo>& status_infos) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& info : status_infos) {
+          resolved.insert(info.transaction_id);
+          if (info.status == TransactionStatus::ABORTED) {
+            aborted.insert(info.transaction_id);
+          }
+        }
+      });
+  size_t num_added = 0;
+  for (const TransactionId& transaction_id : transactions_to_cleanup_) {
+    // Committed transactions are filtered out locally, see FilterTransactions.
+    if (status_manager_.LocalCommitTime(transaction_id).is_valid()) {
+      continue;
+    }
+    auto status_tablet = status_manager_.FindStatusTablet(transaction_id);
+    if (status_tablet) {
+      resolver.Add(*status_tablet, transaction_id);
+      ++num_added;
+    }
+  }
+  if (num_added == 0) {
+    resolver.Shutdown();
+    return resolved;
+  }
+
+  auto future = resolver.ResultFuture();
+  resolver.Start(
+      CoarseMonoClock::now() + FLAGS_cleanup_aborts_resolve_status_timeout_ms * 1ms);
+  auto status = future.get();
+  resolver.Shutdown();
+  LOG_IF_WITH_PREFIX(INFO, !status.ok())
+      << "Failed to resolve statuses of " << num_added << " transactions: " << status;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  VLOG_WITH_PREFIX(1) << "Resolved " << resolved.size() << " of " << num_added
+                      << " transactions in batches, aborted: " << aborted.size();
+  for (const auto& transaction_id : resolved) {
+    if (!aborted.count(transaction_id)) {
+      VLOG_WITH_PREFIX(2) << "Transaction not aborted, should not cleanup: " << transaction_id;
+      erased_transactions_.push_back(transaction_id);
+    }
+  }
+  return resolved;
+}
+
 void CleanupAbortsTask::FilterTransactions() {
-  size_t left_wait = transactions_to_cleanup_.size();
+  // Transactions that were not resolved in batches are checked one by one below.
+  auto resolved = ResolveStatusesInBatches();
+
+  size_t left_wait = transactions_to_cleanup_.size() - resolved.size();
   std::unique_lock<std::mutex> lock(mutex_);
 
   auto now = participant_context_.Now();
   auto tid = std::this_thread::get_id();
 
   for (const TransactionId& transaction_id : transactions_to_cleanup_) {
+    if (resolved.count(transaction_id)) {
+      continue;
+    }
     VLOG_WITH_PREFIX(1) << "Checking if transaction needs to be cleaned up: " << transaction_id;
 
     // If transaction is committed, no action required
@@ -16,6 +16,7 @@
 #include <condition_variable>
 #include <mutex>
 
+#include "yb/rpc/rpc_fwd.h"
 #include "yb/rpc/strand.h"
 
 #include "yb/common/transaction.h"
@@ -33,6 +34,7 @@ class CleanupAbortsTask : public rpc::StrandTask {
                     TransactionIdSet&& transactions_to_cleanup,
                     TransactionParticipantContext* participant_context,
                     TransactionStatusManager* status_manager,
+                    rpc::Rpcs* rpcs,
                     const std::string& log_prefix);
 
   void Prepare(std::shared_ptr<CleanupAbortsTask> cleanup_task);
@@ -44,11 +46,15 @@ class CleanupAbortsTask : public rpc::StrandTask {
  private:
   const std::string& LogPrefix();
   void FilterTransactions();
+  // Resolves statuses of transactions with known status tablet, sending one request for many
+  // transactions of the same status tablet. Returns transactions that were resolved.
+  TransactionIdSet ResolveStatusesInBatches();
 
   TransactionIntentApplier* applier_;
   TransactionIdSet transactions_to_cleanup_;
   TransactionParticipantContext& participant_context_;
   TransactionStatusManager& status_manager_;
+  rpc::Rpcs& rpcs_;
   const std::string& log_prefix_;
   std::shared_ptr<CleanupAbortsTask> retain_self_;
   std::mutex mutex_;
@@ -37,6 +37,7 @@
 
 #include "yb/tablet/maintenance_manager.h"
 #include "yb/tablet/tablet.pb.h"
+#include "yb/util/flags.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/status_log.h"
@@ -50,6 +51,11 @@ using std::vector;
 using std::string;
 using strings::Substitute;
 
+using namespace std::literals;
+
+DECLARE_double(maintenance_manager_high_io_time_fraction);
+DECLARE_bool(maintenance_manager_rank_by_benefit_per_cost);
+
 METRIC_DEFINE_entity(test);
 METRIC_DEFINE_gauge_uint32(test, maintenance_ops_running,
                            "Number of Maintenance Operations Running",
@@ -128,6 +134,9 @@ class TestMaintenanceOp : public MaintenanceOp {
 
   void Perform() override {
     DLOG(INFO) << "Performing op " << name();
+    if (perform_duration_) {
+      SleepFor(perform_duration_);
+    }
     std::lock_guard<Mutex> guard(lock_);
     CHECK_EQ(OP_RUNNING, state_);
     state_ = OP_FINISHED;
@@ -187,6 +196,11 @@ class TestMaintenanceOp : public MaintenanceOp {
     perf_improvement_ = perf_improvement;
   }
 
+  // Should be set before the op is registered.
+  void set_perform_duration(MonoDelta perform_duration) {
+    perform_duration_ = perform_duration;
+  }
+
   scoped_refptr<Histogram> DurationHistogram() const override {
     return maintenance_op_duration_;
   }
@@ -202,6 +216,7 @@ class TestMaintenanceOp : public MaintenanceOp {
   ScopedTrackedConsumption consumption_;
   uint64_t logs_retained_bytes_;
   uint64_t perf_improvement_;
+  MonoDelta perform_duration_;
   MetricRegistry metric_registry_;
   scoped_refptr<MetricEntity> metric_entity_;
   scoped_refptr<Histogram> maintenance_op_duration_;
@@ -277,6 +292,82 @@ TEST_F(MaintenanceManagerTest, TestLogRetentionPrioritization) {
   }
 }
 
+// Test that with rank by benefit per cost, a cheap op is preferred over an expensive op with a
+// higher perf improvement.
+TEST_F(MaintenanceManagerTest, TestRankByBenefitPerCost) {
+  TestMaintenanceOp fast_op("fast_op", MaintenanceOp::HIGH_IO_USAGE, OP_RUNNABLE, test_tracker_);
+  fast_op.set_ram_anchored(0);
+  fast_op.set_perf_improvement(1);
+
+  TestMaintenanceOp slow_op("slow_op", MaintenanceOp::HIGH_IO_USAGE, OP_RUNNABLE, test_tracker_);
+  slow_op.set_ram_anchored(0);
+  slow_op.set_perf_improvement(10);
+  slow_op.set_perform_duration(200ms);
+
+  // Run each op once, so that the manager measures their duration.
+  for (auto* op : { &fast_op, &slow_op }) {
+    manager_->RegisterOp(op);
+    ASSERT_TRUE(op->WaitForStateWithTimeout(OP_FINISHED, 5000));
+    manager_->UnregisterOp(op);
+  }
+
+  manager_->Shutdown();
+  fast_op.Enable();
+  slow_op.Enable();
+  manager_->RegisterOp(&fast_op);
+  manager_->RegisterOp(&slow_op);
+
+  {
+    std::lock_guard<std::mutex> lock(manager_->mutex_);
+    ASSERT_EQ(&slow_op, manager_->FindBestOp());
+  }
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_maintenance_manager_rank_by_benefit_per_cost) = true;
+  {
+    std::lock_guard<std::mutex> lock(manager_->mutex_);
+    ASSERT_EQ(&fast_op, manager_->FindBestOp());
+  }
+
+  manager_->UnregisterOp(&fast_op);
+  manager_->UnregisterOp(&slow_op);
+}
+
+// Test that after a high IO op completes, high IO ops are delayed to respect the time fraction,
+// while low IO ops still run.
+TEST_F(MaintenanceManagerTest, TestHighIOTimeFraction) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_maintenance_manager_high_io_time_fraction) = 0.1;
+
+  TestMaintenanceOp high_io_op(
+      "high_io_op", MaintenanceOp::HIGH_IO_USAGE, OP_RUNNABLE, test_tracker_);
+  high_io_op.set_ram_anchored(0);
+  high_io_op.set_perf_improvement(1);
+  high_io_op.set_perform_duration(500ms);
+  manager_->RegisterOp(&high_io_op);
+  ASSERT_TRUE(high_io_op.WaitForStateWithTimeout(OP_FINISHED, 5000));
+  manager_->UnregisterOp(&high_io_op);
+
+  // The op ran for at least 500ms, so high IO ops are delayed for at least 4.5s after it.
+  manager_->Shutdown();
+  high_io_op.Enable();
+  manager_->RegisterOp(&high_io_op);
+  {
+    std::lock_guard<std::mutex> lock(manager_->mutex_);
+    ASSERT_EQ(nullptr, manager_->FindBestOp());
+  }
+
+  TestMaintenanceOp low_io_op("low_io_op", MaintenanceOp::LOW_IO_USAGE, OP_RUNNABLE, test_tracker_);
+  low_io_op.set_ram_anchored(0);
+  low_io_op.set_logs_retained_bytes(100);
+  manager_->RegisterOp(&low_io_op);
+  {
+    std::lock_guard<std::mutex> lock(manager_->mutex_);
+    ASSERT_EQ(&low_io_op, manager_->FindBestOp());
+  }
+
+  manager_->UnregisterOp(&high_io_op);
+  manager_->UnregisterOp(&low_io_op);
+}
+
 // Test adding operations and make sure that the history of recently completed operations
 // is correct in that it wraps around and doesn't grow.
 TEST_F(MaintenanceManagerTest, TestCompletedOpsHistory) {
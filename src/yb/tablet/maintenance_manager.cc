@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -77,12 +78,32 @@ DEFINE_UNKNOWN_bool(enable_maintenance_manager, true,
        "Enable the maintenance manager, runs compaction and tablet cleaning tasks.");
 TAG_FLAG(enable_maintenance_manager, unsafe);
 
+DEFINE_RUNTIME_double(maintenance_manager_high_io_time_fraction, 1.0,
+    "Maximum fraction of the time during which high IO maintenance operations are allowed to "
+    "run. After a high IO operation completes, the next one is delayed so that the share of time "
+    "spent in high IO operations stays below this fraction. Operations that free memory under "
+    "memory pressure are not delayed. Values outside of (0, 1) mean no limit.");
+TAG_FLAG(maintenance_manager_high_io_time_fraction, advanced);
+
+DEFINE_RUNTIME_bool(maintenance_manager_rank_by_benefit_per_cost, false,
+    "Whether the maintenance manager compares the log retention freed and the performance "
+    "improvement of operations per second of their measured run time, instead of in absolute "
+    "terms.");
+TAG_FLAG(maintenance_manager_rank_by_benefit_per_cost, advanced);
+
 namespace yb {
 
 using yb::tablet::MaintenanceManagerStatusPB;
 using yb::tablet::MaintenanceManagerStatusPB_CompletedOpPB;
 using yb::tablet::MaintenanceManagerStatusPB_MaintenanceOpPB;
 
+namespace {
+
+// Weight of the latest run when updating the average duration of an op.
+constexpr double kDurationSmoothingFactor = 0.25;
+
+} // namespace
+
 MaintenanceOpStats::MaintenanceOpStats() {
   Clear();
 }
@@ -277,11 +298,16 @@ MaintenanceOp* MaintenanceManager::FindBestOp() {
   MaintenanceOp* most_mem_anchored_op = nullptr;
 
   int64_t most_logs_retained_bytes = 0;
+  double best_logs_retained_score = 0;
   uint64_t most_logs_retained_bytes_ram_anchored = 0;
   MaintenanceOp* most_logs_retained_bytes_op = nullptr;
 
   double best_perf_improvement = 0;
+  double best_perf_improvement_score = 0;
   MaintenanceOp* best_perf_improvement_op = nullptr;
+
+  const bool high_io_delayed = MonoTime::Now() < next_high_io_start_;
+  const bool rank_by_cost = FLAGS_maintenance_manager_rank_by_benefit_per_cost;
   for (OpMapTy::value_type &val : ops_) {
     MaintenanceOp* op(val.first);
     MaintenanceOpStats& stats(val.second);
@@ -301,20 +327,32 @@ MaintenanceOp* MaintenanceManager::FindBestOp() {
       most_mem_anchored_op = op;
       most_mem_anchored = stats.ram_anchored();
     }
+
+    // Past this point ops are only run when there is nothing urgent, so high IO ops respect the
+    // time budget.
+    if (high_io_delayed && op->io_usage_ == MaintenanceOp::HIGH_IO_USAGE) {
+      continue;
+    }
+
+    const double cost = rank_by_cost ? EstimatedCostSec(*op) : 1.0;
     // We prioritize ops that can free more logs, but when it's the same we pick the one that
     // also frees up the most memory.
+    const double logs_retained_score = stats.logs_retained_bytes() / cost;
     if (stats.logs_retained_bytes() > 0 &&
-        (stats.logs_retained_bytes() > most_logs_retained_bytes ||
-            (stats.logs_retained_bytes() == most_logs_retained_bytes &&
+        (logs_retained_score > best_logs_retained_score ||
+            (logs_retained_score == best_logs_retained_score &&
                 stats.ram_anchored() > most_logs_retained_bytes_ram_anchored))) {
       most_logs_retained_bytes_op = op;
       most_logs_retained_bytes = stats.logs_retained_bytes();
+      best_logs_retained_score = logs_retained_score;
       most_logs_retained_bytes_ram_anchored = stats.ram_anchored();
     }
+    const double perf_improvement_score = stats.perf_improvement() / cost;
     if ((!best_perf_improvement_op) ||
-        (stats.perf_improvement() > best_perf_improvement)) {
+        (perf_improvement_score > best_perf_improvement_score)) {
       best_perf_improvement_op = op;
       best_perf_improvement = stats.perf_improvement();
+      best_perf_improvement_score = perf_improvement_score;
     }
   }
 
@@ -368,6 +406,16 @@ MaintenanceOp* MaintenanceManager::FindBestOp() {
   return nullptr;
 }
 
+double MaintenanceManager::EstimatedCostSec(const MaintenanceOp& op) const {
+  // Ops that did not complete yet, and very short ones, cost one polling interval, so that a new
+  // op is not starved and a trivial one is not preferred without bound.
+  const double min_cost = polling_interval_ms_ / 1000.0;
+  if (!op.average_duration_.Initialized()) {
+    return min_cost;
+  }
+  return std::max(op.average_duration_.ToSeconds(), min_cost);
+}
+
 void MaintenanceManager::LaunchOp(const ScopedMaintenanceOpRun& run) {
   auto op = run.get();
   MonoTime start_time(MonoTime::Now());
@@ -389,6 +437,24 @@ void MaintenanceManager::LaunchOp(const ScopedMaintenanceOpRun& run) {
   completed_ops_count_++;
 
   op->DurationHistogram()->Increment(delta.ToMilliseconds());
+
+  if (op->average_duration_.Initialized()) {
+    op->average_duration_ = MonoDelta::FromSeconds(
+        op->average_duration_.ToSeconds() * (1 - kDurationSmoothingFactor) +
+        delta.ToSeconds() * kDurationSmoothingFactor);
+  } else {
+    op->average_duration_ = delta;
+  }
+
+  auto high_io_time_fraction = FLAGS_maintenance_manager_high_io_time_fraction;
+  if (op->io_usage_ == MaintenanceOp::HIGH_IO_USAGE && high_io_time_fraction > 0 &&
+      high_io_time_fraction < 1) {
+    // Idle for long enough that this run takes at most the allowed fraction of the time.
+    next_high_io_start_ = std::max(next_high_io_start_, end_time) +
+                          MonoDelta::FromSeconds(
+                              delta.ToSeconds() * (1 - high_io_time_fraction) /
+                              high_io_time_fraction);
+  }
 }
 
 void MaintenanceManager::GetMaintenanceManagerStatusDump(MaintenanceManagerStatusPB* out_pb) {
@@ -406,6 +472,9 @@ void MaintenanceManager::GetMaintenanceManagerStatusDump(MaintenanceManagerStatu
       op_pb->set_ram_anchored_bytes(stat.ram_anchored());
       op_pb->set_logs_retained_bytes(stat.logs_retained_bytes());
       op_pb->set_perf_improvement(stat.perf_improvement());
+      if (op->average_duration_.Initialized()) {
+        op_pb->set_average_duration_millis(op->average_duration_.ToMilliseconds());
+      }
     } else {
       op_pb->set_runnable(false);
       op_pb->set_ram_anchored_bytes(0);
@@ -216,6 +216,11 @@ class MaintenanceOp {
 
   IOUsage io_usage_;
 
+  // Exponential moving average of the time this op takes to run, as measured by the
+  // MaintenanceManager. Uninitialized until the op has completed once. Protected by the
+  // MaintenanceManager's mutex.
+  MonoDelta average_duration_;
+
   DISALLOW_COPY_AND_ASSIGN(MaintenanceOp);
 };
 
@@ -268,6 +273,8 @@ class MaintenanceManager : public std::enable_shared_from_this<MaintenanceManage
   friend class ScopedMaintenanceOpRun;
 
   FRIEND_TEST(MaintenanceManagerTest, TestLogRetentionPrioritization);
+  FRIEND_TEST(MaintenanceManagerTest, TestRankByBenefitPerCost);
+  FRIEND_TEST(MaintenanceManagerTest, TestHighIOTimeFraction);
   typedef std::map<MaintenanceOp*, MaintenanceOpStats, MaintenanceOpComparator> OpMapTy;
 
   void RunSchedulerThread();
@@ -277,6 +284,9 @@ class MaintenanceManager : public std::enable_shared_from_this<MaintenanceManage
 
   void LaunchOp(const ScopedMaintenanceOpRun& op);
 
+  // Estimated cost of running the op in seconds, based on its measured duration.
+  double EstimatedCostSec(const MaintenanceOp& op) const REQUIRES(mutex_);
+
   std::mutex mutex_;
   const int32_t num_threads_;
   const int32_t polling_interval_ms_;
@@ -292,6 +302,9 @@ class MaintenanceManager : public std::enable_shared_from_this<MaintenanceManage
   // the completed_ops_count_ % the vector's size and then the count needs to be incremented.
   std::vector<CompletedOp> completed_ops_ GUARDED_BY(mutex_);
   int64_t completed_ops_count_ GUARDED_BY(mutex_) = 0;
+  // High IO ops are not started before this time, so that they only run for
+  // maintenance_manager_high_io_time_fraction of the time.
+  MonoTime next_high_io_start_ GUARDED_BY(mutex_) = MonoTime::kMin;
 
   DISALLOW_COPY_AND_ASSIGN(MaintenanceManager);
 };
@@ -367,5 +367,41 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
 }
 
+TEST_F(MvccTest, WaitForSafeTimeForFollower) {
+  HybridTime ht1 = clock_->Now();
+  HybridTime ht2 = AddLogical(ht1, 10);
+  manager_.SetPropagatedSafeTimeOnFollower(ht1);
+
+  std::atomic<bool> t1_done(false);
+  std::thread t1([this, ht1, &t1_done] {
+    ASSERT_GE(manager_.SafeTimeForFollower(AddLogical(ht1, 5), CoarseTimePoint::max()),
+              AddLogical(ht1, 5));
+    t1_done = true;
+  });
+  std::atomic<bool> t2_done(false);
+  std::thread t2([this, ht2, &t2_done] {
+    ASSERT_GE(manager_.SafeTimeForFollower(ht2, CoarseTimePoint::max()), ht2);
+    t2_done = true;
+  });
+  std::this_thread::sleep_for(100ms);
+  ASSERT_FALSE(t1_done.load());
+  ASSERT_FALSE(t2_done.load());
+
+  manager_.SetPropagatedSafeTimeOnFollower(AddLogical(ht1, 5));
+  std::this_thread::sleep_for(100ms);
+  ASSERT_TRUE(t1_done.load());
+  ASSERT_FALSE(t2_done.load());
+
+  manager_.SetPropagatedSafeTimeOnFollower(ht2);
+  std::this_thread::sleep_for(100ms);
+  ASSERT_TRUE(t2_done.load());
+
+  t1.join();
+  t2.join();
+
+  ASSERT_FALSE(manager_.SafeTimeForFollower(
+      AddLogical(ht2, 1), CoarseMonoClock::now() + 100ms));
+}
+
 } // namespace tablet
 } // namespace yb
@@ -44,6 +44,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/trace.h"
+#include "yb/util/wait_state.h"
 
 using std::ostream;
 
@@ -274,6 +275,7 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id })) << InvariantViolationLogPrefix();
     queue_.pop_front();
     last_replicated_ = ht;
+    NotifyFollowerWaiters();
   }
   cond_.notify_all();
 }
@@ -291,6 +293,7 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id }))
         << InvariantViolationLogPrefix() << "It is allowed to abort only last operation";
     queue_.pop_back();
+    NotifyFollowerWaiters();
   }
   cond_.notify_all();
 }
@@ -417,6 +420,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
     last_replicated_ = ht;
+    NotifyFollowerWaiters();
   }
   cond_.notify_all();
 }
@@ -437,6 +441,7 @@ void MvccManager::SetPropagatedSafeTimeOnFollower(HybridTime ht) {
           << propagated_safe_time_ << ". This could happen on followers when a new leader "
           << "is elected.";
     }
+    NotifyFollowerWaiters();
   }
   cond_.notify_all();
 }
@@ -476,6 +481,7 @@ void MvccManager::UpdatePropagatedSafeTimeOnLeader(const FixedHybridTimeLease& h
         .safe_time = safe_time
       });
     }
+    NotifyFollowerWaiters();
   }
   cond_.notify_all();
 }
@@ -501,30 +507,25 @@ HybridTime MvccManager::SafeTimeForFollower(
     return DoGetSafeTime(min_allowed, deadline, FixedHybridTimeLease(), &lock);
   }
 
-  SafeTimeWithSource result;
-  auto predicate = [this, &result, min_allowed] {
-    // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
-    // could be greater than propagated_safe_time_.
-    if (propagated_safe_time_ > last_replicated_) {
-      if (queue_.empty() || propagated_safe_time_ < queue_.front().hybrid_time) {
-        result.safe_time = propagated_safe_time_;
-        result.source = SafeTimeSource::kPropagated;
-      } else {
-        result.safe_time = queue_.front().hybrid_time.Decremented();
-        result.source = SafeTimeSource::kNextInQueue;
-      }
+  auto result = DoGetSafeTimeForFollower();
+  if (result.safe_time < min_allowed) {
+    SCOPED_WAIT_STATUS(kSafeTimeWait);
+    std::condition_variable cond;
+    auto waiter_it = follower_waiters_.emplace(min_allowed, &cond);
+    auto predicate = [this, &result, min_allowed] {
+      result = DoGetSafeTimeForFollower();
+      return result.safe_time >= min_allowed;
+    };
+    bool reached = true;
+    if (deadline == CoarseTimePoint::max()) {
+      cond.wait(lock, predicate);
     } else {
-      result.safe_time = last_replicated_;
-      result.source = SafeTimeSource::kLastReplicated;
+      reached = cond.wait_until(lock, deadline, predicate);
+    }
+    follower_waiters_.erase(waiter_it);
+    if (!reached) {
+      return HybridTime::kInvalid;
     }
-    VTRACE(3, "Current safe time $0. Source $1", yb::ToString(result.safe_time),
-           yb::ToString(result.source));
-    return result.safe_time >= min_allowed;
-  };
-  if (deadline == CoarseTimePoint::max()) {
-    cond_.wait(lock, predicate);
-  } else if (!cond_.wait_until(lock, deadline, predicate)) {
-    return HybridTime::kInvalid;
   }
   VLOG_WITH_PREFIX(1) << "SafeTimeForFollower(" << min_allowed
                       << "), result = " << result.ToString();
@@ -547,6 +548,38 @@ HybridTime MvccManager::SafeTimeForFollower(
   return result.safe_time;
 }
 
+SafeTimeWithSource MvccManager::DoGetSafeTimeForFollower() const {
+  SafeTimeWithSource result;
+  // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
+  // could be greater than propagated_safe_time_.
+  if (propagated_safe_time_ > last_replicated_) {
+    if (queue_.empty() || propagated_safe_time_ < queue_.front().hybrid_time) {
+      result.safe_time = propagated_safe_time_;
+      result.source = SafeTimeSource::kPropagated;
+    } else {
+      result.safe_time = queue_.front().hybrid_time.Decremented();
+      result.source = SafeTimeSource::kNextInQueue;
+    }
+  } else {
+    result.safe_time = last_replicated_;
+    result.source = SafeTimeSource::kLastReplicated;
+  }
+  VTRACE(3, "Current safe time $0. Source $1", yb::ToString(result.safe_time),
+         yb::ToString(result.source));
+  return result;
+}
+
+void MvccManager::NotifyFollowerWaiters() {
+  if (follower_waiters_.empty()) {
+    return;
+  }
+  auto safe_time = DoGetSafeTimeForFollower().safe_time;
+  for (auto it = follower_waiters_.begin();
+       it != follower_waiters_.end() && it->first <= safe_time; ++it) {
+    it->second->notify_one();
+  }
+}
+
 // NO_THREAD_SAFETY_ANALYSIS because this analysis does not work with unique_lock.
 HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
@@ -615,6 +648,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
   // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
+  SCOPED_WAIT_STATUS(kSafeTimeWait);
   if (deadline == CoarseTimePoint::max()) {
     cond_.wait(*lock, predicate);
   } else if (!cond_.wait_until(*lock, deadline, predicate)) {
@@ -33,6 +33,7 @@
 
 #include <condition_variable>
 #include <deque>
+#include <map>
 #include <vector>
 
 #include "yb/gutil/thread_annotations.h"
@@ -156,6 +157,11 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const REQUIRES(mutex_);
 
+  SafeTimeWithSource DoGetSafeTimeForFollower() const REQUIRES(mutex_);
+
+  // Wakes up the waiters of SafeTimeForFollower whose safe time has been reached.
+  void NotifyFollowerWaiters() REQUIRES(mutex_);
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -211,6 +217,10 @@ class MvccManager {
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
+  // Waiters of SafeTimeForFollower keyed by the safe time they wait for, so that a change only
+  // wakes up the reads it unblocks.
+  mutable std::multimap<HybridTime, std::condition_variable*> follower_waiters_ GUARDED_BY(mutex_);
+
   std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
 };
 
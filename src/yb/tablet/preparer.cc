@@ -41,6 +41,12 @@ DEFINE_UNKNOWN_uint64(max_group_replicate_batch_size, 16,
 DEFINE_UNKNOWN_double(estimated_replicate_msg_size_percentage, 0.95,
               "The estimated percentage of replicate message size in a log entry batch.");
 
+DEFINE_RUNTIME_int32(preparer_max_batch_wait_us, 0,
+    "Maximum time in microseconds the preparer waits for more leader-side operations, when its "
+    "queue becomes empty while the current batch is not full. Allows small concurrent writes to "
+    "share a single Raft round at the cost of extra latency. 0 to replicate immediately.");
+TAG_FLAG(preparer_max_batch_wait_us, advanced);
+
 DEFINE_test_flag(int32, preparer_batch_inject_latency_ms, 0,
                  "Inject latency before replicating batch.");
 
@@ -109,6 +115,12 @@ class PreparerImpl {
   std::mutex stop_mtx_;
   std::condition_variable stop_cond_;
 
+  // Used by WaitForMoreLeaderSideItems to sleep until a new leader-side operation is submitted.
+  // Submit only signals the condition when waiting_for_items_ is set.
+  std::atomic<bool> waiting_for_items_{false};
+  std::mutex items_mtx_;
+  std::condition_variable items_cond_;
+
   OperationDrivers leader_side_batch_;
   size_t leader_side_batch_size_estimate_ = 0;
   const size_t leader_side_batch_size_limit_;
@@ -122,6 +134,13 @@ class PreparerImpl {
   void Run();
   void ProcessItem(OperationDriver* item);
 
+  // Processes operations that arrive within preparer_max_batch_wait_us while the current batch is
+  // not empty and not yet sent to replication.
+  void WaitForMoreLeaderSideItems();
+
+  // Wakes up WaitForMoreLeaderSideItems if it is waiting.
+  void NotifyItemsWaiter();
+
   void ProcessAndClearLeaderSideBatch();
 
   void ProcessFailedItem(OperationDriver* item, Status status);
@@ -157,6 +176,7 @@ void PreparerImpl::Stop() {
     return;
   }
   stop_requested_ = true;
+  NotifyItemsWaiter();
   {
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     stop_cond_.wait(stop_lock, [this] {
@@ -182,8 +202,10 @@ Status PreparerImpl::Submit(OperationDriver* operation_driver) {
   if (leader_side) {
     // Prepare leader-side operations on the "preparer thread" so we can only acquire the
     // ReplicaState lock once and append multiple operations.
-    active_tasks_.fetch_add(1, std::memory_order_release);
+    // Sequentially consistent, paired with waiting_for_items_ in WaitForMoreLeaderSideItems.
+    active_tasks_.fetch_add(1);
     queue_.Push(operation_driver);
+    NotifyItemsWaiter();
   } else {
     // For follower-side operations, there would be no benefit in preparing them on the preparer
     // thread.
@@ -208,6 +230,7 @@ void PreparerImpl::Run() {
       active_tasks_.fetch_sub(1, std::memory_order_release);
       ProcessItem(item);
     }
+    WaitForMoreLeaderSideItems();
     ProcessAndClearLeaderSideBatch();
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     running_.store(false, std::memory_order_release);
@@ -298,6 +321,42 @@ void PreparerImpl::ProcessItem(OperationDriver* item) {
   }
 }
 
+void PreparerImpl::WaitForMoreLeaderSideItems() {
+  const auto wait_us = FLAGS_preparer_max_batch_wait_us;
+  if (wait_us <= 0 || leader_side_batch_.empty()) {
+    return;
+  }
+  const auto deadline = std::chrono::steady_clock::now() + wait_us * 1us;
+  waiting_for_items_ = true;
+  // ProcessItem sends the batch to replication when it is full, so we stop waiting in that case.
+  while (!leader_side_batch_.empty() && !stop_requested_.load(std::memory_order_acquire)) {
+    if (OperationDriver* item = queue_.Pop()) {
+      active_tasks_.fetch_sub(1, std::memory_order_release);
+      ProcessItem(item);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(items_mtx_);
+    // active_tasks_ is incremented before the operation is pushed to the queue, so it could be
+    // positive while Pop still returns nullptr. In this case we just try Pop again.
+    if (!items_cond_.wait_until(lock, deadline, [this] {
+          return active_tasks_.load() != 0 || stop_requested_.load(std::memory_order_acquire);
+        })) {
+      break;
+    }
+  }
+  waiting_for_items_ = false;
+}
+
+void PreparerImpl::NotifyItemsWaiter() {
+  if (!waiting_for_items_.load()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(items_mtx_);
+  }
+  items_cond_.notify_one();
+}
+
 void PreparerImpl::ProcessFailedItem(OperationDriver* item, Status status) {
   DCHECK_EQ(leader_side_batch_.size(), 0);
   Status s = item->PrepareAndStart();
@@ -28,6 +28,7 @@
 
 #include "yb/tablet/transaction_intent_applier.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/transaction_participant_context.h"
 
 #include "yb/util/delayer.h"
 #include "yb/util/math_util.h"
@@ -86,6 +87,10 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  void StrandEnqueue(rpc::StrandTask* task) {
+    participant_context_.StrandEnqueue(task);
+  }
+
  protected:
   friend class RunningTransaction;
 
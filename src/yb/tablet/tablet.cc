@@ -152,6 +152,11 @@ DEFINE_UNKNOWN_int32(intents_flush_max_delay_ms, 2000,
              "Max time to wait for regular db to flush during flush of intents. "
              "After this time flush of regular db will be forced.");
 
+DEFINE_RUNTIME_bool(coordinate_regular_and_intents_db_flush, false,
+    "Follow a flush of regular RocksDB of a tablet with a flush of its intents RocksDB, when "
+    "the oldest entry of intents db is more than num_raft_ops_to_force_idle_intents_db_to_flush "
+    "operations behind the flushed frontier of regular db, so the log it retains is released.");
+
 DEFINE_UNKNOWN_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
              "When writes to intents RocksDB are stopped and the number of Raft operations after "
              "the last write to the intents RocksDB "
@@ -239,6 +244,12 @@ DEFINE_test_flag(bool, pause_before_full_compaction, false,
 DEFINE_test_flag(bool, disable_adding_user_frontier_to_sst, false,
                  "Prevents adding the UserFrontier to SST file in order to mimic older files.");
 
+DEFINE_RUNTIME_bool(enable_post_split_full_compaction, true,
+    "Whether a tablet created by a split runs a full compaction as soon as it starts, to drop the "
+    "data that belongs to the other child. When disabled, that data is dropped by regular "
+    "compactions, and the tablet is considered compacted once none of its SST files have keys "
+    "outside of its key bounds. Until then the tablet can't be split again or moved.");
+
 DEFINE_test_flag(bool, skip_post_split_compaction, false,
                  "Skip processing post split compaction.");
 
@@ -349,6 +360,17 @@ rocksdb::UserFrontierPtr MemTableFrontierFromDb(
 }
 
 
+// Returns true if some SST file of 'db' has keys outside of 'key_bounds'.
+bool HasFilesOutOfKeyBounds(rocksdb::DB* db, const docdb::KeyBounds& key_bounds) {
+  for (const auto& file : db->GetLiveFilesMetaData()) {
+    if (!key_bounds.IsWithinBounds(file.smallest.key) ||
+        !key_bounds.IsWithinBounds(file.largest.key)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Result<HybridTime> CheckSafeTime(HybridTime time, HybridTime min_allowed) {
   if (time) {
     return time;
@@ -364,6 +386,12 @@ class Tablet::RegularRocksDbListener : public rocksdb::EventListener {
       : tablet_(*CHECK_NOTNULL(tablet)),
         log_prefix_(log_prefix) {}
 
+  void OnFlushCompleted(rocksdb::DB*, const rocksdb::FlushJobInfo&) override {
+    if (FLAGS_coordinate_regular_and_intents_db_flush) {
+      tablet_.FlushIntentsDbAfterRegularFlush();
+    }
+  }
+
   void OnCompactionCompleted(rocksdb::DB* db, const rocksdb::CompactionJobInfo& ci) override {
     auto& metadata = *CHECK_NOTNULL(tablet_.metadata());
     if (ci.is_full_compaction) {
@@ -374,6 +402,13 @@ class Tablet::RegularRocksDbListener : public rocksdb::EventListener {
         metadata.set_has_been_fully_compacted(true);
       }
       ERROR_NOT_OK(metadata.Flush(), log_prefix_);
+    } else if (!metadata.has_been_fully_compacted() && tablet_.key_bounds_.IsInitialized() &&
+               !HasFilesOutOfKeyBounds(db, tablet_.key_bounds_)) {
+      // Regular compactions drop keys outside of the key bounds, so after a split they could have
+      // already removed all the data of the other child.
+      LOG(INFO) << log_prefix_ << "No post split data left after compaction";
+      metadata.set_has_been_fully_compacted(true);
+      ERROR_NOT_OK(metadata.Flush(), log_prefix_);
     }
 
     MinSchemaVersionMap table_id_to_min_schema_version;
@@ -1219,6 +1254,8 @@ Status Tablet::ApplyRowOperations(
             << put_batch.ShortDebugString();
     metrics_->rows_inserted->IncrementBy(put_batch.write_pairs().size());
   }
+  ScopedThreadCpuTimeTracker cpu_time_tracker(
+      metrics_ ? metrics_->write_apply_cpu_time.get() : nullptr);
 
   return ApplyOperation(
       *operation, write_request.batch_idx(), put_batch, already_applied_to_regular_db);
@@ -1944,6 +1981,12 @@ HybridTime Tablet::ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadl
   return mvcc_.SafeTimeForFollower(min_allowed, deadline);
 }
 
+void Tablet::TransactionResolved(const TransactionId& id, const TransactionStatusResult& result) {
+  if (wait_queue_) {
+    wait_queue_->SignalResolved(id, result);
+  }
+}
+
 Result<std::unique_ptr<docdb::YQLRowwiseIteratorIf>> Tablet::CreateCDCSnapshotIterator(
     const Schema& projection, const ReadHybridTime& time, const string& next_key) {
   VLOG_WITH_PREFIX(2) << "The nextKey is " << next_key;
@@ -3145,6 +3188,40 @@ void Tablet::FlushIntentsDbIfNecessary(const yb::OpId& lastest_log_entry_op_id)
   }
 }
 
+void Tablet::FlushIntentsDbAfterRegularFlush() {
+  auto scoped_read_operation = CreateNonAbortableScopedRWOperation();
+  if (!scoped_read_operation.ok() || !intents_db_) {
+    return;
+  }
+
+  // A pending flush of intents db means that this regular db flush was forced by it, and it will
+  // proceed on its own.
+  if (intents_db_->GetFlushAbility() != rocksdb::FlushAbility::kHasNewData) {
+    return;
+  }
+
+  auto regular_flushed_frontier = regular_db_->GetFlushedFrontier();
+  auto intents_frontier =
+      MemTableFrontierFromDb(intents_db_.get(), rocksdb::UpdateUserValueType::kSmallest);
+  if (!regular_flushed_frontier || !intents_frontier) {
+    return;
+  }
+
+  // Log GC is bounded by the oldest unflushed entry of both DBs. Flush intents db when it lags
+  // behind the just flushed regular db, so the log can be released up to the regular db frontier.
+  auto index_delta =
+      static_cast<const docdb::ConsensusFrontier&>(*regular_flushed_frontier).op_id().index -
+      down_cast<docdb::ConsensusFrontier*>(intents_frontier.get())->op_id().index;
+  if (index_delta <= FLAGS_num_raft_ops_to_force_idle_intents_db_to_flush) {
+    return;
+  }
+
+  VLOG_WITH_PREFIX(2) << "Flushing intents DB after regular DB flush, lag: " << index_delta;
+  rocksdb::FlushOptions options;
+  options.wait = false;
+  WARN_NOT_OK(intents_db_->Flush(options), "Flush intents db failed");
+}
+
 bool Tablet::IsTransactionalRequest(bool is_ysql_request) const {
   // We consider all YSQL tables within the sys catalog transactional.
   return txns_enabled_ && (
@@ -3192,6 +3269,20 @@ Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
   return result;
 }
 
+Result<size_t> Tablet::MutableMemtablesSize() const {
+  auto scoped_read_operation = CreateNonAbortableScopedRWOperation();
+  RETURN_NOT_OK(scoped_read_operation);
+
+  size_t result = 0;
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    uint64_t size = 0;
+    if (db && db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+      result += size;
+    }
+  }
+  return result;
+}
+
 const yb::SchemaPtr Tablet::schema() const {
   return metadata_->schema();
 }
@@ -3344,6 +3435,24 @@ Status Tablet::ForceFullRocksDBCompact(rocksdb::CompactionReason compaction_reas
   return Status::OK();
 }
 
+Status Tablet::SaveBlockCacheWarmupState(const rocksdb::BlockCacheKeys& cache_keys) {
+  auto scoped_operation = CreateAbortableScopedRWOperation();
+  RETURN_NOT_OK(scoped_operation);
+  if (!regular_db_) {
+    return Status::OK();
+  }
+  return regular_db_->SaveBlockCacheWarmupState(cache_keys);
+}
+
+Result<size_t> Tablet::WarmUpBlockCache() {
+  auto scoped_operation = CreateAbortableScopedRWOperation();
+  RETURN_NOT_OK(scoped_operation);
+  if (!regular_db_) {
+    return 0;
+  }
+  return regular_db_->WarmUpBlockCache();
+}
+
 std::string Tablet::TEST_DocDBDumpStr(IncludeIntents include_intents) {
   if (!regular_db_) return "";
 
@@ -3774,6 +3883,10 @@ void Tablet::TriggerPostSplitCompactionIfNeeded() {
   if (!StillHasOrphanedPostSplitDataAbortable()) {
     return;
   }
+  if (!FLAGS_enable_post_split_full_compaction) {
+    VLOG_WITH_PREFIX(1) << "Post split data will be dropped by regular compactions";
+    return;
+  }
   auto status = TriggerFullCompactionIfNeeded(rocksdb::CompactionReason::kPostSplitCompaction);
   if (status.ok()) {
     ts_post_split_compaction_added_->Increment();
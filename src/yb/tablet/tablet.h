@@ -512,6 +512,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
 
+  // Returns the approximate size of the mutable memtables in intents and regular db-s.
+  Result<size_t> MutableMemtablesSize() const;
+
   // For non-kudu table type fills key-value batch in transaction state request and updates
   // request in state. Due to acquiring locks it can block the thread.
   void AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteQuery> query);
@@ -576,6 +579,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   Status ForceFullRocksDBCompact(rocksdb::CompactionReason compaction_reason,
       docdb::SkipFlush skip_flush = docdb::SkipFlush::kFalse);
 
+  // Saves the list of data blocks of the regular DB that are in the block cache, so they could be
+  // loaded back by WarmUpBlockCache after a restart.
+  Status SaveBlockCacheWarmupState(const rocksdb::BlockCacheKeys& cache_keys);
+
+  // Loads the data blocks saved by SaveBlockCacheWarmupState into the block cache. Returns the
+  // number of blocks loaded.
+  Result<size_t> WarmUpBlockCache();
+
   docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
 
   // Returns approximate middle key for tablet split:
@@ -672,6 +683,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Flushed intents db if necessary.
   void FlushIntentsDbIfNecessary(const yb::OpId& lastest_log_entry_op_id);
 
+  // Flushes intents db if it holds log entries older than the flushed frontier of regular db.
+  void FlushIntentsDbAfterRegularFlush();
+
   bool is_sys_catalog() const { return is_sys_catalog_; }
   bool IsTransactionalRequest(bool is_ysql_request) const override;
 
@@ -1031,6 +1045,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
     CleanupIntentFiles();
   }
 
+  void TransactionResolved(
+      const TransactionId& id, const TransactionStatusResult& result) override;
+
   template <class F>
   auto GetRegularDbStat(const F& func, const decltype(func())& default_value) const;
 
@@ -57,6 +57,7 @@
 
 DECLARE_bool(skip_flushed_entries);
 DECLARE_int32(retryable_request_timeout_secs);
+DECLARE_bool(tablet_bootstrap_read_ahead_segments);
 
 using std::shared_ptr;
 using std::string;
@@ -494,6 +495,36 @@ TEST_F(BootstrapTest, TestConsensusOnlyOperationOutOfOrderHybridTime) {
   ASSERT_EQ(1, results.size());
 }
 
+// Tests that entries of every segment are replayed in order when the next segment is read ahead.
+TEST_F(BootstrapTest, TestBootstrapReadAheadSegments) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_bootstrap_read_ahead_segments) = true;
+  constexpr int kNumSegments = 5;
+  BuildLog();
+
+  for (int i = 1; i <= kNumSegments; ++i) {
+    const auto opid = MakeOpId(1, i);
+    AppendReplicateBatch(opid, opid, {TupleForAppend(i, i, "insert")}, AppendSync::kTrue);
+    if (i != kNumSegments) {
+      ASSERT_OK(RollLog());
+    }
+  }
+
+  ConsensusBootstrapInfo boot_info;
+  TabletPtr tablet;
+  ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+  ASSERT_OPID_EQ(MakeOpId(1, kNumSegments), boot_info.last_id);
+  ASSERT_OPID_EQ(MakeOpId(1, kNumSegments), boot_info.last_committed_id);
+
+  vector<string> results;
+  IterateTabletRows(tablet.get(), &results);
+  ASSERT_EQ(kNumSegments, results.size());
+  std::sort(results.begin(), results.end());
+  for (int i = 1; i <= kNumSegments; ++i) {
+    ASSERT_EQ(Format("{ int32_value: $0 int32_value: $0 string_value: \"insert\" }", i),
+              results[i - 1]);
+  }
+}
+
 // Test that we don't overflow opids. Regression test for KUDU-1933.
 TEST_F(BootstrapTest, TestBootstrapHighOpIdIndex) {
   // Start appending with a log index 3 under the int32 max value.
@@ -100,6 +100,7 @@
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/threadpool.h"
 
 DEFINE_UNKNOWN_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
@@ -128,6 +129,11 @@ DEFINE_UNKNOWN_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_RUNTIME_bool(tablet_bootstrap_read_ahead_segments, true,
+    "Read and decode the next WAL segment in the background while the entries of the current "
+    "segment are replayed. Up to two segments worth of entries are kept in memory.");
+TAG_FLAG(tablet_bootstrap_read_ahead_segments, advanced);
+
 DEFINE_UNKNOWN_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
               "The segment size for transaction status tablet log roll-overs, in bytes.");
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
@@ -1323,10 +1329,36 @@ class TabletBootstrap {
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
+    // Read result of the segment following the one being replayed, if it is read ahead.
+    log::ReadEntriesResult next_read_result;
+    bool next_read_submitted = false;
+    // Single thread that reads the next segment. Declared after next_read_result, so it is shut
+    // down, waiting for the running read, before the result is destroyed.
+    std::unique_ptr<ThreadPool> read_ahead_pool;
+    if (FLAGS_tablet_bootstrap_read_ahead_segments && iter != segments.end() &&
+        std::next(iter) != segments.end()) {
+      RETURN_NOT_OK(ThreadPoolBuilder("bootstrap-read-ahead")
+                        .set_max_threads(1)
+                        .Build(&read_ahead_pool));
+    }
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      log::ReadEntriesResult read_result;
+      if (next_read_submitted) {
+        read_ahead_pool->Wait();
+        read_result = std::move(next_read_result);
+        next_read_submitted = false;
+      } else {
+        read_result = segment->ReadEntries();
+      }
+      auto next_iter = std::next(iter);
+      if (read_ahead_pool && read_result.status.ok() && next_iter != segments.end()) {
+        next_read_submitted = read_ahead_pool->SubmitFunc(
+            [&next_read_result, next_segment = *next_iter] {
+          next_read_result = next_segment->ReadEntries();
+        }).ok();
+      }
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
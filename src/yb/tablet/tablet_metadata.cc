@@ -1350,6 +1350,17 @@ Status RaftGroupMetadata::OldSchemaGC(
   return Flush();
 }
 
+bool RaftGroupMetadata::HasOldSchemaVersions() const {
+  std::lock_guard<MutexType> lock(data_mutex_);
+  for (const auto& [table_id, table_info] : kv_store_.tables) {
+    if (table_info->doc_read_context->schema_packing_storage.HasVersionBelow(
+            table_info->schema_version)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 Result<docdb::CompactionSchemaInfo> RaftGroupMetadata::CotablePacking(
     const Uuid& cotable_id, uint32_t schema_version, HybridTime history_cutoff) {
   if (cotable_id.IsNil()) {
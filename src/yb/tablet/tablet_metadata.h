@@ -550,6 +550,10 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata>,
   // versions is a map from table id to min schema version that should be kept for this table.
   Status OldSchemaGC(const std::unordered_map<Uuid, SchemaVersion, UuidHash>& versions);
 
+  // Returns true if any table of this tablet still keeps the packing of a schema version older
+  // than its current one, i.e. tablet data could contain rows written with an older schema.
+  bool HasOldSchemaVersions() const;
+
   Result<docdb::CompactionSchemaInfo> CotablePacking(
       const Uuid& cotable_id, uint32_t schema_version, HybridTime history_cutoff) override;
 
@@ -31,8 +31,17 @@
 //
 #include "yb/tablet/tablet_metrics.h"
 
+#include "yb/gutil/walltime.h"
+
+#include "yb/util/flags.h"
 #include "yb/util/metrics.h"
 
+DEFINE_RUNTIME_bool(tablet_track_cpu_time, false,
+    "Whether to measure the thread CPU time spent on reads and on applying writes of each "
+    "tablet, reported by the read_cpu_time and write_apply_cpu_time metrics. Adds two "
+    "clock_gettime calls to every read and write apply.");
+TAG_FLAG(tablet_track_cpu_time, advanced);
+
 // Tablet-specific metrics.
 METRIC_DEFINE_counter(tablet, rows_inserted, "Rows Inserted",
     yb::MetricUnit::kRows,
@@ -48,21 +57,21 @@ METRIC_DEFINE_counter(tablet, insertions_failed_dup_key, "Duplicate Key Inserts"
                       yb::MetricUnit::kRows,
                       "Number of inserts which failed because the key already existed");
 
-METRIC_DEFINE_coarse_histogram(table, ql_write_latency, "Write latency at tserver layer",
+METRIC_DEFINE_sharded_coarse_histogram(table, ql_write_latency, "Write latency at tserver layer",
   yb::MetricUnit::kMicroseconds,
   "Time taken to handle a batch of writes at tserver layer");
 
-METRIC_DEFINE_coarse_histogram(table, snapshot_read_inflight_wait_duration,
+METRIC_DEFINE_sharded_coarse_histogram(table, snapshot_read_inflight_wait_duration,
   "Time Waiting For Snapshot Reads",
   yb::MetricUnit::kMicroseconds,
   "Time spent waiting for in-flight writes to complete for READ_AT_SNAPSHOT scans.");
 
-METRIC_DEFINE_coarse_histogram(
+METRIC_DEFINE_sharded_coarse_histogram(
     table, ql_read_latency, "Handle ReadRequest latency at tserver layer",
     yb::MetricUnit::kMicroseconds,
     "Time taken to handle the read request at the tserver layer.");
 
-METRIC_DEFINE_coarse_histogram(
+METRIC_DEFINE_sharded_coarse_histogram(
     table, write_lock_latency, "Write lock latency", yb::MetricUnit::kMicroseconds,
     "Time taken to acquire key locks for a write operation");
 
@@ -126,6 +135,16 @@ METRIC_DEFINE_counter(tablet, tablet_data_corruptions,
   yb::MetricUnit::kUnits,
   "Number of times this tablet was flagged for corrupted data");
 
+METRIC_DEFINE_counter(tablet, read_cpu_time,
+  "Read CPU Time",
+  yb::MetricUnit::kMicroseconds,
+  "Thread CPU time spent on handling read requests of this tablet");
+
+METRIC_DEFINE_counter(tablet, write_apply_cpu_time,
+  "Write Apply CPU Time",
+  yb::MetricUnit::kMicroseconds,
+  "Thread CPU time spent on applying writes of this tablet to RocksDB");
+
 using strings::Substitute;
 
 namespace yb {
@@ -147,7 +166,9 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, consistent_prefix_read_requests),
     MINIT(tablet_entity, pgsql_consistent_prefix_read_rows),
     MINIT(tablet_entity, tablet_data_corruptions),
-    MINIT(tablet_entity, rows_inserted) {
+    MINIT(tablet_entity, rows_inserted),
+    MINIT(tablet_entity, read_cpu_time),
+    MINIT(tablet_entity, write_apply_cpu_time) {
 }
 #undef MINIT
 
@@ -157,5 +178,18 @@ ScopedTabletMetricsTracker::ScopedTabletMetricsTracker(scoped_refptr<Histogram>
 ScopedTabletMetricsTracker::~ScopedTabletMetricsTracker() {
   latency_->Increment(MonoTime::Now().GetDeltaSince(start_time_).ToMicroseconds());
 }
+
+ScopedThreadCpuTimeTracker::ScopedThreadCpuTimeTracker(Counter* cpu_time)
+    : cpu_time_(cpu_time && FLAGS_tablet_track_cpu_time ? cpu_time : nullptr) {
+  if (cpu_time_) {
+    start_micros_ = GetThreadCpuTimeMicros();
+  }
+}
+
+ScopedThreadCpuTimeTracker::~ScopedThreadCpuTimeTracker() {
+  if (cpu_time_) {
+    cpu_time_->IncrementBy(GetThreadCpuTimeMicros() - start_micros_);
+  }
+}
 } // namespace tablet
 } // namespace yb
@@ -70,6 +70,11 @@ struct TabletMetrics {
   scoped_refptr<Counter> tablet_data_corruptions;
 
   scoped_refptr<Counter> rows_inserted;
+
+  // Thread CPU time spent on reads and on applying writes, used to attribute CPU usage to tables
+  // and namespaces through the table_id and namespace_name attributes of the tablet entity.
+  scoped_refptr<Counter> read_cpu_time;
+  scoped_refptr<Counter> write_apply_cpu_time;
 };
 
 class ScopedTabletMetricsTracker {
@@ -82,5 +87,19 @@ class ScopedTabletMetricsTracker {
   MonoTime start_time_;
 };
 
+// Adds the CPU time used by the current thread during the lifetime of the object to the counter.
+// Does nothing when the counter is null or --tablet_track_cpu_time is not set.
+class ScopedThreadCpuTimeTracker {
+ public:
+  explicit ScopedThreadCpuTimeTracker(Counter* cpu_time);
+  ~ScopedThreadCpuTimeTracker();
+
+ private:
+  Counter* cpu_time_;
+  int64_t start_micros_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedThreadCpuTimeTracker);
+};
+
 } // namespace tablet
 } // namespace yb
@@ -15,6 +15,7 @@
 
 #include <future>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "yb/util/env.h"
@@ -36,6 +37,7 @@ class Cache;
 class EventListener;
 class MemoryMonitor;
 class Env;
+class SstFileManager;
 
 struct RocksDBPriorityThreadPoolMetrics;
 }
@@ -57,6 +59,10 @@ struct TabletOptions {
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
   std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
+  std::shared_ptr<rocksdb::Cache> table_cache;
+  // Managers of obsolete SST file deletion, one per data root, keyed by the disk group number of
+  // the data root, i.e. by the hash of its path.
+  std::unordered_map<uint64_t, std::shared_ptr<rocksdb::SstFileManager>> sst_file_managers;
   std::shared_ptr<rocksdb::RocksDBPriorityThreadPoolMetrics> priority_thread_pool_metrics;
 };
 
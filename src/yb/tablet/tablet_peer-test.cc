@@ -81,6 +81,7 @@ DECLARE_uint64(initial_log_segment_size_bytes);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_uint64(log_segment_size_bytes);
 DECLARE_uint64(max_group_replicate_batch_size);
+DECLARE_int32(preparer_max_batch_wait_us);
 DECLARE_int32(protobuf_message_total_bytes_limit);
 DECLARE_uint64(rpc_max_message_size);
 
@@ -465,6 +466,66 @@ TEST_F(TabletPeerTest, TestGCEmptyLog) {
   ASSERT_OK(tablet_peer_->RunLogGC());
 }
 
+// Small concurrent writes should share Raft rounds when preparer is allowed to wait for them.
+TEST_F(TabletPeerTest, PreparerBatchWait) {
+  constexpr auto kNumOps = 10;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_preparer_max_batch_wait_us) = 100000;
+
+  ConsensusBootstrapInfo info;
+  ASSERT_OK(StartPeer(info));
+
+  std::vector<WriteResponsePB> responses(kNumOps);
+  CountDownLatch latch(kNumOps);
+  auto* const tablet_peer = tablet_peer_.get();
+
+  for (int i = 0; i < kNumOps; ++i) {
+    auto* resp = &responses[i];
+    WriteRequestPB req;
+    req.set_tablet_id(tablet()->tablet_id());
+    AddTestRowInsert(i, i, "value", &req);
+    auto query = std::make_unique<WriteQuery>(
+        /* leader_term = */ 1, CoarseTimePoint::max(), tablet_peer, tablet(), nullptr, resp);
+    query->set_client_request(req);
+    query->set_callback([&latch, resp](const Status& status) {
+      if (!status.ok()) {
+        StatusToPB(status, resp->mutable_error()->mutable_status());
+      }
+      latch.CountDown();
+    });
+    tablet_peer->WriteAsync(std::move(query));
+  }
+  latch.Wait();
+
+  for (size_t i = 0; i < responses.size(); ++i) {
+    ASSERT_FALSE(responses[i].has_error()) << "Response[" << i << "]: "
+                                           << responses[i].DebugString();
+  }
+
+  ASSERT_OK(RollLog(tablet_peer));
+
+  log::SegmentSequence segments;
+  ASSERT_OK(tablet_peer->log()->GetLogReader()->GetSegmentsSnapshot(&segments));
+
+  size_t max_batch_size = 0;
+  for (auto& segment : segments) {
+    auto entries = segment->ReadEntries();
+    ASSERT_OK(entries.status);
+
+    size_t current_batch_size = 0;
+    int64_t current_batch_offset = 0;
+    for (const auto& meta : entries.entry_metadata) {
+      if (meta.offset == current_batch_offset) {
+        ++current_batch_size;
+      } else {
+        current_batch_offset = meta.offset;
+        current_batch_size = 1;
+      }
+      max_batch_size = std::max(max_batch_size, current_batch_size);
+    }
+  }
+  ASSERT_GT(max_batch_size, 1U);
+}
+
 class TabletPeerProtofBufSizeLimitTest : public TabletPeerTest {
  public:
   TabletPeerProtofBufSizeLimitTest() : TabletPeerTest(GetSimpleTestSchema()) {
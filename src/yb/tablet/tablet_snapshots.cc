@@ -13,6 +13,8 @@
 
 #include "yb/tablet/tablet_snapshots.h"
 
+#include <unordered_set>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 #include "yb/common/index.h"
@@ -39,6 +41,7 @@
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/operation_counter.h"
+#include "yb/util/pb_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -51,6 +54,11 @@ DEFINE_test_flag(int32, delay_tablet_split_metadata_restore_secs, 0,
                  "How much time in secs to delay restoring tablet split metadata after restoring "
                  "checkpoint.");
 
+DEFINE_RUNTIME_bool(pitr_skip_unchanged_tablets, false,
+    "When restoring a snapshot schedule to a point in time, leave the RocksDB of a tablet "
+    "untouched if it has no data written after the restore time.");
+TAG_FLAG(pitr_skip_unchanged_tablets, advanced);
+
 namespace yb {
 namespace tablet {
 
@@ -63,6 +71,32 @@ std::string TabletMetadataFile(const std::string& dir) {
   return JoinPathSegments(dir, kTabletMetadataFile);
 }
 
+const std::string kSnapshotFilesFile = "snapshot.files";
+
+std::string SnapshotFilesFile(const std::string& dir) {
+  return JoinPathSegments(dir, kSnapshotFilesFile);
+}
+
+Status ListSnapshotFiles(
+    Env* env, const std::string& dir, const std::string& prefix,
+    google::protobuf::RepeatedPtrField<FilePB>* out) {
+  auto files = VERIFY_RESULT_PREPEND(
+      env->GetChildren(dir, ExcludeDots::kTrue), Format("Unable to list directory $0", dir));
+  for (const auto& file : files) {
+    const auto path = JoinPathSegments(dir, file);
+    const auto name = prefix.empty() ? file : JoinPathSegments(prefix, file);
+    if (VERIFY_RESULT(env->IsDirectory(path))) {
+      RETURN_NOT_OK(ListSnapshotFiles(env, path, name, out));
+      continue;
+    }
+    auto& file_pb = *out->Add();
+    file_pb.set_name(name);
+    file_pb.set_size_bytes(VERIFY_RESULT(env->GetFileSize(path)));
+    file_pb.set_inode(VERIFY_RESULT(env->GetFileINode(path)));
+  }
+  return Status::OK();
+}
+
 } // namespace
 
 struct TabletSnapshots::RestoreMetadata {
@@ -188,6 +222,10 @@ Status TabletSnapshots::Create(const CreateSnapshotData& data) {
 
   RETURN_NOT_OK(tablet().metadata()->SaveTo(TabletMetadataFile(tmp_snapshot_dir)));
 
+  if (data.schedule_id) {
+    RETURN_NOT_OK(WriteSnapshotFiles(data, tmp_snapshot_dir));
+  }
+
   RETURN_NOT_OK_PREPEND(
       env->RenameFile(tmp_snapshot_dir, snapshot_dir),
       Format("Cannot rename temp snapshot dir $0 to $1", tmp_snapshot_dir, snapshot_dir));
@@ -210,6 +248,56 @@ Env& TabletSnapshots::env() {
   return *metadata().fs_manager()->env();
 }
 
+Status TabletSnapshots::WriteSnapshotFiles(
+    const CreateSnapshotData& data, const std::string& dir) {
+  auto& env = this->env();
+  SnapshotFilesPB snapshot_files;
+  snapshot_files.set_schedule_id(data.schedule_id.data(), data.schedule_id.size());
+  snapshot_files.set_hybrid_time(data.hybrid_time.ToUint64());
+  RETURN_NOT_OK(ListSnapshotFiles(&env, dir, std::string(), snapshot_files.mutable_files()));
+
+  // The base is the latest earlier snapshot of the same schedule that is still on this tablet.
+  // Its files are hard links, so a file shared with it has the same inode.
+  const auto top_snapshots_dir = DirName(data.snapshot_dir);
+  SnapshotFilesPB base;
+  for (const auto& child : VERIFY_RESULT(env.GetChildren(top_snapshots_dir, ExcludeDots::kTrue))) {
+    const auto path = SnapshotFilesFile(JoinPathSegments(top_snapshots_dir, child));
+    if (IsTempSnapshotDir(child) || !env.FileExists(path)) {
+      continue;
+    }
+    SnapshotFilesPB candidate;
+    auto status = pb_util::ReadPBContainerFromPath(&env, path, &candidate);
+    if (!status.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Unable to read " << path << ": " << status;
+      continue;
+    }
+    if (candidate.schedule_id() != snapshot_files.schedule_id() ||
+        candidate.hybrid_time() >= snapshot_files.hybrid_time() ||
+        (snapshot_files.has_base_snapshot() && candidate.hybrid_time() <= base.hybrid_time())) {
+      continue;
+    }
+    snapshot_files.set_base_snapshot(child);
+    base = std::move(candidate);
+  }
+
+  std::unordered_set<uint64_t> base_inodes;
+  for (const auto& file : base.files()) {
+    base_inodes.insert(file.inode());
+  }
+  for (const auto& file : snapshot_files.files()) {
+    if (!base_inodes.count(file.inode())) {
+      snapshot_files.add_new_files(file.name());
+    }
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Snapshot in " << data.snapshot_dir << " has "
+                        << snapshot_files.new_files_size() << " new files out of "
+                        << snapshot_files.files_size() << ", base snapshot: "
+                        << snapshot_files.base_snapshot();
+  return pb_util::WritePBContainerToPath(
+      &env, SnapshotFilesFile(dir), snapshot_files, pb_util::OVERWRITE, pb_util::SYNC);
+}
+
 Status TabletSnapshots::CleanupSnapshotDir(const std::string& dir) {
   auto& env = this->env();
   if (!env.FileExists(dir)) {
@@ -340,6 +428,16 @@ Status TabletSnapshots::RestoreCheckpoint(
 
   const auto destroy = !dir.empty();
 
+  if (dir.empty() && restore_at && GetAtomicFlag(&FLAGS_pitr_skip_unchanged_tablets) &&
+      !HasRegularDataAfter(restore_at)) {
+    // Nothing in this tablet was written after restore_at, so the hybrid time filter would not
+    // hide anything. Keep RocksDB open instead of shutting it down, patching and reopening it.
+    LOG_WITH_PREFIX(INFO) << "No data after " << restore_at << ", skipping RocksDB restore";
+    RETURN_NOT_OK(ApplyRestoreMetadata(dir, restore_metadata, is_pitr_restore));
+    // Record that the restore operation was executed, so that it won't get replayed if we crash.
+    return tablet().ModifyFlushedFrontier(frontier, rocksdb::FrontierModificationMode::kUpdate);
+  }
+
   // The following two lines can't just be changed to RETURN_NOT_OK(PauseReadWriteOperations()):
   // op_pause has to stay in scope until the end of the function.
   auto op_pauses = VERIFY_RESULT(StartShutdownRocksDBs(DisableFlushOnShutdown(destroy)));
@@ -364,9 +462,10 @@ Status TabletSnapshots::RestoreCheckpoint(
       LOG_WITH_PREFIX(WARNING) << "Copy checkpoint files status: " << s;
       return STATUS(IllegalState, "Unable to copy checkpoint files", s.ToString());
     }
-    auto tablet_metadata_file = TabletMetadataFile(db_dir);
-    if (env().FileExists(tablet_metadata_file)) {
-      RETURN_NOT_OK(env().DeleteFile(tablet_metadata_file));
+    for (const auto& file : {TabletMetadataFile(db_dir), SnapshotFilesFile(db_dir)}) {
+      if (env().FileExists(file)) {
+        RETURN_NOT_OK(env().DeleteFile(file));
+      }
     }
   }
 
@@ -382,6 +481,37 @@ Status TabletSnapshots::RestoreCheckpoint(
     }
   }
 
+  RETURN_NOT_OK(ApplyRestoreMetadata(dir, restore_metadata, is_pitr_restore));
+
+  // Reopen database from copied checkpoint.
+  // Note: db_dir == metadata()->rocksdb_dir() is still valid db dir.
+  auto s = OpenRocksDBs();
+  if (PREDICT_FALSE(!s.ok())) {
+    LOG_WITH_PREFIX(WARNING) << "Failed tablet db opening from checkpoint: " << s;
+    return s;
+  }
+
+  LOG_WITH_PREFIX(INFO) << "Checkpoint restored from " << dir;
+  LOG_WITH_PREFIX(INFO) << "Re-enabling compactions";
+  s = tablet().EnableCompactions(&op_pauses.non_abortable);
+  if (!s.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to enable compactions after restoring a checkpoint";
+    return s;
+  }
+
+  // Schedule post split compaction after compaction enabled on the tablet.
+  tablet().TriggerPostSplitCompactionIfNeeded();
+
+  // Ensure that op_pauses stays in scope throughout this function.
+  for (auto* op_pause : op_pauses.AsArray()) {
+    DFATAL_OR_RETURN_NOT_OK(op_pause->status());
+  }
+
+  return Status::OK();
+}
+
+Status TabletSnapshots::ApplyRestoreMetadata(
+    const std::string& dir, const RestoreMetadata& restore_metadata, bool is_pitr_restore) {
   bool need_flush = false;
 
   if (restore_metadata.schema) {
@@ -422,31 +552,23 @@ Status TabletSnapshots::RestoreCheckpoint(
     RefreshYBMetaDataCache();
   }
 
-  // Reopen database from copied checkpoint.
-  // Note: db_dir == metadata()->rocksdb_dir() is still valid db dir.
-  auto s = OpenRocksDBs();
-  if (PREDICT_FALSE(!s.ok())) {
-    LOG_WITH_PREFIX(WARNING) << "Failed tablet db opening from checkpoint: " << s;
-    return s;
-  }
+  return Status::OK();
+}
 
-  LOG_WITH_PREFIX(INFO) << "Checkpoint restored from " << dir;
-  LOG_WITH_PREFIX(INFO) << "Re-enabling compactions";
-  s = tablet().EnableCompactions(&op_pauses.non_abortable);
-  if (!s.ok()) {
-    LOG_WITH_PREFIX(WARNING) << "Failed to enable compactions after restoring a checkpoint";
-    return s;
+bool TabletSnapshots::HasRegularDataAfter(HybridTime hybrid_time) {
+  auto is_after = [hybrid_time](const rocksdb::UserFrontierPtr& frontier) {
+    return frontier &&
+           down_cast<docdb::ConsensusFrontier&>(*frontier).hybrid_time() > hybrid_time;
+  };
+  if (is_after(regular_db().CalcMemTableFrontier(rocksdb::UpdateUserValueType::kLargest))) {
+    return true;
   }
-
-  // Schedule post split compaction after compaction enabled on the tablet.
-  tablet().TriggerPostSplitCompactionIfNeeded();
-
-  // Ensure that op_pauses stays in scope throughout this function.
-  for (auto* op_pause : op_pauses.AsArray()) {
-    DFATAL_OR_RETURN_NOT_OK(op_pause->status());
+  for (const auto& file : regular_db().GetLiveFilesMetaData()) {
+    if (is_after(file.largest.user_frontier)) {
+      return true;
+    }
   }
-
-  return Status::OK();
+  return false;
 }
 
 Result<std::string> TabletSnapshots::RestoreToTemporary(
@@ -104,12 +104,23 @@ class TabletSnapshots : public TabletComponent {
       const std::string& dir, HybridTime restore_at, const RestoreMetadata& metadata,
       const docdb::ConsensusFrontier& frontier, bool is_pitr_restore);
 
+  // Updates the tablet metadata for a restore. dir is the snapshot directory, empty for a restore
+  // of a snapshot schedule to a point in time.
+  Status ApplyRestoreMetadata(
+      const std::string& dir, const RestoreMetadata& metadata, bool is_pitr_restore);
+
+  // Whether the regular DB has records written after hybrid_time.
+  bool HasRegularDataAfter(HybridTime hybrid_time);
+
   // Applies specified snapshot operation.
   Status Apply(SnapshotOperation* operation);
 
   Status CleanupSnapshotDir(const std::string& dir);
   Env& env();
 
+  // Writes the SnapshotFilesPB of a snapshot of a schedule, that is being created in dir.
+  Status WriteSnapshotFiles(const CreateSnapshotData& data, const std::string& dir);
+
   Status RestorePartialRows(SnapshotOperation* operation);
 
   Result<TabletRestorePatch> GenerateRestoreWriteBatch(
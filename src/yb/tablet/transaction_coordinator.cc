@@ -251,6 +251,12 @@ class TransactionState {
     return false;
   }
 
+  // Whether this transaction was committed or sealed, and is handled by Poll until its intents are
+  // applied in all involved tablets.
+  bool Applying() const {
+    return status_ == TransactionStatus::COMMITTED || status_ == TransactionStatus::SEALED;
+  }
+
   // Whether this transaction has completed.
   bool Completed() const {
     return status_ == TransactionStatus::ABORTED ||
@@ -482,6 +488,7 @@ class TransactionState {
   }
 
   // now_physical is just optimization to avoid querying the current time multiple times.
+  // Should only be called for applying transactions, see Applying.
   void Poll(bool leader, MonoTime now_physical) {
     if (status_ != TransactionStatus::COMMITTED &&
         (status_ != TransactionStatus::SEALED || tablets_with_not_replicated_batches_ != 0)) {
@@ -1425,6 +1432,7 @@ class TransactionCoordinator::Impl : public TransactionStateContext,
  private:
   class LastTouchTag;
   class FirstEntryIndexTag;
+  class ApplyingTag;
 
   typedef boost::multi_index_container<TransactionState,
       boost::multi_index::indexed_by <
@@ -1444,6 +1452,14 @@ class TransactionCoordinator::Impl : public TransactionStateContext,
               boost::multi_index::const_mem_fun<TransactionState,
                                                 int64_t,
                                                 &TransactionState::first_entry_raft_index>
+          >,
+          // Only applying transactions need work in Poll, so they are found without going over
+          // all active transactions.
+          boost::multi_index::ordered_non_unique <
+              boost::multi_index::tag<ApplyingTag>,
+              boost::multi_index::const_mem_fun<TransactionState,
+                                                bool,
+                                                &TransactionState::Applying>
           >
       >
   > ManagedTransactions;
@@ -1686,12 +1702,18 @@ class TransactionCoordinator::Impl : public TransactionStateContext,
         }
       }
       auto now_physical = MonoTime::Now();
-      for (auto& transaction : managed_transactions_) {
-        const_cast<TransactionState&>(transaction).Poll(leader, now_physical);
+      // Poll does not change the status of the transaction, so the index stays valid.
+      auto& applying_index = managed_transactions_.get<ApplyingTag>();
+      for (auto it = applying_index.lower_bound(true); it != applying_index.end(); ++it) {
+        const_cast<TransactionState&>(*it).Poll(leader, now_physical);
       }
       postponed_leader_actions_.Swap(&actions);
     }
     ExecutePostponedLeaderActions(&actions);
+
+    if (leader && ANNOTATE_UNPROTECTED_READ(FLAGS_enable_deadlock_detection)) {
+      deadlock_detector_.TriggerProbesForNewWaiters();
+    }
   }
 
   void CheckCompleted(ManagedTransactions::iterator it) {
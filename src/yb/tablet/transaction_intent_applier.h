@@ -46,6 +46,11 @@ class TransactionIntentApplier {
   // See TransactionParticipant::WaitMinRunningHybridTime below
   virtual void MinRunningHybridTimeSatisfied() = 0;
 
+  // Invoked when the participant learns that the transaction was committed or aborted, so that
+  // operations blocked on it could be resumed without waiting for the next status poll.
+  virtual void TransactionResolved(
+      const TransactionId& id, const TransactionStatusResult& result) = 0;
+
  protected:
   ~TransactionIntentApplier() {}
 };
@@ -617,7 +617,7 @@ class TransactionParticipant::Impl
     }
 
     auto cleanup_aborts_task = std::make_shared<CleanupAbortsTask>(
-        &applier_, std::move(set), &participant_context_, status_manager, LogPrefix());
+        &applier_, std::move(set), &participant_context_, status_manager, &rpcs_, LogPrefix());
     cleanup_aborts_task->Prepare(cleanup_aborts_task);
     participant_context_.StrandEnqueue(cleanup_aborts_task.get());
   }
@@ -682,6 +682,9 @@ class TransactionParticipant::Impl
     }
 
     NotifyApplied(data);
+    applier_.TransactionResolved(
+        data.transaction_id,
+        TransactionStatusResult(TransactionStatus::COMMITTED, data.commit_ht, data.aborted));
     return Status::OK();
   }
 
@@ -1545,6 +1548,8 @@ class TransactionParticipant::Impl
         .status_tablet = std::string()
     };
     WARN_NOT_OK(ProcessCleanup(data, cleanup_type), "Process cleanup failed");
+    // Cleanup is sent by the coordinator for aborted transactions only.
+    applier_.TransactionResolved(*id, TransactionStatusResult::Aborted());
     operation->CompleteWithStatus(Status::OK());
   }
 
@@ -11,6 +11,8 @@
 // under the License.
 //
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include <boost/algorithm/string.hpp>
@@ -33,6 +35,8 @@
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/doc_read_context.h"
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/master/master_client.pb.h"
 #include "yb/master/master_util.h"
 
@@ -102,6 +106,10 @@ DEFINE_UNKNOWN_int32(bulk_load_max_background_flushes, 2,
 DEFINE_UNKNOWN_uint64(bulk_load_num_files_per_tablet, 5,
               "Determines how to compact the data of a tablet to ensure we have only a certain "
               "number of sst files per tablet");
+DEFINE_NON_RUNTIME_int32(bulk_load_num_concurrent_tablets, 1,
+    "Number of tablets to keep open at the same time. While the files of a tablet are flushed, "
+    "compacted and exported, the rows of the next tablets are loaded. Each open tablet has its "
+    "own rocksdb with up to bulk_load_num_memtables memtables of memtable_size_bytes.");
 
 DECLARE_string(skipped_cols);
 
@@ -142,23 +150,44 @@ class CompactionTask: public Runnable {
   BulkLoadDocDBUtil *const db_fixture_;
 };
 
+// A tablet whose files are being generated.
+struct TabletLoad {
+  TabletId tablet_id;
+  unique_ptr<BulkLoadDocDBUtil> db_fixture;
+  // Groups the tasks of this tablet in the shared thread pool, so that they can be waited for
+  // without waiting for the tasks of other tablets.
+  unique_ptr<ThreadPoolToken> token;
+};
+
 class BulkLoad {
  public:
+  ~BulkLoad();
+
   Status RunBulkLoad();
 
  private:
   Status InitYBBulkLoad();
   Status InitDBUtil(const TabletId &tablet_id);
-  Status FinishTabletProcessing(const TabletId &tablet_id,
-                                vector<pair<TabletId, string>> rows);
+  // Submits the remaining rows of the current tablet and finishes the tablet in the background.
+  Status FinishTabletAsync(vector<pair<TabletId, string>> rows);
+  Status FinishTabletProcessing(TabletLoad* tablet);
+  // Waits until fewer than bulk_load_num_concurrent_tablets tablets are being finished.
+  Status WaitForTabletSlot();
   Status RetryableSubmit(vector<pair<TabletId, string>> rows);
-  Status CompactFiles();
+  Status CompactFiles(TabletLoad* tablet);
 
   std::unique_ptr<YBClient> client_;
   shared_ptr<YBTable> table_;
   unique_ptr<YBPartitionGenerator> partition_generator_;
   std::unique_ptr<ThreadPool> thread_pool_;
-  unique_ptr<BulkLoadDocDBUtil> db_fixture_;
+  // Runs FinishTabletProcessing, one thread per concurrent tablet.
+  std::unique_ptr<ThreadPool> finish_pool_;
+  shared_ptr<TabletLoad> current_tablet_;
+
+  std::mutex mutex_;
+  std::condition_variable finished_cond_;
+  int num_finishing_tablets_ GUARDED_BY(mutex_) = 0;
+  Status finish_status_ GUARDED_BY(mutex_);
 };
 
 CompactionTask::CompactionTask(const vector<string>& sst_filenames, BulkLoadDocDBUtil* db_fixture)
@@ -343,11 +372,12 @@ Status BulkLoadTask::InsertRow(const string &row,
 
 Status BulkLoad::RetryableSubmit(vector<pair<TabletId, string>> rows) {
   auto runnable = std::make_shared<BulkLoadTask>(
-      std::move(rows), db_fixture_.get(), table_.get(), partition_generator_.get());
+      std::move(rows), current_tablet_->db_fixture.get(), table_.get(),
+      partition_generator_.get());
 
   Status s;
   do {
-    s = thread_pool_->Submit(runnable);
+    s = current_tablet_->token->Submit(runnable);
 
     if (!s.IsServiceUnavailable()) {
       return s;
@@ -362,9 +392,10 @@ Status BulkLoad::RetryableSubmit(vector<pair<TabletId, string>> rows) {
   return Status::OK();
 }
 
-Status BulkLoad::CompactFiles() {
+Status BulkLoad::CompactFiles(TabletLoad* tablet) {
+  auto* db_fixture = tablet->db_fixture.get();
   std::vector<rocksdb::LiveFileMetaData> live_files_metadata;
-  db_fixture_->rocksdb()->GetLiveFilesMetaData(&live_files_metadata);
+  db_fixture->rocksdb()->GetLiveFilesMetaData(&live_files_metadata);
   if (live_files_metadata.empty()) {
     return STATUS(IllegalState, "Need atleast one sst file");
   }
@@ -390,38 +421,86 @@ Status BulkLoad::CompactFiles() {
       auto end_iter = (i == FLAGS_bulk_load_num_files_per_tablet - 1) ? sst_files.end()
                                                                       : start_iter + batch_size;
       auto runnable = std::make_shared<CompactionTask>(vector<string>(start_iter, end_iter),
-                                                       db_fixture_.get());
-      RETURN_NOT_OK(thread_pool_->Submit(runnable));
+                                                       db_fixture);
+      RETURN_NOT_OK(tablet->token->Submit(runnable));
       start_iter = end_iter;
     }
 
     // Finally wait for all compactions to finish.
-    thread_pool_->Wait();
+    tablet->token->Wait();
 
     // Reopen rocksdb to clean up deleted files.
-    return db_fixture_->ReopenRocksDB();
+    return db_fixture->ReopenRocksDB();
   }
   return Status::OK();
 }
 
-Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
-                                        vector<pair<TabletId, string>> rows) {
-  if (!db_fixture_) {
-    // Skip processing since db_fixture wasn't initialized indicating empty input.
+BulkLoad::~BulkLoad() {
+  // Tablet finishing tasks use the other members, so the running ones should complete before any
+  // member is destroyed, even when RunBulkLoad returned early with an error. Tablet tokens should
+  // be destroyed before thread_pool_.
+  if (finish_pool_) {
+    finish_pool_->Shutdown();
+  }
+  current_tablet_.reset();
+  if (thread_pool_) {
+    thread_pool_->Shutdown();
+  }
+}
+
+Status BulkLoad::FinishTabletAsync(vector<pair<TabletId, string>> rows) {
+  if (!current_tablet_) {
+    // Skip processing since no tablet was started indicating empty input.
     return Status::OK();
   }
 
   // Submit all the work.
   RETURN_NOT_OK(RetryableSubmit(std::move(rows)));
 
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_finishing_tablets_;
+  }
+  auto tablet = std::move(current_tablet_);
+  auto s = finish_pool_->SubmitFunc([this, tablet] {
+    auto status = FinishTabletProcessing(tablet.get());
+    LOG_IF(ERROR, !status.ok()) << "Failed to finish tablet " << tablet->tablet_id << ": "
+                                << status;
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_finishing_tablets_;
+    if (finish_status_.ok()) {
+      finish_status_ = status;
+    }
+    finished_cond_.notify_all();
+  });
+  if (!s.ok()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_finishing_tablets_;
+  }
+  return s;
+}
+
+Status BulkLoad::WaitForTabletSlot() {
+  const auto max_tablets = std::max(FLAGS_bulk_load_num_concurrent_tablets, 1);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (num_finishing_tablets_ >= max_tablets && finish_status_.ok()) {
+    finished_cond_.wait(lock);
+  }
+  return finish_status_;
+}
+
+Status BulkLoad::FinishTabletProcessing(TabletLoad* tablet) {
+  const auto& tablet_id = tablet->tablet_id;
+  auto* db_fixture = tablet->db_fixture.get();
+
   // Wait for all tasks for the tablet to complete.
-  thread_pool_->Wait();
+  tablet->token->Wait();
 
   // Now flush the DB.
-  RETURN_NOT_OK(db_fixture_->FlushRocksDbAndWait());
+  RETURN_NOT_OK(db_fixture->FlushRocksDbAndWait());
 
   // Perform the necessary compactions.
-  RETURN_NOT_OK(CompactFiles());
+  RETURN_NOT_OK(CompactFiles(tablet));
 
   if (!FLAGS_export_files) {
     return Status::OK();
@@ -443,7 +522,7 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
 
   // Invoke the bulk_load_helper script.
   vector<string> argv = {FLAGS_bulk_load_helper_script, "-t", tablet_id, "-r", csv_replicas, "-i",
-      FLAGS_ssh_key_file, "-d", db_fixture_->rocksdb_dir()};
+      FLAGS_ssh_key_file, "-d", db_fixture->rocksdb_dir()};
   string bulk_load_helper_stdout;
   RETURN_NOT_OK(Subprocess::Call(argv, &bulk_load_helper_stdout));
 
@@ -488,17 +567,23 @@ Status BulkLoad::FinishTabletProcessing(const TabletId &tablet_id,
   }
 
   // Delete the data once the import is done.
-  return yb::Env::Default()->DeleteRecursively(db_fixture_->rocksdb_dir());
+  return yb::Env::Default()->DeleteRecursively(db_fixture->rocksdb_dir());
 }
 
 
 Status BulkLoad::InitDBUtil(const TabletId &tablet_id) {
-  db_fixture_.reset(new BulkLoadDocDBUtil(tablet_id, FLAGS_base_dir,
-                                          FLAGS_memtable_size_bytes,
-                                          FLAGS_bulk_load_num_memtables,
-                                          FLAGS_bulk_load_max_background_flushes));
-  RETURN_NOT_OK(db_fixture_->InitRocksDBOptions());
-  RETURN_NOT_OK(db_fixture_->DisableCompactions()); // This opens rocksdb.
+  RETURN_NOT_OK(WaitForTabletSlot());
+
+  auto tablet = std::make_shared<TabletLoad>();
+  tablet->tablet_id = tablet_id;
+  tablet->db_fixture.reset(new BulkLoadDocDBUtil(tablet_id, FLAGS_base_dir,
+                                                 FLAGS_memtable_size_bytes,
+                                                 FLAGS_bulk_load_num_memtables,
+                                                 FLAGS_bulk_load_max_background_flushes));
+  RETURN_NOT_OK(tablet->db_fixture->InitRocksDBOptions());
+  RETURN_NOT_OK(tablet->db_fixture->DisableCompactions()); // This opens rocksdb.
+  tablet->token = thread_pool_->NewToken(ThreadPool::ExecutionMode::CONCURRENT);
+  current_tablet_ = std::move(tablet);
   return Status::OK();
 }
 
@@ -516,7 +601,7 @@ Status BulkLoad::InitYBBulkLoad() {
   partition_generator_.reset(new YBPartitionGenerator(table_name, {FLAGS_master_addresses}));
   RETURN_NOT_OK(partition_generator_->Init());
 
-  db_fixture_ = nullptr;
+  current_tablet_ = nullptr;
   CHECK_OK(
       ThreadPoolBuilder("bulk_load_tasks")
           .set_min_threads(FLAGS_bulk_load_num_threads)
@@ -524,6 +609,10 @@ Status BulkLoad::InitYBBulkLoad() {
           .set_max_queue_size(FLAGS_bulk_load_threadpool_queue_size)
           .set_idle_timeout(MonoDelta::FromMilliseconds(5000))
           .Build(&thread_pool_));
+  CHECK_OK(
+      ThreadPoolBuilder("bulk_load_finish")
+          .set_max_threads(std::max(FLAGS_bulk_load_num_concurrent_tablets, 1))
+          .Build(&finish_pool_));
   return Status::OK();
 }
 
@@ -550,7 +639,7 @@ Status BulkLoad::RunBulkLoad() {
     // Reinitialize rocksdb if needed.
     if (current_tablet_id.empty() || current_tablet_id != tablet_id) {
       // Flush all of the data before opening a new rocksdb.
-      RETURN_NOT_OK(FinishTabletProcessing(current_tablet_id, std::move(rows)));
+      RETURN_NOT_OK(FinishTabletAsync(std::move(rows)));
       RETURN_NOT_OK(InitDBUtil(tablet_id));
     }
     current_tablet_id = tablet_id;
@@ -563,8 +652,11 @@ Status BulkLoad::RunBulkLoad() {
   }
 
   // Process last tablet.
-  RETURN_NOT_OK(FinishTabletProcessing(current_tablet_id, std::move(rows)));
-  return Status::OK();
+  RETURN_NOT_OK(FinishTabletAsync(std::move(rows)));
+  finish_pool_->Wait();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finish_status_;
 }
 
 } // anonymous namespace
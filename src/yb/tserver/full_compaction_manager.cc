@@ -15,12 +15,15 @@
 
 #include "yb/tserver/full_compaction_manager.h"
 
+#include <algorithm>
+#include <unordered_set>
 #include <utility>
 
 #include "yb/common/hybrid_time.h"
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/tablet_server.h"
@@ -50,6 +53,26 @@ DEFINE_RUNTIME_int32(scheduled_full_compaction_jitter_factor_percentage,
               "computed when scheduling a compaction, between 0 and (frequency * jitter factor) "
               "hours.");
 
+DEFINE_RUNTIME_int32(scheduled_full_compaction_old_schema_frequency_hours, 0,
+              "Minimum time between full compactions scheduled on tablets whose data could still "
+              "contain rows written with an older schema version. Such compactions repack rows "
+              "into the latest schema packing and remove deleted columns, regardless of "
+              "scheduled_full_compaction_frequency_hours. 0 indicates the feature is disabled.");
+TAG_FLAG(scheduled_full_compaction_old_schema_frequency_hours, advanced);
+
+DEFINE_RUNTIME_int32(scheduled_full_compaction_max_per_check, 0,
+              "Maximum number of scheduled full compactions started by one check. Tablets that "
+              "are due at the same time are then compacted over several checks, oldest first, "
+              "instead of being queued at once. 0 indicates no limit.");
+TAG_FLAG(scheduled_full_compaction_max_per_check, advanced);
+
+DEFINE_RUNTIME_int32(scheduled_full_compaction_max_foreground_ops_per_sec, 0,
+              "Scheduled full compactions are not started while the rate of reads and writes "
+              "served by the tablets of this tserver since the previous check is above this "
+              "value. Compactions that are due wait for a check with lower load. 0 indicates "
+              "that load is not checked.");
+TAG_FLAG(scheduled_full_compaction_max_foreground_ops_per_sec, advanced);
+
 namespace yb {
 namespace tserver {
 
@@ -66,16 +89,35 @@ void FullCompactionManager::ScheduleFullCompactions() {
 }
 
 void FullCompactionManager::DoScheduleFullCompactions() {
-  // If compaction_frequency_ is 0, feature is disabled.
-  if (compaction_frequency_ == MonoDelta::kZero) {
+  // If both compaction frequencies are 0, feature is disabled.
+  if (compaction_frequency_ == MonoDelta::kZero &&
+      old_schema_compaction_frequency_ == MonoDelta::kZero) {
     num_scheduled_last_execution_.store(0);
     return;
   }
 
+  const auto foreground_ops_per_sec = MeasureForegroundOpsPerSec();
+  const auto max_foreground_ops_per_sec =
+      ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_max_foreground_ops_per_sec);
+  if (max_foreground_ops_per_sec > 0 && foreground_ops_per_sec > max_foreground_ops_per_sec) {
+    YB_LOG_EVERY_N_SECS(INFO, 300) << "Deferring scheduled full compactions: "
+        << foreground_ops_per_sec << " foreground ops/sec is above "
+        << max_foreground_ops_per_sec;
+    num_scheduled_last_execution_.store(0);
+    return;
+  }
+
+  const auto max_per_check =
+      ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_max_per_check);
   int num_scheduled = 0;
   PeerNextCompactList peers_to_compact = GetPeersEligibleForCompaction();
 
   for (auto itr = peers_to_compact.begin(); itr != peers_to_compact.end(); itr++) {
+    if (max_per_check > 0 && num_scheduled >= max_per_check) {
+      // The remaining tablets keep their next compaction times and are picked up, oldest first,
+      // by the following checks.
+      break;
+    }
     const auto peer = itr->second;
     const auto tablet = peer->shared_tablet();
     if (!tablet) {
@@ -112,7 +154,9 @@ PeerNextCompactList FullCompactionManager::GetPeersEligibleForCompaction() {
 
     // If the next compaction time is pre-calculated, use that. Otherwise, calculate
     // a new one.
-    const HybridTime next_compact_time = DetermineNextCompactTime(peer, now);
+    HybridTime next_compact_time = compaction_frequency_ == MonoDelta::kZero
+        ? HybridTime::kMax : DetermineNextCompactTime(peer, now);
+    next_compact_time = std::min(next_compact_time, DetermineOldSchemaCompactTime(peer, now));
 
     // If the tablet is ready to compact, then add it to the list.
     if (next_compact_time <= now) {
@@ -122,12 +166,46 @@ PeerNextCompactList FullCompactionManager::GetPeersEligibleForCompaction() {
   return compact_list;
 }
 
+double FullCompactionManager::MeasureForegroundOpsPerSec() {
+  uint64_t foreground_ops = 0;
+  // Tablets of the same table can share their metrics, so each histogram is only counted once.
+  std::unordered_set<const Histogram*> counted;
+  for (const auto& peer : ts_tablet_manager_->GetTabletPeers()) {
+    const auto tablet = peer->shared_tablet();
+    if (!tablet || !tablet->metrics()) {
+      continue;
+    }
+    const auto* metrics = tablet->metrics();
+    for (const auto* histogram : {metrics->ql_read_latency.get(),
+                                  metrics->ql_write_latency.get()}) {
+      if (counted.insert(histogram).second) {
+        foreground_ops += histogram->TotalCount();
+      }
+    }
+  }
+
+  const auto now = CoarseMonoClock::Now();
+  double result = 0;
+  // Tablets that moved away take their counts with them, so the total can go down.
+  if (last_load_check_time_ != CoarseTimePoint() && foreground_ops >= last_foreground_ops_) {
+    const auto elapsed = MonoDelta(now - last_load_check_time_);
+    if (elapsed > MonoDelta::kZero) {
+      result = (foreground_ops - last_foreground_ops_) / elapsed.ToSeconds();
+    }
+  }
+  last_foreground_ops_ = foreground_ops;
+  last_load_check_time_ = now;
+  return result;
+}
+
 void FullCompactionManager::SetFrequencyAndJitterFromFlags() {
   const auto compaction_frequency = MonoDelta::FromHours(
       ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_frequency_hours));
   const auto jitter_factor =
       ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_jitter_factor_percentage);
   ResetFrequencyAndJitterIfNeeded(compaction_frequency, jitter_factor);
+  old_schema_compaction_frequency_ = MonoDelta::FromHours(
+      ANNOTATE_UNPROTECTED_READ(FLAGS_scheduled_full_compaction_old_schema_frequency_hours));
 }
 
 void FullCompactionManager::ResetFrequencyAndJitterIfNeeded(
@@ -168,6 +246,20 @@ HybridTime FullCompactionManager::DetermineNextCompactTime(TabletPeerPtr peer, H
   return next_compact_iter->second;
 }
 
+HybridTime FullCompactionManager::DetermineOldSchemaCompactTime(
+    TabletPeerPtr peer, HybridTime now) const {
+  if (old_schema_compaction_frequency_ == MonoDelta::kZero ||
+      !peer->tablet_metadata()->HasOldSchemaVersions()) {
+    return HybridTime::kMax;
+  }
+  // Old schema packings are only released once no data uses them, so rows above the history
+  // cutoff can keep them alive after a compaction. The frequency limits how often such tablets
+  // are compacted again.
+  const HybridTime last_compact_time(peer->tablet_metadata()->last_full_compaction_time());
+  return last_compact_time.is_special()
+      ? now : last_compact_time.AddDelta(old_schema_compaction_frequency_);
+}
+
 HybridTime FullCompactionManager::CalculateNextCompactTime(
     const TabletId& tablet_id,
     const HybridTime now,
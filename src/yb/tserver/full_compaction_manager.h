@@ -68,6 +68,7 @@ class FullCompactionManager {
  private:
   FRIEND_TEST(TsTabletManagerTest, FullCompactionCalculateNextCompaction);
   FRIEND_TEST(TsTabletManagerTest, CompactionsEvenlySpreadByJitter);
+  FRIEND_TEST(TsTabletManagerTest, FullCompactionOfOldSchemaVersions);
 
   // Iterates through all tablets owned by the tablet manager, scheduling full compactions
   // on any tablets that are eligible for full compaction. When a new compaction is scheduled,
@@ -75,6 +76,10 @@ class FullCompactionManager {
   // (next_compact_time_per_tablet_).
   void DoScheduleFullCompactions();
 
+  // Returns the rate of reads and writes served by all tablets of this tserver since the
+  // previous call, or 0 on the first call.
+  double MeasureForegroundOpsPerSec();
+
   // Iterates through all peers, determining the next compaction time for each peer
   // eligible for scheduled full compactions. Returns a list of peers that are currently
   // ready for compaction, ordered by how recently they were last compacted (oldest first).
@@ -86,6 +91,11 @@ class FullCompactionManager {
   // and stored in the in-memory map.
   HybridTime DetermineNextCompactTime(tablet::TabletPeerPtr peer, HybridTime now);
 
+  // Returns the time at which a tablet that could still contain rows written with an older
+  // schema version should be compacted, so rows are repacked into the latest schema packing.
+  // Returns HybridTime::kMax if the tablet has no such rows or the feature is disabled.
+  HybridTime DetermineOldSchemaCompactTime(tablet::TabletPeerPtr peer, HybridTime now) const;
+
   // Calculates the next compaction time based on the last compaction time and jitter.
   // If the tablet has no last compaction time, then a compaction will be scheduled
   // soon as a function of (now + jitter). Otherwise, the next compaction time will
@@ -123,9 +133,17 @@ class FullCompactionManager {
   // Maximum amount of jitter that modifies the expected compaction time.
   MonoDelta max_jitter_;
 
+  // Minimum amount of time between full compactions of tablets with old schema versions.
+  MonoDelta old_schema_compaction_frequency_;
+
   // In-memory map of pre-calculated next compaction times per tablet.
   std::unordered_map<TabletId, HybridTime> next_compact_time_per_tablet_;
 
+  // Total number of reads and writes served by all tablets, and the time it was taken at, as of
+  // the previous MeasureForegroundOpsPerSec() call.
+  uint64_t last_foreground_ops_ = 0;
+  CoarseTimePoint last_load_check_time_;
+
   // Number of compactions that were scheduled during the previous execution.
   // -1 indicates that there is no information about the previous execution.
   std::atomic<int> num_scheduled_last_execution_ = -1;
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "yb/common/entity_ids_types.h"
+#include "yb/common/hybrid_time.h"
 
 #include "yb/tserver/tserver_fwd.h"
 
@@ -31,6 +32,10 @@ class LocalTabletServer {
                                          GetTabletStatusResponsePB* resp) const = 0;
 
   virtual bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const = 0;
+
+  // Returns the time up to which the local replica of the tablet could serve a consistent prefix
+  // read without waiting, or an invalid hybrid time if it is not known.
+  virtual HybridTime SafeTimeForFollowerRead(const TabletId& tablet_id) const = 0;
 };
 
 } // namespace tserver
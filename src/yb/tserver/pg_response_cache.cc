@@ -15,8 +15,9 @@
 
 #include <atomic>
 #include <mutex>
-#include <future>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <boost/multi_index/member.hpp>
 
@@ -34,9 +35,11 @@
 
 #include "yb/util/flags.h"
 #include "yb/util/flags/flag_tags.h"
+#include "yb/util/locks.h"
 #include "yb/util/logging.h"
 #include "yb/util/lru_cache.h"
 #include "yb/util/metrics.h"
+#include "yb/util/status.h"
 #include "yb/util/write_buffer.h"
 
 METRIC_DEFINE_counter(server, pg_response_cache_hits,
@@ -57,28 +60,80 @@ namespace {
 
 YB_DEFINE_ENUM(DataState, (kInitializing)(kInitialized)(kFailed));
 
+void FillResponse(PgPerformResponsePB* response,
+                  rpc::RpcContext* context,
+                  const PgResponseCache::Response& value) {
+  *response = value.response;
+  auto rows_data_it = value.rows_data.begin();
+  auto& sidecars = context->sidecars();
+  for (auto& op : *response->mutable_responses()) {
+    if (op.has_rows_data_sidecar()) {
+      sidecars.Start().Append(rows_data_it->AsSlice());
+      op.set_rows_data_sidecar(narrow_cast<int>(sidecars.Complete()));
+    }
+    ++rows_data_it;
+  }
+  context->RespondSuccess();
+}
+
 class Data {
  public:
   explicit Data(const CoarseTimePoint& deadline)
       : state_(DataState::kInitializing),
-        deadline_(deadline),
-        future_(promise_.get_future()) {}
+        deadline_(deadline) {}
 
-  const PgResponseCache::Response& Get() const {
-    return future_.get();
+  // Responds to the call with the cached value. If the value is not loaded yet, the call is
+  // responded when loading completes, so RPC threads are not blocked while waiting for it.
+  void Fill(PgPerformResponsePB* response, rpc::RpcContext* context) {
+    const PgResponseCache::Response* value = nullptr;
+    {
+      std::lock_guard<simple_spinlock> lock(mutex_);
+      if (!value_ && !abandoned_) {
+        waiters_.emplace_back(response, std::move(*context));
+        return;
+      }
+      if (value_) {
+        value = &*value_;
+      }
+    }
+    if (value) {
+      FillResponse(response, context, *value);
+    } else {
+      RespondAbandoned(response, context);
+    }
   }
 
   void Set(PgResponseCache::Response&& value, IsFailure is_failure) {
-    auto expected = DataState::kInitializing;
-    auto exchanged = state_.compare_exchange_strong(
-        expected,
-        is_failure ? DataState::kFailed : DataState::kInitialized,
-        std::memory_order_acq_rel);
-    if (!exchanged) {
-      LOG(DFATAL) << "Unexpected state " << expected;
+    if (!ChangeState(is_failure ? DataState::kFailed : DataState::kInitialized)) {
       return;
     }
-    promise_.set_value(std::move(value));
+    Waiters waiters;
+    const PgResponseCache::Response* stored_value;
+    {
+      std::lock_guard<simple_spinlock> lock(mutex_);
+      stored_value = &value_.emplace(std::move(value));
+      waiters.swap(waiters_);
+    }
+    for (auto& [response, context] : waiters) {
+      FillResponse(response, &context, *stored_value);
+    }
+  }
+
+  // Invoked when the value will never be set, for instance when the call that had to load it
+  // failed before reaching tablets.
+  void Abandon() {
+    if (!ChangeState(DataState::kFailed)) {
+      return;
+    }
+    Waiters waiters;
+    {
+      std::lock_guard<simple_spinlock> lock(mutex_);
+      abandoned_ = true;
+      waiters.swap(waiters_);
+    }
+    for (auto& [response, context] : waiters) {
+      RespondAbandoned(response, &context);
+    }
   }
 
   bool IsValid() const {
@@ -92,10 +147,49 @@ class Data {
   }
 
  private:
+  using Waiters = std::vector<std::pair<PgPerformResponsePB*, rpc::RpcContext>>;
+
+  bool ChangeState(DataState new_state) {
+    auto expected = DataState::kInitializing;
+    if (state_.compare_exchange_strong(expected, new_state, std::memory_order_acq_rel)) {
+      return true;
+    }
+    LOG(DFATAL) << "Unexpected state " << expected;
+    return false;
+  }
+
+  static void RespondAbandoned(PgPerformResponsePB* response, rpc::RpcContext* context) {
+    StatusToPB(STATUS(TryAgain, "Failed to load cached response"), response->mutable_status());
+    context->RespondSuccess();
+  }
+
   std::atomic<DataState> state_;
   const CoarseTimePoint deadline_;
-  std::promise<PgResponseCache::Response> promise_;
-  std::shared_future<PgResponseCache::Response> future_;
+  simple_spinlock mutex_;
+  // Set only once, so a pointer to it obtained under the lock stays valid.
+  std::optional<PgResponseCache::Response> value_ GUARDED_BY(mutex_);
+  bool abandoned_ GUARDED_BY(mutex_) = false;
+  Waiters waiters_ GUARDED_BY(mutex_);
+};
+
+// Abandons the data if it was not set by the time the last copy of the setter is destroyed.
+class DataSetter {
+ public:
+  explicit DataSetter(std::shared_ptr<Data> data) : data_(std::move(data)) {}
+
+  ~DataSetter() {
+    if (data_) {
+      data_->Abandon();
+    }
+  }
+
+  void Set(PgResponseCache::Response&& response, IsFailure is_failure) {
+    data_->Set(std::move(response), is_failure);
+    data_.reset();
+  }
+
+ private:
+  std::shared_ptr<Data> data_;
 };
 
 struct Entry {
@@ -106,22 +200,6 @@ struct Entry {
   std::shared_ptr<Data> data;
 };
 
-void FillResponse(PgPerformResponsePB* response,
-                  rpc::RpcContext* context,
-                  const PgResponseCache::Response& value) {
-  *response = value.response;
-  auto rows_data_it = value.rows_data.begin();
-  auto& sidecars = context->sidecars();
-  for (auto& op : *response->mutable_responses()) {
-    if (op.has_rows_data_sidecar()) {
-      sidecars.Start().Append(rows_data_it->AsSlice());
-      op.set_rows_data_sidecar(narrow_cast<int>(sidecars.Complete()));
-    }
-    ++rows_data_it;
-  }
-  context->RespondSuccess();
-}
-
 } // namespace
 
 class PgResponseCache::Impl {
@@ -149,11 +227,12 @@ class PgResponseCache::Impl {
     IncrementCounter(queries_);
     if (!loading_required) {
       IncrementCounter(hits_);
-      FillResponse(response, context, data->Get());
+      data->Fill(response, context);
       return PgResponseCache::Setter();
     }
-    return [empty_data = std::move(data)](Response&& response, IsFailure is_failure) {
-      empty_data->Set(std::move(response), is_failure);
+    return [setter = std::make_shared<DataSetter>(std::move(data))](
+        Response&& response, IsFailure is_failure) {
+      setter->Set(std::move(response), is_failure);
     };
   }
 
@@ -550,6 +550,7 @@ Result<ReadHybridTime> ReadQuery::DoRead() {
   Result<ReadHybridTime> result{ReadHybridTime()};
   {
     LongOperationTracker long_operation_tracker("Read", 1s);
+    tablet::ScopedThreadCpuTimeTracker cpu_time_tracker(tablet()->metrics()->read_cpu_time.get());
     result = DoReadImpl();
   }
   // Check transaction is still alive in case read was successful
@@ -70,6 +70,7 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
+#include "yb/util/threadpool.h"
 
 using namespace yb::size_literals;
 
@@ -109,6 +110,7 @@ DEFINE_test_flag(bool, download_partial_wal_segments, false, "");
 DEFINE_test_flag(bool, pause_rbs_before_download_wal, false, "Pause RBS before downloading WAL.");
 
 DECLARE_int32(bytes_remote_bootstrap_durable_write_mb);
+DECLARE_int32(remote_bootstrap_max_concurrent_file_downloads);
 
 namespace yb {
 namespace tserver {
@@ -667,15 +669,52 @@ Status RemoteBootstrapClient::DownloadRocksDBFiles() {
 
   RETURN_NOT_OK(CreateTabletDirectories(rocksdb_dir, meta_->fs_manager()));
 
-  DataIdPB data_id;
-  data_id.set_type(DataIdPB::ROCKSDB_FILE);
-  for (auto const& file_pb : new_superblock_.kv_store().rocksdb_files()) {
+  auto download_file = [this, &rocksdb_dir](const tablet::FilePB& file_pb) -> Status {
+    DataIdPB data_id;
+    data_id.set_type(DataIdPB::ROCKSDB_FILE);
     auto start = MonoTime::Now();
     RETURN_NOT_OK(downloader_.DownloadFile(file_pb, rocksdb_dir, &data_id));
     auto elapsed = MonoTime::Now().GetDeltaSince(start);
     LOG_WITH_PREFIX(INFO)
         << "Downloaded file " << file_pb.name() << " of size " << file_pb.size_bytes()
         << " in " << elapsed.ToSeconds() << " seconds";
+    return Status::OK();
+  };
+
+  const auto& files = new_superblock_.kv_store().rocksdb_files();
+  const auto num_concurrent_downloads =
+      std::min(FLAGS_remote_bootstrap_max_concurrent_file_downloads, files.size());
+  if (num_concurrent_downloads <= 1) {
+    for (const auto& file_pb : files) {
+      RETURN_NOT_OK(download_file(file_pb));
+    }
+  } else {
+    // Declared before the pool, so that they outlive the tasks of the pool.
+    std::mutex status_mutex;
+    Status download_status;
+    std::unique_ptr<ThreadPool> pool;
+    RETURN_NOT_OK(ThreadPoolBuilder("rb-download")
+                      .set_max_threads(num_concurrent_downloads)
+                      .Build(&pool));
+    for (const auto& file_pb : files) {
+      RETURN_NOT_OK(pool->SubmitFunc([&download_file, &status_mutex, &download_status, &file_pb] {
+        {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (!download_status.ok()) {
+            return;
+          }
+        }
+        auto status = download_file(file_pb);
+        if (!status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (download_status.ok()) {
+            download_status = std::move(status);
+          }
+        }
+      }));
+    }
+    pool->Wait();
+    RETURN_NOT_OK(download_status);
   }
 
   // To avoid adding new file type to remote bootstrap we move intents as subdir of regular DB.
@@ -29,6 +29,7 @@
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
@@ -47,6 +48,19 @@ DEFINE_UNKNOWN_int64(remote_bootstrap_rate_limit_bytes_per_sec, 256_MB,
              "the total limit will be 2 * remote_bootstrap_rate_limit_bytes_per_sec because a "
              "tserver or master can act both as a sender and receiver at the same time.");
 
+DEFINE_RUNTIME_bool(remote_bootstrap_fetch_data_in_sidecars, true,
+    "Ask the remote bootstrap source to send file chunks in RPC sidecars. The source then sends "
+    "chunks without copying them into the serialized response, and the chunk is not copied "
+    "while parsing the response. Older sources ignore the request and send data inline.");
+TAG_FLAG(remote_bootstrap_fetch_data_in_sidecars, advanced);
+
+DEFINE_NON_RUNTIME_int32(remote_bootstrap_max_concurrent_file_downloads, 1,
+    "Maximum number of RocksDB files of a tablet downloaded concurrently during a remote "
+    "bootstrap. The files are fetched over the same session, so the source reads the next chunk "
+    "while previous chunks are being sent and written. The rate limit of the session is shared "
+    "between the downloads in flight.");
+TAG_FLAG(remote_bootstrap_max_concurrent_file_downloads, advanced);
+
 DEFINE_UNKNOWN_int32(bytes_remote_bootstrap_durable_write_mb, 1024,
              "Explicitly call fsync after downloading the specified amount of data in MB "
              "during a remote bootstrap session. If 0 fsync() is not called.");
@@ -102,16 +116,23 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
-    auto it = inode2file_.find(file_pb.inode());
-    if (it != inode2file_.end()) {
+    std::string existing_file;
+    {
+      std::lock_guard<std::mutex> lock(inode2file_mutex_);
+      auto it = inode2file_.find(file_pb.inode());
+      if (it != inode2file_.end()) {
+        existing_file = it->second;
+      }
+    }
+    if (!existing_file.empty()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
-                          << " => " << it->second;
-      auto link_status = env().LinkFile(it->second, file_path);
+                          << " => " << existing_file;
+      auto link_status = env().LinkFile(existing_file, file_path);
       if (link_status.ok()) {
         return Status::OK();
       }
       // TODO fallback to copy.
-      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << it->second
+      LOG_WITH_PREFIX(ERROR) << "Failed to link file: " << file_path << " => " << existing_file
                              << ": " << link_status;
     }
   }
@@ -130,6 +151,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
@@ -147,10 +169,15 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   auto max_length = std::min<size_t>(FLAGS_remote_bootstrap_max_chunk_size,
                                      FLAGS_rpc_max_message_size - kBytesReservedForMessageHeaders);
 
+  downloads_in_flight_.fetch_add(1, std::memory_order_acq_rel);
+  auto scope_exit = ScopeExit([this] {
+    downloads_in_flight_.fetch_sub(1, std::memory_order_acq_rel);
+  });
+
   std::unique_ptr<RateLimiter> rate_limiter;
 
   if (FLAGS_remote_bootstrap_rate_limit_bytes_per_sec > 0) {
-    static auto rate_updater = []() {
+    auto rate_updater = [this]() {
       auto remote_bootstrap_clients_started =
           remote_bootstrap_clients_started_.load(std::memory_order_acquire);
       if (remote_bootstrap_clients_started < 1) {
@@ -159,7 +186,8 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
         return static_cast<uint64_t>(FLAGS_remote_bootstrap_rate_limit_bytes_per_sec);
       }
       return static_cast<uint64_t>(
-          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started);
+          FLAGS_remote_bootstrap_rate_limit_bytes_per_sec / remote_bootstrap_clients_started /
+          std::max(downloads_in_flight_.load(std::memory_order_acquire), 1));
     };
 
     rate_limiter = std::make_unique<RateLimiter>(rate_updater);
@@ -192,36 +220,44 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
       max_length = std::min(max_length, decltype(max_length)(max_size));
     }
     req.set_max_length(max_length);
+    req.set_use_sidecar(FLAGS_remote_bootstrap_fetch_data_in_sidecars);
 
     FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
+    RefCntSlice sidecar;
+    auto status = rate_limiter->SendOrReceiveData(
+        [this, &req, &resp, &controller, &sidecar]() -> Status {
+      RETURN_NOT_OK(proxy_->FetchData(req, &resp, &controller));
+      if (resp.chunk().has_data_sidecar_idx()) {
+        sidecar = VERIFY_RESULT(controller.ExtractSidecar(resp.chunk().data_sidecar_idx()));
+      }
+      return Status::OK();
+    }, [&resp, &sidecar]() { return resp.ByteSize() + sidecar.size(); });
     RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+    const Slice data = resp.chunk().has_data_sidecar_idx()
+        ? sidecar.AsSlice() : Slice(resp.chunk().data());
+    DCHECK_LE(data.size(), max_length);
     iterations++;
 
     // Sanity-check for corruption.
     verify_data_timer.resume();
-    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
+    RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk(), data),
                           Format("Error validating data item $0", data_id));
     verify_data_timer.stop();
 
     // Write the data.
     VLOG_WITH_PREFIX(3) << "Verifying received data";
     append_data_timer.resume();
-    RETURN_NOT_OK(appendable->Append(resp.chunk().data()));
+    RETURN_NOT_OK(appendable->Append(data));
     append_data_timer.stop();
     VLOG_WITH_PREFIX(3) << "Verified and appended successfully: resp size: " << resp.ByteSize()
-                        << ", chunk size: " << resp.chunk().data().size();
+                        << ", chunk size: " << data.size();
 
-    if (offset + resp.chunk().data().size() ==
-            implicit_cast<size_t>(resp.chunk().total_data_length())) {
+    if (offset + data.size() == implicit_cast<size_t>(resp.chunk().total_data_length())) {
       done = true;
     }
-    offset += resp.chunk().data().size();
+    offset += data.size();
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
-      periodic_sync_unsynced_bytes += resp.chunk().data().size();
+      periodic_sync_unsynced_bytes += data.size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
         sync_timer.resume();
         RETURN_NOT_OK(appendable->Sync());
@@ -254,7 +290,8 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   return Status::OK();
 }
 
-Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChunkPB& chunk) {
+Status RemoteBootstrapFileDownloader::VerifyData(
+    uint64_t offset, const DataChunkPB& chunk, Slice data) {
   // Verify the offset is what we expected.
   if (offset != chunk.offset()) {
     return STATUS_FORMAT(
@@ -263,11 +300,11 @@ Status RemoteBootstrapFileDownloader::VerifyData(uint64_t offset, const DataChun
   }
 
   // Verify the checksum.
-  uint32_t crc32 = crc::Crc32c(chunk.data().data(), chunk.data().length());
+  uint32_t crc32 = crc::Crc32c(data.data(), data.size());
   if (PREDICT_FALSE(crc32 != chunk.crc32())) {
     return STATUS_FORMAT(
         Corruption, "CRC32 does not match at offset $0 size $1: $2 vs $3",
-        offset, chunk.data().size(), crc32, chunk.crc32());
+        offset, data.size(), crc32, chunk.crc32());
   }
   return Status::OK();
 }
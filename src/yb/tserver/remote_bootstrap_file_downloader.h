@@ -13,10 +13,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
+#include "yb/gutil/thread_annotations.h"
+
 #include "yb/rpc/rpc_fwd.h"
 
 #include "yb/tablet/metadata.pb.h"
@@ -44,6 +48,7 @@ class RemoteBootstrapFileDownloader {
       std::shared_ptr<RemoteBootstrapServiceProxy> proxy, std::string session_id,
       MonoDelta session_idle_timeout);
 
+  // Thread safe, files of the session can be downloaded concurrently.
   Status DownloadFile(
       const tablet::FilePB& file_pb, const std::string& dir, DataIdPB* data_id);
 
@@ -66,7 +71,7 @@ class RemoteBootstrapFileDownloader {
   }
 
  private:
-  Status VerifyData(uint64_t offset, const DataChunkPB& resp);
+  Status VerifyData(uint64_t offset, const DataChunkPB& chunk, Slice data);
 
   const std::string& LogPrefix() const {
     return log_prefix_;
@@ -80,7 +85,11 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
-  std::unordered_map<uint64_t, std::string> inode2file_;
+  // Number of files of the session being downloaded right now, they share the rate limit of the
+  // session.
+  std::atomic<int> downloads_in_flight_{0};
+  std::mutex inode2file_mutex_;
+  std::unordered_map<uint64_t, std::string> inode2file_ GUARDED_BY(inode2file_mutex_);
 };
 
 Status UnwindRemoteError(const Status& status, const rpc::RpcController& controller);
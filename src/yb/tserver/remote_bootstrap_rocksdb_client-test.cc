@@ -17,6 +17,8 @@
 
 #include "yb/tserver/remote_bootstrap_client-test.h"
 
+DECLARE_int32(remote_bootstrap_max_concurrent_file_downloads);
+
 using std::shared_ptr;
 using std::vector;
 
@@ -31,6 +33,9 @@ using tablet::TabletStatusListener;
 class RemoteBootstrapRocksDBClientTest : public RemoteBootstrapClientTest {
  public:
   RemoteBootstrapRocksDBClientTest() : RemoteBootstrapClientTest(YQL_TABLE_TYPE) {}
+
+ protected:
+  void TestDownloadRocksDBFiles();
 };
 
 // Basic begin / end remote bootstrap session.
@@ -40,8 +45,7 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestBeginEndSession) {
   ASSERT_OK(client_->Finish());
 }
 
-// Basic RocksDB files download unit test.
-TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+void RemoteBootstrapRocksDBClientTest::TestDownloadRocksDBFiles() {
   TabletStatusListener listener(meta_);
   ASSERT_OK(client_->FetchAll(&listener));
   auto tablet_peer_checkpoint_dir =
@@ -81,5 +85,15 @@ TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
   }
 }
 
+// Basic RocksDB files download unit test.
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFiles) {
+  TestDownloadRocksDBFiles();
+}
+
+TEST_F(RemoteBootstrapRocksDBClientTest, TestDownloadRocksDBFilesConcurrently) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_remote_bootstrap_max_concurrent_file_downloads) = 4;
+  TestDownloadRocksDBFiles();
+}
+
 } // namespace tserver
 } // namespace yb
@@ -37,6 +37,7 @@
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
 #include <glog/logging.h>
 
 #include "yb/common/wire_protocol.h"
@@ -49,6 +50,7 @@
 #include "yb/gutil/ref_counted.h"
 
 #include "yb/rpc/rpc_context.h"
+#include "yb/rpc/sidecars.h"
 
 #include "yb/tablet/tablet_peer.h"
 
@@ -287,16 +289,19 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
     session = it->second.session;
   }
 
-  session->EnsureRateLimiterIsInitialized();
-
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_handle_rb_fetch_data);
 
-  int64_t rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  int64_t rate_limit;
+  {
+    std::lock_guard<std::mutex> lock(session->fetch_data_mutex());
+    session->EnsureRateLimiterIsInitialized();
+    rate_limit = session->rate_limiter().GetMaxSizeForNextTransmission();
+  }
   VLOG(3) << " rate limiter max len: " << rate_limit;
   GetDataPieceInfo info = {
     .offset = req->offset(),
     .client_maxlen = rate_limit == 0 ? req->max_length() : std::min(req->max_length(), rate_limit),
-    .data = std::string(),
+    .data = RefCntBuffer(),
     .data_size = 0,
     .error_code = RemoteBootstrapErrorPB::UNKNOWN_ERROR,
   };
@@ -304,18 +309,29 @@ void RemoteBootstrapServiceImpl::FetchData(const FetchDataRequestPB* req,
   RPC_RETURN_NOT_OK(ValidateFetchRequestDataId(data_id, &info.error_code, session),
                     info.error_code, "Invalid DataId");
 
-  session->data_read_timer().resume();
   RPC_RETURN_NOT_OK(session->GetDataPiece(data_id, &info),
                     info.error_code, "Unable to get piece of data file");
-  session->data_read_timer().stop();
 
-  session->rate_limiter().UpdateDataSizeAndMaybeSleep(info.data.size());
-  session->crc_compute_timer().resume();
-  uint32_t crc32 = Crc32c(info.data.data(), info.data.length());
-  session->crc_compute_timer().stop();
+  MonoDelta sleep_time;
+  {
+    std::lock_guard<std::mutex> lock(session->fetch_data_mutex());
+    sleep_time = session->rate_limiter().UpdateDataSize(info.data.size());
+  }
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+  }
+  uint32_t crc32 = Crc32c(info.data.data(), info.data.size());
 
   DataChunkPB* data_chunk = resp->mutable_chunk();
-  *data_chunk->mutable_data() = std::move(info.data);
+  if (req->use_sidecar()) {
+    boost::container::small_vector<const uint8_t*, 2> bounds = {
+        info.data.udata(), info.data.uend()};
+    data_chunk->set_data_sidecar_idx(
+        narrow_cast<int32_t>(context.sidecars().Take(info.data, bounds)));
+    data_chunk->set_data(std::string());
+  } else {
+    data_chunk->set_data(info.data.data(), info.data.size());
+  }
   data_chunk->set_total_data_length(info.data_size);
   data_chunk->set_offset(info.offset);
 
@@ -48,9 +48,9 @@
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
 #include "yb/util/status_fwd.h"
-#include "yb/util/stopwatch.h"
 #include "yb/util/locks.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/ref_cnt_buffer.h"
 
 namespace yb {
 
@@ -72,7 +72,7 @@ struct GetDataPieceInfo {
   int64_t client_maxlen;
 
   // Output
-  std::string data;
+  RefCntBuffer data;
   uint64_t data_size;
   RemoteBootstrapErrorPB::Code error_code;
 
@@ -140,8 +140,9 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
 
   RateLimiter& rate_limiter() { return rate_limiter_; }
 
-  Stopwatch& crc_compute_timer() { return crc_compute_timer_; }
-  Stopwatch& data_read_timer() { return data_read_timer_; }
+  // Protects the rate limiter, since the client can fetch several files of the session
+  // concurrently. Only held while the rate limiter is accessed, not while reading or sending data.
+  std::mutex& fetch_data_mutex() { return fetch_data_mutex_; }
 
   static const std::string kCheckpointsDir;
 
@@ -229,13 +230,11 @@ class RemoteBootstrapSession : public RefCountedThreadSafe<RemoteBootstrapSessio
   // Time when this session was initialized.
   MonoTime start_time_;
 
-  // Stopwatch to capture the latency of different operations
-  Stopwatch crc_compute_timer_;
-  Stopwatch data_read_timer_;
-
   // Used to limit the transmission rate.
   RateLimiter rate_limiter_;
 
+  std::mutex fetch_data_mutex_;
+
   // Pointer to the counter for of the number of sessions in RemoteBootstrapService. Used to
   // calculate the rate for the rate limiter.
   const std::atomic<int>* nsessions_;
@@ -53,6 +53,11 @@ DEFINE_RUNTIME_uint64(sst_files_hard_limit, 48,
     "When majority SST files number is greater that this limit, we will reject all write "
     "requests.");
 
+DEFINE_RUNTIME_AUTO_bool(tserver_send_leader_hint, kLocalVolatile, false, true,
+    "When set, a follower that rejects a request with NOT_THE_LEADER attaches the UUID of the "
+    "leader it knows about, so that the client could retry on that peer directly. Older "
+    "processes do not know the status error category used for the hint.");
+
 DEFINE_test_flag(int32, write_rejection_percentage, 0,
                  "Reject specified percentage of writes.");
 
@@ -165,7 +170,20 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     typedef consensus::LeaderStatus LeaderStatus;
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
-      case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
+      case LeaderStatus::NOT_LEADER: {
+        status = status.CloneAndAddErrorCode(
+            TabletServerError(TabletServerErrorPB::NOT_THE_LEADER));
+        // Let the client go straight to the leader we know about, instead of trying every
+        // replica or looking the tablet up in the master.
+        if (FLAGS_tserver_send_leader_hint) {
+          auto leader_uuid = consensus->ConsensusState(
+              consensus::CONSENSUS_CONFIG_ACTIVE).leader_uuid();
+          if (!leader_uuid.empty() && leader_uuid != tablet_peer.permanent_uuid()) {
+            status = status.CloneAndAddErrorCode(TabletServerLeaderHint(leader_uuid));
+          }
+        }
+        return status;
+      }
       case LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE:
         // We are returning a NotTheLeader as opposed to LeaderNotReady, because there is a chance
         // that we're a partitioned-away leader, and the client needs to do another leader lookup.
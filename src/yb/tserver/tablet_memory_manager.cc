@@ -22,10 +22,13 @@
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
 
+#include "yb/server/clock.h"
+
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/background_task.h"
 #include "yb/util/flags.h"
 #include "yb/util/logging.h"
@@ -35,6 +38,8 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+
 DEFINE_UNKNOWN_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
 
@@ -76,6 +81,41 @@ DEFINE_UNKNOWN_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_NON_RUNTIME_string(db_block_cache_type, "lru",
+             "Type of RocksDB block cache. lru - LRU cache with single touch and multi touch "
+             "sub caches. clock - CLOCK cache, that does not take exclusive locks on lookups, but "
+             "does not distinguish single touch and multi touch entries.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+namespace {
+
+bool ValidateBlockCacheType(const char* flag_name, const std::string& value) {
+  if (value == "lru" || value == "clock") {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for " << flag_name << ": " << value
+             << ", expected one of: lru, clock";
+  return false;
+}
+
+} // namespace
+
+DEFINE_validator(db_block_cache_type, &ValidateBlockCacheType);
+
+DEFINE_RUNTIME_bool(global_memstore_flush_by_write_amplification, false,
+             "When the global memstore limit is reached, flush the tablet that frees the most "
+             "memtable memory per SST file it adds, instead of the tablet with the oldest write. "
+             "Tablets that already have many SST files are deprioritized, since their next "
+             "compaction would rewrite the new file. Tablets whose oldest unflushed write is older "
+             "than global_memstore_flush_max_write_age_sec are still flushed first.");
+TAG_FLAG(global_memstore_flush_by_write_amplification, advanced);
+
+DEFINE_RUNTIME_int32(global_memstore_flush_max_write_age_sec, 600,
+             "With global_memstore_flush_by_write_amplification, the tablet with the oldest "
+             "unflushed write is flushed first once that write is older than this, to bound WAL "
+             "retention and replay time. 0 disables the age limit.");
+TAG_FLAG(global_memstore_flush_max_write_age_sec, advanced);
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -196,8 +236,14 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+    if (FLAGS_db_block_cache_type == "clock") {
+      options->block_cache = rocksdb::NewClockCache(
+          block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+          /* strict_capacity_limit= */ false);
+    } else {
+      options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
+                                                  FLAGS_db_block_cache_num_shard_bits);
+    }
     options->block_cache->SetMetrics(metrics);
     block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
@@ -298,7 +344,7 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
       if (tablet_to_flush) {
         LOG(INFO)
             << LogPrefix(peer_to_flush)
-            << "Flushing tablet with oldest memstore write at "
+            << "Flushing tablet, oldest memstore write at "
             << tablet_to_flush->OldestMutableMemtableWriteHybridTime();
         WARN_NOT_OK(
             tablet_to_flush->Flush(
@@ -312,11 +358,18 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
+// Return the tablet to flush according to the flush policy, or nullptr if all tablet memstores are
 // empty or about to flush.
 tablet::TabletPeerPtr TabletMemoryManager::TabletToFlush() {
+  const bool by_write_amplification =
+      GetAtomicFlag(&FLAGS_global_memstore_flush_by_write_amplification);
+  const double level0_trigger = std::max(FLAGS_rocksdb_level0_file_num_compaction_trigger, 1);
+
   HybridTime oldest_write_in_memstores = HybridTime::kMax;
   tablet::TabletPeerPtr tablet_to_flush;
+  double best_score = 0;
+  tablet::TabletPeerPtr best_score_tablet;
+  std::shared_ptr<tablet::Tablet> oldest_write_tablet;
   for (const tablet::TabletPeerPtr& peer : peers_fn_()) {
     const auto tablet = peer->shared_tablet();
     if (tablet) {
@@ -325,15 +378,45 @@ tablet::TabletPeerPtr TabletMemoryManager::TabletToFlush() {
         if (*ht < oldest_write_in_memstores) {
           oldest_write_in_memstores = *ht;
           tablet_to_flush = peer;
+          oldest_write_tablet = tablet;
         }
       } else {
         YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
             "Failed to get oldest mutable memtable write ht for tablet $0: $1",
             tablet->tablet_id(), ht.status());
+        continue;
+      }
+      if (!by_write_amplification || *ht == HybridTime::kMax) {
+        continue;
+      }
+      const auto memtables_size = tablet->MutableMemtablesSize();
+      if (!memtables_size.ok()) {
+        continue;
+      }
+      // Every flush adds an SST file. Flushing large memtables makes fewer and bigger files, and
+      // a tablet that is close to the compaction trigger would rewrite the new file right away.
+      const auto score = *memtables_size /
+          (1.0 + tablet->GetCurrentVersionNumSSTFiles() / level0_trigger);
+      if (score > best_score) {
+        best_score = score;
+        best_score_tablet = peer;
       }
     }
   }
-  return tablet_to_flush;
+
+  if (!by_write_amplification || !best_score_tablet) {
+    return tablet_to_flush;
+  }
+
+  // Unflushed writes keep their WAL segments alive and are replayed on restart, so they are not
+  // allowed to stay in memtables for too long.
+  const auto max_write_age =
+      MonoDelta::FromSeconds(GetAtomicFlag(&FLAGS_global_memstore_flush_max_write_age_sec));
+  if (max_write_age > MonoDelta::kZero &&
+      oldest_write_in_memstores.AddDelta(max_write_age) <= oldest_write_tablet->clock()->Now()) {
+    return tablet_to_flush;
+  }
+  return best_score_tablet;
 }
 
 std::string TabletMemoryManager::LogPrefix(const tablet::TabletPeerPtr& peer) const {
@@ -82,8 +82,10 @@ class TabletMemoryManager {
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
-  // Determines which tablet has the oldest mutable memtable write time.  May return a null ptr
-  // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
+  // Determines which tablet has the oldest mutable memtable write time, or with
+  // global_memstore_flush_by_write_amplification, which tablet frees the most memory per added SST
+  // file.  May return a null ptr if no tablet meets the criteria.  Uses peers_fn_ to determine the
+  // full list of peers to check.
   tablet::TabletPeerPtr TabletToFlush();
 
   // Function to return a log prefix with the tablet's tablet_id and permanent_uuid.
@@ -655,6 +655,41 @@ TEST_F(TabletServerTest, TestCreateTablet_TabletExists) {
   }
 }
 
+TEST_F(TabletServerTest, TestCreateTablets) {
+  const std::vector<TabletId> kTabletIds = {"tablet-a", kTabletId, "tablet-b"};
+
+  CreateTabletsRequestPB req;
+  CreateTabletsResponsePB resp;
+  RpcController rpc;
+
+  req.set_dest_uuid(mini_server_->server()->fs_manager()->uuid());
+  Schema schema = SchemaBuilder(schema_).Build();
+  for (const auto& tablet_id : kTabletIds) {
+    auto* tablet_req = req.add_tablets();
+    tablet_req->set_table_id("testtb");
+    tablet_req->set_tablet_id(tablet_id);
+    tablet_req->set_table_name("testtb");
+    tablet_req->mutable_config()->CopyFrom(mini_server_->CreateLocalConfig());
+    SchemaToPB(schema, tablet_req->mutable_schema());
+  }
+
+  SCOPED_TRACE(req.DebugString());
+  ASSERT_OK(admin_proxy_->CreateTablets(req, &resp, &rpc));
+  SCOPED_TRACE(resp.DebugString());
+  ASSERT_FALSE(resp.has_error());
+  ASSERT_EQ(resp.tablets_size(), 3);
+
+  // The existing tablet is reported without failing the others.
+  ASSERT_FALSE(resp.tablets(0).has_error());
+  ASSERT_TRUE(resp.tablets(1).has_error());
+  ASSERT_EQ(TabletServerErrorPB::TABLET_ALREADY_EXISTS, resp.tablets(1).error().code());
+  ASSERT_FALSE(resp.tablets(2).has_error());
+
+  for (const auto& tablet_id : kTabletIds) {
+    ASSERT_OK(mini_server_->server()->tablet_manager()->GetTablet(tablet_id));
+  }
+}
+
 TEST_F(TabletServerTest, TestDeleteTablet) {
   // Verify that the tablet exists
   ASSERT_OK(mini_server_->server()->tablet_manager()->GetTablet(kTabletId));
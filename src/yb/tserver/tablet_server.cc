@@ -67,6 +67,7 @@
 #include "yb/server/webserver.h"
 
 #include "yb/tablet/maintenance_manager.h"
+#include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/heartbeater.h"
@@ -523,6 +524,19 @@ bool TabletServer::LeaderAndReady(const TabletId& tablet_id, bool allow_stale) c
   return peer->LeaderStatus(allow_stale) == consensus::LeaderStatus::LEADER_AND_READY;
 }
 
+HybridTime TabletServer::SafeTimeForFollowerRead(const TabletId& tablet_id) const {
+  auto peer = tablet_manager_->LookupTablet(tablet_id);
+  if (!peer) {
+    return HybridTime::kInvalid;
+  }
+  auto tablet = peer->shared_tablet();
+  if (!tablet) {
+    return HybridTime::kInvalid;
+  }
+  // Consistent prefix reads do not require the lease, and kMin does not let SafeTime wait.
+  return ResultToValue(tablet->SafeTime(tablet::RequireLease::kFalse), HybridTime::kInvalid);
+}
+
 Status TabletServer::SetUniverseKeyRegistry(
     const encryption::UniverseKeyRegistryPB& universe_key_registry) {
   return Status::OK();
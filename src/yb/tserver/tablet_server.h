@@ -162,6 +162,8 @@ class TabletServer : public DbServerBase, public TabletServerIf {
 
   bool LeaderAndReady(const TabletId& tablet_id, bool allow_stale = false) const override;
 
+  HybridTime SafeTimeForFollowerRead(const TabletId& tablet_id) const override;
+
   const std::string& permanent_uuid() const override { return fs_manager_->uuid(); }
 
   bool has_faulty_drive() const { return fs_manager_->has_faulty_drive(); }
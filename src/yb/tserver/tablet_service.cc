@@ -33,6 +33,7 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -1098,6 +1099,72 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
   }
 }
 
+void TabletServiceImpl::UpdateTransactionHeartbeats(
+    const UpdateTransactionHeartbeatsRequestPB* req,
+    UpdateTransactionHeartbeatsResponsePB* resp,
+    rpc::RpcContext context) {
+  TRACE("UpdateTransactionHeartbeats");
+
+  VLOG(1) << "UpdateTransactionHeartbeats: " << req->ShortDebugString()
+          << ", context: " << context.ToString();
+  UpdateClock(*req, server_->Clock());
+
+  auto tablet = LookupLeaderTabletOrRespond(
+      server_->tablet_peer_lookup(), req->tablet_id(), resp, &context);
+  if (!tablet) {
+    return;
+  }
+
+  auto* coordinator = tablet.tablet->transaction_coordinator();
+  if (!coordinator) {
+    SetupErrorAndRespond(
+        resp->mutable_error(),
+        STATUS(InvalidArgument, "Does not have transaction coordinator to process heartbeats"),
+        &context);
+    return;
+  }
+
+  const auto num_transactions = req->transaction_id().size();
+  if (num_transactions == 0) {
+    resp->set_propagated_hybrid_time(server_->Clock()->Now().ToUint64());
+    context.RespondSuccess();
+    return;
+  }
+
+  // Each heartbeat goes through the coordinator as a regular PENDING update, so Raft replicates
+  // them together. The response is sent once the last of them completes.
+  struct Batch {
+    Batch(rpc::RpcContext context_, UpdateTransactionHeartbeatsResponsePB* resp_, size_t size)
+        : context(std::move(context_)), resp(resp_), statuses(size), pending(size) {}
+
+    rpc::RpcContext context;
+    UpdateTransactionHeartbeatsResponsePB* resp;
+    std::vector<Status> statuses;
+    std::atomic<size_t> pending;
+  };
+  auto batch = std::make_shared<Batch>(std::move(context), resp, num_transactions);
+  auto clock = server_->Clock();
+
+  for (int i = 0; i != num_transactions; ++i) {
+    auto state = std::make_unique<tablet::UpdateTxnOperation>(tablet.tablet);
+    auto& txn_state = *state->AllocateRequest();
+    txn_state.set_transaction_id(req->transaction_id(i));
+    txn_state.set_status(TransactionStatus::PENDING);
+    state->set_completion_callback([batch, clock, i](const Status& status) {
+      batch->statuses[i] = status;
+      if (batch->pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+      }
+      for (const auto& txn_status : batch->statuses) {
+        StatusToPB(txn_status, batch->resp->add_status());
+      }
+      batch->resp->set_propagated_hybrid_time(clock->Now().ToUint64());
+      batch->context.RespondSuccess();
+    });
+    coordinator->Handle(std::move(state), tablet.leader_term);
+  }
+}
+
 template <class Req, class Resp, class Action>
 void TabletServiceImpl::PerformAtLeader(
     const Req& req, Resp* resp, rpc::RpcContext* context, const Action& action) {
@@ -1344,6 +1411,52 @@ void TabletServiceAdminImpl::CreateTablet(const CreateTabletRequestPB* req,
   }
 }
 
+void TabletServiceAdminImpl::CreateTablets(const CreateTabletsRequestPB* req,
+                                           CreateTabletsResponsePB* resp,
+                                           rpc::RpcContext context) {
+  if (!CheckUuidMatchOrRespond(server_->tablet_manager(), "CreateTablets", req, resp, &context)) {
+    return;
+  }
+  LOG(INFO) << "Processing CreateTablets for " << req->tablets_size() << " tablets";
+  if (req->tablets().empty()) {
+    context.RespondSuccess();
+    return;
+  }
+
+  struct CreateTabletsState {
+    CreateTabletsState(rpc::RpcContext context_, int pending_)
+        : context(std::move(context_)), pending(pending_) {}
+
+    rpc::RpcContext context;
+    std::atomic<int> pending;
+  };
+  auto state = std::make_shared<CreateTabletsState>(std::move(context), req->tablets_size());
+  resp->mutable_tablets()->Reserve(req->tablets_size());
+  for (int i = 0; i != req->tablets_size(); ++i) {
+    resp->add_tablets();
+  }
+
+  // Tablets are created on the pool that opens tablets, which is sized for the data disks. Each
+  // creation writes and syncs the tablet and consensus metadata, so doing them in parallel is what
+  // makes the batch faster than the same number of CreateTablet RPCs.
+  auto* pool = server_->tablet_manager()->open_tablet_pool();
+  for (int i = 0; i != req->tablets_size(); ++i) {
+    auto create = [this, tablet_req = &req->tablets(i), tablet_resp = resp->mutable_tablets(i),
+                   state] {
+      auto status = DoCreateTablet(tablet_req, tablet_resp);
+      if (!status.ok()) {
+        SetupError(tablet_resp->mutable_error(), status);
+      }
+      if (--state->pending == 0) {
+        state->context.RespondSuccess();
+      }
+    };
+    if (!pool->SubmitFunc(create).ok()) {
+      create();
+    }
+  }
+}
+
 Status TabletServiceAdminImpl::DoCreateTablet(const CreateTabletRequestPB* req,
                                               CreateTabletResponsePB* resp) {
   if (PREDICT_FALSE(FLAGS_TEST_txn_status_table_tablet_creation_delay_ms > 0 &&
@@ -2270,6 +2383,10 @@ void TabletServiceImpl::Publish(
     const PublishRequestPB* req, PublishResponsePB* resp, rpc::RpcContext context) {
   rpc::Publisher* publisher = server_->GetPublisher();
   resp->set_num_clients_forwarded_to(publisher ? (*publisher)(req->channel(), req->message()) : 0);
+  for (const auto& entry : req->more_messages()) {
+    resp->add_more_num_clients_forwarded_to(
+        publisher ? (*publisher)(entry.channel(), entry.message()) : 0);
+  }
   context.RespondSuccess();
 }
 
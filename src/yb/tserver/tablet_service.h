@@ -115,6 +115,10 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
                          UpdateTransactionResponsePB* resp,
                          rpc::RpcContext context) override;
 
+  void UpdateTransactionHeartbeats(const UpdateTransactionHeartbeatsRequestPB* req,
+                                   UpdateTransactionHeartbeatsResponsePB* resp,
+                                   rpc::RpcContext context) override;
+
   void GetTransactionStatus(const GetTransactionStatusRequestPB* req,
                             GetTransactionStatusResponsePB* resp,
                             rpc::RpcContext context) override;
@@ -203,6 +207,10 @@ class TabletServiceAdminImpl : public TabletServerAdminServiceIf {
                     CreateTabletResponsePB* resp,
                     rpc::RpcContext context) override;
 
+  void CreateTablets(const CreateTabletsRequestPB* req,
+                     CreateTabletsResponsePB* resp,
+                     rpc::RpcContext context) override;
+
   void PrepareDeleteTransactionTablet(const PrepareDeleteTransactionTabletRequestPB* req,
                                       PrepareDeleteTransactionTabletResponsePB* resp,
                                       rpc::RpcContext context) override;
@@ -43,6 +43,7 @@
 #include "yb/common/schema.h"
 
 #include "yb/consensus/consensus.messages.h"
+#include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_round.h"
 #include "yb/consensus/metadata.pb.h"
 #include "yb/consensus/raft_consensus.h"
@@ -83,8 +84,10 @@ DECLARE_bool(TEST_tserver_disable_heartbeat);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
 DECLARE_bool(disable_auto_flags_management);
+DECLARE_bool(enable_restart_last_leader_tablets_first);
 DECLARE_int32(scheduled_full_compaction_frequency_hours);
 DECLARE_int32(scheduled_full_compaction_jitter_factor_percentage);
+DECLARE_int32(scheduled_full_compaction_old_schema_frequency_hours);
 
 namespace yb {
 namespace tserver {
@@ -250,6 +253,36 @@ TEST_F(TsTabletManagerTest, TestCreateTablet) {
   ASSERT_EQ(kTabletId, peer->tablet()->tablet_id());
 }
 
+TEST_F(TsTabletManagerTest, BootstrapLastLeaderTabletsFirst) {
+  const std::vector<TabletId> kTabletIds = {"tablet-0", "tablet-1", "tablet-2"};
+  std::vector<tablet::RaftGroupMetadataPtr> metas;
+  for (const auto& tablet_id : kTabletIds) {
+    std::shared_ptr<TabletPeer> peer;
+    ASSERT_OK(CreateNewTablet(kTableId, tablet_id, schema_, &peer));
+    metas.push_back(peer->tablet_metadata());
+
+    // Only tablet-1 voted for another peer in its latest term.
+    std::unique_ptr<consensus::ConsensusMetadata> cmeta;
+    ASSERT_OK(consensus::ConsensusMetadata::Load(
+        fs_manager_, tablet_id, fs_manager_->uuid(), &cmeta));
+    cmeta->set_voted_for(tablet_id == "tablet-1" ? "other-peer-uuid" : fs_manager_->uuid());
+    ASSERT_OK(cmeta->Flush());
+  }
+
+  auto order = [this, &metas] {
+    std::vector<TabletId> result;
+    for (const auto& meta : tablet_manager_->OrderTabletsForBootstrap(metas)) {
+      result.push_back(meta->raft_group_id());
+    }
+    return result;
+  };
+
+  ASSERT_EQ(order(), kTabletIds);
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_restart_last_leader_tablets_first) = true;
+  ASSERT_EQ(order(), std::vector<TabletId>({"tablet-0", "tablet-2", "tablet-1"}));
+}
+
 TEST_F(TsTabletManagerTest, TestTombstonedTabletsAreUnregistered) {
   const std::string kTableId = "my-table-id";
   const std::string kTabletId1 = "my-tablet-id-1";
@@ -832,6 +865,35 @@ TEST_F(TsTabletManagerTest, FullCompactionCalculateNextCompaction) {
   }
 }
 
+// Tests that tablets with data of an older schema version are scheduled for a full compaction.
+TEST_F(TsTabletManagerTest, FullCompactionOfOldSchemaVersions) {
+  std::shared_ptr<TabletPeer> peer;
+  ASSERT_OK(CreateNewTablet(kTableId, kTabletId, schema_, &peer));
+  auto metadata = peer->tablet_metadata();
+  auto compaction_manager = tablet_manager_->full_compaction_manager();
+  const auto now = HybridTime(kTimeRecent);
+
+  FlagSaver flag_saver;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_scheduled_full_compaction_old_schema_frequency_hours) = 24;
+  compaction_manager->SetFrequencyAndJitterFromFlags();
+  ASSERT_FALSE(metadata->HasOldSchemaVersions());
+  ASSERT_EQ(compaction_manager->DetermineOldSchemaCompactTime(peer, now), HybridTime::kMax);
+
+  metadata->SetSchema(*metadata->schema(), IndexMap(), {}, metadata->schema_version() + 1);
+  ASSERT_TRUE(metadata->HasOldSchemaVersions());
+  // Never compacted, so the compaction is due now.
+  metadata->set_last_full_compaction_time(kNoLastCompact.ToUint64());
+  ASSERT_EQ(compaction_manager->DetermineOldSchemaCompactTime(peer, now), now);
+  // Compacted recently, so the next compaction is due after the frequency.
+  metadata->set_last_full_compaction_time(kTimeRecent.ToUint64());
+  ASSERT_EQ(compaction_manager->DetermineOldSchemaCompactTime(peer, now),
+            kTimeRecent.AddDelta(MonoDelta::FromHours(24)));
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_scheduled_full_compaction_old_schema_frequency_hours) = 0;
+  compaction_manager->SetFrequencyAndJitterFromFlags();
+  ASSERT_EQ(compaction_manager->DetermineOldSchemaCompactTime(peer, now), HybridTime::kMax);
+}
+
 // Tests that scheduled compaction times are roughly evenly spread based on jitter factor.
 TEST_F(TsTabletManagerTest, CompactionsEvenlySpreadByJitter) {
   const auto compaction_frequency = MonoDelta::FromDays(10);
@@ -73,6 +73,7 @@
 #include "yb/master/master_heartbeat.pb.h"
 #include "yb/master/sys_catalog.h"
 
+#include "yb/rocksdb/util/block_cache_warmup.h"
 #include "yb/rocksdb/util/task_metrics.h"
 
 #include "yb/rpc/messenger.h"
@@ -245,6 +246,23 @@ DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
 DEFINE_UNKNOWN_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_NON_RUNTIME_bool(enable_restart_last_leader_tablets_first, false,
+    "Set to true to bootstrap tablets for which this tserver was likely the last leader, i.e. "
+    "voted for itself in the latest known term, before the other tablets (but after transaction "
+    "status tablets). Requires reading consensus metadata of every tablet before bootstrap.");
+TAG_FLAG(enable_restart_last_leader_tablets_first, advanced);
+
+DEFINE_NON_RUNTIME_uint32(block_cache_warmup_save_interval_sec, 0,
+    "Interval at which the data blocks present in the block cache are recorded for every tablet, "
+    "so that they can be loaded back into the block cache when the tablet is opened after a "
+    "restart. The blocks are also recorded on clean shutdown. 0 disables recording.");
+TAG_FLAG(block_cache_warmup_save_interval_sec, advanced);
+
+DEFINE_NON_RUNTIME_bool(block_cache_warmup_on_start, true,
+    "Whether to load the data blocks recorded before a restart into the block cache after the "
+    "tablet is opened. Loading stops when the block cache is full.");
+TAG_FLAG(block_cache_warmup_on_start, advanced);
+
 DECLARE_bool(enable_wait_queues);
 
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
@@ -376,6 +394,41 @@ void TSTabletManager::CleanupOldMetrics() {
   metric_registry_->RetireOldMetrics();
 }
 
+void TSTabletManager::SaveBlockCacheWarmupState() {
+  if (!tablet_options_.block_cache) {
+    return;
+  }
+  auto cache_keys = rocksdb::BlockCacheKeys::Collect(tablet_options_.block_cache.get());
+  VLOG_WITH_PREFIX(2) << "Recording " << cache_keys.size() << " block cache entries";
+  for (const auto& peer : GetTabletPeers()) {
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    WARN_NOT_OK(tablet->SaveBlockCacheWarmupState(cache_keys),
+                Format("$0Failed to record block cache state", TabletLogPrefix(peer->tablet_id())));
+  }
+}
+
+void TSTabletManager::WarmUpBlockCache(const std::weak_ptr<tablet::TabletPeer>& weak_peer) {
+  auto peer = weak_peer.lock();
+  if (!peer) {
+    return;
+  }
+  auto tablet = peer->shared_tablet();
+  if (!tablet) {
+    return;
+  }
+  auto num_blocks = tablet->WarmUpBlockCache();
+  if (!num_blocks.ok()) {
+    LOG(WARNING) << TabletLogPrefix(peer->tablet_id()) << "Block cache warm-up failed: "
+                 << num_blocks.status();
+  } else if (*num_blocks) {
+    LOG(INFO) << TabletLogPrefix(peer->tablet_id()) << "Loaded " << *num_blocks
+              << " blocks into the block cache";
+  }
+}
+
 void TSTabletManager::PollWaitingTxnRegistry() {
   DCHECK_NOTNULL(waiting_txn_registry_)->SendWaitForGraph();
 }
@@ -451,6 +504,9 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
               .set_metrics(THREAD_POOL_METRICS_INSTANCE(
                   server_->metric_entity(), wait_queue_resume_waiter_pool))
               .Build(&wait_queue_pool_));
+  CHECK_OK(ThreadPoolBuilder("block-cache-warmup")
+              .set_max_threads(1)
+              .Build(&block_cache_warmup_pool_));
   ts_split_op_apply_ = METRIC_ts_split_op_apply.Instantiate(server_->metric_entity(), 0);
   ts_post_split_compaction_added_ =
       METRIC_ts_post_split_compaction_added.Instantiate(server_->metric_entity(), 0);
@@ -481,6 +537,16 @@ Status TSTabletManager::Init() {
   if (docdb::GetRocksDBRateLimiterSharingMode() == docdb::RateLimiterSharingMode::TSERVER) {
     tablet_options_.rate_limiter = docdb::CreateRocksDBRateLimiter();
   }
+  tablet_options_.table_cache = docdb::CreateSharedRocksDBTableCache();
+  for (const auto& data_root : fs_manager_->GetDataRootDirs()) {
+    auto sst_file_manager = VERIFY_RESULT(docdb::CreateRocksDBSstFileManager(
+        tablet_options_.rocksdb_env, data_root));
+    if (sst_file_manager) {
+      // Tablet uses the hash of its data root as the disk group number.
+      tablet_options_.sst_file_managers.emplace(
+          std::hash<std::string>()(data_root), std::move(sst_file_manager));
+    }
+  }
 
   // Start the threadpool we'll use to open tablets.
   // This has to be done in Init() instead of the constructor, since the
@@ -522,7 +588,7 @@ Status TSTabletManager::Init() {
         client_future(), scoped_refptr<server::Clock>(server_->clock()));
   }
 
-  deque<RaftGroupMetadataPtr> metas;
+  vector<RaftGroupMetadataPtr> metas;
 
   // First, load all of the tablet metadata. We do this before we start
   // submitting the actual OpenTablet() tasks so that we don't have to compete
@@ -539,17 +605,9 @@ Status TSTabletManager::Init() {
     RegisterDataAndWalDir(
         fs_manager_, meta->table_id(), meta->raft_group_id(), meta->data_root_dir(),
         meta->wal_root_dir());
-    if (FLAGS_enable_restart_transaction_status_tablets_first) {
-      // Prioritize bootstrapping transaction status tablets first.
-      if (meta->table_type() == TRANSACTION_STATUS_TABLE_TYPE) {
-        metas.push_front(meta);
-      } else {
-        metas.push_back(meta);
-      }
-    } else {
-      metas.push_back(meta);
-    }
+    metas.push_back(meta);
   }
+  metas = OrderTabletsForBootstrap(std::move(metas));
 
   MonoDelta elapsed = MonoTime::Now().GetDeltaSince(start);
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
@@ -597,6 +655,9 @@ Status TSTabletManager::Init() {
   waiting_txn_registry_poller_ = std::make_unique<rpc::Poller>(
       LogPrefix(), std::bind(&TSTabletManager::PollWaitingTxnRegistry, this));
 
+  block_cache_warmup_saver_ = std::make_unique<rpc::Poller>(
+      LogPrefix(), std::bind(&TSTabletManager::SaveBlockCacheWarmupState, this));
+
   return Status::OK();
 }
 
@@ -655,6 +716,11 @@ Status TSTabletManager::Start() {
     LOG(INFO)
         << "Old metrics cleanup is disabled by cleanup_metrics_interval_sec flag set to 0";
   }
+  if (FLAGS_block_cache_warmup_save_interval_sec > 0) {
+    block_cache_warmup_saver_->Start(
+        &server_->messenger()->scheduler(), FLAGS_block_cache_warmup_save_interval_sec * 1s);
+    LOG(INFO) << "Block cache warm-up state recording task started...";
+  }
 
   if (waiting_txn_registry_) {
     waiting_txn_registry_poller_->Start(
@@ -1452,6 +1518,46 @@ bool TSTabletManager::IsTabletInTransition(const TabletId& tablet_id) const {
   return ContainsKey(transition_in_progress_, tablet_id);
 }
 
+std::vector<RaftGroupMetadataPtr> TSTabletManager::OrderTabletsForBootstrap(
+    std::vector<RaftGroupMetadataPtr> metas) {
+  deque<RaftGroupMetadataPtr> result;
+  // Tablets for which this tserver was likely the leader before restart. They are placed after
+  // transaction status tablets but before all other tablets.
+  vector<RaftGroupMetadataPtr> last_leader_metas;
+  for (auto& meta : metas) {
+    if (FLAGS_enable_restart_transaction_status_tablets_first) {
+      // Prioritize bootstrapping transaction status tablets first.
+      if (meta->table_type() == TRANSACTION_STATUS_TABLE_TYPE) {
+        result.push_front(std::move(meta));
+        continue;
+      }
+    }
+    if (FLAGS_enable_restart_last_leader_tablets_first && WasLikelyLastLeader(meta)) {
+      last_leader_metas.push_back(std::move(meta));
+    } else {
+      result.push_back(std::move(meta));
+    }
+  }
+  if (!last_leader_metas.empty()) {
+    LOG_WITH_PREFIX(INFO) << "Bootstrapping " << last_leader_metas.size()
+                          << " tablets with local last leader first";
+    auto pos = std::find_if(result.begin(), result.end(), [](const RaftGroupMetadataPtr& meta) {
+      return meta->table_type() != TRANSACTION_STATUS_TABLE_TYPE;
+    });
+    result.insert(pos, last_leader_metas.begin(), last_leader_metas.end());
+  }
+  return std::vector<RaftGroupMetadataPtr>(result.begin(), result.end());
+}
+
+bool TSTabletManager::WasLikelyLastLeader(const RaftGroupMetadataPtr& meta) {
+  // A leader always votes for itself in the term it was elected in, so this is a cheap
+  // approximation. Errors are ignored here, they will be reported by OpenTablet.
+  std::unique_ptr<ConsensusMetadata> cmeta;
+  auto s = ConsensusMetadata::Load(
+      meta->fs_manager(), meta->raft_group_id(), fs_manager_->uuid(), &cmeta);
+  return s.ok() && cmeta->has_voted_for() && cmeta->voted_for() == fs_manager_->uuid();
+}
+
 Status TSTabletManager::OpenTabletMeta(const string& tablet_id,
                                        RaftGroupMetadataPtr* metadata) {
   LOG(INFO) << "Loading metadata for tablet " << tablet_id;
@@ -1617,6 +1723,14 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
 
   tablet->TriggerPostSplitCompactionIfNeeded();
 
+  if (FLAGS_block_cache_warmup_on_start) {
+    WARN_NOT_OK(
+        block_cache_warmup_pool_->SubmitFunc(std::bind(
+            &TSTabletManager::WarmUpBlockCache, this,
+            std::weak_ptr<tablet::TabletPeer>(tablet_peer))),
+        kLogPrefix + "Failed to submit block cache warm-up");
+  }
+
   if (tablet->ShouldDisableLbMove()) {
     std::lock_guard<RWMutex> lock(mutex_);
     tablets_blocked_from_lb_.insert(tablet->tablet_id());
@@ -1680,6 +1794,12 @@ void TSTabletManager::StartShutdown() {
 
   waiting_txn_registry_poller_->Shutdown();
 
+  if (FLAGS_block_cache_warmup_save_interval_sec > 0) {
+    block_cache_warmup_saver_->Shutdown();
+    // Record the blocks once more, so a clean restart warms up with the latest state.
+    SaveBlockCacheWarmupState();
+  }
+
   mem_manager_->Shutdown();
 
   // Wait for all RBS operations to finish.
@@ -1766,6 +1886,10 @@ void TSTabletManager::CompleteShutdown() {
   if (wait_queue_pool_) {
     wait_queue_pool_->Shutdown();
   }
+  // Tablets are shut down by now, so running warm-up is aborted.
+  if (block_cache_warmup_pool_) {
+    block_cache_warmup_pool_->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> l(mutex_);
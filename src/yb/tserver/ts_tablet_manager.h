@@ -164,6 +164,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   ThreadPool* log_sync_pool() const { return log_sync_pool_.get(); }
   ThreadPool* full_compaction_pool() const { return full_compaction_pool_.get(); }
   ThreadPool* wait_queue_pool() const { return wait_queue_pool_.get(); }
+  ThreadPool* open_tablet_pool() const { return open_tablet_pool_.get(); }
 
   // Create a new tablet and register it with the tablet manager. The new tablet
   // is persisted on disk and opened before this method returns.
@@ -347,6 +348,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Background task that Retires old metrics.
   void CleanupOldMetrics();
 
+  // Background task that records the data blocks present in the block cache for every tablet.
+  void SaveBlockCacheWarmupState();
+
   client::YBClient& client();
 
   const std::shared_future<client::YBClient*>& client_future();
@@ -357,6 +361,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   Status TriggerAdminCompactionAndWait(const TabletPtrs& tablets);
 
  private:
+  FRIEND_TEST(TsTabletManagerTest, BootstrapLastLeaderTabletsFirst);
   FRIEND_TEST(TsTabletManagerTest, TestPersistBlocks);
   FRIEND_TEST(TsTabletManagerTest, TestTombstonedTabletsAreUnregistered);
 
@@ -405,6 +410,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   Result<scoped_refptr<TransitionInProgressDeleter>> StartTabletStateTransitionForCreation(
       const TabletId& tablet_id);
 
+  // Returns the tablets in the order they should be bootstrapped at startup: transaction status
+  // tablets first if enable_restart_transaction_status_tablets_first is set, then the tablets this
+  // tserver likely led if enable_restart_last_leader_tablets_first is set, then the others.
+  std::vector<RaftGroupMetadataPtr> OrderTabletsForBootstrap(
+      std::vector<RaftGroupMetadataPtr> metas);
+
+  // Returns true if the local peer voted for itself in the latest term it knows for this tablet.
+  bool WasLikelyLastLeader(const RaftGroupMetadataPtr& meta);
+
   // Open a tablet meta from the local file system by loading its superblock.
   Status OpenTabletMeta(const TabletId& tablet_id,
                         scoped_refptr<tablet::RaftGroupMetadata>* metadata);
@@ -526,6 +540,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   void PollWaitingTxnRegistry();
 
+  // Loads the data blocks recorded before restart into the block cache.
+  void WarmUpBlockCache(const std::weak_ptr<tablet::TabletPeer>& weak_peer);
+
   const CoarseTimePoint start_time_;
 
   FsManager* const fs_manager_;
@@ -625,6 +642,12 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unique_ptr<rpc::Poller> waiting_txn_registry_poller_;
 
+  // Used for recording the block cache state, see SaveBlockCacheWarmupState.
+  std::unique_ptr<rpc::Poller> block_cache_warmup_saver_;
+
+  // Thread pool for loading recorded blocks into the block cache after tablets are opened.
+  std::unique_ptr<ThreadPool> block_cache_warmup_pool_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
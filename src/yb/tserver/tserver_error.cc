@@ -28,5 +28,11 @@ static const std::string kTabletServerDelayCategoryName = "tablet server delay";
 static StatusCategoryRegisterer tablet_server_delay_category_registerer(
     StatusCategoryDescription::Make<TabletServerDelayTag>(&kTabletServerDelayCategoryName));
 
+static const std::string kTabletServerLeaderHintCategoryName = "tablet server leader hint";
+
+static StatusCategoryRegisterer tablet_server_leader_hint_category_registerer(
+    StatusCategoryDescription::Make<TabletServerLeaderHintTag>(
+        &kTabletServerLeaderHintCategoryName));
+
 } // namespace tserver
 } // namespace yb
@@ -65,5 +65,18 @@ struct TabletServerDelayTag : IntegralBackedErrorTag<MonoDeltaTraits> {
 
 typedef StatusErrorCodeImpl<TabletServerDelayTag> TabletServerDelay;
 
+// UUID of the peer that a follower believes to be the leader, attached to NOT_THE_LEADER errors
+// so that the client could retry on that peer instead of guessing.
+struct TabletServerLeaderHintTag : StringBackedErrorTag {
+  // This category id is part of the wire protocol and should not be changed once released.
+  static constexpr uint8_t kCategory = 22;
+
+  static std::string ToMessage(const Value& value) {
+    return value;
+  }
+};
+
+typedef StatusErrorCodeImpl<TabletServerLeaderHintTag> TabletServerLeaderHint;
+
 } // namespace tserver
 } // namespace yb
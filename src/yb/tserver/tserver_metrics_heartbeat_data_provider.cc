@@ -21,6 +21,7 @@
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/cdc_consumer.h"
@@ -43,6 +44,13 @@ DEFINE_UNKNOWN_bool(tserver_heartbeat_metrics_add_drive_data, true,
 DEFINE_UNKNOWN_bool(tserver_heartbeat_metrics_add_replication_status, true,
             "Add replication status to metrics tserver sends to master");
 
+DEFINE_RUNTIME_int32(tserver_heartbeat_metrics_full_storage_report_interval, 12,
+    "Number of heartbeats with drive data after which the storage metadata of every tablet is "
+    "reported to master again. In between, only the tablets whose storage metadata changed are "
+    "reported. Storage metadata of every tablet is also reported after a full tablet report. "
+    "1 or less reports every tablet each time.");
+TAG_FLAG(tserver_heartbeat_metrics_full_storage_report_interval, advanced);
+
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 
 using namespace std::literals;
@@ -73,6 +81,27 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   bool should_add_replication_status =
       FLAGS_tserver_heartbeat_metrics_add_replication_status && no_full_tablet_report;
 
+  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
+  double_t div = diff.ToSeconds();
+  auto ops_per_sec = [div](uint64_t num_ops, uint64_t prev_ops) {
+    return div > 0 && num_ops > prev_ops ? static_cast<double>(num_ops - prev_ops) / div : 0;
+  };
+  std::unordered_map<TabletId, std::pair<uint64_t, uint64_t>> tablet_ops;
+
+  // The master keeps the storage metadata of a replica until it is reported again. A full tablet
+  // report may come from a new master leader, which has none, so report every tablet next time.
+  bool full_storage_report = false;
+  if (should_add_tablet_data) {
+    if (++storage_reports_since_full_ >=
+            FLAGS_tserver_heartbeat_metrics_full_storage_report_interval) {
+      full_storage_report = true;
+      storage_reports_since_full_ = 0;
+    }
+  } else if (!no_full_tablet_report) {
+    prev_storage_reports_.clear();
+  }
+  std::unordered_map<TabletId, TabletStorageReport> storage_reports;
+
   for (const auto& tablet_peer : server().tablet_manager()->GetTabletPeers()) {
     if (tablet_peer) {
       auto tablet = tablet_peer->shared_tablet();
@@ -81,16 +110,41 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
         total_file_sizes += sizes.first;
         uncompressed_file_sizes += sizes.second;
         num_files += tablet->GetCurrentVersionNumSSTFiles();
+        auto* tablet_metrics = tablet->metrics();
+        const auto num_tablet_reads =
+            tablet_metrics ? tablet_metrics->ql_read_latency->TotalCount() : 0;
+        const auto num_tablet_writes =
+            tablet_metrics ? tablet_metrics->ql_write_latency->TotalCount() : 0;
+        tablet_ops.emplace(
+            tablet_peer->tablet_id(), std::pair(num_tablet_reads, num_tablet_writes));
         if (should_add_tablet_data && tablet_peer->log_available() &&
             tablet_peer->tablet_metadata()->tablet_data_state() ==
               tablet::TabletDataState::TABLET_DATA_READY) {
-          auto tablet_metadata = req->add_storage_metadata();
-          tablet_metadata->set_tablet_id(tablet_peer->tablet_id());
-          tablet_metadata->set_sst_file_size(sizes.first);
-          tablet_metadata->set_wal_file_size(tablet_peer->log()->OnDiskSize());
-          tablet_metadata->set_uncompressed_sst_file_size(sizes.second);
-          tablet_metadata->set_may_have_orphaned_post_split_data(
-                tablet->MayHaveOrphanedPostSplitData());
+          TabletStorageReport report {
+            .sst_file_size = sizes.first,
+            .wal_file_size = tablet_peer->log()->OnDiskSize(),
+            .uncompressed_sst_file_size = sizes.second,
+            .may_have_orphaned_post_split_data = tablet->MayHaveOrphanedPostSplitData(),
+          };
+          auto prev_it = prev_tablet_ops_.find(tablet_peer->tablet_id());
+          if (prev_it != prev_tablet_ops_.end()) {
+            report.read_ops_per_sec = ops_per_sec(num_tablet_reads, prev_it->second.first);
+            report.write_ops_per_sec = ops_per_sec(num_tablet_writes, prev_it->second.second);
+          }
+          auto prev_report_it = prev_storage_reports_.find(tablet_peer->tablet_id());
+          if (full_storage_report || prev_report_it == prev_storage_reports_.end() ||
+              !(prev_report_it->second == report)) {
+            auto tablet_metadata = req->add_storage_metadata();
+            tablet_metadata->set_tablet_id(tablet_peer->tablet_id());
+            tablet_metadata->set_sst_file_size(report.sst_file_size);
+            tablet_metadata->set_wal_file_size(report.wal_file_size);
+            tablet_metadata->set_uncompressed_sst_file_size(report.uncompressed_sst_file_size);
+            tablet_metadata->set_may_have_orphaned_post_split_data(
+                report.may_have_orphaned_post_split_data);
+            tablet_metadata->set_read_ops_per_sec(report.read_ops_per_sec);
+            tablet_metadata->set_write_ops_per_sec(report.write_ops_per_sec);
+          }
+          storage_reports.emplace(tablet_peer->tablet_id(), report);
         }
       }
     }
@@ -149,9 +203,6 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
   uint64_t num_writes = (writes_hist != nullptr) ? writes_hist->TotalCount() : 0;
 
   // Calculate the read and write ops per second.
-  MonoDelta diff = CoarseMonoClock::Now() - prev_run_time();
-  double_t div = diff.ToSeconds();
-
   double rops_per_sec = (div > 0 && num_reads > 0) ?
       (static_cast<double>(num_reads - prev_reads_) / div) : 0;
 
@@ -160,6 +211,10 @@ void TServerMetricsHeartbeatDataProvider::DoAddData(
 
   prev_reads_ = num_reads;
   prev_writes_ = num_writes;
+  prev_tablet_ops_ = std::move(tablet_ops);
+  if (should_add_tablet_data) {
+    prev_storage_reports_ = std::move(storage_reports);
+  }
   metrics->set_read_ops_per_sec(rops_per_sec);
   metrics->set_write_ops_per_sec(wops_per_sec);
   uint64_t uptime_seconds = CalculateUptime();
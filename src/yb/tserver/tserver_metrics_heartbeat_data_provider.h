@@ -14,6 +14,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
 #include "yb/tserver/heartbeater.h"
@@ -31,12 +32,32 @@ class TServerMetricsHeartbeatDataProvider : public PeriodicalHeartbeatDataProvid
 
   uint64_t CalculateUptime();
 
+  // Storage metadata reported for a tablet, used to only report tablets whose metadata changed.
+  struct TabletStorageReport {
+    uint64_t sst_file_size = 0;
+    uint64_t wal_file_size = 0;
+    uint64_t uncompressed_sst_file_size = 0;
+    bool may_have_orphaned_post_split_data = true;
+    double read_ops_per_sec = 0;
+    double write_ops_per_sec = 0;
+
+    bool operator==(const TabletStorageReport&) const = default;
+  };
+
   MonoTime start_time_;
 
   // Stores the total read and writes ops for computing iops.
   uint64_t prev_reads_ = 0;
   uint64_t prev_writes_ = 0;
 
+  // Stores the total read and write ops of every tablet for computing per tablet iops.
+  std::unordered_map<TabletId, std::pair<uint64_t, uint64_t>> prev_tablet_ops_;
+
+  // Stores the last storage metadata reported for every tablet.
+  std::unordered_map<TabletId, TabletStorageReport> prev_storage_reports_;
+  // Number of storage reports since storage metadata of every tablet was last reported.
+  int storage_reports_since_full_ = 0;
+
   // Stores the previously reported replication errors.
   cdc::TabletReplicationErrorMap prev_replication_error_map_;
 };
@@ -59,6 +59,14 @@ METRIC_DEFINE_counter(server, block_cache_hits_caching,
                       "Number of lookups that were expecting a block that found one."
                       "Use this number instead of cache_hits when trying to determine how "
                       "efficient the cache is");
+METRIC_DEFINE_counter(server, block_cache_single_touch_ghost_hits,
+                      "Block Cache Single Touch Ghost Hits", yb::MetricUnit::kBlocks,
+                      "Number of inserted blocks that were recently evicted from the single touch "
+                      "cache. Used by adaptive cache policy to grow the single touch cache.");
+METRIC_DEFINE_counter(server, block_cache_multi_touch_ghost_hits,
+                      "Block Cache Multi Touch Ghost Hits", yb::MetricUnit::kBlocks,
+                      "Number of inserted blocks that were recently evicted from the multi touch "
+                      "cache. Used by adaptive cache policy to grow the multi touch cache.");
 
 METRIC_DEFINE_gauge_uint64(server, block_cache_usage, "Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
@@ -71,6 +79,11 @@ METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_usage,
                            "Multi Cache Block Cache Memory Usage",
                            yb::MetricUnit::kBytes,
                            "Memory consumed by the multi cache block cache");
+METRIC_DEFINE_gauge_uint64(server, block_cache_multi_touch_capacity,
+                           "Multi Touch Block Cache Capacity",
+                           yb::MetricUnit::kBytes,
+                           "Current capacity of the multi touch block cache. Changes over time "
+                           "when cache_adaptive_single_touch is enabled");
 namespace yb {
 
 #define MINIT(member, x) member(METRIC_##x.Instantiate(entity))
@@ -83,9 +96,12 @@ CacheMetrics::CacheMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(cache_hits_caching, block_cache_hits_caching),
     MINIT(cache_misses, block_cache_misses),
     MINIT(cache_misses_caching, block_cache_misses_caching),
+    MINIT(single_touch_ghost_hits, block_cache_single_touch_ghost_hits),
+    MINIT(multi_touch_ghost_hits, block_cache_multi_touch_ghost_hits),
     GINIT(cache_usage, block_cache_usage),
     GINIT(single_touch_cache_usage, block_cache_single_touch_usage),
-    GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage) {
+    GINIT(multi_touch_cache_usage, block_cache_multi_touch_usage),
+    GINIT(multi_touch_cache_capacity, block_cache_multi_touch_capacity) {
 }
 #undef MINIT
 #undef GINIT
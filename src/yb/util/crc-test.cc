@@ -74,6 +74,19 @@ TEST_F(CrcTest, TestCRC32C) {
   ASSERT_EQ(0xa9421b7, data_crc); // Known value from crcutil usage test program.
 }
 
+// Crc32c could use a different implementation than the crcutil instance, results should match.
+TEST_F(CrcTest, TestCrc32cMatchesInstance) {
+  std::string data;
+  for (size_t i = 0; i != 1000; ++i) {
+    data.push_back(static_cast<char>(i * 131 + 7));
+  }
+  for (size_t length : {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 999, 1000}) {
+    uint64_t expected = 0;
+    GetCrc32cInstance()->Compute(data.data(), length, &expected);
+    ASSERT_EQ(expected, Crc32c(data.data(), length)) << "Length: " << length;
+  }
+}
+
 // Simple benchmark of CRC32C throughput.
 // We should expect about 8 bytes per cycle in throughput on a single core.
 TEST_F(CrcTest, BenchmarkCRC32C) {
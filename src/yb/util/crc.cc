@@ -31,6 +31,11 @@
 //
 #include "yb/util/crc.h"
 
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#include <string.h>
+#endif
+
 #include <crcutil/interface.h>
 
 #include "yb/gutil/once.h"
@@ -55,11 +60,51 @@ Crc* GetCrc32cInstance() {
   return crc32c_instance;
 }
 
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+
+namespace {
+
+// crcutil uses hardware instructions only on x86, so ARM builds use the CRC32 instructions
+// directly. They are mandatory since ARMv8.1, and the build targets ARMv8.2.
+uint32_t Crc32cArm(const uint8_t* data, size_t length) {
+  uint32_t crc = 0xffffffffu;
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc = __crc32cd(crc, word);
+    data += 8;
+    length -= 8;
+  }
+  if (length >= 4) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    crc = __crc32cw(crc, word);
+    data += 4;
+    length -= 4;
+  }
+  while (length > 0) {
+    crc = __crc32cb(crc, *data);
+    ++data;
+    --length;
+  }
+  return crc ^ 0xffffffffu;
+}
+
+} // namespace
+
+uint32_t Crc32c(const void* data, size_t length) {
+  return Crc32cArm(static_cast<const uint8_t*>(data), length);
+}
+
+#else
+
 uint32_t Crc32c(const void* data, size_t length) {
   uint64_t crc32 = 0;
   GetCrc32cInstance()->Compute(data, length, &crc32);
   return static_cast<uint32_t>(crc32); // Only uses lower 32 bits.
 }
 
+#endif
+
 } // namespace crc
 } // namespace yb
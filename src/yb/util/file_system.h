@@ -171,6 +171,10 @@ class RandomAccessFile : public FileWithUniqueId {
   // For cases when read-ahead is implemented in the platform dependent layer.
   virtual void EnableReadAhead() {}
 
+  // Hints that the specified range of the file will be read soon, so the platform could start
+  // reading it in the background. Does not wait for the data.
+  virtual void Prefetch(uint64_t offset, size_t length) const {}
+
   // For documentation, refer to FileWithUniqueId::GetUniqueId()
   virtual size_t GetUniqueId(char* id) const override {
     return 0; // Default implementation to prevent issues with backwards compatibility.
@@ -382,6 +386,10 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void EnableReadAhead() override { return target_->EnableReadAhead(); }
 
+  void Prefetch(uint64_t offset, size_t length) const override {
+    target_->Prefetch(offset, length);
+  }
+
   size_t GetUniqueId(char* id) const override {
     return target_->GetUniqueId(id);
   }
@@ -257,6 +257,13 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Prefetch(uint64_t offset, size_t length) const {
+#ifdef __linux__
+  // POSIX_FADV_WILLNEED only starts the readahead of the range into the page cache.
+  Fadvise(fd_, offset, length, POSIX_FADV_WILLNEED);
+#endif
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();
@@ -62,6 +62,7 @@ class PosixRandomAccessFile : public RandomAccessFile {
 #endif
   virtual void Hint(AccessPattern pattern) override;
   virtual Status InvalidateCache(size_t offset, size_t length) override;
+  void Prefetch(uint64_t offset, size_t length) const override;
 
  private:
   std::string filename_;
@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -45,6 +46,7 @@
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
 DECLARE_int64(mem_tracker_tcmalloc_gc_release_bytes);
+DECLARE_int64(mem_tracker_per_cpu_drift_bytes);
 
 namespace yb {
 
@@ -363,6 +365,37 @@ TEST(MemTrackerTest, TcMallocGC) {
 }
 #endif
 
+TEST(MemTrackerTest, PerCpuConsumption) {
+  FLAGS_mem_tracker_per_cpu_drift_bytes = 1_KB;
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker(1_MB, "parent");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker("child", p);
+  FLAGS_mem_tracker_per_cpu_drift_bytes = 0;
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumIters = 10000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([c] {
+      for (int j = 0; j != kNumIters; ++j) {
+        c->Consume(10);
+        c->Release(7);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Both the tracker with a limit and the one accumulated per CPU report the exact value once
+  // updates are done.
+  ASSERT_EQ(p->consumption(), kNumThreads * kNumIters * 3);
+  ASSERT_EQ(c->consumption(), kNumThreads * kNumIters * 3);
+  ASSERT_FALSE(p->LimitExceeded());
+  c->Release(kNumThreads * kNumIters * 3);
+  ASSERT_EQ(p->consumption(), 0);
+  ASSERT_EQ(c->consumption(), 0);
+}
+
 TEST(MemTrackerTest, UnregisterFromParent) {
   shared_ptr<MemTracker> p = MemTracker::CreateTracker("parent");
   shared_ptr<MemTracker> c = MemTracker::CreateTracker("child", p);
@@ -32,11 +32,15 @@
 
 #include "yb/util/mem_tracker.h"
 
+#include <sched.h>
+
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 
 #ifdef YB_TCMALLOC_ENABLED
 #if defined(YB_GOOGLE_TCMALLOC)
@@ -49,8 +53,10 @@
 
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/once.h"
+#include "yb/gutil/port.h"
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
@@ -143,6 +149,12 @@ DEFINE_RUNTIME_int64(mem_tracker_tcmalloc_gc_release_bytes, -1,
     "page heap freelist. A higher value implies less aggressive GC, i.e. higher memory "
     "overhead, but more efficient in terms of runtime.");
 
+DEFINE_NON_RUNTIME_int64(mem_tracker_per_cpu_drift_bytes, 0,
+    "When positive, trackers without a limit accumulate consumption changes per CPU and fold "
+    "them into the shared counter only once a CPU has this many bytes pending, so that hot "
+    "trackers do not bounce one cache line between cores. Their consumption may then be off by "
+    "up to this value times the number of CPUs. Trackers with a limit are always exact.");
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -453,6 +465,11 @@ shared_ptr<MemTracker> MemTracker::CreateChild(int64_t byte_limit,
   return result;
 }
 
+struct MemTracker::PerCpuCell {
+  std::atomic<int64_t> value{0};
+  char pad[CACHELINE_SIZE - sizeof(std::atomic<int64_t>)];
+} CACHELINE_ALIGNED;
+
 MemTracker::MemTracker(int64_t byte_limit, const string& id,
                        ConsumptionFunctor consumption_functor, std::shared_ptr<MemTracker> parent,
                        AddToParent add_to_parent, CreateMetrics create_metrics)
@@ -469,6 +486,12 @@ MemTracker::MemTracker(int64_t byte_limit, const string& id,
   VLOG(1) << "Creating tracker " << ToString();
   UpdateConsumption();
 
+  if (FLAGS_mem_tracker_per_cpu_drift_bytes > 0 && !has_limit() && !consumption_functor_) {
+    num_cpus_ = base::MaxCPUIndex() + 1;
+    per_cpu_drift_bytes_ = FLAGS_mem_tracker_per_cpu_drift_bytes;
+    per_cpu_consumption_.reset(new PerCpuCell[num_cpus_]);
+  }
+
   all_trackers_.push_back(this);
   if (has_limit()) {
     limit_trackers_.push_back(this);
@@ -616,6 +639,36 @@ bool MemTracker::UpdateConsumption(bool force) {
   return false;
 }
 
+void MemTracker::IncrementConsumption(int64_t bytes) {
+  if (per_cpu_consumption_) {
+#if defined(__APPLE__)
+    // OSX doesn't have a way to get the CPU, so we'll pick one by thread.
+    size_t cpu = std::hash<std::thread::id>()(std::this_thread::get_id()) % num_cpus_;
+#else
+    size_t cpu = sched_getcpu();
+    DCHECK_LT(cpu, num_cpus_);
+#endif // defined(__APPLE__)
+    auto& cell = per_cpu_consumption_[cpu].value;
+    auto pending = cell.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (std::abs(pending) < per_cpu_drift_bytes_) {
+      return;
+    }
+    bytes = cell.exchange(0, std::memory_order_acq_rel);
+    if (bytes == 0) {
+      return;
+    }
+  }
+  IncrementBy(bytes, &consumption_, metrics_);
+}
+
+int64_t MemTracker::PerCpuConsumption() const {
+  int64_t result = 0;
+  for (size_t i = 0; i != num_cpus_; ++i) {
+    result += per_cpu_consumption_[i].value.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
 void MemTracker::Consume(int64_t bytes) {
   if (bytes < 0) {
     Release(-bytes);
@@ -633,8 +686,8 @@ void MemTracker::Consume(int64_t bytes) {
   }
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
-      IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
+      tracker->IncrementConsumption(bytes);
+      DCHECK(tracker->per_cpu_consumption_ || tracker->consumption_.current_value() >= 0);
     }
   }
 }
@@ -654,7 +707,7 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   for (i = all_trackers_.size() - 1; i >= 0; --i) {
     MemTracker *tracker = all_trackers_[i];
     if (tracker->limit_ < 0) {
-      IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
+      tracker->IncrementConsumption(bytes);
     } else {
       if (!TryIncrementBy(bytes, tracker->limit_, &tracker->consumption_, tracker->metrics_)) {
         // One of the trackers failed, attempt to GC memory or expand our limit. If that
@@ -685,7 +738,7 @@ bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
   // to adjust the consumption of the query tracker to stop the resource from never
   // getting used by a subsequent TryConsume()?
   for (ssize_t j = all_trackers_.size(); --j > i;) {
-    IncrementBy(-bytes, &all_trackers_[j]->consumption_, all_trackers_[j]->metrics_);
+    all_trackers_[j]->IncrementConsumption(-bytes);
   }
   if (blocking_mem_tracker) {
     *blocking_mem_tracker = all_trackers_[i];
@@ -718,14 +771,15 @@ void MemTracker::Release(int64_t bytes) {
 
   for (auto& tracker : all_trackers_) {
     if (!tracker->UpdateConsumption()) {
-      IncrementBy(-bytes, &tracker->consumption_, tracker->metrics_);
+      tracker->IncrementConsumption(-bytes);
       // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
       // reported amount, the subsequent call to FunctionContext::Free() may cause the
       // process mem tracker to go negative until it is synced back to the tcmalloc
       // metric. Don't blow up in this case. (Note that this doesn't affect non-process
       // trackers since we can enforce that the reported memory usage is internally
       // consistent.)
-      DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
+      DCHECK(tracker->per_cpu_consumption_ || tracker->consumption_.current_value() >= 0)
+          << "Tracker: " << tracker->ToString();
     }
   }
 }
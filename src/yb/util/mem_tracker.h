@@ -354,7 +354,7 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   // Returns the memory consumed in bytes.
   int64_t consumption() const {
-    return consumption_.current_value();
+    return consumption_.current_value() + (per_cpu_consumption_ ? PerCpuConsumption() : 0);
   }
 
   int64_t GetUpdatedConsumption(bool force = false) {
@@ -409,6 +409,15 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   }
 
  private:
+  struct PerCpuCell;
+
+  // Adds 'bytes' to the consumption of this tracker only, through the per CPU cells when they are
+  // used.
+  void IncrementConsumption(int64_t bytes);
+
+  // Sum of the consumption accumulated in the per CPU cells and not folded yet.
+  int64_t PerCpuConsumption() const;
+
   bool CheckLimitExceeded() const {
     return limit_ >= 0 && limit_ < consumption();
   }
@@ -461,6 +470,12 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_{0};
 
+  // Consumption changes of trackers without a limit are accumulated per CPU, and folded into
+  // consumption_ once the cell reaches mem_tracker_per_cpu_drift_bytes. Null when not used.
+  std::unique_ptr<PerCpuCell[]> per_cpu_consumption_;
+  size_t num_cpus_ = 0;
+  int64_t per_cpu_drift_bytes_ = 0;
+
   // this tracker plus all of its ancestors
   std::vector<MemTracker*> all_trackers_;
   // all_trackers_ with valid limits
@@ -267,6 +267,30 @@ TEST(TestArena, TestToShared) {
   ASSERT_EQ(1, ca.counter);
 }
 
+TEST(TestArena, TestThreadCachedBlocks) {
+  const void* first_block;
+  {
+    auto arena = SharedArena();
+    first_block = arena->AllocateBytes(1);
+  }
+  {
+    // The block of the destroyed arena is reused by the next one created on the same thread.
+    auto arena = SharedArena();
+    ASSERT_EQ(first_block, arena->AllocateBytes(1));
+  }
+
+  {
+    ThreadSafeArena arena(ThreadCachedBufferAllocator::Get());
+    first_block = arena.AllocateBytes(1);
+    // Blocks past the first one are not cached, but still come from the heap.
+    for (int i = 0; i != 10; ++i) {
+      ASSERT_NE(arena.AllocateBytes(Arena::kStartBlockSize), nullptr);
+    }
+  }
+  ThreadSafeArena arena(ThreadCachedBufferAllocator::Get());
+  ASSERT_EQ(first_block, arena.AllocateBytes(1));
+}
+
 TEST(TestArena, TestVector) {
   CountedArena ca;
   MCVector<Trackable> vector(&ca);
@@ -53,6 +53,10 @@ DEFINE_UNKNOWN_uint64(arena_warn_threshold_bytes, 256*1024*1024,
              "Number of bytes beyond which to emit a warning for a large arena");
 TAG_FLAG(arena_warn_threshold_bytes, hidden);
 
+DEFINE_RUNTIME_uint32(arena_thread_cache_blocks, 16,
+    "Number of first blocks of destroyed short lived arenas that each thread keeps for reuse "
+    "by the next arenas it creates. 0 disables the cache.");
+
 namespace yb {
 namespace internal {
 
@@ -284,13 +288,71 @@ template class ArenaBase<ArenaTraits>;
 
 namespace {
 
+// Set when the block cache of the current thread is destroyed, so blocks freed later during thread
+// exit go back to malloc.
+thread_local bool arena_block_cache_destroyed = false;
+
+// Keeps kStartBlockSize blocks of destroyed arenas, so that arenas created and destroyed per
+// request reuse them instead of going to malloc for their first block.
+class ArenaBlockCache {
+ public:
+  ~ArenaBlockCache() {
+    for (auto* block : blocks_) {
+      free(block);
+    }
+    arena_block_cache_destroyed = true;
+  }
+
+  void* Allocate() {
+    if (blocks_.empty()) {
+      return malloc(Arena::kStartBlockSize);
+    }
+    auto* result = blocks_.back();
+    blocks_.pop_back();
+    return result;
+  }
+
+  void Free(void* block) {
+    if (blocks_.size() >= FLAGS_arena_thread_cache_blocks) {
+      free(block);
+      return;
+    }
+    // The arena that used the block could have left parts of it poisoned.
+    ASAN_UNPOISON_MEMORY_REGION(block, Arena::kStartBlockSize);
+    blocks_.push_back(block);
+  }
+
+ private:
+  std::vector<void*> blocks_;
+};
+
+ArenaBlockCache& ThreadArenaBlockCache() {
+  static thread_local ArenaBlockCache cache;
+  return cache;
+}
+
+void* AllocateArenaBlock() {
+  if (PREDICT_FALSE(arena_block_cache_destroyed)) {
+    return malloc(Arena::kStartBlockSize);
+  }
+  return ThreadArenaBlockCache().Allocate();
+}
+
+void FreeArenaBlock(void* block) {
+  if (PREDICT_FALSE(arena_block_cache_destroyed)) {
+    free(block);
+    return;
+  }
+  ThreadArenaBlockCache().Free(block);
+}
+
 struct AllocatedBuffer {
   char* address = nullptr;
   size_t size = std::numeric_limits<size_t>::max();
 
   char* Allocate(size_t bytes, size_t alignment) {
     auto allocation_size = Arena::kStartBlockSize;
-    auto* allocated = static_cast<char*>(malloc(allocation_size));
+    auto* allocated = static_cast<char*>(AllocateArenaBlock());
     auto* result = align_up(allocated, alignment);
     address = align_up(pointer_cast<char*>(result + bytes), 16);
     size = allocated + allocation_size - address;
@@ -328,7 +390,7 @@ class SharedArenaAllocator {
   }
 
   void deallocate(pointer p, size_type n) {
-    free(p);
+    FreeArenaBlock(p);
   }
 
   template<class... Args>
@@ -364,6 +426,35 @@ class PreallocatedArena {
 
 } // namespace
 
+ThreadCachedBufferAllocator* ThreadCachedBufferAllocator::Get() {
+  return Singleton<ThreadCachedBufferAllocator>::get();
+}
+
+Buffer ThreadCachedBufferAllocator::AllocateInternal(
+    size_t requested, size_t minimal, BufferAllocator* originator) {
+  if (requested != Arena::kStartBlockSize) {
+    return DelegateAllocate(HeapBufferAllocator::Get(), requested, minimal, originator);
+  }
+  auto* data = AllocateArenaBlock();
+  if (data == nullptr) {
+    return Buffer();
+  }
+  return CreateBuffer(data, requested, originator);
+}
+
+bool ThreadCachedBufferAllocator::ReallocateInternal(
+    size_t requested, size_t minimal, Buffer* buffer, BufferAllocator* originator) {
+  return DelegateReallocate(HeapBufferAllocator::Get(), requested, minimal, buffer, originator);
+}
+
+void ThreadCachedBufferAllocator::FreeInternal(Buffer* buffer) {
+  if (buffer->size() != Arena::kStartBlockSize) {
+    DelegateFree(HeapBufferAllocator::Get(), buffer);
+    return;
+  }
+  FreeArenaBlock(buffer->data());
+}
+
 std::shared_ptr<ThreadSafeArena> SharedArena() {
   AllocatedBuffer buffer;
   SharedArenaAllocator<Arena> allocator(&buffer);
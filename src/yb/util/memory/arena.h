@@ -482,8 +482,30 @@ std::shared_ptr<Result> ArenaMakeShared(
   return std::shared_ptr<Result>(arena, result);
 }
 
+// Returns an arena whose first block is taken from, and returned to, a per-thread cache of blocks,
+// so creating and destroying it per request does not go to malloc in the steady state.
 std::shared_ptr<ThreadSafeArena> SharedArena();
 
+// Buffer allocator that takes blocks of the default first block size of an arena from the same
+// per-thread cache as SharedArena. Other sizes go to HeapBufferAllocator. Use it for arenas that
+// are embedded into objects created per request.
+class ThreadCachedBufferAllocator : public BufferAllocator {
+ public:
+  static ThreadCachedBufferAllocator* Get();
+
+ private:
+  friend class Singleton<ThreadCachedBufferAllocator>;
+
+  ThreadCachedBufferAllocator() = default;
+
+  Buffer AllocateInternal(size_t requested, size_t minimal, BufferAllocator* originator) override;
+
+  bool ReallocateInternal(
+      size_t requested, size_t minimal, Buffer* buffer, BufferAllocator* originator) override;
+
+  void FreeInternal(Buffer* buffer) override;
+};
+
 } // namespace yb
 
 template<class Traits>
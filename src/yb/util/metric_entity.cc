@@ -279,9 +279,9 @@ Status MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
   }
   bool select_all = MatchMetricInList(id(), entity_options.metrics);
 
-  // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
-  typedef std::map<const char*, scoped_refptr<Metric> > OrderedMetricMap;
-  OrderedMetricMap metrics;
+  // Prometheus does not care about the order of the entries, and table level metrics are rolled
+  // up by the writer anyway, so a vector is enough here.
+  std::vector<std::pair<const char*, scoped_refptr<Metric>>> metrics;
   AttributeMap attrs;
   std::vector<ExternalPrometheusMetricsCb> external_metrics_cbs;
   {
@@ -290,12 +290,13 @@ Status MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
     std::lock_guard<simple_spinlock> l(lock_);
     attrs = attributes_;
     external_metrics_cbs = external_prometheus_metrics_cbs_;
+    metrics.reserve(metric_map_.size());
     for (const auto& [prototype, metric] : metric_map_) {
       if (MatchMetricInList(prototype->name(), entity_options.exclude_metrics)) {
         continue;
       }
       if (select_all || MatchMetricInList(prototype->name(), entity_options.metrics)) {
-        InsertOrDie(&metrics, prototype->name(), metric);
+        metrics.emplace_back(prototype->name(), metric);
       }
     }
   }
@@ -339,9 +340,9 @@ Status MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
   prometheus_attr["metric_type"] = prototype_->name();
   prometheus_attr["exported_instance"] = FLAGS_metric_node_name;
 
-  for (OrderedMetricMap::value_type& val : metrics) {
-    WARN_NOT_OK(val.second->WriteForPrometheus(writer, prometheus_attr, opts),
-                Format("Failed to write $0 as Prometheus", val.first));
+  for (const auto& [name, metric] : metrics) {
+    WARN_NOT_OK(metric->WriteForPrometheus(writer, prometheus_attr, opts),
+                Format("Failed to write $0 as Prometheus", name));
   }
   // Run the external metrics collection callback if there is one set.
   for (const ExternalPrometheusMetricsCb& cb : external_metrics_cbs) {
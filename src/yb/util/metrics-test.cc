@@ -32,6 +32,7 @@
 
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -231,6 +232,9 @@ TEST_F(MetricsTest, TEstExposeGaugeAsCounter) {
 METRIC_DEFINE_histogram_with_percentiles(test_entity, test_hist, "Test Histogram",
                         MetricUnit::kMilliseconds, "A default histogram.", 100000000L, 2);
 
+METRIC_DEFINE_sharded_histogram_with_percentiles(test_entity, test_sharded_hist,
+    "Test Sharded Histogram", MetricUnit::kMilliseconds, "A sharded histogram.", 100000000L, 2);
+
 METRIC_DEFINE_entity(tablet);
 
 METRIC_DEFINE_gauge_int32(tablet, test_sum_gauge, "Test Sum Gauge", MetricUnit::kMilliseconds,
@@ -356,6 +360,40 @@ TEST_F(MetricsTest, ResetHistogramTest) {
   EXPECT_EQ(0, hist->histogram_->ValueAtPercentile(100));
 }
 
+TEST_F(MetricsTest, ShardedHistogramTest) {
+  scoped_refptr<Histogram> hist = METRIC_test_sharded_hist.Instantiate(entity_);
+  constexpr int kNumThreads = 8;
+  constexpr int kValuesPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i != kNumThreads; ++i) {
+    threads.emplace_back([&hist] {
+      for (int value = 1; value <= kValuesPerThread; ++value) {
+        hist->Increment(value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(kNumThreads * kValuesPerThread, hist->TotalCount());
+  ASSERT_EQ(1, hist->MinValueForTests());
+  ASSERT_EQ(kValuesPerThread, hist->MaxValueForTests());
+  ASSERT_EQ((kValuesPerThread + 1) / 2.0, hist->MeanValueForTests());
+
+  HistogramSnapshotPB snapshot_pb;
+  MetricJsonOptions options;
+  ASSERT_OK(hist->GetAndResetHistogramSnapshotPB(&snapshot_pb, options));
+  ASSERT_EQ(kNumThreads * kValuesPerThread, snapshot_pb.total_count());
+  ASSERT_EQ(kNumThreads * kValuesPerThread * (kValuesPerThread + 1) / 2, snapshot_pb.total_sum());
+  ASSERT_EQ(1, snapshot_pb.min());
+  ASSERT_EQ(kValuesPerThread, snapshot_pb.max());
+
+  // Percentiles are reset in all shards, while the total count is kept.
+  ASSERT_EQ(0, hist->Snapshot()->CurrentCount());
+  ASSERT_EQ(kNumThreads * kValuesPerThread, hist->TotalCount());
+}
+
 TEST_F(MetricsTest, JsonPrintTest) {
   scoped_refptr<Counter> bytes_seen = METRIC_reqs_pending.Instantiate(entity_);
   bytes_seen->Increment();
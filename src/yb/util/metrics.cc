@@ -32,12 +32,16 @@
 
 #include "yb/util/metrics.h"
 
+#include <sched.h>
+
 #include <map>
 #include <set>
+#include <thread>
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/util/hdr_histogram.h"
 #include "yb/util/histogram.pb.h"
@@ -53,6 +57,10 @@ DEFINE_UNKNOWN_bool(expose_metric_histogram_percentiles, true,
 DEFINE_UNKNOWN_int32(max_tables_metrics_breakdowns, INT32_MAX,
              "The maxmimum number of tables to retrieve metrics for");
 
+DEFINE_NON_RUNTIME_int32(histogram_max_shards, 8,
+    "Maximum number of per-CPU shards of a sharded histogram metric. Each shard is allocated "
+    "on the first value recorded on its CPUs. 0 or 1 turns sharding off.");
+
 // Process/server-wide metrics should go into the 'server' entity.
 // More complex applications will define other entities.
 METRIC_DEFINE_entity(server);
@@ -519,11 +527,13 @@ Status AtomicMillisLag::WriteAsJson(JsonWriter* writer, const MetricJsonOptions&
 
 HistogramPrototype::HistogramPrototype(const MetricPrototype::CtorArgs& args,
                                        uint64_t max_trackable_value, int num_sig_digits,
-                                       ExportPercentiles export_percentiles)
+                                       ExportPercentiles export_percentiles,
+                                       ShardedHistogram sharded)
   : MetricPrototype(args),
     max_trackable_value_(max_trackable_value),
     num_sig_digits_(num_sig_digits),
-    export_percentiles_(export_percentiles) {
+    export_percentiles_(export_percentiles),
+    sharded_(sharded) {
   // Better to crash at definition time that at instantiation time.
   CHECK(HdrHistogram::IsValidHighestTrackableValue(max_trackable_value))
       << Substitute("Invalid max trackable value on histogram $0: $1",
@@ -546,6 +556,7 @@ Histogram::Histogram(const HistogramPrototype* proto)
   : Metric(proto),
     histogram_(new HdrHistogram(proto->max_trackable_value(), proto->num_sig_digits())),
     export_percentiles_(proto->export_percentiles()) {
+  InitShards(proto->sharded());
 }
 
 Histogram::Histogram(
@@ -554,14 +565,78 @@ Histogram::Histogram(
   : Metric(std::move(proto)),
     histogram_(new HdrHistogram(highest_trackable_value, num_significant_digits)),
     export_percentiles_(export_percentiles) {
+  InitShards(down_cast<const HistogramPrototype*>(prototype_)->sharded());
+}
+
+Histogram::~Histogram() {
+  for (size_t i = 0; i != num_shards_; ++i) {
+    delete shards_[i].load(std::memory_order_acquire);
+  }
+}
+
+void Histogram::InitShards(ShardedHistogram sharded) {
+  if (!sharded || FLAGS_histogram_max_shards <= 1) {
+    return;
+  }
+  num_shards_ = std::min<size_t>(FLAGS_histogram_max_shards, base::MaxCPUIndex() + 1);
+  shards_.reset(new std::atomic<HdrHistogram*>[num_shards_]);
+  for (size_t i = 0; i != num_shards_; ++i) {
+    shards_[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+HdrHistogram* Histogram::CurrentShard() {
+  if (num_shards_ == 0) {
+    return histogram_.get();
+  }
+#if defined(__APPLE__)
+  // OSX doesn't have a way to get the CPU, so we'll pick a shard by thread.
+  size_t cpu = std::hash<std::thread::id>()(std::this_thread::get_id());
+#else
+  size_t cpu = sched_getcpu();
+#endif // defined(__APPLE__)
+  auto& shard = shards_[cpu % num_shards_];
+  auto* result = shard.load(std::memory_order_acquire);
+  if (PREDICT_TRUE(result)) {
+    return result;
+  }
+  auto* created = new HdrHistogram(
+      histogram_->highest_trackable_value(), histogram_->num_significant_digits());
+  if (shard.compare_exchange_strong(result, created, std::memory_order_acq_rel)) {
+    return created;
+  }
+  // Another thread installed the shard first.
+  delete created;
+  return result;
+}
+
+std::unique_ptr<HdrHistogram> Histogram::Snapshot() const {
+  auto result = std::make_unique<HdrHistogram>(*histogram_);
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result->MergeFrom(*shard);
+    }
+  }
+  return result;
+}
+
+void Histogram::ResetPercentiles() const {
+  histogram_->ResetPercentiles();
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      shard->ResetPercentiles();
+    }
+  }
 }
 
 void Histogram::Increment(int64_t value) {
-  histogram_->Increment(value);
+  CurrentShard()->Increment(value);
 }
 
 void Histogram::IncrementBy(int64_t value, int64_t amount) {
-  histogram_->IncrementBy(value, amount);
+  CurrentShard()->IncrementBy(value, amount);
 }
 
 Status Histogram::WriteAsJson(JsonWriter* writer,
@@ -583,28 +658,29 @@ Status Histogram::WriteForPrometheus(
     return Status::OK();
   }
 
-  HdrHistogram snapshot(*histogram_);
+  auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
   // HdrHistogram reports percentiles based on all the data points from the
   // begining of time. We are interested in the percentiles based on just
   // the "newly-arrived" data. So, in the defualt setting, we will reset
   // the histogram's percentiles between each invocation. User also has the
   // option to set the url parameter reset_histograms=false
   if (opts.reset_histograms) {
-    histogram_->ResetPercentiles();
+    ResetPercentiles();
   }
 
   // Representing the sum and count require suffixed names.
   std::string hist_name = prototype_->name();
-  auto copy_of_attr = attr;
   RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_sum", snapshot.TotalSum(),
+        attr, hist_name + "_sum", snapshot.TotalSum(),
         prototype()->aggregation_function()));
   RETURN_NOT_OK(writer->WriteSingleEntry(
-        copy_of_attr, hist_name + "_count", snapshot.TotalCount(),
+        attr, hist_name + "_count", snapshot.TotalCount(),
         prototype()->aggregation_function()));
 
   // Copy the label map to add the quatiles.
   if (export_percentiles_ && FLAGS_expose_metric_histogram_percentiles) {
+    auto copy_of_attr = attr;
     copy_of_attr["quantile"] = "p50";
     RETURN_NOT_OK(writer->WriteSingleEntry(copy_of_attr, hist_name,
                                            snapshot.ValueAtPercentile(50),
@@ -631,14 +707,15 @@ Status Histogram::WriteForPrometheus(
 
 Status Histogram::GetAndResetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_pb,
                                                  const MetricJsonOptions& opts) const {
-  HdrHistogram snapshot(*histogram_);
+  auto snapshot_holder = Snapshot();
+  const HdrHistogram& snapshot = *snapshot_holder;
   // HdrHistogram reports percentiles based on all the data points from the
   // begining of time. We are interested in the percentiles based on just
   // the "newly-arrived" data. So, in the defualt setting, we will reset
   // the histogram's percentiles between each invocation. User also has the
   // option to set the url parameter reset_histograms=false
   if (opts.reset_histograms) {
-    histogram_->ResetPercentiles();
+    ResetPercentiles();
   }
 
   snapshot_pb->set_name(prototype_->name());
@@ -675,22 +752,29 @@ Status Histogram::GetAndResetHistogramSnapshotPB(HistogramSnapshotPB* snapshot_p
 }
 
 uint64_t Histogram::CountInBucketForValueForTests(uint64_t value) const {
-  return histogram_->CountInBucketForValue(value);
+  return Snapshot()->CountInBucketForValue(value);
 }
 
 uint64_t Histogram::TotalCount() const {
-  return histogram_->TotalCount();
+  uint64_t result = histogram_->TotalCount();
+  for (size_t i = 0; i != num_shards_; ++i) {
+    auto* shard = shards_[i].load(std::memory_order_acquire);
+    if (shard) {
+      result += shard->TotalCount();
+    }
+  }
+  return result;
 }
 
 uint64_t Histogram::MinValueForTests() const {
-  return histogram_->MinValue();
+  return Snapshot()->MinValue();
 }
 
 uint64_t Histogram::MaxValueForTests() const {
-  return histogram_->MaxValue();
+  return Snapshot()->MaxValue();
 }
 double Histogram::MeanValueForTests() const {
-  return histogram_->MeanValue();
+  return Snapshot()->MeanValue();
 }
 
 ScopedLatencyMetric::ScopedLatencyMetric(
@@ -239,6 +239,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <set>
@@ -351,6 +352,27 @@
                                       yb::MetricLevel::kInfo),                 \
       2, 1, yb::ExportPercentiles::kFalse)
 
+// Same as the above, but the histogram records into per-CPU shards that are merged when the
+// metric is read. Use these for histograms that are updated concurrently from many threads on
+// the hot path.
+#define METRIC_DEFINE_sharded_histogram_with_percentiles(                      \
+    entity, name, label, unit, desc, max_val, num_sig_digits)                  \
+  ::yb::HistogramPrototype BOOST_PP_CAT(METRIC_, name)(                        \
+      ::yb::MetricPrototype::CtorArgs(BOOST_PP_STRINGIZE(entity),              \
+                                      BOOST_PP_STRINGIZE(name), label, unit,   \
+                                      desc,                                    \
+                                      yb::MetricLevel::kInfo),                 \
+      max_val, num_sig_digits, yb::ExportPercentiles::kTrue,                   \
+      yb::ShardedHistogram::kTrue)
+
+#define METRIC_DEFINE_sharded_coarse_histogram(entity, name, label, unit, desc) \
+  ::yb::HistogramPrototype BOOST_PP_CAT(METRIC_, name)(                        \
+      ::yb::MetricPrototype::CtorArgs(BOOST_PP_STRINGIZE(entity),              \
+                                      BOOST_PP_STRINGIZE(name), label, unit,   \
+                                      desc,                                    \
+                                      yb::MetricLevel::kInfo),                 \
+      2, 1, yb::ExportPercentiles::kFalse, yb::ShardedHistogram::kTrue)
+
 // The following macros act as forward declarations for entity types and metric prototypes.
 #define METRIC_DECLARE_entity(name) \
   extern ::yb::MetricEntityPrototype METRIC_ENTITY_##name
@@ -992,28 +1014,34 @@ inline void IncrementCounterBy(const CounterPtr& counter, int64_t amount) {
 }
 
 YB_STRONGLY_TYPED_BOOL(ExportPercentiles);
+YB_STRONGLY_TYPED_BOOL(ShardedHistogram);
 
 class HistogramPrototype : public MetricPrototype {
  public:
   HistogramPrototype(const MetricPrototype::CtorArgs& args,
                      uint64_t max_trackable_value, int num_sig_digits,
-                     ExportPercentiles export_percentiles = ExportPercentiles::kFalse);
+                     ExportPercentiles export_percentiles = ExportPercentiles::kFalse,
+                     ShardedHistogram sharded = ShardedHistogram::kFalse);
   scoped_refptr<Histogram> Instantiate(const scoped_refptr<MetricEntity>& entity) const;
 
   uint64_t max_trackable_value() const { return max_trackable_value_; }
   int num_sig_digits() const { return num_sig_digits_; }
   ExportPercentiles export_percentiles() const { return export_percentiles_; }
+  ShardedHistogram sharded() const { return sharded_; }
   virtual MetricType::Type type() const override { return MetricType::kHistogram; }
 
  private:
   const uint64_t max_trackable_value_;
   const int num_sig_digits_;
   const ExportPercentiles export_percentiles_;
+  const ShardedHistogram sharded_;
   DISALLOW_COPY_AND_ASSIGN(HistogramPrototype);
 };
 
 class Histogram : public Metric {
  public:
+  ~Histogram();
+
   // Increment the histogram for the given value.
   // 'value' must be non-negative.
   void Increment(int64_t value);
@@ -1041,8 +1069,13 @@ class Histogram : public Metric {
 
   // Returns a pointer to the underlying histogram. The implementation of HdrHistogram
   //   // is thread safe.
+  // For a sharded histogram, this does not include the values recorded in the shards, use
+  // Snapshot() instead.
   const HdrHistogram* histogram() const { return histogram_.get(); }
 
+  // Returns a (non-consistent) copy of the histogram, with the shards merged in.
+  std::unique_ptr<HdrHistogram> Snapshot() const;
+
   uint64_t CountInBucketForValueForTests(uint64_t value) const;
   uint64_t MinValueForTests() const;
   uint64_t MaxValueForTests() const;
@@ -1056,8 +1089,20 @@ class Histogram : public Metric {
   explicit Histogram(std::unique_ptr<HistogramPrototype> proto, uint64_t highest_trackable_value,
       int num_significant_digits, ExportPercentiles export_percentiles);
 
+  void InitShards(ShardedHistogram sharded);
+
+  // Returns the histogram that values recorded by the current thread should go to.
+  HdrHistogram* CurrentShard();
+
+  void ResetPercentiles() const;
+
   const std::unique_ptr<HdrHistogram> histogram_;
   const ExportPercentiles export_percentiles_;
+
+  // Per-CPU shards of a sharded histogram, allocated on the first value recorded on that CPU.
+  // Empty for a regular histogram, which records into histogram_ directly.
+  size_t num_shards_ = 0;
+  std::unique_ptr<std::atomic<HdrHistogram*>[]> shards_;
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
 
@@ -17,16 +17,29 @@
 
 #include <regex>
 
+#include "yb/gutil/strings/numbers.h"
+
 #include "yb/util/enums.h"
 
 namespace yb {
 
+namespace {
+
+const std::string kServerEntityId;
+
+} // namespace
+
 PrometheusWriter::PrometheusWriter(std::stringstream* output,
                                    AggregationMetricLevel aggregation_Level)
     : output_(output),
       timestamp_(std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::system_clock::now().time_since_epoch()).count()),
-      aggregation_level_(aggregation_Level) {}
+      aggregation_level_(aggregation_Level) {
+  char buf[kFastToBufferSize];
+  timestamp_suffix_ = " ";
+  timestamp_suffix_.append(buf, FastInt64ToBufferLeft(timestamp_, buf));
+  timestamp_suffix_ += '\n';
+}
 
 PrometheusWriter::~PrometheusWriter() {}
 
@@ -51,21 +64,29 @@ Status PrometheusWriter::FlushAggregatedValues(
 Status PrometheusWriter::FlushSingleEntry(
     const MetricEntity::AttributeMap& attr,
     const std::string& name, const int64_t value) {
-  *output_ << name;
-  size_t total_elements = attr.size();
-  if (total_elements > 0) {
-    *output_ << "{";
-    for (const auto& entry : attr) {
-      *output_ << entry.first << "=\"" << entry.second << "\"";
-      if (--total_elements > 0) {
-        *output_ << ",";
+  // The line is formatted into a buffer that is reused across entries, and appended to the
+  // output in one call, so a scrape does not allocate or flush the stream per entry.
+  line_.assign(name);
+  if (!attr.empty()) {
+    line_ += '{';
+    bool first = true;
+    for (const auto& [key, attr_value] : attr) {
+      if (!first) {
+        line_ += ',';
       }
+      first = false;
+      line_ += key;
+      line_ += "=\"";
+      line_ += attr_value;
+      line_ += '"';
     }
-    *output_ << "}";
+    line_ += '}';
   }
-  *output_ << " " << value;
-  *output_ << " " << timestamp_;
-  *output_ << std::endl;
+  line_ += ' ';
+  char buf[kFastToBufferSize];
+  line_.append(buf, FastInt64ToBufferLeft(value, buf));
+  line_ += timestamp_suffix_;
+  output_->write(line_.data(), line_.size());
   return Status::OK();
 }
 
@@ -80,7 +101,7 @@ void PrometheusWriter::AddAggregatedEntry(
   auto it = aggregated_attributes_.find(entity_id);
   if (it == aggregated_attributes_.end()) {
     // If it's the first time we see this table, create the aggregate attrs.
-    aggregated_attributes_.emplace(entity_id, attr);
+    it = aggregated_attributes_.emplace(entity_id, AggregatedAttributes(attr)).first;
   }
   auto& stored_value = aggregated_values_[metric_name][entity_id];
   switch (aggregation_function) {
@@ -90,7 +111,7 @@ void PrometheusWriter::AddAggregatedEntry(
     case kMax:
       // If we have a new max, also update the metadata so that it matches correctly.
       if (value > stored_value) {
-        aggregated_attributes_[entity_id] = attr;
+        it->second = AggregatedAttributes(attr);
         stored_value = value;
       }
       break;
@@ -100,6 +121,25 @@ void PrometheusWriter::AddAggregatedEntry(
   }
 }
 
+MetricEntity::AttributeMap PrometheusWriter::AggregatedAttributes(
+    const MetricEntity::AttributeMap& attr) const {
+  MetricEntity::AttributeMap result = attr;
+  switch (aggregation_level_) {
+    case AggregationMetricLevel::kServer:
+      result.erase("table_id");
+      result.erase("table_name");
+      result.erase("namespace_name");
+      break;
+    case AggregationMetricLevel::kStream:
+      result.erase("table_id");
+      result.erase("table_name");
+      break;
+    case AggregationMetricLevel::kTable:
+      break;
+  }
+  return result;
+}
+
 Status PrometheusWriter::WriteSingleEntry(
     const MetricEntity::AttributeMap& attr, const std::string& name, int64_t value,
     AggregationFunction aggregation_function) {
@@ -107,24 +147,15 @@ Status PrometheusWriter::WriteSingleEntry(
   if (it == attr.end()) {
     return FlushSingleEntry(attr, name, value);
   }
+  // The attributes of the rolled up entry are only built when it is first seen, or when a max
+  // is replaced, instead of for every tablet.
   switch (aggregation_level_) {
   case AggregationMetricLevel::kServer:
-  {
-    MetricEntity::AttributeMap new_attr = attr;
-    new_attr.erase("table_id");
-    new_attr.erase("table_name");
-    new_attr.erase("namespace_name");
-    AddAggregatedEntry("", new_attr, name, value, aggregation_function);
+    AddAggregatedEntry(kServerEntityId, attr, name, value, aggregation_function);
     break;
-  }
   case AggregationMetricLevel::kStream:
-  {
-    MetricEntity::AttributeMap new_attr = attr;
-    new_attr.erase("table_id");
-    new_attr.erase("table_name");
-    AddAggregatedEntry(attr.find("stream_id")->second, new_attr, name, value, aggregation_function);
+    AddAggregatedEntry(attr.find("stream_id")->second, attr, name, value, aggregation_function);
     break;
-  }
   case AggregationMetricLevel::kTable:
     AddAggregatedEntry(it->second, attr, name, value, aggregation_function);
     break;
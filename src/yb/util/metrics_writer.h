@@ -65,6 +65,9 @@ class PrometheusWriter {
                           const std::string& name, int64_t value,
                           AggregationFunction aggregation_function);
 
+  // Returns attr without the attributes that are rolled up at aggregation_level_.
+  MetricEntity::AttributeMap AggregatedAttributes(const MetricEntity::AttributeMap& attr) const;
+
   // Map entity id to attributes
   std::unordered_map<std::string, MetricEntity::AttributeMap> aggregated_attributes_;
   // Map entity id to values
@@ -76,6 +79,10 @@ class PrometheusWriter {
   std::stringstream* output_;
   // Timestamp for all metrics belonging to this writer instance.
   int64_t timestamp_;
+  // " <timestamp_>\n", appended to every entry.
+  std::string timestamp_suffix_;
+  // Buffer an entry is formatted into before it is written to output_.
+  std::string line_;
 
   AggregationMetricLevel aggregation_level_;
 };
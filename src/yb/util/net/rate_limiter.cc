@@ -60,17 +60,38 @@ uint64_t RateLimiter::GetRate() {
 }
 
 void RateLimiter::UpdateDataSizeAndMaybeSleep(uint64_t data_size) {
+  auto sleep_time = UpdateDataSize(data_size);
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+  }
+}
+
+MonoDelta RateLimiter::UpdateDataSize(uint64_t data_size) {
   auto now = MonoTime::Now();
-  auto elapsed = now.GetDeltaSince(end_time_);
-  end_time_ = now;
+  // end_time_ is in the future while the sleep time returned by previous calls has not passed.
+  auto pending = end_time_ > now ? end_time_ - now : MonoDelta::kZero;
+  auto elapsed = end_time_ > now ? MonoDelta::kZero : now - end_time_;
+  end_time_ = std::max(end_time_, now);
   total_bytes_ += data_size;
   UpdateRate();
-  UpdateTimeSlotSizeAndMaybeSleep(data_size, elapsed);
+  auto sleep_time = UpdateTimeSlotSize(data_size, elapsed);
+  total_time_slept_ += sleep_time;
+  end_time_ += sleep_time;
+  return pending + sleep_time;
 }
 
 void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed) {
+  auto sleep_time = UpdateTimeSlotSize(data_size, elapsed);
+  if (sleep_time > MonoDelta::kZero) {
+    SleepFor(sleep_time);
+    total_time_slept_ += sleep_time;
+    end_time_ = MonoTime::Now();
+  }
+}
+
+MonoDelta RateLimiter::UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed) {
   if (!active()) {
-    return;
+    return MonoDelta::kZero;
   }
 
   // If the rate is greater than target_rate_, sleep until both rates are equal.
@@ -81,16 +102,14 @@ void RateLimiter::UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta
             << " elapsed=" << elapsed.ToMilliseconds()
             << " received size=" << data_size
             << " and sleeping for=" << sleep_time;
-    SleepFor(MonoDelta::FromMilliseconds(sleep_time));
-    total_time_slept_ += MonoDelta::FromMilliseconds(sleep_time);
-    end_time_ = MonoTime::Now();
-    // If we slept for more than 80% of time_slot_ms_, reduce the size of this time slot.
+    // If we sleep for more than 80% of time_slot_ms_, reduce the size of this time slot.
     if (sleep_time > time_slot_ms_ * 80 / 100) {
       time_slot_ms_ = std::max(min_time_slot_, time_slot_ms_ / 2);
     }
-  } else {
-    time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+    return MonoDelta::FromMilliseconds(sleep_time);
   }
+  time_slot_ms_ = std::min(max_time_slot_, time_slot_ms_ * 2);
+  return MonoDelta::kZero;
 }
 
 void RateLimiter::UpdateRate() {
@@ -60,6 +60,11 @@ class RateLimiter {
   // than the rate provided by target_rate_updater_.
   void UpdateDataSizeAndMaybeSleep(uint64_t data_size);
 
+  // Same as UpdateDataSizeAndMaybeSleep, but returns the time to sleep instead of sleeping, so the
+  // caller can sleep without holding the lock that protects this object. The returned time
+  // includes the sleep time returned to earlier callers that has not passed yet.
+  MonoDelta UpdateDataSize(uint64_t data_size);
+
   void Init();
 
   // We can only have an active rate limiter if the user has provided a function to update the rate.
@@ -92,6 +97,8 @@ class RateLimiter {
  private:
   void UpdateRate();
   void UpdateTimeSlotSizeAndMaybeSleep(uint64_t data_size, MonoDelta elapsed);
+  // Updates the time slot size and returns the time to sleep to keep the target rate.
+  MonoDelta UpdateTimeSlotSize(uint64_t data_size, MonoDelta elapsed);
   uint64_t GetSizeForNextTimeSlot();
 
   bool init_ = false;
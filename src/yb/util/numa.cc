@@ -0,0 +1,142 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#include <sched.h>
+
+#include <algorithm>
+
+#include "yb/gutil/strings/split.h"
+#include "yb/gutil/strings/strip.h"
+#include "yb/gutil/sysinfo.h"
+
+#include "yb/util/env.h"
+#include "yb/util/errno.h"
+#include "yb/util/faststring.h"
+#include "yb/util/logging.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+#include "yb/util/stol_utils.h"
+
+namespace yb {
+
+namespace {
+
+const std::string kNodeDir = "/sys/devices/system/node";
+
+Result<std::vector<std::vector<int>>> ReadNumaNodeCpus() {
+  std::vector<std::string> children;
+  RETURN_NOT_OK(Env::Default()->GetChildren(kNodeDir, ExcludeDots::kTrue, &children));
+  std::vector<std::pair<int, std::vector<int>>> nodes;
+  for (const auto& child : children) {
+    if (child.compare(0, 4, "node") != 0) {
+      continue;
+    }
+    auto node = CheckedStoi(child.substr(4));
+    if (!node.ok()) {
+      continue;
+    }
+    faststring cpu_list;
+    RETURN_NOT_OK(ReadFileToString(
+        Env::Default(), Format("$0/$1/cpulist", kNodeDir, child), &cpu_list));
+    auto cpus = VERIFY_RESULT(ParseCpuList(cpu_list.ToString()));
+    // Memory only nodes have no CPUs.
+    if (!cpus.empty()) {
+      nodes.emplace_back(*node, std::move(cpus));
+    }
+  }
+  std::sort(nodes.begin(), nodes.end());
+  std::vector<std::vector<int>> result;
+  for (auto& node : nodes) {
+    result.push_back(std::move(node.second));
+  }
+  return result;
+}
+
+std::vector<std::vector<int>> DetectNumaNodeCpus() {
+  auto result = ReadNumaNodeCpus();
+  if (result.ok() && !result->empty()) {
+    LOG(INFO) << "Detected " << result->size() << " NUMA nodes";
+    return std::move(*result);
+  }
+  if (!result.ok()) {
+    LOG(INFO) << "No NUMA information, using a single node: " << result.status();
+  }
+  std::vector<int> all_cpus;
+  for (int cpu = 0; cpu <= base::MaxCPUIndex(); ++cpu) {
+    all_cpus.push_back(cpu);
+  }
+  return {std::move(all_cpus)};
+}
+
+} // namespace
+
+Result<std::vector<int>> ParseCpuList(const std::string& cpu_list) {
+  std::vector<int> result;
+  std::string input = cpu_list;
+  StripTrailingWhitespace(&input);
+  for (const auto& range : strings::Split(input, ",", strings::SkipEmpty())) {
+    std::vector<std::string> bounds = strings::Split(range, "-");
+    if (bounds.size() > 2) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid CPU range $0 in $1", range, cpu_list);
+    }
+    auto first = VERIFY_RESULT(CheckedStoi(bounds[0]));
+    auto last = bounds.size() == 2 ? VERIFY_RESULT(CheckedStoi(bounds[1])) : first;
+    if (first < 0 || last < first) {
+      return STATUS_FORMAT(InvalidArgument, "Invalid CPU range $0 in $1", range, cpu_list);
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) {
+      result.push_back(cpu);
+    }
+  }
+  return result;
+}
+
+const std::vector<std::vector<int>>& NumaNodeCpus() {
+  static const std::vector<std::vector<int>> result = DetectNumaNodeCpus();
+  return result;
+}
+
+Status PinCurrentThreadToNumaNode(size_t index) {
+#if defined(__APPLE__)
+  return STATUS(NotSupported, "Thread affinity is not supported on macOS");
+#else
+  const auto& nodes = NumaNodeCpus();
+  const auto node = index % nodes.size();
+  const auto& cpus = nodes[node];
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  size_t num_cpus = 0;
+  for (auto cpu : cpus) {
+    // CPU_SET does not check its argument, and cpu_set_t only has room for CPU_SETSIZE CPUs.
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      continue;
+    }
+    CPU_SET(cpu, &cpu_set);
+    ++num_cpus;
+  }
+  if (num_cpus == 0) {
+    return STATUS_FORMAT(
+        InvalidArgument, "No CPU of NUMA node $0 is below CPU_SETSIZE $1: $2", node, CPU_SETSIZE,
+        cpus);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return STATUS_FROM_ERRNO("sched_setaffinity failed", errno);
+  }
+  return Status::OK();
+#endif // defined(__APPLE__)
+}
+
+} // namespace yb
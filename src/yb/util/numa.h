@@ -0,0 +1,35 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+
+// Parses a CPU list in the format used by sysfs, e.g. "0-3,8,10-11".
+Result<std::vector<int>> ParseCpuList(const std::string& cpu_list);
+
+// Returns the CPUs of each NUMA node of the host, as reported by /sys/devices/system/node.
+// A host without NUMA information is reported as a single node with all its CPUs.
+const std::vector<std::vector<int>>& NumaNodeCpus();
+
+// Restricts the calling thread to the CPUs of NUMA node index % NumaNodeCpus().size(). Threads
+// that are started with consecutive indexes are spread round robin over the nodes.
+Status PinCurrentThreadToNumaNode(size_t index);
+
+} // namespace yb
@@ -235,7 +235,7 @@ struct TraceEntry {
   int line_number;
 
   size_t message_len;
-  TraceEntry* next;
+  std::atomic<TraceEntry*> next;
   char message[0];
 
   void Dump(std::ostream* out) const {
@@ -356,17 +356,16 @@ TraceEntry* Trace::NewEntry(
 }
 
 void Trace::AddEntry(TraceEntry* entry) {
-  std::lock_guard<simple_spinlock> l(lock_);
-  entry->next = nullptr;
+  entry->next.store(nullptr, std::memory_order_relaxed);
 
-  if (entries_tail_ != nullptr) {
-    entries_tail_->next = entry;
+  auto* prev = entries_tail_.exchange(entry, std::memory_order_acq_rel);
+  if (prev != nullptr) {
+    prev->next.store(entry, std::memory_order_release);
   } else {
-    DCHECK(entries_head_ == nullptr);
-    entries_head_ = entry;
-    trace_start_time_usec_ = GetCurrentMicrosFast(entry->timestamp);
+    trace_start_time_usec_.store(
+        GetCurrentMicrosFast(entry->timestamp), std::memory_order_relaxed);
+    entries_head_.store(entry, std::memory_order_release);
   }
-  entries_tail_ = entry;
 }
 
 void Trace::Dump(std::ostream *out, bool include_time_deltas) const {
@@ -374,23 +373,20 @@ void Trace::Dump(std::ostream *out, bool include_time_deltas) const {
 }
 
 void Trace::Dump(std::ostream* out, int32_t tracing_depth, bool include_time_deltas) const {
-  // Gather a copy of the list of entries under the lock. This is fast
-  // enough that we aren't worried about stalling concurrent tracers
-  // (whereas doing the logging itself while holding the lock might be
-  // too slow, if the output stream is a file, for example).
+  // Gather a copy of the list of entries, so that the logging itself does not race with
+  // concurrent tracers. Entries added while we walk the list may be missed.
   vector<TraceEntry*> entries;
+  for (TraceEntry* cur = entries_head_.load(std::memory_order_acquire);
+      cur != nullptr;
+      cur = cur->next.load(std::memory_order_acquire)) {
+    entries.push_back(cur);
+  }
+  int64_t trace_start_time_usec = trace_start_time_usec_.load(std::memory_order_relaxed);
+
   vector<scoped_refptr<Trace> > child_traces;
-  decltype(trace_start_time_usec_) trace_start_time_usec;
   {
     std::lock_guard<simple_spinlock> l(lock_);
-    for (TraceEntry* cur = entries_head_;
-        cur != nullptr;
-        cur = cur->next) {
-      entries.push_back(cur);
-    }
-
     child_traces = child_traces_;
-    trace_start_time_usec = trace_start_time_usec_;
   }
 
   DoDump(
@@ -196,23 +196,19 @@ class Trace : public RefCountedThreadSafe<Trace> {
   size_t DynamicMemoryUsage() const;
 
   bool must_print() const {
-    std::lock_guard<simple_spinlock> l(lock_);
-    return must_print_;
+    return must_print_.load(std::memory_order_acquire);
   }
 
   void set_must_print(bool flag) {
-    std::lock_guard<simple_spinlock> l(lock_);
-    must_print_ = flag;
+    must_print_.store(flag, std::memory_order_release);
   }
 
   bool end_to_end_traces_requested() const {
-    std::lock_guard<simple_spinlock> l(lock_);
-    return end_to_end_traces_requested_;
+    return end_to_end_traces_requested_.load(std::memory_order_acquire);
   }
 
   void set_end_to_end_traces_requested(bool flag) {
-    std::lock_guard<simple_spinlock> l(lock_);
-    end_to_end_traces_requested_ = flag;
+    end_to_end_traces_requested_.store(flag, std::memory_order_release);
   }
 
  private:
@@ -231,23 +227,25 @@ class Trace : public RefCountedThreadSafe<Trace> {
   // message of length 'len'.
   TraceEntry* NewEntry(size_t len, const char* file_path, int line_number, CoarseTimePoint now);
 
-  // Add the entry to the linked list of entries.
+  // Add the entry to the linked list of entries. Lock free: the entry is published by swapping
+  // the tail, then linked to its predecessor. A concurrent Dump may not see the entries that are
+  // not linked yet.
   void AddEntry(TraceEntry* entry);
 
   std::atomic<ThreadSafeArena*> arena_ = {nullptr};
 
-  // Lock protecting the entries linked list.
+  // Lock protecting child_traces_.
   mutable simple_spinlock lock_;
   // The head of the linked list of entries (allocated inside arena_)
-  TraceEntry* entries_head_ = nullptr;
+  std::atomic<TraceEntry*> entries_head_{nullptr};
   // The tail of the linked list of entries (allocated inside arena_)
-  TraceEntry* entries_tail_ = nullptr;
+  std::atomic<TraceEntry*> entries_tail_{nullptr};
 
-  int64_t trace_start_time_usec_ = 0;
+  std::atomic<int64_t> trace_start_time_usec_{0};
 
   // A hint to request that the collected trace be printed.
-  bool must_print_ = false;
-  bool end_to_end_traces_requested_ = false;
+  std::atomic<bool> must_print_{false};
+  std::atomic<bool> end_to_end_traces_requested_{false};
 
   std::vector<scoped_refptr<Trace> > child_traces_;
 
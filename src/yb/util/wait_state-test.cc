@@ -0,0 +1,52 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <gtest/gtest.h>
+
+#include "yb/util/test_util.h"
+#include "yb/util/wait_state.h"
+
+namespace yb {
+
+class WaitStateTest : public YBTest {
+};
+
+TEST_F(WaitStateTest, ScopedStatus) {
+  auto wait_state = std::make_shared<WaitStateInfo>();
+  ASSERT_EQ(wait_state->code(), WaitStateCode::kQueued);
+
+  {
+    // Without an adopted wait state, marking a wait does nothing.
+    SCOPED_WAIT_STATUS(kLockWait);
+    ASSERT_EQ(WaitStateInfo::CurrentWaitState(), nullptr);
+  }
+
+  {
+    ADOPT_WAIT_STATE(wait_state);
+    ASSERT_EQ(WaitStateInfo::CurrentWaitState(), wait_state.get());
+    ASSERT_EQ(wait_state->code(), WaitStateCode::kActive);
+    {
+      SCOPED_WAIT_STATUS(kLockWait);
+      ASSERT_EQ(wait_state->code(), WaitStateCode::kLockWait);
+      {
+        SCOPED_WAIT_STATUS(kBlockRead);
+        ASSERT_EQ(wait_state->code(), WaitStateCode::kBlockRead);
+      }
+      ASSERT_EQ(wait_state->code(), WaitStateCode::kLockWait);
+    }
+    ASSERT_EQ(wait_state->code(), WaitStateCode::kActive);
+  }
+  ASSERT_EQ(WaitStateInfo::CurrentWaitState(), nullptr);
+}
+
+} // namespace yb
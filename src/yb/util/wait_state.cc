@@ -0,0 +1,35 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/wait_state.h"
+
+namespace yb {
+
+thread_local WaitStateInfo* WaitStateInfo::threadlocal_wait_state_ = nullptr;
+
+ScopedAdoptWaitState::ScopedAdoptWaitState(WaitStateInfoPtr wait_state)
+    : old_wait_state_(WaitStateInfo::threadlocal_wait_state_),
+      wait_state_(std::move(wait_state)) {
+  if (wait_state_) {
+    wait_state_->set_code(WaitStateCode::kActive);
+  }
+  WaitStateInfo::threadlocal_wait_state_ = wait_state_.get();
+}
+
+ScopedAdoptWaitState::~ScopedAdoptWaitState() {
+  // Reset the thread local before releasing the reference, so it never points to a destroyed
+  // object.
+  WaitStateInfo::threadlocal_wait_state_ = old_wait_state_;
+}
+
+} // namespace yb
@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "yb/gutil/macros.h"
+
+#include "yb/util/enums.h"
+
+namespace yb {
+
+// What the thread handling a request is currently doing. Reported for running RPCs, so it is
+// possible to see what in-flight calls are waiting on.
+YB_DEFINE_ENUM(WaitStateCode,
+    (kQueued)           // Waiting in the RPC queue to be handled.
+    (kActive)           // Running, not waiting on anything known.
+    (kLockWait)         // Waiting for a lock in the shared lock manager.
+    (kSafeTimeWait)     // Waiting for the safe time to reach the read time.
+    (kBlockRead)        // Reading an SST block from disk.
+    (kResponseQueued)); // The response was queued for sending.
+
+// Current wait state of a request. Written by the thread that handles the request, read by
+// whoever dumps running calls.
+class WaitStateInfo {
+ public:
+  WaitStateInfo() = default;
+
+  WaitStateCode code() const {
+    return code_.load(std::memory_order_acquire);
+  }
+
+  void set_code(WaitStateCode value) {
+    code_.store(value, std::memory_order_release);
+  }
+
+  // Returns the wait state adopted by this thread, if any.
+  static WaitStateInfo* CurrentWaitState() {
+    return threadlocal_wait_state_;
+  }
+
+ private:
+  friend class ScopedAdoptWaitState;
+
+  std::atomic<WaitStateCode> code_{WaitStateCode::kQueued};
+
+  static thread_local WaitStateInfo* threadlocal_wait_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(WaitStateInfo);
+};
+
+using WaitStateInfoPtr = std::shared_ptr<WaitStateInfo>;
+
+// Makes the wait state current for this thread and marks it active, for the lifetime of the
+// object. The previous wait state of the thread is restored on destruction.
+class ScopedAdoptWaitState {
+ public:
+  explicit ScopedAdoptWaitState(WaitStateInfoPtr wait_state);
+  ~ScopedAdoptWaitState();
+
+ private:
+  WaitStateInfo* old_wait_state_;
+  WaitStateInfoPtr wait_state_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedAdoptWaitState);
+};
+
+// Sets the wait state of the current thread, if any, to the specified code for the lifetime of
+// the object, then restores the previous code.
+class ScopedWaitStatus {
+ public:
+  explicit ScopedWaitStatus(WaitStateCode code)
+      : wait_state_(WaitStateInfo::CurrentWaitState()) {
+    if (wait_state_) {
+      prev_code_ = wait_state_->code();
+      wait_state_->set_code(code);
+    }
+  }
+
+  ~ScopedWaitStatus() {
+    if (wait_state_) {
+      wait_state_->set_code(prev_code_);
+    }
+  }
+
+ private:
+  WaitStateInfo* wait_state_;
+  WaitStateCode prev_code_ = WaitStateCode::kActive;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedWaitStatus);
+};
+
+#define ADOPT_WAIT_STATE(wait_state) \
+    ::yb::ScopedAdoptWaitState _adopt_wait_state(wait_state)
+
+#define SCOPED_WAIT_STATUS(code) \
+    ::yb::ScopedWaitStatus _scoped_wait_status(::yb::WaitStateCode::code)
+
+} // namespace yb
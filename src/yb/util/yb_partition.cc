@@ -39,7 +39,7 @@ void YBPartition::AppendBytesToKey(const char *bytes, size_t len, std::string *e
   encoded_key->append(bytes, len);
 }
 
-uint16_t YBPartition::HashColumnCompoundValue(const std::string &compound) {
+uint16_t YBPartition::HashColumnCompoundValue(std::string_view compound) {
   // In the future, if you wish to change the hashing behavior, you must introduce a new hashing
   // method for your newly-created tables.  Existing tables must continue to use their hashing
   // methods that was define by their PartitionSchema.
@@ -48,7 +48,7 @@ uint16_t YBPartition::HashColumnCompoundValue(const std::string &compound) {
   // as the default hashing behavior. Constant 'kseed" cannot be changed as it'd yield a different
   // hashing result.
   static const int kseed = 97;
-  const uint64_t hash_value = Hash64StringWithSeed(compound, kseed);
+  const uint64_t hash_value = Hash64StringWithSeed(compound.data(), compound.size(), kseed);
 
   // Convert the 64-bit hash value to 16 bit integer.
   const uint64_t h1 = hash_value >> 48;
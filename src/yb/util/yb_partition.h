@@ -16,6 +16,8 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+
 #include "yb/util/status_fwd.h"
 #include "yb/gutil/endian.h"
 
@@ -40,7 +42,7 @@ class YBPartition {
     encoded_key->append(reinterpret_cast<char *>(&uval), sizeof(uval));
   }
 
-  static uint16_t HashColumnCompoundValue(const std::string &compound);
+  static uint16_t HashColumnCompoundValue(std::string_view compound);
 };
 
 } // namespace yb
@@ -82,12 +82,12 @@ namespace cqlserver {
 
 CQLConnectionContext::CQLConnectionContext(
     size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-    const MemTrackerPtr& call_tracker)
+    const MemTrackerPtr& call_tracker, const rpc::ReadBufferPoolPtr& read_buffer_pool)
     : ql_session_(new ql::QLSession()),
       parser_(buffer_tracker, CQLMessage::kMessageHeaderLength, CQLMessage::kHeaderPosLength,
               FLAGS_max_message_length, rpc::IncludeHeader::kTrue, rpc::SkipEmptyMessages::kFalse,
               this),
-      read_buffer_(receive_buffer_size, buffer_tracker),
+      read_buffer_(receive_buffer_size, buffer_tracker, read_buffer_pool),
       call_tracker_(call_tracker) {
   VLOG(1) << "CQL Connection Context: FLAGS_cql_server_always_send_events = " <<
       FLAGS_cql_server_always_send_events;
@@ -46,7 +46,8 @@ class CQLConnectionContext : public rpc::ConnectionContextWithCallId,
                              public rpc::BinaryCallParserListener {
  public:
   CQLConnectionContext(size_t receive_buffer_size, const MemTrackerPtr& buffer_tracker,
-                       const MemTrackerPtr& call_tracker);
+                       const MemTrackerPtr& call_tracker,
+                       const rpc::ReadBufferPoolPtr& read_buffer_pool);
 
   void DumpPB(const rpc::DumpRunningRpcsRequestPB& req,
               rpc::RpcConnectionPB* resp) override;
@@ -32,6 +32,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/result.h"
+#include "yb/util/shared_lock.h"
 #include "yb/util/status_format.h"
 #include "yb/util/trace.h"
 
@@ -243,7 +244,7 @@ void CQLServiceImpl::ReturnProcessor(const CQLProcessorListPos& pos) {
 shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
     const ql::CQLMessage::QueryId& query_id, const string& query, ql::QLEnv* ql_env) {
   // Get exclusive lock before allocating a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<percpu_rwlock> guard(prepared_stmts_lock_);
 
   shared_ptr<CQLStatement> stmt;
   const auto itr = prepared_stmts_map_.find(query_id);
@@ -283,15 +284,17 @@ shared_ptr<CQLStatement> CQLServiceImpl::AllocatePreparedStatement(
 
 Result<std::shared_ptr<const CQLStatement>> CQLServiceImpl::GetPreparedStatement(
     const ql::CQLMessage::QueryId& query_id, SchemaVersion version) {
-  // Get exclusive lock before looking up a prepared statement and updating the LRU list.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
-
-  const auto itr = prepared_stmts_map_.find(query_id);
-  if (itr == prepared_stmts_map_.end()) {
-    return ErrorStatus(ql::ErrorCode::UNPREPARED_STATEMENT);
+  // Get shared lock to look up the prepared statement. The LRU list is not updated here: the
+  // statement is only marked as used, and CollectGarbage() takes it into account.
+  shared_ptr<CQLStatement> stmt;
+  {
+    SharedLock<rw_spinlock> guard(prepared_stmts_lock_.get_lock());
+    const auto itr = prepared_stmts_map_.find(query_id);
+    if (itr == prepared_stmts_map_.end()) {
+      return ErrorStatus(ql::ErrorCode::UNPREPARED_STATEMENT);
+    }
+    stmt = itr->second;
   }
-
-  shared_ptr<CQLStatement> stmt = itr->second;
   LOG_IF(DFATAL, stmt == nullptr) << "Unexpected null statement";
 
   // If the statement has not finished preparing, do not return it.
@@ -300,7 +303,7 @@ Result<std::shared_ptr<const CQLStatement>> CQLServiceImpl::GetPreparedStatement
   }
   // If the statement is stale, delete it.
   if (stmt->stale()) {
-    DeletePreparedStatementUnlocked(stmt);
+    DeletePreparedStatement(stmt);
     return ErrorStatus(ql::ErrorCode::UNPREPARED_STATEMENT);
   }
   // If the statement has a later schema version, return a error.
@@ -316,13 +319,13 @@ Result<std::shared_ptr<const CQLStatement>> CQLServiceImpl::GetPreparedStatement
     }
   }
 
-  MoveLruPreparedStatementUnlocked(stmt);
+  stmt->MarkUsed();
   return stmt;
 }
 
 void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
   // Get exclusive lock before deleting the prepared statement.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<percpu_rwlock> guard(prepared_stmts_lock_);
 
   DeletePreparedStatementUnlocked(stmt);
 
@@ -400,8 +403,14 @@ void CQLServiceImpl::DeletePreparedStatementUnlocked(
 void CQLServiceImpl::CollectGarbage(size_t required) {
   // Get exclusive lock before deleting the least recently used statement at the end of the LRU
   // list from the cache.
-  std::lock_guard<std::mutex> guard(prepared_stmts_mutex_);
+  std::lock_guard<percpu_rwlock> guard(prepared_stmts_lock_);
 
+  // Statements used since the last pass are moved to the front and lose their mark. The scan is
+  // bounded by the list size, so the last statement is deleted even if all of them were used.
+  for (size_t i = prepared_stmts_list_.size(); i > 1 && prepared_stmts_list_.back()->ResetUsed();
+       --i) {
+    MoveLruPreparedStatementUnlocked(prepared_stmts_list_.back());
+  }
   if (!prepared_stmts_list_.empty()) {
     DeletePreparedStatementUnlocked(prepared_stmts_list_.back());
   }
@@ -22,6 +22,7 @@
 
 #include "yb/client/client_fwd.h"
 
+#include "yb/util/locks.h"
 #include "yb/util/object_pool.h"
 
 #include "yb/yql/cql/cqlserver/cqlserver_fwd.h"
@@ -114,19 +115,20 @@ class CQLServiceImpl : public CQLServerServiceIf,
  private:
   constexpr static int kRpcTimeoutSec = 5;
 
-  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
+  // Insert a prepared statement at the front of the LRU list. "prepared_stmts_lock_" needs to be
+  // locked exclusively before this call.
   void InsertLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
 
-  // Move a prepared statement to the front of the LRU list. "prepared_stmts_mutex_" needs to be
-  // locked before this call.
+  // Move a prepared statement to the front of the LRU list. "prepared_stmts_lock_" needs to be
+  // locked exclusively before this call.
   void MoveLruPreparedStatementUnlocked(const std::shared_ptr<CQLStatement>& stmt);
 
-  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_mutex_" needs to
-  // be locked before this call.
+  // Delete a prepared statement from the cache and the LRU list. "prepared_stmts_lock_" needs to
+  // be locked exclusively before this call.
   void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
 
-  // Delete the least recently used prepared statement from the cache to free up memory.
+  // Delete the least recently used prepared statement from the cache to free up memory. Statements
+  // marked as used since the last pass get a second chance and are moved to the front instead.
   void CollectGarbage(size_t required) override;
 
   // CQLServer of this service.
@@ -153,8 +155,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Prepared statements LRU list (least recently used one at the end).
   CQLStatementList prepared_stmts_list_;
 
-  // Mutex that protects the prepared statements and the LRU list.
-  std::mutex prepared_stmts_mutex_;
+  // Lock that protects the prepared statements and the LRU list. Lookups of EXECUTE requests take
+  // it in shared mode, which only touches the lock of the current CPU.
+  percpu_rwlock prepared_stmts_lock_;
 
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 
 #include "yb/yql/cql/ql/statement.h"
@@ -50,6 +51,20 @@ class CQLStatement : public ql::Statement {
   CQLStatementListPos pos() const { return pos_; }
   void set_pos(CQLStatementListPos pos) const { pos_ = pos; }
 
+  // Mark the statement as used since the last LRU pass. Lookups only set this flag instead of
+  // moving the statement in the LRU list, so that they can run under a shared lock. The flag is
+  // read first so that repeated lookups of a hot statement do not dirty its cache line.
+  void MarkUsed() const {
+    if (!used_.load(std::memory_order_relaxed)) {
+      used_.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  // Clear the used mark and return whether it was set.
+  bool ResetUsed() const {
+    return used_.exchange(false, std::memory_order_relaxed);
+  }
+
   // Get schema version this statement used for preparation.
   Result<SchemaVersion> GetYBTableSchemaVersion() const {
     const ql::ParseTree& parser_tree = VERIFY_RESULT(GetParseTree());
@@ -68,6 +83,9 @@ class CQLStatement : public ql::Statement {
  private:
   // Position of the statement in the LRU.
   mutable CQLStatementListPos pos_;
+
+  // Whether the statement was looked up since the last LRU pass.
+  mutable std::atomic<bool> used_{false};
 };
 
 }  // namespace cqlserver
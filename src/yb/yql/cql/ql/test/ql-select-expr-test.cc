@@ -4,6 +4,7 @@
 
 #include <cmath>
 #include <chrono>
+#include <deque>
 #include <limits>
 #include <thread>
 
@@ -49,6 +50,7 @@ struct CQLQueryParameters : public CQLMessage::QueryParameters {
   void Reset() {
     values.clear();
     value_map.clear();
+    value_buffers.clear();
   }
 
   void PushBackInt32(const string& name, int32_t val) {
@@ -73,10 +75,13 @@ struct CQLQueryParameters : public CQLMessage::QueryParameters {
 
     CQLMessage::Value msg_value;
     msg_value.name = name;
-    msg_value.value = buffer.ToBuffer();
+    msg_value.value = value_buffers.emplace_back(buffer.ToBuffer());
     value_map.insert(NameToIndexMap::value_type(name, values.size()));
     values.push_back(msg_value);
   }
+
+  // Storage of the serialized values, which msg_value.value points to.
+  std::deque<std::string> value_buffers;
 };
 
 class QLTestSelectedExpr : public QLTestBase {
@@ -144,7 +144,7 @@ Status CQLMessage::QueryParameters::GetBindVariable(const std::string& name,
         return STATUS_SUBSTITUTE(
             NotSupported, "Unsupported datatype $0", static_cast<int>(type->main()));
       }
-      Slice data(v->value);
+      Slice data = v->value;
       return value->Deserialize(type, YQL_CLIENT_CQL, &data);
     }
     case Value::Kind::IS_NULL:
@@ -401,8 +401,10 @@ bool CQLRequest::ParseRequest(
     return false;
   }
 
-  // Clear and release the body after parsing.
+  // Clear and release the body after parsing. The uncompressed body is kept, since the bind
+  // values point into it.
   (*request)->body_.clear();
+  (*request)->uncompressed_body_ = std::move(buffer);
 
   return true;
 }
@@ -531,9 +533,9 @@ Status CQLRequest::ParseValue(const bool with_name, Value* value) {
     if (length > 0) {
       uint32_t unsigned_length = length;
       RETURN_NOT_ENOUGH(unsigned_length);
-      value->value.assign(to_char_ptr(data), kIntSize + length);
+      value->value = Slice(data, kIntSize + length);
       body_.remove_prefix(length);
-      DVLOG(4) << "CQL value bytes " << value->value;
+      DVLOG(4) << "CQL value bytes " << value->value.ToDebugString();
     }
   } else if (VersionIsCompatible(kV4Version)) {
     switch (length) {
@@ -984,7 +986,7 @@ void SerializeValue(const CQLMessage::Value& value, faststring* mesg) {
   switch (value.kind) {
     case CQLMessage::Value::Kind::NOT_NULL:
       SerializeInt(value.value.size(), mesg);
-      mesg->append(value.value);
+      mesg->append(value.value.data(), value.value.size());
       return;
     case CQLMessage::Value::Kind::IS_NULL:
       SerializeInt(-1, mesg);
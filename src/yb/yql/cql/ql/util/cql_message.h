@@ -231,12 +231,15 @@ class CQLMessage {
 
     Kind kind = Kind::NOT_NULL;
     std::string name;
-    std::string value; // As required by QLValue::Deserialize() for CQL, the value includes
-                       // the 4-byte length header, i.e. "<4-byte-length><value>".
+    // As required by QLValue::Deserialize() for CQL, the value includes the 4-byte length header,
+    // i.e. "<4-byte-length><value>". The value is not copied: it points into the body of the
+    // request it was parsed from, which lives as long as the request.
+    Slice value;
 
     std::string ToString() const {
-      constexpr int kLengthHeaderSize = 4;
-      return (value.length() > kLengthHeaderSize ? value.substr(kLengthHeaderSize) : "n/a");
+      constexpr size_t kLengthHeaderSize = 4;
+      return value.size() > kLengthHeaderSize
+          ? value.WithoutPrefix(kLengthHeaderSize).ToBuffer() : "n/a";
     }
   };
 
@@ -373,6 +376,9 @@ class CQLRequest : public CQLMessage {
 
  private:
   Slice body_;
+
+  // The uncompressed body of a compressed request. Bind values point into it.
+  std::unique_ptr<uint8_t[]> uncompressed_body_;
 };
 
 // ------------------------------ Individual CQL requests -----------------------------------
@@ -923,6 +923,7 @@ Status PgDocReadOp::CompleteProcessResponse() {
 
     if (has_more_arg) {
       has_more_data = true;
+      IncreasePrefetchLimit(&req);
     } else {
       read_op.set_active(false);
     }
@@ -949,6 +950,17 @@ Status PgDocReadOp::CompleteProcessResponse() {
   return Status::OK();
 }
 
+void PgDocReadOp::IncreasePrefetchLimit(LWPgsqlReadRequestPB* req) {
+  // Limit that came from the statement is respected as is.
+  if (suppress_next_result_prefetching_) {
+    return;
+  }
+  auto max_limit = FLAGS_ysql_prefetch_limit_max;
+  if (req->limit() < max_limit) {
+    req->set_limit(std::min(req->limit() * 2, max_limit));
+  }
+}
+
 void PgDocReadOp::SetRequestPrefetchLimit() {
   // Predict the maximum prefetch-limit using the associated gflags.
   auto& req = read_op_->read_request();
@@ -541,6 +541,9 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Grows the row limit of the next request of a long scan, see ysql_prefetch_limit_max.
+  void IncreasePrefetchLimit(LWPgsqlReadRequestPB* req);
+
   // Set the backfill_spec field of our read request.
   void SetBackfillSpec();
 
@@ -40,6 +40,7 @@
 
 #include "yb/yql/pggate/pg_op.h"
 #include "yb/yql/pggate/pg_tabledesc.h"
+#include "yb/yql/pggate/pggate_flags.h"
 
 namespace yb {
 namespace pggate {
@@ -146,6 +147,15 @@ inline bool IsTableUsedByRequest(const LWPgsqlReadRequestPB& request, const Slic
 
 using RowKeys = std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>>;
 
+bool IsTableUsedByRequest(const LWPgsqlReadRequestPB& request, const RowKeys& keys) {
+  for (const auto& k : keys) {
+    if (IsTableUsedByRequest(request, k.table_id().GetYbTableId())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 struct InFlightOperation {
   RowKeys keys;
   PerformFuture future;
@@ -306,7 +316,9 @@ class PgOperationBuffer::Impl {
             }
             return false;
           })));
-      RETURN_NOT_OK(EnsureAllCompleted());
+      RETURN_NOT_OK(op.is_read() && FLAGS_ysql_read_waits_only_for_related_writes
+          ? EnsureCompletedForRead(down_cast<const PgsqlReadOp&>(op).read_request())
+          : EnsureAllCompleted());
     }
     return result;
   }
@@ -323,6 +335,18 @@ class PgOperationBuffer::Impl {
     return EnsureCompleted(in_flight_ops_.size());
   }
 
+  // Waits for in-flight operations up to the last one that writes to a table used by the request.
+  // Operations are completed in the order they were sent, so earlier unrelated ones are also
+  // waited for.
+  Status EnsureCompletedForRead(const LWPgsqlReadRequestPB& request) {
+    for (auto i = in_flight_ops_.size(); i > 0; --i) {
+      if (IsTableUsedByRequest(request, in_flight_ops_[i - 1].keys)) {
+        return EnsureCompleted(i);
+      }
+    }
+    return Status::OK();
+  }
+
   Status EnsureCompleted(size_t count) {
     for(; count && !in_flight_ops_.empty(); --count) {
       RETURN_NOT_OK(in_flight_ops_.front().future.Get(&rpc_wait_time_));
@@ -399,12 +423,7 @@ class PgOperationBuffer::Impl {
   }
 
   bool IsSameTableUsedByBufferedOperations(const LWPgsqlReadRequestPB& request) const {
-    for (const auto& k : keys_) {
-      if (IsTableUsedByRequest(request, k.table_id().GetYbTableId())) {
-        return true;
-      }
-    }
-    return false;
+    return IsTableUsedByRequest(request, keys_);
   }
 
   const Flusher flusher_;
@@ -15,6 +15,8 @@
 
 #include "yb/yql/pggate/pg_tabledesc.h"
 
+#include <algorithm>
+
 #include "yb/common/partition.h"
 #include "yb/common/pg_system_attr.h"
 #include "yb/common/schema.h"
@@ -48,6 +50,17 @@ Status PgTableDesc::Init() {
   if (resp_.has_tablegroup_id()) {
     tablegroup_oid_ = VERIFY_RESULT(GetPgsqlTablegroupOid(resp_.tablegroup_id()));
   }
+  if (IsHashPartitioned()) {
+    hash_partition_starts_.reserve(table_partitions_->keys.size());
+    for (const auto& key : table_partitions_->keys) {
+      if (!key.empty() && key.size() != implicit_cast<size_t>(PartitionSchema::kPartitionKeySize)) {
+        // Not a hash partition key, fall back to comparing partition keys.
+        hash_partition_starts_.clear();
+        break;
+      }
+      hash_partition_starts_.push_back(PartitionSchema::DecodeMultiColumnHashLeftBound(key));
+    }
+  }
   return PartitionSchema::FromPB(resp_.partition_schema(), schema_, &partition_schema_);
 }
 
@@ -134,6 +147,14 @@ Result<size_t> PgTableDesc::FindPartitionIndex(const Slice& ybctid) const {
   // Find partition index based on ybctid value.
   // - Hash Partition: ybctid -> hashcode -> key -> partition index.
   // - Range Partition: ybctid == key -> partition index.
+  if (!hash_partition_starts_.empty()) {
+    const auto hash_code = VERIFY_RESULT(docdb::DocKey::DecodeHash(ybctid));
+    const auto it = std::upper_bound(
+        hash_partition_starts_.begin(), hash_partition_starts_.end(), hash_code);
+    RSTATUS_DCHECK(it != hash_partition_starts_.begin(), IllegalState,
+                   Format("No partition starts at or before hash code $0", hash_code));
+    return it - hash_partition_starts_.begin() - 1;
+  }
   string partition_key = VERIFY_RESULT(DecodeYbctid(ybctid));
   return client::FindPartitionStartIndex(table_partitions_->keys, partition_key);
 }
@@ -106,6 +106,10 @@ class PgTableDesc : public RefCountedThreadSafe<PgTableDesc> {
   Schema schema_;
   PartitionSchema partition_schema_;
 
+  // Hash codes of partition starts, in the order of table_partitions_->keys. Filled only for hash
+  // partitioned tables, to find the partition of a ybctid without building its partition key.
+  std::vector<uint16_t> hash_partition_starts_;
+
   // Attr number to column index map.
   std::unordered_map<int, size_t> attr_num_map_;
   YBCPgOid tablegroup_oid_{kInvalidOid};
@@ -39,6 +39,12 @@
 DEFINE_UNKNOWN_bool(use_node_hostname_for_local_tserver, false,
     "Connect to local t-server by using host name instead of local IP");
 
+DEFINE_RUNTIME_bool(ysql_defer_read_point_for_read_only_snapshot_transactions, false,
+    "Whether READ ONLY transactions at snapshot isolation pick their read time as DEFERRABLE "
+    "transactions do. The first read waits out the maximum clock skew, and the transaction "
+    "never gets a read restart.");
+TAG_FLAG(ysql_defer_read_point_for_read_only_snapshot_transactions, advanced);
+
 // A macro for logging the function name and the state of the current transaction.
 // This macro is not enclosed in do { ... } while (true) because we want to be able to write
 // additional information into the same log message.
@@ -265,6 +271,9 @@ Status PgTxnManager::CalculateIsolation(bool read_only_op,
   // The "deferrable" flag that in SERIALIZABLE DEFERRABLE READ ONLY mode we will choose the read
   // timestamp as global_limit to avoid the possibility of read restarts. This results in waiting
   // out the maximum clock skew and is appropriate for non-latency-sensitive operations.
+  // With ysql_defer_read_point_for_read_only_snapshot_transactions, READ ONLY transactions at
+  // snapshot isolation do the same, so long reporting queries don't retry on read restarts.
+  // Follower reads already use a read time in the past, so they are not deferred.
 
   const IsolationLevel docdb_isolation =
       (pg_isolation_level_ == PgIsolationLevel::SERIALIZABLE) && !read_only_
@@ -272,7 +281,10 @@ Status PgTxnManager::CalculateIsolation(bool read_only_op,
           : (pg_isolation_level_ == PgIsolationLevel::READ_COMMITTED
               ? IsolationLevel::READ_COMMITTED
               : IsolationLevel::SNAPSHOT_ISOLATION);
-  const bool defer = read_only_ && deferrable_;
+  const bool defer = read_only_ && (
+      deferrable_ ||
+      (docdb_isolation == IsolationLevel::SNAPSHOT_ISOLATION && !read_time_for_follower_reads_ &&
+       GetAtomicFlag(&FLAGS_ysql_defer_read_point_for_read_only_snapshot_transactions)));
 
   VLOG_TXN_STATE(2) << "DocDB isolation level: " << IsolationLevel_Name(docdb_isolation);
 
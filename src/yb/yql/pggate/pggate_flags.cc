@@ -45,6 +45,12 @@ DEFINE_UNKNOWN_int32(ysql_request_limit, 1024,
 DEFINE_UNKNOWN_uint64(ysql_prefetch_limit, 1024,
               "Maximum number of rows to prefetch");
 
+DEFINE_RUNTIME_uint64(ysql_prefetch_limit_max, 0,
+    "If greater than ysql_prefetch_limit, the number of rows prefetched by a scan is doubled "
+    "after every fetch that has more data to read, up to this value. "
+    "Lets long scans amortize the per request overhead while short scans keep small pages. "
+    "Scans with a LIMIT clause that is smaller than ysql_prefetch_limit are not affected.");
+
 DEPRECATE_FLAG(double, ysql_backward_prefetch_scale_factor, "11_2022");
 
 DEFINE_UNKNOWN_uint64(ysql_session_max_batch_size, 3072,
@@ -55,6 +61,11 @@ DEFINE_UNKNOWN_uint64(ysql_session_max_batch_size, 3072,
 DEFINE_UNKNOWN_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
+DEFINE_RUNTIME_bool(ysql_read_waits_only_for_related_writes, false,
+    "Whether a read of relations that are not written by the buffered operations waits only for "
+    "in-flight buffered writes to the relations it reads, instead of all of them. Allows COPY and "
+    "INSERT ... SELECT to keep writes in flight while reading their source tables.");
+
 DEFINE_UNKNOWN_int32(ysql_max_read_restart_attempts, 20,
              "How many read restarts can we try transparently before giving up");
 
@@ -22,9 +22,11 @@ DECLARE_string(pggate_master_addresses);
 DECLARE_int32(pggate_tserver_shm_fd);
 DECLARE_int32(ysql_request_limit);
 DECLARE_uint64(ysql_prefetch_limit);
+DECLARE_uint64(ysql_prefetch_limit_max);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
 DECLARE_uint64(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
+DECLARE_bool(ysql_read_waits_only_for_related_writes);
 DECLARE_int32(ysql_max_read_restart_attempts);
 DECLARE_bool(TEST_ysql_disable_transparent_cache_refresh_retry);
 DECLARE_int64(TEST_inject_delay_between_prepare_ybctid_execute_batch_ybctid_ms);
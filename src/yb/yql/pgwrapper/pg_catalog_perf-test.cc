@@ -24,6 +24,7 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/mini_tablet_server.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/metrics.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
@@ -236,5 +237,39 @@ TEST_F_EX(PgCatalogPerfTest,
   ASSERT_LE(read_rpc_counter, 720);
 }
 
+// The test checks that connections refreshing their catalog cache at the same moment get correct
+// responses from the response cache, including those that arrive while the response is still being
+// loaded by another connection.
+TEST_F_EX(PgCatalogPerfTest,
+          YB_DISABLE_TEST_IN_TSAN(ResponseCacheConcurrentRefresh),
+          PgCatalogWithCachePerfTest) {
+  constexpr size_t kConnectionCount = 20;
+  constexpr size_t kUniqueQueriesPerRefresh = 3;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (r INT PRIMARY KEY)"));
+  std::vector<PGConn> conns;
+  for (size_t i = 0; i < kConnectionCount; ++i) {
+    conns.push_back(ASSERT_RESULT(Connect()));
+    ASSERT_RESULT(conns.back().Fetch("SELECT * FROM t"));
+  }
+  ASSERT_OK(conn.Execute("ALTER TABLE t ADD COLUMN v INT"));
+  auto cache_counters = ASSERT_RESULT(ResponseCacheCountersDelta([&conns] {
+    TestThreadHolder holder;
+    CountDownLatch latch(conns.size());
+    for (auto& c : conns) {
+      holder.AddThread([&c, &latch] {
+        latch.CountDown();
+        latch.Wait();
+        const auto res = ASSERT_RESULT(c.Fetch("SELECT * FROM t"));
+        ASSERT_EQ(PQnfields(res.get()), 2);
+      });
+    }
+    return static_cast<Status>(Status::OK());
+  }));
+  const auto total_queries = kConnectionCount * kUniqueQueriesPerRefresh;
+  ASSERT_EQ(cache_counters.first, total_queries);
+  ASSERT_GE(cache_counters.second, total_queries - 2 * kUniqueQueriesPerRefresh);
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -43,9 +43,13 @@
 
 #include "yb/tools/tools_test_utils.h"
 
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+
 #include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/enums.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_log.h"
@@ -92,6 +96,8 @@ DECLARE_int64(tablet_split_low_phase_size_threshold_bytes);
 
 DECLARE_uint64(max_clock_skew_usec);
 
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
+
 namespace yb {
 namespace pgwrapper {
 namespace {
@@ -1981,6 +1987,39 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(SingleRowScan), PgMiniRPCTest) {
   Run(kRows, kBlockSize, kReads);
 }
 
+class PgMiniPrefetchLimitGrowthTest : public PgMiniSingleTServerTest {
+ protected:
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_prefetch_limit) = 16;
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_ysql_prefetch_limit_max) = 1024;
+    PgMiniTest::SetUp();
+  }
+};
+
+// A long scan should double its prefetch limit on every page up to ysql_prefetch_limit_max, instead
+// of fetching ysql_prefetch_limit rows per read RPC all the way through.
+TEST_F_EX(PgMiniTest, PrefetchLimitGrowth, PgMiniPrefetchLimitGrowthTest) {
+  constexpr int kRows = 4096;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (k INT PRIMARY KEY, v INT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT s, s FROM generate_series(1, $0) AS s", kRows));
+
+  MetricWatcher read_rpc_watcher(
+      *cluster_->mini_tablet_server(0)->server(),
+      METRIC_handler_latency_yb_tserver_TabletServerService_Read);
+  const auto reads = ASSERT_RESULT(read_rpc_watcher.Delta([&conn]() -> Status {
+    auto res = VERIFY_RESULT(conn.Fetch("SELECT * FROM t"));
+    SCHECK_EQ(PQntuples(res.get()), kRows, IllegalState, "Unexpected number of rows");
+    return Status::OK();
+  }));
+  LOG(INFO) << "Read RPCs: " << reads;
+  // 16 + 32 + ... + 1024 covers 2032 rows in 7 reads, the rest takes 2 more reads of 1024 rows.
+  // A fixed limit of 16 rows would need 256 reads.
+  ASSERT_LE(reads, 16);
+}
+
 TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(DDLWithRestart)) {
   SetAtomicFlag(1.0, &FLAGS_TEST_transaction_ignore_applying_probability);
   FLAGS_TEST_force_master_leader_resolution = true;
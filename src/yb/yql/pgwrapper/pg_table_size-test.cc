@@ -12,22 +12,36 @@
 
 #include <chrono>
 #include <string>
+#include <unordered_set>
 
 #include "yb/client/client.h"
 #include "yb/client/table_info.h"
 #include "yb/client/yb_table_name.h"
 
 #include "yb/master/catalog_manager_if.h"
+#include "yb/master/master_heartbeat.pb.h"
 #include "yb/master/mini_master.h"
 
+#include "yb/tablet/tablet_metadata.h"
+#include "yb/tablet/tablet_peer.h"
+
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+#include "yb/tserver/ts_tablet_manager.h"
+#include "yb/tserver/tserver_metrics_heartbeat_data_provider.h"
+
+#include "yb/util/backoff_waiter.h"
 #include "yb/util/status.h"
 #include "yb/util/test_macros.h"
 
 #include "yb/yql/pgwrapper/pg_mini_test_base.h"
 #include "yb/yql/pgwrapper/libpq_utils.h"
 
+DECLARE_int32(tserver_heartbeat_metrics_full_storage_report_interval);
 DECLARE_int32(tserver_heartbeat_metrics_interval_ms);
 
+using namespace std::literals;
+
 namespace yb {
 namespace pgwrapper {
 namespace {
@@ -255,6 +269,68 @@ TEST_F(PgTableSizeTest, YB_DISABLE_TEST_IN_TSAN(PartitionedTableSize)) {
   ASSERT_OK(CheckSizeExpectedRange(parent_table_size, kPartitionParentTableSize));
 }
 
+class PgTableSizeSingleTServerTest : public PgTableSizeTest {
+ protected:
+  size_t NumTabletServers() override {
+    return 1;
+  }
+};
+
+// Storage metadata of a tablet should only be reported to master when it changed, when a full
+// storage report is due, or after a full tablet report.
+TEST_F_EX(PgTableSizeTest, YB_DISABLE_TEST_IN_TSAN(StorageMetadataReportedWhenChanged),
+          PgTableSizeSingleTServerTest) {
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tserver_heartbeat_metrics_full_storage_report_interval) = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.ExecuteFormat("CREATE TABLE $0 ($1 INT PRIMARY KEY) SPLIT INTO 3 TABLETS",
+                               kTable, kCol1));
+
+  auto& tserver = *cluster_->mini_tablet_server(0)->server();
+  std::unordered_set<TabletId> tablet_ids;
+  for (const auto& peer : tserver.tablet_manager()->GetTabletPeers()) {
+    if (peer->tablet_metadata()->table_name() == kTable) {
+      tablet_ids.insert(peer->tablet_id());
+    }
+  }
+  ASSERT_EQ(tablet_ids.size(), 3);
+
+  // Creates its own provider, so heartbeats of the tablet server do not interfere.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tserver_heartbeat_metrics_interval_ms) = 0;
+  tserver::TServerMetricsHeartbeatDataProvider provider(&tserver);
+  const master::TSHeartbeatResponsePB last_resp;
+  auto reported_tablets = [&provider, &last_resp, &tablet_ids](bool full_tablet_report) {
+    master::TSHeartbeatRequestPB req;
+    if (full_tablet_report) {
+      req.mutable_tablet_report()->set_is_incremental(false);
+    }
+    provider.AddData(last_resp, &req);
+    size_t result = 0;
+    for (const auto& metadata : req.storage_metadata()) {
+      result += tablet_ids.count(metadata.tablet_id());
+    }
+    return result;
+  };
+
+  ASSERT_EQ(reported_tablets(/* full_tablet_report= */ false), tablet_ids.size());
+  // Tablets are not reported again once they are idle.
+  ASSERT_OK(WaitFor(
+      [&reported_tablets] { return reported_tablets(/* full_tablet_report= */ false) == 0; },
+      10s * kTimeMultiplier, "Idle tablets are not reported"));
+
+  // Only the tablet that was written to is reported.
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO $0 VALUES (1)", kTable));
+  ASSERT_EQ(reported_tablets(/* full_tablet_report= */ false), 1);
+
+  // Every tablet is reported when a full storage report is due.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tserver_heartbeat_metrics_full_storage_report_interval) = 1;
+  ASSERT_EQ(reported_tablets(/* full_tablet_report= */ false), tablet_ids.size());
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tserver_heartbeat_metrics_full_storage_report_interval) = 1000;
+
+  // A full tablet report carries no storage metadata, and every tablet is reported after it.
+  ASSERT_EQ(reported_tablets(/* full_tablet_report= */ true), 0);
+  ASSERT_EQ(reported_tablets(/* full_tablet_report= */ false), tablet_ids.size());
+}
+
 TEST_F(PgTableSizeTest, YB_DISABLE_TEST_IN_TSAN(MaterializedViewSize)) {
   auto conn = ASSERT_RESULT(Connect());
   ASSERT_OK(conn.ExecuteFormat("Create database $0", kDatabase));
@@ -47,6 +47,8 @@ DECLARE_bool(enable_automatic_tablet_splitting);
 DECLARE_int32(cleanup_split_tablets_interval_sec);
 DECLARE_uint64(rpc_connection_timeout_ms);
 DECLARE_uint64(force_single_shard_waiter_retry_ms);
+DECLARE_int32(wait_queue_poll_interval_ms);
+DECLARE_uint64(transaction_deadlock_detection_interval_usec);
 
 using namespace std::literals;
 
@@ -412,6 +414,45 @@ TEST_F(PgWaitQueuesTest, YB_DISABLE_TEST_IN_TSAN(MultipleWaitersUnblock)) {
   thread_holder.WaitAndStop(10s * kTimeMultiplier);
 }
 
+class PgWaitQueuesSlowPollTest : public PgWaitQueuesTest {
+ protected:
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_wait_queue_poll_interval_ms) = 60000;
+    PgWaitQueuesTest::SetUp();
+  }
+};
+
+// Waiters should be resumed when the blocker commit or abort reaches the participant, not when
+// the wait queue polls the blocker status.
+TEST_F(PgWaitQueuesSlowPollTest, YB_DISABLE_TEST_IN_TSAN(ResumeWithoutPoll)) {
+  auto setup_conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(setup_conn.Execute("INSERT INTO foo VALUES (1, 0), (2, 0)"));
+
+  for (auto commit : {true, false}) {
+    auto key = commit ? 1 : 2;
+    ASSERT_OK(setup_conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+    ASSERT_OK(setup_conn.FetchFormat("SELECT * FROM foo WHERE k=$0 FOR UPDATE", key));
+
+    CountDownLatch updated(1);
+    TestThreadHolder thread_holder;
+    thread_holder.AddThreadFunctor([this, key, &updated] {
+      auto conn = ASSERT_RESULT(Connect());
+      ASSERT_OK(conn.ExecuteFormat("UPDATE foo SET v=v+1 WHERE k=$0", key));
+      updated.CountDown();
+    });
+
+    ASSERT_FALSE(updated.WaitFor(1s * kTimeMultiplier));
+    if (commit) {
+      ASSERT_OK(setup_conn.CommitTransaction());
+    } else {
+      ASSERT_OK(setup_conn.RollbackTransaction());
+    }
+    ASSERT_TRUE(updated.WaitFor(10s * kTimeMultiplier));
+    thread_holder.WaitAndStop(10s * kTimeMultiplier);
+  }
+}
+
 TEST_F(PgWaitQueuesTest, YB_DISABLE_TEST_IN_TSAN(LongWaitBeforeDeadlock)) {
   auto setup_conn = ASSERT_RESULT(Connect());
   constexpr int kClients = 2;
@@ -458,6 +499,59 @@ TEST_F(PgWaitQueuesTest, YB_DISABLE_TEST_IN_TSAN(LongWaitBeforeDeadlock)) {
   EXPECT_LT(succeeded_commit, kClients);
 }
 
+class PgWaitQueuesNoFullDeadlockScanTest : public PgWaitQueuesTest {
+ protected:
+  void SetUp() override {
+    ANNOTATE_UNPROTECTED_WRITE(FLAGS_transaction_deadlock_detection_interval_usec) = 600000000;
+    PgWaitQueuesTest::SetUp();
+  }
+};
+
+// Deadlocks formed by waiters that block at the same moment should be detected shortly after they
+// are formed, without waiting for the periodic scan of the whole wait-for graph.
+TEST_F(PgWaitQueuesNoFullDeadlockScanTest, YB_DISABLE_TEST_IN_TSAN(ConcurrentlyFormedDeadlock)) {
+  constexpr int kClients = 2;
+  constexpr int kNumTrials = 5;
+  auto setup_conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
+  ASSERT_OK(setup_conn.ExecuteFormat(
+      "insert into foo select generate_series(0, $0), 0", kClients * kNumTrials));
+
+  for (int trial_idx = 0; trial_idx < kNumTrials; ++trial_idx) {
+    TestThreadHolder thread_holder;
+    CountDownLatch first_update(kClients);
+    CountDownLatch done(kClients);
+    std::atomic<int> succeeded_second_update{0};
+    const auto start = CoarseMonoClock::Now();
+    for (int i = 0; i < kClients; ++i) {
+      thread_holder.AddThreadFunctor(
+          [this, i, trial_idx, &first_update, &done, &succeeded_second_update] {
+        const auto base_key = trial_idx * kClients;
+        auto conn = ASSERT_RESULT(Connect());
+        ASSERT_OK(conn.StartTransaction(IsolationLevel::SNAPSHOT_ISOLATION));
+        ASSERT_OK(conn.ExecuteFormat("UPDATE foo SET v=1 WHERE k=$0", base_key + i));
+        first_update.CountDown();
+        ASSERT_TRUE(first_update.WaitFor(5s * kTimeMultiplier));
+
+        auto s = conn.ExecuteFormat(
+            "UPDATE foo SET v=2 WHERE k=$0", base_key + (i + 1) % kClients);
+        LOG(INFO) << "Second update in client " << i << " of trial " << trial_idx << ": " << s;
+        if (s.ok()) {
+          succeeded_second_update++;
+          EXPECT_OK(conn.CommitTransaction());
+        }
+        done.CountDown();
+        ASSERT_TRUE(done.WaitFor(kClientStatementTimeoutSeconds * 1s));
+      });
+    }
+    ASSERT_TRUE(done.WaitFor(kClientStatementTimeoutSeconds * 1s));
+    thread_holder.WaitAndStop(10s * kTimeMultiplier);
+    ASSERT_LT(succeeded_second_update, kClients);
+    // Well below both the statement timeout and the full scan interval.
+    ASSERT_LE(CoarseMonoClock::Now() - start, 15s * kTimeMultiplier);
+  }
+}
+
 TEST_F(PgWaitQueuesTest, YB_DISABLE_TEST_IN_TSAN(SavepointRollbackUnblock)) {
   auto setup_conn = ASSERT_RESULT(Connect());
   ASSERT_OK(setup_conn.Execute("CREATE TABLE foo (k INT PRIMARY KEY, v INT)"));
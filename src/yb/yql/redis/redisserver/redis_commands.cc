@@ -1303,5 +1303,34 @@ void FillRedisCommands(const scoped_refptr<MetricEntity>& metric_entity,
   BOOST_PP_SEQ_FOR_EACH(POPULATE_HANDLER, ~, REDIS_COMMANDS);
 }
 
+#define READ_IS_READ_ONLY true
+#define WRITE_IS_READ_ONLY false
+#define LOCAL_IS_READ_ONLY false
+#define CLUSTER_IS_READ_ONLY false
+
+#define DO_ADD_READ_ONLY_NAME(name, cname, arity, type) \
+  if (BOOST_PP_CAT(type, _IS_READ_ONLY)) { \
+    result.insert(Slice(BOOST_PP_STRINGIZE(name))); \
+  }
+#define ADD_READ_ONLY_NAME(r, data, elem) DO_ADD_READ_ONLY_NAME elem
+
+bool IsReadOnlyRedisCommand(const Slice& name) {
+  static const std::unordered_set<Slice, Slice::Hash> kReadOnlyNames = [] {
+    std::unordered_set<Slice, Slice::Hash> result;
+    BOOST_PP_SEQ_FOR_EACH(ADD_READ_ONLY_NAME, ~, REDIS_COMMANDS);
+    return result;
+  }();
+  static constexpr size_t kMaxNameLen = 32;
+
+  if (name.size() > kMaxNameLen) {
+    return false;
+  }
+  char lower_name[kMaxNameLen];
+  for (size_t i = 0; i != name.size(); ++i) {
+    lower_name[i] = std::tolower(name[i]);
+  }
+  return kReadOnlyNames.count(Slice(lower_name, name.size())) != 0;
+}
+
 } // namespace redisserver
 } // namespace yb
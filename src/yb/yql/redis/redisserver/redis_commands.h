@@ -133,6 +133,10 @@ void RespondWithFailure(
 void FillRedisCommands(const scoped_refptr<MetricEntity>& metric_entity,
                        const std::function<void(const RedisCommandInfo& info)>& setup_method);
 
+// Returns true if the command with the specified name only reads data, i.e. could be processed
+// concurrently with other such commands of the same connection. The name is case insensitive.
+bool IsReadOnlyRedisCommand(const Slice& name);
+
 #define YB_REDIS_METRIC(name) \
     BOOST_PP_CAT(METRIC_handler_latency_yb_redisserver_RedisServerService_, name)
 
@@ -48,9 +48,29 @@ namespace {
 constexpr size_t kMaxNumberOfArgs = 1 << 20;
 constexpr size_t kLineEndLength = 2;
 constexpr size_t kMaxNumberLength = 25;
+// Any run of this many decimal digits fits into int64_t.
+constexpr size_t kMaxPlainNumberLength = 18;
 constexpr char kPositiveInfinity[] = "+inf";
 constexpr char kNegativeInfinity[] = "-inf";
 
+// Parses a non empty run of at most kMaxPlainNumberLength decimal digits.
+// Returns false for any other input, so the caller could fall back to the full check.
+bool ParsePlainNumber(const char* begin, const char* end, int64_t* result) {
+  if (begin == end || make_unsigned(end - begin) > kMaxPlainNumberLength) {
+    return false;
+  }
+  int64_t value = 0;
+  for (auto it = begin; it != end; ++it) {
+    unsigned digit = static_cast<unsigned char>(*it) - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  *result = value;
+  return true;
+}
+
 string to_lower_case(Slice slice) {
   return boost::to_lower_copy(slice.ToBuffer());
 }
@@ -1201,11 +1221,22 @@ Result<ptrdiff_t> RedisParser::ParseNumber(char prefix,
     return STATUS_FORMAT(
         Corruption, "Too long $0 of length $1", name, expected_stop - number_begin);
   }
-  number_buffer_.reserve(kMaxNumberLength);
-  IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
-  number_buffer_.push_back(0);
-  auto parsed_number = VERIFY_RESULT(CheckedStoll(
-      Slice(number_buffer_.data(), number_buffer_.size() - 1)));
+  // Sizes and counts are plain digits within one block in almost all requests, so they are parsed
+  // in place. Signs, numbers split between blocks and malformed numbers go through CheckedStoll.
+  int64_t parsed_number;
+  auto p = offset_to_idx_and_local_offset(number_begin);
+  const auto& block = source_[p.first];
+  auto number_length = expected_stop - number_begin;
+  if (p.second + number_length > block.iov_len ||
+      !ParsePlainNumber(IoVecBegin(block) + p.second,
+                        IoVecBegin(block) + p.second + number_length,
+                        &parsed_number)) {
+    number_buffer_.reserve(kMaxNumberLength);
+    IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
+    number_buffer_.push_back(0);
+    parsed_number = VERIFY_RESULT(CheckedStoll(
+        Slice(number_buffer_.data(), number_buffer_.size() - 1)));
+  }
   static_assert(sizeof(parsed_number) == sizeof(ptrdiff_t), "Expected size");
   SCHECK_BOUNDS(parsed_number,
                 min,
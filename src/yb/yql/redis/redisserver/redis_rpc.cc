@@ -31,6 +31,7 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 
+#include "yb/yql/redis/redisserver/redis_commands.h"
 #include "yb/yql/redis/redisserver/redis_encoding.h"
 #include "yb/yql/redis/redisserver/redis_parser.h"
 #include "yb/util/flags.h"
@@ -47,6 +48,11 @@ DEFINE_UNKNOWN_uint64(redis_max_concurrent_commands, 1,
               "Max number of redis commands received from single connection, "
               "that could be processed concurrently");
 DEFINE_UNKNOWN_uint64(redis_max_batch, 500, "Max number of redis commands that forms batch");
+DEFINE_NON_RUNTIME_uint64(redis_max_concurrent_read_only_batches, 16,
+    "Max number of batches received from single connection, that could be processed "
+    "concurrently when all of them contain only read commands. Batches with other commands are "
+    "limited by redis_max_concurrent_commands.");
+TAG_FLAG(redis_max_concurrent_read_only_batches, advanced);
 DEFINE_UNKNOWN_int32(rpcz_max_redis_query_dump_size, 4_KB,
              "The maximum size of the Redis query string in the RPCZ dump.");
 DEFINE_UNKNOWN_uint64(redis_max_read_buffer_size, 128_MB,
@@ -67,7 +73,8 @@ RedisConnectionContext::RedisConnectionContext(
     rpc::GrowableBufferAllocator* allocator,
     const MemTrackerPtr& call_tracker)
     : ConnectionContextWithQueue(
-          FLAGS_redis_max_concurrent_commands, FLAGS_redis_max_queued_bytes),
+          FLAGS_redis_max_concurrent_commands, FLAGS_redis_max_queued_bytes,
+          FLAGS_redis_max_concurrent_read_only_batches),
       read_buffer_(allocator, FLAGS_redis_max_read_buffer_size),
       call_mem_tracker_(call_tracker) {}
 
@@ -247,6 +254,19 @@ Status RedisInboundCall::ParseFrom(
                          end_of_command, request_data_.size());
   }
 
+  // Batches of reads do not depend on each other, so they could be processed concurrently.
+  // Responses are still sent in order by the connection context.
+  bool read_only = true;
+  for (const auto& command : client_batch_) {
+    if (!IsReadOnlyRedisCommand(command[0])) {
+      read_only = false;
+      break;
+    }
+  }
+  if (read_only) {
+    SetOverlappable();
+  }
+
   parsed_.store(true, std::memory_order_release);
   return Status::OK();
 }
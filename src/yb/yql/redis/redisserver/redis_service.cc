@@ -46,6 +46,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/memory/mc_types.h"
 #include "yb/util/metrics.h"
+#include "yb/util/net/net_util.h"
 #include "yb/util/redis_util.h"
 #include "yb/util/result.h"
 #include "yb/util/shared_lock.h"
@@ -115,6 +116,9 @@ DEFINE_UNKNOWN_int32(redis_password_caching_duration_ms, 5000,
 
 DEFINE_UNKNOWN_bool(redis_safe_batch, true, "Use safe batching with Redis service");
 DEFINE_UNKNOWN_bool(enable_redis_auth, true, "Enable AUTH for the Redis service");
+DEFINE_RUNTIME_AUTO_bool(redis_batch_publish_forwarding, kLocalVolatile, false, true,
+    "When set, messages published while a Publish RPC to a node is in flight are queued and "
+    "forwarded to that node in a single RPC once it completes.");
 
 DECLARE_string(placement_cloud);
 DECLARE_string(placement_region);
@@ -140,6 +144,8 @@ namespace redisserver {
 
 typedef boost::container::small_vector_base<Slice> RedisKeyList;
 
+class PublishForwarder;
+
 namespace {
 
 YB_DEFINE_ENUM(OperationType, (kNone)(kRead)(kWrite)(kLocal));
@@ -807,6 +813,8 @@ struct RedisServiceImplData : public RedisServiceData {
   std::unordered_set<Connection*> monitoring_clients_;
   scoped_refptr<AtomicGauge<uint64_t>> num_clients_monitoring_;
 
+  std::shared_ptr<PublishForwarder> publish_forwarder_;
+
   std::mutex redis_password_mutex_;
   MonoTime redis_cached_password_validity_expiry_;
   vector<string> redis_cached_passwords_;
@@ -1207,8 +1215,8 @@ class PublishResponseHandler {
   PublishResponseHandler(int32_t n, IntFunctor f)
       : num_replies_pending(n), done_functor(std::move(f)) {}
 
-  void HandleResponse(const tserver::PublishResponsePB* resp) {
-    num_clients_forwarded_to.IncrementBy(resp->num_clients_forwarded_to());
+  void HandleResponse(int32_t num_clients) {
+    num_clients_forwarded_to.IncrementBy(num_clients);
 
     if (0 == num_replies_pending.IncrementBy(-1)) {
       done_functor(num_clients_forwarded_to.Load());
@@ -1221,6 +1229,123 @@ class PublishResponseHandler {
   IntFunctor done_functor;
 };
 
+// Forwards published messages to other nodes. While a Publish RPC to a node is in flight, later
+// messages to that node are queued, and sent together in one RPC when it completes.
+class PublishForwarder : public std::enable_shared_from_this<PublishForwarder> {
+ public:
+  explicit PublishForwarder(rpc::ProxyCache* proxy_cache) : proxy_cache_(*proxy_cache) {}
+
+  void Forward(
+      const HostPort& host_port, const string& channel, const string& message,
+      const std::shared_ptr<PublishResponseHandler>& handler) {
+    std::vector<PendingMessage> messages;
+    if (!FLAGS_redis_batch_publish_forwarding) {
+      messages.push_back(PendingMessage{channel, message, handler});
+      auto proxy = std::make_shared<tserver::TabletServerServiceProxy>(&proxy_cache_, host_port);
+      Send(host_port, proxy, std::move(messages), false /* batch */);
+      return;
+    }
+    std::shared_ptr<tserver::TabletServerServiceProxy> proxy;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& destination = destinations_[host_port];
+      destination.pending.push_back(PendingMessage{channel, message, handler});
+      if (destination.proxy) {
+        // A Publish RPC to this node is in flight, the message is sent when it completes.
+        return;
+      }
+      destination.proxy = std::make_shared<tserver::TabletServerServiceProxy>(
+          &proxy_cache_, host_port);
+      proxy = destination.proxy;
+      messages = TakeBatch(&destination.pending);
+    }
+    Send(host_port, proxy, std::move(messages), true /* batch */);
+  }
+
+ private:
+  struct PendingMessage {
+    string channel;
+    string message;
+    std::shared_ptr<PublishResponseHandler> handler;
+  };
+
+  // Exists only while a Publish RPC to the node is in flight, so nodes that left the cluster don't
+  // keep an entry.
+  struct Destination {
+    std::shared_ptr<tserver::TabletServerServiceProxy> proxy;
+    std::vector<PendingMessage> pending;
+  };
+
+  // Limits the size of a batch, so a burst of large messages doesn't produce an RPC above the
+  // message size limit. A single message is always sent, whatever its size.
+  static constexpr size_t kMaxBatchBytes = 1_MB;
+
+  static std::vector<PendingMessage> TakeBatch(std::vector<PendingMessage>* pending) {
+    size_t bytes = 0;
+    auto it = pending->begin();
+    while (it != pending->end() && (it == pending->begin() || bytes < kMaxBatchBytes)) {
+      bytes += it->channel.size() + it->message.size();
+      ++it;
+    }
+    std::vector<PendingMessage> result(
+        std::make_move_iterator(pending->begin()), std::make_move_iterator(it));
+    pending->erase(pending->begin(), it);
+    return result;
+  }
+
+  void Send(
+      const HostPort& host_port, const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy,
+      std::vector<PendingMessage> messages, bool batch) {
+    tserver::PublishRequestPB request;
+    request.set_channel(messages.front().channel);
+    request.set_message(messages.front().message);
+    for (size_t i = 1; i < messages.size(); ++i) {
+      auto* entry = request.add_more_messages();
+      entry->set_channel(messages[i].channel);
+      entry->set_message(messages[i].message);
+    }
+    auto response = std::make_shared<tserver::PublishResponsePB>();
+    auto controller = std::make_shared<rpc::RpcController>();
+    // The callback holds the proxy, response and controller until the RPC is done.
+    proxy->PublishAsync(
+        request, response.get(), controller.get(),
+        [self = shared_from_this(), host_port, proxy, response, controller,
+         messages = std::move(messages), batch] {
+      for (size_t i = 0; i != messages.size(); ++i) {
+        int32_t num_clients = 0;
+        if (i == 0) {
+          num_clients = response->num_clients_forwarded_to();
+        } else if (static_cast<int>(i) <= response->more_num_clients_forwarded_to_size()) {
+          num_clients = response->more_num_clients_forwarded_to(narrow_cast<int>(i - 1));
+        }
+        messages[i].handler->HandleResponse(num_clients);
+      }
+      if (batch) {
+        self->BatchDone(host_port, proxy);
+      }
+    });
+  }
+
+  void BatchDone(
+      const HostPort& host_port, const std::shared_ptr<tserver::TabletServerServiceProxy>& proxy) {
+    std::vector<PendingMessage> messages;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = destinations_.find(host_port);
+      if (it->second.pending.empty()) {
+        destinations_.erase(it);
+        return;
+      }
+      messages = TakeBatch(&it->second.pending);
+    }
+    Send(host_port, proxy, std::move(messages), true /* batch */);
+  }
+
+  rpc::ProxyCache& proxy_cache_;
+  std::mutex mutex_;
+  std::unordered_map<HostPort, Destination, HostPortHash> destinations_ GUARDED_BY(mutex_);
+};
+
 void RedisServiceImplData::ForwardToInterestedProxies(
     const string& channel, const string& message, const IntFunctor& f) {
   auto interested_servers = GetServerAddrsForChannel(channel);
@@ -1231,29 +1356,7 @@ void RedisServiceImplData::ForwardToInterestedProxies(
   std::shared_ptr<PublishResponseHandler> resp_handler =
       std::make_shared<PublishResponseHandler>(interested_servers->size(), f);
   for (auto& hostport_pb : *interested_servers) {
-    tserver::PublishRequestPB requestPB;
-    requestPB.set_channel(channel);
-    requestPB.set_message(message);
-    std::shared_ptr<tserver::TabletServerServiceProxy> proxy =
-        std::make_shared<tserver::TabletServerServiceProxy>(
-            &client_->proxy_cache(), HostPortFromPB(hostport_pb));
-    std::shared_ptr<tserver::PublishResponsePB> responsePB =
-        std::make_shared<tserver::PublishResponsePB>();
-    std::shared_ptr<yb::rpc::RpcController> rpcController = std::make_shared<rpc::RpcController>();
-    // Hold a copy of the shared ptr in the callback to ensure that the proxy, responsePB and
-    // rpcController are valid.
-    // these self-destruct on the latter of the two events
-    //  (i)  exit this loop, and
-    //  (ii) done with the callback.
-    proxy->PublishAsync(
-        requestPB, responsePB.get(), rpcController.get(),
-        [resp_handler, responsePB, rpcController, proxy]() mutable {
-          resp_handler->HandleResponse(responsePB.get());
-          responsePB.reset();
-          rpcController.reset();
-          proxy.reset();
-          resp_handler.reset();
-        });
+    publish_forwarder_->Forward(HostPortFromPB(hostport_pb), channel, message, resp_handler);
   }
 }
 
@@ -1352,6 +1455,7 @@ Status RedisServiceImplData::Initialize() {
     client_ = server_->tserver()->client();
 
     server_->tserver()->SetPublisher(std::bind(&RedisServiceImplData::Publish, this, _1, _2));
+    publish_forwarder_ = std::make_shared<PublishForwarder>(&client_->proxy_cache());
 
     tables_cache_ = std::make_shared<YBMetaDataCache>(
         client_, false /* Update roles permissions cache */);
@@ -11,7 +11,9 @@
 // under the License.
 //
 
+#include <algorithm>
 #include <chrono>
+#include <map>
 #include <memory>
 #include <random>
 #include <string>
@@ -56,6 +58,7 @@
 
 DECLARE_uint64(redis_max_concurrent_commands);
 DECLARE_uint64(redis_max_batch);
+DECLARE_uint64(redis_max_concurrent_read_only_batches);
 DECLARE_uint64(redis_max_read_buffer_size);
 DECLARE_uint64(redis_max_queued_bytes);
 DECLARE_int64(redis_rpc_block_size);
@@ -73,6 +76,7 @@ DECLARE_uint64(rpc_max_message_size);
 DECLARE_uint64(consensus_max_batch_size_bytes);
 DECLARE_int32(consensus_rpc_timeout_ms);
 DECLARE_int64(max_time_in_queue_ms);
+DECLARE_uint32(redis_sorted_set_rank_bucket_size);
 
 DEFINE_UNKNOWN_uint64(test_redis_max_concurrent_commands, 20,
     "Value of redis_max_concurrent_commands for pipeline test");
@@ -1375,6 +1379,39 @@ TEST_F_EX(TestRedisService, SafeBatchPipeline, TestRedisServiceSafeBatch) {
   LOG(INFO) << yb::Format("Safe set: $0ms, get: $1ms", set_time.count(), get_time.count());
 }
 
+class TestRedisServiceReadOnlyBatches : public TestRedisService {
+ public:
+  void SetUp() override {
+    FLAGS_redis_max_concurrent_commands = 1;
+    FLAGS_redis_max_concurrent_read_only_batches = 16;
+    FLAGS_redis_max_batch = 10;
+    FLAGS_redis_safe_batch = true;
+    TestRedisService::SetUp();
+  }
+};
+
+TEST_F_EX(TestRedisService, ReadOnlyBatchesPipeline, TestRedisServiceReadOnlyBatches) {
+  SendCommandAndExpectResponse(__LINE__, PipelineSetCommand(), PipelineSetResponse());
+  SendCommandAndExpectResponse(__LINE__, PipelineGetCommand(), PipelineGetResponse());
+
+  // Batches of gets are processed concurrently, but should still see the sets of the batches
+  // received before them.
+  constexpr int kRounds = 10;
+  constexpr int kGetsPerRound = 25;
+  std::string command;
+  std::string response;
+  for (int i = 0; i != kRounds; ++i) {
+    auto value = std::to_string(i);
+    command += Format("set key $0\r\n", value);
+    response += "+OK\r\n";
+    for (int j = 0; j != kGetsPerRound; ++j) {
+      command += "get key\r\n";
+      response += Format("$$$0\r\n$1\r\n", value.length(), value);
+    }
+  }
+  SendCommandAndExpectResponse(__LINE__, command, response);
+}
+
 TEST_F(TestRedisService, BatchedCommandMulti) {
   SendCommandAndExpectResponse(
       __LINE__,
@@ -2643,6 +2680,53 @@ TEST_F(TestRedisServiceExternal, TestPUnsubscribeCluster) {
   TestPubSub(LocalOrCluster::kCluster, SubOrUnsub::kUnsubscribe, PatternOrChannel::kPattern);
 }
 
+class TestRedisServiceBatchPublish : public TestRedisServiceExternal {
+ protected:
+  void CustomizeExternalMiniCluster(ExternalMiniClusterOptions* opts) override {
+    TestRedisServiceExternal::CustomizeExternalMiniCluster(opts);
+    opts->extra_tserver_flags.push_back("--redis_batch_publish_forwarding=true");
+  }
+};
+
+// Publishes a pipeline of messages on one node to a subscriber on another node. Messages
+// published while a Publish RPC is in flight are forwarded together in the next one, through
+// more_messages, and must still be delivered in order with one reply per PUBLISH.
+TEST_F(TestRedisServiceBatchPublish, PipelinedPublishCluster) {
+  expected_no_sessions_ = true;
+
+  auto ts0 = external_mini_cluster()->tablet_server(0);
+  auto ts1 = external_mini_cluster()->tablet_server(1);
+  auto sc1 = std::make_shared<RedisClient>(ts0->bind_host(), ts0->redis_rpc_port());
+  auto pc1 = std::make_shared<RedisClient>(ts1->bind_host(), ts1->redis_rpc_port());
+
+  const string topic1 = "topic1";
+  constexpr int kNumMsgs = 200;
+
+  UseClient(sc1);
+  DoRedisTestResultsArray(
+      __LINE__, {"SUBSCRIBE", topic1},
+      {RedisReply(RedisReplyType::kString, "subscribe"),
+       RedisReply(RedisReplyType::kString, topic1), RedisReply(1)});
+  SyncClient();
+
+  UseClient(pc1);
+  for (int i = 0; i < kNumMsgs; i++) {
+    DoRedisTestInt(__LINE__, {"PUBLISH", topic1, Format("msg-$0", i)}, 1);
+  }
+  SyncClient();
+
+  UseClient(sc1);
+  for (int i = 0; i < kNumMsgs; i++) {
+    DoRedisTestArray(__LINE__, {}, {"message", topic1, Format("msg-$0", i)});
+  }
+  // No more messages to receive.
+  DoRedisTestArray(__LINE__, {"PING"}, {"pong", ""});
+  SyncClient();
+
+  UseClient(nullptr);
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisServiceExternal, YB_DISABLE_TEST(TestSlowSubscribersCatchingUp)) {
   expected_no_sessions_ = true;
 
@@ -3704,6 +3788,71 @@ TEST_F(TestRedisService, TestZRange) {
   VerifyCallbacks();
 }
 
+TEST_F(TestRedisService, TestZRangeWithRankIndex) {
+  // Small buckets, so the members are spread over many buckets of the rank index.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_redis_sorted_set_rank_bucket_size) = 2;
+  constexpr int kNumMembers = 20;
+
+  // Score and member of every member of the set.
+  std::map<std::string, int> scores;
+  auto check_ranges = [this, &scores] {
+    std::vector<std::pair<int, std::string>> members;
+    for (const auto& [member, score] : scores) {
+      members.emplace_back(score, member);
+    }
+    std::sort(members.begin(), members.end());
+    for (size_t start = 0; start <= members.size(); ++start) {
+      std::vector<std::string> forward, reverse;
+      for (size_t i = start; i < std::min(start + 3, members.size()); ++i) {
+        forward.push_back(members[i].second);
+        reverse.push_back(members[members.size() - 1 - i].second);
+      }
+      auto start_str = std::to_string(start);
+      auto end_str = std::to_string(start + 2);
+      DoRedisTestArray(__LINE__, {"ZRANGE", "z_key", start_str, end_str}, forward);
+      DoRedisTestArray(__LINE__, {"ZREVRANGE", "z_key", start_str, end_str}, reverse);
+    }
+    DoRedisTestInt(__LINE__, {"ZCARD", "z_key"}, members.size());
+    SyncClient();
+  };
+
+  // Add members one by one, in an order that does not match the score order, so buckets are
+  // split while the set grows.
+  for (int i = 0; i < kNumMembers; ++i) {
+    auto member = Format("v$0", i);
+    auto score = (i * 7) % kNumMembers;
+    DoRedisTestInt(__LINE__, {"ZADD", "z_key", std::to_string(score), member}, 1);
+    SyncClient();
+    scores[member] = score;
+  }
+  check_ranges();
+
+  // Remove some members, move others to new scores and add a member with an existing score.
+  DoRedisTestInt(__LINE__, {"ZREM", "z_key", "v0", "v3", "v6", "v100"}, 3);
+  SyncClient();
+  for (const auto* member : {"v0", "v3", "v6"}) {
+    scores.erase(member);
+  }
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "100", "v1", "-5", "v2", "7", "v21"}, 1);
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "7", "v9"}, 0);
+  SyncClient();
+  scores["v1"] = 100;
+  scores["v2"] = -5;
+  scores["v21"] = 7;
+  scores["v9"] = 7;
+  check_ranges();
+
+  // Recreate the set after deleting it.
+  DoRedisTestInt(__LINE__, {"DEL", "z_key"}, 1);
+  SyncClient();
+  DoRedisTestInt(__LINE__, {"ZADD", "z_key", "3", "a", "2", "b", "1", "c"}, 3);
+  SyncClient();
+  scores = {{"a", 3}, {"b", 2}, {"c", 1}};
+  check_ranges();
+
+  VerifyCallbacks();
+}
+
 TEST_F(TestRedisService, TestZScore) {
   // The default value is true, but we explicitly set this here for clarity.
   FLAGS_emulate_redis_responses = true;